@@ -6,77 +6,112 @@
 /*
     EditorContext
     ----------------------------------------------------------------------------
-    F
-      - _  ImGui ŋLgҏW UI ̏ԁh̎󂯓np PODB
-      - 1t[̒Łu_߂  ImGui Q/XV  _ʂǂށv
-        ƂЕf[^t[zB
+    役割：
+      - レンダラ側 ⇔ ImGui 側で共有する“編集 UI の状態”の受け渡し用 POD。
+      - 1フレームの中で「レンダラが埋める → ImGui が参照/更新 → レンダラが結果を読む」
+        という片方向データフローを想定。
 
-    CtTCNEXṼC[WF
-      1) _t[`ŁAScene/Game  SRV RTTCY𖄂߂
-         iFSceneLayer::FeedToUI / SyncStatsTo ōXVj
-      2) ImGui iEditorPanels Ȃǁj̒lăEBhE\zE͎擾
-      3) ʁiႦ΁uScene r[|[g̎\TCYvuHovered/Focusedvj
-         ̍\̂ɏ߂
-      4) _͏߂ꂽlisceneViewportSize Ȃǁjg
-         t[̃TCYv
+    ライフサイクル・更新順のイメージ：
+      1) レンダラがフレーム冒頭で、Scene/Game の SRV や実RTサイズ等を埋める
+         （例：SceneLayer::FeedToUI / SyncStatsTo で更新）
+      2) ImGui 側（EditorPanels など）がこの値を見てウィンドウ構築・入力取得
+      3) 結果（例えば「Scene ビューポートの実表示サイズ」や「Hovered/Focused」）を
+         この構造体に書き戻す
+      4) レンダラは書き戻された値（sceneViewportSize など）を使って
+         次フレームのリサイズ要求等を処理
 
-    pF
-      - RTTCYisceneRTWidth/Height, gameRTWidth/HeightjF
-        ۂ̃ItXN[ RenderTarget ̃sNZTCY
-      - ViewportSizeisceneViewportSize, gameViewportSizejF
-        ImGui ɃeNX`sNZlŕ`i̈̊]TCYj
-      - ImTextureIDisceneTexId, gameTexIdjF
-        imgui_impl_dx12 ŕێuGPU  SRV fBXNv^vw ID
+    用語：
+      - RTサイズ（sceneRTWidth/Height, gameRTWidth/Height）：
+        実際のオフスクリーン RenderTarget のピクセルサイズ
+      - ViewportSize（sceneViewportSize, gameViewportSize）：
+        ImGui 上にテクスチャを何ピクセル四方で描くか（＝可視領域の希望サイズ）
+      - ImTextureID（sceneTexId, gameTexId）：
+        imgui_impl_dx12 が内部で保持する「GPU 可視 SRV ディスクリプタ」を指す ID
 */
 
 struct EditorContext {
     // ----------------------------------------------------------------------------
-    // gOECAEg
+    // トグル・リレイアウト
     // ----------------------------------------------------------------------------
-    bool* pEnableEditor = nullptr; // GfB^ UI Ŝ̗L/i`FbN{bNXAȂǁj
-    bool* pRequestResetLayout = nullptr; // true ɂƃCAEgԂɃZbgi1tĝāj
-    bool* pAutoRelayout = nullptr; // CAEgœKL邩i^p|V[Cj
+    bool* pEnableEditor = nullptr; // エディタ UI 全体の有効/無効（チェックボックス連動など）
+    bool* pRequestResetLayout = nullptr; // true にするとレイアウトを初期状態にリセット（1フレ使い捨て）
+    bool* pAutoRelayout = nullptr; // 自動レイアウト最適化を有効化するか（運用ポリシー任せ）
 
     // ----------------------------------------------------------------------------
-    // Scene r[iItXN[ RT  ImGui ɕ\j
+    // Scene ビュー（オフスクリーン RT を ImGui に表示）
     // ----------------------------------------------------------------------------
-    ImTextureID sceneTexId = 0;               // ImGui::Image ɓn SRV  IDiimgui_impl_dx12 sj
-    ImVec2      sceneViewportSize = ImVec2(0, 0); // ۂ ImGui ŕ`悳ꂽ`TCYisNZj
-    bool        sceneHovered = false;           // t[AScene r[}EXzo[Ă邩
-    bool        sceneFocused = false;           // t[AScene r[L[{[htH[JX
-    unsigned    sceneRTWidth = 0;               //  RT ̕isNZj Viewports::FeedToUI Ŗ߂
-    unsigned    sceneRTHeight = 0;               //  RT ̍isNZj
+    ImTextureID sceneTexId = 0;               // ImGui::Image に渡す SRV の ID（imgui_impl_dx12 発行）
+    ImVec2      sceneViewportSize = ImVec2(0, 0); // 実際に ImGui 上で描画された矩形サイズ（ピクセル）
+    bool        sceneHovered = false;           // 今フレーム、Scene ビューがマウスホバーされているか
+    bool        sceneFocused = false;           // 今フレーム、Scene ビューがキーボードフォーカスを持つか
+    unsigned    sceneRTWidth = 0;               // 実 RT の幅（ピクセル）※ Viewports::FeedToUI で埋める
+    unsigned    sceneRTHeight = 0;               // 実 RT の高さ（ピクセル）
 
     // ----------------------------------------------------------------------------
-    // Game r[iŒJo͂ ImGui ɕ\j
-    //   - u(View)͌ŒEe(Proj)̂݃AXyNgǏ]vɂ邱ƂŁA
-    //     EBhETCYŁgςĥh݌viViewports QƁj
+    // Game ビュー（固定カメラ出力を ImGui に表示）
+    //   - 「向き(View)は固定・投影(Proj)のみアスペクト追従」にすることで、
+    //     ウィンドウリサイズで“向きが変わる”のを防ぐ設計（Viewports 側参照）
     // ----------------------------------------------------------------------------
-    ImTextureID gameTexId = 0;               // Game p SRV  ID
-    ImVec2      gameViewportSize = ImVec2(0, 0);  // ImGui ł̕\TCYisNZj
-    bool        gameHovered = false;           // t[AGame r[zo[Ă邩
-    bool        gameFocused = false;           // t[AGame r[tH[JX
-    unsigned    gameRTWidth = 0;               //  RT ̕isNZj
-    unsigned    gameRTHeight = 0;               //  RT ̍isNZj
+    ImTextureID gameTexId = 0;               // Game 用 SRV の ID
+    ImVec2      gameViewportSize = ImVec2(0, 0);  // ImGui 上での表示サイズ（ピクセル）
+    bool        gameHovered = false;           // 今フレーム、Game ビューがホバーされているか
+    bool        gameFocused = false;           // 今フレーム、Game ビューがフォーカスを持つか
+    unsigned    gameRTWidth = 0;               // 実 RT の幅（ピクセル）
+    unsigned    gameRTHeight = 0;               // 実 RT の高さ（ピクセル）
 
     // ----------------------------------------------------------------------------
-    // Xbv`FCiobNobt@j̏Ev
+    // スワップチェイン（バックバッファ）側の情報・統計
     // ----------------------------------------------------------------------------
-    std::uint32_t rtWidth = 0;               // ݂̃obNobt@iSwapChain ̎sNZj
-    std::uint32_t rtHeight = 0;               // ݂̃obNobt@
-    float         fps = 0.0f;            // ImGui::GetIO().Framerate 疄߂
+    std::uint32_t rtWidth = 0;               // 現在のバックバッファ幅（SwapChain の実ピクセル）
+    std::uint32_t rtHeight = 0;               // 現在のバックバッファ高
+    float         fps = 0.0f;            // ImGui::GetIO().Framerate 等から埋める
+
+    // 視錐台カリングの統計（SceneLayer::SyncStatsTo で埋める）
+    unsigned      sceneVisible = 0;       // Scene ビューで描いた MeshRenderer 数
+    unsigned      sceneCulled = 0;       // Scene ビューで視錐台外として捨てた数
+    unsigned      gameVisible = 0;       // Game ビューで描いた数
+    unsigned      gameCulled = 0;       // Game ビューで捨てた数
+    unsigned      sceneTested = 0;       // Scene ビューで今フレーム判定し直した数（キャッシュ再利用分を除く）
+    unsigned      gameTested = 0;       // Game ビューで今フレーム判定し直した数
+    unsigned      sceneOccluded = 0;       // Scene ビューで視錐台内だがオクルーダに隠れて捨てた数
+    unsigned      gameOccluded = 0;       // Game ビューでオクルーダに隠れて捨てた数
+    unsigned      sceneMeshBinds = 0;       // Scene ビューで VB/IB を実際にバインドした回数
+    unsigned      gameMeshBinds = 0;       // Game ビューで VB/IB を実際にバインドした回数
+    unsigned      sceneDrawCalls = 0;      // Scene ビューの DrawIndexedInstanced 回数（インスタンシング後）
+    unsigned      gameDrawCalls = 0;       // Game ビューの DrawIndexedInstanced 回数（インスタンシング後）
+    unsigned      sceneIndirectCalls = 0;  // Scene ビューの ExecuteIndirect 回数（0 = 直接記録）
+    unsigned      gameIndirectCalls = 0;   // Game ビューの ExecuteIndirect 回数
+    unsigned      sceneTriangles = 0;      // Scene ビューで描いた三角形数（選んだ LOD で数える）
+    unsigned      gameTriangles = 0;       // Game ビューで描いた三角形数
+    unsigned      sceneLodReduced = 0;     // Scene ビューで LOD1 以降で描いた数
+    unsigned      gameLodReduced = 0;      // Game ビューで LOD1 以降で描いた数
+    unsigned      sceneTinyCulled = 0;     // Scene ビューで画面上小さすぎるとして捨てた数
+    unsigned      gameTinyCulled = 0;      // Game ビューで画面上小さすぎるとして捨てた数
+    unsigned      sceneMeshletsTested = 0; // Scene ビューでメッシュレット単位に判定した塊の数
+    unsigned      gameMeshletsTested = 0;  // Game ビューでメッシュレット単位に判定した塊の数
+    unsigned      sceneMeshletsCulled = 0; // Scene ビューで視錐台外/裏向きとして捨てた塊の数
+    unsigned      gameMeshletsCulled = 0;  // Game ビューで視錐台外/裏向きとして捨てた塊の数
+
+    // 共有 VB/IB の使用量（D3D12Renderer が GeometryPool::Stats から埋める。シーン単位）
+    std::uint64_t meshVertexBytes = 0;     // 生きている頂点の合計バイト数（GPU 形式）
+    std::uint32_t meshVertexStride = 0;    // GPU 頂点 1 個のバイト数（全ストリームの合計。GpuVertexStreams::kStride）
+    std::uint32_t meshPositionStride = 0;  // そのうち位置ストリームのバイト数（位置だけのパスが読む量）
+    std::uint64_t meshIndexBytes = 0;      // 生きているインデックスの合計バイト数
+    std::uint64_t meshIndexBytesSaved = 0; // 16bit に詰めて節約したバイト数
+    std::uint64_t meshIndexCount = 0;      // インデックスの総数
+    std::uint64_t meshShortIndexCount = 0; // そのうち 16bit で持っている数
 
     // ----------------------------------------------------------------------------
-    // pl`̃Gg|CgiĂяo_l߂j
-    //   - Hierarchy/Inspector ̕`͊֐|C^ł͂Ȃ std::function Ŏ󂯂
+    // パネル描画のエントリポイント（呼び出し側がラムダを詰める）
+    //   - Hierarchy/Inspector の描画は関数ポインタではなく std::function で受ける
     // ----------------------------------------------------------------------------
-    std::function<void()> DrawInspector;          // FI GameObject  Transform 
-    std::function<void()> DrawHierarchy;          // FV[c[ieq֌W̉j
+    std::function<void()> DrawInspector;          // 例：選択中 GameObject の Transform 等
+    std::function<void()> DrawHierarchy;          // 例：シーンツリー（親子関係の可視化）
 
     // ----------------------------------------------------------------------------
-    // tOFScene r[̃TCY삪is
-    //   - FhbOŃTCYhĂԂ trueA肵 false
-    //   - foEX̒um肵 RT 蒼v̔Ɏg
+    // フラグ：Scene ビューのリサイズ操作が進行中か
+    //   - 例：ドラッグでサイズが揺れている間は true、安定したら false
+    //   - デバウンスの調整や「確定したら RT を作り直す」等の判定に使える
     // ----------------------------------------------------------------------------
     bool sceneResizing = false;
 };
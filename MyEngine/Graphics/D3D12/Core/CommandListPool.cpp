@@ -0,0 +1,130 @@
+﻿#include "Core/CommandListPool.h"
+#include <utility>
+
+/*
+    CommandListPool
+    ----------------------------------------------------------------------------
+    組の状態遷移：
+        空き(m_free) ──Acquire(open)──▶ 今フレーム(m_thisFrame) ──EndFrame(fence)──▶ 退役(m_retired)
+              ▲                                                                      │
+              └────────────── BeginFrame(completed >= fence) で resetAllocator ────────┘
+    注意：
+      - アロケータの Reset は「そのアロケータで記録したリストを GPU が実行し終えた後」でなければならない。
+        退役時の Signal 値に completed が届くまで空きへは戻さない。
+      - 1 本のリストに 1 つのアロケータを割り当てるので、Acquire（= list の Reset）時に
+        アロケータを Reset する必要はない（空きに戻す時点で Reset 済み）。
+      - 作ったばかりのリストは Close 済みで来る前提（Acquire で必ず open する）。
+*/
+
+bool CommandListPool::Initialize(ID3D12Device* dev, D3D12_COMMAND_LIST_TYPE type)
+{
+    if (!dev) return false;
+
+    Backend b;
+    b.create = [dev, type](CommandListEntry& e) -> bool
+        {
+            if (FAILED(dev->CreateCommandAllocator(type, IID_PPV_ARGS(&e.allocator))))
+                return false;
+            if (FAILED(dev->CreateCommandList(0, type, e.allocator.Get(),
+                /*initialPSO=*/nullptr, IID_PPV_ARGS(&e.list))))
+                return false;
+            return SUCCEEDED(e.list->Close()); // Acquire で Reset する前提に揃える
+        };
+    b.resetAllocator = [](CommandListEntry& e) { return SUCCEEDED(e.allocator->Reset()); };
+    b.open = [](CommandListEntry& e) { return SUCCEEDED(e.list->Reset(e.allocator.Get(), nullptr)); };
+    b.close = [](CommandListEntry& e) { e.list->Close(); };
+    Initialize(std::move(b));
+    return true;
+}
+
+void CommandListPool::Initialize(Backend backend)
+{
+    Destroy();
+    m_backend = std::move(backend);
+}
+
+void CommandListPool::Destroy()
+{
+    m_thisFrame.clear();
+    m_retired.clear();
+    m_free.clear();
+    m_nextId = 0;
+    m_stats = CommandListPoolStats();
+}
+
+void CommandListPool::BeginFrame(std::uint64_t completedFence)
+{
+    while (!m_retired.empty() && m_retired.front().fence <= completedFence)
+    {
+        for (CommandListEntry& e : m_retired.front().entries)
+        {
+            // Reset に失敗した組は捨てる（次に足りなければ作り直す）
+            if (m_backend.resetAllocator && m_backend.resetAllocator(e)) m_free.push_back(std::move(e));
+            else                                                          --m_stats.entries;
+        }
+        m_retired.pop_front();
+    }
+    m_stats.freeEntries = static_cast<std::uint32_t>(m_free.size());
+}
+
+ID3D12GraphicsCommandList* CommandListPool::Acquire()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    CommandListEntry e;
+    if (!m_free.empty())
+    {
+        e = std::move(m_free.back());
+        m_free.pop_back();
+    }
+    else
+    {
+        if (!m_backend.create || !m_backend.create(e)) return nullptr;
+        e.id = m_nextId++;
+        ++m_stats.entries;
+    }
+
+    if (!m_backend.open || !m_backend.open(e))
+    {
+        // 開けない組は使わない（アロケータが壊れている可能性があるので空きにも戻さない）
+        --m_stats.entries;
+        m_stats.freeEntries = static_cast<std::uint32_t>(m_free.size());
+        return nullptr;
+    }
+
+    m_thisFrame.push_back(std::move(e));
+    ++m_stats.listsThisFrame;
+    m_stats.freeEntries = static_cast<std::uint32_t>(m_free.size());
+    return m_thisFrame.back().list.Get();
+}
+
+ID3D12GraphicsCommandList* CommandListPool::Current() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_thisFrame.empty() ? nullptr : m_thisFrame.back().list.Get();
+}
+
+void CommandListPool::Close(std::vector<ID3D12CommandList*>& out)
+{
+    out.clear();
+    out.reserve(m_thisFrame.size());
+    for (CommandListEntry& e : m_thisFrame)
+    {
+        if (m_backend.close) m_backend.close(e);
+        out.push_back(e.list.Get());
+    }
+}
+
+void CommandListPool::EndFrame(std::uint64_t fenceValue)
+{
+    if (!m_thisFrame.empty())
+    {
+        Retired r;
+        r.fence = fenceValue;
+        for (CommandListEntry& e : m_thisFrame) e.fence = fenceValue;
+        r.entries.swap(m_thisFrame);
+        m_retired.push_back(std::move(r));
+    }
+    m_stats.listsLastFrame = m_stats.listsThisFrame;
+    m_stats.listsThisFrame = 0;
+}
@@ -0,0 +1,116 @@
+﻿#pragma once
+#include <wrl/client.h>
+#include <d3d12.h>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/*
+    CommandListPool
+    ----------------------------------------------------------------------------
+    目的：
+      - 「コマンドアロケータ + コマンドリスト」の組をプールして、1 フレームに何本でも
+        記録用のリストを払い出す（メインスレッド用 1 本 + ワーカーごとに 1 本 …）。
+        1 組を同時に使うのは 1 スレッドだけなので、ワーカーは互いにロック無しで記録できる。
+      - 使い終わった組は「そのフレームの Signal 値」で退役させ、GPU が到達したら
+        アロケータを Reset して空きへ戻す（UploadRing と同じ FIFO + フェンス値方式）。
+        → フレーム数 × ワーカー数ぶんを最初から固定で持たなくても、使った数だけに収まる。
+
+    提出順：
+      - Acquire した順がそのまま ExecuteCommandLists の順になる（Close で順に集める）。
+        途中で並列記録を挟むときは
+          Current(前半) → Acquire × n（並列に記録） → Acquire（後半の続き）
+        の順で取れば、前半 → 並列分 → 後半 の順に実行される。
+
+    想定フロー（FrameScheduler）：
+      1) BeginFrame(completedFence) …… 完了したフレームの組を Reset して空きへ
+      2) Acquire()                  …… 記録中に何度でも（Reset 済みで開いた状態のリストを返す）
+      3) Close(lists)               …… 今フレームのリストを Close し、提出順に並べて返す
+      4) EndFrame(signalValue)      …… 今フレームの組を Signal 値で退役させる
+
+    設計メモ：
+      - D3D12 の呼び出しは Backend（関数の束）に委譲する。既定はデバイスから作る実装。
+        テストではモックの Backend を渡せば GPU 無しで Reset のタイミングを確認できる。
+      - Acquire は内部でロックするので、記録スレッドからも呼べる（ビューごとのスレッドが
+        さらにチャンク用のリストを取る場合など）。並ぶ順は呼んだ順。
+        Close/BeginFrame/EndFrame はすべての記録が終わってからメインスレッドで呼ぶ。
+      - Current() は「最後に払い出したリスト」なので、複数スレッドが Acquire する間は
+        自分で取ったリストを覚えておくこと。
+*/
+
+/// プールが持つ 1 組（アロケータ 1 つにリスト 1 本）
+struct CommandListEntry
+{
+    Microsoft::WRL::ComPtr<ID3D12CommandAllocator>    allocator;
+    Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> list;
+    std::uint32_t                                     id = 0;   ///< 作成順の通し番号（デバッグ/テスト用）
+    std::uint64_t                                     fence = 0; ///< 最後に退役したときの Signal 値
+};
+
+/// 使用状況（デバッグ/Stats 表示用）
+struct CommandListPoolStats
+{
+    std::uint32_t entries = 0;        ///< 保持している組の数（使用中 + 退役待ち + 空き）
+    std::uint32_t freeEntries = 0;    ///< すぐ使える組の数
+    std::uint32_t listsThisFrame = 0; ///< 今フレームに払い出した本数
+    std::uint32_t listsLastFrame = 0; ///< 直前のフレームに払い出した本数
+};
+
+class CommandListPool
+{
+public:
+    /// D3D12 呼び出しの差し替え口
+    struct Backend
+    {
+        std::function<bool(CommandListEntry&)> create;         ///< allocator と list を作る（list は Close 済みで）
+        std::function<bool(CommandListEntry&)> resetAllocator; ///< allocator->Reset()（GPU 完了後にだけ呼ばれる）
+        std::function<bool(CommandListEntry&)> open;           ///< list->Reset(allocator, nullptr)
+        std::function<void(CommandListEntry&)> close;          ///< list->Close()
+    };
+
+    /// type（既定は DIRECT。転送用なら COPY）のアロケータ/リストをデバイスから作る
+    bool Initialize(ID3D12Device* dev, D3D12_COMMAND_LIST_TYPE type = D3D12_COMMAND_LIST_TYPE_DIRECT);
+
+    /// 作り方を差し替えて初期化する（テスト用のモック等）
+    void Initialize(Backend backend);
+
+    /// 全組を解放する（GPU 完了待ち済みで呼ぶこと）
+    void Destroy();
+
+    /// completedFence 以下の値で退役した組のアロケータを Reset して空きへ戻す
+    void BeginFrame(std::uint64_t completedFence);
+
+    /**
+     * @brief 記録を始められる状態のリストを 1 本払い出す（提出順の末尾に並ぶ）
+     * @return 失敗（作成/Reset 失敗）なら nullptr
+     */
+    ID3D12GraphicsCommandList* Acquire();
+
+    /// 直近に Acquire したリスト（今フレームにまだ無ければ nullptr）
+    ID3D12GraphicsCommandList* Current() const;
+
+    /// 今フレームのリストをすべて Close し、提出順に out へ並べる（out は上書き）
+    void Close(std::vector<ID3D12CommandList*>& out);
+
+    /// 今フレームの組を fenceValue で退役させる
+    void EndFrame(std::uint64_t fenceValue);
+
+    const CommandListPoolStats& Stats() const { return m_stats; }
+
+private:
+    struct Retired
+    {
+        std::uint64_t                 fence = 0;
+        std::vector<CommandListEntry> entries;
+    };
+
+    Backend                       m_backend;
+    std::vector<CommandListEntry> m_thisFrame; ///< 今フレームに払い出した組（提出順）
+    std::deque<Retired>           m_retired;   ///< 先頭 = 最も古い（小さいフェンス値）
+    std::vector<CommandListEntry> m_free;      ///< Reset 済みの組
+    std::uint32_t                 m_nextId = 0;
+    CommandListPoolStats          m_stats;
+    mutable std::mutex            m_mutex;     ///< Acquire/Current 用
+};
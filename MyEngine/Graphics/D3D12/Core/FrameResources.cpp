@@ -6,107 +6,56 @@ using Microsoft::WRL::ComPtr;
 /*
     FrameResources
     ----------------------------------------------------------------------------
-    F
-      Et[ƂɕKvȁuR}hAP[^vƁuAbv[hpCBobt@(UPL)vێB
-      E_u/gvobt@ÓAet[CfbNXɑ΂ēƗ̃\[XB
-      EUPL ́ui}bvv CPU ݃|C^ێi݌djB
-
-    pF
-      - frameCount  : Xbv`FC̃t[iF2 or 3j
-      - cbSize      : 1 IuWFNgg萔obt@̃TCYioCgj
-      - maxObjects  : 1 t[ōXVőIuWFNgiXbgj
-
-    ӓ_F
-      - CBV ̃n[hACg 256 oCgBcbSize  256 ̔{ɐ؂グĎgB
-      - UPL t[mۂAet[̗̈ɂ̂ݏސ݌vB
-      - Destroy()  Map K Unmap Ă Reset B
+    役割：
+      ・フレームごとのフェンス値を保持。
+      ・コマンドアロケータ/リストは CommandListPool に集約（必要な本数だけ作り、フェンス値で退役）。
+        以前はフレームインデックスごとにアロケータを 1 つ固定で持っていたが、
+        それだとフレーム内の記録が 1 本のリストに限られるため置き換えた。
+      ・定数バッファ等のアップロード領域は UploadRing（ページ単位で伸長・フェンス値で退役）に集約。
+
+    用語：
+      - frameCount     : スワップチェインのフレーム数（例：2 or 3）
+      - uploadPageSize : UploadRing の通常ページのサイズ（バイト）
+
+    注意点：
+      - 以前は「maxObjects × 256B」の固定スロットをフレーム数ぶん確保していたが、
+        オブジェクト数に上限ができるため UploadRing に置き換えた。
+      - Destroy() は GPU 完了待ちの後に呼ぶ（使用中のページも解放するため）。
 */
 
-bool FrameResources::Initialize(ID3D12Device* dev, UINT frameCount, UINT cbSize, UINT maxObjects)
+bool FrameResources::Initialize(ID3D12Device* dev, UINT frameCount, UINT64 uploadPageSize)
 {
-    // t[iOobt@̒ij
+    // フレーム数（リングバッファの段数）
     m_count = frameCount;
 
-    // ===== dvFCBV  256B ACgɐ؂グ =====
-    // D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT (256)
-    // ) cbSize=160  stride=256, cbSize=300  stride=512
-    m_cbStride = (cbSize + 255) & ~255u;
-
-    // t[Ƃ̃\[XZbgm
+    // フレームごとのリソースセットを確保
     m_items.resize(frameCount);
 
+    // Fence 値初期化（フレーム完了待ちの管理は上位で行う）
     for (UINT i = 0; i < frameCount; ++i) {
-        // --------------------------------------------------------------------
-        // 1) R}hAP[^iDIRECTj
-        //    Eet[p 1 pӁB
-        //    EėpƂ Fence Ŋ҂Ă Reset ̂ʑw̐ӖB
-        // --------------------------------------------------------------------
-        if (FAILED(dev->CreateCommandAllocator(
-            D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&m_items[i].cmdAlloc))))
-        {
-            return false;
-        }
-
-        // --------------------------------------------------------------------
-        // 2) 萔obt@p̃Abv[hq[vit[ i pj
-        //    EumaxObjects ~ stridev̘ÄmۂāA1t[ŎgSIuWFNgɋl߂B
-        //    EUPLOAD  CPU ݉AGPU ǂݎBtXVɌB
-        //    EDefault q[vƈႢAoAǗ͕sviш͒xjB
-        // --------------------------------------------------------------------
-        const UINT64 bytes = UINT64(m_cbStride) * UINT64(maxObjects);
-        auto heap = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-        auto desc = CD3DX12_RESOURCE_DESC::Buffer(bytes);
-
-        if (FAILED(dev->CreateCommittedResource(
-            &heap,
-            D3D12_HEAP_FLAG_NONE,
-            &desc,
-            D3D12_RESOURCE_STATE_GENERIC_READ, // UPL Ȃ̂ GENERIC_READ ŏ풓
-            nullptr,                           // CB pȂ̂ ClearValue ͕sv
-            IID_PPV_ARGS(&m_items[i].resource))))
-        {
-            return false;
-        }
-
-        // --------------------------------------------------------------------
-        // 3) i Map
-        //    EUPL ́ui}bvv OKiUnmap RXg/񐔂炷jB
-        //    ECD3DX12_RANGE(0,0)  CPU ݂݂̏̂ŁAGPU ւ̓ǂݎ͈͒ʒm͕sv̈ӖB
-        //    E߂|C^(m_items[i].cpu) "t[ i  UPL ̐擪" wB
-        // --------------------------------------------------------------------
-        CD3DX12_RANGE rr(0, 0); // ǂݎ薳i݂j
-        if (FAILED(m_items[i].resource->Map(0, &rr, reinterpret_cast<void**>(&m_items[i].cpu))))
-        {
-            return false;
-        }
-
-        // Fence lit[҂̊Ǘ͏ʂōsj
         m_items[i].fenceValue = 0;
     }
 
-    return true;
+    // コマンドアロケータ/リスト（最初の Acquire で作る）
+    if (!m_lists.Initialize(dev)) return false;
+
+    // アップロード領域（ページは最初の Allocate で作る）
+    return m_upload.Initialize(dev, uploadPageSize);
 }
 
 void FrameResources::Destroy()
 {
-    // ς݃t[tɕЕti͕K{ł͂Ȃ₷߁j
     for (auto& it : m_items) {
-        // Map Ăꍇ Unmap Ăii}bvj
-        if (it.resource && it.cpu) {
-            it.resource->Unmap(0, nullptr);
-            it.cpu = nullptr; // OFdangling pointerh~
-        }
-
-        // UPL \[XƃAP[^
-        it.resource.Reset();
-        it.cmdAlloc.Reset();
-
-        // Fence lÔߏ
         it.fenceValue = 0;
     }
 
-    // xN^kAŜ̃^Zbg
+    // コマンドアロケータ/リストを解放
+    m_lists.Destroy();
+
+    // アップロードページを解放（常時 Map は Release で外れる）
+    m_upload.Destroy();
+
+    // ベクタを縮小し、全体のメタ情報もリセット
     m_items.clear();
     m_count = 0;
-    m_cbStride = 0;
 }
@@ -2,37 +2,39 @@
 #include <wrl/client.h>
 #include <d3d12.h>
 #include <vector>
+#include "Core/UploadRing.h"
+#include "Core/CommandListPool.h"
 
 /*
     FrameResources
     ----------------------------------------------------------------------------
-    F
-      - t[CtCgiF2`3j gt[ʃ\[Xh ܂Ƃ߂ĊǗB
-        * R}hAP[^iID3D12CommandAllocatorj
-        * Abv[hp̒萔obt@i1 \[X N IuWFNgԂl߂j
-        * CPU }bv|C^icb ݗpj
-        * t[ʂtFXl
+    役割：
+      - フレームインフライト数分（例：2～3）の “フレーム別リソース” をまとめて管理。
+        * フレーム完了を識別するフェンス値
+      - 定数バッファ/インスタンスデータ用のアップロード領域（UploadRing）を 1 つ持つ。
+        ページ単位で伸び、フェンス値で退役するので、フレーム別に固定スロットを分ける必要はない。
+      - コマンドアロケータ/コマンドリストのプール（CommandListPool）を 1 つ持つ。
+        メインスレッド用とワーカーごとの記録用リストをここから払い出し、同じくフェンス値で退役させる。
 
-    giT^jF
-      1) Initialize(dev, frameCount, sizeof(SceneCB), maxObjects)
-      2) t[擪 current = Get(frameIndex)
-         - current.cmdAlloc->Reset()
-         - cmdList->Reset(current.cmdAlloc.Get(), c)
-      3) 萔obt@ current.cpu + (objectIndex * GetCBStride()) ɏ
-         - GPU  current.resource->GetGPUVirtualAddress() + (objectIndex * GetCBStride())
-      4) Submit A擾tFXl current.fenceValue ɋL^
-      5) 񓯂 frameIndex gO fence ̊҂
+    使い方（典型）：
+      1) Initialize(dev, frameCount)
+      2) フレーム先頭で current = Get(frameIndex)、current.fenceValue の完了を待つ
+         - CommandLists().BeginFrame(fence->GetCompletedValue())
+         - Upload().BeginFrame(fence->GetCompletedValue())
+         - cmd = CommandLists().Acquire()
+      3) 定数バッファ等は Upload().Allocate(size, 256) で切り出して書き込む
+         - GPU 側は戻り値の gpu をそのまま CBV/SRV に渡す
+         - 並列に記録したいときは CommandLists().Acquire() でワーカーごとのリストを取る
+      4) CommandLists().Close(lists) → ExecuteCommandLists → Signal、
+         取得したフェンス値を current.fenceValue に記録し、Upload()/CommandLists() の EndFrame(fence)
 
-    ӓ_F
-      - cbStride  256 oCgEɑiD3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENTj
-      - Upload \[X͏펞}bviMap once  Unmap neverj̉^pz
+    注意点：
+      - CB の切り出しは 256 バイト境界（D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT）
+      - Upload ページは常時マップ（Map once → Unmap never）の運用
 */
 
 struct FrameItem {
-    Microsoft::WRL::ComPtr<ID3D12CommandAllocator> cmdAlloc;  // ̃t[p̃R}hAP[^
-    Microsoft::WRL::ComPtr<ID3D12Resource>         resource;  // Upload CBiÄ maxObjects Ԃj
-    UINT8* cpu = nullptr; // 펞}bvinullptr ̂Ƃ}bvj
-    UINT64                                         fenceValue = 0; // ̃t[̊tFXl
+    UINT64 fenceValue = 0; // このフレームの完了を示すフェンス値
 };
 
 class FrameResources {
@@ -42,36 +44,41 @@ public:
     /*
         Initialize
         ------------------------------------------------------------------------
-        @param dev         : D3D12 foCX
-        @param frameCount  : t[CtCgiobNobt@Ɉv̂ʓIj
-        @param cbSize      : 1 IuWFNgԂ̒萔obt@ struct TCYiFsizeof(SceneCB)j
-        @param maxObjects  : 1 t[őz肷őIuWFNgiXbgj
-        ߂lF true
-        \  Fet[ɂ CommandAllocator  gmaxObjects ~ cbStrideh TCY
-                Upload obt@mۂAMap  cpu ɕێB
+        @param dev            : D3D12 デバイス
+        @param frameCount     : フレームインフライト数（バックバッファ数に一致させるのが一般的）
+        @param uploadPageSize : UploadRing の 1 ページのサイズ（足りなければページを足して伸びる）
+        戻り値：成功で true
+        効能  ：UploadRing と CommandListPool を初期化する
+                （ページ/アロケータは最初の Allocate/Acquire で作る）。
     */
-    bool Initialize(ID3D12Device* dev, UINT frameCount, UINT cbSize, UINT maxObjects);
+    bool Initialize(ID3D12Device* dev, UINT frameCount, UINT64 uploadPageSize = UploadRing::kDefaultPageSize);
 
     /*
         Destroy
         ------------------------------------------------------------------------
-        - ێ\[XjBMap 𖾎I Unmap Kv͂ȂiS Unmap Ă OKjB
-        - AP[^ Upload obt@ACPU |C^NAB
+        - 保持リソースを破棄（GPU 完了待ち済みで呼ぶこと）。
+        - コマンドアロケータ/リストとアップロードページをクリア。
     */
     void Destroy();
 
-    // ------------------------- ANZT -------------------------
+    // ------------------------- アクセサ -------------------------
     UINT GetCount() const { return m_count; }
 
-    // 1 IuWFNg CB XgChi256 oCgEɑlj
-    UINT GetCBStride() const { return m_cbStride; }
-
-    // ݃t[̃nh擾i݁^ǂݏoj
+    // 現在フレームのハンドル取得（書き込み／読み出し）
     FrameItem& Get(UINT idx) { return m_items[idx]; }
     const FrameItem& Get(UINT idx) const { return m_items[idx]; }
 
+    // 定数バッファ/インスタンスデータ用のアップロードアロケータ（全フレーム共有、フェンスで退役）
+    UploadRing& Upload() { return m_upload; }
+    const UploadRing& Upload() const { return m_upload; }
+
+    // コマンドアロケータ/リストのプール（全フレーム共有、フェンスで退役）
+    CommandListPool& CommandLists() { return m_lists; }
+    const CommandListPool& CommandLists() const { return m_lists; }
+
 private:
-    std::vector<FrameItem> m_items; // frameCount vfԂ
+    std::vector<FrameItem> m_items; // frameCount 要素ぶん
     UINT m_count = 0;             // = frameCount
-    UINT m_cbStride = 0;            // = Align(cbSize, 256)
+    UploadRing m_upload;
+    CommandListPool m_lists;
 };
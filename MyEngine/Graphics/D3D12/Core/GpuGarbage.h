@@ -5,76 +5,76 @@
 #include <memory>
 #include <cstdint>
 
-// RenderTarget.h  include Ȃiˑ̋t]ErhԒZk̂ߑO錾ɗ߂j
+// RenderTarget.h は include しない（依存の逆転・ビルド時間短縮のため前方宣言に留める）
 struct RenderTargetHandles;
 
 /*
     GpuGarbageQueue
     ----------------------------------------------------------------------------
-    ړIF
-      - ut[؂藣 GPU \[XvAGPU ̎gp܂
-        ĂASɉ邽߂̒xjL[B
-      - t[E Fence  Signal A̒lifenceValuejɂЂt
-        jΏۂGL[Bȍ~ACollect()  completedValue ɓB
-        ̂珇ɉB
+    目的：
+      - 「今フレーム切り離した GPU リソース」を、GPU の使用が完了するまで
+        生かしておき、安全に解放するための遅延破棄キュー。
+      - フレーム境界で Fence を Signal し、その値（fenceValue）にひも付けて
+        破棄対象をエンキュー。以降、Collect() で completedValue に到達した
+        ものから順に解放する。
 
-    zt[iFRenderTarget ̃TCYjF
-      1) Â RT  Detach()  RenderTargetHandles ɑ˂
-      2) t[ Signal ɁAEnqueueRT(signalValue, std::move(handles)) Ă
-      3) t[ Collect(fenceObj) ĂсAtFXBς݂̂̂
-      4) I FlushAll() őSiGPU ҂Ă炪Sj
+    想定フロー（例：RenderTarget のリサイズ時）：
+      1) 古い RT を Detach() して RenderTargetHandles に束ねる
+      2) 今フレームの Signal 後に、EnqueueRT(signalValue, std::move(handles)) を呼ぶ
+      3) 毎フレーム Collect(fenceObj) を呼び、フェンス到達済みのものを解放
+      4) 終了時は FlushAll() で即時全解放（GPU 完了を待ってからが安全）
 
-    ݌vF
-      - RenderTargetHandles ͖^̂߁Aڃoɂ͎ĂȂB
-         std::unique_ptr<RenderTargetHandles>  type-erasure IɕێB
-      - L[ FIFOBtFXl͒POB
-      - XbhZ[tł͂ȂiĂяoXbh 1 {ɑzjB
+    設計メモ：
+      - RenderTargetHandles は未完成型のため、直接メンバには持てない。
+        → std::unique_ptr<RenderTargetHandles> で type-erasure 的に保持。
+      - キューは FIFO。フェンス値は単調増加が前提。
+      - スレッドセーフではない（呼び出しスレッドを 1 本に揃える想定）。
 */
 class GpuGarbageQueue {
 public:
     /*
         EnqueueRT
         ------------------------------------------------------------------------
-        @param fenceValue : u̒lɓBjėǂvƂtFXl
-        @param rt         : Detach ē RenderTargetHandlesiLDj
-                     : rt tFXlƂƂɃL[֐ς
+        @param fenceValue : 「この値に到達したら破棄して良い」ことを示すフェンス値
+        @param rt         : Detach して得た RenderTargetHandles（所有権を奪う）
+        効果             : rt をフェンス値とともにキュー末尾へ積む
     */
     void EnqueueRT(UINT64 fenceValue, RenderTargetHandles&& rt);
 
     /*
         Collect
         ------------------------------------------------------------------------
-        @param fenceObj : GPU l₢킹ΏۃtFX
-                   : fenceObj->GetCompletedValue() ɒB Item 
-                         擪珇ɉĂ
-                   : tFXl͒POBBĂȂ Item ͎cB
+        @param fenceObj : GPU 完了値を問い合わせる対象フェンス
+        効果           : fenceObj->GetCompletedValue() に達した Item を
+                         先頭から順に解放していく
+        注意           : フェンス値は単調増加が前提。達していない Item は残す。
     */
     void Collect(ID3D12Fence* fenceObj);
 
     /*
         FlushAll
         ------------------------------------------------------------------------
-         : ێĂ邷ׂĂ Item 𑦍ɉitFXlɊ֌WȂjB
-               AvIuł GPU ͊S~ς݁vƕĂǖʂŎgpB
-         : s GPU QƂĂ\󋵂ł͎gȂƁB
+        効果 : 保持しているすべての Item を即座に解放する（フェンス値に関係なく）。
+               アプリ終了時や「すでに GPU は完全停止済み」と分かっている局面で使用。
+        注意 : 実行中の GPU が参照している可能性がある状況では使わないこと。
     */
     void FlushAll();
 
-    // ݃L[ɗ܂Ăҋ@ACeifobOprj
+    // 現在キューに溜まっている待機中アイテム数（デバッグ用途）
     size_t PendingCount() const noexcept { return m_rts.size(); }
 
 private:
     struct Item {
-        UINT64 fence = 0;                                   // BjėǂtFXl
-        std::unique_ptr<RenderTargetHandles> rt;            // j҂ RT Zbg
+        UINT64 fence = 0;                                   // 到達したら破棄して良いフェンス値
+        std::unique_ptr<RenderTargetHandles> rt;            // 破棄待ちの RT セット
     };
-    std::deque<Item> m_rts;                                 // 擪łÂitFXlj
+    std::deque<Item> m_rts;                                 // 先頭＝最も古い（小さいフェンス値）
 };
 
 /*
-    ݊wpiKV[Ăяo̕ێpj
+    互換ヘルパ（レガシー呼び出し名の保持用）
     ------------------------------------------------------------------------
-    R[h EnqueueRenderTarget(q, fence, std::move(rt)) cĂꍇɁA
-    V APIiGpuGarbageQueue::EnqueueRTjĂяobpB
+    既存コードに EnqueueRenderTarget(q, fence, std::move(rt)) が残っている場合に、
+    新 API（GpuGarbageQueue::EnqueueRT）を呼び出す薄いラッパ。
 */
 void EnqueueRenderTarget(GpuGarbageQueue& q, UINT64 fenceValue, RenderTargetHandles&& rt);
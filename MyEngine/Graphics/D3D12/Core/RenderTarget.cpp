@@ -3,8 +3,8 @@
 #include "Editor/ImGuiLayer.h" 
 
 // ----------------------------------------------------------------------------
-// ړIFƂŃNbV/ǐՂ₷悤ARTǂ̏u/Ԃɂ邩oB
-//       iyʃOBKvȂ{iK[ɒuj
+// 目的：あとでクラッシュ解析/寿命追跡しやすいよう、RTがどの瞬間/状態にあるかを出す。
+//       （軽量ログ。必要なら本格ロガーに置き換え）
 // ----------------------------------------------------------------------------
 #include <sstream>
 static void RT_LogPtr(const char* tag, ID3D12Resource* color, ID3D12Resource* depth)
@@ -16,8 +16,8 @@ static void RT_LogPtr(const char* tag, ID3D12Resource* color, ID3D12Resource* de
 
 
 // ----------------------------------------------------------------------------
-// DX_CALLFHRESULT `FbNđ return falseBRenderTarget.*  bool Ԃ݌vB
-//           {ԃR[hł͗O or OtG[R[hԋpȂǂɒuOKB
+// DX_CALL：HRESULT をチェックして即 return false。RenderTarget.* は bool を返す設計。
+//           ※本番コードでは例外 or ログ付エラーコード返却などに置き換えてOK。
 // ----------------------------------------------------------------------------
 #ifndef DX_CALL
 #define DX_CALL(x) do {                                           \
@@ -34,108 +34,108 @@ static void RT_LogPtr(const char* tag, ID3D12Resource* color, ID3D12Resource* de
 
 // ============================================================================
 // Create
-// FRenderTargetDesc(d) ɏ] Color/Depth \[X RTV/DSV q[v𐶐B
-// OFdev != nullptr, d.width/height > 0
-// ӁFԂ COLOR=RENDER_TARGET, DEPTH=DEPTH_WRITE ɂĂiClearɎgjB
-//       sRGB KvȂtH[}bgpCvCœꂷiBackBufferƍӁjB
+// 役割：RenderTargetDesc(d) に従って Color/Depth リソースと RTV/DSV ヒープを生成。
+// 前提：dev != nullptr, d.width/height > 0
+// 注意：初期状態は COLOR=RENDER_TARGET, DEPTH=DEPTH_WRITE にしておく（Clear直後に使える）。
+//       sRGB が必要ならフォーマットやパイプライン側で統一する（BackBufferと混同注意）。
 // ============================================================================
 bool RenderTarget::Create(ID3D12Device* dev, const RenderTargetDesc& d)
 {
     if (!dev) return false;
-    if (d.width == 0 || d.height == 0) return false; // 0TCY쐬֎~isANZXh~j
+    if (d.width == 0 || d.height == 0) return false; // ★0サイズ作成禁止（不正アクセス防止）
 
-    // ݒێiResize Ŏg񂷁j
+    // 設定を保持（Resize で使い回す）
     m_desc = d;
 
-    // --- RTV heapiColorpj ---
+    // --- RTV heap（Color用） ---
     {
         D3D12_DESCRIPTOR_HEAP_DESC r{};
         r.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
-        r.NumDescriptors = 1;                                 // PRTV
-        r.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;            // CPUp
+        r.NumDescriptors = 1;                                 // 単一RTV
+        r.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;            // CPU専用
         DX_CALL(dev->CreateDescriptorHeap(&r, IID_PPV_ARGS(&m_rtvHeap)));
         m_rtv = m_rtvHeap->GetCPUDescriptorHandleForHeapStart();
     }
 
-    //  Color/Depth ̗Ŏguʁvq[vvpeBOɏo
-    CD3DX12_HEAP_PROPERTIES hp(D3D12_HEAP_TYPE_DEFAULT);      // GPU[J
+    // ★ Color/Depth の両方で使う「共通」ヒーププロパティを外側に出す
+    CD3DX12_HEAP_PROPERTIES hp(D3D12_HEAP_TYPE_DEFAULT);      // GPUローカル
 
-    // --- Color eNX`{ ---
+    // --- Color テクスチャ本体 ---
     {
         // Tex2D(desc, width, height, arraySize=1, mipLevels=1)
         auto rd = CD3DX12_RESOURCE_DESC::Tex2D(d.colorFormat, d.width, d.height);
-        rd.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;   // RTV ƂĎgp
+        rd.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;   // RTV として使用
 
-        // Clear̍œKpli_[^[QbgColorZbgj
+        // Clear時の最適化用値（レンダーターゲットはColorをセット）
         D3D12_CLEAR_VALUE c{};
         c.Format = d.colorFormat;
         memcpy(c.Color, d.clearColor, sizeof(float) * 4);
 
-        // Ԃ RENDER_TARGET ɂĂƁÂ܂ Clear/Bind ł
+        // 初期状態を RENDER_TARGET にしておくと、そのまま Clear/Bind できる
         DX_CALL(dev->CreateCommittedResource(
             &hp, D3D12_HEAP_FLAG_NONE, &rd,
             D3D12_RESOURCE_STATE_RENDER_TARGET, &c, IID_PPV_ARGS(&m_color)));
 
-        // RTV 쐬iftHgLqqj
+        // RTV 作成（デフォルト記述子）
         dev->CreateRenderTargetView(m_color.Get(), nullptr, m_rtv);
-        m_colorState = D3D12_RESOURCE_STATE_RENDER_TARGET; // Ԃ킹ioAv̋N_j
+        m_colorState = D3D12_RESOURCE_STATE_RENDER_TARGET; // 内部状態を合わせる（バリア計画の起点）
     }
 
-    // --- DepthiKvȏꍇ̂݁j---
+    // --- Depth（必要な場合のみ）---
     if (d.depthFormat != DXGI_FORMAT_UNKNOWN) {
-        // DSV heapiCPUpj
+        // DSV heap（CPU専用）
         D3D12_DESCRIPTOR_HEAP_DESC dh{};
         dh.Type = D3D12_DESCRIPTOR_HEAP_TYPE_DSV;
         dh.NumDescriptors = 1;
         DX_CALL(dev->CreateDescriptorHeap(&dh, IID_PPV_ARGS(&m_dsvHeap)));
         m_dsv = m_dsvHeap->GetCPUDescriptorHandleForHeapStart();
 
-        // Depth eNX`{
+        // Depth テクスチャ本体
         auto dd = CD3DX12_RESOURCE_DESC::Tex2D(d.depthFormat, d.width, d.height);
         dd.Flags = D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
 
         D3D12_CLEAR_VALUE dc{};
         dc.Format = d.depthFormat;
-        dc.DepthStencil.Depth = d.clearDepth;    //  1.0
-        // Stencil gꍇ .Stencil K؂
+        dc.DepthStencil.Depth = d.clearDepth;    // 既定 1.0
+        // Stencil を使う場合は .Stencil も適切に
 
         DX_CALL(dev->CreateCommittedResource(
-            &hp, D3D12_HEAP_FLAG_NONE, &dd,     //  ʂ hp ̂܂ܗp
+            &hp, D3D12_HEAP_FLAG_NONE, &dd,     // ← 共通の hp をそのまま利用
             D3D12_RESOURCE_STATE_DEPTH_WRITE, &dc, IID_PPV_ARGS(&m_depth)));
 
-        // DSV 쐬
+        // DSV 作成
         dev->CreateDepthStencilView(m_depth.Get(), nullptr, m_dsv);
     }
 
 #ifdef _DEBUG
-    // ̃qgiVS/PIX ŒH₷j
+    // 可視化時のヒント名（VS/PIX 等で辿りやすく）
     if (m_color) m_color->SetName(L"RenderTarget.Color");
     if (m_depth) m_depth->SetName(L"RenderTarget.Depth");
 #endif
 
     RT_LogPtr("Create", m_color.Get(), m_depth.Get());
 
-    // ImGui SRV ̒x쐬ɔIDNA
-    m_imguiTexId = 0; // wb_ 'mutable' w肪Oiconst\bhG邽߁j
+    // ImGui SRV の遅延作成に備えてIDをクリア
+    m_imguiTexId = 0; // ※ヘッダ側で 'mutable' 指定がある前提（constメソッドから触るため）
     return true;
 }
 
 
 // ============================================================================
 // Resize
-// F݂RTU Release() A desc V w/h  Create() B
-// ӁFGPUŎgp̉\ꍇ́AĂяoŃtFX҂ς܂ĂB
-//       ĩ\bĥ́uSȏuԂɌĂ΂vOj
+// 役割：現在のRTを一旦 Release() し、同じ desc を新しい w/h で Create() し直す。
+// 注意：GPU側で使用中の可能性がある場合は、呼び出し側でフェンス完了待ちを済ませてから。
+//       （このメソッド自体は「安全な瞬間に呼ばれる」前提）
 // ============================================================================
 bool RenderTarget::Resize(ID3D12Device* dev, UINT w, UINT h)
 {
-    if (w == 0 || h == 0) return false;                          // 0TCY͖
-    if (w == m_desc.width && h == m_desc.height) return false;   //  no-op
+    if (w == 0 || h == 0) return false;                          // 0サイズは無効
+    if (w == m_desc.width && h == m_desc.height) return false;   // 実質 no-op
 
-    RT_LogPtr("Resize.Begin", m_color.Get(), m_depth.Get());      // \[X̐mFɖ𗧂
-    Release();                                                    // QƂ؂iResizeBuffers l̍@j
+    RT_LogPtr("Resize.Begin", m_color.Get(), m_depth.Get());      // 旧リソースの生存確認に役立つ
+    Release();                                                    // 参照を切る（ResizeBuffers 同様の作法）
     m_desc.width = w; m_desc.height = h;
-    const bool ok = Create(dev, m_desc);                          // č쐬i/NAlj
+    const bool ok = Create(dev, m_desc);                          // 再作成（初期状態/クリア値も復元）
     RT_LogPtr(ok ? "Resize.End.OK" : "Resize.End.FAIL", m_color.Get(), m_depth.Get());
     return ok;
 }
@@ -143,65 +143,65 @@ bool RenderTarget::Resize(ID3D12Device* dev, UINT w, UINT h)
 
 // ============================================================================
 // Release
-// FLĂ Color/Depth Ɗeq[vJBԂlɖ߂B
-// ӁFDetach() ƈႢAgnh̏LO֓nȂhjB
-//       xjKvȂ Detach()  GpuGarbageQueue ցB
+// 役割：所有している Color/Depth と各ヒープを開放。内部状態を既定値に戻す。
+// 注意：Detach() と違い、“ハンドルの所有権を外へ渡さない”破棄。
+//       遅延破棄が必要なら Detach() → GpuGarbageQueue へ。
 // ============================================================================
 void RenderTarget::Release()
 {
-    // ImGui QƂȂ悤 SRV ID NAiSRV̂ ImGuiLayer ̃q[vj
+    // ImGui 側から参照されないよう SRV ID をクリア（SRV自体は ImGuiLayer 側のヒープ）
     m_imguiTexId = 0;
 
-    // [x  RTV ̏ŉi͌ł͂ȂAǐՂ₷j
+    // 深度 → RTV の順で解放（順序は厳密ではないが、追跡しやすく）
     m_depth.Reset();
     m_dsvHeap.Reset();
 
     m_color.Reset();
     m_rtvHeap.Reset();
 
-    // CPU nhĂiBind/Clear ̌p΍j
+    // CPU ハンドルも無効化しておく（Bind/Clear の誤用対策）
     m_rtv = {};
     m_dsv = {};
 
-    // ȍ~̃oAv̋N_ COMMON ɖ߂iSɖgpԁj
+    // 以降のバリア計画の起点を COMMON に戻す（完全に未使用状態）
     m_colorState = D3D12_RESOURCE_STATE_COMMON;
 
-    // OF͏ null ɂȂĂ͂
+    // ログ：解放後は常に null になっているはず
     RT_LogPtr("Release", m_color.Get(), m_depth.Get());
 }
 
 
 // ============================================================================
 // TransitionToRT
-// FColor \[X RENDER_TARGET ԂցiOMSetRenderTargets/Clear OɌĂԁj
-// ӁFŏԂgbLOBAJڂ͗}ĕsvȃoAB
+// 役割：Color リソースを RENDER_TARGET 状態へ（OMSetRenderTargets/Clear 前に呼ぶ）
+// 注意：内部で状態をトラッキング。連続遷移は抑制して不要なバリアを避ける。
 // ============================================================================
 void RenderTarget::TransitionToRT(ID3D12GraphicsCommandList* cmd)
 {
     if (m_colorState == D3D12_RESOURCE_STATE_RENDER_TARGET) {
-        return; // łRTԂȂ牽Ȃipj
+        return; // すでにRT状態なら何もしない（冪等）
     }
     RT_LogPtr("TransitionToRT", m_color.Get(), m_depth.Get());
     auto b = CD3DX12_RESOURCE_BARRIER::Transition(
         m_color.Get(), m_colorState, D3D12_RESOURCE_STATE_RENDER_TARGET);
     cmd->ResourceBarrier(1, &b);
-    m_colorState = D3D12_RESOURCE_STATE_RENDER_TARGET; // ԂXV
+    m_colorState = D3D12_RESOURCE_STATE_RENDER_TARGET; // 内部状態も更新
 }
 
 
 // ============================================================================
 // TransitionToSRV
-// FColor \[X PIXEL_SHADER_RESOURCE ԂցiVF[_ǂݏopj
-// ӁFSRV ̂ ImGuiLayer i{NX́gԁhڍsjB
+// 役割：Color リソースを PIXEL_SHADER_RESOURCE 状態へ（シェーダ読み出し用）
+// 注意：SRV を作るのは ImGuiLayer 側（本クラスは“状態”だけ移行）。
 // ============================================================================
 void RenderTarget::TransitionToSRV(ID3D12GraphicsCommandList* cmd)
 {
     if (m_colorState == D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE) {
-        return; // PSRȂ牽Ȃ
+        return; // 既にPSRなら何もしない
     }
     RT_LogPtr("TransitionToSRV", m_color.Get(), m_depth.Get());
     auto b = CD3DX12_RESOURCE_BARRIER::Transition(
-        m_color.Get(), m_colorState, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE); // from ͎
+        m_color.Get(), m_colorState, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE); // ★from は実状態
     cmd->ResourceBarrier(1, &b);
     m_colorState = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
 }
@@ -209,21 +209,21 @@ void RenderTarget::TransitionToSRV(ID3D12GraphicsCommandList* cmd)
 
 // ============================================================================
 // Bind
-// F݂ RTV/DSV  OM ɃoChB
-// OFRenderTargetView/DepthStencilView ͍쐬ς݁B\[X RT ԂɂĂgB
+// 役割：現在の RTV/DSV を OM にバインド。
+// 前提：RenderTargetView/DepthStencilView は作成済み。リソースは RT 状態にしてから使う。
 // ============================================================================
 void RenderTarget::Bind(ID3D12GraphicsCommandList* cmd)
 {
     RT_LogPtr("Bind", m_color.Get(), m_depth.Get());
-    // DSV ꍇ nullptr niColor ̂ݕ`j
+    // DSV が無い場合は nullptr を渡す（Color のみ描画）
     cmd->OMSetRenderTargets(1, &m_rtv, FALSE, m_depth ? &m_dsv : nullptr);
 }
 
 
 // ============================================================================
 // Clear
-// FRTV/DSV NAijB`OɌĂԂƂB
-// OFColor  RENDER_TARGETADepth  DEPTH_WRITE Ԃ]܂i͑JڂȂjB
+// 役割：RTV/DSV をクリア（初期化）。描画前に呼ぶことが多い。
+// 前提：Color は RENDER_TARGET、Depth は DEPTH_WRITE 状態が望ましい（実装は遷移を強制しない）。
 // ============================================================================
 void RenderTarget::Clear(ID3D12GraphicsCommandList* cmd)
 {
@@ -238,52 +238,52 @@ void RenderTarget::Clear(ID3D12GraphicsCommandList* cmd)
 
 // ============================================================================
 // EnsureImGuiSRV
-// FImGuiLayer  Color \[X SRV iwXbgŁj쐬/XVB
-// ߂FImTextureIDiDX12 ł GPU  SRV fBXNv^nhl߂j
-// ӁF̃\bh 'const'  m_imguiTexId XV邽߁Awb_ł 'mutable' zB
-//       slot: t[CfbNXŏՓ˂Ȃ SRV XbgitHg͒ʏ slot=0 \jB 
+// 役割：ImGuiLayer を介して Color リソースの SRV を（指定スロットで）作成/更新。
+// 戻り：ImTextureID（DX12 では GPU 可視 SRV ディスクリプタハンドルを詰めた整数）
+// 注意：このメソッドは 'const' だが m_imguiTexId を更新するため、ヘッダ側では 'mutable' を想定。
+//       slot: フレームインデックスで衝突しない SRV スロット（フォントは通常 slot=0 予約）。 
 // ============================================================================
 ImTextureID RenderTarget::EnsureImGuiSRV(ImGuiLayer* imgui, UINT slot) const
 {
     if (!m_imguiTexId) {
-        // ImGuiLayer  SRV 쐬iDX12  ImTextureID=GPUnhj
+        // ImGuiLayer 側で SRV を作成（DX12 の ImTextureID=GPUハンドル）
         m_imguiTexId = imgui->CreateOrUpdateTextureSRV(m_color.Get(), m_desc.colorFormat, slot);
         RT_LogPtr("ImGuiSRV.Create", m_color.Get(), m_depth.Get());
     }
-    // ɍ쐬ς݂Ȃ炻̂܂ܕԂiImGui ł͓IDg񂷁j
+    // 既に作成済みならそのまま返す（ImGui 側では同じIDを使い回す）
     return m_imguiTexId;
 }
 
 
 // ============================================================================
 // Detach
-// FLĂ Color/Depth/eq[v CPUnh RenderTargetHandles ƂāghԂB
-//        ĂяoiFViewports/Rendererj GpuGarbageQueue ɐςŁuGPUɔjvłB
-// ӁF̃CX^X́ghԂɂȂiTCY=0, state=COMMON, SRV ID ZbgjB
+// 役割：所有している Color/Depth/各ヒープと CPUハンドルを RenderTargetHandles として“引き剥がし”返す。
+//       → 呼び出し側（例：Viewports/Renderer）が GpuGarbageQueue に積んで「GPU完了後に破棄」できる。
+// 注意：このインスタンス側は“空”状態になる（サイズ=0, state=COMMON, SRV ID リセット）。
 // ============================================================================
 RenderTargetHandles RenderTarget::Detach()
 {
-    // OFdetach gRTh̃AhXfiNbV̒ǐՂɗLj
+    // ログ：detach する“旧RT”のアドレスを吐く（クラッシュ時の追跡に有効）
     RT_LogPtr("Detach.Before", m_color.Get(), m_depth.Get());
 
     RenderTargetHandles out{};
-    // ComPtr ̏L out ɈڂiRenderTarget͐؂藣j
+    // ComPtr の所有権を out に移す（このRenderTargetからは切り離される）
     out.color = std::move(m_color);
     out.depth = std::move(m_depth);
     out.rtvHeap = std::move(m_rtvHeap);
     out.dsvHeap = std::move(m_dsvHeap);
-    // CPU nh̓Rs[inĥ͌yʁBOOMSetɎgj
+    // CPU ハンドルはコピー（ハンドル自体は軽量。外側でOMSet時に使える）
     out.rtv = m_rtv;
     out.dsv = m_dsv;
 
-    // g͊SɁgh֖߂
+    // 自身は完全に“空”へ戻す
     m_rtv = {};
     m_dsv = {};
-    m_imguiTexId = 0;                              // ImGui QƂȂ悤
-    m_colorState = D3D12_RESOURCE_STATE_COMMON;    // oAv̋N_
-    m_desc.width = m_desc.height = 0;              // 0x0 ƂĈipoɖ𗧂j
+    m_imguiTexId = 0;                              // ImGui 側から参照されないように
+    m_colorState = D3D12_RESOURCE_STATE_COMMON;    // バリア計画の起点へ
+    m_desc.width = m_desc.height = 0;              // 0x0 として扱う（誤用検出に役立つ）
 
-    // OFdetach  out ɈڂAhXoiL[̎ǐՂyɂȂj
+    // ログ：detach 後に out に移ったアドレスも出す（キューの寿命追跡が楽になる）
     RT_LogPtr("Detach.After(out)", out.color.Get(), out.depth.Get());
     return out;
 }
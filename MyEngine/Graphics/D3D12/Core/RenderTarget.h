@@ -11,53 +11,53 @@
 /*
     RenderTarget.h
     ----------------------------------------------------------------------------
-    F
-      - ItXN[`p Color/Depth eNX`ƁA RTV/DSV ЂƂ܂Ƃ߂ɊǗB
-      - 쐬(Create)^(Release)^TCYύX(Resize)^ԑJ(Transition*)^
-        oCh/NA(Bind/Clear) ƂȂ񋟁B
-      - ImGui ֕\邽߂ SRViImTextureIDjAOq[viImGuiLayerjɍ쐬B
-
-    ݌ṽ|CgF
-      - RenderTargetDesccKv\ȍ쐬p[^iw/h/format/NAljێB
-      - ԃgbLOcColor ̒߂ D3D12_RESOURCE_STATE ێA
-        svȃoA}ip TransitionToRT/TransitionToSRVjB
-      - Detach() c ̃CX^X̏L\[X RenderTargetHandles Ɉ
-        ԂíghɁjBGPU ҂̒xjL[֍ڂprzB
-      - ImGui SRV c DX12  ImTextureID  GPU  SRV nhiUINT64jB
-        SRV ̂ ImGuiLayer ̃q[vɍ邽߁A{NX ID ̃LbV݂̂B
+    役割：
+      - オフスクリーン描画用の Color/Depth テクスチャと、その RTV/DSV をひとまとめに管理。
+      - 作成(Create)／解放(Release)／サイズ変更(Resize)／状態遷移(Transition*)／
+        バインド/クリア(Bind/Clear) といった一連の操作を提供。
+      - ImGui へ表示するための SRV（ImTextureID）を、外部ヒープ（ImGuiLayer）に作成。
+
+    設計のポイント：
+      - RenderTargetDesc…必要十分な作成パラメータ（w/h/format/クリア値）を保持。
+      - 内部状態トラッキング…Color の直近の D3D12_RESOURCE_STATE を保持し、
+        不要なバリアを抑制（冪等な TransitionToRT/TransitionToSRV）。
+      - Detach() … このインスタンスの所有リソースを RenderTargetHandles に引き剥がして
+        返す（自分は“空”に）。GPU 完了待ちの遅延破棄キューへ載せる用途を想定。
+      - ImGui SRV … DX12 の ImTextureID は GPU 可視 SRV ハンドル（UINT64相当）。
+        SRV 自体は ImGuiLayer 側のヒープに作るため、本クラスは ID のキャッシュのみを持つ。
 */
 
-class ImGuiLayer; // SRV 쐬Ϗ郌CiO錾j
+class ImGuiLayer; // SRV 作成を委譲するレイヤ（前方宣言）
 
 // ----------------------------------------------------------------------------
-// RenderTargetDescFRT 쐬p[^
+// RenderTargetDesc：RT 作成パラメータ
 // ----------------------------------------------------------------------------
 struct RenderTargetDesc
 {
-    UINT        width = 0;                                      // eNX`ipxj
-    UINT        height = 0;                                      // eNX`ipxj
-    DXGI_FORMAT colorFormat = DXGI_FORMAT_R8G8B8A8_UNORM;        // Color  DXGI tH[}bg
-    DXGI_FORMAT depthFormat = DXGI_FORMAT_D32_FLOAT;             // Depth  DXGI tH[}bgisvȂ UNKNOWN wj
-    float       clearColor[4] = { 0, 0, 0, 1 };                  // RTV NAFiCreate ̍œKlɂgpj
-    float       clearDepth = 1.0f;                               // DSV NA[x
+    UINT        width = 0;                                      // テクスチャ幅（px）
+    UINT        height = 0;                                      // テクスチャ高さ（px）
+    DXGI_FORMAT colorFormat = DXGI_FORMAT_R8G8B8A8_UNORM;        // Color の DXGI フォーマット
+    DXGI_FORMAT depthFormat = DXGI_FORMAT_D32_FLOAT;             // Depth の DXGI フォーマット（不要なら UNKNOWN を指定）
+    float       clearColor[4] = { 0, 0, 0, 1 };                  // RTV クリア色（Create 時の最適化値にも使用）
+    float       clearDepth = 1.0f;                               // DSV クリア深度
 };
 
 // ----------------------------------------------------------------------------
-// RenderTargetHandlesFDetach() ŊOցgLڏh鑩
-//   - GpuGarbageQueue ɃtFXƕRtĒxjP[XŎgpB
-//   - CPU fBXNv^nh̓Rs[ŎoAComPtr  move ŏLnB
+// RenderTargetHandles：Detach() で外へ“所有権移譲”する束
+//   - GpuGarbageQueue にフェンスと紐付けて遅延破棄するケースで使用。
+//   - CPU ディスクリプタハンドルはコピーで持ち出し、ComPtr は move で所有権を渡す。
 // ----------------------------------------------------------------------------
 struct RenderTargetHandles {
-    Microsoft::WRL::ComPtr<ID3D12Resource>       color;          // Color eNX`
-    Microsoft::WRL::ComPtr<ID3D12Resource>       depth;          // Depth eNX`iCӁj
-    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> rtvHeap;        // RTV p CPU q[vi1Ggj
-    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> dsvHeap;        // DSV p CPU q[vi1Ggj
-    D3D12_CPU_DESCRIPTOR_HANDLE                  rtv{};          // RTV  CPU nh
-    D3D12_CPU_DESCRIPTOR_HANDLE                  dsv{};          // DSV  CPU nh
+    Microsoft::WRL::ComPtr<ID3D12Resource>       color;          // Color テクスチャ
+    Microsoft::WRL::ComPtr<ID3D12Resource>       depth;          // Depth テクスチャ（任意）
+    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> rtvHeap;        // RTV 用の CPU 可視ヒープ（1エントリ）
+    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> dsvHeap;        // DSV 用の CPU 可視ヒープ（1エントリ）
+    D3D12_CPU_DESCRIPTOR_HANDLE                  rtv{};          // RTV の CPU ハンドル
+    D3D12_CPU_DESCRIPTOR_HANDLE                  dsv{};          // DSV の CPU ハンドル
 };
 
 // ----------------------------------------------------------------------------
-// RenderTargetFColor/Depth + RTV/DSV ܂Ƃ߂Ėʓ|郆[eBeB
+// RenderTarget：Color/Depth + RTV/DSV をまとめて面倒を見るユーティリティ
 // ----------------------------------------------------------------------------
 class RenderTarget
 {
@@ -65,62 +65,62 @@ public:
     /*
         Create
         ------------------------------------------------------------------------
-         : RenderTargetDesc ɏ] Color/Depth \[X RTV/DSV 𐶐B
-        O : dev != nullptr, width/height > 0
-         : Ԃ Color=RENDER_TARGET, Depth=DEPTH_WRITEiNAɎgpjB
-               sRGB Kvȏꍇ́AtH[}bgpCvCœꂷ邱ƁB
+        役割 : RenderTargetDesc に従って Color/Depth リソースと RTV/DSV を生成。
+        前提 : dev != nullptr, width/height > 0
+        注意 : 初期状態は Color=RENDER_TARGET, Depth=DEPTH_WRITE（クリア直後に使用可）。
+               sRGB が必要な場合は、フォーマット整合やパイプライン側で統一すること。
     */
     bool Create(ID3D12Device* dev, const RenderTargetDesc& d);
 
     /*
         Release
         ------------------------------------------------------------------------
-         : LĂ Color/Depth ƊefBXNv^q[vAԂɖ߂B
-         : gLO֓nȂhjBGPU Ŏgp̉\Ȃ Detach() gA
-               j GpuGarbageQueue ɈϏ邱ƁB
+        役割 : 所有している Color/Depth と各ディスクリプタヒープを解放し、空状態に戻す。
+        注意 : “所有権を外へ渡さない”破棄。GPU で使用中の可能性があるなら Detach() を使い、
+               破棄は GpuGarbageQueue に委譲すること。
     */
     void Release();
 
     /*
         Resize
         ------------------------------------------------------------------------
-         : ݂ RT  Release()VTCY Create() B
-        ߂ : /s
-         : ĂяoŃtFX҂ĂsƁiSȃ^C~OŌĂԑOjB
+        役割 : 現在の RT を Release()→新しいサイズで Create() し直す。
+        戻り : 成功/失敗
+        注意 : 呼び出し側でフェンス完了を待ってから行うこと（安全なタイミングで呼ぶ前提）。
     */
     bool Resize(ID3D12Device* dev, UINT w, UINT h);
 
     // ------------------------------------------------------------------------
-    // pX擪/ł̃[eBeBFԃgbLOt̙poA
+    // パス先頭/末尾でのユーティリティ：内部状態トラッキング付きの冪等バリア
     // ------------------------------------------------------------------------
 
-    // OMSetRenderTargets / Clear OɌĂԁFColor  RENDER_TARGET
+    // OMSetRenderTargets / Clear 前に呼ぶ：Color → RENDER_TARGET
     void TransitionToRT(ID3D12GraphicsCommandList* cmd);
 
-    // VF[_ǂݏoprŎgOɌĂԁFColor  PIXEL_SHADER_RESOURCE
+    // シェーダ読み出し用途で使う前に呼ぶ：Color → PIXEL_SHADER_RESOURCE
     void TransitionToSRV(ID3D12GraphicsCommandList* cmd);
 
-    // ݂ RTV/DSV  OM oChiDSV  nullptrj
+    // 現在の RTV/DSV を OM バインド（DSV 無ければ nullptr）
     void Bind(ID3D12GraphicsCommandList* cmd);
 
-    // RTV/DSV NAiColor  m_desc.clearColorADepth  m_desc.clearDepthj
+    // RTV/DSV をクリア（Color は m_desc.clearColor、Depth は m_desc.clearDepth）
     void Clear(ID3D12GraphicsCommandList* cmd);
 
     // ------------------------------------------------------------------------
-    // ImGui \
+    // ImGui 表示
     // ------------------------------------------------------------------------
     /*
         EnsureImGuiSRV
-         : ImGuiLayer  Color \[X SRV iwXbgɁj쐬/XVA
-               ImTextureIDi=GPU  SRV nhjԂB
-         : {NX SRV q[vȂBSRV ̂ ImGuiLayer ɍ쐬B
-               'const' \bh ID LbV邽 m_imguiTexId  mutableB
+        役割 : ImGuiLayer を介して Color リソースの SRV を（指定スロットに）作成/更新し、
+               ImTextureID（=GPU 可視 SRV ハンドル）を返す。
+        注意 : 本クラスは SRV ヒープを持たない。SRV 自体は ImGuiLayer 側に作成。
+               'const' メソッドだが ID キャッシュを書き換えるため m_imguiTexId は mutable。
     */
     ImTextureID EnsureImGuiSRV(ImGuiLayer* imgui, UINT slot) const;
 
     // ------------------------------------------------------------------------
-    // QƌniSFColor  Width/Height  0 Ԃ̂z
-    //         {ł m_desc ^ƂBgp Color()  null 𕹂ĊmFj
+    // 参照系（安全側：Color が無ければ Width/Height は 0 を返すのが理想だが
+    //         本実装では m_desc を真とする。使用側は Color() の null を併せて確認を）
     // ------------------------------------------------------------------------
     UINT         Width()       const { return m_desc.width; }
     UINT         Height()      const { return m_desc.height; }
@@ -130,32 +130,32 @@ public:
     /*
         Detach
         ------------------------------------------------------------------------
-         : Color/Depth/eq[v CPU nh RenderTargetHandles ƂāghԂB
-               ̃CX^X͊SɁgh֖߂iSRV ID jB
-        pr : TCYȂǁAÂ RT  GPU ɔjꍇɁA
-               GpuGarbageQueue ֐ςނ߂̏LڏɎgpB
+        役割 : Color/Depth/各ヒープと CPU ハンドルを RenderTargetHandles として“引き剥がし”返す。
+               このインスタンス側は完全に“空”へ戻る（SRV ID も無効化）。
+        用途 : リサイズ時など、古い RT を GPU 完了後に破棄したい場合に、
+               GpuGarbageQueue へ積むための所有権移譲に使用。
     */
     RenderTargetHandles Detach();
 
 private:
-    // 쐬p[^iResize ɂėpj
+    // 作成パラメータ（Resize 時にも再利用）
     RenderTargetDesc m_desc{};
 
-    // {̃\[X
-    Microsoft::WRL::ComPtr<ID3D12Resource>            m_color;   // K{FColor eNX`
-    Microsoft::WRL::ComPtr<ID3D12Resource>            m_depth;   // CӁFDepth eNX`
+    // 本体リソース
+    Microsoft::WRL::ComPtr<ID3D12Resource>            m_color;   // 必須：Color テクスチャ
+    Microsoft::WRL::ComPtr<ID3D12Resource>            m_depth;   // 任意：Depth テクスチャ
 
-    // fBXNv^q[viCPU j
-    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>      m_rtvHeap; // RTV 1 m
-    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>      m_dsvHeap; // DSV 1 m
+    // ディスクリプタヒープ（CPU 可視）
+    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>      m_rtvHeap; // RTV 1 つだけ確保
+    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>      m_dsvHeap; // DSV 1 つだけ確保
 
-    // CPU nhiOMSet/Clear pj
+    // CPU ハンドル（OMSet/Clear 用）
     D3D12_CPU_DESCRIPTOR_HANDLE                       m_rtv{};
     D3D12_CPU_DESCRIPTOR_HANDLE                       m_dsv{};
 
-    // ImGui p SRV  IDiDX12 ł GPU  SRV nhi[j
+    // ImGui 用 SRV の ID（DX12 では GPU 可視 SRV ハンドルが格納される）
     mutable ImTextureID                               m_imguiTexId = 0;
 
-    // Color \[X́gݏԁhgbNipoÂ߁j
+    // Color リソースの“現在状態”をトラック（冪等バリアのため）
     D3D12_RESOURCE_STATES m_colorState = D3D12_RESOURCE_STATE_COMMON;
 };
@@ -0,0 +1,166 @@
+﻿#include "Core/UploadRing.h"
+#include "d3dx12.h"
+#include <utility>
+
+using Microsoft::WRL::ComPtr;
+
+/*
+    UploadRing
+    ----------------------------------------------------------------------------
+    ページの状態遷移：
+        空き(m_free) ──Acquire──▶ 使用中(m_current) ──満杯──▶ m_usedThisFrame
+              ▲                                                    │
+              └──BeginFrame(completed >= fence)── 退役(m_retired) ◀─EndFrame(fence)
+    注意：
+      - 専用ページ（size > m_pageSize）は退役後に空きへ戻さず、その場で解放する。
+      - DeferRelease したリソースは Retired::released に入り、退役エントリごと解放される。
+      - Destroy は無条件に解放する。必ず GPU 完了待ち（FrameScheduler::WaitIdle）後に呼ぶこと。
+*/
+
+namespace
+{
+    std::uint64_t AlignUp(std::uint64_t v, std::uint64_t a) { return (v + (a - 1)) & ~(a - 1); }
+}
+
+bool UploadRing::Initialize(ID3D12Device* dev, std::uint64_t pageSize)
+{
+    if (!dev) return false;
+    Initialize([dev](std::uint64_t bytes, UploadPage& out) -> bool
+        {
+            auto heap = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+            auto desc = CD3DX12_RESOURCE_DESC::Buffer(bytes);
+            ComPtr<ID3D12Resource> res;
+            if (FAILED(dev->CreateCommittedResource(&heap, D3D12_HEAP_FLAG_NONE, &desc,
+                D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&res))))
+                return false;
+
+            // 常時 Map（CPU は書くだけなので読み取り範囲は空）
+            CD3DX12_RANGE rr(0, 0);
+            void* cpu = nullptr;
+            if (FAILED(res->Map(0, &rr, &cpu))) return false;
+
+            out.resource = std::move(res);
+            out.cpu = static_cast<std::uint8_t*>(cpu);
+            out.gpu = out.resource->GetGPUVirtualAddress();
+            out.size = bytes;
+            return true;
+        }, pageSize);
+    return true;
+}
+
+void UploadRing::Initialize(PageFactory factory, std::uint64_t pageSize)
+{
+    Destroy();
+    m_factory = std::move(factory);
+    m_pageSize = AlignUp(pageSize > 0 ? pageSize : kDefaultPageSize, 256);
+}
+
+void UploadRing::Destroy()
+{
+    // UPLOAD リソースは Unmap せずに Release してよい（解放で Map も外れる）
+    m_hasCurrent = false;
+    m_current = UploadPage();
+    m_offset = 0;
+    m_usedThisFrame.clear();
+    m_releaseThisFrame.clear();
+    m_retired.clear();
+    m_free.clear();
+    m_stats = UploadRingStats();
+}
+
+void UploadRing::BeginFrame(std::uint64_t completedFence)
+{
+    // 先頭から「完了済み（<= completed）」のものだけ空きへ戻す（フェンス値は昇順に積まれている）
+    while (!m_retired.empty() && m_retired.front().fence <= completedFence)
+    {
+        for (UploadPage& p : m_retired.front().pages)
+        {
+            if (p.size == m_pageSize) m_free.push_back(std::move(p));
+            else                      --m_stats.pages; // 専用ページは解放
+        }
+        m_retired.pop_front();
+    }
+    m_stats.freePages = static_cast<std::uint32_t>(m_free.size());
+}
+
+bool UploadRing::AcquirePage(std::uint64_t minBytes)
+{
+    if (m_hasCurrent) m_usedThisFrame.push_back(std::move(m_current));
+    m_hasCurrent = false;
+    m_current = UploadPage();
+    m_offset = 0;
+
+    if (minBytes <= m_pageSize && !m_free.empty())
+    {
+        m_current = std::move(m_free.back());
+        m_free.pop_back();
+    }
+    else
+    {
+        // 空きが無い or 大きすぎる → 新しく作る（伸長）
+        const std::uint64_t size = (minBytes <= m_pageSize) ? m_pageSize : AlignUp(minBytes, 256);
+        if (!m_factory || !m_factory(size, m_current) || !m_current.cpu)
+        {
+            m_current = UploadPage();
+            return false;
+        }
+        m_current.size = size;
+        ++m_stats.pages;
+        ++m_stats.pagesCreated;
+    }
+    m_hasCurrent = true;
+    m_stats.freePages = static_cast<std::uint32_t>(m_free.size());
+    return true;
+}
+
+UploadAllocation UploadRing::Allocate(std::uint64_t bytes, std::uint64_t align)
+{
+    UploadAllocation a;
+    if (bytes == 0) bytes = 1;
+    if (align == 0) align = 1;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::uint64_t offset = AlignUp(m_offset, align);
+    if (!m_hasCurrent || offset + bytes > m_current.size)
+    {
+        // ページ先頭はどのページも 64KB 境界（コミット済みリソース）なので align は満たされる
+        if (!AcquirePage(bytes)) return a;
+        offset = 0;
+    }
+
+    a.cpu = m_current.cpu + offset;
+    a.gpu = m_current.gpu + offset;
+    a.size = bytes;
+    a.resource = m_current.resource.Get();
+    a.offset = offset;
+    m_stats.bytesThisFrame += (offset + bytes) - m_offset;
+    m_offset = offset + bytes;
+    return a;
+}
+
+void UploadRing::EndFrame(std::uint64_t fenceValue)
+{
+    if (m_hasCurrent) m_usedThisFrame.push_back(std::move(m_current));
+    m_hasCurrent = false;
+    m_current = UploadPage();
+    m_offset = 0;
+
+    if (!m_usedThisFrame.empty() || !m_releaseThisFrame.empty())
+    {
+        Retired r;
+        r.fence = fenceValue;
+        r.pages.swap(m_usedThisFrame);
+        r.released.swap(m_releaseThisFrame);
+        m_retired.push_back(std::move(r));
+    }
+    m_stats.bytesLastFrame = m_stats.bytesThisFrame;
+    m_stats.bytesThisFrame = 0;
+}
+
+void UploadRing::DeferRelease(ComPtr<ID3D12Resource> res)
+{
+    if (!res) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_releaseThisFrame.push_back(std::move(res));
+}
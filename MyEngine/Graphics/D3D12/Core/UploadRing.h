@@ -0,0 +1,131 @@
+﻿#pragma once
+#include <wrl/client.h>
+#include <d3d12.h>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/*
+    UploadRing
+    ----------------------------------------------------------------------------
+    目的：
+      - 毎フレーム書き捨てる GPU 定数/インスタンスデータ用の、伸長するアップロードアロケータ。
+        固定スロット（MaxObjects × 256B）を置き換え、オブジェクト数・パス数に上限を設けない。
+      - 大きなアップロードページ（既定 1MB、常時 Map）の中を先頭から線形に切り出す。
+        足りなくなったら空きページを取るか、新しく作る（= 使用量に合わせて伸びる）。
+      - 使い終わったページは「そのフレームの Signal 値」で寿命を管理し、
+        GPU が到達したら空きページへ戻す（GpuGarbageQueue と同じ FIFO + フェンス値方式）。
+
+    想定フロー（FrameScheduler が呼ぶ）：
+      1) BeginFrame(completedFence) …… 完了したフレームのページを空きへ戻す
+      2) Allocate(bytes, align)     …… 記録中に何度でも（CB は 256B 境界）
+      3) EndFrame(signalValue)      …… このフレームで触ったページに Signal 値を付けて退役させる
+
+    設計メモ：
+      - ページはフレームをまたいで共有しない（EndFrame で使いかけのページも退役させる）。
+        → フレームごとの寿命が 1 つのフェンス値で表せ、取り違えが起きない。
+      - ページサイズを超える要求は専用ページを作る。専用ページは退役後に再利用せず解放する。
+      - ページの作成は PageFactory に委譲する。既定は UPLOAD ヒープのコミット済みバッファ。
+        テストではフェイクのファクトリ（CPU メモリ）を渡せば GPU 無しで寿命管理を確認できる。
+      - フェンス値は単調増加が前提。
+      - Allocate/DeferRelease は内部でロックするので、記録スレッドが複数あっても同時に呼べる
+        （Scene/Game を別スレッドで記録する場合など）。BeginFrame/EndFrame は記録が全部終わってから
+        1 スレッドで呼ぶこと。
+      - DeferRelease で渡したリソースも同じ寿命（このフレームの Signal 値）で解放する。
+        伸長で差し替えた GPU バッファなど「このフレームのコマンドがまだ参照しうる」ものに使う。
+*/
+
+/// Allocate の結果（cpu が nullptr なら失敗）
+struct UploadAllocation
+{
+    std::uint8_t*             cpu = nullptr; ///< 書き込み先（常時 Map 済み）
+    D3D12_GPU_VIRTUAL_ADDRESS gpu = 0;       ///< GPU から読むアドレス（CBV/SRV に渡す）
+    std::uint64_t             size = 0;      ///< 確保したバイト数（要求サイズそのまま）
+    ID3D12Resource*           resource = nullptr; ///< 切り出し元のページ（CopyBufferRegion の転送元。フェイクでは nullptr）
+    std::uint64_t             offset = 0;    ///< resource 内の先頭オフセット
+};
+
+/// アップロードページ 1 枚
+struct UploadPage
+{
+    Microsoft::WRL::ComPtr<ID3D12Resource> resource; ///< UPLOAD バッファ（フェイクでは空でもよい）
+    std::uint8_t*                          cpu = nullptr;
+    D3D12_GPU_VIRTUAL_ADDRESS              gpu = 0;
+    std::uint64_t                          size = 0;
+};
+
+/// 使用状況（デバッグ/Stats 表示用）
+struct UploadRingStats
+{
+    std::uint32_t pages = 0;          ///< 保持しているページ数（使用中 + 退役待ち + 空き）
+    std::uint32_t freePages = 0;      ///< すぐ使える空きページ数
+    std::uint32_t pagesCreated = 0;   ///< これまでに作ったページ数（伸長の回数）
+    std::uint64_t bytesThisFrame = 0; ///< 今フレームに切り出したバイト数（パディング込み）
+    std::uint64_t bytesLastFrame = 0; ///< 直前のフレームに切り出したバイト数
+};
+
+class UploadRing
+{
+public:
+    /// ページを 1 枚作る関数（bytes 以上のサイズで out を埋めて true）
+    using PageFactory = std::function<bool(std::uint64_t bytes, UploadPage& out)>;
+
+    static constexpr std::uint64_t kDefaultPageSize = 1024 * 1024;
+
+    /**
+     * @brief UPLOAD ヒープのページを作るアロケータとして初期化する
+     * @param dev      ページを作るデバイス
+     * @param pageSize 通常ページのサイズ（256 の倍数に切り上げ）
+     */
+    bool Initialize(ID3D12Device* dev, std::uint64_t pageSize = kDefaultPageSize);
+
+    /// ページの作り方を差し替えて初期化する（テスト用のフェイク等）
+    void Initialize(PageFactory factory, std::uint64_t pageSize = kDefaultPageSize);
+
+    /// 全ページを解放する（GPU 完了待ち済みで呼ぶこと）
+    void Destroy();
+
+    /// completedFence 以下の値で退役したページを空きへ戻す
+    void BeginFrame(std::uint64_t completedFence);
+
+    /**
+     * @brief bytes バイトを align 境界で切り出す
+     * @param align 2 の冪。CB は D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT（256）
+     * @return 失敗（ページ作成失敗）なら cpu == nullptr
+     */
+    UploadAllocation Allocate(std::uint64_t bytes, std::uint64_t align = 256);
+
+    /// このフレームで使ったページを fenceValue で退役させる
+    void EndFrame(std::uint64_t fenceValue);
+
+    /// res をこのフレームのページと一緒に退役させ、GPU が到達したら解放する
+    void DeferRelease(Microsoft::WRL::ComPtr<ID3D12Resource> res);
+
+    const UploadRingStats& Stats() const { return m_stats; }
+    std::uint64_t          PageSize() const { return m_pageSize; }
+
+private:
+    struct Retired
+    {
+        std::uint64_t           fence = 0;
+        std::vector<UploadPage> pages;
+        std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> released; ///< DeferRelease されたもの
+    };
+
+    bool AcquirePage(std::uint64_t minBytes);
+
+    PageFactory             m_factory;
+    std::uint64_t           m_pageSize = kDefaultPageSize;
+
+    bool                    m_hasCurrent = false;
+    UploadPage              m_current;         ///< 切り出し中のページ
+    std::uint64_t           m_offset = 0;      ///< m_current 内の次の位置
+    std::vector<UploadPage> m_usedThisFrame;   ///< 今フレームで使い切ったページ
+    std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> m_releaseThisFrame; ///< 今フレームの DeferRelease
+    std::deque<Retired>     m_retired;         ///< 先頭 = 最も古い（小さいフェンス値）
+    std::vector<UploadPage> m_free;            ///< 再利用できる通常ページ
+    UploadRingStats         m_stats;
+    std::mutex              m_mutex;           ///< Allocate/DeferRelease 用
+};
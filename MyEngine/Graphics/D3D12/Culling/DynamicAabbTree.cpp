@@ -0,0 +1,409 @@
+﻿#include "Culling/DynamicAabbTree.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace DirectX;
+
+/*
+    DynamicAabbTree.cpp
+    ----------------------------------------------------------------------------
+    挿入（InsertLeaf）：
+      - 根から下りながら「ここで兄弟にする」コストと「子へ下りる」コストを比べる。
+          ここで兄弟にする : 2 * SA(node ∪ leaf)
+          子へ下りる      : SA(child ∪ leaf)（子が内部ノードなら増分だけ）
+                            + 祖先が広がる分の継承コスト 2 * (SA(node ∪ leaf) - SA(node))
+      - 決まった兄弟と新しい葉の上に親ノードを 1 つ作り、根まで戻りながら
+        Balance（回転）→ 高さ/AABB の再計算を行う。
+
+    回転（Balance）：
+      - 子の高さの差が 2 以上なら、高い方の子を持ち上げる（AVL の単回転）。
+      - 持ち上げた子の孫のうち高い方を残し、低い方を元の親へ渡す。
+
+    ノード配列の再確保：
+      - AllocateNode で m_nodes が伸びると参照が無効になるので、
+        Node& を保持したまま AllocateNode を呼ばないこと（添字で持つ）。
+*/
+
+namespace
+{
+    AABB Combine(const AABB& a, const AABB& b)
+    {
+        AABB r;
+        r.Min = { std::min(a.Min.x, b.Min.x), std::min(a.Min.y, b.Min.y), std::min(a.Min.z, b.Min.z) };
+        r.Max = { std::max(a.Max.x, b.Max.x), std::max(a.Max.y, b.Max.y), std::max(a.Max.z, b.Max.z) };
+        return r;
+    }
+
+    // 表面積（の半分）：SAH のコスト指標
+    float HalfArea(const AABB& b)
+    {
+        const float dx = b.Max.x - b.Min.x, dy = b.Max.y - b.Min.y, dz = b.Max.z - b.Min.z;
+        return dx * dy + dy * dz + dz * dx;
+    }
+
+    bool Contains(const AABB& outer, const AABB& inner)
+    {
+        return outer.Min.x <= inner.Min.x && outer.Min.y <= inner.Min.y && outer.Min.z <= inner.Min.z
+            && outer.Max.x >= inner.Max.x && outer.Max.y >= inner.Max.y && outer.Max.z >= inner.Max.z;
+    }
+
+    bool Overlaps(const AABB& a, const AABB& b)
+    {
+        return a.Min.x <= b.Max.x && a.Max.x >= b.Min.x
+            && a.Min.y <= b.Max.y && a.Max.y >= b.Min.y
+            && a.Min.z <= b.Max.z && a.Max.z >= b.Min.z;
+    }
+
+    AABB Inflate(const AABB& b, float r)
+    {
+        AABB o;
+        o.Min = { b.Min.x - r, b.Min.y - r, b.Min.z - r };
+        o.Max = { b.Max.x + r, b.Max.y + r, b.Max.z + r };
+        return o;
+    }
+}
+
+DynamicAabbTree::DynamicAabbTree(float margin, float displacementScale)
+    : m_margin(margin), m_displacementScale(displacementScale)
+{
+}
+
+void DynamicAabbTree::Clear()
+{
+    m_nodes.clear();
+    m_root = kNull;
+    m_freeList = kNull;
+    m_proxyCount = 0;
+}
+
+std::int32_t DynamicAabbTree::AllocateNode()
+{
+    if (m_freeList == kNull)
+    {
+        m_nodes.emplace_back();
+        return static_cast<std::int32_t>(m_nodes.size() - 1);
+    }
+
+    const std::int32_t id = m_freeList;
+    m_freeList = m_nodes[id].parent;
+    m_nodes[id] = Node();
+    return id;
+}
+
+void DynamicAabbTree::FreeNode(std::int32_t id)
+{
+    m_nodes[id].parent = m_freeList;
+    m_nodes[id].height = -1;
+    m_freeList = id;
+}
+
+std::int32_t DynamicAabbTree::CreateProxy(const AABB& box, std::uint32_t userData)
+{
+    const std::int32_t id = AllocateNode();
+    Node& n = m_nodes[id];
+    n.box = Inflate(box, m_margin);
+    n.userData = userData;
+    n.height = 0;
+    InsertLeaf(id);
+    ++m_proxyCount;
+    return id;
+}
+
+void DynamicAabbTree::DestroyProxy(std::int32_t proxyId)
+{
+    assert(proxyId >= 0 && proxyId < (std::int32_t)m_nodes.size() && m_nodes[proxyId].IsLeaf());
+    RemoveLeaf(proxyId);
+    FreeNode(proxyId);
+    --m_proxyCount;
+}
+
+bool DynamicAabbTree::MoveProxy(std::int32_t proxyId, const AABB& box, const XMFLOAT3& displacement)
+{
+    assert(proxyId >= 0 && proxyId < (std::int32_t)m_nodes.size() && m_nodes[proxyId].IsLeaf());
+
+    // 新しいファット AABB：余白 + 進行方向へ移動量を見越して伸ばす
+    AABB fat = Inflate(box, m_margin);
+    const float d[3] = { displacement.x * m_displacementScale,
+                         displacement.y * m_displacementScale,
+                         displacement.z * m_displacementScale };
+    float* mn[3] = { &fat.Min.x, &fat.Min.y, &fat.Min.z };
+    float* mx[3] = { &fat.Max.x, &fat.Max.y, &fat.Max.z };
+    for (int a = 0; a < 3; ++a)
+    {
+        if (d[a] < 0.0f) *mn[a] += d[a];
+        else             *mx[a] += d[a];
+    }
+
+    const AABB& treeBox = m_nodes[proxyId].box;
+    if (Contains(treeBox, box))
+    {
+        // まだ収まっている。ただし以前の高速移動で膨らみすぎている場合は縮め直す
+        const AABB huge = Inflate(fat, 4.0f * m_margin);
+        if (Contains(huge, treeBox)) return false;
+    }
+
+    RemoveLeaf(proxyId);
+    m_nodes[proxyId].box = fat;
+    InsertLeaf(proxyId);
+    return true;
+}
+
+void DynamicAabbTree::InsertLeaf(std::int32_t leaf)
+{
+    if (m_root == kNull)
+    {
+        m_root = leaf;
+        m_nodes[leaf].parent = kNull;
+        return;
+    }
+
+    // ---- 1) 兄弟の選択 ----
+    const AABB leafBox = m_nodes[leaf].box;
+    std::int32_t index = m_root;
+    while (!m_nodes[index].IsLeaf())
+    {
+        const Node& n = m_nodes[index];
+        const float area = HalfArea(n.box);
+        const float combinedArea = HalfArea(Combine(n.box, leafBox));
+
+        const float cost = 2.0f * combinedArea;                      // ここで兄弟にする
+        const float inheritanceCost = 2.0f * (combinedArea - area); // 下りる場合に祖先が広がる分
+
+        auto childCost = [&](std::int32_t c)
+            {
+                const Node& cn = m_nodes[c];
+                const float grown = HalfArea(Combine(cn.box, leafBox));
+                return (cn.IsLeaf() ? grown : grown - HalfArea(cn.box)) + inheritanceCost;
+            };
+        const float cost1 = childCost(n.child1);
+        const float cost2 = childCost(n.child2);
+
+        if (cost < cost1 && cost < cost2) break;
+        index = (cost1 < cost2) ? n.child1 : n.child2;
+    }
+    const std::int32_t sibling = index;
+
+    // ---- 2) 新しい親を作って差し込む ----
+    const std::int32_t oldParent = m_nodes[sibling].parent;
+    const std::int32_t newParent = AllocateNode(); // ※ここで m_nodes が再確保されうる
+    Node& np = m_nodes[newParent];
+    np.parent = oldParent;
+    np.box = Combine(leafBox, m_nodes[sibling].box);
+    np.height = m_nodes[sibling].height + 1;
+    np.child1 = sibling;
+    np.child2 = leaf;
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+
+    if (oldParent != kNull)
+    {
+        if (m_nodes[oldParent].child1 == sibling) m_nodes[oldParent].child1 = newParent;
+        else                                      m_nodes[oldParent].child2 = newParent;
+    }
+    else
+    {
+        m_root = newParent;
+    }
+
+    // ---- 3) 根まで戻りながら回転と AABB/高さの修正 ----
+    index = m_nodes[leaf].parent;
+    while (index != kNull)
+    {
+        index = Balance(index);
+        Node& n = m_nodes[index];
+        n.height = 1 + std::max(m_nodes[n.child1].height, m_nodes[n.child2].height);
+        n.box = Combine(m_nodes[n.child1].box, m_nodes[n.child2].box);
+        index = n.parent;
+    }
+}
+
+void DynamicAabbTree::RemoveLeaf(std::int32_t leaf)
+{
+    if (leaf == m_root)
+    {
+        m_root = kNull;
+        return;
+    }
+
+    const std::int32_t parent = m_nodes[leaf].parent;
+    const std::int32_t grandParent = m_nodes[parent].parent;
+    const std::int32_t sibling = (m_nodes[parent].child1 == leaf) ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    if (grandParent == kNull)
+    {
+        m_root = sibling;
+        m_nodes[sibling].parent = kNull;
+        FreeNode(parent);
+        return;
+    }
+
+    // 親を消して兄弟を祖父に直接つなぐ
+    if (m_nodes[grandParent].child1 == parent) m_nodes[grandParent].child1 = sibling;
+    else                                       m_nodes[grandParent].child2 = sibling;
+    m_nodes[sibling].parent = grandParent;
+    FreeNode(parent);
+
+    std::int32_t index = grandParent;
+    while (index != kNull)
+    {
+        index = Balance(index);
+        Node& n = m_nodes[index];
+        n.box = Combine(m_nodes[n.child1].box, m_nodes[n.child2].box);
+        n.height = 1 + std::max(m_nodes[n.child1].height, m_nodes[n.child2].height);
+        index = n.parent;
+    }
+}
+
+std::int32_t DynamicAabbTree::Balance(std::int32_t iA)
+{
+    Node& A = m_nodes[iA];
+    if (A.IsLeaf() || A.height < 2) return iA;
+
+    const std::int32_t iB = A.child1;
+    const std::int32_t iC = A.child2;
+    Node& B = m_nodes[iB];
+    Node& C = m_nodes[iC];
+    const std::int32_t balance = C.height - B.height;
+
+    // A の親から見た子を差し替える
+    auto replaceInParent = [&](std::int32_t parent, std::int32_t newChild)
+        {
+            if (parent == kNull) { m_root = newChild; return; }
+            if (m_nodes[parent].child1 == iA) m_nodes[parent].child1 = newChild;
+            else                              m_nodes[parent].child2 = newChild;
+        };
+
+    // C を持ち上げる
+    if (balance > 1)
+    {
+        const std::int32_t iF = C.child1;
+        const std::int32_t iG = C.child2;
+        Node& F = m_nodes[iF];
+        Node& G = m_nodes[iG];
+
+        C.child1 = iA;
+        C.parent = A.parent;
+        A.parent = iC;
+        replaceInParent(C.parent, iC);
+
+        if (F.height > G.height)
+        {
+            C.child2 = iF;
+            A.child2 = iG;
+            G.parent = iA;
+            A.box = Combine(B.box, G.box);
+            C.box = Combine(A.box, F.box);
+            A.height = 1 + std::max(B.height, G.height);
+            C.height = 1 + std::max(A.height, F.height);
+        }
+        else
+        {
+            C.child2 = iG;
+            A.child2 = iF;
+            F.parent = iA;
+            A.box = Combine(B.box, F.box);
+            C.box = Combine(A.box, G.box);
+            A.height = 1 + std::max(B.height, F.height);
+            C.height = 1 + std::max(A.height, G.height);
+        }
+        return iC;
+    }
+
+    // B を持ち上げる
+    if (balance < -1)
+    {
+        const std::int32_t iD = B.child1;
+        const std::int32_t iE = B.child2;
+        Node& D = m_nodes[iD];
+        Node& E = m_nodes[iE];
+
+        B.child1 = iA;
+        B.parent = A.parent;
+        A.parent = iB;
+        replaceInParent(B.parent, iB);
+
+        if (D.height > E.height)
+        {
+            B.child2 = iD;
+            A.child1 = iE;
+            E.parent = iA;
+            A.box = Combine(C.box, E.box);
+            B.box = Combine(A.box, D.box);
+            A.height = 1 + std::max(C.height, E.height);
+            B.height = 1 + std::max(A.height, D.height);
+        }
+        else
+        {
+            B.child2 = iE;
+            A.child1 = iD;
+            D.parent = iA;
+            A.box = Combine(C.box, D.box);
+            B.box = Combine(A.box, E.box);
+            A.height = 1 + std::max(C.height, D.height);
+            B.height = 1 + std::max(A.height, E.height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
+
+void DynamicAabbTree::CollectLeaves(std::int32_t node, std::vector<std::uint32_t>& out) const
+{
+    std::vector<std::int32_t> stack;
+    stack.reserve(64);
+    stack.push_back(node);
+    while (!stack.empty())
+    {
+        const Node& n = m_nodes[stack.back()];
+        stack.pop_back();
+        if (n.IsLeaf()) { out.push_back(n.userData); continue; }
+        stack.push_back(n.child2);
+        stack.push_back(n.child1);
+    }
+}
+
+void DynamicAabbTree::QueryFrustum(const Frustum& frustum, std::vector<std::uint32_t>& out) const
+{
+    if (m_root == kNull) return;
+
+    struct Entry { std::int32_t node; std::uint32_t mask; };
+    std::vector<Entry> stack;
+    stack.reserve(64);
+    stack.push_back({ m_root, 0x3Fu });
+
+    while (!stack.empty())
+    {
+        const Entry e = stack.back();
+        stack.pop_back();
+        const Node& n = m_nodes[e.node];
+
+        std::uint32_t mask = e.mask;
+        const CullResult c = frustum.Classify(n.box.Min, n.box.Max, mask);
+        if (c == CullResult::Outside) continue;        // サブツリーごと棄却
+        if (c == CullResult::Inside) { CollectLeaves(e.node, out); continue; } // 丸ごと採用
+        if (n.IsLeaf()) { out.push_back(n.userData); continue; }
+
+        stack.push_back({ n.child2, mask });
+        stack.push_back({ n.child1, mask });
+    }
+}
+
+void DynamicAabbTree::QueryOverlap(const AABB& box, std::vector<std::uint32_t>& out) const
+{
+    if (m_root == kNull || !box.IsValid()) return;
+
+    std::vector<std::int32_t> stack;
+    stack.reserve(64);
+    stack.push_back(m_root);
+
+    while (!stack.empty())
+    {
+        const Node& n = m_nodes[stack.back()];
+        stack.pop_back();
+        if (!Overlaps(n.box, box)) continue;
+        if (n.IsLeaf()) { out.push_back(n.userData); continue; }
+        stack.push_back(n.child2);
+        stack.push_back(n.child1);
+    }
+}
@@ -0,0 +1,92 @@
+﻿#pragma once
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+#include "Assets/Bounds.h"
+#include "Culling/Frustum.h"
+
+/*
+    DynamicAabbTree.h
+    ----------------------------------------------------------------------------
+    目的：
+      - 毎フレーム動く（Dynamic）オブジェクト用の、増分更新できる AABB ツリー。
+      - StaticBvh と並べて、視錐台カリングと重なりクエリに使う。
+
+    構造（Box2D の b2DynamicTree と同じ考え方）：
+      - 葉 = プロキシ 1 つ。葉には実際の AABB を少し膨らませた“ファット AABB”を持たせる。
+      - MoveProxy は新しい AABB がファット AABB に収まっている間は何もしない。
+        はみ出したときだけ葉を抜いて挿入し直す（＝動いてもほとんどのフレームは O(1)）。
+      - 挿入先は表面積コスト（SAH の近似）で選ぶ。挿入後、根に向かって
+        AABB と高さを直しつつ AVL 風の回転でバランスを取る。
+      - ノードはプール配列＋フリーリスト。プロキシ ID = 葉のノード番号（再利用される）。
+
+    注意：
+      - クエリはファット AABB で判定するので保守的（呼び出し側で実 AABB を再判定するとよい）。
+      - プロキシ ID は DestroyProxy 後に別のプロキシへ再利用される。
+*/
+
+class DynamicAabbTree
+{
+public:
+    static constexpr std::int32_t kNull = -1;
+
+    /**
+     * @param margin       ファット AABB の余白（各軸の両側に足す距離）
+     * @param displacementScale  MoveProxy の移動量を何倍先まで見越して膨らませるか
+     */
+    explicit DynamicAabbTree(float margin = 0.1f, float displacementScale = 4.0f);
+
+    /// プロキシを作成して ID を返す（userData はクエリ結果として返る値）
+    std::int32_t CreateProxy(const AABB& box, std::uint32_t userData);
+
+    /// プロキシを削除（ID は以後無効）
+    void DestroyProxy(std::int32_t proxyId);
+
+    /**
+     * @brief プロキシの AABB を更新する
+     * @param displacement  前回からの移動量（進行方向へファット AABB を伸ばす）
+     * @return ツリーを組み替えたら true（ファット AABB に収まっていれば false）
+     */
+    bool MoveProxy(std::int32_t proxyId, const AABB& box, const DirectX::XMFLOAT3& displacement);
+
+    std::uint32_t GetUserData(std::int32_t proxyId) const { return m_nodes[proxyId].userData; }
+    void          SetUserData(std::int32_t proxyId, std::uint32_t userData) { m_nodes[proxyId].userData = userData; }
+    const AABB&   GetFatAABB(std::int32_t proxyId) const { return m_nodes[proxyId].box; }
+
+    /// 視錐台と交差する（可能性のある）プロキシの userData を out に追記する
+    void QueryFrustum(const Frustum& frustum, std::vector<std::uint32_t>& out) const;
+
+    /// box とファット AABB が重なるプロキシの userData を out に追記する
+    void QueryOverlap(const AABB& box, std::vector<std::uint32_t>& out) const;
+
+    void Clear();
+    std::uint32_t ProxyCount() const { return m_proxyCount; }
+    std::int32_t  Height() const { return (m_root == kNull) ? 0 : m_nodes[m_root].height; }
+
+private:
+    struct Node
+    {
+        AABB          box;              // ファット AABB（内部ノードは子の和）
+        std::int32_t  parent = kNull;   // 親（フリーリスト中は次の空きノード）
+        std::int32_t  child1 = kNull;   // kNull なら葉
+        std::int32_t  child2 = kNull;
+        std::int32_t  height = -1;      // 葉 = 0、フリー = -1
+        std::uint32_t userData = 0;
+
+        bool IsLeaf() const { return child1 == kNull; }
+    };
+
+    std::int32_t AllocateNode();
+    void         FreeNode(std::int32_t id);
+    void         InsertLeaf(std::int32_t leaf);
+    void         RemoveLeaf(std::int32_t leaf);
+    std::int32_t Balance(std::int32_t a);
+    void         CollectLeaves(std::int32_t node, std::vector<std::uint32_t>& out) const;
+
+    std::vector<Node> m_nodes;
+    std::int32_t      m_root = kNull;
+    std::int32_t      m_freeList = kNull;
+    std::uint32_t     m_proxyCount = 0;
+    float             m_margin;
+    float             m_displacementScale;
+};
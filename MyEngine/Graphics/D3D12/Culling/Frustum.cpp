@@ -0,0 +1,85 @@
+﻿#include "Culling/Frustum.h"
+#include <cmath>
+
+using namespace DirectX;
+
+/*
+    Frustum.cpp
+    ----------------------------------------------------------------------------
+    AABB 判定（center/extent 法）：
+      - 平面 (n,d) に対し、中心の符号付き距離 s = dot(n,c) + d
+        と、extent の平面法線方向への射影半径 r = dot(|n|, e) を比べる。
+          s < -r → 完全に外側
+          s <  r → 交差
+          それ以外 → この平面に対しては内側
+      - 6 平面すべてで内側なら Inside。
+*/
+
+Frustum Frustum::FromViewProj(FXMMATRIX viewProj)
+{
+    // 列を取り出すため転置して行として扱う
+    const XMMATRIX T = XMMatrixTranspose(viewProj);
+    const XMVECTOR c0 = T.r[0];
+    const XMVECTOR c1 = T.r[1];
+    const XMVECTOR c2 = T.r[2];
+    const XMVECTOR c3 = T.r[3];
+
+    const XMVECTOR raw[6] = {
+        XMVectorAdd(c3, c0),      // Left
+        XMVectorSubtract(c3, c0), // Right
+        XMVectorAdd(c3, c1),      // Bottom
+        XMVectorSubtract(c3, c1), // Top
+        c2,                       // Near（D3D: z >= 0）
+        XMVectorSubtract(c3, c2), // Far
+    };
+
+    Frustum f;
+    for (int i = 0; i < 6; ++i)
+    {
+        // 法線の長さで正規化（距離比較を正しくするため）
+        const float len = XMVectorGetX(XMVector3Length(raw[i]));
+        const XMVECTOR p = (len > 1e-8f) ? XMVectorScale(raw[i], 1.0f / len) : raw[i];
+        XMStoreFloat4(&f.Planes[i], p);
+    }
+    return f;
+}
+
+CullResult Frustum::Classify(const AABB& box) const
+{
+    // 無効 AABB（空メッシュ等）は判定不能 → 描く側に倒す
+    if (!box.IsValid()) return CullResult::Intersect;
+
+    const float cx = (box.Min.x + box.Max.x) * 0.5f;
+    const float cy = (box.Min.y + box.Max.y) * 0.5f;
+    const float cz = (box.Min.z + box.Max.z) * 0.5f;
+    const float ex = (box.Max.x - box.Min.x) * 0.5f;
+    const float ey = (box.Max.y - box.Min.y) * 0.5f;
+    const float ez = (box.Max.z - box.Min.z) * 0.5f;
+
+    CullResult result = CullResult::Inside;
+    for (const XMFLOAT4& p : Planes)
+    {
+        const float s = p.x * cx + p.y * cy + p.z * cz + p.w;
+        const float r = std::fabs(p.x) * ex + std::fabs(p.y) * ey + std::fabs(p.z) * ez;
+        if (s < -r) return CullResult::Outside;
+        if (s < r)  result = CullResult::Intersect;
+    }
+    return result;
+}
+
+CullResult Frustum::Classify(const XMFLOAT3& mn, const XMFLOAT3& mx, std::uint32_t& planeMask) const
+{
+    const float cx = (mn.x + mx.x) * 0.5f, cy = (mn.y + mx.y) * 0.5f, cz = (mn.z + mx.z) * 0.5f;
+    const float ex = (mx.x - mn.x) * 0.5f, ey = (mx.y - mn.y) * 0.5f, ez = (mx.z - mn.z) * 0.5f;
+    for (std::uint32_t i = 0; i < 6; ++i)
+    {
+        const std::uint32_t bit = 1u << i;
+        if (!(planeMask & bit)) continue;
+        const XMFLOAT4& p = Planes[i];
+        const float s = p.x * cx + p.y * cy + p.z * cz + p.w;
+        const float r = std::fabs(p.x) * ex + std::fabs(p.y) * ey + std::fabs(p.z) * ez;
+        if (s < -r) return CullResult::Outside;
+        if (s >= r) planeMask &= ~bit; // この平面に対しては内側確定（子で再判定しない）
+    }
+    return (planeMask == 0) ? CullResult::Inside : CullResult::Intersect;
+}
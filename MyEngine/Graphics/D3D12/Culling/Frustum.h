@@ -0,0 +1,53 @@
+﻿#pragma once
+#include <cstdint>
+#include <DirectXMath.h>
+#include "Assets/Bounds.h"
+
+/*
+    Frustum.h
+    ----------------------------------------------------------------------------
+    目的：
+      - View*Proj 行列から 6 枚のクリップ平面を抽出し、AABB との交差判定を行う。
+      - SceneRenderer::Record で「CB を書く前・Draw を積む前」に不可視オブジェクトを捨てる。
+
+    平面の抽出（Gribb/Hartmann 法, 行ベクトル規約 & D3D の z∈[0,1]）：
+      - VP の列ベクトル c0..c3 を使い
+          Left = c3 + c0,  Right = c3 - c0,
+          Bottom = c3 + c1, Top = c3 - c1,
+          Near = c2,        Far = c3 - c2
+      - 各平面は (n, d) で「dot(n, p) + d >= 0 が内側」。正規化して保持する。
+
+    注意：
+      - AABB 判定は保守的（角付近で“見えないのに残る”ことはあるが、見えるものを捨てることはない）。
+*/
+
+/// 交差判定の結果
+enum class CullResult
+{
+    Outside,   ///< 完全に外側（描かない）
+    Intersect, ///< 境界をまたぐ
+    Inside,    ///< 完全に内側
+};
+
+struct Frustum
+{
+    DirectX::XMFLOAT4 Planes[6]{}; ///< Left, Right, Bottom, Top, Near, Far（xyz=法線, w=d）
+
+    /// View*Proj 行列から視錐台を構築する
+    static Frustum FromViewProj(DirectX::FXMMATRIX viewProj);
+
+    /// AABB（ワールド空間）との交差分類
+    CullResult Classify(const AABB& box) const;
+
+    /**
+     * @brief 平面マスク付きの交差分類（階層走査用）
+     * @param planeMask 判定する平面のビット集合（bit i = Planes[i]）。
+     *                  完全に内側と分かった平面のビットは落として返す。
+     * @details 親ノードで内側と確定した平面を子で再判定しないために使う（BVH / AABB ツリー）。
+     */
+    CullResult Classify(const DirectX::XMFLOAT3& mn, const DirectX::XMFLOAT3& mx,
+        std::uint32_t& planeMask) const;
+
+    /// 少しでも内側にかかっていれば true（無効な AABB は常に true = 描く側に倒す）
+    bool Intersects(const AABB& box) const { return Classify(box) != CullResult::Outside; }
+};
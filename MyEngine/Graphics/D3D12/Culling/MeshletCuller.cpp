@@ -0,0 +1,112 @@
+﻿#include "Culling/MeshletCuller.h"
+#include <cmath>
+
+using namespace DirectX;
+
+/*
+    MeshletCuller.cpp
+    ----------------------------------------------------------------------------
+    裏向き判定（透視投影）：
+      - コーン：全面法線 n_i が軸 a から角度 α 以内、coneCutoff = sin α。
+      - 視線 v = p - e（p は境界球内の点）が a から 90° - α 以内なら、どの n_i とも 90° 以内 = dot(n_i, v) >= 0。
+        |p - c| <= r から
+          dot(v, a) >= dot(c - e, a) - r,   |v| <= |c - e| + r
+        なので dot(c - e, a) >= sin α × |c - e| + r × (1 + sin α) なら十分（保守側）。
+      - 面の表（CW。この左手系では cross(b-a, c-a) がカメラ側を向く）が見えるのは dot(n, p - e) < 0 のとき。
+    正射影：
+      - 視線はどこでも direction なので dot(direction, a) >= sin α × |direction| だけで判定する。
+*/
+
+MeshletCullView MakeMeshletCullView(FXMMATRIX world, CXMMATRIX view, CXMMATRIX proj)
+{
+    MeshletCullView v;
+    v.frustum = Frustum::FromViewProj(world * view * proj);
+
+    // カメラ位置/視線方向（View^-1 の 4 行目/3 行目）をローカル空間へ
+    XMVECTOR viewDet;
+    const XMMATRIX cameraWorld = XMMatrixInverse(&viewDet, view);
+    XMVECTOR worldDet;
+    const XMMATRIX invWorld = XMMatrixInverse(&worldDet, world);
+    const float det = XMVectorGetX(worldDet);
+    if (!std::isfinite(det) || std::fabs(det) < 1e-12f)
+    {
+        v.testCone = false; // 潰れた行列：向きが定まらない
+        return v;
+    }
+    XMStoreFloat3(&v.eye, XMVector3TransformCoord(cameraWorld.r[3], invWorld));
+    XMStoreFloat3(&v.direction, XMVector3TransformNormal(cameraWorld.r[2], invWorld));
+    v.perspective = XMVectorGetW(proj.r[2]) != 0.0f; // _34（正射影は 0）
+    v.mirrored = det < 0.0f;
+    return v;
+}
+
+bool IsMeshletOutside(const MeshletBounds& b, const MeshletCullView& v)
+{
+    for (const XMFLOAT4& p : v.frustum.Planes)
+        if (p.x * b.center.x + p.y * b.center.y + p.z * b.center.z + p.w < -b.radius) return true;
+    return false;
+}
+
+bool IsMeshletBackfacing(const MeshletBounds& b, const MeshletCullView& v)
+{
+    if (b.coneCutoff >= 1.0f) return false;
+    const float s = v.mirrored ? -1.0f : 1.0f; // 鏡映なら表裏が逆 = 軸を反転
+    const XMFLOAT3 axis{ b.coneAxis.x * s, b.coneAxis.y * s, b.coneAxis.z * s };
+
+    if (!v.perspective)
+    {
+        const XMFLOAT3& d = v.direction;
+        const float len = std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z);
+        return len > 0.0f && d.x * axis.x + d.y * axis.y + d.z * axis.z >= b.coneCutoff * len;
+    }
+
+    const XMFLOAT3 d{ b.center.x - v.eye.x, b.center.y - v.eye.y, b.center.z - v.eye.z };
+    const float len = std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z);
+    return d.x * axis.x + d.y * axis.y + d.z * axis.z >= b.coneCutoff * len + b.radius * (1.0f + b.coneCutoff);
+}
+
+std::size_t CullMeshlets(const MeshletData& data, const MeshletCullView& view,
+    std::vector<std::uint32_t>& visible, MeshletCullStats* stats)
+{
+    visible.clear();
+    std::size_t indexCount = 0;
+    MeshletCullStats s;
+    const std::size_t n = data.Meshlets.size();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const MeshletBounds& b = data.Bounds[i];
+        if (view.testFrustum && IsMeshletOutside(b, view)) { ++s.frustumCulled; continue; }
+        if (view.testCone && IsMeshletBackfacing(b, view)) { ++s.coneCulled; continue; }
+        visible.push_back(static_cast<std::uint32_t>(i));
+        indexCount += data.Meshlets[i].triangleCount * 3;
+    }
+    s.tested = static_cast<std::uint32_t>(n);
+    if (stats)
+    {
+        stats->tested += s.tested;
+        stats->frustumCulled += s.frustumCulled;
+        stats->coneCulled += s.coneCulled;
+    }
+    return indexCount;
+}
+
+std::size_t WriteMeshletIndices(const MeshletData& data, const std::uint32_t* meshlets, std::size_t count,
+    void* dst, bool shortIndices)
+{
+    std::size_t written = 0;
+    std::uint16_t* out16 = static_cast<std::uint16_t*>(dst);
+    std::uint32_t* out32 = static_cast<std::uint32_t*>(dst);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Meshlet& m = data.Meshlets[meshlets[i]];
+        const std::uint32_t* verts = data.Vertices.data() + m.vertexOffset;
+        const std::uint8_t* tri = data.Triangles.data() + m.triangleOffset;
+        const std::size_t n = static_cast<std::size_t>(m.triangleCount) * 3;
+        if (shortIndices)
+            for (std::size_t k = 0; k < n; ++k) out16[written + k] = static_cast<std::uint16_t>(verts[tri[k]]);
+        else
+            for (std::size_t k = 0; k < n; ++k) out32[written + k] = verts[tri[k]];
+        written += n;
+    }
+    return written;
+}
@@ -0,0 +1,80 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+#include "Assets/Meshlet.h"
+#include "Culling/Frustum.h"
+
+/*
+    MeshletCuller.h
+    ----------------------------------------------------------------------------
+    目的：
+      - オブジェクト単位のカリングを通った大きなメッシュを、メッシュレット（Assets/Meshlet.h）単位で
+        もう一度判定し、視錐台の外と裏向きの塊を捨てる。残った塊のインデックスを 1 本に詰めて
+        （ビューごとのコンパクトな IB）、DrawIndexed 1 回で描けるようにする。
+      - GPU には依存しない純 CPU コード（SceneRenderer::Record がアップロード領域へ直接書く）。
+
+    判定はメッシュのローカル空間で行う（MakeMeshletCullView で 1 オブジェクト 1 回だけ準備）：
+      - 視錐台 …… World*View*Proj から平面を取れば、それがそのままローカル空間の平面になる
+                   （Frustum::FromViewProj）。アフィン変換は半空間を保つので非一様スケールでも正確。
+      - 裏向き …… 面の向き dot(n, p - e) の符号はローカル空間でも同じ（ワールド行列の行列式の符号だけ
+                   反転する）。カメラ位置/視線方向を逆行列でローカルへ移し、鏡映（行列式 < 0）なら
+                   表裏を入れ替える。透視投影は境界球とコーンの保守的な判定、正射影は視線方向だけで判定。
+
+    使い方：
+      MeshletCullView v = MakeMeshletCullView(world, view, proj);
+      const std::size_t n = CullMeshlets(data, v, visible, &stats); // 残ったメッシュレットと index 数
+      WriteMeshletIndices(data, visible.data(), visible.size(), dst, shortIndices);
+
+    注意：
+      - 出力するインデックスは元の MeshData::Vertices の番号（LOD0 と同じ。BaseVertex はそのまま使える）。
+      - 三角形の順は「残ったメッシュレットの順 × メッシュレット内の順」。巻き順は変えない。
+*/
+
+/// 1 オブジェクト × 1 ビューの判定条件（メッシュのローカル空間）
+struct MeshletCullView
+{
+    Frustum           frustum;            ///< ローカル空間の視錐台
+    DirectX::XMFLOAT3 eye{};              ///< カメラ位置（透視投影）
+    DirectX::XMFLOAT3 direction{};        ///< 視線方向（正射影。正規化していなくてよい）
+    bool              perspective = true; ///< false = 正射影（direction で判定）
+    bool              mirrored = false;   ///< ワールド行列の行列式が負（表裏が入れ替わる）
+    bool              testFrustum = true; ///< 視錐台で判定するか（オブジェクトが完全に内側なら false でよい）
+    bool              testCone = true;    ///< 法線コーンで裏向きを判定するか
+};
+
+/// CullMeshlets の統計
+struct MeshletCullStats
+{
+    std::uint32_t tested = 0;        ///< 判定したメッシュレット数
+    std::uint32_t frustumCulled = 0; ///< 視錐台の外として捨てた数
+    std::uint32_t coneCulled = 0;    ///< 全三角形が裏向きとして捨てた数
+};
+
+/**
+ * @brief ワールド行列とカメラからローカル空間の判定条件を作る
+ * @details ワールド行列が正則でない（スケール 0 等）ときは裏向き判定をしない（testCone = false）。
+ */
+MeshletCullView MakeMeshletCullView(DirectX::FXMMATRIX world, DirectX::CXMMATRIX view, DirectX::CXMMATRIX proj);
+
+/// 境界球が視錐台の外なら true
+bool IsMeshletOutside(const MeshletBounds& b, const MeshletCullView& v);
+
+/// 法線コーンから全三角形が裏向きと言えるなら true（コーン無しは常に false）
+bool IsMeshletBackfacing(const MeshletBounds& b, const MeshletCullView& v);
+
+/**
+ * @brief 残るメッシュレットの番号を visible に集める（上書き）
+ * @return 残ったメッシュレットのインデックス数の合計（WriteMeshletIndices に要る要素数）
+ */
+std::size_t CullMeshlets(const MeshletData& data, const MeshletCullView& view,
+    std::vector<std::uint32_t>& visible, MeshletCullStats* stats = nullptr);
+
+/**
+ * @brief 指定したメッシュレットの三角形を元の頂点番号のインデックスとして dst へ詰めて書く
+ * @param shortIndices true なら 16bit（全頂点番号が 0xFFFF 以下であること）、false なら 32bit
+ * @return 書いたインデックス数
+ */
+std::size_t WriteMeshletIndices(const MeshletData& data, const std::uint32_t* meshlets, std::size_t count,
+    void* dst, bool shortIndices);
@@ -0,0 +1,417 @@
+﻿#include "Culling/OcclusionCuller.h"
+#include "Core/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <immintrin.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define OCC_TARGET_AVX2            // MSVC は /arch 指定なしでも AVX2 組み込み関数を使える
+#else
+#define OCC_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+using namespace DirectX;
+
+/*
+    OcclusionCuller.cpp
+    ----------------------------------------------------------------------------
+    画素の扱い：
+      - 画素 (x, y) の中心は (x + 0.5, y + 0.5)。画面座標は左上原点・y 下向き。
+      - AVX2 版は 8 画素ブロック（x を 8 の倍数に揃える）単位、スカラー版は 1 画素ずつ。
+        どちらも「e = ex * xs + (ey * yc + ec)」の順で計算するので結果が一致する。
+    帯（band）：
+      - kTileSize 行ずつ。RasterizeBand は帯のクリア → 三角形を塗る → その帯の HiZ 作成 までを行う。
+        帯同士は書き込み先が重ならないので、ロック無しで並列に処理できる。
+*/
+
+namespace
+{
+    constexpr float kClearDepth = 1.0f;
+
+    // ---- 帯 1 本分のラスタライズ（スカラー版） ----
+    void RasterizeSpanScalar(const OcclusionCuller::Triangle& t, float* depth, std::uint32_t width,
+        std::int32_t y0, std::int32_t y1)
+    {
+        const std::int32_t xa = t.minX & ~7;
+        for (std::int32_t y = y0; y <= y1; ++y)
+        {
+            const float yc = (float)y + 0.5f;
+            const float r0 = t.ey[0] * yc + t.ec[0];
+            const float r1 = t.ey[1] * yc + t.ec[1];
+            const float r2 = t.ey[2] * yc + t.ec[2];
+            const float rz = t.zb * yc + t.zc;
+            float* row = depth + (std::size_t)y * width;
+            for (std::int32_t x = xa; x <= (t.maxX | 7); ++x) // AVX2 版と同じく 8 画素ブロックの端まで
+            {
+                const float xs = (float)(x & ~7) + ((float)(x & 7) + 0.5f);
+                const float e0 = t.ex[0] * xs + r0;
+                const float e1 = t.ex[1] * xs + r1;
+                const float e2 = t.ex[2] * xs + r2;
+                if (e0 < 0.0f || e1 < 0.0f || e2 < 0.0f) continue;
+                const float z = t.za * xs + rz;
+                if (z < row[x]) row[x] = z;
+            }
+        }
+    }
+
+    // ---- 帯 1 本分のラスタライズ（AVX2 版：8 画素ずつ） ----
+    OCC_TARGET_AVX2 void RasterizeSpanAvx2(const OcclusionCuller::Triangle& t, float* depth, std::uint32_t width,
+        std::int32_t y0, std::int32_t y1)
+    {
+        const __m256 lane = _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 ex0 = _mm256_set1_ps(t.ex[0]);
+        const __m256 ex1 = _mm256_set1_ps(t.ex[1]);
+        const __m256 ex2 = _mm256_set1_ps(t.ex[2]);
+        const __m256 za = _mm256_set1_ps(t.za);
+        const std::int32_t xa = t.minX & ~7;
+
+        for (std::int32_t y = y0; y <= y1; ++y)
+        {
+            const float yc = (float)y + 0.5f;
+            const __m256 r0 = _mm256_set1_ps(t.ey[0] * yc + t.ec[0]);
+            const __m256 r1 = _mm256_set1_ps(t.ey[1] * yc + t.ec[1]);
+            const __m256 r2 = _mm256_set1_ps(t.ey[2] * yc + t.ec[2]);
+            const __m256 rz = _mm256_set1_ps(t.zb * yc + t.zc);
+            float* row = depth + (std::size_t)y * width;
+            for (std::int32_t x = xa; x <= t.maxX; x += 8)
+            {
+                const __m256 xs = _mm256_add_ps(_mm256_set1_ps((float)x), lane);
+                const __m256 e0 = _mm256_add_ps(_mm256_mul_ps(ex0, xs), r0);
+                const __m256 e1 = _mm256_add_ps(_mm256_mul_ps(ex1, xs), r1);
+                const __m256 e2 = _mm256_add_ps(_mm256_mul_ps(ex2, xs), r2);
+                const __m256 inside = _mm256_and_ps(
+                    _mm256_and_ps(_mm256_cmp_ps(e0, zero, _CMP_GE_OQ), _mm256_cmp_ps(e1, zero, _CMP_GE_OQ)),
+                    _mm256_cmp_ps(e2, zero, _CMP_GE_OQ));
+                if (_mm256_movemask_ps(inside) == 0) continue;
+
+                const __m256 z = _mm256_add_ps(_mm256_mul_ps(za, xs), rz);
+                const __m256 d = _mm256_load_ps(row + x);
+                _mm256_store_ps(row + x, _mm256_blendv_ps(d, _mm256_min_ps(d, z), inside));
+            }
+        }
+    }
+
+    // ---- 8 画素ブロック内の [xa, xb] に minZ 以上の深度があるか ----
+    bool AnyFartherScalar(const float* block, std::int32_t xa, std::int32_t xb, float minZ)
+    {
+        for (std::int32_t x = xa; x <= xb; ++x)
+            if (block[x] >= minZ) return true;
+        return false;
+    }
+
+    OCC_TARGET_AVX2 bool AnyFartherAvx2(const float* block, std::int32_t xa, std::int32_t xb, float minZ)
+    {
+        const __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i inRange = _mm256_and_si256(
+            _mm256_cmpgt_epi32(idx, _mm256_set1_epi32(xa - 1)),
+            _mm256_cmpgt_epi32(_mm256_set1_epi32(xb + 1), idx));
+        const __m256 farther = _mm256_cmp_ps(_mm256_load_ps(block), _mm256_set1_ps(minZ), _CMP_GE_OQ);
+        return _mm256_movemask_ps(_mm256_and_ps(farther, _mm256_castsi256_ps(inRange))) != 0;
+    }
+
+    bool DetectAvx2()
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx) return false;
+        if ((_xgetbv(0) & 0x6) != 0x6) return false; // OS が YMM レジスタを保存するか
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+}
+
+// ============================================================================
+// 構築/設定
+// ============================================================================
+OcclusionCuller::OcclusionCuller(std::uint32_t width, std::uint32_t height)
+    : m_useAvx2(IsAvx2Supported())
+{
+    Resize(width, height);
+    XMStoreFloat4x4(&m_viewProj, XMMatrixIdentity());
+}
+
+void OcclusionCuller::Resize(std::uint32_t width, std::uint32_t height)
+{
+    width = std::max<std::uint32_t>(kTileSize, (width + kTileSize - 1) & ~(kTileSize - 1));
+    height = std::max<std::uint32_t>(kTileSize, (height + kTileSize - 1) & ~(kTileSize - 1));
+    if (width == m_width && height == m_height) return;
+
+    m_width = width;
+    m_height = height;
+    m_tilesX = width / kTileSize;
+    m_tilesY = height / kTileSize;
+
+    // AVX2 版は 32B アラインのロード/ストアを使う：先頭を揃えるために 8 要素余分に取る
+    m_depth.assign((std::size_t)width * height + 8, kClearDepth);
+    m_hiZ.assign((std::size_t)m_tilesX * m_tilesY, kClearDepth);
+    m_bins.resize(m_tilesY);
+}
+
+const float* OcclusionCuller::Depth() const
+{
+    // m_depth は 8 要素余分に確保してあるので、32B 境界まで進めても Width x Height 入る
+    const float* p = m_depth.data();
+    return p + ((8 - ((reinterpret_cast<std::uintptr_t>(p) >> 2) & 7)) & 7);
+}
+
+bool OcclusionCuller::IsAvx2Supported()
+{
+    static const bool s_supported = DetectAvx2();
+    return s_supported;
+}
+
+// ============================================================================
+// オクルーダ投入
+// ============================================================================
+void OcclusionCuller::BeginFrame(FXMMATRIX viewProj)
+{
+    XMStoreFloat4x4(&m_viewProj, viewProj);
+    m_tris.clear();
+    m_stats = {};
+}
+
+void OcclusionCuller::AddOccluder(const XMFLOAT3* positions, std::size_t stride, std::size_t vertexCount,
+    const unsigned int* indices, std::size_t indexCount, FXMMATRIX world)
+{
+    if (!positions || !indices || vertexCount == 0 || indexCount < 3) return;
+
+    // 1) 全頂点をクリップ空間へ（頂点共有が多いので三角形単位ではなく頂点単位で変換）
+    const XMMATRIX m = XMMatrixMultiply(world, XMLoadFloat4x4(&m_viewProj));
+    m_clip.resize(vertexCount);
+    const unsigned char* src = reinterpret_cast<const unsigned char*>(positions);
+    for (std::size_t i = 0; i < vertexCount; ++i)
+    {
+        const XMFLOAT3* p = reinterpret_cast<const XMFLOAT3*>(src + i * stride);
+        XMStoreFloat4(&m_clip[i], XMVector3Transform(XMLoadFloat3(p), m));
+    }
+
+    // 2) 三角形ごとにクリップ → セットアップ
+    for (std::size_t i = 0; i + 2 < indexCount; i += 3)
+    {
+        const unsigned int i0 = indices[i], i1 = indices[i + 1], i2 = indices[i + 2];
+        if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount) continue;
+        ++m_stats.occluderTriangles;
+        ClipAndSetup(m_clip[i0], m_clip[i1], m_clip[i2]);
+    }
+}
+
+/*
+    ClipAndSetup
+      - 視錐台の左右上下/遠平面の外に 3 頂点とも出ていれば捨てる。
+      - 近平面（D3D：z >= 0）だけは実際にクリップする（Sutherland–Hodgman で最大 4 頂点）。
+        手前にはみ出す大きな床や壁ほど遮蔽効果が大きいので、捨てずに残す。
+      - 左右上下ははみ出したまま画面座標にし、外接矩形のクランプで済ませる（ガードバンド扱い）。
+*/
+void OcclusionCuller::ClipAndSetup(const XMFLOAT4& a, const XMFLOAT4& b, const XMFLOAT4& c)
+{
+    const XMFLOAT4* v[3] = { &a, &b, &c };
+    auto allOut = [&](auto outside)
+        {
+            return outside(*v[0]) && outside(*v[1]) && outside(*v[2]);
+        };
+    if (allOut([](const XMFLOAT4& p) { return p.x > p.w; }) ||
+        allOut([](const XMFLOAT4& p) { return p.x < -p.w; }) ||
+        allOut([](const XMFLOAT4& p) { return p.y > p.w; }) ||
+        allOut([](const XMFLOAT4& p) { return p.y < -p.w; }) ||
+        allOut([](const XMFLOAT4& p) { return p.z > p.w; }) ||
+        allOut([](const XMFLOAT4& p) { return p.z < 0.0f; }))
+        return;
+
+    if (a.z >= 0.0f && b.z >= 0.0f && c.z >= 0.0f)
+    {
+        SetupTriangle(a, b, c);
+        return;
+    }
+
+    XMFLOAT4 poly[4];
+    int n = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+        const XMFLOAT4& p = *v[i];
+        const XMFLOAT4& q = *v[(i + 1) % 3];
+        if (p.z >= 0.0f) poly[n++] = p;
+        if ((p.z >= 0.0f) != (q.z >= 0.0f))
+        {
+            const float t = p.z / (p.z - q.z);
+            poly[n++] = XMFLOAT4(p.x + (q.x - p.x) * t, p.y + (q.y - p.y) * t, 0.0f, p.w + (q.w - p.w) * t);
+        }
+    }
+    for (int i = 2; i < n; ++i) SetupTriangle(poly[0], poly[i - 1], poly[i]);
+}
+
+void OcclusionCuller::SetupTriangle(const XMFLOAT4& a, const XMFLOAT4& b, const XMFLOAT4& c)
+{
+    // クリップ → 画面座標（左上原点・y 下向き）
+    const float w = (float)m_width, h = (float)m_height;
+    float x[3], y[3], z[3];
+    const XMFLOAT4* v[3] = { &a, &b, &c };
+    for (int i = 0; i < 3; ++i)
+    {
+        if (v[i]->w <= 0.0f) return; // 近平面クリップ後は来ないはず（正射影の退化対策）
+        const float iw = 1.0f / v[i]->w;
+        x[i] = (v[i]->x * iw * 0.5f + 0.5f) * w;
+        y[i] = (0.5f - v[i]->y * iw * 0.5f) * h;
+        z[i] = v[i]->z * iw;
+    }
+
+    // 符号付き面積：負なら 1 と 2 を入れ替えて常に正の向きにする（裏面も塗る）
+    float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+    if (std::fabs(area) < 1e-8f || !std::isfinite(area)) return;
+    if (area < 0.0f)
+    {
+        std::swap(x[1], x[2]); std::swap(y[1], y[2]); std::swap(z[1], z[2]);
+        area = -area;
+    }
+
+    Triangle t;
+    t.minX = std::max<std::int32_t>(0, (std::int32_t)std::floor(std::min({ x[0], x[1], x[2] })));
+    t.maxX = std::min<std::int32_t>((std::int32_t)m_width - 1, (std::int32_t)std::ceil(std::max({ x[0], x[1], x[2] })));
+    t.minY = std::max<std::int32_t>(0, (std::int32_t)std::floor(std::min({ y[0], y[1], y[2] })));
+    t.maxY = std::min<std::int32_t>((std::int32_t)m_height - 1, (std::int32_t)std::ceil(std::max({ y[0], y[1], y[2] })));
+    if (t.minX > t.maxX || t.minY > t.maxY) return;
+
+    // エッジ i（頂点 i → i+1）：正の向きの三角形では内側が正
+    for (int i = 0; i < 3; ++i)
+    {
+        const int j = (i + 1) % 3;
+        t.ex[i] = y[i] - y[j];
+        t.ey[i] = x[j] - x[i];
+        t.ec[i] = x[i] * y[j] - y[i] * x[j];
+    }
+
+    // 深度平面（画面座標で線形：NDC z は 1/w 補間不要）
+    const float dx1 = x[1] - x[0], dy1 = y[1] - y[0], dz1 = z[1] - z[0];
+    const float dx2 = x[2] - x[0], dy2 = y[2] - y[0], dz2 = z[2] - z[0];
+    const float invArea = 1.0f / area;
+    t.za = (dz1 * dy2 - dz2 * dy1) * invArea;
+    t.zb = (dz2 * dx1 - dz1 * dx2) * invArea;
+    t.zc = z[0] - t.za * x[0] - t.zb * y[0];
+
+    m_tris.push_back(t);
+}
+
+// ============================================================================
+// ラスタライズ
+// ============================================================================
+void OcclusionCuller::Rasterize()
+{
+    // 三角形を帯へビニング（外接矩形がかかる帯すべてに入れる）
+    for (auto& bin : m_bins) bin.clear();
+    for (std::uint32_t i = 0; i < (std::uint32_t)m_tris.size(); ++i)
+    {
+        const Triangle& t = m_tris[i];
+        for (std::int32_t b = t.minY / (std::int32_t)kTileSize; b <= t.maxY / (std::int32_t)kTileSize; ++b)
+            m_bins[b].push_back(i);
+    }
+    m_stats.rasterizedTriangles = static_cast<std::uint32_t>(m_tris.size());
+
+    JobSystem::ParallelFor(m_tilesY, 1, [this](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t b = begin; b < end; ++b) RasterizeBand(static_cast<std::uint32_t>(b));
+        });
+}
+
+void OcclusionCuller::RasterizeBand(std::uint32_t band)
+{
+    float* depth = const_cast<float*>(Depth());
+
+    const std::int32_t y0 = (std::int32_t)(band * kTileSize);
+    const std::int32_t y1 = y0 + (std::int32_t)kTileSize - 1;
+    std::fill(depth + (std::size_t)y0 * m_width, depth + (std::size_t)(y1 + 1) * m_width, kClearDepth);
+
+    for (std::uint32_t i : m_bins[band])
+    {
+        const Triangle& t = m_tris[i];
+        const std::int32_t ya = std::max(t.minY, y0);
+        const std::int32_t yb = std::min(t.maxY, y1);
+        if (m_useAvx2) RasterizeSpanAvx2(t, depth, m_width, ya, yb);
+        else           RasterizeSpanScalar(t, depth, m_width, ya, yb);
+    }
+
+    // この帯のタイルの HiZ（タイル内で最も遠い深度）
+    for (std::uint32_t tx = 0; tx < m_tilesX; ++tx)
+    {
+        float farthest = 0.0f;
+        for (std::int32_t y = y0; y <= y1; ++y)
+        {
+            const float* p = depth + (std::size_t)y * m_width + tx * kTileSize;
+            for (std::uint32_t k = 0; k < kTileSize; ++k) farthest = std::max(farthest, p[k]);
+        }
+        m_hiZ[(std::size_t)band * m_tilesX + tx] = farthest;
+    }
+}
+
+// ============================================================================
+// 判定
+// ============================================================================
+/*
+    IsVisible
+      1) AABB の 8 頂点をクリップ空間へ。1 つでも近平面の手前（z < 0）なら可視。
+      2) 画面上の外接矩形（画素）と、最も手前の深度 minZ を求める。
+      3) 矩形にかかるタイルごとに：
+           - HiZ < minZ ならタイル全体がオクルーダより奥 → このタイルでは隠れている
+           - そうでなければ画素単位で「深度 >= minZ」の画素を探す。1 つでもあれば可視。
+      4) すべてのタイルで隠れていれば不可視。
+*/
+bool OcclusionCuller::IsVisible(const AABB& box) const
+{
+    if (!box.IsValid()) return true;
+
+    const XMMATRIX vp = XMLoadFloat4x4(&m_viewProj);
+    float minX = 1e30f, maxX = -1e30f, minY = 1e30f, maxY = -1e30f, minZ = 1e30f;
+    for (int i = 0; i < 8; ++i)
+    {
+        const XMVECTOR p = XMVectorSet(
+            (i & 1) ? box.Max.x : box.Min.x,
+            (i & 2) ? box.Max.y : box.Min.y,
+            (i & 4) ? box.Max.z : box.Min.z, 1.0f);
+        XMFLOAT4 c;
+        XMStoreFloat4(&c, XMVector4Transform(p, vp));
+        if (c.z < 0.0f || c.w <= 0.0f) return true;
+        const float iw = 1.0f / c.w;
+        const float sx = (c.x * iw * 0.5f + 0.5f) * (float)m_width;
+        const float sy = (0.5f - c.y * iw * 0.5f) * (float)m_height;
+        minX = std::min(minX, sx); maxX = std::max(maxX, sx);
+        minY = std::min(minY, sy); maxY = std::max(maxY, sy);
+        minZ = std::min(minZ, c.z * iw);
+    }
+
+    const std::int32_t px0 = std::max<std::int32_t>(0, (std::int32_t)std::floor(minX));
+    const std::int32_t px1 = std::min<std::int32_t>((std::int32_t)m_width - 1, (std::int32_t)std::floor(maxX));
+    const std::int32_t py0 = std::max<std::int32_t>(0, (std::int32_t)std::floor(minY));
+    const std::int32_t py1 = std::min<std::int32_t>((std::int32_t)m_height - 1, (std::int32_t)std::floor(maxY));
+    if (px0 > px1 || py0 > py1) return true; // 画面外（視錐台カリング側に任せる）
+
+    const float* depth = Depth();
+
+    const std::int32_t ts = (std::int32_t)kTileSize;
+    for (std::int32_t ty = py0 / ts; ty <= py1 / ts; ++ty)
+    {
+        for (std::int32_t tx = px0 / ts; tx <= px1 / ts; ++tx)
+        {
+            if (m_hiZ[(std::size_t)ty * m_tilesX + tx] < minZ) continue; // タイル全体が手前で塞がれている
+
+            const std::int32_t xa = std::max(px0, tx * ts) - tx * ts;
+            const std::int32_t xb = std::min(px1, tx * ts + ts - 1) - tx * ts;
+            const std::int32_t ya = std::max(py0, ty * ts);
+            const std::int32_t yb = std::min(py1, ty * ts + ts - 1);
+            for (std::int32_t y = ya; y <= yb; ++y)
+            {
+                const float* block = depth + (std::size_t)y * m_width + tx * ts;
+                if (m_useAvx2 ? AnyFartherAvx2(block, xa, xb, minZ) : AnyFartherScalar(block, xa, xb, minZ))
+                    return true;
+            }
+        }
+    }
+    return false;
+}
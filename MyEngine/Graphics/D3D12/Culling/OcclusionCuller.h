@@ -0,0 +1,129 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+#include "Assets/Bounds.h"
+#include "Assets/Mesh.h"
+
+/*
+    OcclusionCuller.h
+    ----------------------------------------------------------------------------
+    目的：
+      - 視錐台カリングを通ったオブジェクトのうち、大きな遮蔽物（オクルーダ）の
+        裏に完全に隠れているものを CPU 側で捨てる（ソフトウェア・オクルージョンカリング）。
+      - 指定したオクルーダのメッシュだけを低解像度の深度バッファへラスタライズし、
+        オブジェクトの AABB をその深度と比べる。GPU には依存しない純 CPU コード。
+
+    深度バッファ：
+      - 既定 256x144。幅/高さは 8 の倍数に切り上げる。
+      - 深度は D3D 規約の NDC z（0=近, 1=遠）。クリア値 1、オクルーダは min で書く。
+      - 8x8 タイルごとに「タイル内の最も遠い深度」（HiZ）を持つ。
+        AABB 判定はまず HiZ で、タイル全体が AABB より手前ならそのタイルは画素を見ない。
+
+    ラスタライズ：
+      - 三角形ごとにクリップ空間へ変換 → 近平面でクリップ → 画面座標のエッジ関数を用意。
+      - 画面を 8 行ずつの帯（タイル行）に分け、JobSystem::ParallelFor で帯ごとに並列に塗る。
+        （三角形は事前に帯へビニング。帯は深度バッファ上で連続なので書き込みが衝突しない）
+      - 画素ループは AVX2 で 8 画素ずつ（エッジ判定 3 本 + 深度補間 + min ブレンド）。
+        AVX2 が使えない CPU ではスカラー版に切り替える（起動時に CPUID で判定）。
+        両者は同じ演算順なので結果はビット単位で一致する。
+      - 裏面も塗る（オクルーダの巻き順や両面メッシュを気にしなくてよい）。
+
+    使い方（1 ビュー 1 インスタンス）：
+      BeginFrame(viewProj) → AddOccluder(...) を必要数 → Rasterize() → IsVisible(box) を何度でも
+
+    注意：
+      - 画素中心で被覆を判定するので、バッファ 1 画素未満の隙間から覗くオブジェクトは
+        隠れていると判定されることがある（解像度とのトレードオフ）。
+      - AABB が近平面をまたぐ/カメラの後ろにかかる場合は常に可視とする（保守側）。
+*/
+
+/// ラスタライズの統計（デバッグ/Stats 表示用）
+struct OcclusionStats
+{
+    std::uint32_t occluderTriangles = 0;   ///< AddOccluder で投入された三角形数
+    std::uint32_t rasterizedTriangles = 0; ///< クリップ/縮退除去後に実際に塗った三角形数
+};
+
+class OcclusionCuller
+{
+public:
+    static constexpr std::uint32_t kTileSize = 8; ///< HiZ タイル/帯の一辺（画素）
+
+    explicit OcclusionCuller(std::uint32_t width = 256, std::uint32_t height = 144);
+
+    /// 深度バッファの解像度を変える（8 の倍数に切り上げ。内容は次の Rasterize まで不定）
+    void Resize(std::uint32_t width, std::uint32_t height);
+    std::uint32_t Width() const { return m_width; }
+    std::uint32_t Height() const { return m_height; }
+
+    /// この CPU/OS で AVX2 が使えるか（初回だけ CPUID を引く）
+    static bool IsAvx2Supported();
+
+    /// AVX2 版を使うか（false ならスカラー版。未対応 CPU では常にスカラー）
+    void SetSimdEnabled(bool enabled) { m_useAvx2 = enabled && IsAvx2Supported(); }
+    bool IsSimdEnabled() const { return m_useAvx2; }
+
+    /// フレーム開始：オクルーダを空にしてカメラを設定する
+    void BeginFrame(DirectX::FXMMATRIX viewProj);
+
+    /**
+     * @brief オクルーダを 1 つ追加する（三角形リスト）
+     * @param positions    頂点位置の先頭（ローカル空間）
+     * @param stride       頂点間のバイト数（Vertex 配列なら sizeof(Vertex)）
+     * @param vertexCount  頂点数
+     * @param indices      インデックス（3 つで 1 三角形）
+     * @param indexCount   インデックス数
+     * @param world        ワールド行列
+     */
+    void AddOccluder(const DirectX::XMFLOAT3* positions, std::size_t stride, std::size_t vertexCount,
+        const unsigned int* indices, std::size_t indexCount, DirectX::FXMMATRIX world);
+
+    void AddOccluder(const MeshData& mesh, DirectX::FXMMATRIX world)
+    {
+        AddOccluder(mesh.Vertices.empty() ? nullptr : &mesh.Vertices[0].Position, sizeof(Vertex),
+            mesh.Vertices.size(), mesh.Indices.data(), mesh.Indices.size(), world);
+    }
+
+    /// 追加済みオクルーダを深度バッファへ塗り、HiZ を作る（帯ごとに並列）
+    void Rasterize();
+
+    /**
+     * @brief ワールド AABB が（オクルーダに隠れず）見える可能性があれば true
+     * @details 直近の Rasterize の結果で判定する。無効な AABB は常に true。
+     */
+    bool IsVisible(const AABB& worldBox) const;
+
+    const OcclusionStats&      Stats() const { return m_stats; }
+    const DirectX::XMFLOAT4X4& ViewProj() const { return m_viewProj; }
+    const float*               Depth() const; ///< 行優先 Width x Height、32B 境界（デバッグ表示用）
+
+    /// 三角形 1 枚分のセットアップ結果（画面座標のエッジ関数と深度平面）
+    struct Triangle
+    {
+        float         ex[3], ey[3], ec[3]; ///< エッジ i：ex*x + ey*y + ec >= 0 が内側
+        float         za, zb, zc;          ///< 深度平面：z = za*x + zb*y + zc
+        std::int32_t  minX, maxX, minY, maxY; ///< 画素単位の外接矩形（両端含む、画面内にクランプ済み）
+    };
+
+private:
+    void ClipAndSetup(const DirectX::XMFLOAT4& a, const DirectX::XMFLOAT4& b, const DirectX::XMFLOAT4& c);
+    void SetupTriangle(const DirectX::XMFLOAT4& a, const DirectX::XMFLOAT4& b, const DirectX::XMFLOAT4& c);
+    void RasterizeBand(std::uint32_t band);
+
+    std::uint32_t m_width = 0;
+    std::uint32_t m_height = 0;
+    std::uint32_t m_tilesX = 0;
+    std::uint32_t m_tilesY = 0;
+    bool          m_useAvx2 = false;
+
+    DirectX::XMFLOAT4X4 m_viewProj{};
+    std::vector<float>  m_depth; ///< Width x Height（NDC z）
+    std::vector<float>  m_hiZ;   ///< タイルごとの最も遠い深度
+
+    std::vector<Triangle>                   m_tris;  ///< セットアップ済み三角形
+    std::vector<std::vector<std::uint32_t>> m_bins;  ///< 帯ごとの三角形番号
+    std::vector<DirectX::XMFLOAT4>          m_clip;  ///< 頂点のクリップ座標（作業用）
+    OcclusionStats                          m_stats;
+};
@@ -0,0 +1,611 @@
+﻿#include "Culling/StaticBvh.h"
+#include "Core/JobSystem.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using namespace DirectX;
+
+/*
+    StaticBvh.cpp
+    ----------------------------------------------------------------------------
+    構築の流れ：
+      1) 有効な AABB の ID を m_indices に並べ、重心を前計算
+      2) 直列フェーズ：ルートから分割し、担当数が taskSize 以下になったノードを“タスク”として保留
+         （大きいノードのビン集計は ParallelFor で並列化）
+      3) 並列フェーズ：タスクごとにローカル配列でサブツリーを構築（互いに m_indices の別範囲を触る）
+      4) 連結：ローカル配列を m_nodes の末尾に追加し、子番号を付け替える
+
+    SAH コスト（Ctrav=1, Cisect=1）：
+      split = 1 + (A_L * N_L + A_R * N_R) / A
+      leaf  = N
+      - N <= kMaxLeafSize かつ split >= leaf なら葉にする
+      - N >  kMaxLeafSize は常に分割（クエリの粒度を保つため）
+      - 重心が 1 点に潰れている場合は中央値で分割
+*/
+
+namespace
+{
+    constexpr int           kBinCount = 16;
+    constexpr std::uint32_t kMaxLeafSize = 4;
+    constexpr std::uint32_t kParallelBinThreshold = 32 * 1024; // これ以上のノードはビン集計を並列化
+    constexpr std::size_t   kBinChunk = 8 * 1024;               // 並列ビン集計の 1 チャンク
+
+    struct Box3
+    {
+        float mn[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+        float mx[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+        void Grow(const float* p)
+        {
+            for (int a = 0; a < 3; ++a) { mn[a] = std::min(mn[a], p[a]); mx[a] = std::max(mx[a], p[a]); }
+        }
+        void Grow(const Box3& b)
+        {
+            for (int a = 0; a < 3; ++a) { mn[a] = std::min(mn[a], b.mn[a]); mx[a] = std::max(mx[a], b.mx[a]); }
+        }
+        void Grow(const AABB& b)
+        {
+            mn[0] = std::min(mn[0], b.Min.x); mn[1] = std::min(mn[1], b.Min.y); mn[2] = std::min(mn[2], b.Min.z);
+            mx[0] = std::max(mx[0], b.Max.x); mx[1] = std::max(mx[1], b.Max.y); mx[2] = std::max(mx[2], b.Max.z);
+        }
+        float HalfArea() const
+        {
+            if (mn[0] > mx[0]) return 0.0f;
+            const float dx = mx[0] - mn[0], dy = mx[1] - mn[1], dz = mx[2] - mn[2];
+            return dx * dy + dy * dz + dz * dx;
+        }
+    };
+
+    struct Bin
+    {
+        Box3          bounds;   // プリミティブ AABB の和
+        Box3          centroid; // 重心の範囲（子ノードの重心範囲として引き継ぐ）
+        std::uint32_t count = 0;
+    };
+
+    // ビン集計の作業領域。小さいノードではビン数を減らし、使う分だけ初期化する
+    // （毎ノード 3x16 ビンを丸ごと初期化すると、葉付近でそのコストが支配的になるため）
+    struct BinSet
+    {
+        Bin  bins[3][kBinCount];
+        Box3 centroid;     // 集計前に与える重心範囲（ビン割当て用）
+        int  binCount = kBinCount;
+
+        void Reset(const Box3& cb, int nb)
+        {
+            centroid = cb;
+            binCount = nb;
+            for (int a = 0; a < 3; ++a)
+                for (int b = 0; b < nb; ++b) bins[a][b] = Bin();
+        }
+
+        void Merge(const BinSet& o)
+        {
+            for (int a = 0; a < 3; ++a)
+                for (int b = 0; b < binCount; ++b)
+                {
+                    bins[a][b].bounds.Grow(o.bins[a][b].bounds);
+                    bins[a][b].centroid.Grow(o.bins[a][b].centroid);
+                    bins[a][b].count += o.bins[a][b].count;
+                }
+        }
+    };
+
+    // 構築中に共有する読み取り専用データ + インデックス配列
+    struct BuildContext
+    {
+        const std::vector<AABB>*     boxes = nullptr;
+        std::vector<XMFLOAT3>        centroids;
+        std::uint32_t*               indices = nullptr;
+    };
+
+    const float* C(const BuildContext& ctx, std::uint32_t id) { return &ctx.centroids[id].x; }
+
+    // 重心 → ビン番号の写像（軸ごとの係数を前計算しておく）
+    struct BinMap
+    {
+        float origin[3];
+        float scale[3]; // 潰れた軸は 0
+        int   binCount;
+
+        BinMap(const Box3& cb, int nb) : binCount(nb)
+        {
+            for (int a = 0; a < 3; ++a)
+            {
+                const float ext = cb.mx[a] - cb.mn[a];
+                origin[a] = cb.mn[a];
+                scale[a] = (ext > 0.0f) ? nb / ext : 0.0f;
+            }
+        }
+
+        int operator()(int axis, float c) const
+        {
+            const int b = static_cast<int>((c - origin[axis]) * scale[axis]);
+            return std::min(std::max(b, 0), binCount - 1);
+        }
+    };
+
+    // [first, first+count) の AABB 範囲と重心範囲を求める（大きければ並列）
+    void RangeBounds(const BuildContext& ctx, std::uint32_t first, std::uint32_t count,
+        Box3& outBounds, Box3& outCentroid)
+    {
+        auto scan = [&](std::size_t b, std::size_t e, Box3& bb, Box3& cb)
+            {
+                for (std::size_t i = b; i < e; ++i)
+                {
+                    const std::uint32_t id = ctx.indices[first + i];
+                    bb.Grow((*ctx.boxes)[id]);
+                    cb.Grow(C(ctx, id));
+                }
+            };
+
+        if (count < kParallelBinThreshold)
+        {
+            scan(0, count, outBounds, outCentroid);
+            return;
+        }
+
+        const std::size_t chunks = (count + kBinChunk - 1) / kBinChunk;
+        std::vector<Box3> bbs(chunks), cbs(chunks);
+        JobSystem::ParallelFor(count, kBinChunk, [&](std::size_t b, std::size_t e)
+            {
+                scan(b, e, bbs[b / kBinChunk], cbs[b / kBinChunk]);
+            });
+        for (std::size_t i = 0; i < chunks; ++i) { outBounds.Grow(bbs[i]); outCentroid.Grow(cbs[i]); }
+    }
+
+    void FillBins(const BuildContext& ctx, std::uint32_t first, std::size_t b, std::size_t e, BinSet& set)
+    {
+        const BinMap map(set.centroid, set.binCount);
+        for (std::size_t i = b; i < e; ++i)
+        {
+            const std::uint32_t id = ctx.indices[first + i];
+            const float* c = C(ctx, id);
+            for (int a = 0; a < 3; ++a)
+            {
+                if (map.scale[a] == 0.0f) continue; // 潰れた軸は使わない
+                Bin& bin = set.bins[a][map(a, c[a])];
+                bin.bounds.Grow((*ctx.boxes)[id]);
+                bin.centroid.Grow(c);
+                ++bin.count;
+            }
+        }
+    }
+
+    void SetNodeBounds(BvhNode& n, const Box3& b)
+    {
+        n.Min = XMFLOAT3(b.mn[0], b.mn[1], b.mn[2]);
+        n.Max = XMFLOAT3(b.mx[0], b.mx[1], b.mx[2]);
+    }
+
+    Box3 NodeBox(const BvhNode& n)
+    {
+        Box3 b;
+        b.mn[0] = n.Min.x; b.mn[1] = n.Min.y; b.mn[2] = n.Min.z;
+        b.mx[0] = n.Max.x; b.mx[1] = n.Max.y; b.mx[2] = n.Max.z;
+        return b;
+    }
+
+    /*
+        SplitNode
+        - node を分割できれば true を返し、左右の子（範囲と AABB）を outL/outR に入れる。
+          子の重心範囲も outLc/outRc に返す（次の分割で範囲を数え直さずに済む）。
+        - 葉にすべきなら false。
+    */
+    bool SplitNode(const BuildContext& ctx, const BvhNode& node, const Box3& cb, BinSet& set,
+        BvhNode& outL, BvhNode& outR, Box3& outLc, Box3& outRc)
+    {
+        const std::uint32_t first = node.First;
+        const std::uint32_t count = node.Count;
+        if (count <= 1) return false;
+
+        const bool degenerate =
+            cb.mx[0] <= cb.mn[0] && cb.mx[1] <= cb.mn[1] && cb.mx[2] <= cb.mn[2];
+
+        std::uint32_t mid = first;
+        Box3 lb, rb;
+
+        if (!degenerate)
+        {
+            // --- ビン集計 ---
+            const int nb = static_cast<int>(std::min<std::uint32_t>(kBinCount, std::max<std::uint32_t>(4, count)));
+            set.Reset(cb, nb);
+            if (count < kParallelBinThreshold)
+            {
+                FillBins(ctx, first, 0, count, set);
+            }
+            else
+            {
+                const std::size_t chunks = (count + kBinChunk - 1) / kBinChunk;
+                std::vector<BinSet> partial(chunks);
+                for (auto& p : partial) p.Reset(cb, nb);
+                JobSystem::ParallelFor(count, kBinChunk, [&](std::size_t b, std::size_t e)
+                    {
+                        FillBins(ctx, first, b, e, partial[b / kBinChunk]);
+                    });
+                for (const auto& p : partial) set.Merge(p);
+            }
+
+            // --- SAH 評価（左から/右からの累積で全境界を O(bins) で） ---
+            float bestCost = FLT_MAX;
+            int   bestAxis = -1, bestSplit = -1;
+            for (int a = 0; a < 3; ++a)
+            {
+                if (cb.mx[a] <= cb.mn[a]) continue;
+
+                float         leftArea[kBinCount - 1];
+                std::uint32_t leftCount[kBinCount - 1];
+                Box3 acc; std::uint32_t n = 0;
+                for (int i = 0; i < nb - 1; ++i)
+                {
+                    acc.Grow(set.bins[a][i].bounds);
+                    n += set.bins[a][i].count;
+                    leftArea[i] = acc.HalfArea();
+                    leftCount[i] = n;
+                }
+                acc = Box3(); n = 0;
+                for (int i = nb - 1; i > 0; --i)
+                {
+                    acc.Grow(set.bins[a][i].bounds);
+                    n += set.bins[a][i].count;
+                    const std::uint32_t nl = leftCount[i - 1];
+                    if (nl == 0 || n == 0) continue;
+                    const float cost = leftArea[i - 1] * nl + acc.HalfArea() * n;
+                    if (cost < bestCost) { bestCost = cost; bestAxis = a; bestSplit = i; }
+                }
+            }
+
+            if (bestAxis >= 0)
+            {
+                const float parentArea = NodeBox(node).HalfArea();
+                const float splitCost = 1.0f + ((parentArea > 0.0f) ? bestCost / parentArea : 0.0f);
+                if (count <= kMaxLeafSize && splitCost >= static_cast<float>(count))
+                    return false; // 葉の方が安い
+
+                // --- パーティション（インプレース） ---
+                const BinMap map(cb, nb);
+                std::uint32_t* begin = ctx.indices + first;
+                std::uint32_t* m = std::partition(begin, begin + count, [&](std::uint32_t id)
+                    {
+                        return map(bestAxis, C(ctx, id)[bestAxis]) < bestSplit;
+                    });
+                mid = first + static_cast<std::uint32_t>(m - begin);
+
+                outLc = Box3(); outRc = Box3();
+                for (int i = 0; i < bestSplit; ++i)
+                {
+                    lb.Grow(set.bins[bestAxis][i].bounds);
+                    outLc.Grow(set.bins[bestAxis][i].centroid);
+                }
+                for (int i = bestSplit; i < nb; ++i)
+                {
+                    rb.Grow(set.bins[bestAxis][i].bounds);
+                    outRc.Grow(set.bins[bestAxis][i].centroid);
+                }
+            }
+        }
+
+        if (mid == first || mid == first + count)
+        {
+            // 重心が潰れている/分割できない：小さければ葉、大きければ中央値で割る
+            if (count <= kMaxLeafSize) return false;
+            mid = first + count / 2;
+            lb = Box3(); rb = Box3(); outLc = Box3(); outRc = Box3();
+            RangeBounds(ctx, first, mid - first, lb, outLc);
+            RangeBounds(ctx, mid, first + count - mid, rb, outRc);
+        }
+
+        outL = BvhNode{};
+        outL.First = first;
+        outL.Count = mid - first;
+        SetNodeBounds(outL, lb);
+
+        outR = BvhNode{};
+        outR.First = mid;
+        outR.Count = first + count - mid;
+        SetNodeBounds(outR, rb);
+        return true;
+    }
+
+    // 構築待ちノード（ノード番号 + その重心範囲）
+    struct PendingNode
+    {
+        std::uint32_t node;
+        Box3          centroid;
+    };
+
+    // nodes[0] をルートとするサブツリーを nodes 内に構築する（子番号は nodes ローカル）
+    void BuildSubtree(const BuildContext& ctx, std::vector<BvhNode>& nodes, const Box3& rootCentroid)
+    {
+        std::vector<PendingNode> stack{ { 0, rootCentroid } };
+        BinSet scratch;
+        while (!stack.empty())
+        {
+            const PendingNode p = stack.back();
+            stack.pop_back();
+
+            BvhNode l, r;
+            Box3 lc, rc;
+            if (!SplitNode(ctx, nodes[p.node], p.centroid, scratch, l, r, lc, rc)) continue; // 葉
+
+            const std::uint32_t left = static_cast<std::uint32_t>(nodes.size());
+            nodes[p.node].Left = left;
+            nodes.push_back(l);
+            nodes.push_back(r);
+            stack.push_back({ left, lc });
+            stack.push_back({ left + 1, rc });
+        }
+    }
+
+    // ---- クエリ用ヘルパ ----
+
+    bool Overlaps(const AABB& a, const XMFLOAT3& mn, const XMFLOAT3& mx)
+    {
+        return a.Min.x <= mx.x && a.Max.x >= mn.x
+            && a.Min.y <= mx.y && a.Max.y >= mn.y
+            && a.Min.z <= mx.z && a.Max.z >= mn.z;
+    }
+
+    bool Contains(const AABB& a, const XMFLOAT3& mn, const XMFLOAT3& mx)
+    {
+        return a.Min.x <= mn.x && a.Max.x >= mx.x
+            && a.Min.y <= mn.y && a.Max.y >= mx.y
+            && a.Min.z <= mn.z && a.Max.z >= mx.z;
+    }
+
+    // スラブ法：レイと AABB の進入距離（外れたら FLT_MAX）
+    float RayBox(const float o[3], const float inv[3], const XMFLOAT3& mn, const XMFLOAT3& mx, float maxT)
+    {
+        const float bmn[3] = { mn.x, mn.y, mn.z };
+        const float bmx[3] = { mx.x, mx.y, mx.z };
+        float t0 = 0.0f, t1 = maxT;
+        for (int a = 0; a < 3; ++a)
+        {
+            float tn = (bmn[a] - o[a]) * inv[a];
+            float tf = (bmx[a] - o[a]) * inv[a];
+            if (tn > tf) std::swap(tn, tf);
+            t0 = std::max(t0, tn);
+            t1 = std::min(t1, tf);
+            if (t0 > t1) return FLT_MAX;
+        }
+        return t0;
+    }
+}
+
+void StaticBvh::Clear()
+{
+    m_nodes.clear();
+    m_indices.clear();
+    m_boxes.clear();
+}
+
+void StaticBvh::Build(const std::vector<AABB>& boxes)
+{
+    Clear();
+    m_boxes = boxes;
+
+    // 1) 有効な AABB だけを対象にする
+    m_indices.reserve(boxes.size());
+    for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(boxes.size()); ++i)
+        if (boxes[i].IsValid()) m_indices.push_back(i);
+    const std::uint32_t n = static_cast<std::uint32_t>(m_indices.size());
+    if (n == 0) return;
+
+    BuildContext ctx;
+    ctx.boxes = &m_boxes;
+    ctx.indices = m_indices.data();
+    ctx.centroids.resize(boxes.size());
+    JobSystem::ParallelFor(boxes.size(), kBinChunk, [&](std::size_t b, std::size_t e)
+        {
+            for (std::size_t i = b; i < e; ++i)
+            {
+                const AABB& a = boxes[i];
+                ctx.centroids[i] = XMFLOAT3(
+                    (a.Min.x + a.Max.x) * 0.5f, (a.Min.y + a.Max.y) * 0.5f, (a.Min.z + a.Max.z) * 0.5f);
+            }
+        });
+
+    // ルート
+    m_nodes.reserve(2 * static_cast<std::size_t>(n));
+    Box3 rootCentroid;
+    {
+        BvhNode root{};
+        root.First = 0;
+        root.Count = n;
+        Box3 bb;
+        RangeBounds(ctx, 0, n, bb, rootCentroid);
+        SetNodeBounds(root, bb);
+        m_nodes.push_back(root);
+    }
+
+    // 2) 直列フェーズ：taskSize 以下になるまで上から割る
+    const std::uint32_t workers = JobSystem::WorkerCount();
+    const std::uint32_t taskSize = std::max<std::uint32_t>(1024, n / (workers * 4));
+    std::vector<PendingNode> tasks;
+    std::vector<PendingNode> work{ { 0, rootCentroid } };
+    BinSet scratch;
+    while (!work.empty())
+    {
+        const PendingNode p = work.back();
+        work.pop_back();
+        if (m_nodes[p.node].Count <= taskSize) { tasks.push_back(p); continue; }
+
+        BvhNode l, r;
+        Box3 lc, rc;
+        if (!SplitNode(ctx, m_nodes[p.node], p.centroid, scratch, l, r, lc, rc)) continue; // 葉（通常は起きない）
+
+        const std::uint32_t left = static_cast<std::uint32_t>(m_nodes.size());
+        m_nodes[p.node].Left = left;
+        m_nodes.push_back(l);
+        m_nodes.push_back(r);
+        work.push_back({ left, lc });
+        work.push_back({ left + 1, rc });
+    }
+
+    // 3) 並列フェーズ：タスクごとにローカル配列へサブツリーを構築
+    std::vector<std::vector<BvhNode>> locals(tasks.size());
+    JobSystem::ParallelFor(tasks.size(), 1, [&](std::size_t b, std::size_t e)
+        {
+            for (std::size_t t = b; t < e; ++t)
+            {
+                auto& local = locals[t];
+                local.reserve(2 * static_cast<std::size_t>(m_nodes[tasks[t].node].Count));
+                local.push_back(m_nodes[tasks[t].node]);
+                BuildSubtree(ctx, local, tasks[t].centroid);
+            }
+        });
+
+    // 4) 連結：ローカル 0 番はタスクノード自身、1.. は末尾へ追加（子番号を付け替え）
+    for (std::size_t t = 0; t < tasks.size(); ++t)
+    {
+        const auto& local = locals[t];
+        const std::uint32_t base = static_cast<std::uint32_t>(m_nodes.size());
+        auto remap = [base](BvhNode nd)
+            {
+                if (nd.Left) nd.Left = base + nd.Left - 1;
+                return nd;
+            };
+        m_nodes[tasks[t].node] = remap(local[0]);
+        for (std::size_t i = 1; i < local.size(); ++i) m_nodes.push_back(remap(local[i]));
+    }
+}
+
+void StaticBvh::QueryFrustum(const Frustum& frustum, std::vector<std::uint32_t>& out,
+    BvhQueryStats* stats) const
+{
+    if (m_nodes.empty()) return;
+
+    BvhQueryStats local{};
+    struct Entry { std::uint32_t node; std::uint32_t mask; };
+    std::vector<Entry> stack;
+    stack.reserve(64);
+    stack.push_back({ 0, 0x3Fu });
+
+    while (!stack.empty())
+    {
+        const Entry e = stack.back();
+        stack.pop_back();
+        const BvhNode& nd = m_nodes[e.node];
+        ++local.nodesVisited;
+
+        std::uint32_t mask = e.mask;
+        const CullResult c = frustum.Classify(nd.Min, nd.Max, mask);
+        if (c == CullResult::Outside) continue; // サブツリーごと棄却
+
+        if (c == CullResult::Inside)
+        {
+            // サブツリーごと採用：範囲が連続なのでそのまま追記
+            out.insert(out.end(), m_indices.begin() + nd.First, m_indices.begin() + nd.First + nd.Count);
+            ++local.subtreesAccepted;
+            continue;
+        }
+
+        if (nd.Left == 0)
+        {
+            // 葉：残っている平面だけで個別判定
+            for (std::uint32_t i = nd.First; i < nd.First + nd.Count; ++i)
+            {
+                const std::uint32_t id = m_indices[i];
+                std::uint32_t m = mask;
+                ++local.primitivesTested;
+                if (frustum.Classify(m_boxes[id].Min, m_boxes[id].Max, m) != CullResult::Outside) out.push_back(id);
+            }
+            continue;
+        }
+
+        stack.push_back({ nd.Left + 1, mask });
+        stack.push_back({ nd.Left, mask });
+    }
+
+    if (stats) *stats = local;
+}
+
+void StaticBvh::QueryOverlap(const AABB& box, std::vector<std::uint32_t>& out) const
+{
+    if (m_nodes.empty() || !box.IsValid()) return;
+
+    std::vector<std::uint32_t> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+
+    while (!stack.empty())
+    {
+        const BvhNode& nd = m_nodes[stack.back()];
+        stack.pop_back();
+        if (!Overlaps(box, nd.Min, nd.Max)) continue;
+
+        if (Contains(box, nd.Min, nd.Max))
+        {
+            // ノードごと box の内側：範囲をまとめて採用
+            out.insert(out.end(), m_indices.begin() + nd.First, m_indices.begin() + nd.First + nd.Count);
+            continue;
+        }
+
+        if (nd.Left == 0)
+        {
+            for (std::uint32_t i = nd.First; i < nd.First + nd.Count; ++i)
+            {
+                const std::uint32_t id = m_indices[i];
+                if (Overlaps(box, m_boxes[id].Min, m_boxes[id].Max)) out.push_back(id);
+            }
+            continue;
+        }
+
+        stack.push_back(nd.Left + 1);
+        stack.push_back(nd.Left);
+    }
+}
+
+bool StaticBvh::Raycast(const XMFLOAT3& origin, const XMFLOAT3& dir, float maxT,
+    std::uint32_t& outId, float& outT) const
+{
+    if (m_nodes.empty()) return false;
+
+    const float o[3] = { origin.x, origin.y, origin.z };
+    const float d[3] = { dir.x, dir.y, dir.z };
+    float inv[3];
+    for (int a = 0; a < 3; ++a) inv[a] = (d[a] != 0.0f) ? 1.0f / d[a] : FLT_MAX;
+
+    float best = maxT;
+    bool  hit = false;
+
+    if (RayBox(o, inv, m_nodes[0].Min, m_nodes[0].Max, best) == FLT_MAX) return false;
+    std::vector<std::uint32_t> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+
+    while (!stack.empty())
+    {
+        const BvhNode& nd = m_nodes[stack.back()];
+        stack.pop_back();
+
+        if (nd.Left == 0)
+        {
+            for (std::uint32_t i = nd.First; i < nd.First + nd.Count; ++i)
+            {
+                const std::uint32_t id = m_indices[i];
+                const float t = RayBox(o, inv, m_boxes[id].Min, m_boxes[id].Max, best);
+                if (t < best) { best = t; outId = id; hit = true; }
+            }
+            continue;
+        }
+
+        // 近い子を後に積んで先に処理する（遠い子は best 更新で刈られやすくなる）
+        const float tl = RayBox(o, inv, m_nodes[nd.Left].Min, m_nodes[nd.Left].Max, best);
+        const float tr = RayBox(o, inv, m_nodes[nd.Left + 1].Min, m_nodes[nd.Left + 1].Max, best);
+        if (tl <= tr)
+        {
+            if (tr != FLT_MAX) stack.push_back(nd.Left + 1);
+            if (tl != FLT_MAX) stack.push_back(nd.Left);
+        }
+        else
+        {
+            if (tl != FLT_MAX) stack.push_back(nd.Left);
+            if (tr != FLT_MAX) stack.push_back(nd.Left + 1);
+        }
+    }
+
+    if (hit) outT = best;
+    return hit;
+}
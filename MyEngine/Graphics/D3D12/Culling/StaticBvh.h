@@ -0,0 +1,90 @@
+﻿#pragma once
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+#include "Assets/Bounds.h"
+#include "Culling/Frustum.h"
+
+/*
+    StaticBvh.h
+    ----------------------------------------------------------------------------
+    目的：
+      - 動かない（Static）オブジェクトのワールド AABB 群に対する BVH。
+      - 視錐台クエリを階層的に行い、線形走査（N 回の AABB 判定）を避ける。
+      - レイクエリ（ピッキング等）で最も近い AABB ヒットを返す。
+
+    構造：
+      - ノードはフラット配列（m_nodes）。子は常に隣接ペア（Left, Left+1）で確保する。
+      - 各ノードは担当するプリミティブ範囲 [First, First+Count) を m_indices 上に持つ。
+        （分割はインプレースのパーティションなので、内部ノードの範囲も連続）
+        → 視錐台の完全内側と判定したノードは、子を辿らず範囲をまとめて出力できる。
+      - Left == 0 のノードが葉（ルート 0 は誰の子にもならないため識別に使える）。
+
+    構築：
+      - 重心の範囲を 16 ビンに分けた Binned SAH（3 軸すべて評価）。
+      - 上位数段は直列で分割し、十分な数のサブツリーができたら
+        JobSystem::ParallelFor でサブツリーを並列構築 → 最後に 1 本の配列へ連結。
+      - 大きなノードのビン集計自体も並列化する。
+
+    注意：
+      - 入力の AABB 配列の添字が「オブジェクト ID」。クエリはこの ID を返す。
+      - 無効な AABB（空メッシュ）は構築時に除外される（クエリで返らない）。
+*/
+
+/// BVH ノード（36B）。Left==0 なら葉。
+struct BvhNode
+{
+    DirectX::XMFLOAT3 Min;   ///< ノード AABB 最小
+    std::uint32_t     Left;  ///< 左の子のノード番号（右は Left+1）。0 なら葉
+    DirectX::XMFLOAT3 Max;   ///< ノード AABB 最大
+    std::uint32_t     First; ///< m_indices 上の先頭
+    std::uint32_t     Count; ///< 担当プリミティブ数
+};
+
+/// クエリ統計（デバッグ/Stats 表示用）
+struct BvhQueryStats
+{
+    std::uint32_t nodesVisited = 0;   ///< 判定したノード数
+    std::uint32_t subtreesAccepted = 0; ///< 完全内側として一括採用したサブツリー数
+    std::uint32_t primitivesTested = 0; ///< 葉で個別に判定したプリミティブ数
+};
+
+class StaticBvh
+{
+public:
+    /// boxes[i] を ID=i として構築（以前の内容は破棄）
+    void Build(const std::vector<AABB>& boxes);
+
+    void Clear();
+    bool Empty() const { return m_nodes.empty(); }
+    std::size_t NodeCount() const { return m_nodes.size(); }
+    std::size_t PrimitiveCount() const { return m_indices.size(); }
+    const std::vector<BvhNode>& Nodes() const { return m_nodes; }
+
+    /**
+     * @brief 視錐台と交差する（可能性のある）オブジェクト ID を out に追記する
+     * @details 完全外側のサブツリーは丸ごと棄却、完全内側のサブツリーは丸ごと採用。
+     */
+    void QueryFrustum(const Frustum& frustum, std::vector<std::uint32_t>& out,
+        BvhQueryStats* stats = nullptr) const;
+
+    /// box と重なる（境界が接するものを含む）オブジェクト ID を out に追記する
+    void QueryOverlap(const AABB& box, std::vector<std::uint32_t>& out) const;
+
+    /**
+     * @brief レイと AABB が最初に交差するオブジェクトを返す
+     * @param origin  レイ原点
+     * @param dir     レイ方向（正規化不要。t は dir の長さ単位）
+     * @param maxT    探索する最大距離
+     * @param outId   ヒットしたオブジェクト ID
+     * @param outT    ヒット距離（AABB への進入点）
+     * @return ヒットしたら true
+     */
+    bool Raycast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& dir, float maxT,
+        std::uint32_t& outId, float& outT) const;
+
+private:
+    std::vector<BvhNode>       m_nodes;   // フラットなノード配列（0 がルート）
+    std::vector<std::uint32_t> m_indices; // 葉/サブツリー範囲 → オブジェクト ID
+    std::vector<AABB>          m_boxes;   // オブジェクト ID → ワールド AABB（葉での個別判定用）
+};
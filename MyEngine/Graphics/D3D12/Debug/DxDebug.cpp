@@ -1,5 +1,5 @@
 #include "DxDebug.h"
-#include <comdef.h>   // _com_erroriHRESULTlԉǃbZ[Wj
+#include <comdef.h>   // _com_error（HRESULT→人間可読メッセージ）
 #include <sstream>    // std::wstringstream
 
 using Microsoft::WRL::ComPtr;
@@ -9,16 +9,16 @@ namespace dxdbg
 
     // ----------------------------------------------------------------------------
     // LogHRESULTError
-    // ړI: s HRESULT AlԂǂ߂`ŃfobOo̓EBhE֏oB
-    // p@: DX12/Win32 API Ăяo hr nBFAILED(hr) ̎óB
-    // o: [D3D12Renderer ERROR] <msg> HRESULT=0xXXXXXXXX : <VXebZ[W>
-    // : ʂɌĂ΂ƃfobOo͂܂̂ŁAvɌ肷邱ƁB
+    // 目的: 失敗した HRESULT を、人間が読める形でデバッグ出力ウィンドウへ出す。
+    // 用法: DX12/Win32 API 呼び出し直後に hr を渡す。FAILED(hr) の時だけ出力。
+    // 出力: [D3D12Renderer ERROR] <msg> HRESULT=0xXXXXXXXX : <システムメッセージ>
+    // 注意: 大量に呼ばれるとデバッグ出力が埋まるので、要所に限定すること。
     // ----------------------------------------------------------------------------
     void LogHRESULTError(HRESULT hr, const char* msg)
     {
         if (FAILED(hr))
         {
-            // _com_error g HRESULT ɑΉ Windows ̐擾ł
+            // _com_error を使うと HRESULT に対応する Windows の説明文を取得できる
             _com_error err(hr);
             std::wstring errMsg = err.ErrorMessage();
 
@@ -27,21 +27,21 @@ namespace dxdbg
                 << L" HRESULT=0x" << std::hex << hr
                 << L" : " << errMsg << L"\n";
 
-            // Visual Studio  "o" EBhE
+            // Visual Studio の "出力" ウィンドウへ
             OutputDebugStringW(wss.str().c_str());
         }
     }
 
     // ----------------------------------------------------------------------------
-    // SetupInfoQueueiԂ: Info  typoB API ݊̂߂̂܂܁j
-    // ړI: D3D12  InfoQueue ZbgAbvāAdxƂɃfobKŃu[NB
-    // Ăԏꏊ̖ڈ: foCXȂiKiInitialize ȂǁjB
-    // :
-    //   ECORRUPTION/ERROR/WARNING Ƀu[NiDebug \̂݁jB
-    //   Ȅ璷bZ[WtB^iMAP/UNMAP  NULL rangejB
-    // :
-    //   EDebug rhi_DEBUG Ă鎞̂ݗLjB
-    //   Eʏo͂CɂȂꍇ Severity /ID ǉŃtB^B
+    // SetupInfoQueue（※綴り: Info の typo。既存 API 互換のためそのまま）
+    // 目的: D3D12 の InfoQueue をセットアップして、重大度ごとにデバッガでブレークする。
+    // 呼ぶ場所の目安: デバイス生成後、初期化の早い段階（Initialize 内など）。
+    // 効果:
+    //   ・CORRUPTION/ERROR/WARNING 発生時にブレーク（Debug 構成のみ）。
+    //   ・特定の冗長メッセージをフィルタ（MAP/UNMAP の NULL range）。
+    // 注意:
+    //   ・Debug ビルド限定（_DEBUG が立っている時のみ有効）。
+    //   ・大量出力が気になる場合は Severity を下げる/ID を追加でフィルタする。
     // ----------------------------------------------------------------------------
     void SetupInfoQueue(ComPtr<ID3D12Device> device)
     {
@@ -51,13 +51,13 @@ namespace dxdbg
         ComPtr<ID3D12InfoQueue> iq;
         if (SUCCEEDED(device.As(&iq)))
         {
-            // dxʂɁuɃu[Nv
-            iq->SetBreakOnSeverity(D3D12_MESSAGE_SEVERITY_CORRUPTION, TRUE); // jȂǒvI
-            iq->SetBreakOnSeverity(D3D12_MESSAGE_SEVERITY_ERROR, TRUE);      // G[
-            iq->SetBreakOnSeverity(D3D12_MESSAGE_SEVERITY_WARNING, TRUE);    // x
+            // 重大度別に「発生時にブレーク」させる
+            iq->SetBreakOnSeverity(D3D12_MESSAGE_SEVERITY_CORRUPTION, TRUE); // メモリ破損など致命的
+            iq->SetBreakOnSeverity(D3D12_MESSAGE_SEVERITY_ERROR, TRUE);      // エラー
+            iq->SetBreakOnSeverity(D3D12_MESSAGE_SEVERITY_WARNING, TRUE);    // 警告
 
-            // 悭o邪mCYɂȂ₷bZ[W}
-            // : Map/Unmap ł NULL ͈͎͂dl OK ȃR[hło
+            // よく出るがノイズになりやすいメッセージを抑制
+            // 例: Map/Unmap での NULL 範囲は仕様上 OK なコードでも出がち
             D3D12_MESSAGE_ID deny[] = {
                 D3D12_MESSAGE_ID_MAP_INVALID_NULLRANGE,
                 D3D12_MESSAGE_ID_UNMAP_INVALID_NULLRANGE,
@@ -67,7 +67,7 @@ namespace dxdbg
             f.DenyList.NumIDs = _countof(deny);
             f.DenyList.pIDList = deny;
 
-            // ȍ~AInfoQueue ̃Xg[W֓郁bZ[WɃtB^|
+            // 以降、InfoQueue のストレージへ入るメッセージにフィルタが掛かる
             iq->PushStorageFilter(&f);
         }
 #endif
@@ -75,12 +75,12 @@ namespace dxdbg
 
     // ----------------------------------------------------------------------------
     // ReportLiveObjects
-    // ړI: foCXjOȂǂɁucĂvD3D12 IuWFNg|[gB
-    // Ăԏꏊ̖ڈ: Vbg_EOiS GPU ҂EO\[XjB
-    // o: D3D12_RLDO_DETAIL ŏڍׂói[NǐՂɕ֗jB
-    // :
-    //   EDebug rhB
-    //   EGPU gp̂܂܌ĂԂƑʂɏo/댟mɂȂ̂ŁAWaitForGPU ɌĂԁB
+    // 目的: デバイス破棄前などに「生き残っている」D3D12 オブジェクトをレポートする。
+    // 呼ぶ場所の目安: シャットダウン直前（全 GPU 完了待ち・自前リソース解放後）。
+    // 出力: D3D12_RLDO_DETAIL で詳細を出力（リーク追跡に便利）。
+    // 注意:
+    //   ・Debug ビルド限定。
+    //   ・GPU 使用中のまま呼ぶと大量に出る/誤検知になるので、FrameScheduler::WaitIdle 後に呼ぶ。
     // ----------------------------------------------------------------------------
     void ReportLiveObjects(ComPtr<ID3D12Device> device)
     {
@@ -90,7 +90,7 @@ namespace dxdbg
         ComPtr<ID3D12DebugDevice> dbg;
         if (SUCCEEDED(device.As(&dbg)))
         {
-            // D3D12_RLDO_DETAIL: ڍׂ܂ŏoB SUMMARY/IGNORE_INTERNAL ȂǂB
+            // D3D12_RLDO_DETAIL: 詳細まで出す。他に SUMMARY/IGNORE_INTERNAL などもある。
             dbg->ReportLiveDeviceObjects(D3D12_RLDO_DETAIL);
         }
 #endif // _DEBUG
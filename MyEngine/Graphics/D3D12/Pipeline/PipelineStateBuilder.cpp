@@ -1,4 +1,5 @@
 #include "PipelineStateBuilder.h"
+#include "Pipeline/VertexFormat.h"
 #include "d3dx12.h"
 #include <d3dcompiler.h>
 #include <cstring>
@@ -8,79 +9,122 @@
 using Microsoft::WRL::ComPtr;
 
 /*
-    VF[_Fŏ LambertigUjCeBO
-    - 萔obt@ b0  MVP / World / WorldIT / LightDir ێ
-    - VSFʒuϊ + @ WorldIT ŐK
-    - PSFNEL ̓ςŃJ[
+    シェーダ：最小限の Lambert（拡散）ライティング（インスタンシング対応）
+    - 定数バッファ b0 に View / Proj / ViewProj / ライト / 時間（パス共通）を保持
+    - t0 の StructuredBuffer にオブジェクトごとの World(3x4) / 法線行列(3x3) が常駐（スロット番号で引く）
+    - t1 はこのパスの「インスタンス → スロット番号」表。b1 のルート定数 g_drawBase が区間の先頭
+      （SV_InstanceID は StartInstanceLocation を含まないので、バッチの先頭はルート定数で渡す）
+    - VS：World → ViewProj の順に変換 + 法線を法線行列で変換して正規化
+    - 入力は GpuVertexStreams（スロットの違いはシェーダからは見えない）。OCT_NORMALS=1 なら NORMAL は八面体写像の float2（SNORM）で、
+      OctDecode で float3 に戻す（VertexQuantization.cpp の DecodeOctahedral と同じ式）。
+      位置が half4 の形式でも POSITION は float3 で読める（IA が w を捨てる）
+    - PS：N・L の内積でカラーを減衰
 */
 static const char* kVS = R"(
-cbuffer cb0 : register(b0)
+cbuffer PassCB : register(b0)
 {
-    row_major float4x4 g_mvp;
-    row_major float4x4 g_world;
-    row_major float4x4 g_worldIT;
-    float3 g_lightDir; float pad;
+    row_major float4x4 g_view;
+    row_major float4x4 g_proj;
+    row_major float4x4 g_viewProj;
+    float3 g_lightDir;   float g_time;
+    float3 g_lightColor; float pad0;
+    float3 g_cameraPos;  float pad1;
 };
+cbuffer DrawCB : register(b1) { uint g_drawBase; };
+struct InstanceData { row_major float3x4 world; row_major float3x3 normal; };
+StructuredBuffer<InstanceData> g_objects   : register(t0);
+StructuredBuffer<uint>         g_drawSlots : register(t1);
+#if OCT_NORMALS
+struct VSInput { float3 pos:POSITION; float2 normal:NORMAL; float4 color:COLOR; };
+float3 OctDecode(float2 e){
+    float3 n = float3(e, 1 - abs(e.x) - abs(e.y));
+    float  t = saturate(-n.z);
+    n.xy += (n.xy >= 0.0) ? float2(-t, -t) : float2(t, t);
+    return normalize(n);
+}
+#else
 struct VSInput { float3 pos:POSITION; float3 normal:NORMAL; float4 color:COLOR; };
+float3 OctDecode(float3 n){ return n; }
+#endif
 struct PSInput { float4 pos:SV_POSITION; float3 normal:NORMAL; float4 color:COLOR; };
-PSInput main(VSInput i){
+PSInput main(VSInput i, uint iid : SV_InstanceID){
+    InstanceData inst = g_objects[g_drawSlots[g_drawBase + iid]];
     PSInput o;
-    o.pos    = mul(float4(i.pos,1), g_mvp);
-    o.normal = normalize(mul(i.normal, (float3x3)g_worldIT));
+    float3 worldPos = mul(inst.world, float4(i.pos, 1));
+    o.pos    = mul(float4(worldPos, 1), g_viewProj);
+    o.normal = normalize(mul(OctDecode(i.normal), inst.normal));
     o.color  = i.color;
     return o;
 })";
 
 static const char* kPS = R"(
-cbuffer cb0 : register(b0)
+cbuffer PassCB : register(b0)
 {
-    row_major float4x4 g_mvp;
-    row_major float4x4 g_world;
-    row_major float4x4 g_worldIT;
-    float3 g_lightDir; float pad;
+    row_major float4x4 g_view;
+    row_major float4x4 g_proj;
+    row_major float4x4 g_viewProj;
+    float3 g_lightDir;   float g_time;
+    float3 g_lightColor; float pad0;
+    float3 g_cameraPos;  float pad1;
 };
 struct PSInput { float4 pos:SV_POSITION; float3 normal:NORMAL; float4 color:COLOR; };
 float4 main(PSInput i) : SV_TARGET {
-    float NdotL = max(dot(normalize(i.normal), -normalize(g_lightDir)), 0.0f);
-    return float4(i.color.rgb * NdotL, i.color.a);
+    float NdotL = max(dot(normalize(i.normal), -g_lightDir), 0.0f);
+    return float4(i.color.rgb * g_lightColor * NdotL, i.color.a);
 })";
 
 /*
     BuildLambertPipeline
-    F
-      - [gVOl`iCBV b0 ̂݁jgݗ
-      - VF[_^CŃRpCid3dcompilerj
-      - ̓CAEg/X^/uh/[xXeVݒ PSO 𐶐
-    OF
+    役割：
+      - ルートシグネチャ（[0] CBV b0、[1] 定数 b1、[2] SRV t0 = オブジェクト、[3] SRV t1 = スロット表）を組み立て
+      - シェーダをランタイムでコンパイル（d3dcompiler）
+      - 入力レイアウト/ラスタ/ブレンド/深度ステンシルを既定設定で PSO を生成
+    前提：
       - dev != nullptr
-      - rtvFmt/dsvFmt ͎ۂ̃_[^[QbgƍvĂ邱
-    ӁF
-      - ^CRpC͊JpBił͎ORpCς݃VF[_̎gpiDXCj
-      - ł vs_5_0 / ps_5_0 gpiDX12 Ȃ 5.1 ȏłOKj
+      - rtvFmt/dsvFmt は実際のレンダーターゲットと合致していること
+    注意：
+      - ランタイムコンパイルは開発用。製品では事前コンパイル済みシェーダの使用推奨（DXC等）
+      - ここでは vs_5_0 / ps_5_0 を使用（DX12 なら 5.1 以上でもOK）
 */
 bool BuildLambertPipeline(ID3D12Device* dev, DXGI_FORMAT rtvFmt, DXGI_FORMAT dsvFmt, PipelineSet& outPipe)
 {
     // ============================
-    // 1) [gVOl`쐬
+    // 1) ルートシグネチャ作成
     // ============================
-    // P CBV (b0) SXe[WŃoCh
-    CD3DX12_ROOT_PARAMETER root{};
-    root.InitAsConstantBufferView(
+    // [0] CBV (b0)：パス共通の定数。全ステージ可視
+    // [1] 定数 (b1)：32bit × 1。インスタンス区間の先頭（スロット表上の位置）。Draw ごとに変える
+    // [2] SRV (t0)：オブジェクトの StructuredBuffer（GpuSceneBuffer、常駐）
+    // [3] SRV (t1)：パスごとのスロット番号表。どちらもルートディスクリプタなのでヒープ不要
+    CD3DX12_ROOT_PARAMETER root[4]{};
+    root[0].InitAsConstantBufferView(
         /*shaderRegister=*/0,    // b0
-        /*registerSpace=*/0,     // Xy[X0
+        /*registerSpace=*/0,     // スペース0
         D3D12_SHADER_VISIBILITY_ALL);
+    root[1].InitAsConstants(
+        /*num32BitValues=*/1,
+        /*shaderRegister=*/1,    // b1
+        /*registerSpace=*/0,
+        D3D12_SHADER_VISIBILITY_VERTEX);
+    root[2].InitAsShaderResourceView(
+        /*shaderRegister=*/0,    // t0
+        /*registerSpace=*/0,
+        D3D12_SHADER_VISIBILITY_VERTEX);
+    root[3].InitAsShaderResourceView(
+        /*shaderRegister=*/1,    // t1
+        /*registerSpace=*/0,
+        D3D12_SHADER_VISIBILITY_VERTEX);
 
     D3D12_ROOT_SIGNATURE_DESC rs{};
-    rs.NumParameters = 1;
-    rs.pParameters = &root;
-    // IA ݂̂gisvȃXe[Wۂăof[Vɂj
+    rs.NumParameters = _countof(root);
+    rs.pParameters = root;
+    // IA のみを使う（不要なステージを拒否してバリデーションを緩くする）
     rs.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
 
-    ComPtr<ID3DBlob> sig, err; // err ͎sɃbZ[W
+    ComPtr<ID3DBlob> sig, err; // err は失敗時にメッセージが入る
     if (FAILED(D3D12SerializeRootSignature(
         &rs, D3D_ROOT_SIGNATURE_VERSION_1, &sig, &err)))
     {
-        //  err Ă΁Alԉǂ̃G[񂪓iKvȂ烍Oցj
+        // ここで err が取れていれば、人間可読のエラー文字列が得られる（必要ならログへ）
         return false;
     }
 
@@ -92,20 +136,26 @@ bool BuildLambertPipeline(ID3D12Device* dev, DXGI_FORMAT rtvFmt, DXGI_FORMAT dsv
     }
 
     // ============================
-    // 2) VF[_RpC
+    // 2) シェーダをコンパイル
     // ============================
-    ComPtr<ID3DBlob> VS, PS, ce; // ce: RpCG[iblobjBsɃbZ[W
+    ComPtr<ID3DBlob> VS, PS, ce; // ce: コンパイルエラー（blob）。失敗時にメッセージが入る
 
-    // J̓fobO/œKXLbvŃRpCiiterativeJj
-    // irhł D3DCOMPILE_OPTIMIZATION_LEVEL3 Ȃǂɐ؂ւ
+    // 開発時はデバッグ/最適化スキップでコンパイル（iterative開発向け）
+    // 製品ビルドでは D3DCOMPILE_OPTIMIZATION_LEVEL3 などに切り替える
     UINT compileFlags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
 
+    // 頂点形式に合わせて VS の入力を切り替える
+    const D3D_SHADER_MACRO vsDefines[] = {
+        { "OCT_NORMALS", GpuVertexStreams::Has<vfmt::NormalOct16>() ? "1" : "0" },
+        { nullptr, nullptr },
+    };
+
     if (FAILED(D3DCompile(
         kVS, std::strlen(kVS),
-        /*sourceName=*/nullptr, /*defines=*/nullptr, /*include=*/nullptr,
+        /*sourceName=*/nullptr, vsDefines, /*include=*/nullptr,
         "main", "vs_5_0", compileFlags, 0, &VS, &ce)))
     {
-        // s ce->GetBufferPointer() ɃG[iASCIIj
+        // 失敗時は ce->GetBufferPointer() にエラー文字列（ASCII）が入る
         return false;
     }
 
@@ -118,41 +168,34 @@ bool BuildLambertPipeline(ID3D12Device* dev, DXGI_FORMAT rtvFmt, DXGI_FORMAT dsv
     }
 
     // ============================
-    // 3) ̓CAEg
+    // 3) 入力レイアウト
     // ============================
-    // ӁF_\̂ **Sv** 邱
-    // - float3 pos (POSITION)   : 0 oCgItZbg
-    // - float3 normal (NORMAL)  : 12 oCgItZbg
-    // - float4 color  (COLOR)   : 24 oCgItZbg
-    D3D12_INPUT_ELEMENT_DESC layout[] = {
-        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0,  0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-        { "NORMAL",   0, DXGI_FORMAT_R32G32B32_FLOAT,    0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-        { "COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 24, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-    };
+    // 形式・オフセット・スロットは GpuVertexStreams の要素並びからコンパイル時に作られる
+    // （VB を詰める GpuVertexStreams::Encode と同じ記述なので食い違わない）
 
     // ============================
-    // 4) PSO ݒ
+    // 4) PSO 設定
     // ============================
     D3D12_GRAPHICS_PIPELINE_STATE_DESC pso{};
-    pso.InputLayout = { layout, _countof(layout) };
+    pso.InputLayout = GpuVertexStreams::InputLayout();
     pso.pRootSignature = outPipe.root.Get();
     pso.VS = CD3DX12_SHADER_BYTECODE(VS.Get());
     pso.PS = CD3DX12_SHADER_BYTECODE(PS.Get());
-    pso.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);      // : JOL/tB/[xNbvON
-    pso.BlendState = CD3DX12_BLEND_DESC(D3D12_DEFAULT);           // : At@uhȂ
-    pso.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);   // lx[XɁc
-    pso.DepthStencilState.DepthEnable = TRUE;                               // [xON
-    pso.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ALL;         // ݂
-    pso.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_LESS;         // ߂̂O
-    pso.SampleMask = UINT_MAX;                                    // SrbgL
-    pso.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;      // Op`Xg
-    pso.NumRenderTargets = 1;                                           // MRT 1
-    pso.RTVFormats[0] = rtvFmt;                                      // Ăяo RT ƈv
-    pso.DSVFormat = dsvFmt;                                      // Ăяo DSV ƈv
-    pso.SampleDesc.Count = 1;                                           // MSAA iKvȂvj
+    pso.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);      // 既定: カリング有り/フィル/深度クリップON
+    pso.BlendState = CD3DX12_BLEND_DESC(D3D12_DEFAULT);           // 既定: アルファブレンドなし
+    pso.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);   // 既定値をベースに…
+    pso.DepthStencilState.DepthEnable = TRUE;                               // 深度ON
+    pso.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ALL;         // 書き込みあり
+    pso.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_LESS;         // 近いものが前
+    pso.SampleMask = UINT_MAX;                                    // 全ビット有効
+    pso.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;      // 三角形リスト等
+    pso.NumRenderTargets = 1;                                           // MRT 1枚
+    pso.RTVFormats[0] = rtvFmt;                                      // 呼び出し側の RT と一致させる
+    pso.DSVFormat = dsvFmt;                                      // 呼び出し側の DSV と一致させる
+    pso.SampleDesc.Count = 1;                                           // MSAA 無し（必要なら一致させる）
 
     // ============================
-    // 5) PSO 𐶐
+    // 5) PSO を生成
     // ============================
     if (FAILED(dev->CreateGraphicsPipelineState(&pso, IID_PPV_ARGS(&outPipe.pso))))
         return false;
@@ -1,15 +1,15 @@
 #pragma once
 // ============================================================================
 // PipelineStateBuilder.h
-// ړIF
-//   - gLambert VF[fBOph̍ŏ RootSignature / PSO ЂƂ܂Ƃ߂ɂA
-//     Ăяo 1 ֐ŃZbgAbvł悤ɂwb_B
-//   - i.cppj HLSL ̑gݍ݁iD3DCompilej PSO \zsB
-// ^pF
-//   - ̓CAEg POSITION(float3) / NORMAL(float3) / COLOR(float4) zB
-//   - [gVOl` CBV(b0)  1 {iVS/PS LjɌB
-//   - [x͊ ONiLESSA݂jBKvȂ .cpp ŒB
-//   - RTV  1 ̂݁AtH[}bg͌ĂяoɎwB
+// 目的：
+//   - “Lambert シェーディング用”の最小限の RootSignature / PSO をひとまとめにし、
+//     呼び出し側が 1 関数でセットアップできるようにするヘッダ。
+//   - 実装（.cpp）側で HLSL の組み込み（D3DCompile）と PSO 構築を行う。
+// 運用メモ：
+//   - 入力レイアウトは GpuVertexStreams（VertexFormat.h）から生成する（位置はスロット 0、法線/色はスロット 1）。
+//   - ルートシグネチャは CBV(b0)（VS/PS 共有）+ SRV(t0)（VS、インスタンスバッファ）の 2 本。
+//   - 深度は既定で ON（LESS、書き込みあり）。必要なら .cpp 側で調整。
+//   - RTV は 1 枚のみ、フォーマットは呼び出し時に指定。
 // ============================================================================
 
 #include <wrl/client.h>
@@ -18,40 +18,42 @@
 
 // ----------------------------------------------------------------------------
 // PipelineSet
-// FBuildLambertPipeline őgݏグ RootSignature  PSO ̎󂯎MB
-// ӁFComPtr Ȃ̂ŎQƃJEg͎ǗBDestroy ͕svB
+// 役割：BuildLambertPipeline で組み上げた RootSignature と PSO の受け皿。
+// 注意：ComPtr なので参照カウントは自動管理。Destroy は不要。
 // ----------------------------------------------------------------------------
 struct PipelineSet {
-    Microsoft::WRL::ComPtr<ID3D12RootSignature> root;  // CBV(b0) 1 {̊Ȉ RootSig
-    Microsoft::WRL::ComPtr<ID3D12PipelineState> pso;   // Lambert p Graphics PSO
+    Microsoft::WRL::ComPtr<ID3D12RootSignature> root;  // [0] CBV(b0) / [1] SRV(t0) の簡易 RootSig
+    Microsoft::WRL::ComPtr<ID3D12PipelineState> pso;   // Lambert 用 Graphics PSO
 };
 
 // ----------------------------------------------------------------------------
 // BuildLambertPipeline
-// FLambert p HLSLiVS/PSjŃRpC  RootSig  PSO 쐬B
-// ߂lFtrue= / false=siD3DCompile/PSO 쐬̂ǂꂩsj
+// 役割：Lambert 用 HLSL（VS/PS）を内部でコンパイル → RootSig と PSO を作成。
+// 戻り値：true=成功 / false=失敗（D3DCompile/PSO 作成のどれかが失敗）
 //
-// F
-//  - dev       : D3D12 foCX
-//  - rtvFormat : o̓J[ DXGI tH[}bgiFDXGI_FORMAT_R8G8B8A8_UNORMj
-//  - dsvFormat : [xXeṼtH[}bgiFDXGI_FORMAT_D32_FLOATj
-//  - out       : 쐬 RootSignature / PSO i[îݗLj
+// 引数：
+//  - dev       : D3D12 デバイス
+//  - rtvFormat : 出力カラーの DXGI フォーマット（例：DXGI_FORMAT_R8G8B8A8_UNORM）
+//  - dsvFormat : 深度ステンシルのフォーマット（例：DXGI_FORMAT_D32_FLOAT）
+//  - out       : 作成した RootSignature / PSO を格納（成功時のみ有効）
 //
-// ҂oChF
-//  - VS/PS Ƃ CBV(b0) ɈȉҁF
-//      row_major float4x4 g_mvp;
-//      row_major float4x4 g_world;
-//      row_major float4x4 g_worldIT;
-//      float3 g_lightDir; float pad;
+// 期待するバインド：
+//  - ルートパラメータ [0]：VS/PS とも CBV(b0) に以下を期待（PassConstants）：
+//      row_major float4x4 g_view, g_proj, g_viewProj;
+//      float3 g_lightDir; float g_time; float3 g_lightColor; float pad0; float3 g_cameraPos; float pad1;
+//  - ルートパラメータ [1]：VS が 32bit 定数(b1) uint g_drawBase（インスタンス区間の先頭）を期待
+//  - ルートパラメータ [2]：VS が SRV(t0) に StructuredBuffer<InstanceData> g_objects を期待：
+//      struct InstanceData { row_major float3x4 world; row_major float3x3 normal; };
+//  - ルートパラメータ [3]：VS が SRV(t1) に StructuredBuffer<uint> g_drawSlots を期待
+//    インスタンス i のデータは g_objects[g_drawSlots[g_drawBase + SV_InstanceID]]。
 //
-// ҂̓CAEgF
-//  - POSITION : float3 (offset 0)
-//  - NORMAL   : float3 (offset 12)
-//  - COLOR    : float4 (offset 24)
+// 期待する入力レイアウト：
+//  - GpuVertexStreams::InputLayout()（既定：スロット 0 = POSITION float3 / スロット 1 = NORMAL 八面体 SNORM16x2 + COLOR RGBA8）
+//  - 法線が八面体形式なら OCT_NORMALS=1 でコンパイルし、VS で float3 に復号する
 //
-// pF
+// 利用例：
 //   PipelineSet pipe{};
-//   if (!BuildLambertPipeline(dev, rtvFmt, dsvFmt, pipe)) { /* G[ */ }
+//   if (!BuildLambertPipeline(dev, rtvFmt, dsvFmt, pipe)) { /* エラー処理 */ }
 //   cmd->SetGraphicsRootSignature(pipe.root.Get());
 //   cmd->SetPipelineState(pipe.pso.Get());
 // ----------------------------------------------------------------------------
@@ -0,0 +1,331 @@
+﻿#pragma once
+#include <d3d12.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Assets/Mesh.h"
+#include "Assets/VertexQuantization.h"
+
+/*
+===============================================================================
+ VertexFormat（GPU 頂点形式のコンパイル時記述）
+-------------------------------------------------------------------------------
+目的:
+  - CPU 側の Vertex（float 40B）は変えずに、GPU へ送る頂点の形式を「要素記述子の並び」で
+    1 か所に書く。並びから次をコンパイル時に作る：
+      * 各要素のオフセットと stride（詰めた頂点 1 個のバイト数）
+      * D3D12_INPUT_ELEMENT_DESC の配列（PSO の InputLayout）
+      * Vertex 配列 ⇄ 詰めた頂点配列の一括変換（要素ごとに VertexQuantization の SIMD 版を呼ぶ）
+  - 手書きのオフセット（12, 24 …）と構造体定義の食い違いを無くす。
+  - VertexStreams<F0, F1, …> は VertexFormat を頂点ストリーム（VB スロット）ごとに並べたもの。
+    ストリーム s の要素は InputSlot = s、オフセットはストリーム内で数える。
+
+要素記述子（vfmt::*）:
+  - kSemantic / kFormat / kSize と、Vertex 配列 ⇄ 詰めた配列（オフセット済み先頭 + stride）の
+    Encode / Decode を持つ。kSize は 4 の倍数（D3D12 の要素アラインメント）。
+  - 位置   : PositionF32（R32G32B32_FLOAT, 12B） / PositionF16（R16G16B16A16_FLOAT, 8B, w = 1）
+  - 法線   : NormalF32（R32G32B32_FLOAT, 12B） / NormalOct16（R16G16_SNORM, 4B, 八面体写像）
+  - 色     : ColorF32（R32G32B32A32_FLOAT, 16B） / ColorUnorm8（R8G8B8A8_UNORM, 4B）
+
+使う形式（GpuVertexStreams）:
+  - 位置だけのストリーム（スロット 0）と、法線 + 色のストリーム（スロット 1）に分ける。
+      スロット 0 : PositionF32（12B）
+      スロット 1 : NormalOct16 + ColorUnorm8（8B）
+    合計は StandardVertexFormat（インターリーブ 20B）と同じだが、深度/影のような位置しか読まない
+    パスはスロット 0 だけをバインドすれば 1 頂点 12B の読み出しで済む（PositionInputLayout）。
+  - kHalfVertexPositions を true にすると位置は PositionF16（8B）。
+    half は 2^-11 の相対精度なので、原点から遠い頂点（静的バッチはワールド空間に焼き込む）で
+    ずれが目立つ。ローカル空間の小さなメッシュだけなら有効にしてよい。
+  - シェーダは Has<vfmt::NormalOct16>() を見て法線の復号を切り替える（PipelineStateBuilder）。
+  - GeometryPool はストリームごとに VB を持ち、頂点区間（BaseVertex）は全ストリーム共通。
+===============================================================================
+*/
+
+namespace vfmt
+{
+    struct PositionF32
+    {
+        static constexpr const char* kSemantic = "POSITION";
+        static constexpr DXGI_FORMAT kFormat = DXGI_FORMAT_R32G32B32_FLOAT;
+        static constexpr UINT        kSize = 12;
+        static void Encode(const Vertex* src, std::size_t count, unsigned char* dst, std::size_t stride)
+        {
+            CopyFloat3(&src->Position, sizeof(Vertex), dst, stride, count); // 位置ストリーム（stride 12）は SSE で詰める
+        }
+        static void Decode(const unsigned char* src, std::size_t stride, Vertex* dst, std::size_t count)
+        {
+            CopyFloat3(src, stride, &dst->Position, sizeof(Vertex), count);
+        }
+    };
+
+    struct PositionF16
+    {
+        static constexpr const char* kSemantic = "POSITION";
+        static constexpr DXGI_FORMAT kFormat = DXGI_FORMAT_R16G16B16A16_FLOAT; // half3 の形式は無いので w = 1 を足す
+        static constexpr UINT        kSize = 8;
+        static void Encode(const Vertex* src, std::size_t count, unsigned char* dst, std::size_t stride)
+        {
+            EncodeHalf3(&src->Position, sizeof(Vertex), dst, stride, count);
+        }
+        static void Decode(const unsigned char* src, std::size_t stride, Vertex* dst, std::size_t count)
+        {
+            DecodeHalf3(src, stride, &dst->Position, sizeof(Vertex), count);
+        }
+    };
+
+    struct NormalF32
+    {
+        static constexpr const char* kSemantic = "NORMAL";
+        static constexpr DXGI_FORMAT kFormat = DXGI_FORMAT_R32G32B32_FLOAT;
+        static constexpr UINT        kSize = 12;
+        static void Encode(const Vertex* src, std::size_t count, unsigned char* dst, std::size_t stride)
+        {
+            for (std::size_t i = 0; i < count; ++i) std::memcpy(dst + stride * i, &src[i].Normal, kSize);
+        }
+        static void Decode(const unsigned char* src, std::size_t stride, Vertex* dst, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i) std::memcpy(&dst[i].Normal, src + stride * i, kSize);
+        }
+    };
+
+    struct NormalOct16
+    {
+        static constexpr const char* kSemantic = "NORMAL";
+        static constexpr DXGI_FORMAT kFormat = DXGI_FORMAT_R16G16_SNORM; // VS で float2 → float3 に復号する
+        static constexpr UINT        kSize = 4;
+        static void Encode(const Vertex* src, std::size_t count, unsigned char* dst, std::size_t stride)
+        {
+            EncodeOctahedralSnorm16(&src->Normal, sizeof(Vertex), dst, stride, count);
+        }
+        static void Decode(const unsigned char* src, std::size_t stride, Vertex* dst, std::size_t count)
+        {
+            DecodeOctahedralSnorm16(src, stride, &dst->Normal, sizeof(Vertex), count);
+        }
+    };
+
+    struct ColorF32
+    {
+        static constexpr const char* kSemantic = "COLOR";
+        static constexpr DXGI_FORMAT kFormat = DXGI_FORMAT_R32G32B32A32_FLOAT;
+        static constexpr UINT        kSize = 16;
+        static void Encode(const Vertex* src, std::size_t count, unsigned char* dst, std::size_t stride)
+        {
+            for (std::size_t i = 0; i < count; ++i) std::memcpy(dst + stride * i, &src[i].Color, kSize);
+        }
+        static void Decode(const unsigned char* src, std::size_t stride, Vertex* dst, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i) std::memcpy(&dst[i].Color, src + stride * i, kSize);
+        }
+    };
+
+    struct ColorUnorm8
+    {
+        static constexpr const char* kSemantic = "COLOR";
+        static constexpr DXGI_FORMAT kFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
+        static constexpr UINT        kSize = 4;
+        static void Encode(const Vertex* src, std::size_t count, unsigned char* dst, std::size_t stride)
+        {
+            EncodeUnorm8x4(&src->Color, sizeof(Vertex), dst, stride, count);
+        }
+        static void Decode(const unsigned char* src, std::size_t stride, Vertex* dst, std::size_t count)
+        {
+            DecodeUnorm8x4(src, stride, &dst->Color, sizeof(Vertex), count);
+        }
+    };
+}
+
+namespace vfmt::detail
+{
+    // クラス内の static constexpr メンバの初期化子からは同じクラスの関数を呼べない（未完成型）ので外に置く
+    template <class... Elements>
+    constexpr std::array<UINT, sizeof...(Elements)> Offsets()
+    {
+        std::array<UINT, sizeof...(Elements)> o{};
+        const UINT sizes[] = { Elements::kSize... };
+        UINT offset = 0;
+        for (std::size_t i = 0; i < sizeof...(Elements); ++i) { o[i] = offset; offset += sizes[i]; }
+        return o;
+    }
+
+    template <UINT Slot, class... Elements, std::size_t... I>
+    constexpr std::array<D3D12_INPUT_ELEMENT_DESC, sizeof...(Elements)> InputElements(std::index_sequence<I...>)
+    {
+        constexpr std::array<UINT, sizeof...(Elements)> offsets = Offsets<Elements...>();
+        return { {
+            { Elements::kSemantic, 0, Elements::kFormat, Slot, offsets[I], D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }...
+        } };
+    }
+
+    // ストリームごとの要素を InputSlot = ストリーム番号で 1 本の配列につなぐ
+    template <class... Streams, std::size_t... S>
+    constexpr std::array<D3D12_INPUT_ELEMENT_DESC, (Streams::kElementCount + ... + 0)> StreamInputElements(std::index_sequence<S...>)
+    {
+        std::array<D3D12_INPUT_ELEMENT_DESC, (Streams::kElementCount + ... + 0)> out{};
+        std::size_t k = 0;
+        auto append = [&](const auto& elements) { for (const auto& e : elements) out[k++] = e; };
+        (append(Streams::template InputElementsAt<static_cast<UINT>(S)>()), ...);
+        return out;
+    }
+}
+
+template <class... Elements>
+struct VertexFormat
+{
+    static constexpr std::size_t kElementCount = sizeof...(Elements);
+    static constexpr UINT        kStride = (Elements::kSize + ... + 0u);
+    static_assert(((Elements::kSize % 4 == 0) && ...), "頂点要素は 4B 単位にすること");
+
+    /// 各要素のオフセット（並び順に詰める）
+    static constexpr std::array<UINT, kElementCount> kOffsets = vfmt::detail::Offsets<Elements...>();
+
+    /// 詰めた頂点 1 個（中身はバイト列。要素には Offset<E>() でアクセスする）
+    struct alignas(4) Packed
+    {
+        unsigned char bytes[kStride];
+    };
+    static_assert(sizeof(Packed) == kStride, "Packed に詰め物が入っている");
+
+    /// 要素 E を含むか（シェーダの分岐用）
+    template <class E>
+    static constexpr bool Has() { return (std::is_same_v<E, Elements> || ...); }
+
+    /// 要素 E のオフセット（含まなければコンパイルエラー）
+    template <class E>
+    static constexpr UINT Offset()
+    {
+        static_assert(Has<E>(), "この形式に含まれない要素");
+        std::size_t i = 0;
+        const bool match[] = { std::is_same_v<E, Elements>... };
+        while (!match[i]) ++i;
+        return kOffsets[i];
+    }
+
+    /// PSO の入力レイアウト（スロット 0、頂点ごと）
+    static constexpr std::array<D3D12_INPUT_ELEMENT_DESC, kElementCount> kInputElements =
+        vfmt::detail::InputElements<0, Elements...>(std::make_index_sequence<kElementCount>{});
+
+    /// スロット Slot に置いたときの入力要素（VertexStreams が使う）
+    template <UINT Slot>
+    static constexpr std::array<D3D12_INPUT_ELEMENT_DESC, kElementCount> InputElementsAt()
+    {
+        return vfmt::detail::InputElements<Slot, Elements...>(std::make_index_sequence<kElementCount>{});
+    }
+
+    static D3D12_INPUT_LAYOUT_DESC InputLayout()
+    {
+        return { kInputElements.data(), static_cast<UINT>(kInputElements.size()) };
+    }
+
+    /// Vertex 配列 → 詰めた配列（要素ごとに一括変換）
+    static void Encode(const Vertex* src, std::size_t count, Packed* dst)
+    {
+        if (count == 0) return;
+        unsigned char* base = dst->bytes;
+        (Elements::Encode(src, count, base + Offset<Elements>(), kStride), ...);
+    }
+    static void Encode(const std::vector<Vertex>& src, std::vector<Packed>& dst)
+    {
+        dst.resize(src.size());
+        Encode(src.data(), src.size(), dst.data());
+    }
+
+    /// 詰めた配列 → Vertex 配列（量子化した要素は丸め後の値になる）
+    static void Decode(const Packed* src, std::size_t count, Vertex* dst)
+    {
+        if (count == 0) return;
+        const unsigned char* base = src->bytes;
+        (Elements::Decode(base + Offset<Elements>(), kStride, dst, count), ...);
+    }
+};
+
+/*
+    VertexStreams
+    ----------------------------------------------------------------------------
+    - ストリーム s の頂点は Stream<s>::Packed の配列で、別々の VB（スロット s）に置く。
+      頂点 i はどのストリームでも i 番目（BaseVertex/インデックスは全ストリーム共通）。
+    - Encode は Vertex 配列を 1 回ずつ走査して各ストリームへ振り分ける（要素ごとの SIMD 変換）。
+*/
+template <class... Streams>
+struct VertexStreams
+{
+    static constexpr std::size_t kStreamCount = sizeof...(Streams);
+    template <std::size_t S>
+    using Stream = std::tuple_element_t<S, std::tuple<Streams...>>;
+
+    /// ストリームごとの stride と、その合計（頂点 1 個が全 VB で占めるバイト数）
+    static constexpr std::array<UINT, kStreamCount> kStrides = { { Streams::kStride... } };
+    static constexpr UINT kStride = (Streams::kStride + ... + 0u);
+
+    /// ストリームごとに詰めた頂点配列（Encode の出力）
+    using Arrays = std::tuple<std::vector<typename Streams::Packed>...>;
+
+    template <class E>
+    static constexpr bool Has() { return (Streams::template Has<E>() || ...); }
+
+    /// PSO の入力レイアウト（全ストリーム。要素の InputSlot = ストリーム番号）
+    static constexpr std::array<D3D12_INPUT_ELEMENT_DESC, (Streams::kElementCount + ... + 0)> kInputElements =
+        vfmt::detail::StreamInputElements<Streams...>(std::make_index_sequence<kStreamCount>{});
+
+    static D3D12_INPUT_LAYOUT_DESC InputLayout()
+    {
+        return { kInputElements.data(), static_cast<UINT>(kInputElements.size()) };
+    }
+
+    /// ストリーム 0 だけの入力レイアウト（位置しか読まないパス用。スロット 0 だけバインドする）
+    static D3D12_INPUT_LAYOUT_DESC PositionInputLayout() { return Stream<0>::InputLayout(); }
+
+    /// Vertex 配列 → ストリームごとの詰めた配列
+    static void Encode(const Vertex* src, std::size_t count, typename Streams::Packed*... dst)
+    {
+        (Streams::Encode(src, count, dst), ...);
+    }
+    static void Encode(const std::vector<Vertex>& src, Arrays& dst)
+    {
+        std::apply([&](auto&... streams)
+            {
+                (streams.resize(src.size()), ...);
+                Encode(src.data(), src.size(), streams.data()...);
+            }, dst);
+    }
+
+    /// ストリームごとの詰めた配列 → Vertex 配列
+    static void Decode(std::size_t count, Vertex* dst, const typename Streams::Packed*... src)
+    {
+        (Streams::Decode(src, count, dst), ...);
+    }
+
+    /// 各ストリームの先頭（GeometryPool::Upload などへ渡す）
+    static std::array<const void*, kStreamCount> Data(const Arrays& arrays)
+    {
+        return std::apply([](const auto&... streams)
+            { return std::array<const void*, kStreamCount>{ { static_cast<const void*>(streams.data())... } }; }, arrays);
+    }
+};
+
+/// 旧形式（float ×10 = 40B）。比較・デバッグ用
+using FullVertexFormat = VertexFormat<vfmt::PositionF32, vfmt::NormalF32, vfmt::ColorF32>;
+/// float 位置 + 八面体法線 + RGBA8（20B）
+using StandardVertexFormat = VertexFormat<vfmt::PositionF32, vfmt::NormalOct16, vfmt::ColorUnorm8>;
+/// half 位置 + 八面体法線 + RGBA8（16B）
+using CompactVertexFormat = VertexFormat<vfmt::PositionF16, vfmt::NormalOct16, vfmt::ColorUnorm8>;
+
+/// 位置を half にするか（上の注意を参照）
+inline constexpr bool kHalfVertexPositions = false;
+
+/// 位置ストリーム（スロット 0）/ 法線 + 色ストリーム（スロット 1）
+using PositionStreamFormat = std::conditional_t<kHalfVertexPositions, VertexFormat<vfmt::PositionF16>, VertexFormat<vfmt::PositionF32>>;
+using AttributeStreamFormat = VertexFormat<vfmt::NormalOct16, vfmt::ColorUnorm8>;
+
+/// GeometryPool / MeshUploader / PSO が使う GPU 頂点形式
+using GpuVertexStreams = VertexStreams<PositionStreamFormat, AttributeStreamFormat>;
+
+static_assert(FullVertexFormat::kStride == sizeof(Vertex), "FullVertexFormat は Vertex と同じ並び");
+static_assert(StandardVertexFormat::kStride == 20 && CompactVertexFormat::kStride == 16, "想定外の stride");
+static_assert(GpuVertexStreams::kStreamCount == 2 && GpuVertexStreams::Stream<0>::kElementCount == 1 &&
+    (GpuVertexStreams::Stream<0>::Has<vfmt::PositionF32>() || GpuVertexStreams::Stream<0>::Has<vfmt::PositionF16>()),
+    "スロット 0 は位置だけのストリームにすること");
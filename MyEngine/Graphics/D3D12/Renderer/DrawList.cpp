@@ -0,0 +1,84 @@
+﻿#include "Renderer/DrawList.h"
+#include <cstring>
+#include <utility>
+
+/*
+    DrawList.cpp
+    ----------------------------------------------------------------------------
+    MakeKey：
+      - depth は IEEE754 の float。0 以上の値はビット列を符号なし整数として比べても大小が同じ。
+        負（カメラ中心より後ろ）や NaN は 0 に寄せる。
+    RadixSortDrawPackets：
+      - 8 桁ぶんのヒストグラムを 1 走査で作り、件数 n の桁（=全キーで同じ値）はパスごと飛ばす。
+        描画リストは pipeline/mesh 桁がほぼ同じなので、実際に回るパスは 4～5 回程度になる。
+      - data ⇔ scratch を交互に使い、最後に結果が scratch 側にあれば data へ戻す。
+*/
+
+std::uint64_t DrawList::MakeKey(std::uint32_t pipeline, std::uint32_t mesh, float depth)
+{
+    if (!(depth > 0.0f)) depth = 0.0f; // 負 / NaN
+    std::uint32_t depthBits;
+    std::memcpy(&depthBits, &depth, sizeof(depthBits));
+
+    return (static_cast<std::uint64_t>(pipeline & 0xFFu) << 56)
+        | (static_cast<std::uint64_t>(mesh & 0xFFFFFFu) << 32)
+        | depthBits;
+}
+
+void DrawList::Begin(std::size_t capacity)
+{
+    m_arena.Reset();
+    m_packets = m_arena.Allocate<DrawPacket>(capacity);
+    m_count = 0;
+    m_capacity = capacity;
+}
+
+void DrawList::Sort()
+{
+    if (m_count < 2) return;
+    DrawPacket* scratch = m_arena.Allocate<DrawPacket>(m_count);
+    RadixSortDrawPackets(m_packets, scratch, m_count);
+}
+
+void RadixSortDrawPackets(DrawPacket* data, DrawPacket* scratch, std::size_t n)
+{
+    if (n < 2) return;
+
+    // 8 桁ぶんのヒストグラム
+    std::size_t hist[8][256];
+    std::memset(hist, 0, sizeof(hist));
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const std::uint64_t k = data[i].key;
+        for (int d = 0; d < 8; ++d) ++hist[d][(k >> (d * 8)) & 0xFF];
+    }
+
+    DrawPacket* src = data;
+    DrawPacket* dst = scratch;
+    for (int d = 0; d < 8; ++d)
+    {
+        std::size_t* h = hist[d];
+
+        // 全キーがこの桁で同じ値 → 並びは変わらないので飛ばす
+        const std::size_t first = h[(src[0].key >> (d * 8)) & 0xFF];
+        if (first == n) continue;
+
+        // 件数 → 書き込み開始位置（排他的プレフィックス和）
+        std::size_t sum = 0;
+        for (int b = 0; b < 256; ++b)
+        {
+            const std::size_t c = h[b];
+            h[b] = sum;
+            sum += c;
+        }
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const std::size_t b = (src[i].key >> (d * 8)) & 0xFF;
+            dst[h[b]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    if (src != data) std::memcpy(data, src, n * sizeof(DrawPacket));
+}
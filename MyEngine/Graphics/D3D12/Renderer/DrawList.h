@@ -0,0 +1,66 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "Core/LinearAllocator.h"
+
+struct RenderItem;
+
+/*
+    DrawList.h
+    ----------------------------------------------------------------------------
+    目的：
+      - 「何を描くか（抽出）」と「コマンドを積む（記録）」を分けるための平らな描画リスト。
+      - 1 件 = ソートキー + 描画候補（RenderItem：メッシュ・ワールド行列・AABB）へのポインタ
+        + 描く LOD（同じ RenderItem でもビューごとに段が違いうるので、候補ではなくパケットに持つ）。
+        配列は LinearAllocator 上に取り、毎パス Reset するだけで使い回す。
+
+    ソートキー（64bit、昇順に並べる）：
+        [63..56] pipeline  …… PSO/マテリアル番号（切り替えが最も高いので最上位）
+        [55..32] mesh      …… メッシュ識別子（同じ VB/IB が連続 → IASet* を省ける。LOD ごとに別の値）
+        [31.. 0] depth     …… ビュー空間の奥行き（float のビット列。正の値は整数比較でも単調）
+      → 同じ PSO・同じメッシュの中では手前から奥へ（Early-Z が効きやすい）。
+
+    ソート：
+      - 8bit × 8 パスの LSD 基数ソート（安定）。全キーで同じ桁のパスは飛ばす。
+        ヒストグラムは 1 回の走査で 8 桁分まとめて数える。
+*/
+
+/// 描画リストの 1 件（24B）
+struct DrawPacket
+{
+    std::uint64_t     key;  ///< ソートキー（MakeKey）
+    const RenderItem* item; ///< 描画候補（フレーム内は SceneRenderer が保持）
+    std::uint32_t     lod;  ///< 描く LOD（MeshRendererComponent::Lods の添字）
+};
+
+class DrawList
+{
+public:
+    /// ソートキーを作る（pipeline 8bit、mesh 24bit、depth は負なら 0 扱い）
+    static std::uint64_t MakeKey(std::uint32_t pipeline, std::uint32_t mesh, float depth);
+
+    /// リストを空にして最大 capacity 件ぶんの領域を確保する（前回の領域はすべて破棄）
+    void Begin(std::size_t capacity);
+
+    /// 1 件追加（Begin の capacity を超えた分は捨てる）
+    void Push(std::uint64_t key, const RenderItem* item, std::uint32_t lod = 0)
+    {
+        if (m_count < m_capacity) m_packets[m_count++] = { key, item, lod };
+    }
+
+    /// キー昇順に並べ替える（安定）
+    void Sort();
+
+    const DrawPacket* begin() const { return m_packets; }
+    const DrawPacket* end() const { return m_packets + m_count; }
+    std::size_t       Size() const { return m_count; }
+
+private:
+    LinearAllocator m_arena;
+    DrawPacket*     m_packets = nullptr;
+    std::size_t     m_count = 0;
+    std::size_t     m_capacity = 0;
+};
+
+/// DrawPacket を key 昇順に基数ソートする（scratch は n 件ぶんの作業領域。結果は data に入る）
+void RadixSortDrawPackets(DrawPacket* data, DrawPacket* scratch, std::size_t n);
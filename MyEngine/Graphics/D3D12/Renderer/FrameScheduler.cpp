@@ -1,5 +1,5 @@
 // Renderer/FrameScheduler.cpp
-// PCHgĂȂ
+// PCHを使っているなら
 // #include "pch.h"
 
 #include "Renderer/FrameScheduler.h"
@@ -18,28 +18,29 @@
 /*
     FrameScheduler
     ----------------------------------------------------------------------------
-    ړIF
-      - 1t[́uJn`Iv܂ł̋ʏJvZB
-        * Ot[҂iFencej
-        * CommandAllocator/CommandList  Reset
+    目的：
+      - 1フレームの「開始～終了」までの共通処理をカプセル化。
+        * 前フレーム完了待ち（Fence）
+        * CommandListPool（アロケータ/リスト）の回収と払い出し
         * Submit/Present/Signal
-        * t[Ƃ Fence l̕Rti㑱̑ҋ@Ɏgj
-        * xjL[iGpuGarbageQueuejւ̓Ɖ
-
-    gF
-      - Initialize() ŕKvȃ\[XZbgB
-      - t[ Render() ̗ŁF
-         1) auto begin = BeginFrame();  // cmd 擾ăR[hJn
-         2) ... R}hL^ ...
-         3) EndFrame(&deadRT);          // oPresentxjo^
-
-    ӁiƂjF
-      - BackBufferIndex  Begin ŕߑAEnd Łu蒼ȂvƁB
-        Present ɃCfbNX؂ւ邽߁ABegin/End ŃY
-        ʃt[ FrameResources GĂ܂B
-      - Fence ĺuO Signal 邱ƂvOŒPSہB
-      - GpuGarbageQueue ւ̓ Submit Ɠt[ Fence lōsA
-        Collect() ͖t[ĂŃ[NhB
+        * フレームごとの Fence 値の紐付け（後続の待機に使う）
+        * アップロードページ（UploadRing）の退役/回収
+        * 遅延破棄キュー（GpuGarbageQueue）への投入と回収
+
+    使い方：
+      - Initialize() で必要なリソースをセット。
+      - 毎フレーム Render() 相当の流れで：
+         1) auto begin = BeginFrame();  // cmd を取得してレコード開始
+         2) ... コマンドを記録 ...
+         3) EndFrame(&deadRT);          // 提出＆Present＆遅延破棄登録
+
+    注意（落とし穴）：
+      - BackBufferIndex を Begin で捕捉し、End で「取り直さない」こと。
+        Present 後にインデックスが切り替わるため、Begin/End でズレると
+        別フレームの FrameResources を触ってしまう。
+      - Fence 値は「外部で Signal されることがある」前提で単調増加を担保。
+      - GpuGarbageQueue への投入は Submit と同じフレームの Fence 値で行い、
+        Collect() は毎フレーム呼んでリークを防ぐ。
 */
 
 void FrameScheduler::Initialize(DeviceResources* dev,
@@ -48,36 +49,36 @@ void FrameScheduler::Initialize(DeviceResources* dev,
     FrameResources* frames,
     GpuGarbageQueue* garbage)
 {
-    // ĂяȍLiǗ͌Ăяoju؂v
+    // 呼び出し側の所有物（寿命管理は呼び出し側）を「借りる」
     m_dev = dev;
     m_fence = fence;
     m_fenceEvent = fenceEvent;
     m_frames = frames;
     m_garbage = garbage;
 
-    // ɑSignalĂ\l completed+1 Jn
+    // 既に他所でSignalされてる可能性を考慮して completed+1 から開始
     const std::uint64_t completed = (m_fence ? m_fence->GetCompletedValue() : 0);
     m_nextFence = completed + 1;
 
-    // CtCg̃t[CfbNXiBeginFrameōXVj
+    // インフライトのフレームインデックス初期化（BeginFrameで更新）
     m_inFlightFrameIndex = 0;
 }
 
 FrameScheduler::BeginInfo FrameScheduler::BeginFrame()
 {
     // ==============================
-    // 1) t[ BackBufferIndex ߑ
-    //     EndFrame ōĎ擾ȂiPresent ɂ؂ւ邽߁j
+    // 1) 今フレームの BackBufferIndex を捕捉
+    //    ※ EndFrame で再取得しない（Present により切り替わるため）
     // ==============================
     const unsigned fi = m_dev->GetCurrentBackBufferIndex();
     m_inFlightFrameIndex = fi;
 
-    // t[p̃\[XZbgiAllocator/UPL̈Ȃǁj
+    // フレーム専用のリソースセット（Allocator/UPL領域など）
     auto& fr = m_frames->Get(fi);
 
     // ==============================
-    // 2) O񂱂̃t[CfbNXɓd̊҂
-    //    iFence ȂCxg҂j
+    // 2) 前回このフレームインデックスに投げた仕事の完了待ち
+    //    （Fence が未完了ならイベント待ち）
     // ==============================
     if (fr.fenceValue != 0 && m_fence->GetCompletedValue() < fr.fenceValue) {
         m_fence->SetEventOnCompletion(fr.fenceValue, static_cast<HANDLE>(m_fenceEvent));
@@ -85,84 +86,93 @@ FrameScheduler::BeginInfo FrameScheduler::BeginFrame()
     }
 
     // ==============================
-    // 3) Allocator  Resetĩt[̋L^JnłԂցj
+    // 3) GPU が実行し終えたコマンドアロケータ（Reset して空きへ）と
+    //    アップロードページを回収
     // ==============================
-    fr.cmdAlloc->Reset();
+    const std::uint64_t completed = m_fence->GetCompletedValue();
+    m_frames->CommandLists().BeginFrame(completed);
+    m_frames->Upload().BeginFrame(completed);
 
     // ==============================
-    // 4) ̂ CommandList 𐶐iȍ~ Reset ōėpj
+    // 4) メインのコマンドリストを払い出す（Reset 済み。PSO は呼び出し側で Set する前提）
+    //    ここから呼び出し側が記録を開始できる
     // ==============================
-    if (!m_cmd) {
-        ID3D12Device* dev = m_dev->GetDevice();
-        HRESULT hr = dev->CreateCommandList(
-            /*nodeMask=*/0,
-            D3D12_COMMAND_LIST_TYPE_DIRECT,
-            fr.cmdAlloc.Get(),
-            /*initialPSO=*/nullptr,
-            IID_PPV_ARGS(&m_cmd));
-        if (SUCCEEDED(hr)) {
-            // Reset Oɓꂵ̂ŁAx Close Ă
-            m_cmd->Close();
-        }
-    }
+    ID3D12GraphicsCommandList* cmd = m_frames->CommandLists().Acquire();
 
-    // PSO ͌Ăяo Set Oił nullptrj
-    // ĂяoL^Jnł
-    m_cmd->Reset(fr.cmdAlloc.Get(), nullptr);
+    return { fi, cmd };
+}
 
-    return { fi, m_cmd };
+ID3D12GraphicsCommandList* FrameScheduler::GetCmd() const
+{
+    return m_frames ? m_frames->CommandLists().Current() : nullptr;
 }
 
 void FrameScheduler::EndFrame(RenderTargetHandles* toDispose)
 {
     // ==============================
-    // 1) BeginFrame ŕߑ fi g
-    //    iPresent ɂĕς\邽ߍĎ擾Ȃj
+    // 1) BeginFrame で捕捉した fi を使う
+    //    （Present によって変わる可能性があるため再取得しない）
     // ==============================
     const unsigned fi = m_inFlightFrameIndex;
     auto& fr = m_frames->Get(fi);
 
     // ==============================
-    // 2) R}ho & Present
+    // 2) コマンドを提出 & Present
+    //    並列記録したリストも含め、払い出し順に 1 回で提出する
     // ==============================
-    m_cmd->Close();
-    ID3D12CommandList* lists[] = { m_cmd };
-    m_dev->GetQueue()->ExecuteCommandLists(1, lists);
-    m_dev->Present(1); // syncInterval=1iVSyncLjBKvɉĊOw肵ĂǂB
+    m_frames->CommandLists().Close(m_submit);
+    if (!m_submit.empty())
+        m_dev->GetQueue()->ExecuteCommandLists(static_cast<UINT>(m_submit.size()), m_submit.data());
+    m_dev->Present(1); // syncInterval=1（VSync有効）。必要に応じて外部から指定しても良い。
 
     // ==============================
-    // 3) Fence l̊Ǘ
-    //    - OSignalĂAɁucompleted+1 ȏv Signal Ɏg
-    //       Fence l̒Pۏ
+    // 3) Fence 値の管理（SignalNext：WaitIdle と同じカウンタを使う）
     // ==============================
-    const std::uint64_t completed = m_fence->GetCompletedValue();
-    m_nextFence = std::max<std::uint64_t>(m_nextFence, completed + 1);
-
-    const std::uint64_t sig = m_nextFence++;                  // t[ Signal lm
-    m_dev->GetQueue()->Signal(m_fence, sig);                  // GPU  Signal
+    std::uint64_t sig = 0;
+    SignalNext(sig);                                          // 今フレームの Signal 値を確定して GPU へ Signal
 
-    // ̃t[ FrameResource  fence RÂi Begin ̊҂ŎQƁj
+    // このフレームの FrameResource に fence を紐づける（次回 Begin の完了待ちで参照）
     fr.fenceValue = sig;
 
+    // このフレームで使ったコマンドリスト/アップロードページも同じ fence で退役させる
+    m_frames->CommandLists().EndFrame(sig);
+    m_frames->Upload().EndFrame(sig);
+
     // ==============================
-    // 4) xjiRenderTargetHandlesj
-    //    - ̃t[̊i=sigBjɔĵo^
-    //    - o^ toDispose ̓NAiL̓L[ֈړς݁j
+    // 4) 遅延破棄（RenderTargetHandles）
+    //    - このフレームの完了（=sig到達）後に破棄したいものを登録
+    //    - 登録後 toDispose はクリア（所有権はキューへ移動済み）
     // ==============================
     if (toDispose && (toDispose->color || toDispose->depth || toDispose->rtvHeap || toDispose->dsvHeap)) {
         if (m_garbage) EnqueueRenderTarget(*m_garbage, sig, std::move(*toDispose));
-        *toDispose = {}; // djh~̂ߋɂ
+        *toDispose = {}; // 二重破棄防止のため空にする
     }
 
-    // j\ɂȂit[ĂԁFߍݖh~j
+    // 破棄可能になった分を回収（毎フレーム呼ぶ：溜め込み防止）
     if (m_garbage) m_garbage->Collect(m_fence);
 }
 
-FrameScheduler::~FrameScheduler()
+std::uint64_t FrameScheduler::WaitIdle()
 {
-    // CommandList ͂ŉiAllocator  FrameResources Ǘj
-    if (m_cmd) {
-        m_cmd->Release();
-        m_cmd = nullptr;
+    if (!m_dev || !m_fence) return 0;
+
+    // EndFrame と同じ列の次の値で Signal → そこまで待つ
+    std::uint64_t sig = 0;
+    if (FAILED(SignalNext(sig))) return 0;
+    if (m_fence->GetCompletedValue() < sig) {
+        if (SUCCEEDED(m_fence->SetEventOnCompletion(sig, static_cast<HANDLE>(m_fenceEvent))))
+            WaitForSingleObject(static_cast<HANDLE>(m_fenceEvent), INFINITE);
     }
+    return sig;
+}
+
+HRESULT FrameScheduler::SignalNext(std::uint64_t& sig)
+{
+    // 外部Signalがあっても、常に「completed+1 以上」を次の Signal に使う
+    //   → Fence 値の単調増加を保証
+    const std::uint64_t completed = m_fence->GetCompletedValue();
+    m_nextFence = std::max<std::uint64_t>(m_nextFence, completed + 1);
+
+    sig = m_nextFence++;
+    return m_dev->GetQueue()->Signal(m_fence, sig);
 }
@@ -1,48 +1,54 @@
 #pragma once
 // ============================================================================
 // FrameScheduler.h
-// ړIF
-//   - 1t[̃CtTCNiBegin  R}hL^  End/PresentjW񂷂鏬ȎiߓB
-//   - t[isiFrameCount  FrameResources Oŉ񂷁j
-//     tFX҂ER}hAP[^ ResetEPresent/SignalExj̎sꊇǗB
-// ݌v|CgF
-//   - BeginFrame() Łũt[Ŏg FrameResources/R}hXgvԂB
-//   - EndFrame()  Present + tFX SignalARenderTarget ̒xjo^iCӁjB
-//   - uBegin Ɏ擾obNobt@CfbNXvێ End łgB
-//     iPresent Ɏ蒼ƃCfbNXił܂AقȂ FrameResources 
-//      QƂĂ܂̂h~j
-// gF
+// 目的：
+//   - 1フレームのライフサイクル（Begin → コマンド記録 → End/Present）を集約する小さな司令塔。
+//   - 複数フレーム同時進行（FrameCount 個の FrameResources をリングで回す）時の
+//     フェンス待ち・コマンドリストプールの回収・Present/Signal・遅延破棄の実行を一括管理。
+// 設計ポイント：
+//   - BeginFrame() で「このフレームで使う FrameResources/コマンドリスト」を返す。
+//   - EndFrame() で今フレームのコマンドリスト（CommandListPool から払い出した全本）を
+//     払い出し順に 1 回の ExecuteCommandLists で提出し、Present + フェンス Signal、
+//     RenderTarget の遅延破棄登録（任意）。
+//   - 記録の途中で並列記録用のリストが取られると「現在のリスト」が変わる。
+//     BeginFrame の cmd を使い続けず、続きは GetCmd() で取り直すこと。
+//   - 「Begin 時に取得したバックバッファインデックス」を保持して End でもそれを使う。
+//     （Present 後に取り直すとインデックスが進んでしまい、異なる FrameResources を
+//      参照してしまう事故を防止）
+// 使い方：
 //   auto b = scheduler.BeginFrame();
 //   ID3D12GraphicsCommandList* cmd = b.cmd;
-//   // ccmd ֋L^c
-//   scheduler.EndFrame(&rtToDispose); // j nullptr ftHgOK
+//   // …cmd へ記録…
+//   scheduler.EndFrame(&rtToDispose); // 破棄が無ければ nullptr かデフォルト引数でOK
 // ============================================================================
 
 #include <cstdint>
+#include <vector>
 
-// --- fwd declaresidˑj ---
+// --- fwd declares（重依存を避ける） ---
 struct ID3D12Fence;
+struct ID3D12CommandList;
 struct ID3D12GraphicsCommandList;
 class  DeviceResources;
 class  FrameResources;
 class  GpuGarbageQueue;
-struct RenderTargetHandles; // O錾̂܂܂OKî Core/RenderTarget.h j
+struct RenderTargetHandles; // 前方宣言のままでOK（実体は Core/RenderTarget.h 側）
 
 class FrameScheduler {
 public:
-    // BeginFrame() ԂŏZbg
+    // BeginFrame() が返す最小セット
     struct BeginInfo {
-        unsigned frameIndex;                 // ̃t[Ŏgpt[CfbNX
-        ID3D12GraphicsCommandList* cmd;      // L^ɎgR}hXg
+        unsigned frameIndex;                 // このフレームで使用するフレームインデックス
+        ID3D12GraphicsCommandList* cmd;      // 記録に使うコマンドリスト
     };
 
     // ----------------------------------------------------------------------------
     // Initialize
-    // F
-    //   - KvȋLIuWFNgifoCX/tFX/Cxg/t[Q/xjL[j
-    //   - tFXl̏i Signal ς݂̉\lAcompleted+1 Jnj
-    // OF
-    //   - dev/fence/frames ͗L
+    // 役割：
+    //   - 必要な共有オブジェクト（デバイス/フェンス/イベント/フレーム群/遅延破棄キュー）を結線
+    //   - フェンス値の初期化（既に Signal 済みの可能性を考慮し、completed+1 から開始）
+    // 前提：
+    //   - dev/fence/frames は有効
     // ----------------------------------------------------------------------------
     void Initialize(DeviceResources* dev,
         ID3D12Fence* fence,
@@ -52,46 +58,59 @@ public:
 
     // ----------------------------------------------------------------------------
     // BeginFrame
-    // F
-    //   - Jg̃obNobt@CfbNX擾AΉ FrameResources I
-    //   - KvȂ炻 Frame ̃tFX҂ăR}hAP[^ Reset
-    //   - R}hXgi쐬 orjReset ĕԂ
-    // ߂lF
-    //   - BeginInfoiframeIndex  cmdj
+    // 役割：
+    //   - カレントのバックバッファインデックスを取得し、対応する FrameResources を選択
+    //   - 必要ならその Frame のフェンス完了を待ち、完了済みのコマンドリスト/アップロードページを回収
+    //   - メインのコマンドリストをプールから 1 本取って返す
+    // 戻り値：
+    //   - BeginInfo（frameIndex と cmd）
     // ----------------------------------------------------------------------------
     BeginInfo BeginFrame();
 
     // ----------------------------------------------------------------------------
     // EndFrame
-    // F
-    //   - R}hXg Close  Execute  Present
-    //   - tFX Signal AYt[ fenceValue L^
-    //   - nꂽ RenderTargetHandles ΁A fence ɂԂ牺Ēxjo^
-    // F
-    //   - toDispose: t[̏Iɔj RT Zbginullptr ȂjȂj
-    // lF
-    //   - GpuGarbageQueue::Collect ĂŊςݕsx
+    // 役割：
+    //   - 今フレームのコマンドリストをすべて Close → 払い出し順に 1 回で Execute → Present
+    //   - フェンスを Signal し、当該フレームの fenceValue を記録
+    //   - 渡された RenderTargetHandles があれば、その fence にぶら下げて遅延破棄登録
+    // 引数：
+    //   - toDispose: 今フレームの終了時に破棄したい RT セット（nullptr なら破棄なし）
+    // 備考：
+    //   - GpuGarbageQueue::Collect を呼んで完了済み分を都度回収
     // ----------------------------------------------------------------------------
     void EndFrame(RenderTargetHandles* toDispose = nullptr);
 
-    // ݂̃t[ŎgĂR}hXgOɓn
-    ID3D12GraphicsCommandList* GetCmd() const { return m_cmd; }
+    // 現在のフレームで記録中のコマンドリスト（最後にプールから取ったもの）
+    ID3D12GraphicsCommandList* GetCmd() const;
 
-    // ǏniR}hXg Release Ȃǁj
-    ~FrameScheduler();
+    // ----------------------------------------------------------------------------
+    // WaitIdle
+    // 役割：
+    //   - キューに積んだ仕事がすべて終わるまで CPU で待つ（ロード時の区間解放/終了処理など）
+    //   - EndFrame と同じカウンタから次の値を取って Signal する
+    //     （別のカウンタで同じフェンスを Signal すると値が戻り、待ちがすり抜けたり
+    //      BeginFrame が届かない値を待ち続けたりする）
+    // 戻り値：
+    //   - 待った Signal 値（未初期化/Signal 失敗なら 0）
+    // ----------------------------------------------------------------------------
+    std::uint64_t WaitIdle();
 
 private:
-    // O狟鋤LIuWFNgQiؗpj
-    DeviceResources* m_dev = nullptr; // foCX/Xbv`FC/L[
-    FrameResources* m_frames = nullptr; // t[Ƃ̃AP[^/CB
-    GpuGarbageQueue* m_garbage = nullptr; // xjL[
-    ID3D12GraphicsCommandList* m_cmd = nullptr; // g 1 {̃R}hXg
-    ID3D12Fence* m_fence = nullptr; // GPU tFXiOLj
-    void* m_fenceEvent = nullptr; // tFXҋ@CxgiHANDLE  void* ŕێj
+    // 次の Signal 値を確定して GPU へ Signal する（EndFrame/WaitIdle 共用。値は単調増加）
+    // 戻り値は Signal の HRESULT（windows.h を引かないため long で受ける）
+    long SignalNext(std::uint64_t& sig);
+
+    // 外部から供給される共有オブジェクト群（借用）
+    DeviceResources* m_dev = nullptr; // デバイス/スワップチェイン/キュー
+    FrameResources* m_frames = nullptr; // フレームごとのフェンス値/コマンドリストプール/アップロード領域
+    GpuGarbageQueue* m_garbage = nullptr; // 遅延破棄キュー
+    std::vector<ID3D12CommandList*> m_submit; // EndFrame の提出用（作業用）
+    ID3D12Fence* m_fence = nullptr; // GPU 同期フェンス（外部所有）
+    void* m_fenceEvent = nullptr; // フェンス待機イベント（HANDLE を void* で保持）
 
-    std::uint64_t               m_nextFence = 0;       //  Signal tFXl
+    std::uint64_t               m_nextFence = 0;       // 次に Signal するフェンス値
 
-    //  BeginFrame Ŏ擾obNobt@CfbNXۑA
-    //   EndFrame  Present ɁuĎ擾Ȃv߂̃LbV
+    // ★ BeginFrame で取得したバックバッファインデックスを保存し、
+    //   EndFrame で Present 後に「再取得しない」ためのキャッシュ
     unsigned                    m_inFlightFrameIndex = 0;
 };
@@ -0,0 +1,119 @@
+﻿#include "Renderer/GpuSceneBuffer.h"
+#include "d3dx12.h"
+#include <cstring>
+
+using Microsoft::WRL::ComPtr;
+
+/*
+    GpuSceneBuffer.cpp
+    ----------------------------------------------------------------------------
+    Flush の中身：
+      1) HighWater が容量を超えていれば Grow（倍々）。新バッファは中身が無いので
+         生きているかに関わらず [0, HighWater) を全部書き換え扱いにする。
+      2) 区間をまとめ、合計サイズぶんのステージングを 1 回で切り出して順に詰める。
+      3) 現在の状態 → COPY_DEST → 区間ごとに CopyBufferRegion → NON_PIXEL_SHADER_RESOURCE。
+    注意：
+      - バッファは COMMON で作る（バッファは作成時の状態指定が無視される）。
+        COMMON からの遷移も明示バリアで行うので暗黙の昇格/減衰には頼らない。
+      - 解放済みスロットの写しは古いまま残る（描画で参照されないので送り直さない）。
+*/
+
+bool GpuSceneBuffer::Initialize(ID3D12Device* dev, std::uint32_t initialCapacity)
+{
+    Destroy();
+    m_device = dev;
+    m_capacity = 0;
+    m_shadow.reserve(initialCapacity);
+    return dev != nullptr;
+}
+
+void GpuSceneBuffer::Destroy()
+{
+    m_buffer.Reset();
+    m_state = D3D12_RESOURCE_STATE_COMMON;
+    m_capacity = 0;
+    m_slots.Clear();
+    m_dirty.Clear();
+    m_shadow.clear();
+    m_stats = GpuSceneBufferStats();
+}
+
+void GpuSceneBuffer::Write(std::uint32_t slot, const InstanceData& data)
+{
+    if (slot >= m_shadow.size()) m_shadow.resize(static_cast<std::size_t>(slot) + 1);
+    m_shadow[slot] = data;
+    m_dirty.Mark(slot);
+}
+
+bool GpuSceneBuffer::Grow(std::uint32_t required, UploadRing& upload)
+{
+    if (!m_device) return false;
+
+    std::uint32_t capacity = m_capacity > 0 ? m_capacity : kInitialCapacity;
+    while (capacity < required) capacity *= 2;
+
+    auto heap = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+    auto desc = CD3DX12_RESOURCE_DESC::Buffer(static_cast<UINT64>(capacity) * sizeof(InstanceData));
+    ComPtr<ID3D12Resource> buffer;
+    if (FAILED(m_device->CreateCommittedResource(&heap, D3D12_HEAP_FLAG_NONE, &desc,
+        D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(&buffer))))
+        return false;
+
+    // 旧バッファは今フレームまでのコマンドが参照しうる → フレームの Signal 値で解放
+    upload.DeferRelease(std::move(m_buffer));
+    m_buffer = std::move(buffer);
+    m_state = D3D12_RESOURCE_STATE_COMMON;
+    m_capacity = capacity;
+    ++m_stats.grows;
+
+    // 新バッファは空なので、これまでのスロットをすべて送り直す
+    m_dirty.MarkRange(0, m_slots.HighWater());
+    return true;
+}
+
+bool GpuSceneBuffer::Flush(ID3D12GraphicsCommandList* cmd, UploadRing& upload)
+{
+    m_stats.uploadedSlots = 0;
+    m_stats.copyRegions = 0;
+    m_stats.liveSlots = m_slots.LiveCount();
+    if (!cmd) return false;
+
+    const std::uint32_t required = m_slots.HighWater();
+    if (required > m_capacity && !Grow(required, upload)) return false;
+    m_stats.capacity = m_capacity;
+    if (m_dirty.Empty()) return true;
+
+    // 写しが足りない（確保だけして Write していない）スロットは 0 で埋めておく
+    if (m_shadow.size() < required) m_shadow.resize(required);
+
+    const std::size_t count = m_dirty.Build(kMergeGap, m_ranges);
+    const UploadAllocation staging = upload.Allocate(count * sizeof(InstanceData), 16);
+    if (!staging.cpu) return false; // 書き換えは残したまま次回へ
+
+    // ---- 遷移 → 区間ごとにコピー → シェーダ読み取りへ ----
+    if (m_state != D3D12_RESOURCE_STATE_COPY_DEST)
+    {
+        auto toCopy = CD3DX12_RESOURCE_BARRIER::Transition(m_buffer.Get(), m_state, D3D12_RESOURCE_STATE_COPY_DEST);
+        cmd->ResourceBarrier(1, &toCopy);
+    }
+
+    std::uint64_t offset = 0;
+    for (const SlotRange& r : m_ranges)
+    {
+        const std::uint64_t bytes = static_cast<std::uint64_t>(r.count) * sizeof(InstanceData);
+        std::memcpy(staging.cpu + offset, &m_shadow[r.first], static_cast<std::size_t>(bytes));
+        cmd->CopyBufferRegion(m_buffer.Get(), static_cast<UINT64>(r.first) * sizeof(InstanceData),
+            staging.resource, staging.offset + offset, bytes);
+        offset += bytes;
+    }
+
+    auto toRead = CD3DX12_RESOURCE_BARRIER::Transition(m_buffer.Get(), D3D12_RESOURCE_STATE_COPY_DEST,
+        D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+    cmd->ResourceBarrier(1, &toRead);
+    m_state = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+
+    m_dirty.Clear();
+    m_stats.uploadedSlots = static_cast<std::uint32_t>(count);
+    m_stats.copyRegions = static_cast<std::uint32_t>(m_ranges.size());
+    return true;
+}
@@ -0,0 +1,89 @@
+﻿#pragma once
+#include <wrl/client.h>
+#include <d3d12.h>
+#include <cstdint>
+#include <vector>
+
+#include "Graphics/SceneConstantBuffer.h"   // InstanceData
+#include "Core/UploadRing.h"                // 差分のステージング領域
+#include "Renderer/ObjectSlots.h"           // スロット管理 / 書き換え区間のまとめ
+
+/*
+    GpuSceneBuffer
+    ----------------------------------------------------------------------------
+    目的：
+      - オブジェクトごとの InstanceData（ワールド行列・法線行列）を DEFAULT ヒープの
+        StructuredBuffer に常駐させる。毎フレーム全オブジェクトを詰め直すのをやめ、
+        書き換えたスロットだけを送る。
+      - オブジェクトは安定したスロット番号で識別する（動かない限り何も送らない）。
+
+    想定フロー（SceneRenderer）：
+      1) Initialize(dev)
+      2) Prepare 中：新しいオブジェクトは AllocateSlot、消えたものは FreeSlot、
+         ワールド行列が変わったものは Write(slot, data)
+      3) Flush(cmd, upload)（毎フレーム 1 回、全ビューの描画より前）
+         - 必要ならバッファを伸ばす（旧バッファは UploadRing::DeferRelease で遅延解放）
+         - 書き換え区間を DirtySlotRanges でまとめ、UploadRing から切り出した
+           ステージング領域へ詰めて、区間ごとに CopyBufferRegion
+         - COPY_DEST ⇔ NON_PIXEL_SHADER_RESOURCE の遷移もここで行う
+      4) 描画：GpuAddress() をルート SRV にバインドし、スロット番号で引く
+
+    設計メモ：
+      - CPU 側に全スロットの写し（m_shadow）を持つ。区間の隙間や伸長時の再送はここから送る。
+      - バッファは同じ DIRECT キューで使うので、コピーと前フレームの読み出しはキュー順に並ぶ。
+        フレームごとに複製を持つ必要は無い。
+      - スレッドセーフではない（記録スレッドから呼ぶ）。
+*/
+
+/// 直近の Flush の統計（デバッグ/Stats 表示用）
+struct GpuSceneBufferStats
+{
+    std::uint32_t capacity = 0;      ///< GPU バッファの要素数
+    std::uint32_t liveSlots = 0;     ///< 使用中のスロット数
+    std::uint32_t uploadedSlots = 0; ///< 直近の Flush で送ったスロット数（隙間込み）
+    std::uint32_t copyRegions = 0;   ///< 直近の Flush の CopyBufferRegion 回数
+    std::uint32_t grows = 0;         ///< バッファを作り直した回数
+};
+
+class GpuSceneBuffer
+{
+public:
+    static constexpr std::uint32_t kInitialCapacity = 1024; ///< 最初に確保する要素数
+    static constexpr std::uint32_t kMergeGap = 8;           ///< この数以下の隙間を挟む区間はまとめて送る
+
+    bool Initialize(ID3D12Device* dev, std::uint32_t initialCapacity = kInitialCapacity);
+
+    /// GPU バッファと全スロットを解放する（GPU 完了待ち済みで呼ぶこと）
+    void Destroy();
+
+    std::uint32_t AllocateSlot() { return m_slots.Allocate(); }
+    void          FreeSlot(std::uint32_t slot) { m_slots.Free(slot); }
+
+    /// スロットの中身を書き換える（次の Flush で GPU へ送る）
+    void Write(std::uint32_t slot, const InstanceData& data);
+
+    /**
+     * @brief 書き換えたスロットを GPU バッファへ反映するコマンドを積む
+     * @return 失敗（バッファ/ステージングの確保失敗）なら false。書き換えは次回へ持ち越す
+     */
+    bool Flush(ID3D12GraphicsCommandList* cmd, UploadRing& upload);
+
+    /// StructuredBuffer<InstanceData> の先頭（未作成なら 0）
+    D3D12_GPU_VIRTUAL_ADDRESS GpuAddress() const { return m_buffer ? m_buffer->GetGPUVirtualAddress() : 0; }
+
+    const GpuSceneBufferStats& Stats() const { return m_stats; }
+
+private:
+    bool Grow(std::uint32_t required, UploadRing& upload);
+
+    ID3D12Device*                          m_device = nullptr;
+    Microsoft::WRL::ComPtr<ID3D12Resource> m_buffer;   ///< DEFAULT ヒープ
+    D3D12_RESOURCE_STATES                  m_state = D3D12_RESOURCE_STATE_COMMON;
+    std::uint32_t                          m_capacity = 0;
+
+    ObjectSlotAllocator       m_slots;
+    DirtySlotRanges           m_dirty;
+    std::vector<InstanceData> m_shadow;  ///< 全スロットの CPU 側の写し
+    std::vector<SlotRange>    m_ranges;  ///< Flush の作業用
+    GpuSceneBufferStats       m_stats;
+};
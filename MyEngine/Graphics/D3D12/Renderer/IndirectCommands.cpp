@@ -0,0 +1,41 @@
+﻿#include "Renderer/IndirectCommands.h"
+
+/*
+    IndirectCommands.cpp
+    ----------------------------------------------------------------------------
+    CreateIndirectDrawSignature：
+      - 引数の順は IndirectDrawCommand のメンバ順（VBV ×ストリーム数 → IBV → 定数 → DrawIndexed）。
+      - ルート引数（定数）を変えるシグネチャはルートシグネチャの指定が必須。
+      - ByteStride = sizeof(IndirectDrawCommand)。
+*/
+
+bool CreateIndirectDrawSignature(ID3D12Device* dev, ID3D12RootSignature* root, UINT drawBaseRootParam,
+    Microsoft::WRL::ComPtr<ID3D12CommandSignature>& out)
+{
+    out.Reset();
+    if (!dev || !root) return false;
+
+    D3D12_INDIRECT_ARGUMENT_DESC args[kIndirectVertexStreams + 3]{};
+    UINT n = 0;
+    for (UINT s = 0; s < kIndirectVertexStreams; ++s)
+    {
+        args[n].Type = D3D12_INDIRECT_ARGUMENT_TYPE_VERTEX_BUFFER_VIEW;
+        args[n].VertexBuffer.Slot = s;
+        ++n;
+    }
+    args[n++].Type = D3D12_INDIRECT_ARGUMENT_TYPE_INDEX_BUFFER_VIEW;
+    args[n].Type = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT;
+    args[n].Constant.RootParameterIndex = drawBaseRootParam;
+    args[n].Constant.DestOffsetIn32BitValues = 0;
+    args[n].Constant.Num32BitValuesToSet = 1;
+    ++n;
+    args[n++].Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+
+    D3D12_COMMAND_SIGNATURE_DESC desc{};
+    desc.ByteStride = sizeof(IndirectDrawCommand);
+    desc.NumArgumentDescs = n;
+    desc.pArgumentDescs = args;
+    desc.NodeMask = 0;
+
+    return SUCCEEDED(dev->CreateCommandSignature(&desc, root, IID_PPV_ARGS(&out)));
+}
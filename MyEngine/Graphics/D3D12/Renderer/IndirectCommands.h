@@ -0,0 +1,114 @@
+﻿#pragma once
+#include <wrl/client.h>
+#include <d3d12.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Renderer/DrawList.h"
+#include "Renderer/InstanceBatcher.h"
+
+/*
+    IndirectCommands.h
+    ----------------------------------------------------------------------------
+    目的：
+      - インスタンス区間（InstanceBatch）ごとの
+          「ルート定数（スロット表の先頭）+ VBV + IBV + DrawIndexedInstanced の引数」
+        を 1 レコードにまとめた間接引数バッファを作り、ExecuteIndirect 1 回で区間をまとめて描く。
+        IASet* / SetGraphicsRoot32BitConstant / Draw を区間数だけ積む CPU コストを無くす。
+      - WriteIndirectCommands はメモリに書くだけの純 CPU コード（GPU 無しで確認できる）。
+
+    レコードの並び（コマンドシグネチャの引数順と一致させる。72B）：
+        [ 0] D3D12_VERTEX_BUFFER_VIEW       …… スロット 0（位置ストリーム）
+        [16] D3D12_VERTEX_BUFFER_VIEW       …… スロット 1（法線/色ストリーム）
+        [32] D3D12_INDEX_BUFFER_VIEW
+        [48] uint32 drawBase                …… ルート定数（InstanceBatch::first）
+        [52] D3D12_DRAW_INDEXED_ARGUMENTS   …… 必ず最後
+      8B の GPU アドレスを先頭に寄せてあるので、C の構造体レイアウトと
+      間接引数の詰め方（4B 単位）のどちらで見ても同じオフセットになる。
+
+    PSO ごとの分割：
+      - 区間は DrawList の並び（pipeline 桁が最上位）のままなので、同じ pipeline は連続する。
+        pipeline が変わるところで IndirectRun を切り、Run ごとに PSO をセットして ExecuteIndirect する。
+
+    使い方（SceneRenderer::Record）：
+      WriteIndirectCommands(packets, batches, n, getMesh, argsCPU, runs);
+      for (run) { (PSO) ; cmd->ExecuteIndirect(sig, run.count, argsRes, argsOffset + run.first * sizeof(cmd), nullptr, 0); }
+*/
+
+/// レコードに含める頂点ストリーム（VB スロット 0..N-1）の数
+inline constexpr UINT kIndirectVertexStreams = 2;
+
+/// 間接引数 1 レコード（コマンドシグネチャ CreateIndirectDrawSignature と対）
+struct IndirectDrawCommand
+{
+    D3D12_VERTEX_BUFFER_VIEW     vbv[kIndirectVertexStreams];
+    D3D12_INDEX_BUFFER_VIEW      ibv;
+    std::uint32_t                drawBase;
+    D3D12_DRAW_INDEXED_ARGUMENTS draw;
+};
+static_assert(sizeof(IndirectDrawCommand) == 72, "IndirectDrawCommand must match the command signature stride");
+
+/// 同じ pipeline のレコードが続く範囲（ExecuteIndirect 1 回分）
+struct IndirectRun
+{
+    std::uint32_t pipeline = 0; ///< DrawList キーの pipeline 桁
+    std::uint32_t first = 0;    ///< 先頭レコード
+    std::uint32_t count = 0;    ///< レコード数
+};
+
+/// WriteIndirectCommands に渡すメッシュ情報
+struct IndirectMesh
+{
+    D3D12_VERTEX_BUFFER_VIEW vbv[kIndirectVertexStreams]{}; ///< 添字 = VB スロット
+    D3D12_INDEX_BUFFER_VIEW  ibv{};
+    std::uint32_t            indexCount = 0;
+    std::uint32_t            startIndex = 0; ///< 共有 IB 上の先頭（GeometryPool の区間）
+    std::int32_t             baseVertex = 0; ///< 共有 VB 上の先頭
+};
+
+/**
+ * @brief 区間ごとに間接引数レコードを書き、pipeline ごとの Run に分ける
+ * @param packets  区間を作ったときの描画リスト（pipeline 桁を読む）
+ * @param batches  BuildInstanceBatches の結果
+ * @param n        区間数（out は n レコード分の領域が必要）
+ * @param getMesh  IndirectMesh(const RenderItem&, std::uint32_t lod)：区間の代表と LOD からメッシュを取る
+ * @param out      書き込み先（アップロード領域など）
+ * @param runs     結果（上書き）
+ * @return         書いたレコード数（= n）
+ */
+template <class GetMesh>
+std::size_t WriteIndirectCommands(const DrawPacket* packets, const InstanceBatch* batches, std::size_t n,
+    GetMesh&& getMesh, IndirectDrawCommand* out, std::vector<IndirectRun>& runs)
+{
+    runs.clear();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const InstanceBatch& b = batches[i];
+        const IndirectMesh mesh = getMesh(*b.item, b.lod);
+
+        IndirectDrawCommand& c = out[i];
+        for (UINT s = 0; s < kIndirectVertexStreams; ++s) c.vbv[s] = mesh.vbv[s];
+        c.ibv = mesh.ibv;
+        c.drawBase = b.first;
+        c.draw.IndexCountPerInstance = mesh.indexCount;
+        c.draw.InstanceCount = b.count;
+        c.draw.StartIndexLocation = mesh.startIndex;
+        c.draw.BaseVertexLocation = mesh.baseVertex;
+        c.draw.StartInstanceLocation = 0; // SV_InstanceID に含まれないので常に 0（先頭は drawBase で渡す）
+
+        const std::uint32_t pipeline = static_cast<std::uint32_t>(packets[b.first].key >> 56);
+        if (runs.empty() || runs.back().pipeline != pipeline)
+            runs.push_back({ pipeline, static_cast<std::uint32_t>(i), 0 });
+        ++runs.back().count;
+    }
+    return n;
+}
+
+/**
+ * @brief IndirectDrawCommand に対応するコマンドシグネチャを作る
+ * @param root                 ルート定数を含むルートシグネチャ
+ * @param drawBaseRootParam    drawBase を書くルートパラメータ番号（32bit 定数 1 個）
+ * @return 失敗なら false（out は空のまま）
+ */
+bool CreateIndirectDrawSignature(ID3D12Device* dev, ID3D12RootSignature* root, UINT drawBaseRootParam,
+    Microsoft::WRL::ComPtr<ID3D12CommandSignature>& out);
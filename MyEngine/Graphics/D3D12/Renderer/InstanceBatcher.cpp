@@ -0,0 +1,37 @@
+﻿#include "Renderer/InstanceBatcher.h"
+#include <cmath>
+
+using namespace DirectX;
+
+/*
+    PackInstance
+    ----------------------------------------------------------------------------
+      - world  ：4x4 のアフィン部分を 3x4（転置形式）に詰め直すだけ。
+      - normal ：World の 3x3 の逆転置 = 余因子行列 / det。
+                 4x4 の逆行列を作らずに 3x3 の余因子 9 個と det だけで求める。
+      - 縮退した行列（スケール 0 等）は det が極小/非有限になるので単位行列に逃がす。
+*/
+void PackInstance(const XMFLOAT4X4& m, InstanceData& out)
+{
+    // 行 i = ワールド座標の i 成分の係数（x' = px*_11 + py*_21 + pz*_31 + _41）
+    out.world = XMFLOAT3X4(
+        m._11, m._21, m._31, m._41,
+        m._12, m._22, m._32, m._42,
+        m._13, m._23, m._33, m._43);
+
+    // 3x3 の余因子
+    const float c00 = m._22 * m._33 - m._23 * m._32;
+    const float c01 = m._23 * m._31 - m._21 * m._33;
+    const float c02 = m._21 * m._32 - m._22 * m._31;
+    const float det = m._11 * c00 + m._12 * c01 + m._13 * c02;
+    if (!std::isfinite(det) || std::fabs(det) < 1e-8f)
+    {
+        out.normal = XMFLOAT3X3(1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+        return;
+    }
+    const float inv = 1.0f / det;
+    out.normal = XMFLOAT3X3(
+        c00 * inv, c01 * inv, c02 * inv,
+        (m._13 * m._32 - m._12 * m._33) * inv, (m._11 * m._33 - m._13 * m._31) * inv, (m._12 * m._31 - m._11 * m._32) * inv,
+        (m._12 * m._23 - m._13 * m._22) * inv, (m._13 * m._21 - m._11 * m._23) * inv, (m._11 * m._22 - m._12 * m._21) * inv);
+}
@@ -0,0 +1,86 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+#include "Graphics/SceneConstantBuffer.h"
+#include "Renderer/DrawList.h"
+
+/*
+    InstanceBatcher.h
+    ----------------------------------------------------------------------------
+    目的：
+      - ソート済みの DrawList を「同じメッシュ・同じ LOD・同じ PSO が連続する区間」に切り分け、
+        区間ごとに 1 回の DrawIndexedInstanced で描けるようにする（自動インスタンシング）。
+      - インスタンスごとのワールド行列は InstanceData（GpuSceneBuffer に常駐）。
+        VS は区間の先頭 + SV_InstanceID でスロット表を引き、そこから自分の行列を引く。
+      - GPU には依存しない純 CPU コード（メッシュの同一判定は呼び出し側が渡す）。
+
+    使い方（SceneRenderer::Record）：
+      n = BuildInstanceBatches(list.begin(), list.Size(), maxInstances, sameMesh, batches);
+      for (i < n) slots[i] = list.begin()[i].item->slot;   // PackInstance は Prepare で済んでいる
+      for (batch) { b1 = batch.first; DrawIndexedInstanced(..., batch.count, ...); }
+
+    注意：
+      - 区間は DrawList の並び順のまま作る。キーは PSO → メッシュ → 奥行きなので、
+        同じメッシュはソート後に必ず連続する（メッシュ識別子の衝突で別メッシュが
+        挟まっても、sameMesh で切るので描画結果は正しい。区間が分かれるだけ）。
+      - 区間内のインスタンスは手前から奥の順に並ぶ（Early-Z 向きの順序はそのまま残る）。
+*/
+
+/// 1 回の DrawIndexedInstanced に対応する区間
+struct InstanceBatch
+{
+    std::uint32_t     first = 0;      ///< 先頭インスタンス（DrawList 上の位置 = インスタンス配列上の位置）
+    std::uint32_t     count = 0;      ///< インスタンス数
+    const RenderItem* item = nullptr; ///< 代表（区間の先頭。メッシュのバインドに使う）
+    std::uint32_t     lod = 0;        ///< 区間の LOD（区間内は全部同じ）
+};
+
+/**
+ * @brief ワールド行列から InstanceData（world 3x4 / 法線行列 3x3）を作る
+ * @details 3x3 の行列式が極小/非有限のときは法線行列を単位行列にする。
+ */
+void PackInstance(const DirectX::XMFLOAT4X4& world, InstanceData& out);
+
+/**
+ * @brief ソート済みパケット列をインスタンシング区間に切る
+ * @param packets      ソート済みの描画リスト
+ * @param n            件数
+ * @param maxInstances 使ってよいインスタンス数の上限（超えた分は捨てる）
+ * @param sameMesh     bool(const RenderItem& a, const RenderItem& b)：同じ VB/IB/インデックス数/区間なら true
+ *                     （LOD はパケット側で比べるので、sameMesh は LOD0 の区間を比べればよい）
+ * @param batches      出力（clear してから追記）
+ * @return             区間に入れたインスタンス総数（= min(n, maxInstances)）
+ */
+template <class SameMesh>
+std::size_t BuildInstanceBatches(const DrawPacket* packets, std::size_t n, std::size_t maxInstances,
+    SameMesh&& sameMesh, std::vector<InstanceBatch>& batches)
+{
+    batches.clear();
+    if (n > maxInstances) n = maxInstances;
+
+    constexpr int kPipelineShift = 56; // DrawList::MakeKey の pipeline 桁
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const DrawPacket& p = packets[i];
+        if (!batches.empty())
+        {
+            InstanceBatch& last = batches.back();
+            const DrawPacket& head = packets[last.first];
+            if ((head.key >> kPipelineShift) == (p.key >> kPipelineShift) && head.lod == p.lod
+                && sameMesh(*head.item, *p.item))
+            {
+                ++last.count;
+                continue;
+            }
+        }
+        InstanceBatch b;
+        b.first = static_cast<std::uint32_t>(i);
+        b.count = 1;
+        b.item = p.item;
+        b.lod = p.lod;
+        batches.push_back(b);
+    }
+    return n;
+}
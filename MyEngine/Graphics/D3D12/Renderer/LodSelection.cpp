@@ -0,0 +1,20 @@
+﻿#include "Renderer/LodSelection.h"
+
+/*
+    LodSelection.cpp
+    ----------------------------------------------------------------------------
+    SelectLod：
+      - まず前回の段から細かい側へ（今の段が遊び込みでも収まらない間）、
+        次に粗い側へ（次の段が遊び込みでも収まる間）動かす。errors は段ごとに増える前提なので
+        どちらか一方にしか動かない。radiusPx が FLT_MAX（カメラが球の中）なら LOD0 に戻る。
+*/
+
+std::uint32_t SelectLod(const float* errors, std::uint32_t lodCount, float radiusPx, std::uint32_t prev,
+    const LodSelectSettings& settings)
+{
+    auto fits = [&](std::uint32_t k, float scale) { return errors[k] * radiusPx * scale <= settings.pixelError; };
+    std::uint32_t lod = prev < lodCount ? prev : 0;
+    while (lod > 0 && !fits(lod, 1.0f / (1.0f + settings.hysteresis))) --lod;
+    while (lod + 1 < lodCount && fits(lod + 1, 1.0f + settings.hysteresis)) ++lod;
+    return lod;
+}
@@ -0,0 +1,40 @@
+﻿#pragma once
+#include <cstdint>
+
+/*
+    LodSelection.h
+    ----------------------------------------------------------------------------
+    目的：
+      - 画面上の大きさから描く LOD の段を選ぶ（SceneRenderer::Record がオブジェクトごとに呼ぶ）。
+      - GPU には依存しない純 CPU コード（単体で動作確認できる）。
+      - 半径が段の境目の前後で揺れても段が行き来しないよう、前回の段を起点に遊びを持たせて選ぶ
+        （前回の段は呼び出し側がビューごとに覚える）。
+*/
+
+/**
+ * LOD 選択とコントリビューションカリングの設定（SceneRenderer::SetLodSettings）
+ *  - 画面上の大きさ = ワールド AABB の外接球を、このビューの射影（CameraComponent の FOV/正射影の高さ）で
+ *    投影した半径（ピクセル）。LOD k の画面上の誤差 = Lods[k].Error × その半径。
+ *  - 誤差が pixelError 以下に収まる最も粗い段を描く。段の境目で行き来しないよう、
+ *    粗くするのは誤差 × (1 + hysteresis) でも収まるとき、細かく戻すのは誤差 ÷ (1 + hysteresis) でも
+ *    収まらなくなったときだけ（前回の段はビューごとに覚えておく）。
+ */
+struct LodSelectSettings
+{
+    bool  enabled = true;              ///< false なら常に LOD0
+    float pixelError = 1.0f;           ///< 許す画面上の誤差（ピクセル）
+    float hysteresis = 0.25f;          ///< 切り替えの遊び（0 = なし）
+    bool  contributionCulling = false; ///< 投影した外接球の直径が minScreenSize 未満のものを描かない
+    float minScreenSize = 2.0f;        ///< コントリビューションカリングのしきい値（ピクセル）
+};
+
+/**
+ * @brief 前回の段 prev からヒステリシス付きで LOD を選ぶ
+ * @param errors   段ごとの誤差（errors[0] = LOD0。細かい順に増えていること）
+ * @param lodCount 有効な段数（1 以上）
+ * @param radiusPx 画面上の半径（ピクセル）
+ * @param prev     前回描いた段（lodCount 以上なら LOD0 から選ぶ）
+ * @return 描く段（0 ～ lodCount - 1）
+ */
+std::uint32_t SelectLod(const float* errors, std::uint32_t lodCount, float radiusPx, std::uint32_t prev,
+    const LodSelectSettings& settings);
@@ -0,0 +1,79 @@
+﻿#include "Renderer/ObjectSlots.h"
+#include <algorithm>
+#include <functional>
+
+/*
+    ObjectSlots.cpp
+    ----------------------------------------------------------------------------
+    ObjectSlotAllocator：
+      - 空きは std::greater の push_heap/pop_heap で min ヒープとして持つ。
+      - 末尾側が全部空いても HighWater は縮めない（GPU バッファは伸びるだけ）。
+    DirtySlotRanges::Build：
+      - 積んだ番号をソート → 重複除去 → 走査して区間を伸ばす。
+        Build は Mark の配列を並べ替えるだけなので、続けて Mark してもよい。
+*/
+
+std::uint32_t ObjectSlotAllocator::Allocate()
+{
+    if (!m_free.empty())
+    {
+        std::pop_heap(m_free.begin(), m_free.end(), std::greater<std::uint32_t>());
+        const std::uint32_t slot = m_free.back();
+        m_free.pop_back();
+        m_live[slot] = true;
+        return slot;
+    }
+    m_live.push_back(true);
+    return m_highWater++;
+}
+
+void ObjectSlotAllocator::Free(std::uint32_t slot)
+{
+    if (!IsLive(slot)) return;
+    m_live[slot] = false;
+    m_free.push_back(slot);
+    std::push_heap(m_free.begin(), m_free.end(), std::greater<std::uint32_t>());
+}
+
+void ObjectSlotAllocator::Clear()
+{
+    m_free.clear();
+    m_live.clear();
+    m_highWater = 0;
+}
+
+void DirtySlotRanges::MarkRange(std::uint32_t first, std::uint32_t count)
+{
+    m_slots.reserve(m_slots.size() + count);
+    for (std::uint32_t i = 0; i < count; ++i) m_slots.push_back(first + i);
+}
+
+std::size_t DirtySlotRanges::Build(std::uint32_t maxGap, std::vector<SlotRange>& out)
+{
+    out.clear();
+    if (m_slots.empty()) return 0;
+
+    std::sort(m_slots.begin(), m_slots.end());
+    m_slots.erase(std::unique(m_slots.begin(), m_slots.end()), m_slots.end());
+
+    std::size_t total = 0;
+    SlotRange cur{ m_slots[0], 1 };
+    for (std::size_t i = 1; i < m_slots.size(); ++i)
+    {
+        const std::uint32_t s = m_slots[i];
+        const std::uint32_t end = cur.first + cur.count; // 区間の次のスロット
+        if (s - end <= maxGap)
+        {
+            cur.count = s - cur.first + 1; // 隙間ごと取り込む
+        }
+        else
+        {
+            total += cur.count;
+            out.push_back(cur);
+            cur = { s, 1 };
+        }
+    }
+    total += cur.count;
+    out.push_back(cur);
+    return total;
+}
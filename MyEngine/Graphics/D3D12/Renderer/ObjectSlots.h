@@ -0,0 +1,79 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+    ObjectSlots.h
+    ----------------------------------------------------------------------------
+    目的：
+      - GPU 常駐のオブジェクトバッファ（GpuSceneBuffer）で使う「スロット番号」の管理と、
+        書き換えたスロットを少数のコピー区間にまとめる処理。
+      - GPU には依存しない純 CPU コード（単体で動作確認できる）。
+
+    ObjectSlotAllocator：
+      - オブジェクト 1 つに 1 スロット。解放したスロットは再利用する。
+      - 再利用は「小さい番号から」（min ヒープ）。生きているスロットが先頭側に詰まるので
+        バッファの伸長が抑えられ、書き換え区間もまとまりやすい。
+      - HighWater() = これまでに使った最大番号 + 1（バッファに必要な要素数）。
+
+    DirtySlotRanges：
+      - Mark(slot) で書き換えたスロットを積む（重複可）。
+      - Build(maxGap, out) で昇順・重複除去し、隙間が maxGap 以下の区間はつなげて返す。
+        隙間の分は変わっていないデータも送ることになるが、CopyBufferRegion の回数が減る。
+        （送る元は CPU 側の写し全体なので、隙間を含めても中身は正しい）
+*/
+
+/// 連続するスロットの区間 [first, first + count)
+struct SlotRange
+{
+    std::uint32_t first = 0;
+    std::uint32_t count = 0;
+};
+
+class ObjectSlotAllocator
+{
+public:
+    static constexpr std::uint32_t kInvalid = 0xFFFFFFFFu;
+
+    /// 空きスロットを 1 つ取る（解放済みの最小番号、無ければ末尾に足す）
+    std::uint32_t Allocate();
+
+    /// スロットを返す（kInvalid や二重解放は無視）
+    void Free(std::uint32_t slot);
+
+    /// すべて解放して番号を 0 から振り直す
+    void Clear();
+
+    std::uint32_t HighWater() const { return m_highWater; }                                  ///< 必要な要素数
+    std::uint32_t LiveCount() const { return m_highWater - static_cast<std::uint32_t>(m_free.size()); } ///< 使用中のスロット数
+    bool          IsLive(std::uint32_t slot) const { return slot < m_highWater && m_live[slot]; }
+
+private:
+    std::vector<std::uint32_t> m_free;     ///< 解放済みスロット（min ヒープ）
+    std::vector<bool>          m_live;     ///< スロットごとの使用中フラグ（二重解放の検出用）
+    std::uint32_t              m_highWater = 0;
+};
+
+class DirtySlotRanges
+{
+public:
+    void Mark(std::uint32_t slot) { m_slots.push_back(slot); }
+
+    /// [first, first + count) をまとめて書き換え扱いにする（バッファ伸長時など）
+    void MarkRange(std::uint32_t first, std::uint32_t count);
+
+    bool Empty() const { return m_slots.empty(); }
+    void Clear() { m_slots.clear(); }
+
+    /**
+     * @brief 書き換えたスロットを区間にまとめる（積んだ内容は消さない）
+     * @param maxGap この数以下の未変更スロットを挟む区間はつなげる（0 = 隣接のみ）
+     * @param out    結果（昇順・重ならない）。上書きする
+     * @return       区間に含まれるスロットの総数（送るデータ量）
+     */
+    std::size_t Build(std::uint32_t maxGap, std::vector<SlotRange>& out);
+
+private:
+    std::vector<std::uint32_t> m_slots;
+};
@@ -3,27 +3,27 @@
 /*
     Presenter
     ----------------------------------------------------------------------------
-    F
-      - Xbv`FC̃obNobt@u`\ɂ  NA/` 
-        Present \ɖ߂v܂ł̒^JvZB
-    gi1t[jF
-      1) Begin(cmd, targets)   // RT Ԃ֑J + RTVݒ + NA + VP/Scissor ݒ
-      2) ... obNobt@֕` ...
-      3) End(cmd, backBuffer)  // Present Ԃ֑Jځǐ FrameScheduler  Presentj
-    ӁF
-      - oÁu݂̐ԁvuɕKvȏԁvւ̑Jڂł邱ƂdvB
-      - ł̓obNobt@͑Ot[ Present ς݂Ɖ肵
-        PRESENT  RENDER_TARGET  PRESENT ̏őJڂĂB
-      - [xobt@g`sꍇ́ABegin O or 
-        DSV ̐ݒNAĂяoōsƁB
+    役割：
+      - スワップチェインのバックバッファを「描画可能にする → クリア/描画 →
+        Present 可能に戻す」までの定型処理をカプセル化。
+    使い方（1フレーム）：
+      1) Begin(cmd, targets)   // RT 状態へ遷移 + RTV設定 + クリア + VP/Scissor 設定
+      2) ... バックバッファへ描画 ...
+      3) End(cmd, backBuffer)  // Present 状態へ遷移（この後 FrameScheduler 側で Present）
+    注意：
+      - バリアは「現在の正しい状態」から「次に必要な状態」への遷移であることが重要。
+      - ここではバックバッファは前フレームで Present 済みと仮定して
+        PRESENT → RENDER_TARGET → PRESENT の順で遷移している。
+      - 深度バッファを使う描画を行う場合は、Begin 前後 or 直後に
+        DSV の設定やクリアを呼び出し側で行うこと。
 */
 
 void Presenter::Begin(ID3D12GraphicsCommandList* cmd, const PresentTargets& t)
 {
     // ==============================
-    // 1) ԑJ: PRESENT  RENDER_TARGET
-    //    Ot[ Present ɖ߂ĂobNobt@`\ɂB
-    //     ԂقȂ DRED/؃Cx̂ŁA^pŐۂƁB
+    // 1) 状態遷移: PRESENT → RENDER_TARGET
+    //    前フレームで Present に戻っているバックバッファを描画可能にする。
+    //    ※ 現状態が異なると DRED/検証レイヤが警告するので、運用で整合を保つこと。
     // ==============================
     auto toRT = CD3DX12_RESOURCE_BARRIER::Transition(
         t.backBuffer,
@@ -32,17 +32,17 @@ void Presenter::Begin(ID3D12GraphicsCommandList* cmd, const PresentTargets& t)
     cmd->ResourceBarrier(1, &toRT);
 
     // ==============================
-    // 2) OM  RTV ZbgāAobNobt@NA
-    //    - DSV KvȂĂяo OMSetRenderTargets 
-    //      RTV+DSV ōĐݒ肵Ă ClearDepthStencilView ĂԂƁB
+    // 2) OM に RTV をセットして、バックバッファをクリア
+    //    - DSV が必要なら呼び出し側で OMSetRenderTargets を
+    //      RTV+DSV で再設定してから ClearDepthStencilView を呼ぶこと。
     // ==============================
     cmd->OMSetRenderTargets(1, &t.rtv, FALSE, nullptr);
     cmd->ClearRenderTargetView(t.rtv, t.clearColor, 0, nullptr);
 
     // ==============================
-    // 3) RS: r[|[g/VU[tXN[ɐݒ
-    //    ImGui Ȃǂ`OɉʃTCY֍킹ĂB
-    //     t.width/height ̓Xbv`FČ݃TCYƈvĂKvB
+    // 3) RS: ビューポート/シザーをフルスクリーンに設定
+    //    ImGui などを描く前に画面サイズへ合わせておく。
+    //    ※ t.width/height はスワップチェインの現在サイズと一致している必要がある。
     // ==============================
     D3D12_VIEWPORT vp{
         0.f, 0.f,
@@ -62,8 +62,8 @@ void Presenter::Begin(ID3D12GraphicsCommandList* cmd, const PresentTargets& t)
 void Presenter::End(ID3D12GraphicsCommandList* cmd, ID3D12Resource* backBuffer)
 {
     // ==============================
-    // ԑJ: RENDER_TARGET  PRESENT
-    // ̌AL[ɃTu~bgXbv`FC PresentiÕt[Ŏ{jB
+    // 状態遷移: RENDER_TARGET → PRESENT
+    // この後、キューにサブミット＆スワップチェイン Present（外側のフローで実施）。
     // ==============================
     auto toPresent = CD3DX12_RESOURCE_BARRIER::Transition(
         backBuffer,
@@ -73,12 +73,12 @@ void Presenter::End(ID3D12GraphicsCommandList* cmd, ID3D12Resource* backBuffer)
 }
 
 /*
-y悭闎Ƃz
-- Clear/`O RT Ԃ֑JڂĂȂF
-   PRESENT ̂܂ OMSet/Clear ƌ؃G[/`BBegin KʂB
-- r[|[g/VU[ÂTCŶ܂܁F
-   TCYɕ/ς邽߁At[ݒ肪Si{̒ʂjB
-- DSV ĝɐݒ肵ĂȂF
-   [xeXgKvȕ`ꍇABegin  RTV+DSV  OM ֐ݒ肵A
-     ClearDepthStencilView sƁi{NX RTV ݈̂zjB
+【よくある落とし穴】
+- Clear/描画前に RT 状態へ遷移していない：
+  → PRESENT のまま OMSet/Clear すると検証エラー/未定義動作。Begin を必ず通す。
+- ビューポート/シザーが古いサイズのまま：
+  → リサイズ後に幅/高さが変わるため、毎フレーム設定が安全（本実装の通り）。
+- DSV を使うのに設定していない：
+  → 深度テストが必要な描画をする場合、Begin 直後に RTV+DSV を OM へ設定し直し、
+     ClearDepthStencilView も行うこと（本クラスは RTV のみ扱う想定）。
 */
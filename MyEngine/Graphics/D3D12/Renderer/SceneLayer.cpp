@@ -4,110 +4,142 @@
 /*
     SceneLayer
     ----------------------------------------------------------------------------
-    F
-      - uV[`̍xvFʂ ViewportsiRT/TCYǗj
-        SceneRendereri`R}hj̋nsB
-      - UIiImGuij֋ SRV ̑SB
-
-    Ăяof̖ڈi1t[jF
-      1) BeginFrame()              ... UIÑTCYmKpiRTĐ΋RTԂj
-      2) Record(args, maxObjects)  ... SceneGame ̏ŃItXN[`L^
-      3) FeedToUI(ctx, imgui, ...) ... ImGui ֕`挋ʂ SRV 
-      4) iĂяo Presenter.Begin  ImGui  Presenter.Endj
-      5) BeginFrame ŕԂRT FrameScheduler.EndFrame(sig) Œxjo^
-
-    ӓ_F
-      - TCY/qXeVX/ Viewports ɏWiӖj
-      - Scene  Game ͓𑜓xœĂOi Scene ɓj
-      - UI ֓n SRV Xbg͊OiRendererjt[CfbNXŃj[NɊ
+    役割：
+      - 「シーン描画の高レベル調整役」：下位の Viewports（RT/サイズ管理）と
+        SceneRenderer（実描画コマンド生成）の橋渡しを行う。
+      - UI（ImGui）側へ供給する SRV の窓口も担う。
+
+    呼び出しモデルの目安（1フレーム）：
+      1) BeginFrame()              ... UI起因のリサイズ確定を適用（RT再生成があれば旧RTを返す）
+      2) Record(args)              ... Prepare → UploadObjects → Scene/Game を別スレッド・別リストで同時に記録
+                                       （並列記録で記録先が変わるので、呼び出し後は FrameScheduler::GetCmd() を取り直す）
+      3) FeedToUI(ctx, imgui, ...) ... ImGui へ描画結果の SRV を供給
+      4) （呼び出し側で Presenter.Begin → ImGui → Presenter.End）
+      5) BeginFrame で返った旧RTは FrameScheduler.EndFrame(sig) 側で遅延破棄登録
+
+    注意点：
+      - リサイズ判定/ヒステリシス/偶数化は Viewports 側に集約（責務分離）
+      - Scene と Game は同解像度で同期している前提（初回は Scene に同期）
+      - UI へ渡す SRV スロットは外側（Renderer）がフレームインデックスでユニークに割当て
 */
 
 void SceneLayer::Initialize(ID3D12Device* dev, DXGI_FORMAT /*rtvFmt*/, DXGI_FORMAT /*dsvFmt*/,
     FrameResources* frames, const PipelineSet& pipe,
     unsigned initW, unsigned initH)
 {
-    // SceneRenderer ipCvC/t[UPL Ȃǂ̊֘Atj
+    // SceneRenderer を結線（パイプライン/フレームUPL などの関連付け）
     m_sceneRenderer.Initialize(dev, pipe, frames);
 
-    // ViewportsiRT/TCYǗjFEBhETCYō쐬邱Ƃ
-    // ̊g厞ɂڂ₯ȂiTCYgɂꎞIȏk`j
+    // Viewports（RT/サイズ管理）初期化：ウィンドウ初期サイズで作成することで
+    // 初回の拡大時にぼやけない（小サイズ→拡大による一時的な縮小描画回避）
     m_viewports.Initialize(dev, initW, initH);
 }
 
 RenderTargetHandles SceneLayer::BeginFrame(ID3D12Device* dev)
 {
-    // UI őOt[Ɉ艻]TCY΁A RT 蒼B
-    // RT ́uDetach nhiComPtrjvŕԂ̂ŁAĂяo
-    // GpuGarbageQueue Ɂit fence lŁjo^Ēxj邱ƁB
+    // UI 側で前フレーム中に安定化した希望サイズがあれば、ここで RT を作り直す。
+    // 旧RT は「Detach したハンドル（ComPtr束）」で返すので、呼び出し側で
+    // GpuGarbageQueue に（今フレの fence 値で）登録して遅延破棄すること。
     return m_viewports.ApplyPendingResizeIfNeeded(dev);
 }
 
-void SceneLayer::Record(const SceneLayerBeginArgs& a, unsigned maxObjects)
+void SceneLayer::Record(const SceneLayerBeginArgs& a)
 {
-    // hFKvp[^Ă牽ȂiSj
+    // 防御：必要パラメータが欠けていたら何もしない（安全側）
     if (!a.camera || !a.scene || !a.cmd) return;
 
-    // 1) Scene ֕`
-    //    - HFOViFOVjɁAAXyNgωɒǏ]铊e Viewports Œ
-    //    - View/Proj ̑I CB ݒ SceneRenderer.Record Ŏs
-    m_viewports.RenderScene(a.cmd, m_sceneRenderer, a.camera, a.scene, a.frameIndex, maxObjects);
+    // 0) 描画候補の抽出（Scene/Game 共通。Static BVH の再構築もここで判定）
+    m_sceneRenderer.Prepare(a.scene);
 
-    // 2) Game ֕`
-    //    -  Scene ƓŒJiView/ProjjŐÓI\
-    //    - Scene ̓e/AXyNgɍ킹 Game i񓯊j
-    m_viewports.RenderGame(a.cmd, m_sceneRenderer, a.scene, a.frameIndex, maxObjects);
+    // 0') 動いたオブジェクトの InstanceData だけを常駐バッファへコピー（両ビューの描画より前）
+    m_sceneRenderer.UploadObjects(a.cmd);
+
+    // 1) Scene/Game のパスを組み立てる（カメラ行列の確定だけ。メインスレッド）
+    //    - Scene：HFOV（横FOV）を基準に、アスペクト変化に追従する投影を Viewports 側で調整
+    //    - Game ：初回は Scene と同期した固定カメラ（View/Proj）で静的表示
+    SceneViewPass passes[Viewports::kMaxPasses];
+    const std::size_t count = m_viewports.BuildPasses(a.camera, passes);
+
+    // 2) 両ビューを別々のコマンドリストへ同時に記録（CB 設定等は SceneRenderer.Record 内で実行）
+    m_sceneRenderer.RecordViews(a.cmd, passes, count);
 }
 
 void SceneLayer::FeedToUI(EditorContext& ctx, ImGuiLayer* imgui,
     unsigned frameIndex, unsigned sceneSrvBase, unsigned gameSrvBase)
 {
-    // ImGui ֕`挋ʁiRT  Colorj SRV B
-    // - DX12  ImTextureID ́uGPU  SRV fBXNv^nhiUINT64jv݊
-    // - tHg slot=0 gOȂ̂ŁAsceneSrvBase/gameSrvBase  1 ȏ
-    //   et[iframeIndexjɉj[NȃXbg邱ƁB
+    // ImGui へ描画結果（RT の Color）の SRV を供給。
+    // - DX12 の ImTextureID は「GPU 可視 SRV ディスクリプタハンドル（UINT64）」互換
+    // - フォントは slot=0 を使う前提なので、sceneSrvBase/gameSrvBase は 1 以上で
+    //   各フレーム（frameIndex）に応じたユニークなスロット割当をすること。
     m_viewports.FeedToUI(ctx, imgui, frameIndex, sceneSrvBase, gameSrvBase);
 }
 
 void SceneLayer::RequestResize(unsigned wantW, unsigned wantH, float dt)
 {
-    // ImGui ő gScene EBhE̗p\TCYh  Viewports ֓`B
-    // Viewports ŁF
-    //   - XebvXibv/
-    //   - 莞Ԃ̈iqXeVXj
-    //   - pending ւ̊m
-    // ܂Ƃ߂Ėʓ|Bł͂nB
+    // ImGui 側で測った “Scene ウィンドウ内の利用可能サイズ” を Viewports へ伝える。
+    // Viewports 側で：
+    //   - ステップスナップ/偶数化
+    //   - 一定時間の安定（ヒステリシス）
+    //   - pending への確定
+    // をまとめて面倒を見る。ここではただ渡すだけ。
     m_viewports.RequestSceneResize(wantW, wantH, dt);
 }
 
-// ǉFUI  Stats \Ȃǁui^RTTCYjv̓ɎgB
+// 追加実装：UI 側の Stats 表示など「元情報（真のRTサイズ）」の同期に使う。
 void SceneLayer::SyncStatsTo(EditorContext& ctx) const
 {
-    // ^̃\[XFViewports ێ錻݂ RT TCY
+    // 真のソース：Viewports が保持する現在の RT 実サイズ
     ctx.sceneRTWidth = m_viewports.SceneWidth();
     ctx.sceneRTHeight = m_viewports.SceneHeight();
     ctx.gameRTWidth = m_viewports.GameWidth();
     ctx.gameRTHeight = m_viewports.GameHeight();
 
-    //  EditorContext::rtWidth/rtHeight uScene RT ̃~[vƂĈȂ
-    // LLi̓Xbv`FCTCY\prȂ̂ŃRgAEgj
+    // 視錐台カリングの統計（直近の Record 結果）
+    ctx.sceneVisible = m_viewports.SceneStats().visible;
+    ctx.sceneCulled = m_viewports.SceneStats().culled;
+    ctx.gameVisible = m_viewports.GameStats().visible;
+    ctx.gameCulled = m_viewports.GameStats().culled;
+    ctx.sceneTested = m_viewports.SceneStats().tested;
+    ctx.gameTested = m_viewports.GameStats().tested;
+    ctx.sceneOccluded = m_viewports.SceneStats().occluded;
+    ctx.gameOccluded = m_viewports.GameStats().occluded;
+    ctx.sceneMeshBinds = m_viewports.SceneStats().meshBinds;
+    ctx.gameMeshBinds = m_viewports.GameStats().meshBinds;
+    ctx.sceneDrawCalls = m_viewports.SceneStats().drawCalls;
+    ctx.gameDrawCalls = m_viewports.GameStats().drawCalls;
+    ctx.sceneIndirectCalls = m_viewports.SceneStats().indirectCalls;
+    ctx.gameIndirectCalls = m_viewports.GameStats().indirectCalls;
+    ctx.sceneTriangles = m_viewports.SceneStats().triangles;
+    ctx.gameTriangles = m_viewports.GameStats().triangles;
+    ctx.sceneLodReduced = m_viewports.SceneStats().lodReduced;
+    ctx.gameLodReduced = m_viewports.GameStats().lodReduced;
+    ctx.sceneMeshletsTested = m_viewports.SceneStats().meshletsTested;
+    ctx.gameMeshletsTested = m_viewports.GameStats().meshletsTested;
+    ctx.sceneMeshletsCulled = m_viewports.SceneStats().meshletsCulled;
+    ctx.gameMeshletsCulled = m_viewports.GameStats().meshletsCulled;
+    ctx.sceneTinyCulled = m_viewports.SceneStats().contributionCulled;
+    ctx.gameTinyCulled = m_viewports.GameStats().contributionCulled;
+
+    // もし EditorContext::rtWidth/rtHeight を「Scene RT のミラー」として扱いたいなら
+    // 下記を有効化（現状はスワップチェインサイズ表示用途なのでコメントアウト）
     // ctx.rtWidth  = ctx.sceneRTWidth;
     // ctx.rtHeight = ctx.sceneRTHeight;
 }
 
 void SceneLayer::Shutdown()
 {
-    // SF̏ RT uDetachvĎQƂĂ
-    // ił͕ԋp悪Ȃߑjɂ͂ȂȂBVbg_E
-    //  GPU ҂xjL[S flush ς܂ĂƁj
+    // 安全側：この場で RT を「Detach」して参照を解放しておく
+    // （ここでは返却先がないため即時破棄にはならない。シャットダウン順で
+    //  GPU 完了待ち→遅延破棄キュー全 flush を済ませておくこと）
     (void)m_viewports.SceneRT().Detach();
     (void)m_viewports.GameRT().Detach();
 
-    // SceneRenderer ̌؂inullptr Ŗj
+    // SceneRenderer の結線を切る（nullptr で無効化）
     m_sceneRenderer.Initialize(nullptr, PipelineSet{}, nullptr);
 }
 
 RenderTargetHandles SceneLayer::TakeCarryOverDead() {
-    // Viewports ێĂuz[i2ڈȍ~̋RTjvB
-    // ĂяoiRendererjŁut[Ŏ̂ĂgvȂ炱gB
+    // Viewports 側が保持している「持ち越し死骸（2個目以降の旧RT）」を回収。
+    // 呼び出し側（Renderer）で「今フレームで捨てる枠」が空ならこれを使う。
     return m_viewports.TakeCarryOverDead();
 }
@@ -1,160 +1,1074 @@
 #include "Renderer/SceneRenderer.h"
+#include "Culling/Frustum.h"
+#include "Renderer/InstanceBatcher.h"
+#include "Core/Time.h"
+#include "Core/JobSystem.h"
+#include "Upload/IndexFormat.h"
 #include <algorithm>
+#include <cfloat>
 #include <cmath>
-#include <functional>
+#include <cstring>
 
 using Microsoft::WRL::ComPtr;
+using namespace DirectX;
+
+namespace
+{
+    // VB/IB があり、COPY キューでの転送も終わっている（転送中のメッシュは描かない）
+    bool IsDrawable(const MeshRendererComponent& mr)
+    {
+        return mr.VertexBuffers[MeshRendererComponent::kPositionStream] && mr.IndexBuffer && mr.IndexCount > 0 && mr.GpuReady;
+    }
+}
+
+void SceneRenderer::Initialize(ID3D12Device* dev, const PipelineSet& pipe, FrameResources* frames)
+{
+    m_pipe = pipe;
+    m_frames = frames;
+
+    // スロットはバッファと一緒に振り直すので、抽出結果も捨てて次の Prepare で作り直させる
+    m_static.clear();
+    m_staticBvh.Clear();
+    m_staticKeys.clear();
+    m_staticDirty = true;
+    m_dynamicTree.Clear();
+    m_dynamicProxies.clear();
+    ++m_visibilityEpoch;
+    if (dev) m_objects.Initialize(dev);
+    else     m_objects.Destroy();
+
+    // 間接描画のシグネチャ（drawBase はルートパラメータ [1] の 32bit 定数）。作れなければ直接記録のみ
+    CreateIndirectDrawSignature(dev, m_pipe.root.Get(), /*drawBaseRootParam=*/1, m_drawSignature);
+}
+
+void SceneRenderer::ReleaseSlot(RenderItem& item)
+{
+    m_objects.FreeSlot(item.slot);
+    item.slot = ObjectSlotAllocator::kInvalid;
+}
+
+void SceneRenderer::SetStaticBatches(std::vector<std::shared_ptr<MeshRendererComponent>> batches)
+{
+    // m_static はチャンクを生ポインタで指しているので、差し替える前に候補ごと捨てる
+    for (RenderItem& item : m_static) ReleaseSlot(item);
+    m_static.clear();
+    m_staticBvh.Clear();
+    m_staticKeys.clear();
+    m_staticDirty = true;
+    ++m_visibilityEpoch; // Static の ID が無効になるので各ビューのキャッシュも捨てさせる
+    m_staticBatches = std::move(batches);
+}
+
+void SceneRenderer::UploadObjects(ID3D12GraphicsCommandList* cmd)
+{
+    if (!m_frames) return;
+    m_objects.Flush(cmd, m_frames->Upload());
+}
+
+/*
+    SceneRenderer::Prepare
+    ----------------------------------------------------------------------------
+    役割：
+      - Scene を 1 回だけ走査し、描画候補を Static / Dynamic に振り分ける。
+      - Dynamic は Transform/境界のバージョンが変わったものだけ ワールド行列とワールド AABB を
+        計算し直し、AABB ツリーのプロキシを更新する。変わっていなければ前回の値を使い回す。
+        ツリーの組み替えはファット AABB をはみ出したときだけ（MoveProxy 内で判定）。
+      - Static は「コンポーネント集合 + Transform/境界のバージョン」が前回と同じなら BVH をそのまま使う。
+        違っていれば全 Static のワールド AABB を取り直して BVH を再構築する。
+      - 作成/移動/削除したプロキシを m_dynamicChanged / m_dynamicRemoved に残す
+        （Record がビューごとの可視性キャッシュを差分更新するのに使う）。
+      - Static でも IsStaticBatched() のものは描画候補にしない（静的バッチのチャンクが代わりに描く）。
+        チャンク（m_staticBatches）は Static の再構築時に単位行列で BVH へ加える。
+      - 描画候補ごとに GpuSceneBuffer のスロットを持たせる（Dynamic はプロキシと同じ寿命、
+        Static は BVH の再構築ごとに取り直す）。ワールド行列を計算し直したときだけ
+        InstanceData を Write する（動かないものは GPU へ何も送らない）。
+      - IsOccluder() の MeshRenderer は Static/Dynamic とは別に m_occluders にも集める。
+        集合・Transform・境界のどれかが前回と違えば m_occluderEpoch を進める
+        （各ビューのオクルージョン深度バッファを塗り直させる）。
+
+    注意：
+      - RenderItem::mr は生ポインタ。Prepare → Record の同一フレーム内でのみ有効。
+*/
+void SceneRenderer::Prepare(const Scene* scene)
+{
+    m_dynamic.clear();
+    m_dynamicUnbounded.clear();
+    m_dynamicChanged.clear();
+    m_dynamicRemoved.clear();
+    m_staticScan.clear();
+    m_occluders.clear();
+    m_occluderScan.clear();
+    ++m_prepareFrame;
+    if (!scene)
+    {
+        if (!m_occluderKeys.empty()) ++m_occluderEpoch;
+        m_occluderKeys.clear();
+        for (RenderItem& item : m_static) ReleaseSlot(item);
+        for (auto& kv : m_dynamicProxies) m_objects.FreeSlot(kv.second.slot);
+        m_static.clear();
+        m_staticBvh.Clear();
+        m_staticKeys.clear();
+        m_dynamicTree.Clear();
+        m_dynamicProxies.clear();
+        ++m_visibilityEpoch; // プロキシ ID がすべて無効になるのでキャッシュも捨てさせる
+        return;
+    }
+
+    // Dynamic 1 件の描画候補を作る（初見ならプロキシ作成、動いていれば移動）
+    auto prepareDynamic = [&](const std::shared_ptr<MeshRendererComponent>& mr, const GameObject& go,
+        std::uint32_t index) -> RenderItem
+        {
+            DynamicProxy& p = m_dynamicProxies[mr.get()];
+            if (p.mr.expired())
+            {
+                // 初見、または破棄された別コンポーネントと同じアドレス → 作り直す
+                if (p.proxy != DynamicAabbTree::kNull)
+                {
+                    m_dynamicTree.DestroyProxy(p.proxy);
+                    m_dynamicRemoved.push_back(p.proxy);
+                }
+                m_objects.FreeSlot(p.slot);
+                p = DynamicProxy();
+                p.mr = mr;
+                p.slot = m_objects.AllocateSlot();
+            }
+
+            const std::uint32_t tv = go.Transform->GetVersion();
+            const std::uint32_t bv = mr->GetBoundsVersion();
+            if (p.seenFrame == 0 || p.transformVersion != tv || p.boundsVersion != bv)
+            {
+                const XMMATRIX world = go.Transform->GetWorldMatrix();
+                XMStoreFloat4x4(&p.world, world);
+                p.worldBox = TransformAABB(mr->GetLocalBounds(), world);
+                p.transformVersion = tv;
+                p.boundsVersion = bv;
+
+                InstanceData inst;
+                PackInstance(p.world, inst);
+                m_objects.Write(p.slot, inst);
+
+                const AABB& box = p.worldBox;
+                if (box.IsValid())
+                {
+                    const XMFLOAT3 center{ (box.Min.x + box.Max.x) * 0.5f,
+                                           (box.Min.y + box.Max.y) * 0.5f,
+                                           (box.Min.z + box.Max.z) * 0.5f };
+                    if (p.proxy == DynamicAabbTree::kNull)
+                    {
+                        p.proxy = m_dynamicTree.CreateProxy(box, index);
+                    }
+                    else
+                    {
+                        const XMFLOAT3 d{ center.x - p.center.x, center.y - p.center.y, center.z - p.center.z };
+                        m_dynamicTree.MoveProxy(p.proxy, box, d);
+                    }
+                    p.center = center;
+                    m_dynamicChanged.push_back(p.proxy);
+                }
+                else if (p.proxy != DynamicAabbTree::kNull)
+                {
+                    // 空メッシュになった：ツリーから外す
+                    m_dynamicTree.DestroyProxy(p.proxy);
+                    m_dynamicRemoved.push_back(p.proxy);
+                    p.proxy = DynamicAabbTree::kNull;
+                }
+            }
+
+            // m_dynamic の添字は毎フレーム変わりうるので userData は常に更新
+            if (p.proxy != DynamicAabbTree::kNull) m_dynamicTree.SetUserData(p.proxy, index);
+            else                                   m_dynamicUnbounded.push_back(index); // 無効 AABB：常に描く
+            p.seenFrame = m_prepareFrame;
+
+            RenderItem item;
+            item.mr = mr.get();
+            item.world = p.world;
+            item.worldBox = p.worldBox;
+            item.proxy = p.proxy;
+            item.slot = p.slot;
+            return item;
+        };
+
+    // Static は一旦 shared_ptr で集めておき、再構築が必要なときだけ行列/AABB を計算する
+    std::vector<std::pair<std::shared_ptr<MeshRendererComponent>, GameObject*>> statics;
+
+    // 階層は明示スタックで前順に辿る（再帰 std::function の呼び出しコストと深い階層での溢れを避ける）
+    m_visitStack.clear();
+    const auto& roots = scene->GetRootGameObjects();
+    for (auto it = roots.rbegin(); it != roots.rend(); ++it) m_visitStack.push_back(it->get());
+
+    while (!m_visitStack.empty())
+    {
+        GameObject* go = m_visitStack.back();
+        m_visitStack.pop_back();
+        if (!go) continue;
+
+        auto mr = go->GetComponent<MeshRendererComponent>();
+        if (mr && IsDrawable(*mr))
+        {
+            if (mr->IsOccluder())
+            {
+                RenderItem occ;
+                occ.mr = mr.get();
+                XMStoreFloat4x4(&occ.world, go->Transform->GetWorldMatrix());
+                m_occluders.push_back(occ);
+                m_occluderScan.push_back({ mr.get(), go->Transform->GetVersion(), mr->GetBoundsVersion() });
+            }
+
+            if (go->IsStatic() && mr->IsStaticBatched())
+            {
+                // 静的バッチのチャンクとして描く（個別には描かない）
+            }
+            else if (go->IsStatic())
+            {
+                m_staticScan.push_back({ mr, go->Transform->GetVersion(), mr->GetBoundsVersion() });
+                statics.emplace_back(mr, go);
+            }
+            else
+            {
+                const std::uint32_t index = static_cast<std::uint32_t>(m_dynamic.size());
+                m_dynamic.push_back(prepareDynamic(mr, *go, index));
+            }
+        }
+
+        // 子は逆順に積む（先頭の子から処理される = 再帰版と同じ順序）
+        const auto& children = go->GetChildren();
+        for (auto it = children.rbegin(); it != children.rend(); ++it) m_visitStack.push_back(it->get());
+    }
+
+    // ---- 今フレーム現れなかった Dynamic（削除/Static 化/非表示）のプロキシを片付ける ----
+    for (auto it = m_dynamicProxies.begin(); it != m_dynamicProxies.end(); )
+    {
+        if (it->second.seenFrame == m_prepareFrame) { ++it; continue; }
+        if (it->second.proxy != DynamicAabbTree::kNull)
+        {
+            m_dynamicTree.DestroyProxy(it->second.proxy);
+            m_dynamicRemoved.push_back(it->second.proxy);
+        }
+        m_objects.FreeSlot(it->second.slot);
+        it = m_dynamicProxies.erase(it);
+    }
+
+    // ---- オクルーダ集合の変化判定（生ポインタ比較：別物と取り違えても塗り直しが 1 回漏れるだけ） ----
+    bool occludersChanged = (m_occluderScan.size() != m_occluderKeys.size());
+    for (std::size_t i = 0; !occludersChanged && i < m_occluderScan.size(); ++i)
+    {
+        const OccluderKey& a = m_occluderScan[i];
+        const OccluderKey& b = m_occluderKeys[i];
+        occludersChanged = a.mr != b.mr || a.transformVersion != b.transformVersion || a.boundsVersion != b.boundsVersion;
+    }
+    if (occludersChanged)
+    {
+        m_occluderKeys.swap(m_occluderScan);
+        ++m_occluderEpoch;
+    }
+
+    // ---- Static 集合の変化判定（weak_ptr の所有者比較で同一性を見る） ----
+    //      静的バッチのチャンクは転送が終わった数が変われば載せ直す
+    std::size_t readyBatches = 0;
+    for (const auto& chunk : m_staticBatches) if (chunk && IsDrawable(*chunk)) ++readyBatches;
+    bool changed = m_staticDirty || readyBatches != m_staticBatchesReady || (m_staticScan.size() != m_staticKeys.size());
+    for (std::size_t i = 0; !changed && i < m_staticScan.size(); ++i)
+    {
+        const StaticKey& a = m_staticScan[i];
+        const StaticKey& b = m_staticKeys[i];
+        const bool sameObject = !a.mr.owner_before(b.mr) && !b.mr.owner_before(a.mr);
+        changed = !sameObject || a.transformVersion != b.transformVersion || a.boundsVersion != b.boundsVersion;
+    }
+    if (!changed) return;
+
+    // ---- 再構築 ----
+    m_staticBatchesReady = readyBatches;
+    for (RenderItem& item : m_static) ReleaseSlot(item);
+    m_static.clear();
+    m_static.reserve(statics.size() + m_staticBatches.size());
+    std::vector<AABB> boxes;
+    boxes.reserve(statics.size() + m_staticBatches.size());
+    for (auto& s : statics)
+    {
+        RenderItem item;
+        item.mr = s.first.get();
+        const XMMATRIX world = s.second->Transform->GetWorldMatrix();
+        XMStoreFloat4x4(&item.world, world);
+        item.worldBox = TransformAABB(s.first->GetLocalBounds(), world);
+        boxes.push_back(item.worldBox);
+        m_static.push_back(item);
+    }
+    // 静的バッチのチャンク：頂点はワールド空間なので単位行列、ローカル境界 = ワールド AABB
+    for (const auto& chunk : m_staticBatches)
+    {
+        if (!chunk || !IsDrawable(*chunk)) continue;
+        RenderItem item;
+        item.mr = chunk.get();
+        XMStoreFloat4x4(&item.world, XMMatrixIdentity());
+        item.worldBox = chunk->GetLocalBounds();
+        boxes.push_back(item.worldBox);
+        m_static.push_back(item);
+    }
+    // スロットを取り直して全 Static の InstanceData を書く（解放直後なので同じ番号に戻りやすい）
+    for (RenderItem& item : m_static)
+    {
+        InstanceData inst;
+        PackInstance(item.world, inst);
+        item.slot = m_objects.AllocateSlot();
+        m_objects.Write(item.slot, inst);
+    }
+    m_staticBvh.Build(boxes);
+    m_staticKeys.swap(m_staticScan);
+    m_staticDirty = false;
+    ++m_visibilityEpoch; // Static の ID が振り直されたので、各ビューのキャッシュは全判定させる
+}
+
+bool SceneRenderer::RaycastStatic(const XMFLOAT3& origin, const XMFLOAT3& dir, float maxT,
+    const MeshRendererComponent*& outHit, float& outT) const
+{
+    std::uint32_t id = 0;
+    if (!m_staticBvh.Raycast(origin, dir, maxT, id, outT)) return false;
+    outHit = m_static[id].mr;
+    return true;
+}
+
+void SceneRenderer::QueryOverlap(const AABB& box, std::vector<const MeshRendererComponent*>& out) const
+{
+    auto overlaps = [&](const AABB& b)
+        {
+            return b.Min.x <= box.Max.x && b.Max.x >= box.Min.x
+                && b.Min.y <= box.Max.y && b.Max.y >= box.Min.y
+                && b.Min.z <= box.Max.z && b.Max.z >= box.Min.z;
+        };
+
+    std::vector<std::uint32_t> ids;
+    m_staticBvh.QueryOverlap(box, ids);
+    for (std::uint32_t id : ids) out.push_back(m_static[id].mr);
+
+    // ツリーはファット AABB なので、実際のワールド AABB で絞り込む
+    ids.clear();
+    m_dynamicTree.QueryOverlap(box, ids);
+    for (std::uint32_t id : ids)
+        if (overlaps(m_dynamic[id].worldBox)) out.push_back(m_dynamic[id].mr);
+}
+
+/*
+    SceneRenderer::UpdateVisibility
+    ----------------------------------------------------------------------------
+    全判定になる条件：
+      - キャッシュが未使用 / エポック（BVH 再構築・全消去）が違う
+      - View*Proj がビット単位で前回と違う（カメラ移動・投影変更・RT リサイズ）
+      - 前回の更新から Prepare が 2 回以上進んだ（間の変化履歴を持っていないため）
+    差分更新：
+      - m_dynamicRemoved のプロキシを可視リストから外し、
+        m_dynamicChanged のプロキシだけ実際のワールド AABB で判定し直す。
+      - 削除 → 変化の順に処理する（同じフレームでプロキシ ID が再利用されうるため）。
+*/
+namespace
+{
+    // DrawList のメッシュ識別子（24bit）：VB の GPU 仮想アドレスを畳み込み、共有 VB/IB 上の
+    // 区間の先頭（StartIndex）を足す。GeometryPool のメッシュは VB が同じなので StartIndex 順に並ぶ。
+    // コミット済みリソースは 64KB 境界なので下位 16bit は捨てる。衝突してもソートの並びが
+    // 少し崩れるだけ（区間の同一判定とバインド省略は実値で比べるので描画結果は変わらない）。
+    // LOD は区間の先頭が違うので、段ごとに別のメッシュとして並ぶ。
+    std::uint32_t MeshKeyOf(const MeshRendererComponent& mr, std::uint32_t lod)
+    {
+        const std::uint64_t va = mr.VertexBufferViews[MeshRendererComponent::kPositionStream].BufferLocation;
+        const std::uint32_t buffer = static_cast<std::uint32_t>((va >> 16) ^ (va >> 40)) * 0x9E3779B1u;
+        return (buffer + mr.Lods[lod].StartIndex) & 0xFFFFFFu;
+    }
+
+    // ビュー空間の奥行き depth にある半径 radius の球が画面に映る半径（ピクセル）。
+    // halfHeight は RT の高さの半分。正射影（proj._34 == 0）は奥行きに依らない。カメラが球の中なら無限大
+    float ProjectedRadius(float radius, float depth, const XMFLOAT4X4& proj, float halfHeight)
+    {
+        if (proj._34 == 0.0f) return radius * proj._22 * halfHeight;
+        if (depth <= radius) return FLT_MAX;
+        return radius * proj._22 * halfHeight / depth;
+    }
+
+    // mr の段の誤差で LOD を選ぶ（Renderer/LodSelection.h）
+    std::uint32_t SelectMeshLod(const MeshRendererComponent& mr, float radiusPx, std::uint32_t prev, const LodSelectSettings& s)
+    {
+        float errors[MeshRendererComponent::kMaxLods];
+        for (UINT k = 0; k < mr.LodCount; ++k) errors[k] = mr.Lods[k].Error;
+        return SelectLod(errors, mr.LodCount, radiusPx, prev, s);
+    }
+
+    // dynamicVisible への追加/削除（swap-remove で O(1)）
+    void SetDynamicVisible(ViewVisibilityCache& vis, std::int32_t proxy, bool visible)
+    {
+        if (proxy >= (std::int32_t)vis.dynamicSlot.size())
+        {
+            if (!visible) return;
+            vis.dynamicSlot.resize(proxy + 1, -1);
+        }
+
+        std::int32_t& slot = vis.dynamicSlot[proxy];
+        if (visible == (slot >= 0)) return;
+
+        if (visible)
+        {
+            slot = static_cast<std::int32_t>(vis.dynamicVisible.size());
+            vis.dynamicVisible.push_back(proxy);
+        }
+        else
+        {
+            const std::int32_t last = vis.dynamicVisible.back();
+            vis.dynamicVisible[slot] = last;
+            vis.dynamicSlot[last] = slot;
+            vis.dynamicVisible.pop_back();
+            slot = -1;
+        }
+    }
+}
+
+void SceneRenderer::UpdateVisibility(ViewVisibilityCache& vis, const Frustum& frustum,
+    FXMMATRIX viewProj, SceneRenderStats& stats)
+{
+    XMFLOAT4X4 vp;
+    XMStoreFloat4x4(&vp, viewProj);
+
+    const bool sameCamera = std::memcmp(&vp, &vis.viewProj, sizeof(vp)) == 0;
+    const bool contiguous = (vis.prepareFrame == m_prepareFrame) || (vis.prepareFrame + 1 == m_prepareFrame);
+    const bool full = !vis.valid || vis.epoch != m_visibilityEpoch || !sameCamera || !contiguous;
+
+    if (full)
+    {
+        // Static：BVH を階層的に辿る（外側/内側のサブツリーは丸ごと処理）
+        vis.staticVisible.clear();
+        m_staticBvh.QueryFrustum(frustum, vis.staticVisible);
+
+        // Dynamic：AABB ツリーで候補を絞り、実際のワールド AABB で再判定
+        //          （ツリーはファット AABB なので、はみ出し分だけ候補が多めに出る）
+        for (std::int32_t proxy : vis.dynamicVisible) vis.dynamicSlot[proxy] = -1;
+        vis.dynamicVisible.clear();
+        vis.visibleScratch.clear();
+        m_dynamicTree.QueryFrustum(frustum, vis.visibleScratch);
+        for (std::uint32_t index : vis.visibleScratch)
+        {
+            const RenderItem& item = m_dynamic[index];
+            if (frustum.Intersects(item.worldBox)) SetDynamicVisible(vis, item.proxy, true);
+        }
+
+        stats.tested = static_cast<unsigned>(m_static.size() + m_dynamic.size());
+        if (vis.epoch != m_visibilityEpoch) vis.staticLod.assign(m_static.size(), 0); // Static ID が振り直された
+        vis.viewProj = vp;
+        vis.epoch = m_visibilityEpoch;
+        vis.valid = true;
+    }
+    else if (vis.prepareFrame != m_prepareFrame)
+    {
+        // 同じカメラ・同じ BVH：今回の Prepare で変化した Dynamic だけ判定し直す
+        for (std::int32_t proxy : m_dynamicRemoved) SetDynamicVisible(vis, proxy, false);
+        for (std::int32_t proxy : m_dynamicChanged)
+        {
+            const RenderItem& item = m_dynamic[m_dynamicTree.GetUserData(proxy)];
+            SetDynamicVisible(vis, proxy, frustum.Intersects(item.worldBox));
+        }
+        stats.tested = static_cast<unsigned>(m_dynamicChanged.size());
+    }
+
+    vis.prepareFrame = m_prepareFrame;
+}
+
+/*
+    SceneRenderer::UpdateOcclusion
+    ----------------------------------------------------------------------------
+      - カメラ（View*Proj のビット一致）とオクルーダのエポックが前回と同じなら、
+        深度バッファをそのまま使い回す（塗り直さない）。
+      - 違えば全オクルーダを CPU ラスタライズし直す（帯ごとに JobSystem で並列）。
+*/
+void SceneRenderer::UpdateOcclusion(ViewVisibilityCache& vis, FXMMATRIX viewProj)
+{
+    XMFLOAT4X4 vp;
+    XMStoreFloat4x4(&vp, viewProj);
+    if (vis.occlusionEpoch == m_occluderEpoch &&
+        std::memcmp(&vp, &vis.occlusion.ViewProj(), sizeof(vp)) == 0)
+        return;
+
+    vis.occlusion.BeginFrame(viewProj);
+    for (const RenderItem& o : m_occluders)
+        vis.occlusion.AddOccluder(o.mr->GetMeshData(), XMLoadFloat4x4(&o.world));
+    vis.occlusion.Rasterize();
+    vis.occlusionEpoch = m_occluderEpoch;
+}
 
 /*
     SceneRenderer::Record
     ----------------------------------------------------------------------------
-    F
-      - ^ꂽ RenderTarget ɑ΂ăV[Ŝ`悷B
-      - eIuWFNg̒萔obt@( b0 )t[pAbv[hobt@ɏ݁A
-        [g CBV (slot=0) sxւȂ Draw ςށB
-
-    OF
-      - rt.Color() LiRT쐬ς݁j
-      - cmd / m_framesiFrameResourcesjL
-      - m_pipe.rootiRootSignaturej Initialize ɐݒς
-
-    萔obt@̃Xbg蓖āF
-      - cbBase cc Ăяo̕`pXɊ蓖Ă gJnCfbNXh
-      - slot   cc ̊֐ 0..(maxObjects-1) Adst = cbBase + slot ɏ
-      - Xbg FrameResources  maxObjects ƈv邱
+    役割：
+      - 与えられた RenderTarget に対してシーン全体を描画する。
+      - パス共通の定数バッファ( b0：View/Proj/ViewProj・ライト・時間 )を 1 回だけ書いてバインドし、
+        オブジェクトごとのワールド行列は GpuSceneBuffer（t0、常駐）からスロット番号で引く。
+      - 同じ PSO・同じメッシュ（VB/IB/インデックス数/区間の先頭）が続く区間は 1 回の DrawIndexedInstanced に
+        まとめる（InstanceBatcher）。描画リスト順のスロット番号表（t1）を作り、区間の先頭位置を
+        ルート定数（b1）で渡すので、VS は g_objects[g_drawSlots[g_drawBase + SV_InstanceID]] で引ける。
+      - 描く前にワールド AABB を視錐台と判定し、外側のオブジェクトは
+        アップロード領域を消費せず Draw も積まない（統計として culled に数える）。
+        Static は BVH を辿り、完全外側/完全内側のサブツリーをまとめて処理する。
+      - 判定結果は vis（ビューごとのキャッシュ）に残す。カメラと BVH が前回と同じで
+        前フレームから続けて呼ばれていれば、Prepare で変化/削除された Dynamic だけを
+        判定し直して可視リストを差分更新する（Static は判定しない）。
+      - 視錐台を通ったものは、オクルーダがあればビューごとの CPU 深度バッファ（OcclusionCuller）で
+        もう一度判定し、隠れていれば捨てる（統計は occluded）。オクルーダ自身は判定しない。
+      - LOD：ワールド AABB の外接球をこのビューの射影で投影した半径（ピクセル）から、画面上の誤差が
+        pixelError に収まる最も粗い段を選ぶ（LodSelectSettings。前回の段はビューごとに vis に残し、
+        ヒステリシスで境目のちらつきを抑える）。段はパケットに持たせ、区間もインスタンスも段ごとに分かれる。
+        コントリビューションカリングが有効なら、投影した直径が minScreenSize 未満のものを捨てる。
+      - 2 段構成：
+          抽出 …… 残った候補を DrawList（LinearAllocator 上の平らな配列）へ 64bit キー付きで積む
+          記録 …… キーで基数ソートし、並んだ順にコマンドを積む
+        キーは PSO → メッシュ → 手前からの奥行き の順なので、同じメッシュが連続して
+        IASetVertexBuffers/IASetIndexBuffer を省け、メッシュ内は手前から描かれて Early-Z が効く。
+        GeometryPool のメッシュは VB/IB を共有しているので、バインドはパス全体でほぼ 1 回になり、
+        メッシュの違いは StartIndex/BaseVertex だけで表す。
+
+    事前条件：
+      - rt.Color() が有効（RTが作成済み）
+      - cmd / m_frames（FrameResources）が有効（cmd は m_frames->CommandLists() から払い出したリスト）
+      - m_pipe.root（RootSignature）は Initialize 時に設定済み
+      - 今フレームの Prepare → UploadObjects が済んでいる
+
+    アップロード領域：
+      - FrameResources::Upload()（UploadRing）から毎パス切り出す。
+          CB         …… パス定数 1 つ（256B 境界）
+          スロット表 …… 可視数ぶんの uint（InstanceData 本体は送らない）
+      - ページ単位で伸び、フレームの Signal 値で退役するので、オブジェクト数・パス数に上限は無い。
 */
-void SceneRenderer::Record(ID3D12GraphicsCommandList* cmd,
+SceneRenderStats SceneRenderer::Record(ID3D12GraphicsCommandList* cmd,
     RenderTarget& rt,
     const CameraMatrices& cam,
-    const Scene* scene,
-    UINT cbBase,
-    UINT frameIndex,
-    UINT maxObjects)
+    ViewVisibilityCache& vis)
 {
-    // --- hFŒ̈ˑ֌Wꍇ͉Ȃ ---
-    if (!rt.Color() || !cmd || !m_frames) return;
+    // --- 防御：最低限の依存関係が無い場合は何もしない ---
+    SceneRenderStats stats{};
+    if (!rt.Color() || !cmd || !m_frames) return stats;
 
     // ==============================
-    // 1) o̓^[Qbg̏iRTV/NA/r[|[gj
+    // 1) 出力ターゲットの準備（RTV/クリア/ビューポート）
     // ==============================
 
-    // KvȂ RT Ԃ֑Jځiřp`FbNj
+    // 必要なら RT 状態へ遷移（内部で冪等チェック）
     rt.TransitionToRT(cmd);
 
-    // OM  RTV/DSV oChi̊֐ł DSV gȂ\j
+    // OM に RTV/DSV をバインド（この関数では DSV を使わない構成）
     rt.Bind(cmd);
 
-    // NAiwiF/[xj
+    // クリア（背景色/深度）
     rt.Clear(cmd);
 
-    // r[|[g/VU[ RT TCYSʂ
-    {
-        D3D12_VIEWPORT vp{ 0.f, 0.f, (float)rt.Width(), (float)rt.Height(), 0.f, 1.f };
-        D3D12_RECT     sc{ 0, 0, (LONG)rt.Width(), (LONG)rt.Height() };
-        cmd->RSSetViewports(1, &vp);
-        cmd->RSSetScissorRects(1, &sc);
-    }
+    // ビューポート/シザーを RT サイズ全面へ
+    const D3D12_VIEWPORT vp{ 0.f, 0.f, (float)rt.Width(), (float)rt.Height(), 0.f, 1.f };
+    const D3D12_RECT     sc{ 0, 0, (LONG)rt.Width(), (LONG)rt.Height() };
+    cmd->RSSetViewports(1, &vp);
+    cmd->RSSetScissorRects(1, &sc);
 
-    // g|W/[gVOl`iPSO ͌ĂяoŃZbgςݑOj
+    // PSO/トポロジ/ルートシグネチャ（並列記録で後続のリストが変わりうるので PSO もここでセットする）
+    if (m_pipe.pso) cmd->SetPipelineState(m_pipe.pso.Get());
     cmd->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
     cmd->SetGraphicsRootSignature(m_pipe.root.Get());
 
     // ==============================
-    // 2) V[𑖍ĕ`i[/̏͂ł͖lj
+    // 2) Prepare 済みの候補を描画（PSO/メッシュ/奥行きでソート。半透明の奥→手前はここでは未考慮）
     // ==============================
-    if (scene)
-    {
-        // t[̃Abv[ḧ擾
-        auto& fr = m_frames->Get(frameIndex);
-        UINT8* cbCPU = fr.cpu;                            // CPUݐiMapρj
-        D3D12_GPU_VIRTUAL_ADDRESS cbGPU = fr.resource->GetGPUVirtualAddress(); // GPUx[X
-        const UINT cbStride = m_frames->GetCBStride();    // 256B ACς݃TCY
-        UINT slot = 0;                                    // ̕`pXŏ郍[JXbg
 
-        using namespace DirectX;
+    // 定数/インスタンスの書き込み先（ページ単位で伸びるので数の上限は無い）
+    UploadRing& upload = m_frames->Upload();
+
+    // 視錐台（このパスのカメラで 1 回だけ構築）
+    const XMMATRIX viewProj = cam.view * cam.proj;
+    const Frustum frustum = Frustum::FromViewProj(viewProj);
+
+    // 簡易ライト（上前方からの平行光源）：パス定数に 1 回だけ入れる
+    XMFLOAT3 lightDir;
+    XMStoreFloat3(&lightDir, XMVector3Normalize(XMVectorSet(0.0f, -1.0f, -1.0f, 0.0f)));
+
+    // 2.0) 可視リストの更新（全判定 or 差分）
+    UpdateVisibility(vis, frustum, viewProj, stats);
 
-        // ---- ċA_FV[Ot MeshRenderer Ε` ----
-        std::function<void(std::shared_ptr<GameObject>)> draw =
-            [&](std::shared_ptr<GameObject> go)
+    // 2.0') オクルージョン深度バッファ（カメラかオクルーダが変わったときだけ塗り直す）
+    const bool occlusion = m_occlusionEnabled && !m_occluders.empty();
+    if (occlusion) UpdateOcclusion(vis, viewProj);
+
+    // ==============================
+    // 2.1) 抽出：可視な候補を平らな描画リストへ（キー = PSO / メッシュ / 手前からの奥行き）
+    // ==============================
+    XMFLOAT4X4 view, proj;
+    XMStoreFloat4x4(&view, cam.view);
+    XMStoreFloat4x4(&proj, cam.proj);
+    const float halfHeight = static_cast<float>(rt.Height()) * 0.5f;
+    const bool sizeTests = m_lod.enabled || m_lod.contributionCulling;
+
+    // lodState：このビューで前回描いた LOD（ヒステリシス用。nullptr なら常に LOD0）
+    auto push = [&](const RenderItem& item, std::uint8_t* lodState)
+        {
+            // 奥行き：ワールド AABB 中心のビュー空間 z（無効 AABB は 0 = 最前）
+            float depth = 0.0f;
+            std::uint32_t lod = 0;
+            const AABB& b = item.worldBox;
+            if (b.IsValid())
             {
-                if (!go || slot >= maxObjects) return; // XbgőI
+                const float cx = (b.Min.x + b.Max.x) * 0.5f;
+                const float cy = (b.Min.y + b.Max.y) * 0.5f;
+                const float cz = (b.Min.z + b.Max.z) * 0.5f;
+                depth = cx * view._13 + cy * view._23 + cz * view._33 + view._43;
 
-                if (auto mr = go->GetComponent<MeshRendererComponent>())
+                // 画面上の大きさ（AABB の外接球を投影した半径）で捨てる/LOD を選ぶ
+                if (sizeTests)
                 {
-                    // VB/IB LŁA`CfbNXȂ`
-                    if (mr->VertexBuffer && mr->IndexBuffer && mr->IndexCount > 0)
+                    const float dx = b.Max.x - b.Min.x, dy = b.Max.y - b.Min.y, dz = b.Max.z - b.Min.z;
+                    const float radiusPx = ProjectedRadius(0.5f * std::sqrt(dx * dx + dy * dy + dz * dz), depth, proj, halfHeight);
+                    if (m_lod.contributionCulling && radiusPx * 2.0f < m_lod.minScreenSize)
                     {
-                        // 2.1) svZFM, MVP, (M^-1)^T
-                        XMMATRIX world = go->Transform->GetWorldMatrix();
-                        XMMATRIX mvp = world * cam.view * cam.proj;
-
-                        // tšS`FbNikނ NaN/Inf ɂȂ肤j
-                        XMVECTOR det;
-                        XMMATRIX inv = XMMatrixInverse(&det, world);
-                        float detScalar = XMVectorGetX(det);
-                        if (!std::isfinite(detScalar) || std::fabs(detScalar) < 1e-8f) {
-                            // ɒ[ȃXP[/k  @̂ŃtH[obN
-                            inv = XMMatrixIdentity();
-                        }
-                        XMMATRIX worldIT = XMMatrixTranspose(inv);
-
-                        // 2.2) 萔obt@gݗĂ Upload
-                        SceneConstantBuffer cb{};
-                        XMStoreFloat4x4(&cb.mvp, mvp);
-                        XMStoreFloat4x4(&cb.world, world);
-                        XMStoreFloat4x4(&cb.worldIT, worldIT);
-                        // ȈՃCgiO̕sj
-                        XMStoreFloat3(&cb.lightDir,
-                            XMVector3Normalize(XMVectorSet(0.0f, -1.0f, -1.0f, 0.0f)));
-                        cb.pad = 0.0f;
-
-                        // 2.3) ̃IuWFNg CBV XbgicbBase N_j
-                        const UINT dst = cbBase + slot;
-
-                        // CPU Abv[hփRs[i256B ACj
-                        std::memcpy(cbCPU + (UINT64)dst * cbStride, &cb, sizeof(cb));
-
-                        // [g CBV ւib0j
-                        cmd->SetGraphicsRootConstantBufferView(
-                            0, cbGPU + (UINT64)dst * cbStride);
-
-                        // 2.4) WIgoCh Draw
-                        cmd->IASetVertexBuffers(0, 1, &mr->VertexBufferView);
-                        cmd->IASetIndexBuffer(&mr->IndexBufferView);
-                        cmd->DrawIndexedInstanced(mr->IndexCount, 1, 0, 0, 0);
-
-                        ++slot; // IuWFNg
+                        ++stats.contributionCulled; // 数ピクセルにも満たない
+                        return;
+                    }
+                    if (m_lod.enabled && lodState)
+                    {
+                        lod = SelectMeshLod(*item.mr, radiusPx, *lodState, m_lod);
+                        *lodState = static_cast<std::uint8_t>(lod);
                     }
                 }
+            }
 
-                // qm[hċA
-                for (auto& ch : go->GetChildren()) draw(ch);
-            };
+            if (occlusion && !item.mr->IsOccluder() && !vis.occlusion.IsVisible(item.worldBox))
+            {
+                ++stats.occluded; // 視錐台内だが隠れている
+                return;
+            }
 
-        // [g瑖Jni̓V[f[^ˑBKvɉă\[gǉj
-        for (auto& root : scene->GetRootGameObjects()) draw(root);
+            // メッシュレット：塊ごとに視錐台/裏向きを判定し、残った三角形だけの IB を詰めて別に描く
+            const MeshletData* meshlets = (lod == 0 && m_meshlet.enabled) ? item.mr->GetMeshlets() : nullptr;
+            if (meshlets && meshlets->Meshlets.size() >= 2 && (m_meshlet.frustum || m_meshlet.cone))
+            {
+                MeshletCullView mv = MakeMeshletCullView(XMLoadFloat4x4(&item.world), cam.view, cam.proj);
+                mv.testFrustum = m_meshlet.frustum && frustum.Classify(item.worldBox) != CullResult::Inside;
+                mv.testCone = mv.testCone && m_meshlet.cone;
+                MeshletCullStats ms;
+                const std::size_t indexCount = CullMeshlets(*meshlets, mv, vis.meshletScratch, &ms);
+                stats.meshletsTested += ms.tested;
+                stats.meshletsCulled += ms.frustumCulled + ms.coneCulled;
+                if (indexCount == 0) return; // 全部の塊が外/裏向き
+
+                // ほとんど残るなら詰め直さない（元の IB で、インスタンシングにも乗せる）
+                if (indexCount <= item.mr->IndexCount * m_meshlet.maxVisibleRatio)
+                {
+                    const DXGI_FORMAT format = item.mr->IndexBufferView.Format;
+                    const std::uint32_t stride = IndexFormatSize(format);
+                    const UploadAllocation ibMem = upload.Allocate(indexCount * stride, 4);
+                    if (ibMem.cpu)
+                    {
+                        WriteMeshletIndices(*meshlets, vis.meshletScratch.data(), vis.meshletScratch.size(),
+                            ibMem.cpu, format == DXGI_FORMAT_R16_UINT);
+                        MeshletDraw d;
+                        d.item = &item;
+                        d.ibv = { ibMem.gpu, static_cast<UINT>(indexCount * stride), format };
+                        d.indexCount = static_cast<std::uint32_t>(indexCount);
+                        d.depth = depth;
+                        vis.meshletDraws.push_back(d);
+                        stats.triangles += d.indexCount / 3;
+                        return;
+                    }
+                }
+            }
+
+            if (lod > 0) ++stats.lodReduced;
+            stats.triangles += item.mr->Lods[lod].IndexCount / 3;
+            vis.drawList.Push(DrawList::MakeKey(/*pipeline=*/0, MeshKeyOf(*item.mr, lod), depth), &item, lod);
+        };
+
+    vis.drawList.Begin(vis.staticVisible.size() + vis.dynamicVisible.size() + m_dynamicUnbounded.size());
+    vis.meshletDraws.clear();
+    if (vis.staticLod.size() < m_static.size()) vis.staticLod.resize(m_static.size(), 0);
+    for (std::uint32_t id : vis.staticVisible) push(m_static[id], &vis.staticLod[id]);
+    for (std::int32_t proxy : vis.dynamicVisible)
+    {
+        if (proxy >= (std::int32_t)vis.dynamicLod.size()) vis.dynamicLod.resize(proxy + 1, 0);
+        push(m_dynamic[m_dynamicTree.GetUserData(proxy)], &vis.dynamicLod[proxy]);
     }
+    for (std::uint32_t index : m_dynamicUnbounded) push(m_dynamic[index], nullptr);
 
     // ==============================
-    // 3) o͂ SRV ԂցiUI Tvł悤Ɂj
+    // 2.2) 並べ替え（基数ソート）
+    // ==============================
+    vis.drawList.Sort();
+    std::sort(vis.meshletDraws.begin(), vis.meshletDraws.end(),
+        [](const MeshletDraw& a, const MeshletDraw& b) { return a.depth < b.depth; });
+
+    // ==============================
+    // 2.3) パス定数：カメラ・ライト・時間を 1 回だけ書いてバインド（256B 境界で切り出す）
+    // ==============================
+    D3D12_GPU_VIRTUAL_ADDRESS passCB = 0;
+    {
+        const UploadAllocation cbMem = upload.Allocate(sizeof(PassConstants),
+            D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+        if (!cbMem.cpu)
+        {
+            // ページを作れなかった（メモリ不足）：何も描かずに RT だけ戻す
+            rt.TransitionToSRV(cmd);
+            return stats;
+        }
+        PassConstants cb{};
+        cb.view = view;
+        XMStoreFloat4x4(&cb.proj, cam.proj);
+        XMStoreFloat4x4(&cb.viewProj, viewProj);
+        cb.lightDir = lightDir;
+        cb.time = Time::GetTime();
+        cb.lightColor = { 1.0f, 1.0f, 1.0f };
+        XMVECTOR det;
+        XMStoreFloat3(&cb.cameraPos, XMMatrixInverse(&det, cam.view).r[3]); // View^-1 の平行移動 = カメラ位置
+        std::memcpy(cbMem.cpu, &cb, sizeof(cb));
+        passCB = cbMem.gpu;
+        cmd->SetGraphicsRootConstantBufferView(0, passCB);
+    }
+
+    // ==============================
+    // 2.4) インスタンシング：同じ PSO・同じメッシュが続く区間を 1 Draw にまとめる
+    //      InstanceData は GpuSceneBuffer に常駐しているので、ここでは
+    //      描画リスト順の「インスタンス → スロット番号」表（4B/件）だけを書く
+    // ==============================
+    const std::size_t instanceCount = BuildInstanceBatches(vis.drawList.begin(), vis.drawList.Size(), vis.drawList.Size(),
+        [](const RenderItem& a, const RenderItem& b)
+        {
+            // 属性ストリームは位置ストリームと一緒に作り直されるので、位置 VB が同じなら同じ
+            return a.mr->VertexBufferViews[MeshRendererComponent::kPositionStream].BufferLocation == b.mr->VertexBufferViews[MeshRendererComponent::kPositionStream].BufferLocation
+                && a.mr->IndexBufferView.BufferLocation == b.mr->IndexBufferView.BufferLocation
+                && a.mr->IndexCount == b.mr->IndexCount
+                && a.mr->StartIndex == b.mr->StartIndex
+                && a.mr->BaseVertex == b.mr->BaseVertex;
+        },
+        vis.batches);
+
+    // メッシュレットで詰め直した Draw は区間の後ろ（instanceCount + i）に 1 件ずつ置く
+    const std::size_t slotCount = instanceCount + vis.meshletDraws.size();
+    const UploadAllocation slotMem = upload.Allocate(slotCount * sizeof(std::uint32_t), 16);
+    if (!slotMem.cpu || (slotCount > 0 && m_objects.GpuAddress() == 0))
+    {
+        // 表の領域が取れない / オブジェクトバッファが無い（UploadObjects 前や作成失敗）
+        rt.TransitionToSRV(cmd);
+        return stats;
+    }
+    std::uint32_t* slots = reinterpret_cast<std::uint32_t*>(slotMem.cpu);
+    const DrawPacket* packets = vis.drawList.begin();
+    for (std::size_t i = 0; i < instanceCount; ++i)
+        slots[i] = packets[i].item->slot;
+    for (std::size_t i = 0; i < vis.meshletDraws.size(); ++i)
+        slots[instanceCount + i] = vis.meshletDraws[i].item->slot;
+
+    cmd->SetGraphicsRootShaderResourceView(2, m_objects.GpuAddress()); // t0：InstanceData（常駐）
+    cmd->SetGraphicsRootShaderResourceView(3, slotMem.gpu);           // t1：スロット番号の表（このパス）
+
+    // ==============================
+    // 2.5) 記録（間接）：区間ごとのレコードを書き、pipeline ごとに ExecuteIndirect 1 回
+    // ==============================
+    bool recorded = false;
+    if (m_indirectEnabled && m_drawSignature && (!vis.batches.empty() || !vis.meshletDraws.empty()))
+    {
+        const std::size_t records = vis.batches.size() + vis.meshletDraws.size();
+        const UploadAllocation argMem = upload.Allocate(records * sizeof(IndirectDrawCommand), 8);
+        if (argMem.cpu && argMem.resource)
+        {
+            IndirectDrawCommand* commands = reinterpret_cast<IndirectDrawCommand*>(argMem.cpu);
+            WriteIndirectCommands(packets, vis.batches.data(), vis.batches.size(),
+                [](const RenderItem& item, std::uint32_t lod)
+                {
+                    IndirectMesh m;
+                    static_assert(kIndirectVertexStreams == MeshRendererComponent::kVertexStreamCount, "VB スロット数の食い違い");
+                    for (UINT s = 0; s < kIndirectVertexStreams; ++s)
+                        m.vbv[s] = item.mr->VertexBufferViews[s];
+                    m.ibv = item.mr->IndexBufferView;
+                    m.indexCount = item.mr->Lods[lod].IndexCount;
+                    m.startIndex = item.mr->Lods[lod].StartIndex;
+                    m.baseVertex = item.mr->BaseVertex;
+                    return m;
+                },
+                commands, vis.indirectRuns);
+
+            // メッシュレットの Draw を後ろに足す（pipeline 桁は 0。同じ Run に続ける）
+            for (std::size_t i = 0; i < vis.meshletDraws.size(); ++i)
+            {
+                const MeshletDraw& d = vis.meshletDraws[i];
+                IndirectDrawCommand& c = commands[vis.batches.size() + i];
+                for (UINT s = 0; s < kIndirectVertexStreams; ++s) c.vbv[s] = d.item->mr->VertexBufferViews[s];
+                c.ibv = d.ibv;
+                c.drawBase = static_cast<std::uint32_t>(instanceCount + i);
+                c.draw.IndexCountPerInstance = d.indexCount;
+                c.draw.InstanceCount = 1;
+                c.draw.StartIndexLocation = 0;
+                c.draw.BaseVertexLocation = d.item->mr->BaseVertex;
+                c.draw.StartInstanceLocation = 0;
+                if (vis.indirectRuns.empty() || vis.indirectRuns.back().pipeline != 0)
+                    vis.indirectRuns.push_back({ 0, static_cast<std::uint32_t>(vis.batches.size() + i), 0 });
+                ++vis.indirectRuns.back().count;
+            }
+
+            for (const IndirectRun& run : vis.indirectRuns)
+            {
+                // pipeline 桁は現状 0 のみ（PSO は冒頭でセット済み）。増やしたらここで切り替える
+                cmd->ExecuteIndirect(m_drawSignature.Get(), run.count, argMem.resource,
+                    argMem.offset + static_cast<UINT64>(run.first) * sizeof(IndirectDrawCommand), nullptr, 0);
+                ++stats.indirectCalls;
+            }
+            stats.drawCalls = static_cast<unsigned>(records);
+            recorded = true;
+        }
+    }
+
+    // ==============================
+    // 2.5') 記録（直接）：区間ごとにルート定数（表の先頭）を変えて DrawIndexedInstanced。メッシュが前と同じなら IASet* を省く
+    //       区間が多ければ複数のリストに分けて JobSystem で並列に記録する（提出順はプールの払い出し順）
+    // ==============================
+    auto recordBatches = [&vis](ID3D12GraphicsCommandList* list, std::size_t first, std::size_t last,
+        unsigned& meshBinds, unsigned& drawCalls)
+        {
+            D3D12_GPU_VIRTUAL_ADDRESS boundVB = 0, boundIB = 0;
+            for (std::size_t b = first; b < last; ++b)
+            {
+                const InstanceBatch& batch = vis.batches[b];
+
+                // ジオメトリ：同じバッファが続く間はバインドし直さない
+                const MeshRendererComponent* mr = batch.item->mr;
+                // （全ストリームの VB は GeometryPool で一緒に差し替わるので、位置 VB だけで比べる）
+                if (mr->VertexBufferViews[MeshRendererComponent::kPositionStream].BufferLocation != boundVB)
+                {
+                    list->IASetVertexBuffers(0, MeshRendererComponent::kVertexStreamCount, mr->VertexBufferViews);
+                    boundVB = mr->VertexBufferViews[MeshRendererComponent::kPositionStream].BufferLocation;
+                    ++meshBinds;
+                }
+                if (mr->IndexBufferView.BufferLocation != boundIB)
+                {
+                    list->IASetIndexBuffer(&mr->IndexBufferView);
+                    boundIB = mr->IndexBufferView.BufferLocation;
+                    ++meshBinds;
+                }
+
+                // SV_InstanceID は 0 始まりなので、区間の先頭（表の位置）をルート定数 b1 で渡す
+                list->SetGraphicsRoot32BitConstant(1, batch.first, 0);
+                const MeshRendererComponent::LodRange& range = mr->Lods[batch.lod];
+                list->DrawIndexedInstanced(range.IndexCount, batch.count, range.StartIndex, mr->BaseVertex, 0);
+                ++drawCalls;
+            }
+        };
+
+    // メッシュレットで詰め直した Draw（1 件 1 インスタンス。IB は毎回 UploadRing 上の別の区間）
+    auto recordMeshletDraws = [&vis, instanceCount](ID3D12GraphicsCommandList* list, unsigned& meshBinds, unsigned& drawCalls)
+        {
+            D3D12_GPU_VIRTUAL_ADDRESS boundVB = 0;
+            for (std::size_t i = 0; i < vis.meshletDraws.size(); ++i)
+            {
+                const MeshletDraw& d = vis.meshletDraws[i];
+                const MeshRendererComponent* mr = d.item->mr;
+                if (mr->VertexBufferViews[MeshRendererComponent::kPositionStream].BufferLocation != boundVB)
+                {
+                    list->IASetVertexBuffers(0, MeshRendererComponent::kVertexStreamCount, mr->VertexBufferViews);
+                    boundVB = mr->VertexBufferViews[MeshRendererComponent::kPositionStream].BufferLocation;
+                    ++meshBinds;
+                }
+                list->IASetIndexBuffer(&d.ibv);
+                ++meshBinds;
+                list->SetGraphicsRoot32BitConstant(1, static_cast<UINT>(instanceCount + i), 0);
+                list->DrawIndexedInstanced(d.indexCount, 1, 0, mr->BaseVertex, 0);
+                ++drawCalls;
+            }
+        };
+
+    // 払い出したばかりのリストへパスの状態（PSO/RT/ビューポート/ルート引数）を積む
+    auto bindPass = [&](ID3D12GraphicsCommandList* list)
+        {
+            list->SetPipelineState(m_pipe.pso.Get());
+            rt.Bind(list);
+            list->RSSetViewports(1, &vp);
+            list->RSSetScissorRects(1, &sc);
+            list->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+            list->SetGraphicsRootSignature(m_pipe.root.Get());
+            list->SetGraphicsRootConstantBufferView(0, passCB);
+            list->SetGraphicsRootShaderResourceView(2, m_objects.GpuAddress());
+            list->SetGraphicsRootShaderResourceView(3, slotMem.gpu);
+        };
+
+    if (!recorded)
+    {
+        const std::size_t chunks = std::min<std::size_t>(JobSystem::WorkerCount(), vis.batches.size() / kMinBatchesPerList);
+        CommandListPool& lists = m_frames->CommandLists();
+
+        // 並列用のリストを払い出す（今のリストの後ろに並ぶ）。1 本でも取れなければ直列に戻す
+        vis.chunkLists.clear();
+        for (std::size_t k = 0; chunks >= 2 && k < chunks; ++k)
+        {
+            ID3D12GraphicsCommandList* list = lists.Acquire();
+            if (!list) break;
+            vis.chunkLists.push_back(list);
+        }
+
+        if (chunks >= 2 && vis.chunkLists.size() == chunks)
+        {
+            // 新しいリストは状態を持たないので、パスの状態をメインスレッドで積んでおく
+            for (ID3D12GraphicsCommandList* list : vis.chunkLists) bindPass(list);
+
+            // 区間を chunks 等分し、チャンクごとに 1 本のリストへ（統計はチャンク別に数えて後で足す）
+            vis.chunkStats.assign(chunks, {});
+            const std::size_t n = vis.batches.size();
+            JobSystem::ParallelFor(chunks, 1, [&](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t k = begin; k < end; ++k)
+                        recordBatches(vis.chunkLists[k], n * k / chunks, n * (k + 1) / chunks,
+                            vis.chunkStats[k].meshBinds, vis.chunkStats[k].drawCalls);
+                });
+            for (const SceneRenderStats& c : vis.chunkStats)
+            {
+                stats.meshBinds += c.meshBinds;
+                stats.drawCalls += c.drawCalls;
+            }
+            stats.parallelLists = static_cast<unsigned>(chunks);
+
+            // 以降（RT の遷移）は並列分の後ろに並ぶ新しいリストへ積む（取れなければ最後のチャンクの続き）
+            ID3D12GraphicsCommandList* tail = lists.Acquire();
+            cmd = tail ? tail : vis.chunkLists.back();
+            if (!vis.meshletDraws.empty())
+            {
+                if (tail) bindPass(tail);
+                recordMeshletDraws(cmd, stats.meshBinds, stats.drawCalls);
+            }
+        }
+        else
+        {
+            // 直列：途中まで取れたリストがあればその最後（= 今のリストより後ろ）に積む
+            if (!vis.chunkLists.empty())
+            {
+                cmd = vis.chunkLists.back();
+                bindPass(cmd);
+            }
+            recordBatches(cmd, 0, vis.batches.size(), stats.meshBinds, stats.drawCalls);
+            recordMeshletDraws(cmd, stats.meshBinds, stats.drawCalls);
+        }
+
+    }
+    stats.visible = static_cast<unsigned>(slotCount);
+
+    const std::size_t passed = vis.staticVisible.size() + vis.dynamicVisible.size() + m_dynamicUnbounded.size();
+    stats.culled = static_cast<unsigned>(m_static.size() + m_dynamic.size() - passed);
+
+    // ==============================
+    // 3) 出力を SRV 状態へ（UI 側がサンプルできるように）
     // ==============================
     rt.TransitionToSRV(cmd);
+    return stats;
+}
+
+/*
+    SceneRenderer::RecordViews
+    ----------------------------------------------------------------------------
+      - 抽出（Prepare）とオブジェクトバッファのコピー（UploadObjects）は呼び出し側で 1 回だけ済ませ、
+        ここではビューごとの判定・ソート・記録だけを行う（判定はカメラごとに違うので共有できない）。
+      - リストの提出順：
+          cmd（コピー） → ビュー 0 → ビュー 1 → … → 各ビューの並列分/続き → 後続（Presenter/ImGui）
+        ビューどうしは別の RT に書くだけなので、間に他のビューのリストが挟まっても結果は変わらない。
+      - ビュー用のリストが 1 本でも取れなければ、今のリストに順に記録する（従来どおり）。
+*/
+void SceneRenderer::RecordViews(ID3D12GraphicsCommandList* cmd, const SceneViewPass* views, std::size_t count)
+{
+    if (!m_frames || !cmd || count == 0) return;
+    CommandListPool& lists = m_frames->CommandLists();
+
+    // ビューごとのリストを払い出す（メインスレッドで。払い出し順 = 提出順）
+    m_viewLists.clear();
+    for (std::size_t i = 0; m_concurrentViews && count >= 2 && i < count; ++i)
+    {
+        ID3D12GraphicsCommandList* list = lists.Acquire();
+        if (!list) break;
+        m_viewLists.push_back(list);
+    }
+
+    if (m_viewLists.size() == count && count >= 2)
+    {
+        // ビューごとに 1 ジョブ。Record 内のチャンク並列（ParallelFor の入れ子）もそのまま使える
+        JobSystem::ParallelFor(count, 1, [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    const SceneViewPass& v = views[i];
+                    const SceneRenderStats stats = Record(m_viewLists[i], *v.rt, v.cam, *v.vis);
+                    if (v.stats) *v.stats = stats;
+                }
+            });
+
+        // 後続の記録先（全ビューの後ろに並ぶ）。取れなければ最後に払い出されたリストの続きになる
+        lists.Acquire();
+        return;
+    }
+
+    // 直列：途中まで取れたリストがあればその最後（= cmd より後ろ）から続ける
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        ID3D12GraphicsCommandList* current = lists.Current();
+        const SceneViewPass& v = views[i];
+        const SceneRenderStats stats = Record(current ? current : cmd, *v.rt, v.cam, *v.vis);
+        if (v.stats) *v.stats = stats;
+    }
 }
 
 /*
-ỹ / Ƃz
-- FrameResources  cbStride  256B ACK{iD3D12 萔obt@KjB
-  Initialize(cbSize)  (cbSize+255)&~255 ɂȂĂ邱ƂvmFB
-- cbBase/slot  maxObjectsF
-  * cbBase  g̕`pX̐擪h ĂяoǗiFScene=0..N-1, Game=N..2N-1jB
-  * slot ͂̊֐̃[JBmaxObjects 𒴂Sɑł؂B
-- PSO/RS/RootSigF
-  * {֐ł RootSignature ݂̂ZbgBPSO Zbg͌Ăяo̐ӖB
-  * g InputLayout/VF[_ VB/IB  stride/format vĂ邱ƁB
-- Transform ̋tsF
-  * ɒ[ȃXP[i0ɋ߂j񐳑s񂾂 inv  NaN oB
-     det `FbNAĂ Identity փtH[obNi@̂jB
-- [xeXgF
-  *  DSV  Bind ĂȂB[xg`ɂȂ RenderTarget 
-    DSV ABind()  RTV+DSV ݒ肷 or ĂяoœK؂ɐݒ肷B
+【実装上のメモ / 落とし穴】
+- CB の切り出しは 256B アライン必須（D3D12 定数バッファ規約）。Allocate の align で指定する。
+  スロット番号の表は StructuredBuffer<uint> なので 4B 間隔のまま詰める（16B 境界）。
+- オブジェクトバッファ（GpuSceneBuffer）：
+  * InstanceData は DEFAULT ヒープに常駐。Prepare でワールド行列を計算し直したものだけ Write し、
+    UploadObjects で書き換え区間をまとめて CopyBufferRegion する。
+  * Static の再構築はスロットを全部取り直す（全 Static を送り直す）。
+  * UploadObjects を呼ばずに Record すると、前回の内容（または空バッファ）で描くことになる。
+- アップロード領域：
+  * 可視なものはすべて描く（ページが足りなければ UploadRing が伸びる）。
+  * ページ作成に失敗したときだけ、そのパスは何も描かない。
+- インスタンシング：
+  * まとめる条件は「pipeline 桁が同じ」かつ「VB/IB の GPU アドレスとインデックス数が同じ」。
+    同じ MeshData から作ったメッシュは D3D12Renderer が VB/IB を共有させるので、
+    同じ形を並べたシーンはメッシュ数ぶんの Draw に減る。
+  * drawCalls は DrawIndexedInstanced の回数、visible はインスタンス総数（メッシュレットで詰め直した Draw を含む）。
+- 間接描画（ExecuteIndirect）：
+  * 区間 1 つ = IndirectDrawCommand 1 レコード（VBV ×2/IBV/drawBase/DrawIndexed、72B）。
+    引数バッファは UploadRing から切り出す（UPLOAD ヒープは GENERIC_READ なので INDIRECT_ARGUMENT を含む）。
+  * 間接記録では VB/IB をレコードごとに設定するので meshBinds は数えない（0 のまま）。
+  * ページにリソースが無い（フェイク）か、シグネチャを作れなかったときは直接記録に戻る。
+  * drawCalls は間接でも GPU 上の Draw 数（= 区間数）。indirectCalls は ExecuteIndirect の回数。
+- PSO/RS/RootSig：
+  * Record の冒頭で PSO と RootSignature をセットする（並列記録のリストにも同じものを積む）。
+  * 使う InputLayout/シェーダと VB/IB の stride/format が一致していること。
+- 視錐台カリング：
+  * ローカル AABB（SetMesh 時に計算）をワールド行列で変換（Arvo 法）して判定。
+  * Static は Prepare で作った BVH、Dynamic は AABB ツリー。変換は Prepare で 1 フレーム 1 回。
+  * AABB ツリーのマージン（既定 0.1）はワールド単位。大きく速いオブジェクトが多いなら広げる。
+  * 可視性キャッシュはカメラ行列のビット一致で判定する。わずかでも動けば全判定になる
+    （カメラ静止時に効く最適化。Game ビューの固定カメラでは常に差分更新になる）。
+  * 外側と判定したオブジェクトはアップロード領域を消費しない。
+- 静的バッチ：
+  * チャンク 1 つが RenderItem 1 つ（visible/culled もチャンク単位で数える）。
+  * チャンクは単位行列なので、同じ形でない限りインスタンシングではまとまらない（1 チャンク 1 Draw）。
+  * RaycastStatic/QueryOverlap はチャンクの MeshRendererComponent（シーン外）を返しうる。
+- オクルージョンカリング：
+  * culled は視錐台で捨てた数、occluded は視錐台内でオクルーダに隠れて捨てた数（別々に数える）。
+  * 深度バッファはビューごと（ViewVisibilityCache::occlusion）。カメラが動くフレームは毎回塗り直す。
+  * オクルーダは三角形の少ない大きなメッシュにすること。細かいメッシュは塗るコストの割に隠さない。
+- ビューの同時記録（RecordViews）：
+  * Record が書き換えるのは vis（ビューごとの作業領域）と戻り値の統計だけ。Prepare の結果・BVH・
+    AABB ツリー・オクルーダは読むだけなので、Prepare/UploadObjects と並行に呼んではいけない。
+  * UploadRing::Allocate と CommandListPool::Acquire は内部でロックする（スレッドをまたいで呼べる）。
+  * Record 内の記録先の切り替え（並列分の後ろ）は自分で払い出したリストだけを使い、
+    プールの Current() には頼らない（他のビューのリストかもしれないため）。
+- 描画リスト：
+  * DrawList の領域は LinearAllocator。Begin で Reset するだけなので定常状態では確保が起きない。
+  * pipeline 桁は現状 0 固定（PSO は 1 種類）。マテリアル/PSO を増やしたらここに番号を入れる。
+  * meshBinds は IASetVertexBuffers/IASetIndexBuffer を実際に呼んだ回数。
+- メッシュレットカリング：
+  * 対象は LOD0 で描くメッシュレット持ち（塊が 2 つ以上）。オブジェクト単位の判定（視錐台/オクルージョン/
+    コントリビューション）を通った後に、塊ごとに境界球と法線コーンで判定する（MeshletCuller）。
+  * 判定はメッシュのローカル空間。オブジェクトの AABB が視錐台の完全に内側なら塊の視錐台判定は省く。
+  * 残った塊のインデックスは元の頂点番号のまま UploadRing に詰める（元の IB と同じ形式、BaseVertex も同じ）。
+    UPLOAD ヒープは GENERIC_READ なので INDEX_BUFFER として読める。
+  * 詰め直した Draw はインスタンシングしない（ビューごとに IB が違う）。スロット表は区間の後ろに置く。
+  * 全部の塊が捨てられたらオブジェクトごと描かない（visible にも数えない）。残りが maxVisibleRatio を
+    超えたら通常の Draw に戻す（書き込み量の割に減らない）。
+  * triangles は詰め直した後の三角形数で数える。
+- Transform の逆行列：
+  * 極端なスケール（0に近い）や非正則行列だと inv に NaN が出る。
+    → PackInstance で det をチェックし、壊れていたら Identity へフォールバック（法線が崩れるのを回避）。
+  * PackInstance は Prepare（ワールド行列の更新時）でだけ呼ぶ。Record では呼ばない。
+- 深度テスト：
+  * 現状は DSV を Bind していない。深度を使う描画にするなら RenderTarget 側で
+    DSV を持たせ、Bind() で RTV+DSV を設定する or 呼び出し側で適切に設定する。
 */
@@ -2,100 +2,386 @@
 #include <wrl/client.h>
 #include <d3d12.h>
 #include <DirectXMath.h>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
-#include "Core/RenderTarget.h"              // ItXN[RTǗiJ[/[xARTV/DSVAJڃ[eBeBj
-#include "Core/FrameResources.h"            // t[OiUpload CB j
-#include "Pipeline/PipelineStateBuilder.h"  // PipelineSet `iRootSignature / PSOj
+#include "Core/RenderTarget.h"              // オフスクリーンRT管理（カラー/深度、RTV/DSV、遷移ユーティリティ）
+#include "Core/FrameResources.h"            // フレームリング（Upload CB 等）
+#include "Pipeline/PipelineStateBuilder.h"  // PipelineSet 定義（RootSignature / PSO）
 #include "Scene/Scene.h"
 #include "Scene/GameObject.h"
-#include "Graphics/SceneConstantBuffer.h"   // HLSL ɍ킹萔obt@\
+#include "Graphics/SceneConstantBuffer.h"   // HLSL に合わせた定数バッファ構造
 #include "Components/MeshRendererComponent.h"
+#include "Culling/StaticBvh.h"              // Static オブジェクト用の BVH
+#include "Culling/DynamicAabbTree.h"        // Dynamic オブジェクト用の AABB ツリー
+#include "Culling/OcclusionCuller.h"        // CPU ソフトウェアラスタライズによるオクルージョンカリング
+#include "Culling/MeshletCuller.h"          // メッシュレット単位の視錐台/裏向きカリング
+#include "Renderer/DrawList.h"              // ソートキー付きの描画リスト
+#include "Renderer/InstanceBatcher.h"       // 同じメッシュの連続区間をインスタンス描画にまとめる
+#include "Renderer/GpuSceneBuffer.h"        // オブジェクトデータの GPU 常駐バッファ（差分アップロード）
+#include "Renderer/IndirectCommands.h"      // ExecuteIndirect 用の間接引数レコード
+#include "Renderer/LodSelection.h"          // 画面上の大きさによる LOD 選択（ヒステリシス付き）
 
 /*
     SceneRenderer.h
     ----------------------------------------------------------------------------
-    ړIF
-      - u1̃JsZbg  1 RenderTargetv֕`R}hL^ŏ̕`B
-      - RootSignature/PSOiPipelineSetjƁAet[̃Abv[hCBiFrameResourcesj
-        󂯎ĕێA^ꂽ Scene `B
+    目的：
+      - 「1つのカメラ行列セット → 1枚の RenderTarget」へ描画コマンドを記録する最小の描画役。
+      - RootSignature/PSO（PipelineSet）と、各フレームのアップロードCB（FrameResources）
+        を受け取って保持し、与えられた Scene を順次描く。
 
-    zt[iĂяo=Viewports/SceneLayer ȂǁjF
+    想定フロー（呼び出し側=Viewports/SceneLayer など）：
       1) Initialize(dev, pipe, frames)
-         - gp PSO ƃt[OiCBjւ̃|C^ێ
-      2) Record(cmd, rt, cam, scene, cbBase, frameIndex, maxObjects)
-         - rt  RT Ԃ֑J  oCh/NA
-         - cam(view/proj)  Scene AGameObject/Component HăbV`
-         - 萔obt@ FrameResources  [cbBase .. cbBase+maxObjects-1] gp
-
-    ӓ_F
-      - ucbBasev͕pXœ FrameResources 𕪊p邽߂̃ItZbgB
-        jScene pX 0..N-1AGame pX N..2N-1 蓖Ă݌vB
-      - uframeIndexv̓t[ÕCfbNXiBackBufferIndex ƈvƕ₷jB
-      - Record ł PSO/RootSignature ZbgzBۂ PSO ͌Ăяoŏ㏑\B
-      - RenderTarget ́ARecord ̖` RT ւ̑J/ݒA SRV ւ̑Jڂs[eBeB
-        ĂяoiItXN[ImGui \ɔjB
+         - 使用する PSO とフレームリング（CB）へのポインタを保持し、GpuSceneBuffer を作る
+      2) Prepare(scene)（毎フレーム 1 回、全ビューの Record より前）
+         - Scene を 1 回だけ走査し、描画候補（ワールド行列/ワールド AABB）を抽出
+           （VB/IB の転送が終わっていない = GpuReady でないメッシュは候補にしない）
+         - Static なオブジェクトは BVH にまとめる（集合が変わったときだけ再構築）
+         - Dynamic なオブジェクトは DynamicAabbTree に登録（ファット AABB をはみ出したときだけ組み替え）
+         - 各候補に GpuSceneBuffer のスロットを割り当て、ワールド行列が変わったものだけ書き換える
+      2') UploadObjects(cmd)（Prepare の直後に 1 回）
+         - 書き換えたスロットを DEFAULT ヒープのオブジェクトバッファへコピーする
+      3) Record(cmd, rt, cam, vis)（ビューごと）
+         - rt を RT 状態へ遷移 → バインド/クリア
+         - Static は BVH、Dynamic は AABB ツリーを階層的に辿って視錐台と判定
+         - 判定結果はビューごとの ViewVisibilityCache に残し、カメラが動かなければ
+           動いたオブジェクトだけを判定し直す
+         - 外側なら CB も Draw も積まない
+         - 残った候補を DrawList に積んで PSO/メッシュ/奥行きのキーでソートしてから記録する
+         - 同じメッシュが続く区間は 1 回の DrawIndexedInstanced にまとめる
+           （インスタンス → スロット番号の表をパスごとに作り、区間の先頭はルート定数で渡す）
+         - 既定では区間ごとの「ルート定数 + VBV/IBV + Draw 引数」を間接引数バッファに書き、
+           pipeline ごとに ExecuteIndirect 1 回で積む（SetIndirectEnabled(false) で直接記録）
+         - 直接記録で区間が多いときは、CommandListPool から複数のリストを払い出して
+           JobSystem で並列に記録する（提出順は払い出し順なので描画順は変わらない）
+         - オクルーダ指定のメッシュがあれば、ビューごとの低解像度深度バッファへ CPU で塗り、
+           視錐台を通ったオブジェクトの AABB をそれと比べて隠れているものも捨てる
+         - メッシュレットを持つメッシュ（LOD0 で描くもの）は塊ごとに視錐台/裏向きを判定し直し、
+           残った三角形だけのインデックスを UploadRing に詰めて 1 回の DrawIndexed で描く
+         - パス定数とスロット番号の表は FrameResources の UploadRing から切り出す
+           （パス数・オブジェクト数に上限は無い。InstanceData そのものは毎パス送らない）
+
+    注意点：
+      - UploadRing の BeginFrame/EndFrame は FrameScheduler が呼ぶ。Record はその間で使うこと。
+      - Record 内で PSO/RootSignature をセットする。並列記録をすると Record の後は別のリストに
+        積むことになるので、呼び出し側は FrameResources::CommandLists().Current() を取り直すこと。
+      - Record は Prepare の結果を読むだけなので、別々の ViewVisibilityCache を渡せば
+        複数スレッドから同時に呼べる（RecordViews が Scene/Game をそうやって記録する）。
+      - RenderTarget は、Record 内の冒頭で RT への遷移/設定、末尾で SRV への遷移を行うユーティリティを
+        呼び出す（オフスクリーン→ImGui 表示に備える）。
 */
 
-// ===== ʕ`pX(1J1RT) =====
-/** Jps񑩁iLH: nzj */
+// ===== 共通描画パス(1カメラ→1RT) =====
+/** カメラ用行列束（LH: 左手系想定） */
 struct CameraMatrices
 {
-    DirectX::XMMATRIX view;  ///< View si[hr[j
-    DirectX::XMMATRIX proj;  ///< Projection sir[Nbvj
+    DirectX::XMMATRIX view;  ///< View 行列（ワールド→ビュー）
+    DirectX::XMMATRIX proj;  ///< Projection 行列（ビュー→クリップ）
+};
+
+/** Prepare で抽出した描画候補（1 フレーム内で全ビューが共有） */
+struct RenderItem
+{
+    const MeshRendererComponent* mr = nullptr; ///< 描画対象（フレーム内はシーンが所有を保証。読むだけ）
+    DirectX::XMFLOAT4X4    world{};      ///< ワールド行列
+    AABB                   worldBox;     ///< ワールド AABB（カリング用）
+    std::int32_t           proxy = DynamicAabbTree::kNull; ///< Dynamic の AABB ツリープロキシ（Static/無効 AABB は kNull）
+    std::uint32_t          slot = ObjectSlotAllocator::kInvalid; ///< GpuSceneBuffer 上の InstanceData の位置
+};
+
+/** 1 パス分の描画統計（視錐台カリングの結果） */
+struct SceneRenderStats
+{
+    unsigned visible = 0; ///< 視錐台内で実際に描いたオブジェクト（インスタンス）数
+    unsigned culled = 0;  ///< 視錐台外として捨てた数（アップロード領域も消費しない）
+    unsigned tested = 0;  ///< このフレームで視錐台判定をやり直したオブジェクト数（キャッシュ再利用分は含まない）
+    unsigned occluded = 0; ///< 視錐台内だがオクルーダに隠れていたので捨てた数
+    unsigned meshBinds = 0; ///< IASetVertexBuffers/IASetIndexBuffer を実際に呼んだ回数（ソートで同じメッシュが続けば減る）
+    unsigned drawCalls = 0; ///< DrawIndexedInstanced の回数（同じメッシュはインスタンシングで 1 回にまとまる）
+    unsigned indirectCalls = 0; ///< ExecuteIndirect の回数（drawCalls 件を pipeline ごとにまとめて発行。0 = 直接記録）
+    unsigned parallelLists = 0; ///< 直接記録を並列に分けたリストの本数（0 = 1 本のリストに直列で記録）
+    unsigned contributionCulled = 0; ///< 画面上で小さすぎるとして捨てた数（コントリビューションカリング）
+    unsigned lodReduced = 0;    ///< LOD1 以降（簡略化した段）で描いた数
+    unsigned triangles = 0;     ///< 描いた三角形の総数（選んだ LOD の三角形数 × インスタンス）
+    unsigned meshletsTested = 0; ///< メッシュレット単位で判定した塊の数
+    unsigned meshletsCulled = 0; ///< そのうち視錐台外/裏向きとして捨てた数
+};
+
+/**
+ * メッシュレットカリングの設定（SceneRenderer::SetMeshletCullSettings）
+ *  - 対象は MeshRendererComponent::GetMeshlets() を持ち、LOD0 で描くもの（簡略化した段は塊が対応しない）。
+ *  - 残った塊のインデックスはビューごとに UploadRing へ書く（CPU で詰め直す）。ほとんど残るなら
+ *    書き込みの方が高くつくので、元の IB のまま（インスタンシング可能な通常の Draw で）描く。
+ */
+struct MeshletCullSettings
+{
+    bool  enabled = true;          ///< false ならメッシュレット単位では判定しない
+    bool  frustum = true;          ///< 境界球で視錐台判定（オブジェクトが完全に内側なら省く）
+    bool  cone = true;             ///< 法線コーンで裏向き判定
+    float maxVisibleRatio = 0.9f;  ///< 残ったインデックスがこの割合を超えたら詰め直さずに元の IB で描く
+};
+
+/** メッシュレットカリングで詰め直した 1 オブジェクト分の Draw（Record の作業用） */
+struct MeshletDraw
+{
+    const RenderItem*       item = nullptr;
+    D3D12_INDEX_BUFFER_VIEW ibv{};        ///< UploadRing 上の詰め直した IB（元と同じ形式）
+    std::uint32_t           indexCount = 0;
+    float                   depth = 0.0f; ///< ビュー空間 z（手前から描く）
+};
+
+/**
+ * ビューごとの可視性キャッシュ（Viewports が Scene/Game 用に 1 つずつ保持し、Record に渡す）。
+ *  - カメラ（View*Proj）と Static BVH が前回と同じで、前フレームから続けて使われていれば
+ *    Transform/境界が変わった Dynamic だけを判定し直して可視リストを差分更新する。
+ *  - それ以外（カメラが動いた、BVH を作り直した、1 フレーム以上飛んだ）は全判定。
+ *  - 記録用の作業領域（描画リスト・区間など）もここに持つ。ビューごとに別なので、
+ *    Scene/Game の Record を別スレッドで同時に走らせても書き込み先が重ならない。
+ *  - 中身は SceneRenderer が管理する。呼び出し側は触らないこと。
+ */
+struct ViewVisibilityCache
+{
+    DirectX::XMFLOAT4X4        viewProj{};         ///< 前回判定したときの View*Proj
+    std::uint32_t              prepareFrame = 0;   ///< 前回更新した Prepare の番号
+    std::uint32_t              epoch = 0;          ///< 前回更新時の SceneRenderer 側エポック（BVH 再構築等で変わる）
+    bool                       valid = false;
+    std::vector<std::uint32_t> staticVisible;      ///< 可視な Static の ID（BVH の ID）
+    std::vector<std::int32_t>  dynamicVisible;     ///< 可視な Dynamic のプロキシ ID
+    std::vector<std::int32_t>  dynamicSlot;        ///< プロキシ ID → dynamicVisible 上の位置（-1 = 不可視）
+    OcclusionCuller            occlusion;          ///< このビューのオクルージョン深度バッファ
+    std::uint32_t              occlusionEpoch = 0; ///< 前回ラスタライズしたときのオクルーダ集合のエポック
+    std::vector<std::uint8_t>  staticLod;          ///< Static ID → 前回描いた LOD（BVH 再構築で 0 に戻す）
+    std::vector<std::uint8_t>  dynamicLod;         ///< プロキシ ID → 前回描いた LOD
+
+    // ---- Record の作業領域（中身はパスをまたいで持ち越さない。容量だけ使い回す） ----
+    std::vector<std::uint32_t>              visibleScratch; ///< BVH/ツリーのクエリ結果
+    DrawList                                drawList;       ///< 抽出結果（パスごとに作り直す）
+    std::vector<InstanceBatch>              batches;        ///< インスタンシング区間
+    std::vector<IndirectRun>                indirectRuns;   ///< ExecuteIndirect の単位
+    std::vector<ID3D12GraphicsCommandList*> chunkLists;     ///< 並列記録用に払い出したリスト
+    std::vector<SceneRenderStats>           chunkStats;     ///< 並列記録のチャンク別統計
+    std::vector<MeshletDraw>                meshletDraws;   ///< メッシュレットカリングで詰め直した Draw
+    std::vector<std::uint32_t>              meshletScratch; ///< CullMeshlets の結果（残った塊の番号）
+};
+
+/// RecordViews に渡す 1 ビュー分の入力（Viewports::BuildPasses が作る）
+struct SceneViewPass
+{
+    RenderTarget*        rt = nullptr;    ///< 出力先
+    CameraMatrices       cam{};           ///< このビューのカメラ
+    ViewVisibilityCache* vis = nullptr;   ///< このビューのキャッシュ/作業領域
+    SceneRenderStats*    stats = nullptr; ///< 結果の書き込み先
 };
 
 /**
- * @brief V[`̔t@T[hB
- *        ^ꂽ RenderTarget ɑ΂AScene  MeshRenderer ɕ`B
+ * @brief シーン描画の薄いファサード。
+ *        与えられた RenderTarget に対し、Scene 内の MeshRenderer を順に描く。
  */
 class SceneRenderer
 {
 public:
 
     /**
-     * @brief gp PipelineSet  FrameResources ֘AtB
-     * @param dev     igpB̊g RootSig ȂǂKvɂȂꍇɔێj
-     * @param pipe    [gVOl`/PSO ̃Zbg
-     * @param frames  t[OiAbv[h萔obt@R}hAP[^Qj
-     *
-     * @note  dev ͎gpĂȂAInitialize ̓C^[tF[XƂĎ󂯂ĂB
+     * @brief 使用する PipelineSet と FrameResources を関連付ける。
+     * @param dev     GpuSceneBuffer を作るデバイス（nullptr なら結線を切って解放する）
+     * @param pipe    ルートシグネチャ/PSO のセット
+     * @param frames  フレームリング（アップロード領域 UploadRing やコマンドアロケータ群）
      */
-    void Initialize(ID3D12Device* /*dev*/, const PipelineSet& pipe, FrameResources* frames)
-    {
-        m_pipe = pipe;
-        m_frames = frames;
-    }
+    void Initialize(ID3D12Device* dev, const PipelineSet& pipe, FrameResources* frames);
 
     /**
-     * @brief 1 J  1 RenderTarget ֕`R}hL^B
+     * @brief フレーム冒頭の抽出。Scene を 1 回だけ走査して描画候補を作る。
+     * @details
+     *   - Dynamic：Transform/境界のバージョンが変わったものだけ ワールド行列と AABB を計算し直し、
+     *              AABB ツリーのプロキシを MoveProxy で更新（ファット AABB 内なら据え置き）。
+     *              今フレーム見つからなかったコンポーネントのプロキシは削除する。
+     *              変化/削除されたプロキシは記録しておき、Record のキャッシュ差分更新に使う。
+     *   - Static ：集合（コンポーネント・Transform・境界のバージョン）が前回と同じなら何もしない。
+     *              変わっていれば ワールド AABB を取り直して BVH を再構築する。
+     *              静的バッチに結合済みのものは外し、代わりに結合チャンクを BVH に載せる。
+     *   - 複数ビュー（Scene/Game）の Record はこの結果を共有する。
+     */
+    void Prepare(const Scene* scene);
+
+    /**
+     * @brief Prepare で書き換えたオブジェクトデータを GPU バッファへ反映するコマンドを積む
+     * @details Prepare の後、最初の Record より前に同じコマンドリストへ 1 回だけ呼ぶ。
+     */
+    void UploadObjects(ID3D12GraphicsCommandList* cmd);
+
+    /// オブジェクトバッファの使用状況（直近の UploadObjects 時点）
+    const GpuSceneBufferStats& ObjectBufferStats() const { return m_objects.Stats(); }
+
+    /// Static オブジェクトを動かした等、次の Prepare で BVH を必ず作り直させる
+    void InvalidateStatic() { m_staticDirty = true; }
+
+    /**
+     * @brief 静的バッチ（ワールド空間に焼き込んだ結合メッシュ）を差し替える
+     * @details
+     *   - 各要素は VB/IB 作成済みの MeshRendererComponent（シーンには属さない）。
+     *     ローカル境界 = ワールド AABB として、単位行列で Static BVH に載せる。
+     *   - 結合元（IsStaticBatched() のもの）は Prepare で個別の描画候補から外す。
+     *   - 古いチャンクはここで手放されうるので、Static の描画候補と BVH もすぐに捨てる
+     *     （次の Prepare までの RaycastStatic/QueryOverlap が解放済みのチャンクを返さないように）。
+     *     次の Prepare で作り直す。空配列を渡せば解除。
+     */
+    void SetStaticBatches(std::vector<std::shared_ptr<MeshRendererComponent>> batches);
+
+    /// オクルージョンカリングの有効/無効（オクルーダが 1 つも無ければ有効でも何もしない）
+    void SetOcclusionEnabled(bool enabled) { m_occlusionEnabled = enabled; }
+    bool IsOcclusionEnabled() const { return m_occlusionEnabled; }
+
+    /// ExecuteIndirect で記録するか（コマンドシグネチャが作れなかった場合は常に直接記録）
+    void SetIndirectEnabled(bool enabled) { m_indirectEnabled = enabled; }
+    bool IsIndirectEnabled() const { return m_indirectEnabled && m_drawSignature; }
+
+    /// LOD 選択・コントリビューションカリングの設定（LOD は MeshRendererComponent::Lods を持つメッシュだけ）
+    void SetLodSettings(const LodSelectSettings& settings) { m_lod = settings; }
+    const LodSelectSettings& GetLodSettings() const { return m_lod; }
+
+    /// メッシュレットカリングの設定（メッシュレットは D3D12Renderer::BuildMeshlets 等で持たせる）
+    void SetMeshletCullSettings(const MeshletCullSettings& settings) { m_meshlet = settings; }
+    const MeshletCullSettings& GetMeshletCullSettings() const { return m_meshlet; }
+
+    /// 複数ビューを別スレッド・別リストで同時に記録するか（false なら 1 本のリストに順に記録）
+    void SetConcurrentViewsEnabled(bool enabled) { m_concurrentViews = enabled; }
+    bool IsConcurrentViewsEnabled() const { return m_concurrentViews; }
+
+    /**
+     * @brief Static オブジェクトに対するレイクエリ（ワールド AABB 単位、最も近いもの）
+     * @return ヒットしたら true（outHit と outT を設定）
+     */
+    bool RaycastStatic(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& dir, float maxT,
+        const MeshRendererComponent*& outHit, float& outT) const;
+
+    /**
+     * @brief ワールド AABB が box と重なるオブジェクトを集める（Static + Dynamic）
+     * @details 直近の Prepare 時点の位置で判定する。out は追記。
+     */
+    void QueryOverlap(const AABB& box, std::vector<const MeshRendererComponent*>& out) const;
+
+    /**
+     * @brief 1 カメラ → 1 RenderTarget へ描画コマンドを記録する。
      *
-     * @param cmd         L^R}hXgiDIRECTj
-     * @param rt          `Ώۂ RenderTargetiItXN[j
-     * @param cam         Jsiview/projj
-     * @param scene       `Ώ Scenei[gċAj
-     * @param cbBase      FrameResources ̒萔obt@Xbg̊JnItZbg
-     * @param frameIndex  t[ÕCfbNXiBackBufferIndex ɑΉj
-     * @param maxObjects  ̃pXŊmۂĂ悢 CB XbgiK[hpj
+     * @param cmd         記録先コマンドリスト（DIRECT）
+     * @param rt          描画対象の RenderTarget（オフスクリーン）
+     * @param cam         カメラ行列（view/proj）
+     * @param vis         このビューの可視性キャッシュ（ビューごとに別のものを渡す）
+     * @return            可視/カリング数（エディタの Stats 表示用）
      *
      * @details
-     *   - {\bh̒ŁF
-     *       1) rt.TransitionToRT(cmd) / Bind(cmd) / Clear(cmd) Ă
-     *       2) VP/SC/IA/RS/RootSignature ZbgAScene H MeshRenderer `
-     *       3) 萔obt@iSceneConstantBufferj FrameResources  Upload ̈ɏ
-     *       4) Ō rt.TransitionToSRV(cmd)  SRV readable ɖ߂
+     *   - 本メソッドの中で：
+     *       1) rt.TransitionToRT(cmd) / Bind(cmd) / Clear(cmd) を呼ぶ
+     *       2) VP/SC/IA/RS/RootSignature をセットし、Prepare 済みの候補を描く
+     *          （Static は BVH、Dynamic は AABB ツリーで視錐台判定。外なら CB 書き込み・Draw とも行わない）
+     *          視錐台を通ったものはオクルーダの深度と比べ、隠れていれば同様に捨てる
+     *          画面上の大きさで LOD を選ぶ（小さすぎるものはコントリビューションカリングで捨てる）
+     *          LOD0 のメッシュレット持ちは塊ごとに判定し、残りを詰めた IB で別に描く（インスタンシングしない）
+     *       3) パス定数（PassConstants）とスロット番号の表を UploadRing から切り出して書き込み、
+     *          同じメッシュの連続区間ごとにルート定数（表の先頭）を変えて DrawIndexedInstanced を 1 回積む
+     *          （間接記録が有効なら区間を間接引数レコードにして ExecuteIndirect でまとめて積む）
+     *          （直接記録で区間が kMinBatchesPerList × 2 以上あれば、ワーカー数ぶんのリストに分けて並列に積む）
+     *       4) 最後に rt.TransitionToSRV で SRV readable に戻す（並列記録をした場合は後ろに続く新しいリストへ）
+     *
+     *   - 戻った後の記録先は CommandListPool::Current()（cmd のままとは限らない）。
      *
-     *   - cbBase  maxObjects ɂA1t[ŕpXiScene/Game j
-     *      FrameResources ȂgB
+     *   - 領域はパスごとに切り出すので、1フレーム内で複数パス（Scene/Game 等）が干渉しない。
      */
-    void Record(ID3D12GraphicsCommandList* cmd,
+    SceneRenderStats Record(ID3D12GraphicsCommandList* cmd,
         RenderTarget& rt,
         const CameraMatrices& cam,
-        const Scene* scene,
-        UINT cbBase,
-        UINT frameIndex,
-        UINT maxObjects);
+        ViewVisibilityCache& vis);
+
+    /**
+     * @brief 複数ビュー（Scene/Game）をまとめて記録する。Prepare/UploadObjects の結果は全ビューで共有
+     * @param cmd    今の記録先（UploadObjects のコピーを積んだリスト）
+     * @param views  ビューごとの入力（stats に結果を書く）
+     * @details
+     *   - 2 ビュー以上なら CommandListPool からビューごとにリストを払い出し、JobSystem で
+     *     Record を同時に走らせる。提出順は cmd → ビュー順 → 後続のリストなので、
+     *     オブジェクトバッファのコピーは全ビューの描画より前に実行される。
+     *   - アップロード領域（パス定数/スロット表/間接引数）は UploadRing からそれぞれ切り出すので重ならない。
+     *   - 戻った後の記録先は FrameResources::CommandLists().Current()（後続用に新しいリストを払い出す）。
+     */
+    void RecordViews(ID3D12GraphicsCommandList* cmd, const SceneViewPass* views, std::size_t count);
 
 private:
-    PipelineSet     m_pipe{};        ///< [gVOl`/PSOiLambert j
-    FrameResources* m_frames = nullptr; ///< t[OiUpload CB/R}hAP[^j
+    // vis の可視リストを全判定 or 差分で更新する（Record から呼ぶ）
+    void UpdateVisibility(ViewVisibilityCache& vis, const Frustum& frustum,
+        DirectX::FXMMATRIX viewProj, SceneRenderStats& stats);
+
+    // vis のオクルージョン深度バッファを必要なら塗り直す（カメラかオクルーダが変わったときだけ）
+    void UpdateOcclusion(ViewVisibilityCache& vis, DirectX::FXMMATRIX viewProj);
+
+    // スロットを返して item.slot を無効にする
+    void ReleaseSlot(RenderItem& item);
+
+    PipelineSet     m_pipe{};        ///< ルートシグネチャ/PSO（Lambert 等）
+    FrameResources* m_frames = nullptr; ///< フレームリング（Upload CB/コマンドアロケータ等）
+    GpuSceneBuffer  m_objects;          ///< 全描画候補の InstanceData（スロットで引く。動いたものだけ送る）
+    Microsoft::WRL::ComPtr<ID3D12CommandSignature> m_drawSignature; ///< IndirectDrawCommand 用
+    bool            m_indirectEnabled = true;
+    bool            m_concurrentViews = true;
+    LodSelectSettings m_lod;
+    MeshletCullSettings m_meshlet;
+    std::vector<ID3D12GraphicsCommandList*> m_viewLists; ///< RecordViews でビューごとに払い出したリスト（作業用）
+
+    // ---- Prepare の結果（フレーム内で共有） ----
+    std::vector<RenderItem> m_dynamic; ///< 動くオブジェクト（毎フレーム作り直し）
+    std::vector<RenderItem> m_static;  ///< Static オブジェクト（BVH の ID = 添字）
+    StaticBvh               m_staticBvh;
+
+    // Static 集合の同一性判定用キー（weak_ptr で ABA を避ける）
+    struct StaticKey
+    {
+        std::weak_ptr<MeshRendererComponent> mr;
+        std::uint32_t                        transformVersion = 0;
+        std::uint32_t                        boundsVersion = 0;
+    };
+    std::vector<std::shared_ptr<MeshRendererComponent>> m_staticBatches; ///< 静的バッチのチャンク（単位行列で描く）
+    std::vector<StaticKey> m_staticKeys; ///< 前回 BVH を作ったときの集合
+    std::vector<StaticKey> m_staticScan; ///< 今フレームの走査結果（作業用）
+    bool                   m_staticDirty = true;
+    std::size_t            m_staticBatchesReady = 0; ///< 前回 BVH に載せた静的バッチのチャンク数（転送完了分）
+
+    // Dynamic のプロキシ管理（コンポーネント → AABB ツリーのプロキシ）
+    struct DynamicProxy
+    {
+        std::weak_ptr<MeshRendererComponent> mr;       ///< 同じアドレスの別オブジェクトと区別する
+        std::int32_t                         proxy = DynamicAabbTree::kNull;
+        DirectX::XMFLOAT3                    center{}; ///< 前回のワールド AABB 中心（移動量の算出用）
+        std::uint32_t                        seenFrame = 0; ///< 0 = 今回初めて見た
+        std::uint32_t                        transformVersion = 0;
+        std::uint32_t                        boundsVersion = 0;
+        DirectX::XMFLOAT4X4                  world{};  ///< バージョンが変わるまで使い回す
+        AABB                                 worldBox;
+        std::uint32_t                        slot = ObjectSlotAllocator::kInvalid; ///< GpuSceneBuffer のスロット
+    };
+    DynamicAabbTree m_dynamicTree;
+    std::unordered_map<const MeshRendererComponent*, DynamicProxy> m_dynamicProxies;
+    std::vector<std::uint32_t> m_dynamicUnbounded; ///< AABB が無効でツリーに入れられない Dynamic（常に描く）
+    std::uint32_t              m_prepareFrame = 0;
+    std::vector<std::int32_t>  m_dynamicChanged;   ///< 今回の Prepare で作成/移動したプロキシ
+    std::vector<std::int32_t>  m_dynamicRemoved;   ///< 今回の Prepare で削除したプロキシ
+    std::uint32_t              m_visibilityEpoch = 1; ///< Static BVH の再構築/全消去で進める（キャッシュ全無効化）
+
+    std::vector<GameObject*>   m_visitStack;     ///< Prepare の階層走査用スタック（作業用）
+
+    /// 並列記録に分けるときの 1 リストあたりの最小区間数（少ないと状態の積み直しの方が高くつく）
+    static constexpr std::size_t kMinBatchesPerList = 64;
+
+    // オクルーダ（Static/Dynamic を問わず IsOccluder() のもの。毎フレーム作り直し）
+    struct OccluderKey
+    {
+        const MeshRendererComponent* mr = nullptr;
+        std::uint32_t                transformVersion = 0;
+        std::uint32_t                boundsVersion = 0;
+    };
+    std::vector<RenderItem>  m_occluders;
+    std::vector<OccluderKey> m_occluderKeys;   ///< 前回の集合（変化検出用）
+    std::vector<OccluderKey> m_occluderScan;   ///< 今フレームの走査結果（作業用）
+    std::uint32_t            m_occluderEpoch = 1; ///< オクルーダ集合/位置/形が変わるたびに進める
+    bool                     m_occlusionEnabled = true;
 };
@@ -19,40 +19,40 @@ using namespace DirectX;
 /*
     Viewports
     ----------------------------------------------------------------------------
-    F
-      - Scene p / Game p̃ItXN[ RenderTarget Ǘi/Đ/ڏj
-      - ImGui ֕\邽߂ SRV (ImTextureID) 
-      - UI ́u]TCYvqXeVXtŎ󂯎A RT č쐬
-      - Scene  Game ̓eEr[̏iGame ͌ŒJAScene ͓sxj
-
-    dvȃ|V[F
-      - TCÝuvł͂Ȃu莞Ԃ𒴂mv(foEXj
-      - č쐬AÂ RT  Detach ČĂяo GpuGarbageQueue ցixjj
-      - SRV  ImGuiLayer ̃q[vɍiDX12  ImTextureID = GPUSRVnhj
-      - Scene  g FOV Œh ŃAXyNgǏ]iMakeProjConstHFovj
-
-    悭闎ƂF
-      - ImGui ̕\̈悪ɗh  t RT Đ  ja/JN
-         StepSnap + 莞臒lŊɘa
-      - Detach Â RT 𑦔jĂ܂ GPU gpNbV
-         K GpuGarbageQueue  fence lƂƂɓo^iĂяo̐Ӗj
+    役割：
+      - Scene 用 / Game 用のオフスクリーン RenderTarget を管理（生成/再生成/解放移譲）
+      - ImGui へ表示するための SRV (ImTextureID) を供給
+      - UI 側の「希望サイズ」をヒステリシス付きで受け取り、安定後に RT を再作成
+      - Scene と Game の投影・ビューの初期同期（Game は固定カメラ、Scene は都度）
+
+    重要なポリシー：
+      - リサイズは「即時」ではなく「安定時間を超えたら確定」(デバウンス）
+      - 再作成時、古い RT は Detach して呼び出し側の GpuGarbageQueue へ（遅延破棄）
+      - SRV は ImGuiLayer 側のヒープに作る（DX12 の ImTextureID = GPU可視SRVハンドル）
+      - Scene は “横 FOV 固定” でアスペクト追従（MakeProjConstHFov）
+
+    よくある落とし穴：
+      - ImGui の表示領域が高速に揺れる → 毎フレで RT 再生成 → 破棄渋滞/カクつき
+        → StepSnap + 安定時間閾値で緩和
+      - Detach した古い RT を即破棄してしまい GPU 使用中クラッシュ
+        → 必ず GpuGarbageQueue に fence 値とともに登録（呼び出し側の責務）
 */
 
 // =============================================================================
-// Game pFeč\zwp[igGame ̊ehČvZj
-//   - : FOViConst H-FOVj newAspect ɍ킹ďcFOV𒲐
-//   - : iConst Widthj newAspect ɍ킹č𒲐
+// Game 用：投影再構築ヘルパー（“Game の基準投影”から再計算する）
+//   - 透視: 水平FOV一定（Const H-FOV）で newAspect に合わせて縦FOVを調整
+//   - 直交: 横幅一定（Const Width）で newAspect に合わせて高さを調整
 // =============================================================================
 
-// /̊ȈՔiD3D W`F _34  0A 0j
+// 透視/直交の簡易判定（D3D 標準形：透視は _34 ≠ 0、直交は 0）
 static inline bool VP_IsPerspective(const XMFLOAT4X4& M) {
     return std::fabs(M._34) > 1e-6f;
 }
 
-// FFOV newAspect ɍ킹čč\z
+// 透視：水平FOV一定で newAspect に合わせて再構築
 static inline XMMATRIX VP_RebuildPerspConstHFov(const XMFLOAT4X4& base, float newAspect)
 {
-    // near/far oinj
+    // near/far 抽出（左手系透視）
     const float A = base._33;  // far/(far - near)
     const float B = base._43;  // -near*far/(far - near)
     const float nearZ = -B / A;
@@ -66,16 +66,16 @@ static inline XMMATRIX VP_RebuildPerspConstHFov(const XMFLOAT4X4& base, float ne
     return XMMatrixPerspectiveFovLH(vFovNew, newAspect, nearZ, farZ);
 }
 
-// F newAspect ɍ킹ďcč\z
+// 直交：横幅一定で newAspect に合わせて縦幅を再構築
 static inline XMMATRIX VP_RebuildOrthoConstWidth(const XMFLOAT4X4& base, float newAspect)
 {
-    // ̕W`Fm00 = 2/width, m11 = 2/height
+    // 直交の標準形：m00 = 2/width, m11 = 2/height
     const float width = 2.0f / base._11;
     const float height0 = 2.0f / base._22;
 
     const float height = (newAspect > 1e-6f) ? (width / newAspect) : height0;
 
-    // ߉Fm22 = 1/(far-near), m43 = -near/(far-near)
+    // 近遠：m22 = 1/(far-near), m43 = -near/(far-near)
     const float m22 = base._33;
     const float m43 = base._43;
     const float nearZ = -m43 / m22;
@@ -90,8 +90,8 @@ static inline XMMATRIX VP_RebuildOrthoConstWidth(const XMFLOAT4X4& base, float n
 }
 
 // ----------------------------------------------------------------------------
-// FScene/Game  RT EBhETCYō쐬
-//   \傫߂ɍĂƁAg厞̈ꎞIȂڂ₯₷
+// 初期化：Scene/Game の RT をウィンドウ初期サイズで作成
+//   初期を十分大きめに作っておくと、拡大時の一時的なぼやけを避けやすい
 // ----------------------------------------------------------------------------
 void Viewports::Initialize(ID3D12Device* dev, unsigned w, unsigned h)
 {
@@ -116,21 +116,21 @@ void Viewports::Initialize(ID3D12Device* dev, unsigned w, unsigned h)
         m_game.Create(dev, g);
     }
 
-    // Scene ̓J̓euLv`Ov
+    // Scene 初回はカメラの投影を「キャプチャ前」
     m_sceneProjCaptured = false;
 
-    // Game ́uScene Ɠ܂v
+    // Game は「Scene と同期がまだ」状態
     m_gameFrozen = false;
 
-    // TCYfoEX̓ԂZbg
+    // リサイズデバウンスの内部状態をリセット
     m_desiredW = m_desiredH = 0;
     m_desiredStableTime = 0.0f;
     m_pendingW = m_pendingH = 0;
 }
 
 // ----------------------------------------------------------------------------
-// ImGui ֓nieNX`IDƎRTTCYj EditorContext ɓ]L
-//   - sceneSrvBase/gameSrvBase + frameIndex  SRV XbgՓ˂
+// ImGui へ渡す情報（テクスチャIDと実RTサイズ）を EditorContext に転記
+//   - sceneSrvBase/gameSrvBase + frameIndex で SRV スロット衝突を回避
 // ----------------------------------------------------------------------------
 void Viewports::FeedToUI(EditorContext& ctx, ImGuiLayer* imgui,
     unsigned frameIndex, unsigned sceneSrvBase, unsigned gameSrvBase)
@@ -150,27 +150,27 @@ void Viewports::FeedToUI(EditorContext& ctx, ImGuiLayer* imgui,
 }
 
 // ----------------------------------------------------------------------------
-// UI nuScene EBhE̗p\TCYv󂯎A
-//  - StepSnapiݕω}j
-//  - ieNX`݊EsNZ}j
-//  - 莞Ԃ𒴂 pending Ɋm
+// UI 側から渡される「Scene ウィンドウの利用可能サイズ」を受け取り、
+//  - StepSnap（小刻み変化抑制）
+//  - 偶数化（テクスチャ互換・ピクセルずれ抑制）
+//  - 安定時間が一定を超えたら pending に確定
 // ----------------------------------------------------------------------------
 void Viewports::RequestSceneResize(unsigned w, unsigned h, float dt)
 {
     if (w == 0 || h == 0) return;
 
-    // 1) XebvXibvihbO̔ωōĐȂj
+    // 1) ステップスナップ（ドラッグ中の微小変化で再生成しない）
     constexpr unsigned kStep = 8;
     auto StepSnap = [](unsigned v, unsigned step) {
         if (step == 0) return v;
         return (unsigned)(((v + step / 2) / step) * step);
         };
-    auto Even = [](unsigned v) { return (v + 1u) & ~1u; }; // 
+    auto Even = [](unsigned v) { return (v + 1u) & ~1u; }; // 偶数化
 
     unsigned wantW = Even(StepSnap(w, kStep));
     unsigned wantH = Even(StepSnap(h, kStep));
 
-    // 2) ڕWς莞ԂZbg
+    // 2) 目標が変わったら安定時間をリセット
     if (wantW != m_desiredW || wantH != m_desiredH) {
         m_desiredW = wantW;
         m_desiredH = wantH;
@@ -178,42 +178,42 @@ void Viewports::RequestSceneResize(unsigned w, unsigned h, float dt)
         return;
     }
 
-    // 3) ڕWpԂώZ
+    // 3) 同じ目標が継続した時間を積算
     if (dt > 0.0f) m_desiredStableTime += dt;
 
-    // 4) 莞ԃuȂ pending Ɋm
-    constexpr float kStableSec = 0.12f; // 0.08`0.20 Œ
+    // 4) 一定時間ブレなかったら pending に確定
+    constexpr float kStableSec = 0.12f; // 0.08～0.20 で調整可
     if (m_desiredStableTime >= kStableSec) {
-        // ɓTCYȂ noop
+        // 既に同サイズなら noop
         if (m_desiredW != m_scene.Width() || m_desiredH != m_scene.Height()) {
             m_pendingW = m_desiredW;
             m_pendingH = m_desiredH;
         }
-        // ɔăZbg
+        // 次回に備えてリセット
         m_desiredW = m_desiredH = 0;
         m_desiredStableTime = 0.0f;
     }
 }
 
 // ----------------------------------------------------------------------------
-// yfBOꂽTCYΓKp
-//   - V RT 쐬
-//   - Â RT  Detach  1 ߂i2 ڂ m_carryOverDead Ƀv[j
-//   - ĂяoiRendererj͖߂lt[ EndFrame Œxjo^
-//   - Game ̌iViewj͕ێAeiProjĵ݁gGame ̊hč\z
+// ペンディングされたリサイズがあれば適用
+//   - 新しい RT を作成
+//   - 古い RT は Detach して 1 個だけ戻す（2 個目は m_carryOverDead にプール）
+//   - 呼び出し側（Renderer）は戻り値を今フレームの EndFrame で遅延破棄登録
+//   - ★Game の向き（View）は保持し、投影（Proj）のみ“Game の基準”から再構築★
 // ----------------------------------------------------------------------------
 RenderTargetHandles Viewports::ApplyPendingResizeIfNeeded(ID3D12Device* dev)
 {
-    RenderTargetHandles toDispose{}; // t[ EndFrame ɓniő1j
+    RenderTargetHandles toDispose{}; // 今フレームの EndFrame に渡す分（最大1個）
     if (m_pendingW == 0 || m_pendingH == 0) return toDispose;
 
     const bool needScene = (m_pendingW != m_scene.Width() || m_pendingH != m_scene.Height());
     const bool needGame = (m_pendingW != m_game.Width() || m_pendingH != m_game.Height());
 
-    // K Detachi Release ͂ȂjGPU ŎgĂ\邽
+    // 旧を必ず Detach（即 Release はしない）※GPU で使っている可能性があるため
     if (needScene) {
         RenderTargetHandles old = m_scene.Detach();
-        // 1ڂ͍t[ցA2ڂ͎z
+        // 1個目は今フレームへ、2個目は持ち越し
         if (!toDispose.color && !toDispose.depth && !toDispose.rtvHeap && !toDispose.dsvHeap) {
             toDispose = std::move(old);
         }
@@ -233,7 +233,7 @@ RenderTargetHandles Viewports::ApplyPendingResizeIfNeeded(ID3D12Device* dev)
         }
     }
 
-    // VK쐬iScene / Game Ƃj
+    // 新規作成（Scene / Game とも）
     if (needScene) {
         RenderTargetDesc s{};
         s.width = m_pendingW; s.height = m_pendingH;
@@ -242,7 +242,7 @@ RenderTargetHandles Viewports::ApplyPendingResizeIfNeeded(ID3D12Device* dev)
         s.clearColor[0] = 0.10f; s.clearColor[1] = 0.10f; s.clearColor[2] = 0.10f; s.clearColor[3] = 1.0f;
         s.clearDepth = 1.0f;
         m_scene.Create(dev, s);
-        m_sceneProjCaptured = false; // e蒼iAXyNgωɑΉj
+        m_sceneProjCaptured = false; // 投影基準を取り直す（アスペクト変化に対応）
     }
     if (needGame) {
         RenderTargetDesc g{};
@@ -253,22 +253,22 @@ RenderTargetHandles Viewports::ApplyPendingResizeIfNeeded(ID3D12Device* dev)
         g.clearDepth = 1.0f;
         m_game.Create(dev, g);
 
-        // (View)͈ێBe(Proj)̂݁gGame ̊ehč\zB
+        // ★向き(View)は維持。投影(Proj)のみ“Game の基準投影”から再構築する。
         if (m_game.Width() > 0 && m_game.Height() > 0) {
             const float gaspect = float(m_game.Width()) / float(m_game.Height());
 
-            // č\z̊ƂȂ铊es
+            // 再構築の基準となる投影行列
             XMFLOAT4X4 base{};
             if (m_gameFrozen) {
-                // ɏ񓯊ς  Game g̊egidvFScene ɈȂj
+                // 既に初回同期済み → Game 自身の基準投影を使う（←重要：Scene に引っ張らない）
                 base = m_gameProjInit;
             }
             else if (m_sceneProjCaptured) {
-                // ܂OȂbI Scene ̓egî݁j
+                // まだ同期前なら暫定的に Scene の投影を使う（初回のみ）
                 base = m_sceneProjInit;
             }
             else {
-                // ŏItH[obNli60x, 0.1-1000j
+                // 最終フォールバック値（60度, 0.1-1000）
                 XMStoreFloat4x4(&base,
                     XMMatrixPerspectiveFovLH(XMConvertToRadians(60.0f), gaspect, 0.1f, 1000.0f));
             }
@@ -278,88 +278,82 @@ RenderTargetHandles Viewports::ApplyPendingResizeIfNeeded(ID3D12Device* dev)
                 : VP_RebuildOrthoConstWidth(base, gaspect);
             XMStoreFloat4x4(&m_gameProjInit, P);
         }
-        // m_gameFrozen ͐GȂi= View ͌Œ̂܂܁j
+        // m_gameFrozen は触らない（= View は固定のまま）
     }
 
-    // ς
+    // 消費済み
     m_pendingW = m_pendingH = 0;
-    return toDispose; //  EndFrame ɓn͍̂ő1i2ڂ͓zj
+    return toDispose; // ★ EndFrame に渡すのは最大1個（2個目は内部持ち越し）
 }
 
 // ----------------------------------------------------------------------------
-// Scene `i FOV ŒŃAXyNgǏ]j
-//   - ɃJ̓eLv`ij
-//   - ݂ RT AXyNgɍ킹ďc FOV ČvZ
-//   - `AGame ̏񓯊iŒJ̎d݁j
+// パスの組み立て（記録は SceneRenderer::RecordViews が Scene/Game を同時に行う）
+//   Scene：横 FOV 固定でアスペクト追従
+//     - 初回にカメラの投影をキャプチャ（基準）
+//     - 現在の RT アスペクトに合わせて縦 FOV を再計算
+//     - Game の初回同期（固定カメラの仕込み）。Game のパスより先に行うので初回から同じフレームで描ける
+//   Game ：固定カメラ（最初に Scene と同期した View/Proj を使用）
 // ----------------------------------------------------------------------------
-void Viewports::RenderScene(ID3D12GraphicsCommandList* cmd, SceneRenderer& sr,
-    const CameraComponent* cam, const Scene* scene,
-    unsigned frameIndex, unsigned maxObjects)
+std::size_t Viewports::BuildPasses(const CameraComponent* cam, SceneViewPass (&out)[kMaxPasses])
 {
-    if (!m_scene.Color() || !cam) return;
+    m_sceneStats = {};
+    m_gameStats = {};
+    std::size_t n = 0;
+
+    if (m_scene.Color() && cam) {
+        // 投影の基準（初回のみキャプチャ）
+        if (!m_sceneProjCaptured) {
+            XMStoreFloat4x4(&m_sceneProjInit, cam->GetProjectionMatrix());
+            m_sceneProjCaptured = true;
+        }
 
-    // e̊î݃Lv`j
-    if (!m_sceneProjCaptured) {
-        XMStoreFloat4x4(&m_sceneProjInit, cam->GetProjectionMatrix());
-        m_sceneProjCaptured = true;
-    }
+        // 現在のアスペクト
+        const float aspect = (m_scene.Height() > 0)
+            ? float(m_scene.Width()) / float(m_scene.Height())
+            : 1.0f;
 
-    // ݂̃AXyNg
-    const float aspect = (m_scene.Height() > 0)
-        ? float(m_scene.Width()) / float(m_scene.Height())
-        : 1.0f;
-
-    // FOVŒŏcFOVČvZes
-    const XMMATRIX proj = MakeProjConstHFov(XMLoadFloat4x4(&m_sceneProjInit), aspect);
-    CameraMatrices C{ cam->GetViewMatrix(), proj };
-
-    // Scene _OicbBase=0..maxObjects-1j
-    sr.Record(cmd, m_scene, C, scene, /*cbBase=*/0, frameIndex, maxObjects);
-
-    // --- Game ̏񓯊i1񂾂j ---
-    if (!m_gameFrozen && m_game.Width() > 0 && m_game.Height() > 0) {
-        const float gaspect = float(m_game.Width()) / float(m_game.Height());
-        const XMMATRIX gproj = MakeProjConstHFov(XMLoadFloat4x4(&m_sceneProjInit), gaspect);
-        XMStoreFloat4x4(&m_gameViewInit, cam->GetViewMatrix());
-        XMStoreFloat4x4(&m_gameProjInit, gproj);
-        m_gameFrozen = true; // ȍ~ Game ͌ŒJŕ`iView ͌ŒAProj ̓AXyNgǏ]j
-    }
-}
+        // 横FOV固定で縦FOVを再計算した投影行列
+        const XMMATRIX proj = MakeProjConstHFov(XMLoadFloat4x4(&m_sceneProjInit), aspect);
+        out[n++] = { &m_scene, CameraMatrices{ cam->GetViewMatrix(), proj }, &m_sceneVis, &m_sceneStats };
 
-// ----------------------------------------------------------------------------
-// Game `iŒJFŏ Scene Ɠ View/Proj gpj
-//   - cbBase=maxObjects..(2*maxObjects-1) gO SceneRenderer ɓn
-// ----------------------------------------------------------------------------
-void Viewports::RenderGame(ID3D12GraphicsCommandList* cmd, SceneRenderer& sr,
-    const Scene* scene, unsigned frameIndex, unsigned maxObjects)
-{
-    if (!m_gameFrozen || !m_game.Color()) return;
+        // --- Game の初回同期（1回だけ） ---
+        if (!m_gameFrozen && m_game.Width() > 0 && m_game.Height() > 0) {
+            const float gaspect = float(m_game.Width()) / float(m_game.Height());
+            const XMMATRIX gproj = MakeProjConstHFov(XMLoadFloat4x4(&m_sceneProjInit), gaspect);
+            XMStoreFloat4x4(&m_gameViewInit, cam->GetViewMatrix());
+            XMStoreFloat4x4(&m_gameProjInit, gproj);
+            m_gameFrozen = true; // 以降 Game は固定カメラで描く（View は固定、Proj はアスペクト追従）
+        }
+    }
 
-    CameraMatrices C{
-        XMLoadFloat4x4(&m_gameViewInit),
-        XMLoadFloat4x4(&m_gameProjInit)
-    };
-    sr.Record(cmd, m_game, C, scene, /*cbBase=*/maxObjects, frameIndex, maxObjects);
+    if (m_gameFrozen && m_game.Color()) {
+        CameraMatrices C{
+            XMLoadFloat4x4(&m_gameViewInit),
+            XMLoadFloat4x4(&m_gameProjInit)
+        };
+        out[n++] = { &m_game, C, &m_gameVis, &m_gameStats };
+    }
+    return n;
 }
 
 // ----------------------------------------------------------------------------
 // MakeProjConstHFov
-// ړIF̓e P0  near/far  gFOVh ۂ܂܁AVAXyNg newAspect 
-//       cFOV ČvZesԂB
-// wFm00 = 1 / (tan(vFov/2) * aspect)  1/m00 = tan(vFov/2) * aspect = tan(hFov/2)
-//        tan(hFov/2) = 1/m00BnewAspect ς tan(vFov/2)=tan(hFov/2)/newAspectB
+// 目的：元の投影 P0 から near/far と “横FOV” を保ったまま、新しいアスペクト newAspect の
+//       縦FOV を再計算した透視投影行列を返す。
+// 数学：m00 = 1 / (tan(vFov/2) * aspect) → 1/m00 = tan(vFov/2) * aspect = tan(hFov/2)
+//       よって tan(hFov/2) = 1/m00。newAspect が変わったら tan(vFov/2)=tan(hFov/2)/newAspect。
 // ----------------------------------------------------------------------------
 XMMATRIX Viewports::MakeProjConstHFov(XMMATRIX P0, float newAspect)
 {
     XMFLOAT4X4 M; XMStoreFloat4x4(&M, P0);
 
-    // ߉s񂩂璊oinëʌ`j
+    // 近遠を元行列から抽出（左手系透視投影の一般形）
     const float A = M._33;  // far/(far - near)
     const float B = M._43;  // -near*far/(far - near)
     const float nearZ = -B / A;
     const float farZ = (A * nearZ) / (A - 1.0f);
 
-    //  FOV ςɏc FOV ČvZ
+    // 横 FOV を変えずに縦 FOV を再計算
     const float tanHalfH = 1.0f / M._11;         // = tan(hFov/2)
     const float tanHalfV = tanHalfH / newAspect; // = tan(vFov/2)
     const float vFovNew = 2.0f * std::atan(tanHalfV);
@@ -368,7 +362,7 @@ XMMATRIX Viewports::MakeProjConstHFov(XMMATRIX P0, float newAspect)
 }
 
 // ----------------------------------------------------------------------------
-// ANZXnFRT ݂Ȃꍇ 0 ԂiSj
+// アクセス系：RT が存在しない場合は 0 を返す（安全側）
 // ----------------------------------------------------------------------------
 unsigned Viewports::SceneWidth()  const noexcept { return m_scene.Color() ? m_scene.Width() : 0; }
 unsigned Viewports::SceneHeight() const noexcept { return m_scene.Color() ? m_scene.Height() : 0; }
@@ -1,8 +1,10 @@
 // Renderer/Viewports.h
 #pragma once
 #include <DirectXMath.h>
+#include <cstddef>
 #include <utility>             // std::move
 #include "Core/RenderTarget.h" // RenderTarget / RenderTargetHandles
+#include "Renderer/SceneRenderer.h" // SceneRenderStats / SceneViewPass
 
 // fwd
 struct ID3D12Device;
@@ -16,95 +18,106 @@ struct  EditorContext;
 /*
     Viewports
     ----------------------------------------------------------------------------
-    F
-      - Scene / Game p̃ItXN[ RenderTarget ǗiEĐEڏj
-      - ImGui ֕\邽߂ SRV (ImTextureID) 
-      - UI ́u]TCYv󂯎A\Ɉ肵Ɣfłč쐬ifoEXj
-      - Scene ͓sxJsgpAGame ́uŏ Scene ƓŒ View/Projvgp
-
-    L[݌vF
-      - RequestSceneResize() Łu]TCYv󂯎A莞ԁikRequiredStableTimej
-        ϓ ApplyPendingResizeIfNeeded() ŎTCYɔf
-      - č쐬AÂ RT  Detach() ŃpbP[WĕԂiGPU ɒxjj
-        * t[ 2 ȏ̌Â RT ꍇ m_carryOverDead Ƀv[
-      - Game ̃J́uView=Œ / Proj=AXyNgɉčXVv̕j
-        * ̂ Scene ̃JpƁg FOV ۂehœ
+    役割：
+      - Scene / Game 用のオフスクリーン RenderTarget を管理（生成・再生成・解放移譲）
+      - ImGui へ表示するための SRV (ImTextureID) を供給
+      - UI 側の「希望サイズ」を受け取り、十分に安定したと判断できた時だけ再作成（デバウンス）
+      - Scene は都度カメラ行列を使用、Game は「最初に Scene と同期した固定 View/Proj」を使用
+
+    キー設計：
+      - RequestSceneResize() で「希望サイズ」を受け取り、一定時間（kRequiredStableTime）
+        変動が無ければ ApplyPendingResizeIfNeeded() で実サイズに反映
+      - 再作成時、古い RT は Detach() でパッケージ化して返す（GPU 完了後に遅延破棄）
+        * 同一フレームに 2 つ以上の古い RT が発生した場合は m_carryOverDead にプール
+      - Game のカメラは「View=固定 / Proj=アスペクトに応じて更新」の方針
+        * 初回のみ Scene のカメラ姿勢と“横 FOV を保つ投影”で同期
 */
 
 class Viewports {
 public:
-    // FScene/Game  RT  (w,h) ō쐬
+    // 初期化：Scene/Game の RT を (w,h) で作成
     void Initialize(ID3D12Device* dev, unsigned w, unsigned h);
 
-    // ImGui  SRV AEditorContext ɎRTTCY𔽉f
+    // ImGui へ SRV を供給し、EditorContext に実RTサイズ等を反映
     void FeedToUI(EditorContext& ctx, ImGuiLayer* imgui,
         unsigned frameIndex, unsigned sceneSrvBase, unsigned gameSrvBase);
 
-    // UI nꂽ Scene EBhÉup\TCYv󂯎AfoEXɉ
+    // UI から渡された Scene ウィンドウの「利用可能サイズ」を受け取り、デバウンス処理に回す
     void RequestSceneResize(unsigned w, unsigned h, float dt);
 
-    // yfBOĂTCY𑦎Kp
-    //  - V RT 쐬
-    //  - Â RT  Detach() Ė߂iő1j
-    //  - 2ڂ͓ m_carryOverDead ֎z
+    // ペンディングされていたリサイズを即時適用
+    //  - 新しい RT を作成
+    //  - 古い RT を Detach() して戻す（最大1個）
+    //  - 2個目は内部の m_carryOverDead へ持ち越し
     RenderTargetHandles ApplyPendingResizeIfNeeded(ID3D12Device* dev);
 
-    // ́gz[h󂯎AĂяoiFrameScheduler::EndFrame jŒxjo^
+    // 内部の“持ち越し死骸”を受け取り、呼び出し側（FrameScheduler::EndFrame 等）で遅延破棄登録する
     RenderTargetHandles TakeCarryOverDead() {
         RenderTargetHandles out = std::move(m_carryOverDead);
         m_carryOverDead = {};
         return out;
     }
 
-    // Scene pX̋L^iScene JɊÂAFOVŒŏcFOVČvZj
-    void RenderScene(ID3D12GraphicsCommandList* cmd, SceneRenderer& sr,
-        const CameraComponent* cam, const Scene* scene,
-        unsigned frameIndex, unsigned maxObjects);
+    // 今フレームに描くパスを組み立てる（記録はしない。SceneRenderer::RecordViews に渡す）
+    //  - Scene：Scene カメラに基づき、横FOV固定で縦FOVを再計算
+    //  - Game ：最初に Scene と同期した固定 View/Proj を使う（初回同期もここで行う）
+    //  - RT が無い/カメラが無いビューは含めない（統計は 0 に戻す）
+    //  - 戻り値は out に書いた数（最大 kMaxPasses）
+    static constexpr std::size_t kMaxPasses = 2;
+    std::size_t BuildPasses(const CameraComponent* cam, SceneViewPass (&out)[kMaxPasses]);
 
-    // Game pX̋L^iŏ Scene ƓŒ View/Proj gj
-    void RenderGame(ID3D12GraphicsCommandList* cmd, SceneRenderer& sr,
-        const Scene* scene, unsigned frameIndex, unsigned maxObjects);
-
-    // eF̓e P0  near/far Ɓg FOVhۂAnewAspect ɍ킹ďc FOV ČvZ
+    // 透視投影：元の投影 P0 の near/far と“横 FOV”を保ちつつ、newAspect に合わせて縦 FOV を再計算
     static DirectX::XMMATRIX MakeProjConstHFov(DirectX::XMMATRIX P0, float newAspect);
 
-    //  RT TCYiRT쐬Ȃ 0j
+    // 実 RT サイズ（RTが未作成なら 0）
     unsigned SceneWidth()  const noexcept;
     unsigned SceneHeight() const noexcept;
     unsigned GameWidth()   const noexcept;
     unsigned GameHeight()  const noexcept;
 
-    // ڃANZXKvȏꍇ̎QƁiImGui SRV 쐬Ȃǁj
+    // 直接アクセスが必要な場合の参照（ImGui SRV 作成など）
     RenderTarget& SceneRT() { return m_scene; }
     RenderTarget& GameRT() { return m_game; }
 
+    // 直近フレームの描画統計（視錐台カリングの可視/カリング数）
+    const SceneRenderStats& SceneStats() const noexcept { return m_sceneStats; }
+    const SceneRenderStats& GameStats()  const noexcept { return m_gameStats; }
+
 private:
-    // ItXN[RTiJ[/[xARTV/DSVAJڃwpj
+    // オフスクリーンRT（カラー/深度、RTV/DSV、遷移ヘルパ等を内包）
     RenderTarget m_scene;
     RenderTarget m_game;
 
-    // ---- Scene Fes̊Lv`î݁j ----
-    DirectX::XMFLOAT4X4 m_sceneProjInit{};  // ̓eۑ
+    // ビューごとの可視性キャッシュ（SceneRenderer::Record が差分更新する）
+    ViewVisibilityCache m_sceneVis;
+    ViewVisibilityCache m_gameVis;
+
+    // 直近の Record 結果（描かなかったフレームは 0 に戻す）
+    SceneRenderStats m_sceneStats{};
+    SceneRenderStats m_gameStats{};
+
+    // ---- Scene 側：投影行列の基準をキャプチャ（初回のみ） ----
+    DirectX::XMFLOAT4X4 m_sceneProjInit{};  // 初回の投影を保存
     bool                m_sceneProjCaptured = false;
 
-    // ---- Game FŒJi񂾂 Scene Ɠj ----
-    bool                m_gameFrozen = false;      // 񓯊ς񂾂 true
-    DirectX::XMFLOAT4X4 m_gameViewInit{};          // Œ View
-    DirectX::XMFLOAT4X4 m_gameProjInit{};          // Œ ProjiAXyNgω͍ČvZčXVj
+    // ---- Game 側：固定カメラ（初回だけ Scene と同期） ----
+    bool                m_gameFrozen = false;      // 初回同期が済んだら true
+    DirectX::XMFLOAT4X4 m_gameViewInit{};          // 固定 View
+    DirectX::XMFLOAT4X4 m_gameProjInit{};          // 固定 Proj（アスペクト変化時は再計算して更新）
 
-    // ---- foEXԁi]TCŸ艻j ----
-    unsigned m_desiredW = 0, m_desiredH = 0; // ŐV́u]TCYiXibvjvێ
-    float    m_desiredStableTime = 0.0f;     // ]pݐώ
+    // ---- デバウンス状態（希望サイズの安定化） ----
+    unsigned m_desiredW = 0, m_desiredH = 0; // 最新の「希望サイズ（スナップ後）」を保持
+    float    m_desiredStableTime = 0.0f;     // 同一希望が継続した累積時間
 
-    // ---- yfBO ----
-    unsigned m_pendingW = 0;                 // ۂɓKp\̃TCYi蔻j
+    // ---- ペンディング ----
+    unsigned m_pendingW = 0;                 // 実際に適用予定のサイズ（安定判定後）
     unsigned m_pendingH = 0;
 
-    // 2ڂ́g[huit[ŗȂzj
+    // 2個目の“死骸”置き場（今フレームで流せない分を持ち越す）
     RenderTargetHandles m_carryOverDead;
 
-    // foEXEXibṽp[^
-    static constexpr float    kRequiredStableTime = 0.10f; // 莞ԃuȂΊmibj
-    static constexpr unsigned kMinDeltaPx = 4;      // ω̂igpȂ 0j
-    static constexpr unsigned kSnapStep = 16;     // TCYϓ̃XebvXibvipxj
+    // デバウンス・スナップのパラメータ
+    static constexpr float    kRequiredStableTime = 0.10f; // 一定時間ブレなければ確定（秒）
+    static constexpr unsigned kMinDeltaPx = 4;      // 微小変化無視のしきい（未使用なら 0）
+    static constexpr unsigned kSnapStep = 16;     // サイズ変動時のステップスナップ（px）
 };
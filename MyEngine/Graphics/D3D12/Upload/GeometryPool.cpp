@@ -0,0 +1,374 @@
+﻿#include "Upload/GeometryPool.h"
+#include "Upload/IndexFormat.h"
+#include <algorithm>
+
+using Microsoft::WRL::ComPtr;
+
+/*
+    GeometryPool
+    ----------------------------------------------------------------------------
+    Rebuild の手順：
+      1) uploads.WaitIdle()：旧バッファへの転送を終わらせる（コピー元として読む前に）
+      2) 新しい VB（全ストリーム）/IB（32bit と 16bit の両方）を作る（DEFAULT / COMMON）
+      3) 生きている区間の旧位置を控えてから Compact + Grow（新しい位置が決まる）
+      4) 旧 → 新のコピーを積む。旧位置も新位置も連続している区間は 1 回のコピーにまとめる
+         （頂点区間は全ストリーム共通なので、同じ Relocation を各 VB の stride で使う）
+      5) uploads.WaitIdle()：新バッファが埋まってから差し替える
+      6) 旧バッファを retire に渡し、Generation を進める
+    インデックスの置き場所：
+      - Upload が FitsShortIndices で形式を決め、16bit なら m_packed に詰めてから UploadPacked に渡す
+        （Enqueue はステージングへコピーするので m_packed はすぐ再利用してよい）。
+      - UploadPacked は詰め済みのインデックスをそのまま送る（.mesh キャッシュの区画など）。
+      - 区間表は形式ごとに別。Allocation::shortIndices でどちらの表のハンドルかを区別する。
+    VB の名前：
+      - GeometryPool.VB0, VB1, …（ストリーム番号。PIX などで区別できるように）
+    失敗時：
+      - 新バッファが作れなければ何も変えずに false（区間表も触らない）。
+*/
+
+namespace
+{
+    // 区間の旧位置 → 新位置（Rebuild の作業用）
+    struct Relocation
+    {
+        std::uint64_t from = 0;
+        std::uint64_t to = 0;
+        std::uint64_t size = 0;
+    };
+
+    // 生きている区間の旧位置を控える（位置順）
+    void SnapshotLive(const RangeAllocator& ranges, std::vector<std::pair<std::uint32_t, std::uint64_t>>& out)
+    {
+        out.clear();
+        for (std::uint32_t h = 0; h < ranges.HandleCount(); ++h)
+            if (ranges.IsLive(h)) out.push_back({ h, ranges.Offset(h) });
+        std::sort(out.begin(), out.end(),
+            [](const auto& a, const auto& b) { return a.second < b.second; });
+    }
+
+    // 旧位置 → 新位置のコピーを、前後とも連続しているものどうしでまとめる
+    void BuildRelocations(const RangeAllocator& ranges,
+        const std::vector<std::pair<std::uint32_t, std::uint64_t>>& live, std::vector<Relocation>& out)
+    {
+        out.clear();
+        for (const auto& [h, from] : live)
+        {
+            const std::uint64_t to = ranges.Offset(h);
+            const std::uint64_t size = ranges.Size(h);
+            if (!out.empty() && out.back().from + out.back().size == from && out.back().to + out.back().size == to)
+                out.back().size += size;
+            else
+                out.push_back({ from, to, size });
+        }
+    }
+
+    void NameVertexBuffer(ID3D12Resource* vb, std::uint32_t stream)
+    {
+        static const wchar_t* const kNames[GeometryPool::kMaxVertexStreams] = {
+            L"GeometryPool.VB0", L"GeometryPool.VB1", L"GeometryPool.VB2", L"GeometryPool.VB3" };
+        vb->SetName(kNames[stream]);
+    }
+}
+
+std::uint64_t PlanPoolCapacity(std::uint64_t capacity, std::uint64_t used, std::uint64_t required)
+{
+    if (used + required <= capacity) return capacity; // 詰めれば入る
+    std::uint64_t grown = std::max<std::uint64_t>(capacity, 1);
+    while (grown < used + required) grown *= 2;
+    return grown;
+}
+
+bool GeometryPool::Initialize(ID3D12Device* dev, GpuUploadQueue* uploads,
+    const std::uint32_t* vertexStrides, std::uint32_t streamCount,
+    std::uint64_t vertexCapacity, std::uint64_t shortIndexCapacity, std::uint64_t wideIndexCapacity, RetireFn retire)
+{
+    Destroy();
+    if (!dev || !uploads || !vertexStrides || streamCount == 0 || streamCount > kMaxVertexStreams ||
+        vertexCapacity == 0 || shortIndexCapacity == 0 || wideIndexCapacity == 0)
+        return false;
+    for (std::uint32_t s = 0; s < streamCount; ++s)
+        if (vertexStrides[s] == 0) return false;
+
+    m_device = dev;
+    m_uploads = uploads;
+    m_retire = std::move(retire);
+    m_streamCount = streamCount;
+    for (std::uint32_t s = 0; s < streamCount; ++s) m_vertices[s].stride = vertexStrides[s];
+
+    m_indices[kWide].elementSize = sizeof(std::uint32_t);
+    m_indices[kWide].format = DXGI_FORMAT_R32_UINT;
+    m_indices[kWide].name = L"GeometryPool.IB32";
+    m_indices[kShort].elementSize = sizeof(std::uint16_t);
+    m_indices[kShort].format = DXGI_FORMAT_R16_UINT;
+    m_indices[kShort].name = L"GeometryPool.IB16";
+
+    const std::uint64_t indexCapacity[kIndexStoreCount] = { wideIndexCapacity, shortIndexCapacity };
+    for (std::uint32_t s = 0; s < m_streamCount; ++s)
+    {
+        VertexStore& vs = m_vertices[s];
+        if (!CreateStaticBuffer(dev, vertexCapacity * vs.stride, vs.buffer))
+        {
+            Destroy();
+            return false;
+        }
+        NameVertexBuffer(vs.buffer.Get(), s);
+    }
+    m_vertexRanges.Reset(vertexCapacity);
+    for (int i = 0; i < kIndexStoreCount; ++i)
+    {
+        IndexStore& st = m_indices[i];
+        if (!CreateStaticBuffer(dev, indexCapacity[i] * st.elementSize, st.buffer))
+        {
+            Destroy();
+            return false;
+        }
+        st.buffer->SetName(st.name);
+        st.ranges.Reset(indexCapacity[i]);
+    }
+    return true;
+}
+
+void GeometryPool::Destroy()
+{
+    for (VertexStore& vs : m_vertices) vs = VertexStore();
+    m_streamCount = 0;
+    m_vertexRanges.Reset(0);
+    for (IndexStore& st : m_indices)
+    {
+        st.buffer.Reset();
+        st.ranges.Reset(0);
+    }
+    m_packed.clear();
+    m_device = nullptr;
+    m_uploads = nullptr;
+    m_retire = RetireFn();
+    m_compactions = 0;
+    m_grows = 0;
+    ++m_generation;
+}
+
+void GeometryPool::Clear()
+{
+    m_vertexRanges.Reset(m_vertexRanges.Capacity());
+    for (IndexStore& st : m_indices) st.ranges.Reset(st.ranges.Capacity());
+}
+
+bool GeometryPool::Upload(const void* const* streams, std::uint64_t vertexCount,
+    const std::uint32_t* indices, std::uint64_t indexCount, Allocation& out, std::uint64_t& fence)
+{
+    out = Allocation();
+    fence = 0;
+    if (!indices || indexCount == 0) return false;
+
+    // インデックスは頂点区間の先頭からの相対値（BaseVertex で足す）なので、メッシュ単体で判定できる
+    const bool shortIndices = FitsShortIndices(indices, static_cast<std::size_t>(indexCount));
+    const void* indexData = indices;
+    if (shortIndices)
+    {
+        PackShortIndices(indices, static_cast<std::size_t>(indexCount), m_packed);
+        indexData = m_packed.data();
+    }
+    return UploadPacked(streams, vertexCount, indexData, indexCount, shortIndices, out, fence);
+}
+
+bool GeometryPool::UploadPacked(const void* const* streams, std::uint64_t vertexCount,
+    const void* indices, std::uint64_t indexCount, bool shortIndices, Allocation& out, std::uint64_t& fence)
+{
+    out = Allocation();
+    fence = 0;
+    if (m_streamCount == 0 || !streams || !indices || vertexCount == 0 || indexCount == 0) return false;
+    for (std::uint32_t s = 0; s < m_streamCount; ++s)
+        if (!streams[s]) return false;
+
+    Allocation a;
+    a.shortIndices = shortIndices;
+    const int si = a.shortIndices ? kShort : kWide;
+    RangeAllocator& iranges = m_indices[si].ranges;
+
+    a.vertices = m_vertexRanges.Allocate(vertexCount);
+    a.indices = iranges.Allocate(indexCount);
+    if (!a.Valid())
+    {
+        // 片方だけ取れた分は戻してから作り直す（詰め直し or 伸長。使わない形式の IB は容量そのまま）
+        m_vertexRanges.Free(a.vertices);
+        iranges.Free(a.indices);
+        const std::uint64_t vcap = PlanPoolCapacity(m_vertexRanges.Capacity(), m_vertexRanges.Used(), vertexCount);
+        std::uint64_t icap[kIndexStoreCount] = { m_indices[kWide].ranges.Capacity(), m_indices[kShort].ranges.Capacity() };
+        icap[si] = PlanPoolCapacity(iranges.Capacity(), iranges.Used(), indexCount);
+        if (!Rebuild(vcap, icap)) return false;
+
+        a.vertices = m_vertexRanges.Allocate(vertexCount);
+        a.indices = iranges.Allocate(indexCount);
+        if (!a.Valid())
+        {
+            m_vertexRanges.Free(a.vertices);
+            iranges.Free(a.indices);
+            return false;
+        }
+    }
+
+    const IndexStore& st = m_indices[si];
+    // 同じ頂点区間を各ストリームの VB に書く（フェンスは最後に積んだ転送のものが全部を含む）
+    std::uint64_t last = 0;
+    for (std::uint32_t s = 0; s < m_streamCount; ++s)
+    {
+        const VertexStore& vs = m_vertices[s];
+        const std::uint64_t vf = m_uploads->Enqueue(vs.buffer.Get(), m_vertexRanges.Offset(a.vertices) * vs.stride,
+            streams[s], vertexCount * vs.stride);
+        if (vf == 0)
+        {
+            Free(a);
+            return false;
+        }
+        last = std::max(last, vf);
+    }
+    const std::uint64_t inf = m_uploads->Enqueue(st.buffer.Get(), st.ranges.Offset(a.indices) * st.elementSize,
+        indices, indexCount * st.elementSize);
+    if (inf == 0)
+    {
+        Free(a);
+        return false;
+    }
+
+    out = a;
+    fence = std::max(last, inf);
+    return true;
+}
+
+void GeometryPool::Free(Allocation& a)
+{
+    m_vertexRanges.Free(a.vertices);
+    m_indices[a.shortIndices ? kShort : kWide].ranges.Free(a.indices);
+    a = Allocation();
+}
+
+bool GeometryPool::Compact()
+{
+    if (m_streamCount == 0) return false;
+    bool packed = m_vertexRanges.FreeBlocks() <= 1;
+    for (const IndexStore& st : m_indices) packed = packed && st.ranges.FreeBlocks() <= 1;
+    if (packed) return true; // 詰まっている
+
+    const std::uint64_t icap[kIndexStoreCount] = { m_indices[kWide].ranges.Capacity(), m_indices[kShort].ranges.Capacity() };
+    return Rebuild(m_vertexRanges.Capacity(), icap);
+}
+
+bool GeometryPool::Rebuild(std::uint64_t vertexCapacity, const std::uint64_t (&indexCapacity)[kIndexStoreCount])
+{
+    if (!m_device || !m_uploads) return false;
+
+    // 1) 旧バッファへの転送を終わらせる
+    m_uploads->WaitIdle();
+
+    // 2) 新しいバッファ
+    ComPtr<ID3D12Resource> vb[kMaxVertexStreams], ib[kIndexStoreCount];
+    for (std::uint32_t s = 0; s < m_streamCount; ++s)
+    {
+        if (!CreateStaticBuffer(m_device, vertexCapacity * m_vertices[s].stride, vb[s])) return false;
+        NameVertexBuffer(vb[s].Get(), s);
+    }
+    for (int i = 0; i < kIndexStoreCount; ++i)
+    {
+        if (!CreateStaticBuffer(m_device, indexCapacity[i] * m_indices[i].elementSize, ib[i])) return false;
+        ib[i]->SetName(m_indices[i].name);
+    }
+
+    // 3) 旧位置を控えてから詰める（ハンドルの数は Compact で変わらない）
+    std::vector<std::pair<std::uint32_t, std::uint64_t>> liveV, liveI[kIndexStoreCount];
+    bool grew = vertexCapacity > m_vertexRanges.Capacity();
+    SnapshotLive(m_vertexRanges, liveV);
+    m_vertexRanges.Compact(m_moves);
+    m_vertexRanges.Grow(vertexCapacity);
+    for (int i = 0; i < kIndexStoreCount; ++i)
+    {
+        RangeAllocator& r = m_indices[i].ranges;
+        grew = grew || indexCapacity[i] > r.Capacity();
+        SnapshotLive(r, liveI[i]);
+        r.Compact(m_moves);
+        r.Grow(indexCapacity[i]);
+    }
+
+    // 4) 旧 → 新のコピー
+    std::vector<Relocation> relocations;
+    BuildRelocations(m_vertexRanges, liveV, relocations);
+    for (std::uint32_t s = 0; s < m_streamCount; ++s)
+    {
+        const VertexStore& vs = m_vertices[s];
+        for (const Relocation& r : relocations)
+            m_uploads->EnqueueCopy(vb[s].Get(), r.to * vs.stride, vs.buffer.Get(), r.from * vs.stride, r.size * vs.stride);
+    }
+    for (int i = 0; i < kIndexStoreCount; ++i)
+    {
+        const IndexStore& st = m_indices[i];
+        BuildRelocations(st.ranges, liveI[i], relocations);
+        for (const Relocation& r : relocations)
+            m_uploads->EnqueueCopy(ib[i].Get(), r.to * st.elementSize, st.buffer.Get(),
+                r.from * st.elementSize, r.size * st.elementSize);
+    }
+
+    // 5) 新バッファが埋まるまで待つ
+    m_uploads->WaitIdle();
+
+    // 6) 差し替え
+    for (std::uint32_t s = 0; s < m_streamCount; ++s)
+    {
+        if (m_retire) m_retire(std::move(m_vertices[s].buffer));
+        m_vertices[s].buffer = std::move(vb[s]);
+    }
+    for (int i = 0; i < kIndexStoreCount; ++i)
+    {
+        if (m_retire) m_retire(std::move(m_indices[i].buffer));
+        m_indices[i].buffer = std::move(ib[i]);
+    }
+    if (grew) ++m_grows;
+    else      ++m_compactions;
+    ++m_generation;
+    return true;
+}
+
+D3D12_VERTEX_BUFFER_VIEW GeometryPool::VertexView(std::uint32_t stream) const
+{
+    D3D12_VERTEX_BUFFER_VIEW v{};
+    if (stream >= m_streamCount || !m_vertices[stream].buffer) return v;
+    const VertexStore& vs = m_vertices[stream];
+    v.BufferLocation = vs.buffer->GetGPUVirtualAddress();
+    v.StrideInBytes = vs.stride;
+    v.SizeInBytes = static_cast<UINT>(m_vertexRanges.Capacity() * vs.stride);
+    return v;
+}
+
+D3D12_INDEX_BUFFER_VIEW GeometryPool::IndexView(const Allocation& a) const
+{
+    D3D12_INDEX_BUFFER_VIEW v{};
+    const IndexStore& st = Store(a);
+    if (!st.buffer) return v;
+    v.BufferLocation = st.buffer->GetGPUVirtualAddress();
+    v.Format = st.format;
+    v.SizeInBytes = static_cast<UINT>(st.ranges.Capacity() * st.elementSize);
+    return v;
+}
+
+GeometryPoolStats GeometryPool::Stats() const
+{
+    const RangeAllocator& wide = m_indices[kWide].ranges;
+    const RangeAllocator& narrow = m_indices[kShort].ranges;
+
+    GeometryPoolStats s;
+    s.vertexCapacity = m_vertexRanges.Capacity();
+    s.vertexUsed = m_vertexRanges.Used();
+    for (std::uint32_t i = 0; i < m_streamCount; ++i) s.vertexStride += m_vertices[i].stride;
+    s.positionStride = m_vertices[0].stride;
+    s.vertexStreams = m_streamCount;
+    s.indexCapacity = wide.Capacity();
+    s.indexUsed = wide.Used();
+    s.shortIndexCapacity = narrow.Capacity();
+    s.shortIndexUsed = narrow.Used();
+    s.indexBytes = wide.Used() * sizeof(std::uint32_t) + narrow.Used() * sizeof(std::uint16_t);
+    s.indexBytesSaved = narrow.Used() * (sizeof(std::uint32_t) - sizeof(std::uint16_t));
+    s.vertexFragmentation = m_vertexRanges.Fragmentation();
+    s.indexFragmentation = std::max(wide.Fragmentation(), narrow.Fragmentation());
+    s.meshes = m_vertexRanges.LiveCount();
+    s.compactions = m_compactions;
+    s.grows = m_grows;
+    return s;
+}
@@ -0,0 +1,202 @@
+﻿#pragma once
+#include <wrl/client.h>
+#include <d3d12.h>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "Upload/RangeAllocator.h"
+#include "Upload/GpuUploadQueue.h"
+
+/*
+    GeometryPool
+    ----------------------------------------------------------------------------
+    目的：
+      - 全メッシュの頂点/インデックスを頂点ストリームごとの大きな VB と形式ごとの IB（DEFAULT ヒープ）に詰める。
+        メッシュは「VB 上の頂点区間 + IB 上のインデックス区間」で表し、描画は
+          DrawIndexedInstanced(indexCount, n, StartIndexLocation, BaseVertexLocation, 0)
+        で行う。全メッシュが同じ VBV と 2 種類の IBV を使うので、IASet* はパス内で数回になり、
+        インスタンス区間や間接引数は「どこから何個」だけで書ける。
+      - 区間の切り出しは RangeAllocator（free-list、best-fit、隣接結合）。
+        中身の転送は GpuUploadQueue（COPY キュー）に積む。
+
+    断片化と作り直し（Rebuild）：
+      - Upload で区間が取れなかったとき：
+          空きの合計で足りる → 同じ容量で作り直す（＝詰め直し。Compact）
+          足りない           → 容量を倍々に増やして作り直す（Grow）
+      - 作り直しは新しい VB/IB を作り、生きている区間を詰めた位置へ GPU 上でコピーする。
+        同じバッファ内で詰めないのは、重なるコピーを避けるためと、前フレームのコマンドが
+        旧バッファの旧位置をまだ読んでいる可能性があるため。旧バッファは retire（既定は何もしない）
+        に渡すので、呼び出し側が DIRECT キューの完了まで生かしておくこと。
+      - 作り直しは COPY キューの完了を CPU で待つ（ロード時の待ちは許容）。終わると Generation() が
+        進むので、呼び出し側は保持しているビュー/BaseVertex/StartIndex を取り直すこと。
+
+    想定フロー（D3D12Renderer）：
+      - 初期化：Initialize(dev, &uploads, GpuVertexStreams::kStrides.data(), GpuVertexStreams::kStreamCount, ..., retire)
+      - メッシュ作成：Upload(streams, vertexCount, indices, alloc, fence) → 完了まで描かない（fence を監視）
+        （.mesh キャッシュのように GPU 形式へ詰め済みなら UploadPacked。ステージングへのコピーだけになる）
+      - メッシュ破棄：GPU 完了待ちの後で Free(alloc)
+      - シーン破棄：Clear()（バッファは残して区間だけ全部捨てる）
+
+    インデックス形式：
+      - IB は 32bit（R32_UINT）と 16bit（R16_UINT）の 2 本。Upload 時にメッシュの最大インデックスを調べ、
+        0xFFFF 以下なら 16bit に詰めて 16bit 側に置く（BaseVertex で頂点区間の先頭を足すので、
+        判定はメッシュ単体の頂点数で決まる。ほとんどのメッシュは 16bit に入る）。
+      - 形式は Allocation::shortIndices で区別する。IndexView(a) はその形式の IB を返す。
+
+    頂点ストリーム：
+      - VB はストリーム（スロット）ごとに 1 本ずつ持つ（位置だけの VB と、法線/色の VB など）。
+        頂点区間の表は全ストリームで 1 つなので、BaseVertex と頂点のインデックスはどの VB でも同じ。
+        作り直しも全ストリームの VB を同時に差し替える。
+      - 位置しか読まないパスは VertexView(0) だけをバインドすればよい。
+
+    設計メモ：
+      - ストリームの数と頂点の大きさは Initialize の strides で決める。
+      - 区間の位置は Upload/Compact/Rebuild でしか変わらない。スレッドセーフではない。
+*/
+
+/// プールの使用状況（デバッグ/Stats 表示用）
+struct GeometryPoolStats
+{
+    std::uint64_t vertexCapacity = 0;  ///< VB の要素数
+    std::uint64_t vertexUsed = 0;
+    std::uint32_t vertexStride = 0;    ///< 頂点 1 個のバイト数（全ストリームの stride の合計）
+    std::uint32_t positionStride = 0;  ///< ストリーム 0（位置）の stride。位置だけのパスが読む 1 頂点のバイト数
+    std::uint32_t vertexStreams = 0;   ///< ストリーム（VB）の数
+    std::uint64_t indexCapacity = 0;   ///< 32bit IB の要素数
+    std::uint64_t indexUsed = 0;
+    std::uint64_t shortIndexCapacity = 0; ///< 16bit IB の要素数
+    std::uint64_t shortIndexUsed = 0;
+    std::uint64_t indexBytes = 0;      ///< 生きているインデックスの合計バイト数（16bit 分は 2B/個）
+    std::uint64_t indexBytesSaved = 0; ///< 16bit に詰めたことで節約したバイト数（= shortIndexUsed * 2）
+    float         vertexFragmentation = 0.0f;
+    float         indexFragmentation = 0.0f; ///< 32bit/16bit のうち大きい方
+    std::uint32_t meshes = 0;          ///< 生きているメッシュ（区間の組）の数
+    std::uint32_t compactions = 0;     ///< 同じ容量での作り直し回数
+    std::uint32_t grows = 0;           ///< 容量を増やした作り直し回数
+};
+
+/**
+ * @brief 区間が取れなかったときの作り直し後の容量を決める
+ * @return capacity のまま = 詰め直しだけで足りる / それより大きい = 倍々に伸ばす
+ */
+std::uint64_t PlanPoolCapacity(std::uint64_t capacity, std::uint64_t used, std::uint64_t required);
+
+class GeometryPool
+{
+public:
+    static constexpr std::uint64_t kDefaultVertexCapacity = 256 * 1024;  ///< 頂点数
+    static constexpr std::uint64_t kDefaultIndexCapacity = 1024 * 1024;  ///< 16bit IB のインデックス数
+    static constexpr std::uint64_t kDefaultWideIndexCapacity = 64 * 1024; ///< 32bit IB のインデックス数（足りなければ伸びる）
+    static constexpr std::uint32_t kMaxVertexStreams = 4;                 ///< 頂点ストリーム（VB）の上限
+
+    using RetireFn = std::function<void(Microsoft::WRL::ComPtr<ID3D12Resource>)>;
+
+    /// VB 上の頂点区間と IB 上のインデックス区間の組
+    struct Allocation
+    {
+        std::uint32_t vertices = RangeAllocator::kInvalid;
+        std::uint32_t indices = RangeAllocator::kInvalid;
+        bool          shortIndices = false; ///< true = 16bit IB 側の区間
+        bool Valid() const { return vertices != RangeAllocator::kInvalid && indices != RangeAllocator::kInvalid; }
+    };
+
+    ~GeometryPool() { Destroy(); }
+
+    /**
+     * @param uploads       転送に使うキュー（プールより長生きさせること）
+     * @param vertexStrides ストリームごとの頂点 1 個のバイト数（streamCount 個。ストリーム s が VB スロット s）
+     * @param retire        作り直しで外した旧バッファの受け取り先（DIRECT キューの完了まで生かす）
+     */
+    bool Initialize(ID3D12Device* dev, GpuUploadQueue* uploads,
+        const std::uint32_t* vertexStrides, std::uint32_t streamCount,
+        std::uint64_t vertexCapacity = kDefaultVertexCapacity,
+        std::uint64_t shortIndexCapacity = kDefaultIndexCapacity,
+        std::uint64_t wideIndexCapacity = kDefaultWideIndexCapacity,
+        RetireFn retire = RetireFn());
+
+    /// バッファを解放する（GPU 完了待ち済みで呼ぶこと）
+    void Destroy();
+
+    /// すべての区間を捨てる（バッファはそのまま。GPU 完了待ち済みで呼ぶこと）
+    void Clear();
+
+    /**
+     * @brief 区間を切り出して頂点/インデックスの転送を積む（提出は uploads.Submit まで遅らせる）
+     * @details インデックスは 32bit で受け取り、最大値が 0xFFFF 以下なら 16bit に詰めて送る
+     * @param streams ストリームごとの詰めた頂点配列の先頭（StreamCount() 個。どれも vertexCount 頂点）
+     * @param fence   転送完了のフェンス値（uploads.IsComplete に渡す）
+     * @return 失敗（容量を伸ばせない、転送に失敗）なら false。out は無効のまま
+     */
+    bool Upload(const void* const* streams, std::uint64_t vertexCount,
+        const std::uint32_t* indices, std::uint64_t indexCount,
+        Allocation& out, std::uint64_t& fence);
+
+    /**
+     * @brief 詰め済みのインデックスで Upload する（形式の判定も詰め直しもしない）
+     * @param indices      shortIndices なら uint16、そうでなければ uint32 の配列（indexCount 個）
+     * @param shortIndices 16bit IB 側に置くか（全インデックスが 0xFFFF 以下であること）
+     */
+    bool UploadPacked(const void* const* streams, std::uint64_t vertexCount,
+        const void* indices, std::uint64_t indexCount, bool shortIndices,
+        Allocation& out, std::uint64_t& fence);
+
+    /// 区間を返す（GPU がもう読まないことを呼び出し側が保証する）
+    void Free(Allocation& a);
+
+    /// 空きを詰め直す（断片化を解消する。ロード時向け。位置が変わるので Generation が進む）
+    bool Compact();
+
+    INT  BaseVertex(const Allocation& a) const { return static_cast<INT>(m_vertexRanges.Offset(a.vertices)); }
+    UINT StartIndex(const Allocation& a) const { return static_cast<UINT>(Store(a).ranges.Offset(a.indices)); }
+
+    std::uint32_t StreamCount() const { return m_streamCount; }
+
+    /// ストリーム stream の VB 全体のビュー（スロット stream にバインドする）
+    D3D12_VERTEX_BUFFER_VIEW VertexView(std::uint32_t stream) const;
+    /// a のインデックス形式（16bit/32bit）の IB 全体のビュー
+    D3D12_INDEX_BUFFER_VIEW  IndexView(const Allocation& a) const;
+    const Microsoft::WRL::ComPtr<ID3D12Resource>& VertexBuffer(std::uint32_t stream) const { return m_vertices[stream].buffer; }
+    const Microsoft::WRL::ComPtr<ID3D12Resource>& IndexBuffer(const Allocation& a) const { return Store(a).buffer; }
+
+    /// バッファの作り直し（位置の変更）ごとに進む。保持しているビュー等の取り直しの判定に使う
+    std::uint32_t Generation() const { return m_generation; }
+
+    GeometryPoolStats Stats() const;
+
+private:
+    /// 頂点ストリームごとの VB（区間表は全ストリーム共通の m_vertexRanges）
+    struct VertexStore
+    {
+        Microsoft::WRL::ComPtr<ID3D12Resource> buffer;
+        std::uint32_t                          stride = 0;
+    };
+
+    /// インデックス形式ごとの IB と区間表
+    struct IndexStore
+    {
+        Microsoft::WRL::ComPtr<ID3D12Resource> buffer;
+        RangeAllocator                         ranges;
+        std::uint32_t                          elementSize = 0;
+        DXGI_FORMAT                            format = DXGI_FORMAT_UNKNOWN;
+        const wchar_t*                         name = L"";
+    };
+    enum : int { kWide = 0, kShort = 1, kIndexStoreCount = 2 };
+
+    const IndexStore& Store(const Allocation& a) const { return m_indices[a.shortIndices ? kShort : kWide]; }
+
+    bool Rebuild(std::uint64_t vertexCapacity, const std::uint64_t (&indexCapacity)[kIndexStoreCount]);
+
+    ID3D12Device*    m_device = nullptr;
+    GpuUploadQueue*  m_uploads = nullptr;
+    RetireFn         m_retire;
+
+    VertexStore      m_vertices[kMaxVertexStreams];
+    std::uint32_t    m_streamCount = 0;
+    RangeAllocator   m_vertexRanges;
+    IndexStore       m_indices[kIndexStoreCount];
+    std::vector<std::uint16_t> m_packed; ///< 16bit に詰めたインデックス（Upload の作業用）
+    std::uint32_t    m_generation = 0;
+    std::uint32_t    m_compactions = 0;
+    std::uint32_t    m_grows = 0;
+    std::vector<RangeMove> m_moves; ///< Compact の作業用
+};
@@ -0,0 +1,249 @@
+﻿#include "Upload/GpuUploadQueue.h"
+#include "Debug/DxDebug.h"
+#include <d3dx12.h>
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+using Microsoft::WRL::ComPtr;
+
+/*
+    GpuUploadQueue
+    ----------------------------------------------------------------------------
+    フェンス値の流れ：
+      - Enqueue は「次の Submit で Signal する値（m_nextFence）」を返す。
+        同じ Submit にまとまった転送は同じ値になる。
+      - Submit：backend.submit(m_nextFence) → ステージングの未退役分を同じ値で Retire。
+      - Update：completed 以下の InFlight を外し、ステージングを Reclaim。
+    満杯時：
+      - 未提出分があれば先に Submit（でないと待つ相手がいない）→ 最も古いフェンスを wait → Update。
+    注意：
+      - copy が失敗した場合、その Enqueue は 0 を返す（途中まで積んだ分と切り出した領域は
+        次の Submit でそのまま送られ、同じフェンスで戻る）。
+      - submit の失敗（Signal 失敗 = デバイス消失）は特別扱いしない。以後の転送も完了しない。
+*/
+
+namespace
+{
+    constexpr std::uint64_t kStagingAlign = 16; // CopyBufferRegion に制約は無いが memcpy 先を揃えておく
+}
+
+bool GpuUploadQueue::Initialize(ID3D12Device* dev, std::uint64_t stagingBytes)
+{
+    Destroy();
+    if (!dev) return false;
+
+    // 専用の COPY キュー（DIRECT の描画と並行して転送できる）
+    D3D12_COMMAND_QUEUE_DESC qd{};
+    qd.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+    HRESULT hr = dev->CreateCommandQueue(&qd, IID_PPV_ARGS(&m_queue));
+    dxdbg::LogHRESULTError(hr, "Create copy queue");
+    if (FAILED(hr)) return false;
+    m_queue->SetName(L"GpuUploadQueue");
+
+    hr = dev->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_fence));
+    dxdbg::LogHRESULTError(hr, "Create copy fence");
+    if (FAILED(hr)) return false;
+    m_event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+    if (!m_event) return false;
+
+    if (!m_lists.Initialize(dev, D3D12_COMMAND_LIST_TYPE_COPY)) return false;
+
+    Backend b;
+    b.createStaging = [dev](std::uint64_t bytes, UploadPage& out) -> bool
+        {
+            auto heap = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+            auto desc = CD3DX12_RESOURCE_DESC::Buffer(bytes);
+            ComPtr<ID3D12Resource> res;
+            HRESULT hr = dev->CreateCommittedResource(&heap, D3D12_HEAP_FLAG_NONE, &desc,
+                D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&res));
+            dxdbg::LogHRESULTError(hr, "Create staging");
+            if (FAILED(hr)) return false;
+
+            // 常時 Map（CPU は書くだけなので読み取り範囲は空）
+            CD3DX12_RANGE rr(0, 0);
+            void* cpu = nullptr;
+            if (FAILED(res->Map(0, &rr, &cpu))) return false;
+
+            out.resource = std::move(res);
+            out.cpu = static_cast<std::uint8_t*>(cpu);
+            out.gpu = out.resource->GetGPUVirtualAddress();
+            out.size = bytes;
+            return true;
+        };
+    b.copy = [this](ID3D12Resource* dst, std::uint64_t dstOffset, ID3D12Resource* src, std::uint64_t srcOffset, std::uint64_t bytes) -> bool
+        {
+            if (!m_open)
+            {
+                // 完了した提出のアロケータを戻してから開く
+                m_lists.BeginFrame(m_fence->GetCompletedValue());
+                m_open = m_lists.Acquire();
+                if (!m_open) return false;
+            }
+            m_open->CopyBufferRegion(dst, dstOffset, src ? src : m_staging.resource.Get(), srcOffset, bytes);
+            return true;
+        };
+    b.submit = [this](std::uint64_t fence) -> bool
+        {
+            std::vector<ID3D12CommandList*> lists;
+            m_lists.Close(lists);
+            m_open = nullptr;
+            if (!lists.empty())
+                m_queue->ExecuteCommandLists(static_cast<UINT>(lists.size()), lists.data());
+            const HRESULT hr = m_queue->Signal(m_fence.Get(), fence);
+            m_lists.EndFrame(fence);
+            return SUCCEEDED(hr);
+        };
+    b.completed = [this]() -> std::uint64_t { return m_fence->GetCompletedValue(); };
+    b.wait = [this](std::uint64_t fence)
+        {
+            if (m_fence->GetCompletedValue() >= fence) return;
+            if (SUCCEEDED(m_fence->SetEventOnCompletion(fence, m_event)))
+                WaitForSingleObject(m_event, INFINITE);
+        };
+
+    return Setup(std::move(b), stagingBytes);
+}
+
+bool GpuUploadQueue::Initialize(Backend backend, std::uint64_t stagingBytes)
+{
+    Destroy();
+    return Setup(std::move(backend), stagingBytes);
+}
+
+bool GpuUploadQueue::Setup(Backend backend, std::uint64_t stagingBytes)
+{
+    m_backend = std::move(backend);
+    stagingBytes = (std::max<std::uint64_t>(stagingBytes, 64 * 1024) + 255) & ~255ull;
+    if (!m_backend.createStaging || !m_backend.createStaging(stagingBytes, m_staging))
+    {
+        m_backend = Backend();
+        return false;
+    }
+    m_ring.Reset(m_staging.size);
+    m_nextFence = 1;
+    m_lastSubmitted = 0;
+    m_hasPending = false;
+    m_stats = Stats();
+    return true;
+}
+
+void GpuUploadQueue::Destroy()
+{
+    if (m_backend.submit) WaitIdle();
+
+    m_pendingTargets.clear();
+    m_inFlight.clear();
+    m_ring.Reset(0);
+    m_staging = UploadPage(); // UPLOAD リソースは Unmap せずに Release してよい
+    m_backend = Backend();
+    m_open = nullptr;
+    m_lists.Destroy();
+    m_fence.Reset();
+    m_queue.Reset();
+    if (m_event) { CloseHandle(m_event); m_event = nullptr; }
+}
+
+std::uint64_t GpuUploadQueue::Enqueue(ID3D12Resource* dst, std::uint64_t dstOffset, const void* data, std::uint64_t bytes)
+{
+    if (!m_backend.copy || !m_staging.cpu || !data || bytes == 0) return 0;
+
+    const std::uint8_t* src = static_cast<const std::uint8_t*>(data);
+    std::uint64_t done = 0;
+    while (done < bytes)
+    {
+        // ステージングに収まる大きさに分ける
+        const std::uint64_t chunk = std::min(bytes - done, m_ring.Capacity());
+        const std::uint64_t offset = m_ring.Allocate(chunk, kStagingAlign);
+        if (offset == StagingRing::kInvalid)
+        {
+            // 満杯：溜まっている分を提出し、最も古い転送の完了を待って空ける
+            if (m_hasPending) Submit();
+            const std::uint64_t oldest = m_ring.OldestFence();
+            if (oldest == 0 || oldest > m_lastSubmitted) return 0; // 待つ相手がいない（提出失敗等）
+            m_backend.wait(oldest);
+            ++m_stats.stalls;
+            Update();
+            continue;
+        }
+
+        m_hasPending = true; // 切り出した領域は次の Submit で退役させる
+        std::memcpy(m_staging.cpu + offset, src + done, static_cast<size_t>(chunk));
+        if (!m_backend.copy(dst, dstOffset + done, nullptr, offset, chunk)) return 0;
+        ++m_stats.copies;
+        done += chunk;
+    }
+
+    if (dst) m_pendingTargets.emplace_back(dst);
+    m_stats.bytesQueued += bytes;
+    return m_nextFence;
+}
+
+std::uint64_t GpuUploadQueue::EnqueueCopy(ID3D12Resource* dst, std::uint64_t dstOffset,
+    ID3D12Resource* src, std::uint64_t srcOffset, std::uint64_t bytes)
+{
+    if (!m_backend.copy || !src || bytes == 0) return 0;
+    m_hasPending = true;
+    if (!m_backend.copy(dst, dstOffset, src, srcOffset, bytes)) return 0;
+    ++m_stats.copies;
+
+    if (dst) m_pendingTargets.emplace_back(dst);
+    m_pendingTargets.emplace_back(src);
+    m_stats.bytesQueued += bytes;
+    return m_nextFence;
+}
+
+std::uint64_t GpuUploadQueue::Submit()
+{
+    if (!m_hasPending || !m_backend.submit) return m_lastSubmitted;
+
+    const std::uint64_t fence = m_nextFence++;
+    m_backend.submit(fence);
+    m_ring.Retire(fence);
+
+    InFlight f;
+    f.fence = fence;
+    f.targets.swap(m_pendingTargets);
+    m_inFlight.push_back(std::move(f));
+
+    m_hasPending = false;
+    m_lastSubmitted = fence;
+    ++m_stats.submits;
+    m_stats.inFlight = static_cast<std::uint32_t>(m_inFlight.size());
+    return fence;
+}
+
+void GpuUploadQueue::Update()
+{
+    if (!m_backend.completed) return;
+    const std::uint64_t completed = m_backend.completed();
+    while (!m_inFlight.empty() && m_inFlight.front().fence <= completed) m_inFlight.pop_front();
+    m_ring.Reclaim(completed);
+    m_stats.inFlight = static_cast<std::uint32_t>(m_inFlight.size());
+}
+
+bool GpuUploadQueue::IsComplete(std::uint64_t fence) const
+{
+    if (fence == 0) return true;
+    if (fence > m_lastSubmitted || !m_backend.completed) return false; // 未提出
+    return m_backend.completed() >= fence;
+}
+
+void GpuUploadQueue::WaitIdle()
+{
+    Submit();
+    if (m_lastSubmitted != 0 && m_backend.wait) m_backend.wait(m_lastSubmitted);
+    Update();
+}
+
+bool CreateStaticBuffer(ID3D12Device* dev, std::uint64_t bytes, ComPtr<ID3D12Resource>& out)
+{
+    out.Reset();
+    if (!dev || bytes == 0) return false;
+    auto heap = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+    auto desc = CD3DX12_RESOURCE_DESC::Buffer(bytes);
+    const HRESULT hr = dev->CreateCommittedResource(&heap, D3D12_HEAP_FLAG_NONE, &desc,
+        D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(&out));
+    dxdbg::LogHRESULTError(hr, "Create static buffer");
+    return SUCCEEDED(hr);
+}
@@ -0,0 +1,137 @@
+﻿#pragma once
+#include <wrl/client.h>
+#include <d3d12.h>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+#include "Core/UploadRing.h"        // UploadPage（ステージングバッファの表現を共用）
+#include "Core/CommandListPool.h"   // COPY キュー用のアロケータ/リスト
+#include "Upload/StagingRing.h"
+
+/*
+    GpuUploadQueue
+    ----------------------------------------------------------------------------
+    目的：
+      - 静的なメッシュ（VB/IB）を DEFAULT ヒープに置くための転送キュー。
+        専用の COPY キューと、常時 Map したステージングバッファ（StagingRing で循環利用）を持ち、
+          CPU → ステージング（memcpy） → DEFAULT バッファ（CopyBufferRegion、COPY キュー）
+        の 2 段で送る。UPLOAD ヒープに置きっぱなしにするより GPU からの読み出しが速い。
+      - 転送の完了はフェンス値で表す。Enqueue が返した値を IsComplete で確かめてから描く
+        （描画側は完了するまでそのメッシュを飛ばす。DIRECT キューは待たない）。
+
+    想定フロー（D3D12Renderer）：
+      - ロード時：CreateStaticBuffer で DEFAULT バッファを作り、Enqueue(dst, data) を何度でも
+      - 毎フレーム：Submit()（溜まったコピーを 1 回で提出）→ Update()（完了分のステージングを再利用）
+      - 終了時：Destroy()（すべての転送の完了を待つ）
+
+    リソース状態：
+      - 転送先のバッファは COMMON で作る。バッファは COPY キューで暗黙に COPY_DEST へ昇格し、
+        ExecuteCommandLists の完了で COMMON に戻るので、バリアは不要。DIRECT キューでも
+        VB/IB として使うときに暗黙に昇格する。
+      - 転送先は完了まで参照を持っておく（途中で持ち主が手放しても GPU が書き終わるまで生きている）。
+
+    設計メモ：
+      - キュー/フェンス/リスト記録は Backend（関数の束）に委譲する。既定はデバイスから作る実装。
+        テストではフェイクのキュー（フェンス値を手で進める）を渡せば、ステージングの循環と
+        フェンスの管理を GPU 無しで確認できる。
+      - ステージングより大きいデータは Capacity 以下に分けて送る。ステージングが満杯なら
+        溜まっている分を提出し、最も古い転送の完了を待ってから続ける（ロード時の待ちは許容）。
+      - スレッドセーフではない（メインスレッドから呼ぶ）。
+*/
+
+class GpuUploadQueue
+{
+public:
+    static constexpr std::uint64_t kDefaultStagingSize = 8ull * 1024 * 1024;
+
+    /// D3D12 呼び出しの差し替え口
+    struct Backend
+    {
+        std::function<bool(std::uint64_t bytes, UploadPage& out)> createStaging; ///< 常時 Map のステージングを作る
+        /// 今の記録先へ dst[dstOffset..] ← src[srcOffset..] のコピーを積む（src が nullptr ならステージング。必要ならリストを開く）
+        std::function<bool(ID3D12Resource* dst, std::uint64_t dstOffset, ID3D12Resource* src, std::uint64_t srcOffset, std::uint64_t bytes)> copy;
+        std::function<bool(std::uint64_t fence)> submit;     ///< 積んだコピーを提出して fence を Signal する
+        std::function<std::uint64_t()>           completed;  ///< COPY キューが到達したフェンス値
+        std::function<void(std::uint64_t fence)> wait;       ///< fence に到達するまで CPU で待つ
+    };
+
+    /// 転送の統計（デバッグ/Stats 表示用）
+    struct Stats
+    {
+        std::uint64_t bytesQueued = 0;   ///< これまでに Enqueue したバイト数
+        std::uint32_t copies = 0;        ///< これまでに積んだ CopyBufferRegion の数
+        std::uint32_t submits = 0;       ///< 提出回数
+        std::uint32_t stalls = 0;        ///< ステージング満杯で完了を待った回数
+        std::uint32_t inFlight = 0;      ///< 完了待ちの提出数
+    };
+
+    ~GpuUploadQueue() { Destroy(); }
+
+    /// 専用の COPY キュー・フェンス・ステージング（UPLOAD ヒープ）を作る
+    bool Initialize(ID3D12Device* dev, std::uint64_t stagingBytes = kDefaultStagingSize);
+
+    /// 作り方を差し替えて初期化する（テスト用のフェイクキュー等）
+    bool Initialize(Backend backend, std::uint64_t stagingBytes = kDefaultStagingSize);
+
+    /// すべての転送の完了を待ってから解放する
+    void Destroy();
+
+    /**
+     * @brief data の bytes バイトを dst の dstOffset 以降へ送る（提出は Submit まで遅らせる）
+     * @return この転送の完了を表すフェンス値（IsComplete に渡す）。失敗なら 0
+     */
+    std::uint64_t Enqueue(ID3D12Resource* dst, std::uint64_t dstOffset, const void* data, std::uint64_t bytes);
+
+    /**
+     * @brief GPU 上のバッファ間コピーを積む（src[srcOffset..] → dst[dstOffset..]、ステージングは使わない）
+     * @details GeometryPool の作り直しで使う。src も完了まで参照を持つ。src と dst は別のリソースであること
+     * @return 完了を表すフェンス値。失敗なら 0
+     */
+    std::uint64_t EnqueueCopy(ID3D12Resource* dst, std::uint64_t dstOffset,
+        ID3D12Resource* src, std::uint64_t srcOffset, std::uint64_t bytes);
+
+    /// 溜まっているコピーを提出する。戻り値は最後に提出したフェンス値（何も無ければ前回の値）
+    std::uint64_t Submit();
+
+    /// 完了した転送のステージング領域と転送先の参照を解放する
+    void Update();
+
+    /// fence までの転送が終わっているか（0 は常に完了扱い）
+    bool IsComplete(std::uint64_t fence) const;
+
+    /// すべての転送（未提出分も提出して）の完了を待つ
+    void WaitIdle();
+
+    const Stats&       GetStats() const { return m_stats; }
+    const StagingRing& Staging() const { return m_ring; }
+
+private:
+    bool Setup(Backend backend, std::uint64_t stagingBytes);
+
+    struct InFlight
+    {
+        std::uint64_t fence = 0;
+        std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> targets; ///< 完了まで生かしておく転送先
+    };
+
+    Backend                 m_backend;
+    UploadPage              m_staging;
+    StagingRing             m_ring;
+    std::uint64_t           m_nextFence = 1;    ///< 次の Submit で Signal する値
+    std::uint64_t           m_lastSubmitted = 0;
+    bool                    m_hasPending = false;
+    std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> m_pendingTargets;
+    std::deque<InFlight>    m_inFlight;
+    Stats                   m_stats;
+
+    // 既定のバックエンドが持つ D3D12 オブジェクト
+    Microsoft::WRL::ComPtr<ID3D12CommandQueue> m_queue;
+    Microsoft::WRL::ComPtr<ID3D12Fence>        m_fence;
+    HANDLE                                     m_event = nullptr;
+    CommandListPool                            m_lists;
+    ID3D12GraphicsCommandList*                 m_open = nullptr; ///< 記録中のリスト（Submit で閉じる）
+};
+
+/// 静的データ用の DEFAULT ヒープバッファを COMMON 状態で作る（GpuUploadQueue の転送先）
+bool CreateStaticBuffer(ID3D12Device* dev, std::uint64_t bytes, Microsoft::WRL::ComPtr<ID3D12Resource>& out);
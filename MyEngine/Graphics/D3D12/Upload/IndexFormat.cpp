@@ -0,0 +1,19 @@
+﻿#include "Upload/IndexFormat.h"
+#include <algorithm>
+
+bool FitsShortIndices(const std::uint32_t* indices, std::size_t count)
+{
+    if (!indices || count == 0) return false;
+    return *std::max_element(indices, indices + count) <= 0xFFFFu;
+}
+
+void PackShortIndices(const std::uint32_t* indices, std::size_t count, std::vector<std::uint16_t>& out)
+{
+    out.resize(count);
+    for (std::size_t i = 0; i < count; ++i) out[i] = static_cast<std::uint16_t>(indices[i]);
+}
+
+DXGI_FORMAT ChooseIndexFormat(const std::uint32_t* indices, std::size_t count)
+{
+    return FitsShortIndices(indices, count) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+}
@@ -0,0 +1,33 @@
+﻿#pragma once
+#include <dxgiformat.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+    IndexFormat
+    ----------------------------------------------------------------------------
+    目的：
+      - CPU 側のインデックスは常に 32bit（MeshData::Indices）。GPU へ送るときに最大値を調べ、
+        0xFFFF 以下なら 16bit（R16_UINT）に詰めて IB の帯域/メモリを半分にする。
+      - GeometryPool と MeshUploader の両方が使う純 CPU ヘルパ（単体で動作確認できる）。
+
+    設計メモ：
+      - 三角形リスト前提なので strip-cut 値（0xFFFF）も通常のインデックスとして扱う。
+      - CPU 側コピーは 32bit のまま残す（遮蔽ラスタライザと静的バッチ結合が 32bit で読むため）。
+*/
+
+/// 全インデックスが 16bit に収まるか（空なら false）
+bool FitsShortIndices(const std::uint32_t* indices, std::size_t count);
+
+/// 32bit → 16bit に詰める（FitsShortIndices を満たすこと）。out は上書き
+void PackShortIndices(const std::uint32_t* indices, std::size_t count, std::vector<std::uint16_t>& out);
+
+/// 収まる方の形式（R16_UINT / R32_UINT）
+DXGI_FORMAT ChooseIndexFormat(const std::uint32_t* indices, std::size_t count);
+
+/// 形式ごとの 1 インデックスのバイト数
+inline std::uint32_t IndexFormatSize(DXGI_FORMAT format)
+{
+    return format == DXGI_FORMAT_R16_UINT ? 2u : 4u;
+}
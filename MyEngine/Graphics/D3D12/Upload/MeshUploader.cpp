@@ -1,95 +1,174 @@
 #include "MeshUploader.h"
+#include "Upload/GpuUploadQueue.h"
+#include "Upload/IndexFormat.h"
+#include "Pipeline/VertexFormat.h"
 #include "Debug/DxDebug.h"
+#include "Assets/MeshCache.h"
+#include <algorithm>
 #include <cstring>
+#include <utility>
 #include <d3dx12.h>
 
 using Microsoft::WRL::ComPtr;
 
+static_assert(GpuVertexStreams::kStreamCount == _countof(MeshGPU{}.vbv), "MeshGPU::vbv はストリームごとに 1 つ");
+
+namespace
+{
+    // ストリームを前から順に並べた VB の中身を作り、ストリーム s の先頭オフセットを offsets[s] に返す
+    std::vector<unsigned char> PackVertexStreams(const MeshData& src, UINT (&offsets)[GpuVertexStreams::kStreamCount])
+    {
+        GpuVertexStreams::Arrays streams;
+        GpuVertexStreams::Encode(src.Vertices, streams);
+        const auto data = GpuVertexStreams::Data(streams);
+
+        std::vector<unsigned char> bytes;
+        for (std::size_t s = 0; s < GpuVertexStreams::kStreamCount; ++s)
+        {
+            const std::size_t size = src.Vertices.size() * GpuVertexStreams::kStrides[s];
+            offsets[s] = static_cast<UINT>(bytes.size()); // stride はどれも 4 の倍数なので各先頭も 4B 境界
+            bytes.insert(bytes.end(), static_cast<const unsigned char*>(data[s]),
+                static_cast<const unsigned char*>(data[s]) + size);
+        }
+        return bytes;
+    }
+
+    template <std::size_t... S>
+    void EncodeGpuStreams(const Vertex* src, std::size_t count, void* const* streams, std::index_sequence<S...>)
+    {
+        GpuVertexStreams::Encode(src, count, static_cast<typename GpuVertexStreams::Stream<S>::Packed*>(streams[S])...);
+    }
+
+    MeshCacheVertexFormat MakeGpuMeshCacheFormat()
+    {
+        static_assert(GpuVertexStreams::kStreamCount <= MeshCacheVertexFormat::kMaxStreams, ".mesh のストリーム数の上限");
+        MeshCacheVertexFormat f;
+        f.streamCount = static_cast<std::uint32_t>(GpuVertexStreams::kStreamCount);
+        for (std::size_t s = 0; s < GpuVertexStreams::kStreamCount; ++s) f.strides[s] = GpuVertexStreams::kStrides[s];
+        f.encode = [](const Vertex* src, std::size_t count, void* const* streams)
+            {
+                EncodeGpuStreams(src, count, streams, std::make_index_sequence<GpuVertexStreams::kStreamCount>{});
+            };
+
+        // 形式のキー：入力要素を並べたバイト列のハッシュ（ポインタではなくセマンティクスの文字列を入れる）
+        std::vector<unsigned char> desc;
+        auto append = [&desc](const void* p, std::size_t n)
+            { desc.insert(desc.end(), static_cast<const unsigned char*>(p), static_cast<const unsigned char*>(p) + n); };
+        for (const D3D12_INPUT_ELEMENT_DESC& e : GpuVertexStreams::kInputElements)
+        {
+            append(e.SemanticName, std::strlen(e.SemanticName) + 1);
+            const UINT fields[] = { e.SemanticIndex, static_cast<UINT>(e.Format), e.InputSlot, e.AlignedByteOffset };
+            append(fields, sizeof(fields));
+        }
+        append(GpuVertexStreams::kStrides.data(), GpuVertexStreams::kStrides.size() * sizeof(UINT));
+        f.key = HashBytes64(desc.data(), desc.size()) | 1; // 0 は無効
+        return f;
+    }
+
+    void SetVertexViews(ID3D12Resource* vb, const UINT (&offsets)[GpuVertexStreams::kStreamCount], UINT vertexCount,
+        D3D12_VERTEX_BUFFER_VIEW* views)
+    {
+        for (std::size_t s = 0; s < GpuVertexStreams::kStreamCount; ++s)
+        {
+            views[s].BufferLocation = vb->GetGPUVirtualAddress() + offsets[s]; // GPU 仮想アドレス
+            views[s].StrideInBytes = GpuVertexStreams::kStrides[s];           // 1 頂点のバイト数（詰めた形式）
+            views[s].SizeInBytes = vertexCount * GpuVertexStreams::kStrides[s];
+        }
+    }
+}
+
 /*
     CreateMesh
     ----------------------------------------------------------------------------
-    ړIF
-      - CPU ̃bVf[^ (MeshData: _zECfbNXz) 
-        DX12  Upload q[ṽobt@ɃRs[āA`ɕKv
-        GPU \[Xr[ (VBV/IBV) ZbgAbvB
-
-    F
-      - q[v UPLOADiCPU ݉EGPU ǂݎjgpB
-        _XVpxȂJc[pr/K̓bVɌB
-        pɂɕ`/傫bV DEFAULT q[v + Abv[hꎞobt@B
-      - s dxdbg::LogHRESULTError  HRESULT fobOo͂Afalse ԂB
-      - outiMeshGPUjɈȉl߂F
-          * vb / ib           : ComPtr<ID3D12Resource>iUpload obt@{́j
-          * vbv / ibv         : D3D12_VERTEX_BUFFER_VIEW / D3D12_INDEX_BUFFER_VIEW
-          * indexCount        : `ɎgCfbNX
-
-    OF
+    目的：
+      - CPU 側のメッシュデータ (MeshData: 頂点配列・インデックス配列) を
+        DX12 の Upload ヒープ上のバッファにコピーして、描画に必要な
+        GPU リソースビュー (VBV/IBV) をセットアップする。
+
+    特徴：
+      - ヒープは UPLOAD（CPU 書き込み可・GPU 読み取り可）を使用。
+        頂点数や更新頻度が少ない開発ツール用途/小規模メッシュに向く。
+        頻繁に描く/大きいメッシュは DEFAULT ヒープ + アップロード一時バッファ推奨。
+      - 失敗時は dxdbg::LogHRESULTError で HRESULT をデバッグ出力し、false を返す。
+      - out（MeshGPU）に以下を詰める：
+          * vb / ib           : ComPtr<ID3D12Resource>（Upload バッファ本体。vb はストリームを順に並べる）
+          * vbv[] / ibv       : D3D12_VERTEX_BUFFER_VIEW（ストリームごと）/ D3D12_INDEX_BUFFER_VIEW
+                                （ibv.Format は最大インデックスで R16_UINT / R32_UINT を選ぶ）
+          * indexCount        : 描画に使うインデックス数
+
+    前提：
       - dev != nullptr
-      - src.Vertices / src.Indices łȂ
-      - Vertex ̃CAEg PSO  InputLayout ƈvĂ邱
-
-    ӁF
-      - UPLOAD q[v CPU ANZX\Ȃ߁AGPU ̓ǂݏo͔rIxB
-        ptH[}Xd̍ŏIAvł́ADEFAULT q[vփRs[ĎgƁB
-      - Map/Unmap ͈̔ (CD3DX12_RANGE)  0,0 ɂ CPU ݐp̈Ӑ}ɂȂA
-        ǂݖ߂͂ȂƂhCo֓`iœKjB
+      - src.Vertices / src.Indices が空でない
+      - PSO の InputLayout は GpuVertexStreams::InputLayout()（VB は GpuVertexStreams に詰めて書く）
+
+    注意：
+      - UPLOAD ヒープは CPU アクセス可能なため、GPU からの読み出しは比較的遅い。
+        パフォーマンス重視の最終アプリでは、DEFAULT ヒープへコピーして使うこと。
+      - Map/Unmap の範囲 (CD3DX12_RANGE) を 0,0 にすると CPU 書き込み専用の意図になり、
+        読み戻しはしないことをドライバへ伝えられる（最適化）。
 */
 bool CreateMesh(ID3D12Device* dev, const MeshData& src, MeshGPU& out)
 {
-    // ̓`FbNF󃁃bV͐sv
+    // 入力チェック：空メッシュは生成不要
     if (src.Indices.empty() || src.Vertices.empty())
         return false;
 
-    // ׂ Upload q[vɍiJc[/yʃbV̊ȈՃpXj
-    // I DEFAULT q[vֈڍsȂAiK]ɒuB
+    // すべて Upload ヒープに作る（開発ツール/軽量メッシュ向けの簡易パス）
+    // 将来的に DEFAULT ヒープへ移行するなら、ここを二段階転送に置き換え。
     HRESULT hr;
     D3D12_HEAP_PROPERTIES heap = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
 
     // ==============================
-    // _obt@ (VB) ̐
+    // 頂点バッファ (VB) の生成
     // ==============================
-    const UINT vbSize = static_cast<UINT>(src.Vertices.size() * sizeof(Vertex));
+    // GPU 用の形式（量子化済み）でストリームごとに詰め、1 本のバッファに順に並べて書く
+    UINT streamOffsets[GpuVertexStreams::kStreamCount];
+    const std::vector<unsigned char> packedVertices = PackVertexStreams(src, streamOffsets);
+    const UINT vbSize = static_cast<UINT>(packedVertices.size());
 
-    // 1) \[X쐬iobt@j
+    // 1) リソース作成（バッファ）
     {
         D3D12_RESOURCE_DESC vbDesc = CD3DX12_RESOURCE_DESC::Buffer(vbSize);
         hr = dev->CreateCommittedResource(
-            &heap,                             // UPLOAD q[v
+            &heap,                             // UPLOAD ヒープ
             D3D12_HEAP_FLAG_NONE,
-            &vbDesc,                           // obt@
-            D3D12_RESOURCE_STATE_GENERIC_READ, // CPU  & GPU ǂݏo
+            &vbDesc,                           // バッファ
+            D3D12_RESOURCE_STATE_GENERIC_READ, // CPU 書き込み & GPU 読み出し
             nullptr,
             IID_PPV_ARGS(&out.vb));
         dxdbg::LogHRESULTError(hr, "Create VB");
         if (FAILED(hr)) return false;
     }
 
-    // 2) CPU f[^ށiMap  memcpy  Unmapj
+    // 2) CPU からデータを書き込む（Map → memcpy → Unmap）
     {
         UINT8* dst = nullptr;
-        CD3DX12_RANGE rr(0, 0); // ǂݖ߂iCPU ݐp̈Ӑ}j
+        CD3DX12_RANGE rr(0, 0); // 読み戻し無し（CPU 書き込み専用の意図）
         hr = out.vb->Map(0, &rr, reinterpret_cast<void**>(&dst));
         dxdbg::LogHRESULTError(hr, "VB Map");
         if (FAILED(hr)) return false;
 
-        // _f[^Ŝ Upload q[vփRs[
-        std::memcpy(dst, src.Vertices.data(), vbSize);
+        // 頂点データ全体を Upload ヒープへコピー
+        std::memcpy(dst, packedVertices.data(), vbSize);
 
-        // ݊iǂݖ߂Ȃߑ nullptrj
+        // 書き込み完了（読み戻さないため第二引数は nullptr）
         out.vb->Unmap(0, nullptr);
     }
 
-    // 3) VBV ̃ZbgAbviIA ɓn߂̃r[j
-    out.vbv.BufferLocation = out.vb->GetGPUVirtualAddress(); // GPU zAhX
-    out.vbv.StrideInBytes = sizeof(Vertex);                 // 1 _̃oCg
-    out.vbv.SizeInBytes = vbSize;                         // obt@Ŝ̃TCY
+    // 3) VBV のセットアップ（IA に渡すためのビュー情報。ストリームごとにバッファ内の範囲を指す）
+    SetVertexViews(out.vb.Get(), streamOffsets, static_cast<UINT>(src.Vertices.size()), out.vbv);
 
     // ==============================
-    // CfbNXobt@ (IB) ̐
+    // インデックスバッファ (IB) の生成
     // ==============================
-    const UINT ibSize = static_cast<UINT>(src.Indices.size() * sizeof(unsigned int));
+    // 16bit に収まるなら詰めてから書く（IB のメモリ/帯域が半分になる）
+    const DXGI_FORMAT ibFormat = ChooseIndexFormat(src.Indices.data(), src.Indices.size());
+    std::vector<std::uint16_t> packed;
+    if (ibFormat == DXGI_FORMAT_R16_UINT) PackShortIndices(src.Indices.data(), src.Indices.size(), packed);
+    const void* ibData = packed.empty() ? static_cast<const void*>(src.Indices.data()) : packed.data();
+    const UINT ibSize = static_cast<UINT>(src.Indices.size() * IndexFormatSize(ibFormat));
 
-    // 1) \[X쐬iobt@j
+    // 1) リソース作成（バッファ）
     {
         D3D12_RESOURCE_DESC ibDesc = CD3DX12_RESOURCE_DESC::Buffer(ibSize);
         hr = dev->CreateCommittedResource(
@@ -103,7 +182,7 @@ bool CreateMesh(ID3D12Device* dev, const MeshData& src, MeshGPU& out)
         if (FAILED(hr)) return false;
     }
 
-    // 2) CPU f[^ށiMap  memcpy  Unmapj
+    // 2) CPU からデータを書き込む（Map → memcpy → Unmap）
     {
         UINT8* dst = nullptr;
         CD3DX12_RANGE rr(0, 0);
@@ -111,23 +190,23 @@ bool CreateMesh(ID3D12Device* dev, const MeshData& src, MeshGPU& out)
         dxdbg::LogHRESULTError(hr, "IB Map");
         if (FAILED(hr)) return false;
 
-        std::memcpy(dst, src.Indices.data(), ibSize);
+        std::memcpy(dst, ibData, ibSize);
         out.ib->Unmap(0, nullptr);
     }
 
-    // 3) IBV ̃ZbgAbviIA ɓn߂̃r[j
+    // 3) IBV のセットアップ（IA に渡すためのビュー情報）
     out.ibv.BufferLocation = out.ib->GetGPUVirtualAddress();
-    out.ibv.Format = DXGI_FORMAT_R32_UINT;  // 32bit CfbNXisrc  uint32 Oj
+    out.ibv.Format = ibFormat;
     out.ibv.SizeInBytes = ibSize;
 
     // ==============================
-    // bV{
+    // メッシュ基本情報
     // ==============================
-    out.indexCount = static_cast<UINT>(src.Indices.size()); // DrawIndexedInstanced ɓn
+    out.indexCount = static_cast<UINT>(src.Indices.size()); // DrawIndexedInstanced に渡す数
 
     /*
-        giĂяojF
-          cmd->IASetVertexBuffers(0, 1, &out.vbv);
+        使い方メモ（呼び出し側）：
+          cmd->IASetVertexBuffers(0, 2, out.vbv);
           cmd->IASetIndexBuffer(&out.ibv);
           cmd->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
           cmd->DrawIndexedInstanced(out.indexCount, 1, 0, 0, 0);
@@ -135,3 +214,49 @@ bool CreateMesh(ID3D12Device* dev, const MeshData& src, MeshGPU& out)
 
     return true;
 }
+
+/*
+    CreateMesh（Default ヒープ版）
+    ----------------------------------------------------------------------------
+    - VB/IB を CreateStaticBuffer（DEFAULT / COMMON）で作り、queue.Enqueue で転送を積む。
+      バッファは COPY キューで暗黙に COPY_DEST へ昇格し、完了で COMMON に戻るのでバリア不要。
+    - out.uploadFence は VB/IB 両方の転送を含むフェンス値（同じ Submit なら同じ値）。
+    - IB の形式は Upload ヒープ版と同じく最大インデックスで決める。
+*/
+bool CreateMesh(ID3D12Device* dev, GpuUploadQueue& queue, const MeshData& src, MeshGPU& out)
+{
+    if (!dev || src.Indices.empty() || src.Vertices.empty())
+        return false;
+
+    UINT streamOffsets[GpuVertexStreams::kStreamCount];
+    const std::vector<unsigned char> packedVertices = PackVertexStreams(src, streamOffsets);
+    const UINT vbSize = static_cast<UINT>(packedVertices.size());
+    if (!CreateStaticBuffer(dev, vbSize, out.vb)) return false;
+    const std::uint64_t vbFence = queue.Enqueue(out.vb.Get(), 0, packedVertices.data(), vbSize);
+    if (vbFence == 0) return false;
+
+    SetVertexViews(out.vb.Get(), streamOffsets, static_cast<UINT>(src.Vertices.size()), out.vbv);
+
+    const DXGI_FORMAT ibFormat = ChooseIndexFormat(src.Indices.data(), src.Indices.size());
+    std::vector<std::uint16_t> packed;
+    if (ibFormat == DXGI_FORMAT_R16_UINT) PackShortIndices(src.Indices.data(), src.Indices.size(), packed);
+    const void* ibData = packed.empty() ? static_cast<const void*>(src.Indices.data()) : packed.data();
+    const UINT ibSize = static_cast<UINT>(src.Indices.size() * IndexFormatSize(ibFormat));
+    if (!CreateStaticBuffer(dev, ibSize, out.ib)) return false;
+    const std::uint64_t ibFence = queue.Enqueue(out.ib.Get(), 0, ibData, ibSize); // ステージングへコピー済みで戻る
+    if (ibFence == 0) return false;
+
+    out.ibv.BufferLocation = out.ib->GetGPUVirtualAddress();
+    out.ibv.Format = ibFormat;
+    out.ibv.SizeInBytes = ibSize;
+
+    out.indexCount = static_cast<UINT>(src.Indices.size());
+    out.uploadFence = std::max(vbFence, ibFence);
+    return true;
+}
+
+const MeshCacheVertexFormat& GpuMeshCacheFormat()
+{
+    static const MeshCacheVertexFormat format = MakeGpuMeshCacheFormat();
+    return format;
+}
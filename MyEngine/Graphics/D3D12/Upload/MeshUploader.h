@@ -1,90 +1,103 @@
 #pragma once
 #include <wrl/client.h>
 #include <d3d12.h>
+#include <cstdint>
 #include <vector>
+#include "Assets/Mesh.h"
+
+class GpuUploadQueue;
+struct MeshCacheVertexFormat;
 
 /*
 ===============================================================================
-Mesh / Vertex ̍ŏ`iDX12 j
+Mesh / Vertex 周りの最小定義（DX12 向け）
 -------------------------------------------------------------------------------
-F
-  - CPU bViMeshDataj GPU \[XiMeshGPUj𕪂ĊǗ
-  - CreateMesh()  Upload q[v VB/IB mۂ CPUGPU ɃRs[
-     {́u`܂ŏ펞}bvsvvuPESvړI
+役割：
+  - CPU 側メッシュ（MeshData、Assets/Mesh.h）と GPU 側リソース（MeshGPU）を分けて管理
+  - CreateMesh(dev, queue, ...) で Default ヒープに VB/IB を確保し、GpuUploadQueue で転送
+  - CreateMesh(dev, ...) は Upload ヒープに VB/IB を確保して CPU→GPU にコピー（簡易版）
+    ※ 簡易版は「描画まで常時マップ不要」「単純・安全」が目的
 
-ӁF
-  - {wb_ g^`ƍ쐬 API ̐錾h B .cpp  CreateMesh()B
-  - CfbNX 32bitiDXGI_FORMAT_R32_UINTjŒB
-    65k gȂȂ 16bit iR16_UINTjŃ/ш팸B
-  - Upload q[v CPU 珑\A`掞 L0/L1 LbVoR
-    ǂ܂邽߁A僁bV̏펞gpɂ͔񐄏iSTATIC f[^ Default q[vjB
-  - Default q[vɒuꍇ́AUpload Xe[WO{Rs[R}hKviʎjB
+注意：
+  - 本ヘッダは “型定義と作成 API の宣言” だけ。実装は .cpp 側の CreateMesh()。
+  - VB は GpuVertexStreams（Pipeline/VertexFormat.h）に詰めて作る。1 本のバッファにストリームを
+    前から順に並べ、vbv[s] はストリーム s（VB スロット s）の範囲を指す。PSO の InputLayout は
+    GpuVertexStreams::InputLayout() を使い、vbv は 2 本ともバインドすること
+    （位置だけのパスは vbv[0] だけでよい）。
+  - CPU 側のインデックスは 32bit。GPU 側は最大値が 0xFFFF 以下なら 16bit（R16_UINT）に詰め、
+    ibv.Format もそれに合わせる（IndexFormat.h）。描画側は ibv をそのまま使えばよい。
+  - Upload ヒープは CPU から書き換え可能だが、描画時も L0/L1 キャッシュ経由で
+    読まれるため、巨大メッシュの常時使用には非推奨（STATIC データは Default ヒープ推奨）。
+  - Default ヒープ版は転送完了まで描けない。uploadFence を queue.IsComplete で確かめること。
 ===============================================================================
 */
 
 // ------------------------------------------------------------
-// _tH[}bgij
-//  - ʒu (px,py,pz)
-//  - @ (nx,ny,nz)
-//  - F   (r,g,b,a)
-//   PSO  InputLayout ƍ킹邱ƁI
-// ------------------------------------------------------------
-struct Vertex
-{
-    float px, py, pz;
-    float nx, ny, nz;
-    float r, g, b, a;
-};
-
-// ------------------------------------------------------------
-// CPU bV
-//  - _z^CfbNXẑ݂ێiSTL Ǘj
-//  - CfbNX 32bitiunsigned intj
-// ------------------------------------------------------------
-struct MeshData
-{
-    std::vector<Vertex>       Vertices;
-    std::vector<unsigned int> Indices;
-};
-
-// ------------------------------------------------------------
-// GPU bV
-//  - VB/IB  ID3D12Resource ƁAIA pr[ێ
-//  - indexCount  DrawIndexedInstanced ̈ɂ̂܂܎gp\
+// GPU 側メッシュ
+//  - VB/IB の ID3D12Resource と、IA 用ビューを保持
+//  - indexCount は DrawIndexedInstanced の引数にそのまま使用可能
 // ------------------------------------------------------------
 struct MeshGPU
 {
-    Microsoft::WRL::ComPtr<ID3D12Resource> vb;  // Upload q[v VB
-    Microsoft::WRL::ComPtr<ID3D12Resource> ib;  // Upload q[v IB
-    D3D12_VERTEX_BUFFER_VIEW vbv{};              // IASetVertexBuffers p
-    D3D12_INDEX_BUFFER_VIEW  ibv{};              // IASetIndexBuffer p
-    UINT indexCount = 0;                         // Draw ɎgCfbNX
+    Microsoft::WRL::ComPtr<ID3D12Resource> vb;  // VB（Upload または Default ヒープ）
+    Microsoft::WRL::ComPtr<ID3D12Resource> ib;  // IB（Upload または Default ヒープ）
+    D3D12_VERTEX_BUFFER_VIEW vbv[2]{};           // IASetVertexBuffers 用（[0] = 位置、[1] = 法線/色）
+    D3D12_INDEX_BUFFER_VIEW  ibv{};              // IASetIndexBuffer 用
+    UINT indexCount = 0;                         // Draw に使う総インデックス数
+    std::uint64_t uploadFence = 0;               // 転送完了のフェンス値（Upload ヒープ版は 0 = 即描画可）
 };
 
 /*
 -------------------------------------------------------------------------------
 CreateMesh
-  TvF
-    - ^ꂽ CPU  MeshData gāAUpload q[v VB/IB mۂA
-      g Map/Rs[ MeshGPU 郆[eBeBB
-  F
+  概要：
+    - 与えられた CPU 側 MeshData を使って、Upload ヒープの VB/IB を確保し、
+      中身を Map/コピーして MeshGPU を初期化するユーティリティ。
+  引数：
     - dev : ID3D12Device*
-    - src : CPU bViVertices / Indices łȂƁj
-    - out : 쐬ꂽ GPU \[Xƃr[i[
-  ߂lF
-    -  true / s falseifoCX쐬sAMap sA͂Ȃǁj
-  gijF
+    - src : CPU 側メッシュ（Vertices / Indices が空でないこと）
+    - out : 作成された GPU リソースとビューが格納される
+  戻り値：
+    - 成功 true / 失敗 false（デバイス作成失敗、Map 失敗、入力が空など）
+  使い方（例）：
     MeshGPU gpu;
     MeshData cpu = LoadMyMesh();
     if (CreateMesh(device, cpu, gpu)) {
-        cmd->IASetVertexBuffers(0, 1, &gpu.vbv);
+        cmd->IASetVertexBuffers(0, 2, gpu.vbv);
         cmd->IASetIndexBuffer(&gpu.ibv);
         cmd->DrawIndexedInstanced(gpu.indexCount, 1, 0, 0, 0);
     }
 
-  F
-    - Upload q[vȂ̂ł̂܂ Draw \iK̓bV/c[/fobOjB
-    -  or px` Default q[vֈڂ݌viptH[}XjB
+  メモ：
+    - Upload ヒープなのでそのまま Draw 可能（小規模メッシュ/ツール/デバッグ向け）。
+    - 大量 or 高頻度描画は Default ヒープへ移す設計を検討（パフォーマンス向上）。
 -------------------------------------------------------------------------------
 */
 bool CreateMesh(ID3D12Device* dev, const MeshData& src, MeshGPU& out);
+
+/*
+-------------------------------------------------------------------------------
+CreateMesh（Default ヒープ版）
+  概要：
+    - VB/IB を Default ヒープ（COMMON 状態）に作り、中身は queue のステージング経由で
+      COPY キューから送る。ここでは積むだけで、提出は queue.Submit() のとき。
+  戻り値：
+    - 成功 true（out.uploadFence に完了フェンスが入る）/ 失敗 false
+  使い方（例）：
+    if (CreateMesh(device, uploads, cpu, gpu)) { ... uploads.Submit(); }
+    // 描く前に：if (uploads.IsComplete(gpu.uploadFence)) { ... }
+-------------------------------------------------------------------------------
+*/
+bool CreateMesh(ID3D12Device* dev, GpuUploadQueue& queue, const MeshData& src, MeshGPU& out);
+
+/*
+-------------------------------------------------------------------------------
+GpuMeshCacheFormat
+  概要：
+    - .mesh キャッシュ（Assets/MeshCache.h）に書く GPU 頂点形式の記述。
+      ストリームと stride は GpuVertexStreams のもの、encode は GpuVertexStreams::Encode。
+    - key は入力要素（セマンティクス/形式/スロット/オフセット）と stride のハッシュ。
+      VertexFormat.h の形式を変えると key が変わり、古い .mesh は作り直しになる。
+-------------------------------------------------------------------------------
+*/
+const MeshCacheVertexFormat& GpuMeshCacheFormat();
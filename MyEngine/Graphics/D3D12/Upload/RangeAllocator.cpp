@@ -0,0 +1,173 @@
+﻿#include "Upload/RangeAllocator.h"
+#include <algorithm>
+
+/*
+    RangeAllocator
+    ----------------------------------------------------------------------------
+    不変条件：
+      - m_freeByOffset と m_freeBySize は同じ空き区間の集合を持つ。
+      - 空き区間どうしは隣接しない（InsertFree が必ず結合する）。
+      - 生きている区間 + 空き区間 + アラインの前余り（切り出し時に空きへ戻すので 0）= 容量。
+    Allocate（best-fit）：
+      - 大きさ順の表を size 以上から順に見て、アライン後に収まる最初の区間を使う。
+        align == 1 なら最初の候補で必ず収まる。
+*/
+
+namespace
+{
+    std::uint64_t AlignUp(std::uint64_t v, std::uint64_t a) { return (v + (a - 1)) / a * a; }
+}
+
+void RangeAllocator::Reset(std::uint64_t capacity)
+{
+    m_capacity = capacity;
+    m_used = 0;
+    m_freeTotal = 0;
+    m_liveCount = 0;
+    m_freeByOffset.clear();
+    m_freeBySize.clear();
+    m_blocks.clear();
+    m_freeHandles.clear();
+    if (capacity > 0) InsertFree(0, capacity);
+}
+
+void RangeAllocator::EraseFree(std::map<std::uint64_t, std::uint64_t>::iterator it)
+{
+    m_freeBySize.erase({ it->second, it->first });
+    m_freeTotal -= it->second;
+    m_freeByOffset.erase(it);
+}
+
+void RangeAllocator::InsertFree(std::uint64_t offset, std::uint64_t size)
+{
+    if (size == 0) return;
+
+    // 後ろの空きと結合
+    auto next = m_freeByOffset.find(offset + size);
+    if (next != m_freeByOffset.end())
+    {
+        size += next->second;
+        EraseFree(next);
+    }
+    // 前の空きと結合
+    auto prev = m_freeByOffset.lower_bound(offset);
+    if (prev != m_freeByOffset.begin())
+    {
+        --prev;
+        if (prev->first + prev->second == offset)
+        {
+            offset = prev->first;
+            size += prev->second;
+            EraseFree(prev);
+        }
+    }
+
+    m_freeByOffset.emplace(offset, size);
+    m_freeBySize.insert({ size, offset });
+    m_freeTotal += size;
+}
+
+std::uint32_t RangeAllocator::Allocate(std::uint64_t size, std::uint64_t align)
+{
+    if (size == 0 || size > m_freeTotal) return kInvalid;
+    if (align == 0) align = 1;
+
+    for (auto it = m_freeBySize.lower_bound({ size, 0 }); it != m_freeBySize.end(); ++it)
+    {
+        const std::uint64_t blockOffset = it->second;
+        const std::uint64_t blockSize = it->first;
+        const std::uint64_t offset = AlignUp(blockOffset, align);
+        if (offset + size > blockOffset + blockSize) continue;
+
+        // 空き区間を外し、前余り/後ろ余りを空きに戻す（どちらも隣は使用中なので結合は起きない）
+        EraseFree(m_freeByOffset.find(blockOffset));
+        InsertFree(blockOffset, offset - blockOffset);
+        InsertFree(offset + size, blockOffset + blockSize - (offset + size));
+
+        std::uint32_t handle;
+        if (!m_freeHandles.empty())
+        {
+            handle = m_freeHandles.back();
+            m_freeHandles.pop_back();
+        }
+        else
+        {
+            handle = static_cast<std::uint32_t>(m_blocks.size());
+            m_blocks.emplace_back();
+        }
+        m_blocks[handle] = { offset, size, align, true };
+        m_used += size;
+        ++m_liveCount;
+        return handle;
+    }
+    return kInvalid;
+}
+
+void RangeAllocator::Free(std::uint32_t handle)
+{
+    if (!IsLive(handle)) return;
+    Block& b = m_blocks[handle];
+    b.live = false;
+    m_used -= b.size;
+    --m_liveCount;
+    InsertFree(b.offset, b.size);
+    m_freeHandles.push_back(handle);
+}
+
+void RangeAllocator::Grow(std::uint64_t newCapacity)
+{
+    if (newCapacity <= m_capacity) return;
+    const std::uint64_t old = m_capacity;
+    m_capacity = newCapacity;
+    InsertFree(old, newCapacity - old);
+}
+
+void RangeAllocator::Compact(std::vector<RangeMove>& moves)
+{
+    moves.clear();
+
+    std::vector<std::uint32_t> live;
+    live.reserve(m_liveCount);
+    for (std::uint32_t h = 0; h < m_blocks.size(); ++h)
+        if (m_blocks[h].live) live.push_back(h);
+    std::sort(live.begin(), live.end(),
+        [this](std::uint32_t a, std::uint32_t b) { return m_blocks[a].offset < m_blocks[b].offset; });
+
+    // 位置順に詰めるので、移動先は常に移動元以下（同じバッファ内でも前から順に移せば重ならない）
+    std::uint64_t cursor = 0;
+    for (std::uint32_t h : live)
+    {
+        Block& b = m_blocks[h];
+        cursor = AlignUp(cursor, b.align);
+        if (b.offset != cursor)
+        {
+            moves.push_back({ h, b.offset, cursor, b.size });
+            b.offset = cursor;
+        }
+        cursor += b.size;
+    }
+
+    m_freeByOffset.clear();
+    m_freeBySize.clear();
+    m_freeTotal = 0;
+    // アラインの隙間も空きに戻す（次の Compact まで再利用できる）
+    std::uint64_t end = 0;
+    for (std::uint32_t h : live)
+    {
+        const Block& b = m_blocks[h];
+        InsertFree(end, b.offset - end);
+        end = b.offset + b.size;
+    }
+    InsertFree(end, m_capacity - end);
+}
+
+std::uint64_t RangeAllocator::LargestFree() const
+{
+    return m_freeBySize.empty() ? 0 : m_freeBySize.rbegin()->first;
+}
+
+float RangeAllocator::Fragmentation() const
+{
+    if (m_freeTotal == 0) return 0.0f;
+    return 1.0f - static_cast<float>(LargestFree()) / static_cast<float>(m_freeTotal);
+}
@@ -0,0 +1,103 @@
+﻿#pragma once
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+/*
+    RangeAllocator
+    ----------------------------------------------------------------------------
+    目的：
+      - 1 本の大きなバッファ（GeometryPool の VB/IB）を「要素数の区間」で切り分けるサブアロケータ。
+        GPU には依存しない純 CPU コード（単体で動作確認できる）。
+      - 区間はハンドルで識別する。Compact で位置が変わってもハンドルはそのまま使える。
+
+    空き管理（free-list）：
+      - 空き区間を「位置順（隣接の結合用）」と「大きさ順（best-fit 用）」の 2 つの表で持つ。
+      - Allocate は要求を満たす最小の空き区間から切り出す（アライン分の前余りも空きに戻す）。
+      - Free は前後の空き区間と結合する（隣り合う空きは常に 1 つにまとまっている）。
+
+    断片化：
+      - 空きの合計は足りるのに 1 区間に収まらない状態は Fragmentation() で測れる。
+      - Compact は生きている区間を位置順に先頭から詰め直し、空きを末尾の 1 区間にまとめる。
+        動かした区間は RangeMove で返すので、呼び出し側がデータを移す（GPU なら新しいバッファへコピー）。
+      - Grow は末尾に空きを足す（中身は動かない）。
+
+    設計メモ：
+      - 単位は呼び出し側が決める（GeometryPool は頂点数/インデックス数）。
+      - スレッドセーフではない。
+*/
+
+/// Compact で動いた区間（[from, from + size) → [to, to + size)）
+struct RangeMove
+{
+    std::uint32_t handle = 0;
+    std::uint64_t from = 0;
+    std::uint64_t to = 0;
+    std::uint64_t size = 0;
+};
+
+class RangeAllocator
+{
+public:
+    static constexpr std::uint32_t kInvalid = 0xFFFFFFFFu;
+
+    /// 容量を決めて空にする（すべてのハンドルは無効になる）
+    void Reset(std::uint64_t capacity);
+
+    /**
+     * @brief size 要素の区間を align 境界で切り出す（best-fit）
+     * @return ハンドル。収まる空き区間が無ければ kInvalid（状態は変えない）
+     */
+    std::uint32_t Allocate(std::uint64_t size, std::uint64_t align = 1);
+
+    /// 区間を空きに戻して前後と結合する（kInvalid や二重解放は無視）
+    void Free(std::uint32_t handle);
+
+    /// 末尾に空きを足して容量を newCapacity にする（小さくはしない）
+    void Grow(std::uint64_t newCapacity);
+
+    /**
+     * @brief 生きている区間を先頭から詰め直す（align は各区間の Allocate 時の値を守る）
+     * @param moves 動かした区間（位置の昇順）。上書きする
+     */
+    void Compact(std::vector<RangeMove>& moves);
+
+    bool          IsLive(std::uint32_t handle) const { return handle < m_blocks.size() && m_blocks[handle].live; }
+    std::uint64_t Offset(std::uint32_t handle) const { return m_blocks[handle].offset; }
+    std::uint64_t Size(std::uint32_t handle) const { return m_blocks[handle].size; }
+
+    std::uint64_t Capacity() const { return m_capacity; }
+    std::uint64_t Used() const { return m_used; }                    ///< 生きている区間の合計（アライン余りは含まない）
+    std::uint64_t FreeTotal() const { return m_freeTotal; }          ///< 空き区間の合計
+    std::uint64_t LargestFree() const;                               ///< 最大の空き区間
+    std::size_t   FreeBlocks() const { return m_freeByOffset.size(); }
+    std::uint32_t LiveCount() const { return m_liveCount; }
+    std::uint32_t HandleCount() const { return static_cast<std::uint32_t>(m_blocks.size()); } ///< ハンドルの上限（走査用）
+
+    /// 断片化率：1 - 最大の空き / 空きの合計（0 = 空きは 1 区間にまとまっている）
+    float Fragmentation() const;
+
+private:
+    struct Block
+    {
+        std::uint64_t offset = 0;
+        std::uint64_t size = 0;
+        std::uint64_t align = 1;
+        bool          live = false;
+    };
+
+    void InsertFree(std::uint64_t offset, std::uint64_t size); ///< 前後と結合して空きに加える
+    void EraseFree(std::map<std::uint64_t, std::uint64_t>::iterator it);
+
+    std::uint64_t m_capacity = 0;
+    std::uint64_t m_used = 0;
+    std::uint64_t m_freeTotal = 0;
+    std::uint32_t m_liveCount = 0;
+
+    std::map<std::uint64_t, std::uint64_t>            m_freeByOffset; ///< 位置 → 大きさ
+    std::set<std::pair<std::uint64_t, std::uint64_t>> m_freeBySize;   ///< (大きさ, 位置)
+    std::vector<Block>                                m_blocks;       ///< ハンドル → 区間
+    std::vector<std::uint32_t>                        m_freeHandles;  ///< 再利用できるハンドル
+};
@@ -0,0 +1,82 @@
+﻿#include "Upload/StagingRing.h"
+
+/*
+    StagingRing
+    ----------------------------------------------------------------------------
+    空き判定：
+      - 使用中が空（m_used == 0）なら head/tail を 0 に戻す（断片を残さない）。
+      - head >= tail（折り返していない）：[head, capacity) に入れば取る。
+        入らなければ [head, capacity) を詰め物として捨て、[0, tail) に入れば先頭から取る。
+      - head < tail（折り返し中）：[head, tail) に入る場合だけ取る。
+    詰め物（アライン/末尾の捨て分）も使用量に数え、同じフェンスで一緒に解放する。
+*/
+
+namespace
+{
+    std::uint64_t AlignUp(std::uint64_t v, std::uint64_t a) { return (v + (a - 1)) & ~(a - 1); }
+}
+
+void StagingRing::Reset(std::uint64_t capacity)
+{
+    m_capacity = capacity;
+    m_head = m_tail = 0;
+    m_used = 0;
+    m_openBytes = 0;
+    m_retired.clear();
+}
+
+std::uint64_t StagingRing::Allocate(std::uint64_t bytes, std::uint64_t align)
+{
+    if (bytes == 0) bytes = 1;
+    if (align == 0) align = 1;
+    if (bytes > m_capacity) return kInvalid;
+
+    if (m_used == 0) m_head = m_tail = 0;
+
+    std::uint64_t offset = AlignUp(m_head, align);
+    std::uint64_t consumed = 0;
+    if (m_used == 0 || m_head > m_tail)
+    {
+        if (offset + bytes <= m_capacity)
+        {
+            consumed = (offset - m_head) + bytes;
+        }
+        else
+        {
+            // 末尾に入らない：残りを捨てて先頭から（先頭側は tail まで空いている）
+            if (bytes > m_tail) return kInvalid;
+            consumed = (m_capacity - m_head) + bytes;
+            offset = 0;
+        }
+    }
+    else
+    {
+        // 折り返し中（head <= tail かつ使用中あり）：tail までしか使えない
+        if (offset + bytes > m_tail) return kInvalid;
+        consumed = (offset - m_head) + bytes;
+    }
+
+    m_head = offset + bytes;
+    if (m_head == m_capacity) m_head = 0;
+    m_used += consumed;
+    m_openBytes += consumed;
+    return offset;
+}
+
+void StagingRing::Retire(std::uint64_t fenceValue)
+{
+    if (m_openBytes == 0) return;
+    m_retired.push_back({ fenceValue, m_head, m_openBytes });
+    m_openBytes = 0;
+}
+
+void StagingRing::Reclaim(std::uint64_t completedFence)
+{
+    while (!m_retired.empty() && m_retired.front().fence <= completedFence)
+    {
+        const Block& b = m_retired.front();
+        m_tail = b.end;
+        m_used -= b.bytes;
+        m_retired.pop_front();
+    }
+}
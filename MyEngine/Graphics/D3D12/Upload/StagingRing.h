@@ -0,0 +1,70 @@
+﻿#pragma once
+#include <cstdint>
+#include <deque>
+
+/*
+    StagingRing
+    ----------------------------------------------------------------------------
+    目的：
+      - 固定サイズのステージングバッファ（UPLOAD ヒープ、常時 Map）を先頭から循環して切り出す
+        オフセット管理だけを行う。GPU には依存しない純 CPU コード（単体で動作確認できる）。
+      - 切り出した領域は「それを読むコピーを提出したときのフェンス値」で退役させ、
+        GPU（COPY キュー）がそのフェンスに到達したら再利用できるようにする。
+
+    状態：
+        [tail ........ head) が使用中（提出待ち + GPU 転送中）。head が末尾に届いたら 0 へ折り返す。
+        1 回の切り出しは末尾をまたがない（届かない分は詰め物として捨てて先頭から取る）。
+
+    想定フロー（GpuUploadQueue）：
+      1) Allocate(bytes, align) …… 失敗（kInvalid）なら満杯。古い転送の完了を待って Reclaim する
+      2) Retire(fence)          …… 直前の Retire 以降に切り出した分（詰め物込み）を fence に結び付ける
+      3) Reclaim(completed)     …… completed 以下で退役した分を解放する（FIFO）
+
+    設計メモ：
+      - Capacity を超える要求は常に失敗する。呼び出し側で Capacity 以下に分割すること。
+      - フェンス値は単調増加が前提。スレッドセーフではない。
+*/
+class StagingRing
+{
+public:
+    static constexpr std::uint64_t kInvalid = ~0ull;
+
+    /// 容量を決めて空にする（以前の退役待ちも捨てる）
+    void Reset(std::uint64_t capacity);
+
+    /**
+     * @brief bytes バイトを align 境界で切り出す
+     * @param align 2 の冪
+     * @return 先頭オフセット。空きが足りなければ kInvalid（状態は変えない）
+     */
+    std::uint64_t Allocate(std::uint64_t bytes, std::uint64_t align = 16);
+
+    /// 直前の Retire 以降に切り出した領域を fenceValue で退役させる（何も無ければ何もしない）
+    void Retire(std::uint64_t fenceValue);
+
+    /// completedFence 以下の値で退役した領域を解放する
+    void Reclaim(std::uint64_t completedFence);
+
+    /// 最も古い退役待ちのフェンス値（無ければ 0）。満杯時に待つ相手
+    std::uint64_t OldestFence() const { return m_retired.empty() ? 0 : m_retired.front().fence; }
+
+    std::uint64_t Capacity() const { return m_capacity; }
+    std::uint64_t Used() const { return m_used; }            ///< 使用中のバイト数（詰め物込み）
+    std::uint64_t PendingBytes() const { return m_openBytes; } ///< まだ Retire していないバイト数
+    bool          HasRetired() const { return !m_retired.empty(); }
+
+private:
+    struct Block
+    {
+        std::uint64_t fence = 0;
+        std::uint64_t end = 0;   ///< この退役分の終わり（解放後の tail）
+        std::uint64_t bytes = 0; ///< 詰め物込みのバイト数
+    };
+
+    std::uint64_t     m_capacity = 0;
+    std::uint64_t     m_head = 0;      ///< 次に切り出す位置
+    std::uint64_t     m_tail = 0;      ///< 最も古い使用中領域の先頭
+    std::uint64_t     m_used = 0;      ///< [tail, head) のバイト数（head == tail のとき空/満杯の区別に使う）
+    std::uint64_t     m_openBytes = 0; ///< 最後の Retire 以降に使ったバイト数
+    std::deque<Block> m_retired;       ///< 先頭 = 最も古い
+};
@@ -21,6 +21,9 @@
 // RT/遅延破棄ハンドル型（ローカルで使うだけなので cpp にて include）
 #include "Core/RenderTarget.h"
 
+// .mesh キャッシュの GPU 頂点形式（GpuMeshCacheFormat）
+#include "Upload/MeshUploader.h"
+
 using Microsoft::WRL::ComPtr;
 
 #ifdef max
@@ -65,7 +68,7 @@ D3D12Renderer::~D3D12Renderer() { Cleanup(); }
 
     流れ：
       1) DeviceResources（デバイス/スワップチェイン/RTV/DSV/キュー）
-      2) FrameResources（各フレームのコマンドアロケータ＋アップロード CB）
+      2) FrameResources（各フレームのコマンドアロケータ＋アップロードリング）
       3) フェンスとイベント
       4) パイプライン（Lambert）構築
       5) SceneLayer 初期化（初期サイズを渡して RT を生成）
@@ -84,15 +87,14 @@ bool D3D12Renderer::Initialize(HWND hwnd, UINT width, UINT height)
 
     ID3D12Device* dev = m_dev->GetDevice();
 
-    // FrameResources：各フレームにコマンドアロケータと Upload CB を用意
-    // ※ MaxObjects×2：Scene と Game の 2 セット分を 1 フレームで使い分ける想定
-    if (!m_frames.Initialize(dev, FrameCount, sizeof(SceneConstantBuffer), MaxObjects * 2))
+    // FrameResources：各フレームにコマンドアロケータ、全フレーム共有の UploadRing を用意
+    // ※ 定数/インスタンスデータはページ単位で伸びるので、オブジェクト数に上限は無い
+    if (!m_frames.Initialize(dev, FrameCount, UploadPageSize))
         return false;
 
     // Fence：CPU-GPU 同期のためのフェンスと OS イベント
     HRESULT hr = dev->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_fence));
     if (FAILED(hr)) return false;
-    m_nextFence = 1;
     m_fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
     if (!m_fenceEvent) return false;
 
@@ -112,6 +114,19 @@ bool D3D12Renderer::Initialize(HWND hwnd, UINT width, UINT height)
         m_dev->GetRTVFormat(), m_dev->GetDSVFormat(), FrameCount))
         return false;
 
+    // メッシュ転送：専用 COPY キュー + 常時 Map のステージング（VB/IB は DEFAULT ヒープへ送る）
+    if (!m_uploads.Initialize(dev, MeshStagingSize))
+        return false;
+
+    // 共有 VB/IB：作り直しで外した旧バッファは、参照しうるフレームが終わるまで UploadRing に預ける
+    // 頂点は位置/属性の 2 ストリーム（GpuVertexStreams）。プールはストリームごとに VB を持つ
+    static_assert(GpuVertexStreams::kStreamCount == MeshRendererComponent::kVertexStreamCount, "VB スロット数の食い違い");
+    if (!m_geometry.Initialize(dev, &m_uploads, GpuVertexStreams::kStrides.data(), GpuVertexStreams::kStreamCount,
+        GeometryPool::kDefaultVertexCapacity, GeometryPool::kDefaultIndexCapacity, GeometryPool::kDefaultWideIndexCapacity,
+        [this](Microsoft::WRL::ComPtr<ID3D12Resource> old) { m_frames.Upload().DeferRelease(std::move(old)); }))
+        return false;
+    m_geometryGeneration = m_geometry.Generation();
+
     // フレームスケジューラ（Present, Signal, 遅延破棄 Collect まで）
     m_scheduler.Initialize(m_dev.get(), m_fence.Get(), m_fenceEvent, &m_frames, &m_garbage);
 
@@ -132,6 +147,7 @@ bool D3D12Renderer::Initialize(HWND hwnd, UINT width, UINT height)
 /*
     Render
     ----------------------------------------------------------------------------
+    0) PumpMeshUploads：ロードで溜まったメッシュ転送を提出し、完了したものを描画対象へ
     1) BeginFrame：バックバッファインデックスの確定、前フレームの待ち、コマンドリストのリセット
     2) Viewports：前フレの“確定済みリサイズ”を適用（古い RT を detach）
        - detach された RT は今フレームの EndFrame で遅延破棄へ（最大 1 個）
@@ -146,6 +162,9 @@ bool D3D12Renderer::Initialize(HWND hwnd, UINT width, UINT height)
 */
 void D3D12Renderer::Render()
 {
+    // --- 0) メッシュ転送の提出と完了確認 ---
+    PumpMeshUploads();
+
     // --- 1) BeginFrame ---
     auto begin = m_scheduler.BeginFrame();
     const UINT fi = begin.frameIndex;
@@ -177,7 +196,10 @@ void D3D12Renderer::Render()
         args.frameIndex = fi;
         args.scene = m_CurrentScene.get();
         args.camera = m_Camera.get();
-        m_sceneLayer.Record(args, /*maxObjects=*/MaxObjects);
+        m_sceneLayer.Record(args);
+
+        // 並列記録でリストが継ぎ足されていれば、以降（Presenter/ImGui）はその続きに積む
+        cmd = m_scheduler.GetCmd();
     }
 
     // --- 4) Presenter.Begin：バックバッファを描ける状態へ ---
@@ -211,6 +233,18 @@ void D3D12Renderer::Render()
     ctx.pRequestResetLayout = &s_resetLayout;
     ctx.pAutoRelayout = &s_autoRelayout;
 
+    // 共有 VB/IB の使用量（プールはシーンごとに Clear するので、そのままシーン単位の値になる）
+    {
+        const GeometryPoolStats gs = m_geometry.Stats();
+        ctx.meshVertexBytes = gs.vertexUsed * gs.vertexStride;
+        ctx.meshVertexStride = gs.vertexStride;
+        ctx.meshPositionStride = gs.positionStride;
+        ctx.meshIndexBytes = gs.indexBytes;
+        ctx.meshIndexBytesSaved = gs.indexBytesSaved;
+        ctx.meshShortIndexCount = gs.shortIndexUsed;
+        ctx.meshIndexCount = gs.indexUsed + gs.shortIndexUsed;
+    }
+
     // 念のためもう一度 Sync（rtWidth/rtHeight は上書きしない）
     m_sceneLayer.SyncStatsTo(ctx);
 
@@ -274,12 +308,17 @@ void D3D12Renderer::Cleanup()
     // ImGui のシャットダウン
     if (m_imgui) { m_imgui->Shutdown(); m_imgui.reset(); }
 
+    // 転送中のメッシュを待ってから COPY キューを畳む
+    m_uploads.Destroy();
+    m_pendingMeshes.clear();
+
     // シーン側の GPU リソース解放（メッシュ VB/IB 等）
     ReleaseSceneResources();
 
     // 念のため完全待機 → 遅延破棄をすべて Flush
-    WaitForGPU();
+    m_scheduler.WaitIdle();
     m_garbage.FlushAll();
+    m_geometry.Destroy();
 
     // フレームリソース破棄（Map 解除等）
     m_frames.Destroy();
@@ -295,20 +334,29 @@ void D3D12Renderer::Cleanup()
 //==============================================================================
 
 /*
-    WaitForGPU
+    PumpMeshUploads
     ----------------------------------------------------------------------------
-    現在キューに積まれている仕事が完了するまで待つ。
-    “今この時点まで”の仕事の完了をフェンスで確認する用途。
+    - CreateMeshRendererResources が積んだコピーを 1 回の ExecuteCommandLists で提出する
+      （ロード中に何個作っても提出はフレームに 1 回）。
+    - COPY キューが到達したフェンスを見て、転送済みのメッシュを GpuReady に戻す。
+      DIRECT キューは COPY キューを待たない（CPU で完了を確認したものだけを描く）。
 */
-void D3D12Renderer::WaitForGPU() noexcept
+void D3D12Renderer::PumpMeshUploads()
 {
-    if (!m_dev || !m_fence) return;
-    const UINT64 v = ++m_nextFence;
-    if (FAILED(m_dev->GetQueue()->Signal(m_fence.Get(), v))) return;
-    if (m_fence->GetCompletedValue() < v) {
-        if (SUCCEEDED(m_fence->SetEventOnCompletion(v, m_fenceEvent)))
-            WaitForSingleObject(m_fenceEvent, INFINITE);
-    }
+    m_uploads.Submit();
+    m_uploads.Update();
+    if (m_pendingMeshes.empty()) return;
+
+    auto done = [this](const std::weak_ptr<MeshRendererComponent>& w)
+        {
+            auto mr = w.lock();
+            if (!mr) return true;
+            if (!m_uploads.IsComplete(mr->UploadFence)) return false;
+            mr->GpuReady = true;
+            return true;
+        };
+    m_pendingMeshes.erase(std::remove_if(m_pendingMeshes.begin(), m_pendingMeshes.end(), done),
+        m_pendingMeshes.end());
 }
 
 /*
@@ -323,74 +371,503 @@ void D3D12Renderer::DrawMesh(MeshRendererComponent* mr)
     ID3D12GraphicsCommandList* cmd = m_scheduler.GetCmd();
     if (!cmd) return;
 
-    cmd->IASetVertexBuffers(0, 1, &mr->VertexBufferView);
+    cmd->IASetVertexBuffers(0, MeshRendererComponent::kVertexStreamCount, mr->VertexBufferViews);
     cmd->IASetIndexBuffer(&mr->IndexBufferView);
     cmd->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    cmd->DrawIndexedInstanced(mr->IndexCount, 1, 0, 0, 0);
+    cmd->DrawIndexedInstanced(mr->IndexCount, 1, mr->StartIndex, mr->BaseVertex, 0);
 }
 
 /*
     CreateMeshRendererResources
     ----------------------------------------------------------------------------
-    MeshRendererComponent の MeshData（CPU 側）から、Upload ヒープに VB/IB を作成。
-    小規模/開発ツール向け。パフォーマンスを求めるなら DEFAULT ヒープ＋コピーへ移行。
+    MeshRendererComponent の MeshData（CPU 側）を、GeometryPool の共有 VB/IB（DEFAULT ヒープ）に置く。
+      - 頂点/インデックスの区間を切り出し、mr には共有 VB/IB のビューと StartIndex/BaseVertex を設定する。
+      - 中身は m_uploads（COPY キュー）のステージング経由で送る。ここでは積むだけで、
+        提出は次の Render 先頭（PumpMeshUploads）。
+      - 転送が終わるまで mr->GpuReady = false（SceneRenderer は描画候補にしない）。
+        完了フェンスは mr->UploadFence に入れ、m_pendingMeshes で完了を見張る。
+
+    メッシュ共有：
+      - 頂点/インデックス（LOD があれば LOD のインデックスと段の表も）のバイト列の XXH64（HashBytes64）
+        をキーに m_meshCache を引き、同じ内容のメッシュが既にあれば区間をそのまま共有する（users に加える）。
+      - キーが一致しても、エントリの生きている users の 1 つと中身をバイト単位で比べてから共有する。
+        違えば（衝突）次のキーへずらす。生きている users がいないエントリ（解放待ち）とは共有しない。
+      - 同じ区間を指す MeshRenderer は SceneRenderer でインスタンス描画にまとまる。
+      - 作り直し（LOD を足した等）のときは、前に登録したエントリの users から外してから引き直す。
+
+    LOD：
+      - mr->GetLods() があれば、インデックスは LOD0 → LOD1 → … の順に続けて 1 区間に置く。
+        頂点は全段で共有（MeshSimplifier は頂点を動かさない）なので BaseVertex も共通。
+
+    .mesh キャッシュ（SetMeshFromCache）：
+      - mr->GetMeshCache() の形式が GpuMeshCacheFormat と同じなら、詰め済みの頂点ストリームと
+        インデックス（同じ LOD0 → LOD1 … の並び）を GeometryPool::UploadPacked でそのまま送る。
+        共有表のキーは通常の経路と同じ HashMeshData（CPU 側へコピー済みの中身）なので、
+        同じメッシュを SetMesh と SetMeshFromCache の両方で設定しても区間は 1 組になる。
+      - 送ったら（または共有できたら）mr は cache を手放す（マップを閉じられるように）。
 */
+namespace
+{
+    // 要素数 → 頂点 → インデックス →（LOD のインデックス → 段の表）の順に seed をつないで 1 つのキーにする
+    std::uint64_t HashMeshData(const MeshData& md, const MeshLods* lods)
+    {
+        const bool hasLods = lods && !lods->Levels.empty();
+        const std::uint64_t counts[4] = { md.Vertices.size(), md.Indices.size(),
+            hasLods ? lods->Indices.size() : 0, hasLods ? lods->Levels.size() : 0 };
+        std::uint64_t h = HashBytes64(counts, sizeof(counts));
+        h = HashBytes64(md.Vertices.data(), md.Vertices.size() * sizeof(Vertex), h);
+        h = HashBytes64(md.Indices.data(), md.Indices.size() * sizeof(uint32_t), h);
+        if (hasLods)
+        {
+            h = HashBytes64(lods->Indices.data(), lods->Indices.size() * sizeof(uint32_t), h);
+            h = HashBytes64(lods->Levels.data(), lods->Levels.size() * sizeof(MeshLodLevel), h);
+        }
+        return h;
+    }
+
+    template <class T>
+    bool SameBytes(const std::vector<T>& a, const std::vector<T>& b)
+    {
+        return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+    }
+
+    // HashMeshData のキーが一致したときの確認（同じバイト列を比べる。lods が null なら LOD は見ない）
+    bool SameMeshData(const MeshData& a, const MeshLods* aLods, const MeshData& b, const MeshLods* bLods)
+    {
+        if (!SameBytes(a.Vertices, b.Vertices) || !SameBytes(a.Indices, b.Indices)) return false;
+        if (!aLods || !bLods) return true;
+        return SameBytes(aLods->Indices, bLods->Indices) && SameBytes(aLods->Levels, bLods->Levels);
+    }
+}
+
 bool D3D12Renderer::CreateMeshRendererResources(std::shared_ptr<MeshRendererComponent> mr)
 {
     if (!mr) return false;
     const MeshData& md = mr->GetMeshData();
     if (md.Vertices.empty() || md.Indices.empty()) return false;
+    const MeshLods& lods = mr->GetLods();
 
-    ID3D12Device* dev = m_dev->GetDevice();
-    HRESULT hr;
-    D3D12_HEAP_PROPERTIES heap = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-
-    // VB 作成 → Map → memcpy → Unmap → VBV 設定
-    const UINT vbSize = static_cast<UINT>(md.Vertices.size() * sizeof(Vertex));
-    D3D12_RESOURCE_DESC vbDesc = CD3DX12_RESOURCE_DESC::Buffer(vbSize);
-    hr = dev->CreateCommittedResource(&heap, D3D12_HEAP_FLAG_NONE, &vbDesc,
-        D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&mr->VertexBuffer));
-    if (FAILED(hr)) return false;
+    // .mesh キャッシュ：CPU 側と同じ中身で、GPU 形式も今のものと同じときだけ区画をそのまま使う
+    const MeshCacheFile* cache = mr->GetMeshCache();
+    if (cache && (cache->FormatKey() != GpuMeshCacheFormat().key || cache->VertexCount() != md.Vertices.size()
+        || cache->TotalIndexCount() != md.Indices.size() + lods.Indices.size()))
+        cache = nullptr;
+
+    // 作り直し：前に登録したエントリから外す（区間は ReleaseUnusedMeshes で返る）
+    if (mr->MeshCacheKey != 0)
     {
-        UINT8* dst = nullptr; CD3DX12_RANGE rr(0, 0);
-        hr = mr->VertexBuffer->Map(0, &rr, reinterpret_cast<void**>(&dst));
-        if (FAILED(hr)) return false;
-        std::memcpy(dst, md.Vertices.data(), vbSize);
-        mr->VertexBuffer->Unmap(0, nullptr);
+        auto prev = m_meshCache.find(mr->MeshCacheKey);
+        if (prev != m_meshCache.end())
+        {
+            auto& users = prev->second.users;
+            users.erase(std::remove_if(users.begin(), users.end(),
+                [&mr](const std::weak_ptr<MeshRendererComponent>& w) { return w.lock() == mr; }), users.end());
+        }
+        mr->MeshCacheKey = 0;
     }
-    mr->VertexBufferView.BufferLocation = mr->VertexBuffer->GetGPUVirtualAddress();
-    mr->VertexBufferView.StrideInBytes = sizeof(Vertex);
-    mr->VertexBufferView.SizeInBytes = vbSize;
-
-    // IB 作成 → Map → memcpy → Unmap → IBV 設定
-    const UINT ibSize = static_cast<UINT>(md.Indices.size() * sizeof(uint32_t));
-    D3D12_RESOURCE_DESC ibDesc = CD3DX12_RESOURCE_DESC::Buffer(ibSize);
-    hr = dev->CreateCommittedResource(&heap, D3D12_HEAP_FLAG_NONE, &ibDesc,
-        D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&mr->IndexBuffer));
-    if (FAILED(hr)) return false;
+
+    // 同じ内容のメッシュが既にあれば共有する（キーが同じでも中身が違えば次のキーへずらす）
+    auto sameContent = [&](const SharedMesh& sm)
+        {
+            if (sm.vertexCount != md.Vertices.size() || sm.indexCount != md.Indices.size()
+                || sm.lods.size() != lods.Levels.size())
+                return false;
+            for (const auto& w : sm.users)
+                if (auto user = w.lock()) return SameMeshData(user->GetMeshData(), &user->GetLods(), md, &lods);
+            return false; // 比べる相手がいない（解放待ち）
+        };
+    std::uint64_t meshHash = HashMeshData(md, &lods);
+    if (meshHash == 0) meshHash = 1; // 0 は「未登録」
+    auto cached = m_meshCache.find(meshHash);
+    while (cached != m_meshCache.end() && !sameContent(cached->second))
+    {
+        if (++meshHash == 0) meshHash = 1;
+        cached = m_meshCache.find(meshHash);
+    }
+    if (cached != m_meshCache.end())
     {
-        UINT8* dst = nullptr; CD3DX12_RANGE rr(0, 0);
-        hr = mr->IndexBuffer->Map(0, &rr, reinterpret_cast<void**>(&dst));
-        if (FAILED(hr)) return false;
-        std::memcpy(dst, md.Indices.data(), ibSize);
-        mr->IndexBuffer->Unmap(0, nullptr);
+        SharedMesh& sm = cached->second;
+        ApplySharedMesh(*mr, sm);
+        mr->MeshCacheKey = meshHash;
+        sm.users.push_back(mr);
+        // 共有元がまだ転送中なら同じフェンスで待つ
+        mr->UploadFence = sm.uploadFence;
+        mr->GpuReady = m_uploads.IsComplete(sm.uploadFence);
+        if (!mr->GpuReady) m_pendingMeshes.push_back(mr);
+        mr->ReleaseMeshCache();
+        return true;
     }
-    mr->IndexBufferView.BufferLocation = mr->IndexBuffer->GetGPUVirtualAddress();
-    mr->IndexBufferView.Format = DXGI_FORMAT_R32_UINT;
-    mr->IndexBufferView.SizeInBytes = ibSize;
 
-    mr->IndexCount = static_cast<UINT>(md.Indices.size());
+    // 共有 VB/IB に区間を取り、転送を積む（入らなければプールが詰め直し/伸長する）
+    SharedMesh sm;
+    std::uint64_t fence = 0;
+    bool uploaded = false;
+    if (cache)
+    {
+        // 焼き込み済みの区画（マップしたファイル）からステージングへ直接コピーする
+        const void* streams[GpuVertexStreams::kStreamCount];
+        for (std::uint32_t s = 0; s < GpuVertexStreams::kStreamCount; ++s) streams[s] = cache->VertexStream(s);
+        uploaded = m_geometry.UploadPacked(streams, cache->VertexCount(), cache->GpuIndices(), cache->TotalIndexCount(),
+            cache->ShortIndices(), sm.alloc, fence);
+    }
+    else
+    {
+        // 頂点は GPU 用の形式でストリームごとに詰めてから送る（Upload はステージングへコピーして戻るので作業域は使い回せる）
+        GpuVertexStreams::Encode(md.Vertices, m_packedVertices);
+        const std::uint32_t* indices = md.Indices.data();
+        size_t indexCount = md.Indices.size();
+        if (!lods.Levels.empty())
+        {
+            // LOD0 の後ろに LOD1 以降を続ける（各段の位置は sm.lods の indexOffset + LOD0 の数）
+            m_uploadIndices.assign(md.Indices.begin(), md.Indices.end());
+            m_uploadIndices.insert(m_uploadIndices.end(), lods.Indices.begin(), lods.Indices.end());
+            indices = m_uploadIndices.data();
+            indexCount = m_uploadIndices.size();
+        }
+        uploaded = m_geometry.Upload(GpuVertexStreams::Data(m_packedVertices).data(), md.Vertices.size(),
+            indices, indexCount, sm.alloc, fence);
+    }
+    if (!uploaded) return false;
+    sm.vertexCount = md.Vertices.size();
+    sm.indexCount = md.Indices.size();
+    sm.lods = lods.Levels;
+    sm.uploadFence = fence;
+    sm.users.push_back(mr);
+    ApplySharedMesh(*mr, m_meshCache.emplace(meshHash, std::move(sm)).first->second);
+    mr->MeshCacheKey = meshHash;
+
+    // 転送完了まで描画対象外（PumpMeshUploads が戻す）
+    mr->UploadFence = fence;
+    mr->GpuReady = false;
+    m_pendingMeshes.push_back(mr);
+    mr->ReleaseMeshCache();
+
+    // プールを作り直した（バッファ/位置が変わった）なら既存のメッシュにも配り直す
+    RefreshMeshViews();
     return true;
 }
 
+std::shared_ptr<const MeshCacheFile> D3D12Renderer::ImportMeshCached(const wchar_t* path, MeshCacheStats* stats,
+    const MeshImportOptions& importOptions, const MeshCacheBuildSettings& buildSettings)
+{
+    std::shared_ptr<const MeshCacheFile> cache;
+    ::ImportMeshCached(path, GpuMeshCacheFormat(), cache, importOptions, buildSettings, nullptr, stats);
+    return cache;
+}
+
+void D3D12Renderer::ApplySharedMesh(MeshRendererComponent& mr, const SharedMesh& sm) const
+{
+    for (UINT s = 0; s < MeshRendererComponent::kVertexStreamCount; ++s)
+    {
+        mr.VertexBuffers[s] = m_geometry.VertexBuffer(s);
+        mr.VertexBufferViews[s] = m_geometry.VertexView(s);
+    }
+    mr.IndexBuffer = m_geometry.IndexBuffer(sm.alloc);
+    mr.IndexBufferView = m_geometry.IndexView(sm.alloc); // 16bit/32bit はメッシュごとに違う
+    mr.IndexCount = static_cast<UINT>(sm.indexCount);
+    mr.StartIndex = m_geometry.StartIndex(sm.alloc);
+    mr.BaseVertex = m_geometry.BaseVertex(sm.alloc);
+
+    // LOD：LOD0 の直後から続く（段数は MeshRendererComponent::kMaxLods まで）
+    mr.Lods[0] = { mr.StartIndex, mr.IndexCount, 0.0f };
+    mr.LodCount = 1;
+    for (const MeshLodLevel& l : sm.lods)
+    {
+        if (mr.LodCount >= MeshRendererComponent::kMaxLods) break;
+        mr.Lods[mr.LodCount++] = { mr.StartIndex + static_cast<UINT>(sm.indexCount) + l.indexOffset, l.indexCount, l.error };
+    }
+}
+
+/*
+    RefreshMeshViews
+    ----------------------------------------------------------------------------
+    GeometryPool の作り直し（詰め直し/伸長）で VB/IB と区間の位置が変わったら、
+    キャッシュの全メッシュの users にビューと StartIndex/BaseVertex を配り直す。
+    作り直しは COPY キューの完了を待ってから戻るので、配り直した時点で中身は揃っている。
+    旧バッファは UploadRing::DeferRelease 経由で、参照しうるフレームの完了後に解放される。
+*/
+void D3D12Renderer::RefreshMeshViews()
+{
+    if (m_geometry.Generation() == m_geometryGeneration) return;
+    m_geometryGeneration = m_geometry.Generation();
+
+    for (auto& [hash, sm] : m_meshCache)
+    {
+        for (const auto& w : sm.users)
+            if (auto user = w.lock()) ApplySharedMesh(*user, sm);
+    }
+}
+
+/*
+    ReleaseUnusedMeshes / CompactMeshPool
+    ----------------------------------------------------------------------------
+    - 区間を返すと次の Upload で上書きされうるので、DIRECT キュー（描画）と COPY キュー（転送）の
+      両方の完了を待ってから返す。
+    - users がすべて切れたエントリだけを返す。生きている users は残す（切れた weak_ptr は掃除する）。
+    - CompactMeshPool は空き区間を 1 つにまとめる。位置が変わるので配り直す。
+*/
+size_t D3D12Renderer::ReleaseUnusedMeshes()
+{
+    m_scheduler.WaitIdle();
+    m_uploads.WaitIdle();
+
+    size_t released = 0;
+    for (auto it = m_meshCache.begin(); it != m_meshCache.end();)
+    {
+        auto& users = it->second.users;
+        users.erase(std::remove_if(users.begin(), users.end(),
+            [](const std::weak_ptr<MeshRendererComponent>& w) { return w.expired(); }), users.end());
+        if (users.empty())
+        {
+            m_geometry.Free(it->second.alloc);
+            it = m_meshCache.erase(it);
+            ++released;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return released;
+}
+
+bool D3D12Renderer::CompactMeshPool()
+{
+    m_scheduler.WaitIdle();
+    const bool ok = m_geometry.Compact();
+    RefreshMeshViews();
+    return ok;
+}
+
+/*
+    BuildStaticBatches
+    ----------------------------------------------------------------------------
+    scene 内の Static な MeshRenderer（VB/IB 作成済みのもの）を集めて BuildStaticBatches で
+    ワールド空間に焼き込み・結合し、チャンクごとに描画専用の MeshRendererComponent を作る。
+      - 結合元には SetStaticBatched(true) を付け、SceneRenderer が個別に描かないようにする。
+      - LOD またはメッシュレットを持つもの、頂点数が maxVerticesPerChunk を超えるものは結合しない。
+        チャンクは LOD0 だけの結合メッシュなので、焼き込むと LOD 選択・メッシュレットカリング・
+        16bit インデックスが効かなくなる（大きなメッシュは結合しても Draw がほとんど減らない）。
+        BuildMeshLods / BuildMeshlets の後に呼ぶこと。
+      - 作り直し：前回の結合元を戻してから集め直すので、何度呼んでも結合は 1 重になる。
+        前回のチャンクを使った描画が GPU に残っている可能性があるので、区間は完全待機してから
+        共有 VB/IB へ返す（ReleaseUnusedMeshes。ロード時の処理なので待ちは許容する）。
+        記録中のコマンドリストは待っても完了しないので、BeginFrame～EndFrame の間には呼ばないこと。
+      - チャンクが 1 つでも作れなければ結合しない。作りかけのチャンクの区間もその場で返す。
+      - チャンクの VB/IB 転送は戻る前に完了を待つ（結合元が消えてチャンクも未転送、の隙間を作らない）。
+      - 結合後に Static オブジェクトを動かした/増やした場合はもう一度呼ぶこと
+        （チャンクは自動では追従しない）。
+      - pipeline は現状 0 固定（PSO は 1 種類）。マテリアルを増やしたらここで番号を入れる。
+*/
+size_t D3D12Renderer::BuildStaticBatches(const Scene* scene, const StaticBatchSettings& settings)
+{
+    // 前回の結合を解除し、前回のチャンクの区間を返す（GPU 完了待ちは ReleaseUnusedMeshes が行う）
+    const bool rebuilt = !m_staticBatches.empty();
+    DropStaticBatches();
+    if (rebuilt) ReleaseUnusedMeshes();
+    if (!scene) return 0;
+
+    // Static な MeshRenderer を集める
+    std::vector<StaticBatchInput> inputs;
+    std::vector<std::shared_ptr<MeshRendererComponent>> sources;
+    std::vector<GameObject*> stack;
+    for (const auto& root : scene->GetRootGameObjects()) stack.push_back(root.get());
+    while (!stack.empty())
+    {
+        GameObject* go = stack.back();
+        stack.pop_back();
+        if (!go) continue;
+        if (go->IsStatic())
+        {
+            auto mr = go->GetComponent<MeshRendererComponent>();
+            if (mr && mr->VertexBuffers[MeshRendererComponent::kPositionStream] && mr->IndexCount > 0
+                && mr->LodCount <= 1 && !mr->GetMeshlets()
+                && mr->GetMeshData().Vertices.size() <= settings.maxVerticesPerChunk)
+            {
+                StaticBatchInput in;
+                in.mesh = &mr->GetMeshData();
+                DirectX::XMStoreFloat4x4(&in.world, go->Transform->GetWorldMatrix());
+                inputs.push_back(in);
+                sources.push_back(mr);
+            }
+        }
+        for (const auto& ch : go->GetChildren()) stack.push_back(ch.get());
+    }
+
+    std::vector<StaticBatchChunk> chunks;
+    ::BuildStaticBatches(inputs.data(), inputs.size(), settings, chunks);
+
+    for (StaticBatchChunk& chunk : chunks)
+    {
+        auto mr = std::make_shared<MeshRendererComponent>();
+        mr->EditMeshData() = std::move(chunk.mesh); // コピーを避ける（境界は次の GetBounds で計算）
+        if (!CreateMeshRendererResources(mr))
+        {
+            // 1 つでも作れなければ結合しない（結合元をそのまま個別に描く）。
+            // 作ったチャンクは転送中かもしれないので、COPY キューを待ってから区間を返す
+            DropStaticBatches();
+            ReleaseUnusedMeshes();
+            return 0;
+        }
+        m_staticBatches.push_back(std::move(mr));
+    }
+    // 結合元は即座に描かれなくなるので、チャンクの転送はここで終わらせておく（ロード時の待ちは許容）
+    m_uploads.WaitIdle();
+    PumpMeshUploads();
+    for (auto& mr : sources)
+    {
+        mr->SetStaticBatched(true);
+        m_batchedSources.push_back(mr);
+    }
+
+    m_sceneLayer.SetStaticBatches(m_staticBatches);
+    return m_staticBatches.size();
+}
+
+void D3D12Renderer::DropStaticBatches()
+{
+    for (auto& mr : m_batchedSources) if (auto p = mr.lock()) p->SetStaticBatched(false);
+    m_batchedSources.clear();
+    m_staticBatches.clear();
+    m_sceneLayer.SetStaticBatches({});
+}
+
+/*
+    BuildMeshLods
+    ----------------------------------------------------------------------------
+    scene 内の MeshRenderer（LOD をまだ持たず、静的バッチに結合されていないもの）に LOD を作る。
+      - 同じ内容のメッシュ（HashMeshData で引き、バイト単位で確かめる）は 1 回だけ簡略化し、結果を配る。
+      - 簡略化はメッシュ単位で JobSystem に並列に投げる（::BuildMeshLods。各メッシュの中は逐次）。
+      - LOD ができたものだけ CreateMeshRendererResources で VB/IB を作り直す（古い区間は
+        users から外れ、ReleaseUnusedMeshes で返る）。転送中は GpuReady = false になる。
+      - LOD が作れない（小さすぎる・継ぎ目だらけ等）メッシュはそのまま。
+*/
+size_t D3D12Renderer::BuildMeshLods(const Scene* scene, const MeshLodSettings& settings)
+{
+    if (!scene) return 0;
+
+    // 対象を集め、同じ内容のメッシュを 1 つにまとめる
+    std::vector<std::shared_ptr<MeshRendererComponent>> targets;
+    std::vector<size_t> unique;                // targets の添字 → meshes の添字
+    std::vector<const MeshData*> meshes;
+    std::unordered_map<std::uint64_t, size_t> byHash;
+    std::vector<GameObject*> stack;
+    for (const auto& root : scene->GetRootGameObjects()) stack.push_back(root.get());
+    while (!stack.empty())
+    {
+        GameObject* go = stack.back();
+        stack.pop_back();
+        if (!go) continue;
+        auto mr = go->GetComponent<MeshRendererComponent>();
+        if (mr && !mr->IsStaticBatched() && mr->GetLods().Levels.empty())
+        {
+            const MeshData& md = mr->GetMeshData();
+            if (!md.Indices.empty())
+            {
+                const std::uint64_t h = HashMeshData(md, nullptr);
+                auto it = byHash.find(h);
+                if (it == byHash.end() || !SameMeshData(*meshes[it->second], nullptr, md, nullptr))
+                {
+                    it = byHash.insert_or_assign(h, meshes.size()).first;
+                    meshes.push_back(&md);
+                }
+                targets.push_back(mr);
+                unique.push_back(it->second);
+            }
+        }
+        for (const auto& ch : go->GetChildren()) stack.push_back(ch.get());
+    }
+
+    std::vector<MeshLods> lods(meshes.size());
+    ::BuildMeshLods(meshes.data(), meshes.size(), settings, lods.data());
+
+    size_t built = 0;
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        const MeshLods& l = lods[unique[i]];
+        if (l.Levels.empty()) continue;
+        targets[i]->SetLods(l);
+        if (CreateMeshRendererResources(targets[i])) ++built;
+    }
+    return built;
+}
+
+/*
+    BuildMeshlets
+    ----------------------------------------------------------------------------
+    scene 内の MeshRenderer（メッシュレットをまだ持たず、静的バッチに結合されていないもの）を分ける。
+      - 同じ内容のメッシュ（HashMeshData で引き、バイト単位で確かめる）は 1 回だけ分け、結果を shared_ptr で共有させる。
+      - 分けるのはメッシュ単位で JobSystem に並列に投げる（::BuildMeshlets）。
+      - 三角形が 1 塊に収まるメッシュは持たせない（塊ごとに判定しても得が無い）。
+*/
+size_t D3D12Renderer::BuildMeshlets(const Scene* scene, const MeshletLimits& limits)
+{
+    if (!scene) return 0;
+
+    std::vector<std::shared_ptr<MeshRendererComponent>> targets;
+    std::vector<size_t> unique;                // targets の添字 → meshes の添字
+    std::vector<const MeshData*> meshes;
+    std::unordered_map<std::uint64_t, size_t> byHash;
+    std::vector<GameObject*> stack;
+    for (const auto& root : scene->GetRootGameObjects()) stack.push_back(root.get());
+    while (!stack.empty())
+    {
+        GameObject* go = stack.back();
+        stack.pop_back();
+        if (!go) continue;
+        auto mr = go->GetComponent<MeshRendererComponent>();
+        if (mr && !mr->IsStaticBatched() && !mr->GetMeshlets())
+        {
+            const MeshData& md = mr->GetMeshData();
+            if (md.Indices.size() / 3 > limits.maxTriangles)
+            {
+                const std::uint64_t h = HashMeshData(md, nullptr);
+                auto it = byHash.find(h);
+                if (it == byHash.end() || !SameMeshData(*meshes[it->second], nullptr, md, nullptr))
+                {
+                    it = byHash.insert_or_assign(h, meshes.size()).first;
+                    meshes.push_back(&md);
+                }
+                targets.push_back(mr);
+                unique.push_back(it->second);
+            }
+        }
+        for (const auto& ch : go->GetChildren()) stack.push_back(ch.get());
+    }
+
+    std::vector<MeshletData> built(meshes.size());
+    ::BuildMeshlets(meshes.data(), meshes.size(), limits, built.data());
+
+    std::vector<std::shared_ptr<const MeshletData>> shared(meshes.size());
+    for (size_t i = 0; i < meshes.size(); ++i)
+        if (built[i].Meshlets.size() >= 2) shared[i] = std::make_shared<MeshletData>(std::move(built[i]));
+
+    size_t count = 0;
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        if (!shared[unique[i]]) continue;
+        targets[i]->SetMeshlets(shared[unique[i]]);
+        ++count;
+    }
+    return count;
+}
+
 /*
     ReleaseSceneResources
     ----------------------------------------------------------------------------
     現在のシーンが保持している MeshRendererComponent の GPU リソースを解放。
     （ガベージキューは使わず、素直に ComPtr を Reset）
+    共有メッシュのキャッシュと GeometryPool の区間もここで捨てる（GPU 完了を待ってから）。
 */
 void D3D12Renderer::ReleaseSceneResources()
 {
+    // 共有 VB/IB の区間を全部捨てる（描画と転送の完了を待ってから）
+    m_scheduler.WaitIdle();
+    m_uploads.WaitIdle();
+    m_pendingMeshes.clear();
+    m_meshCache.clear();
+    m_geometry.Clear();
+    DropStaticBatches(); // 結合元が次のシーンで使い回されても個別に描かれるようにフラグを戻す
     if (!m_CurrentScene) return;
     for (const auto& root : m_CurrentScene->GetRootGameObjects()) {
         std::function<void(std::shared_ptr<GameObject>)> walk =
@@ -399,7 +876,8 @@ void D3D12Renderer::ReleaseSceneResources()
                 if (!go) return;
                 if (auto mr = go->GetComponent<MeshRendererComponent>()) {
                     mr->IndexBuffer.Reset();
-                    mr->VertexBuffer.Reset();
+                    mr->MeshCacheKey = 0;
+                    for (auto& vb : mr->VertexBuffers) vb.Reset();
                 }
                 for (auto& ch : go->GetChildren()) walk(ch);
             };
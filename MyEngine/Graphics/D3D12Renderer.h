@@ -5,22 +5,22 @@
 ================================================================================
 D3D12Renderer
 --------------------------------------------------------------------------------
-ixjF
-  - AvGu_[v{̂̌J API 
-  -  / t[` / TCY / I ̃CtTCNi
-  - ჌xiDeviceResources, FrameResources, Fencecj
-    xiScene, Camera, ImGui, Offscreen RTcj̋n
-
-݌v̒F
-  - ჌x DX12 \[XǗ Core::* ɈϏiSRPj
-  - `̑唼 SceneLayeriSceneRenderer + ViewportsjֈϏ
-  - R}hoEPresentEtFX FrameScheduler ɈϏ
-  - Editor(UI)  ImGuiLayer, EditorContext đa
-
-悭闎ƂF
-  - Resize: Xbv`FCł͂ȂAJ̃AXyNgXV邱
-  - tFXFO Signal \lAPȂ
-  - ImGui: NewFrame  Build  Render ̏A` BB ɑ΂čs
+役割（高レベル）：
+  - アプリ側が触る「レンダラー」本体の公開 API を提供
+  - 初期化 / フレーム描画 / リサイズ / 終了処理 のライフサイクルを司る
+  - 低レベル（DeviceResources, FrameResources, Fence…）と
+    高レベル（Scene, Camera, ImGui, Offscreen RT…）の橋渡し
+
+設計の柱：
+  - 低レベルの DX12 リソース管理は Core::* に委譲（SRP）
+  - 実描画の大半は SceneLayer（SceneRenderer + Viewports）へ委譲
+  - コマンド提出・Present・フェンス同期は FrameScheduler に委譲
+  - Editor(UI) は ImGuiLayer, EditorContext を介して疎結合に
+
+よく見る落とし穴：
+  - Resize: スワップチェインだけではなく、カメラのアスペクトも更新すること
+  - フェンス：外部で Signal される可能性を考慮し、単調増加を崩さない
+  - ImGui: NewFrame → Build → Render の順序、かつ描画は BB に対して行う
 ================================================================================
 */
 
@@ -29,33 +29,40 @@ D3D12Renderer
 #include <d3d12.h>
 #include <dxgi1_6.h>
 #include <DirectXMath.h>
+#include <cstdint>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <functional>
 
-// ---- GWʁiV[܂j ----
+// ---- エンジン上位（シーンまわり） ----
 #include "Scene/Scene.h"
 #include "Components/CameraComponent.h"
 #include "Scene/GameObject.h"
 
-// ---- f[^ibVj ----
+// ---- データ（メッシュ） ----
 #include "Assets/Mesh.h"
+#include "Assets/StaticBatch.h"
+#include "Assets/MeshCache.h"
 #include "Components/MeshRendererComponent.h"
 
-// ---- 萔obt@iGPU ƈvj----
+// ---- 定数バッファ（GPU 側と一致させる）----
 #include "SceneConstantBuffer.h"
 
-// ---- ʃW[iDX12 [eBeBQj----
-#include "Core/DeviceResources.h"           // foCX/Xbv`FC/RTV/DSV
-#include "Core/FrameResources.h"            // t[OiUpload CB, CmdAllocj
-#include "Core/GpuGarbage.h"                // xjL[itFXBɉj
-#include "Pipeline/PipelineStateBuilder.h"  // RootSig/PSO \ziLambertj
-#include "Editor/EditorContext.h"           // GfB^ UI Ƃ̃f[^󂯓n
-#include "Editor/ImGuiLayer.h"              // ImGui /`
-#include "Renderer/Presenter.h"             // BB JځENAEݒ
-#include "Renderer/SceneLayer.h"            // ItXN[`iScene/Gamejꎮ
-
-// ---- XPW[io/Present/tFXǗj----
+// ---- 下位モジュール（DX12 ユーティリティ群）----
+#include "Core/DeviceResources.h"           // デバイス/スワップチェイン/RTV/DSV
+#include "Core/FrameResources.h"            // フレームリング（Upload CB, CmdAlloc）
+#include "Core/GpuGarbage.h"                // 遅延破棄キュー（フェンス到達後に解放）
+#include "Pipeline/PipelineStateBuilder.h"  // RootSig/PSO 構築（Lambert）
+#include "Pipeline/VertexFormat.h"          // GPU 頂点形式（量子化。VB の stride と InputLayout）
+#include "Editor/EditorContext.h"           // エディタ UI とのデータ受け渡し
+#include "Editor/ImGuiLayer.h"              // ImGui 初期化/描画
+#include "Renderer/Presenter.h"             // BB 遷移・クリア・設定
+#include "Renderer/SceneLayer.h"            // オフスクリーン描画（Scene/Game）一式
+#include "Upload/GpuUploadQueue.h"          // 静的メッシュの転送（COPY キュー + ステージング）
+#include "Upload/GeometryPool.h"            // 全メッシュ共有の VB/IB（区間で切り分け）
+
+// ---- スケジューラ（提出/Present/フェンス管理）----
 #include "Renderer/FrameScheduler.h"
 
 class MeshRendererComponent;
@@ -64,98 +71,180 @@ class MeshRendererComponent;
 --------------------------------------------------------------------------------
 D3D12Renderer
 --------------------------------------------------------------------------------
-JC^tF[ẌӐ}F
-  - Initialize(hwnd, w, h)  c DX12/ImGui/pCvCȂǈꎮ\z
-  - Render()                c 1t[̕`iUI ܂ށj
-  - Resize(w, h)            c Xbv`FC̃TCYiEBhETCYύXj
-  - Cleanup()               c GPU ҋ@\[X
-  - SetScene/SetCamera      c t[`Ώۂ̃V[/Jւ
-  - CreateMeshRendererResources c MeshRenderer p VB/IB 쐬iȈՃ[eBeBj
-
-\̊TvF
-  - DeviceResources : Device / SwapChain / RTV / DSV / Queue ێ
-  - FrameResources  : CmdAllocator / Upload CB / et[ fence l
-  - FrameScheduler  : BeginFrame() / EndFrame()  CmdList ǗPresent
-  - SceneLayer      : Viewports + SceneRendereriScene/Game  2 RT ɕ`j
-  - Presenter       : BB  RT ɑJڂ ImGui `恨Present J
+公開インタフェースの意図：
+  - Initialize(hwnd, w, h)  … DX12/ImGui/パイプラインなど一式構築
+  - Render()                … 1フレーム分の描画（UI 含む）
+  - Resize(w, h)            … スワップチェインのリサイズ（ウィンドウサイズ変更時）
+  - Cleanup()               … GPU 待機→リソース解放
+  - SetScene/SetCamera      … 今フレーム描画対象のシーン/カメラを差し替え
+  - CreateMeshRendererResources … MeshRenderer 用 VB/IB を作成（DEFAULT ヒープへ非同期転送）
+  - ImportMeshCached        … メッシュファイルを .mesh キャッシュ付きで読む（GPU 形式はこのレンダラのもの）
+
+内部構造の概要：
+  - DeviceResources : Device / SwapChain / RTV / DSV / Queue を保持
+  - FrameResources  : CmdAllocator / UploadRing（定数・インスタンス）/ 各フレームの fence 値
+  - FrameScheduler  : BeginFrame() / EndFrame() で CmdList 管理＆Present
+  - SceneLayer      : Viewports + SceneRenderer（Scene/Game の 2 RT に描画）
+  - Presenter       : BB を RT に遷移して ImGui を描画→Present 遷移
+  - GpuUploadQueue  : メッシュ VB/IB を COPY キューで DEFAULT ヒープへ送る（完了まで描画対象外）
+  - GeometryPool    : 全メッシュの頂点/インデックスを大きな VB/IB 1 組に詰める（BaseVertex/StartIndex で描く）
 --------------------------------------------------------------------------------
 */
 class D3D12Renderer
 {
 public:
-    // t[iSwapChain obt@Ɛj
+    // フレーム数（SwapChain バッファ数と整合させる）
     static const UINT FrameCount = 3;
-    // 1t[ɃAbv[hőIuWFNgiCBV Xbgj
-    static const UINT MaxObjects = 100;
+    // 定数/インスタンス用アップロードページ 1 枚のサイズ（足りなければページを足して伸びる）
+    static constexpr UINT64 UploadPageSize = 1024 * 1024;
+    // メッシュ転送用ステージングのサイズ（これを超えるロードは分割＋完了待ちで流す）
+    static constexpr UINT64 MeshStagingSize = 8ull * 1024 * 1024;
 
     D3D12Renderer();
     ~D3D12Renderer();
 
-    // ---- CtTCN ----
+    // ---- ライフサイクル ----
     bool Initialize(HWND hwnd, UINT width, UINT height);
     void Render();
     void Resize(UINT width, UINT height) noexcept;
     void Cleanup();
 
-    // ---- V[^J̍ւ ----
+    // ---- シーン／カメラの差し替え ----
     void SetScene(std::shared_ptr<Scene> scene) { m_CurrentScene = std::move(scene); }
     void SetCamera(std::shared_ptr<CameraComponent> cam) { m_Camera = std::move(cam); }
 
-    // ---- bViȈՃAbv[_j----
-    //  EMeshRendererComponent Ɋ܂܂ CPU bV VB/IB 쐬
+    // ---- メッシュ（簡易アップローダ）----
+    //  ・MeshRendererComponent に含まれる CPU メッシュを元に VB/IB を作成
+    //  ・中身（頂点/インデックス）が同じメッシュは VB/IB を共有する（インスタンシングでまとまる）
+    //  ・VB/IB は DEFAULT ヒープ。転送が終わるまで GpuReady = false（描画で飛ばされる）
+    //  ・頂点/インデックスは GeometryPool の共有 VB/IB に区間として置く
     bool CreateMeshRendererResources(std::shared_ptr<MeshRendererComponent> meshRenderer);
 
-    //  Eۂ̃h[ Render()  SceneRenderer sA
-    //    P`sꍇȂǂɎgpiVB/IB/g|Wݒ{ DrawIndexedj
+    //  ・OBJ/glTF を .mesh キャッシュ付きで読む（::ImportMeshCached に GpuMeshCacheFormat を渡すだけ）。
+    //    結果は MeshRendererComponent::SetMeshFromCache に渡し、CreateMeshRendererResources で送る。
+    //    失敗したら nullptr（理由は stats->error）
+    std::shared_ptr<const MeshCacheFile> ImportMeshCached(const wchar_t* path, MeshCacheStats* stats = nullptr,
+        const MeshImportOptions& importOptions = MeshImportOptions(),
+        const MeshCacheBuildSettings& buildSettings = MeshCacheBuildSettings());
+
+    //  ・どの MeshRenderer からも使われなくなったメッシュの区間を GeometryPool へ返す。
+    //    GPU 完了を待ってから返す（ロード/シーン切り替え時向け）。戻り値は返したメッシュ数
+    size_t ReleaseUnusedMeshes();
+
+    //  ・GeometryPool の空きを詰め直す（断片化の解消。完了を待つのでロード時向け）
+    bool CompactMeshPool();
+
+    //  ・静的バッチ：scene 内の Static な MeshRenderer をワールド空間に焼き込み、
+    //    空間チャンクごとの結合メッシュにまとめて描く（ロード時に 1 回。作り直しも可。
+    //    前回のチャンクは GPU の完了を待ってから捨てる。フレームの記録中には呼ばないこと）。
+    //    結合元は IsStaticBatched() になり個別には描かれない。戻り値はチャンク数。
+    //    LOD/メッシュレットを持つもの・1 チャンクに収まらない大きなものは結合せず個別に描く。
+    size_t BuildStaticBatches(const Scene* scene, const StaticBatchSettings& settings = StaticBatchSettings());
+
+    //  ・LOD：scene 内の MeshRenderer のうち LOD をまだ持たないものに、MeshSimplifier で LOD1 以降を作る
+    //    （同じ内容のメッシュは 1 回だけ。メッシュ単位で JobSystem に並列に投げる）。
+    //    LOD ができたものは VB/IB を作り直す（LOD のインデックスは LOD0 と同じ区間の後ろに続けて置く）。
+    //    描く段は SceneRenderer が画面上の大きさで選ぶ。戻り値は LOD を持つようになった MeshRenderer 数
+    size_t BuildMeshLods(const Scene* scene, const MeshLodSettings& settings = MeshLodSettings());
+
+    //  ・メッシュレット：scene 内の MeshRenderer のうちメッシュレットをまだ持たないものを、LOD0 の三角形から分ける
+    //    （同じ内容のメッシュは 1 回だけ作って共有させる。メッシュ単位で JobSystem に並列に投げる）。
+    //    CPU 側だけのデータなので VB/IB は作り直さない。SceneRenderer が塊ごとのカリングに使う。
+    //    戻り値はメッシュレットを持つようになった MeshRenderer 数
+    size_t BuildMeshlets(const Scene* scene, const MeshletLimits& limits = MeshletLimits());
+
+    //  ・実際のドローは Render() 内で SceneRenderer が行うが、
+    //    単発描画を行いたい場合などに使用（VB/IB/トポロジ設定＋ DrawIndexed）
     void DrawMesh(MeshRendererComponent* meshRenderer);
 
-    // ---- GPU Sҋ@ifobO/IȂǁj----
-    void WaitForGPU() noexcept;
-
-    // ---- V[j GPU \[XiVB/IB Ȃǁj----
+    // ---- シーン破棄時の GPU リソース解放（VB/IB など）----
     void ReleaseSceneResources();
 
-    // ---- vFo߃t[ ----
+    // ---- 統計：経過フレーム数 ----
     UINT GetFrameCount() const { return m_frameCount; }
 
 private:
-    // ========= { DX12 \[X =========
+    // ========= 基本 DX12 リソース =========
     std::unique_ptr<DeviceResources>        m_dev;          // Device / Queue / SwapChain / RTV / DSV
-    Microsoft::WRL::ComPtr<ID3D12Fence>     m_fence;        // WaitForGPU p̃tFXiXPW[Ƃ͕ʊǗj
+    Microsoft::WRL::ComPtr<ID3D12Fence>     m_fence;        // DIRECT キューのフェンス（Signal は FrameScheduler だけが行う）
     HANDLE                                  m_fenceEvent = nullptr;
-    UINT64                                  m_nextFence = 0; // WaitForGPU piPȃVOi҂Ɏgpj
 
-    // t[Oiet[ CmdAllocator / Upload CB / Fence lȂǁj
+    // フレームリング（各フレームの CmdAllocator / Upload CB / Fence 値など）
     FrameResources                          m_frames;
 
-    // Lambert p RootSig / PSO ꎮ
+    // Lambert 用の RootSig / PSO 一式
     PipelineSet                             m_pipe;
 
-    // ImGui ̏E`wp
+    // ImGui の初期化・描画ヘルパ
     std::unique_ptr<ImGuiLayer>             m_imgui;
 
-    // ========= xQ =========
-    std::shared_ptr<Scene>                  m_CurrentScene; // `悷V[
-    std::shared_ptr<CameraComponent>        m_Camera;       // gpJ
+    // ========= 高レベル参照 =========
+    std::shared_ptr<Scene>                  m_CurrentScene; // 今回描画するシーン
+    std::shared_ptr<CameraComponent>        m_Camera;       // 今回使用するカメラ
 
-    // ========= Editor  =========
+    // ========= Editor 状態 =========
     bool                                    m_IsEditor = true;
-    std::weak_ptr<GameObject>               m_Selected;     // Inspector/Hiearchy ̑IΏ
+    std::weak_ptr<GameObject>               m_Selected;     // Inspector/Hiearchy の選択対象
 
-    // ========= v =========
+    // ========= 統計 =========
     UINT                                    m_frameCount = 0;
 
-    // ========= oPresent XPW[ =========
+    // ========= 提出＆Present スケジューラ =========
     FrameScheduler                          m_scheduler;
 
-    // ========= ʏo / V[` =========
-    Presenter                               m_presenter;    // BB ւ̑JځENAE߂
-    SceneLayer                              m_sceneLayer;   // Scene/Game ̃ItXN[`Ǘ
+    // ========= 画面出力 / シーン描画 =========
+    Presenter                               m_presenter;    // BB への遷移・クリア・戻し
+    SceneLayer                              m_sceneLayer;   // Scene/Game のオフスクリーン描画管理
 
-    // ImGui SRV ̃x[XXbgit[ +frameIndex Ŏgj
-    static constexpr UINT kSceneSrvBase = 16;               // Scene r[|[g\p
-    static constexpr UINT kGameSrvBase = 32;               // Game  r[|[g\p
+    // ImGui SRV のベーススロット（フレーム毎に +frameIndex で使い分け）
+    static constexpr UINT kSceneSrvBase = 16;               // Scene ビューポート表示用
+    static constexpr UINT kGameSrvBase = 32;               // Game  ビューポート表示用
 
-    // ========= xjitFXBɈSɉj=========
+    // ========= 遅延破棄（フェンス到達後に安全に解放）=========
     GpuGarbageQueue                         m_garbage;
+
+    // ========= メッシュ転送（COPY キュー）=========
+    GpuUploadQueue                          m_uploads;
+    std::vector<std::weak_ptr<MeshRendererComponent>> m_pendingMeshes; // 転送完了待ち（GpuReady = false）
+
+    // 溜まった転送を提出し、完了したメッシュを描画対象に戻す（Render の先頭で呼ぶ）
+    void PumpMeshUploads();
+
+    // ========= メッシュの共有 VB/IB =========
+    GeometryPool                            m_geometry;
+    std::uint32_t                           m_geometryGeneration = 0; // ビューを配った時点の Generation
+    GpuVertexStreams::Arrays                m_packedVertices;         // GpuVertexStreams に詰めた頂点（ストリームごと。Upload の作業用）
+    std::vector<std::uint32_t>              m_uploadIndices;          // LOD0 に LOD1 以降を続けたインデックス（Upload の作業用）
+
+    // ========= メッシュ共有（内容ハッシュ → GeometryPool の区間）=========
+    //  ・同じ形のメッシュを別々の MeshRenderer に設定しても区間は 1 組だけ取る。
+    //    StartIndex/BaseVertex が一致するので SceneRenderer がインスタンス描画にまとめられる。
+    //  ・エントリは ReleaseUnusedMeshes / ReleaseSceneResources / Cleanup まで残る
+    //    （参照が切れても即解放しない）。
+    //  ・プールの作り直しで位置が変わったら、users のビュー/区間を配り直す（RefreshMeshViews）。
+    //  ・LOD を持つメッシュは LOD0 の後ろに LOD1 以降のインデックスを続けて 1 区間に置く（頂点は共有）。
+    struct SharedMesh
+    {
+        GeometryPool::Allocation               alloc;
+        size_t                                 vertexCount = 0; // 中身をバイト単位で比べる前の簡易チェック用
+        size_t                                 indexCount = 0;  // LOD0 のインデックス数
+        std::vector<MeshLodLevel>              lods;            // LOD1 以降（indexOffset は LOD0 の直後から）
+        std::uint64_t                          uploadFence = 0; // VB/IB 転送の完了フェンス（m_uploads）
+        std::vector<std::weak_ptr<MeshRendererComponent>> users; // このメッシュを使っている MeshRenderer
+    };
+    std::unordered_map<std::uint64_t, SharedMesh> m_meshCache;
+
+    // sm の区間を mr に設定する（共有 VB/IB のビュー + StartIndex/BaseVertex）
+    void ApplySharedMesh(MeshRendererComponent& mr, const SharedMesh& sm) const;
+
+    // プールが作り直されていれば、全メッシュのビュー/区間を配り直す
+    void RefreshMeshViews();
+
+    // ========= 静的バッチ（BuildStaticBatches の結果。シーンには属さない描画専用コンポーネント）=========
+    std::vector<std::shared_ptr<MeshRendererComponent>> m_staticBatches;
+    std::vector<std::weak_ptr<MeshRendererComponent>>   m_batchedSources; // 結合元（解除時にフラグを戻す）
+
+    // 結合元のフラグを戻し、チャンクを SceneLayer と m_staticBatches から外す
+    // （区間は返さない。GPU の完了待ちと ReleaseUnusedMeshes は呼び出し側）
+    void DropStaticBatches();
 };
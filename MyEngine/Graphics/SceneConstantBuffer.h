@@ -5,52 +5,62 @@
 ================================================================================
 SceneConstantBuffer.h
 --------------------------------------------------------------------------------
-ړIF
-  - VF[_[ɓng1 h[i܂ 1 IuWFNgjh̒萔f[^`B
-  - HLSL  cbuffer  1:1 ɑΉ悤A16 oCgEivec4 PʁjŐ񂷂B
+目的：
+  - シェーダーに渡す定数データ（GPU 側と 1:1 のレイアウト）を定義する。
+      * PassConstants …… 1 パス（1 カメラ）ぶんの定数。cbuffer b0。パスごとに 1 回だけ書く
+      * InstanceData  …… 1 オブジェクトぶんのデータ。GpuSceneBuffer（StructuredBuffer t0、DEFAULT ヒープ）に
+                         スロット番号で常駐し、VS はパスごとのスロット表（t1）経由で引く
+  - HLSL の cbuffer / struct と 1:1 に対応するよう、cbuffer は 16 バイト境界（vec4 単位）で整列する。
+    StructuredBuffer の要素は詰めて並ぶ（16B 境界の制約は無い）。
 
-݌vF
-  - DirectXMath ̍s͍sD(XMFLOAT4x4)AHLSL  mul ɍ킹
-    VS ňiT^Iɂ row-major ̂܂܎gpBKvɉ transpose jB
-  - gworldITiWorld s̋t]ujh͖@ϊpBlXP[܂ޏꍇł
-    @𓾂邽߂ɎgB
-  - obt@TCY 16 ̔{ɑił 208B224B ۂ߂z肵
-    Abv[h 256B Ȃ 256 ACgɊۂ߂邱ƂjB
-    ۂ̃Abv[h̓t[\[X GetCBStride()  256B Pʂ
-    ĂOiD3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT = 256jB
-gpi_VF[_jF
-    cbuffer SceneCB : register(b0) {
-      float4x4 gMVP;
-      float4x4 gWorld;
-      float4x4 gWorldIT;
-      float3   gLightDir;
-      float    _pad;
+設計メモ：
+  - カメラ・ライト・時間など全オブジェクト共通の値は PassConstants にだけ置く。
+    オブジェクトごとには View*Proj もライトも持たない（VS で g_viewProj を掛ける）。
+  - InstanceData は 84B：
+      world  …… 3x4（アフィン部分だけ。XMStoreFloat3x4 の転置形式。HLSL は mul(world, float4(p,1))）
+      normal …… 3x3 の法線行列（World の 3x3 の逆転置）。非一様スケールでも法線の向きを保つ。
+    （World と WorldIT を 4x4 で 2 つ持つ 128B と比べて 34% 小さい）
+  - DirectXMath の行列は行優先(XMFLOAT4x4)。HLSL 側も row_major で宣言する。
+  - CB は UploadRing から 256B 境界で切り出す
+    （D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT = 256）。
+使用例（頂点シェーダ）：
+    cbuffer PassCB : register(b0) {
+      row_major float4x4 g_view; row_major float4x4 g_proj; row_major float4x4 g_viewProj;
+      float3 g_lightDir; float g_time; float3 g_lightColor; float pad0; float3 g_cameraPos; float pad1;
     };
-    float4 VSMain(float3 pos : POSITION, float3 nrm : NORMAL) : SV_Position {
-      float4 wp = mul(float4(pos,1), gWorld);
-      float3 wn = normalize(mul(nrm, (float3x3)gWorldIT));
-      return mul(wp, gMVP);
+    cbuffer DrawCB : register(b1) { uint g_drawBase; };
+    struct InstanceData { row_major float3x4 world; row_major float3x3 normal; };
+    StructuredBuffer<InstanceData> g_objects   : register(t0);
+    StructuredBuffer<uint>         g_drawSlots : register(t1);
+    float4 VSMain(float3 pos : POSITION, uint iid : SV_InstanceID) : SV_Position {
+      InstanceData inst = g_objects[g_drawSlots[g_drawBase + iid]];
+      return mul(float4(mul(inst.world, float4(pos,1)), 1), g_viewProj);
     }
 ================================================================================
 */
-struct SceneConstantBuffer
+struct PassConstants
 {
-    // 64B: Model-View-Projectioni[J[hr[vWFNVj
-    //   _NbvԂ֕ϊŏIsBCPU  world*view*proj OvZċl߂B
-    DirectX::XMFLOAT4X4 mvp;      // offset 0, size 64
+    DirectX::XMFLOAT4X4 view;       // offset   0：ワールド→ビュー
+    DirectX::XMFLOAT4X4 proj;       // offset  64：ビュー→クリップ
+    DirectX::XMFLOAT4X4 viewProj;   // offset 128：View * Projection（VS はこれだけ使う）
 
-    // 64B: World si[J[hj
-    //   fobOpXƂ̍ėpiepAG-Buffer pȂǁjŌʂɂg悤ێB
-    DirectX::XMFLOAT4X4 world;    // offset 64, size 64
+    // 平行光源（ワールド空間、lightDir は正規化済み）
+    DirectX::XMFLOAT3   lightDir;   // offset 192
+    float               time = 0.0f; // offset 204：起動からの経過秒（Time::GetTime）
+    DirectX::XMFLOAT3   lightColor; // offset 208
+    float               pad0 = 0.0f;
+    DirectX::XMFLOAT3   cameraPos;  // offset 224：カメラのワールド位置（スペキュラ等用）
+    float               pad1 = 0.0f;
+};                                  // 240B（256B 1 ブロックに収まる）
 
-    // 64B: World s̋t]uiInverse Transposej
-    //   @xNgϊpBlXP[܂ރfłۂB
-    DirectX::XMFLOAT4X4 worldIT;  // offset 128, size 64
-
-    // 12B: Cgi[hԁAK𐄏j
-    //   F{0,-1,-1}  normalize ĎgpBsNZVF[_ Lambert/Phong ɗpB
-    DirectX::XMFLOAT3   lightDir; // offset 192, size 12
+// 1 インスタンスぶんのデータ（HLSL の StructuredBuffer<InstanceData> と一致させる。84B）
+struct InstanceData
+{
+    // 48B: World のアフィン部分（XMStoreFloat3x4 の転置形式：行 i = ワールド座標の i 成分の係数）
+    DirectX::XMFLOAT3X4 world;      // offset 0, size 48
 
-    // 4B: pfBOicbuffer  16B Pʂŋl߂邽ߌ߁j
-    float pad = 0.0f;             // offset 204, size 4
+    // 36B: 法線行列（World の 3x3 の逆転置。行ベクトル規約で n' = n * normal）
+    DirectX::XMFLOAT3X3 normal;     // offset 48, size 36
 };
+static_assert(sizeof(PassConstants) == 240, "PassConstants must match the HLSL cbuffer layout");
+static_assert(sizeof(InstanceData) == 84, "InstanceData must match the HLSL StructuredBuffer stride");
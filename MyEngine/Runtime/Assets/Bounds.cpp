@@ -0,0 +1,193 @@
+﻿#include "Assets/Bounds.h"
+#include <cfloat>
+#include <cmath>
+#include <xmmintrin.h>
+
+using namespace DirectX;
+
+/*
+    Bounds.cpp
+    ----------------------------------------------------------------------------
+    ComputeAABB：
+      - Position を _mm_loadu_ps で 4 float（x,y,z,Normal.x）として読み、
+        4 本のアキュムレータで min/max を取る（依存チェーンを分けて IPC を稼ぐ）。
+      - w レーンはゴミだが最後に捨てるので問題ない。
+    ComputeBoundingSphere（Ritter）：
+      1) 各軸の最小/最大点のうち、最も離れたペアを直径とする初期球を作る
+      2) 全頂点を走査し、外にある点があれば球をその点まで広げる
+      - 結果は AABB の外接球と比べて小さい方を返す。
+    TransformAABB：
+      - center/extent 形式に直し、center は普通に変換、
+        extent は |M| （3x3 部分の各成分の絶対値）で変換する。
+      - 回転が入っても 8 頂点変換と同じ結果（保守的な外接 AABB）になる。
+*/
+
+namespace
+{
+    // 球 s を点 p を含むように広げる（Ritter の成長ステップ）
+    void GrowSphere(BoundingSphere& s, const XMFLOAT3& p)
+    {
+        const float dx = p.x - s.Center.x;
+        const float dy = p.y - s.Center.y;
+        const float dz = p.z - s.Center.z;
+        const float d2 = dx * dx + dy * dy + dz * dz;
+        if (d2 <= s.Radius * s.Radius) return;
+
+        const float d = std::sqrt(d2);
+        const float newR = (s.Radius + d) * 0.5f;
+        const float k = (newR - s.Radius) / d; // 中心を p 側へ (newR - r) だけ動かす
+        s.Center.x += dx * k;
+        s.Center.y += dy * k;
+        s.Center.z += dz * k;
+        s.Radius = newR * (1.0f + 1e-6f); // 丸め誤差で点がわずかに外れないよう少しだけ膨らませる
+    }
+
+    float Axis(const XMFLOAT3& p, int a)
+    {
+        return (a == 0) ? p.x : (a == 1) ? p.y : p.z;
+    }
+
+    float DistSq(const XMFLOAT3& a, const XMFLOAT3& b)
+    {
+        const float dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+        return dx * dx + dy * dy + dz * dz;
+    }
+}
+
+AABB ComputeAABB(const Vertex* vertices, std::size_t count)
+{
+    AABB out;
+    if (!vertices || count == 0) return out; // 無効 AABB
+
+    __m128 mn0 = _mm_set1_ps(FLT_MAX), mn1 = mn0, mn2 = mn0, mn3 = mn0;
+    __m128 mx0 = _mm_set1_ps(-FLT_MAX), mx1 = mx0, mx2 = mx0, mx3 = mx0;
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 p0 = _mm_loadu_ps(&vertices[i + 0].Position.x);
+        const __m128 p1 = _mm_loadu_ps(&vertices[i + 1].Position.x);
+        const __m128 p2 = _mm_loadu_ps(&vertices[i + 2].Position.x);
+        const __m128 p3 = _mm_loadu_ps(&vertices[i + 3].Position.x);
+        mn0 = _mm_min_ps(mn0, p0); mx0 = _mm_max_ps(mx0, p0);
+        mn1 = _mm_min_ps(mn1, p1); mx1 = _mm_max_ps(mx1, p1);
+        mn2 = _mm_min_ps(mn2, p2); mx2 = _mm_max_ps(mx2, p2);
+        mn3 = _mm_min_ps(mn3, p3); mx3 = _mm_max_ps(mx3, p3);
+    }
+    for (; i < count; ++i)
+    {
+        const __m128 p = _mm_loadu_ps(&vertices[i].Position.x);
+        mn0 = _mm_min_ps(mn0, p); mx0 = _mm_max_ps(mx0, p);
+    }
+
+    const __m128 mn = _mm_min_ps(_mm_min_ps(mn0, mn1), _mm_min_ps(mn2, mn3));
+    const __m128 mx = _mm_max_ps(_mm_max_ps(mx0, mx1), _mm_max_ps(mx2, mx3));
+
+    alignas(16) float a[4], b[4];
+    _mm_store_ps(a, mn);
+    _mm_store_ps(b, mx);
+    out.Min = XMFLOAT3(a[0], a[1], a[2]);
+    out.Max = XMFLOAT3(b[0], b[1], b[2]);
+    return out;
+}
+
+BoundingSphere ComputeBoundingSphere(const Vertex* vertices, std::size_t count, const AABB& box)
+{
+    BoundingSphere s;
+    if (!vertices || count == 0 || !box.IsValid()) return s;
+
+    // 1) 各軸の極値点を探す
+    std::size_t minIdx[3] = { 0, 0, 0 }, maxIdx[3] = { 0, 0, 0 };
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        for (int a = 0; a < 3; ++a)
+        {
+            const float c = Axis(vertices[i].Position, a);
+            if (c < Axis(vertices[minIdx[a]].Position, a)) minIdx[a] = i;
+            if (c > Axis(vertices[maxIdx[a]].Position, a)) maxIdx[a] = i;
+        }
+    }
+
+    // 最も離れた極値ペアを初期直径に
+    int best = 0;
+    float bestD2 = -1.0f;
+    for (int a = 0; a < 3; ++a)
+    {
+        const float d2 = DistSq(vertices[minIdx[a]].Position, vertices[maxIdx[a]].Position);
+        if (d2 > bestD2) { bestD2 = d2; best = a; }
+    }
+    const XMFLOAT3& pa = vertices[minIdx[best]].Position;
+    const XMFLOAT3& pb = vertices[maxIdx[best]].Position;
+    s.Center = XMFLOAT3((pa.x + pb.x) * 0.5f, (pa.y + pb.y) * 0.5f, (pa.z + pb.z) * 0.5f);
+    s.Radius = std::sqrt(bestD2) * 0.5f;
+
+    // 2) はみ出す点を取り込みながら成長
+    for (std::size_t i = 0; i < count; ++i) GrowSphere(s, vertices[i].Position);
+
+    // AABB の外接球の方が小さければそちらを採用（細長い/軸並行メッシュ向け）
+    BoundingSphere boxSphere;
+    boxSphere.Center = XMFLOAT3(
+        (box.Min.x + box.Max.x) * 0.5f,
+        (box.Min.y + box.Max.y) * 0.5f,
+        (box.Min.z + box.Max.z) * 0.5f);
+    boxSphere.Radius = std::sqrt(DistSq(box.Min, box.Max)) * 0.5f;
+    return (boxSphere.Radius < s.Radius) ? boxSphere : s;
+}
+
+MeshBounds ComputeMeshBounds(const MeshData& mesh)
+{
+    MeshBounds b;
+    b.Box = ComputeAABB(mesh);
+    b.Sphere = ComputeBoundingSphere(mesh.Vertices.data(), mesh.Vertices.size(), b.Box);
+    return b;
+}
+
+void ExpandBounds(MeshBounds& bounds, const Vertex* vertices, std::size_t count)
+{
+    if (!vertices || count == 0) return;
+
+    // AABB：部分集合の AABB との和
+    const AABB part = ComputeAABB(vertices, count);
+    if (!bounds.Box.IsValid())
+    {
+        bounds.Box = part;
+    }
+    else
+    {
+        AABB& b = bounds.Box;
+        b.Min = XMFLOAT3(std::fmin(b.Min.x, part.Min.x), std::fmin(b.Min.y, part.Min.y), std::fmin(b.Min.z, part.Min.z));
+        b.Max = XMFLOAT3(std::fmax(b.Max.x, part.Max.x), std::fmax(b.Max.y, part.Max.y), std::fmax(b.Max.z, part.Max.z));
+    }
+
+    // 球：無効なら部分集合から作り直し、有効なら Ritter の成長ステップのみ
+    if (!bounds.Sphere.IsValid())
+    {
+        bounds.Sphere = ComputeBoundingSphere(vertices, count, part);
+        return;
+    }
+    for (std::size_t i = 0; i < count; ++i) GrowSphere(bounds.Sphere, vertices[i].Position);
+}
+
+AABB TransformAABB(const AABB& local, FXMMATRIX m)
+{
+    if (!local.IsValid()) return local;
+
+    const XMVECTOR mn = XMLoadFloat3(&local.Min);
+    const XMVECTOR mx = XMLoadFloat3(&local.Max);
+    const XMVECTOR center = XMVectorScale(XMVectorAdd(mn, mx), 0.5f);
+    const XMVECTOR extent = XMVectorScale(XMVectorSubtract(mx, mn), 0.5f);
+
+    // 行ベクトル規約（v * M）：ワールド center = center * M
+    const XMVECTOR wc = XMVector3TransformCoord(center, m);
+
+    // extent は各行の絶対値で線形結合（平行移動は無関係）
+    const XMVECTOR we = XMVectorAdd(XMVectorAdd(
+        XMVectorMultiply(XMVectorSplatX(extent), XMVectorAbs(m.r[0])),
+        XMVectorMultiply(XMVectorSplatY(extent), XMVectorAbs(m.r[1]))),
+        XMVectorMultiply(XMVectorSplatZ(extent), XMVectorAbs(m.r[2])));
+
+    AABB out;
+    XMStoreFloat3(&out.Min, XMVectorSubtract(wc, we));
+    XMStoreFloat3(&out.Max, XMVectorAdd(wc, we));
+    return out;
+}
@@ -0,0 +1,72 @@
+﻿#pragma once
+#include <cstddef>
+#include <DirectXMath.h>
+#include "Assets/Mesh.h"
+
+/*
+===============================================================================
+ Bounds（AABB / 境界球）
+-------------------------------------------------------------------------------
+目的:
+  - メッシュのローカル空間の包囲ボックス（AABB）と境界球を表す最小構造体と、
+    その計算・ワールド変換・増分更新のヘルパを提供する。
+  - 視錐台カリング（SceneRenderer）、ピッキング、LOD 選択などの共通の土台。
+
+設計メモ:
+  - AABB は Min/Max 形式で保持（空メッシュは Min > Max の“無効”状態）。
+  - AABB の算出は SSE の min/max リダクション（Position の 16B 非整列ロード）。
+    Vertex は Position の直後に Normal が続くので 16B 読んでも頂点内に収まる。
+  - 境界球は Ritter 法（最小ではないが 1～2 パスで求まる近似）。
+    AABB の外接球と比べて小さい方を採用する。
+  - ワールド変換は Arvo の方法（行列の各成分の絶対値で extent を変換）で
+    8 頂点を変換せずに保守的な AABB を求める。
+  - 増分更新（ExpandBounds）は「広げるだけ」。頂点が内側へ動いた場合は
+    緩い（保守的な）境界になるので、必要に応じて全再計算すること。
+===============================================================================
+*/
+
+struct AABB
+{
+    DirectX::XMFLOAT3 Min{ 0.0f, 0.0f, 0.0f };   // 最小座標
+    DirectX::XMFLOAT3 Max{ -1.0f, -1.0f, -1.0f }; // 最大座標（初期値は無効状態）
+
+    // Min <= Max のときのみ有効
+    bool IsValid() const
+    {
+        return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z;
+    }
+};
+
+struct BoundingSphere
+{
+    DirectX::XMFLOAT3 Center{ 0.0f, 0.0f, 0.0f }; // 中心
+    float             Radius = -1.0f;             // 半径（負なら無効）
+
+    bool IsValid() const { return Radius >= 0.0f; }
+};
+
+// メッシュ 1 つ分のローカル境界（AABB + 境界球）
+struct MeshBounds
+{
+    AABB           Box;
+    BoundingSphere Sphere;
+};
+
+// 頂点位置から AABB を求める（SSE リダクション。頂点が無ければ無効な AABB）
+AABB ComputeAABB(const Vertex* vertices, std::size_t count);
+inline AABB ComputeAABB(const MeshData& mesh)
+{
+    return ComputeAABB(mesh.Vertices.data(), mesh.Vertices.size());
+}
+
+// 頂点位置から境界球を求める（Ritter 法。box は同じ頂点集合の AABB）
+BoundingSphere ComputeBoundingSphere(const Vertex* vertices, std::size_t count, const AABB& box);
+
+// AABB と境界球をまとめて求める
+MeshBounds ComputeMeshBounds(const MeshData& mesh);
+
+// 既存の境界を vertices[0..count) を含むように広げる（縮小はしない）
+void ExpandBounds(MeshBounds& bounds, const Vertex* vertices, std::size_t count);
+
+// ローカル AABB を行列 m で変換し、ワールド空間の保守的な AABB を返す（Arvo 法）
+AABB TransformAABB(const AABB& local, DirectX::FXMMATRIX m);
@@ -6,42 +6,42 @@
 ===============================================================================
  Vertex / MeshData
 -------------------------------------------------------------------------------
-ړI:
-  - Œ̃WIg\i_z{CfbNXzjGWŋL邽߂
-    ʃf[^\`B
+目的:
+  - 最低限のジオメトリ表現（頂点配列＋インデックス配列）をエンジン内部で共有するための
+    共通データ構造を定義する。
 
-݌v:
-  - DirectXMath ̌^ (XMFLOAT3/4) gACPU ł gv[ȍ\̔zh Ƃ
-    ̂܂܃Abv[hł`ɂĂB
-  - HLSL ̃CAEgɍ킹邱Ɓi: POSITION/ NORMAL/ COLORjB
-  - @͍n(+ZO)ł̖ʂ̕\iCW/CCWjƃJOݒɒӁB
-  - CfbNX 32bitiunsigned intjB_ 65535 ȉŏ\Ȃ 16bit B
+設計メモ:
+  - DirectXMath の型 (XMFLOAT3/4) を使い、CPU 側では “プレーンな構造体配列” として扱う
+    （境界計算・静的バッチ・遮蔽ラスタライザはこの float 形式を直接読む）。
+  - GPU へはこのまま送らず、GpuVertexStreams（Pipeline/VertexFormat.h）に量子化して詰める
+    （位置だけのストリームと、八面体 SNORM16 の法線 + RGBA8 の色のストリームに分ける。
+      HLSL の入力レイアウトもそこから生成する）。
+  - 法線は左手系(+Z前)での面の表向き（CW/CCW）とカリング設定に注意。
+  - インデックスは 32bit（unsigned int）。GPU 側は収まれば 16bit に詰める（IndexFormat.h）。
 ===============================================================================
 */
 
 // ============================================================================
-// _f[^
-//  - ʒu(Position)A@(Normal)A_J[(Color) {tH[}bgB
-//  - HLSL  InputLayout ƈv邱ƁiFPOSITION, NORMAL, COLORjB
-//    VSF
-//      struct VSInput { float3 pos:POSITION; float3 nrm:NORMAL; float4 col:COLOR; };
+// 頂点データ
+//  - 位置(Position)、法線(Normal)、頂点カラー(Color) を持つ基本フォーマット。
+//  - GPU 用の形式とは別物（VertexFormat.h の Encode/Decode で相互に変換する）。
 // ============================================================================
 struct Vertex
 {
-    DirectX::XMFLOAT3 Position; // _ʒui[JWj
-    DirectX::XMFLOAT3 Normal;   // _@i[JԁAKj
-    DirectX::XMFLOAT4 Color;    // _J[iRGBA, 0..1j
+    DirectX::XMFLOAT3 Position; // 頂点位置（ローカル座標）
+    DirectX::XMFLOAT3 Normal;   // 頂点法線（ローカル空間、正規化推奨）
+    DirectX::XMFLOAT4 Color;    // 頂点カラー（RGBA, 0..1）
 };
 
 // ============================================================================
-// bVf[^
-//  - 1̕`ΏہiTubVj\钸_zƃCfbNXzB
-//  - Indices ͎Op`Xgzi31gCAOjB
-//    * n{ʂ̕\iCW/CCWj PSO  RasterizerState.CullMode ƍ킹B
-//  - TubV~ꍇ́A̍\̂𕡐 or TubVǉB
+// メッシュデータ
+//  - 1つの描画対象（サブメッシュ相当）を構成する頂点配列とインデックス配列。
+//  - Indices は三角形リスト想定（3つで1トライアングル）。
+//    * 左手系＋面の表向き（CW/CCW）は PSO の RasterizerState.CullMode と合わせる。
+//  - 複数サブメッシュが欲しい場合は、この構造体を複数持つ or サブメッシュ情報を追加する。
 // ============================================================================
 struct MeshData
 {
-    std::vector<Vertex>       Vertices; // _XgiPosition/Normal/Colorj
-    std::vector<unsigned int> Indices;  // CfbNXiOp`XgO, 32bitj
+    std::vector<Vertex>       Vertices; // 頂点リスト（Position/Normal/Color）
+    std::vector<unsigned int> Indices;  // インデックス（三角形リスト前提, 32bit）
 };
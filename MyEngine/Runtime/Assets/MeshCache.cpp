@@ -0,0 +1,544 @@
+﻿#include "Assets/MeshCache.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#endif
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+/*
+    MeshCache
+    ----------------------------------------------------------------------------
+    - 開くとき：ヘッダをコピーして、区画ごとに「数から決まるサイズ」「16B 境界」「ファイル内」を確かめる。
+      verifyContent なら中身全体のハッシュも取る（XXH64 相当。メモリ帯域に近い速さ）。
+      区画の中身は見ない（インデックスの範囲などは書き出し側で確かめてからハッシュに含めている）。
+    - 書き出し：焼き込んだ MeshData から区画を並べ、GPU ストリームは format.encode で出力の区画へ直接詰める。
+    - 区画の型はそのままの並びで書く（static_assert で大きさと trivially copyable を確かめる）。
+*/
+
+static_assert(std::is_trivially_copyable_v<Vertex> && sizeof(Vertex) == 40, "Vertex の並びが変わったら kMeshCacheVersion を上げる");
+static_assert(std::is_trivially_copyable_v<MeshLodLevel> && sizeof(MeshLodLevel) == 12, "MeshLodLevel の並び");
+static_assert(std::is_trivially_copyable_v<Meshlet> && sizeof(Meshlet) == 16, "Meshlet の並び");
+static_assert(std::is_trivially_copyable_v<MeshletBounds> && sizeof(MeshletBounds) == 32, "MeshletBounds の並び");
+static_assert(std::is_trivially_copyable_v<MeshCacheHeader> && sizeof(MeshCacheHeader) % 16 == 0, "ヘッダは 16B の倍数");
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double Milliseconds(Clock::time_point t0)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    constexpr std::uint64_t kPrime1 = 11400714785074694791ull;
+    constexpr std::uint64_t kPrime2 = 14029467366897019727ull;
+    constexpr std::uint64_t kPrime3 = 1609587929392839161ull;
+    constexpr std::uint64_t kPrime4 = 9650029242287828579ull;
+    constexpr std::uint64_t kPrime5 = 2870177450012600261ull;
+
+    inline std::uint64_t Rotl(std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+    inline std::uint64_t Read64(const std::uint8_t* p) { std::uint64_t v; std::memcpy(&v, p, 8); return v; }
+    inline std::uint32_t Read32(const std::uint8_t* p) { std::uint32_t v; std::memcpy(&v, p, 4); return v; }
+    inline std::uint64_t Round(std::uint64_t acc, std::uint64_t input)
+    {
+        acc += input * kPrime2;
+        return Rotl(acc, 31) * kPrime1;
+    }
+    inline std::uint64_t Merge(std::uint64_t acc, std::uint64_t value)
+    {
+        acc ^= Round(0, value);
+        return acc * kPrime1 + kPrime4;
+    }
+
+    inline std::uint64_t Align16(std::uint64_t v) { return (v + 15) & ~std::uint64_t(15); }
+
+    inline std::uint64_t FloatBits(float f)
+    {
+        std::uint32_t u;
+        std::memcpy(&u, &f, 4);
+        return u;
+    }
+}
+
+std::uint64_t HashBytes64(const void* data, std::size_t size, std::uint64_t seed)
+{
+    const std::uint8_t* p = static_cast<const std::uint8_t*>(data);
+    const std::uint8_t* const end = p + size;
+    std::uint64_t h;
+    if (size >= 32)
+    {
+        // 4 レーンを独立に回す（依存の鎖が 4 本になり、1 サイクルに 1 レーンずつ進む）
+        std::uint64_t v1 = seed + kPrime1 + kPrime2, v2 = seed + kPrime2, v3 = seed, v4 = seed - kPrime1;
+        const std::uint8_t* const limit = end - 32;
+        do
+        {
+            v1 = Round(v1, Read64(p));
+            v2 = Round(v2, Read64(p + 8));
+            v3 = Round(v3, Read64(p + 16));
+            v4 = Round(v4, Read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+        h = Rotl(v1, 1) + Rotl(v2, 7) + Rotl(v3, 12) + Rotl(v4, 18);
+        h = Merge(Merge(Merge(Merge(h, v1), v2), v3), v4);
+    }
+    else
+    {
+        h = seed + kPrime5;
+    }
+    h += static_cast<std::uint64_t>(size);
+
+    for (; p + 8 <= end; p += 8) h = Rotl(h ^ Round(0, Read64(p)), 27) * kPrime1 + kPrime4;
+    if (p + 4 <= end)
+    {
+        h = Rotl(h ^ (static_cast<std::uint64_t>(Read32(p)) * kPrime1), 23) * kPrime2 + kPrime3;
+        p += 4;
+    }
+    for (; p < end; ++p) h = Rotl(h ^ (*p * kPrime5), 11) * kPrime1;
+
+    h ^= h >> 33;
+    h *= kPrime2;
+    h ^= h >> 29;
+    h *= kPrime3;
+    h ^= h >> 32;
+    return h;
+}
+
+std::uint64_t HashMeshCacheSettings(const MeshImportOptions& import, const MeshCacheBuildSettings& build,
+    const MeshCacheVertexFormat& format)
+{
+    // 詰め物を含む構造体をそのままハッシュしない（値だけを 64bit に並べる）
+    const std::uint64_t values[] = {
+        kMeshCacheVersion, format.key,
+        import.convertToLeftHanded, FloatBits(import.scale),
+        FloatBits(import.defaultColor.x), FloatBits(import.defaultColor.y), FloatBits(import.defaultColor.z), FloatBits(import.defaultColor.w),
+        build.optimize,
+        build.buildLods, build.lods.maxLods, FloatBits(build.lods.reduction), FloatBits(build.lods.maxError),
+        FloatBits(build.lods.minProgress), build.lods.minTriangles,
+        build.buildMeshlets, build.meshlets.maxVertices, build.meshlets.maxTriangles, FloatBits(build.meshlets.coneWeight),
+    };
+    return HashBytes64(values, sizeof(values));
+}
+
+// ---------------------------------------------------------------------------
+// MeshCacheFile
+// ---------------------------------------------------------------------------
+bool MeshCacheFile::Open(const wchar_t* path, const MeshCacheVertexFormat* format,
+    std::uint64_t sourceHash, std::uint64_t settingsHash, bool verifyContent)
+{
+    Close();
+    if (!m_file.Open(path))
+    {
+        m_error = "cannot open the cache file";
+        return false;
+    }
+    m_data = m_file.Data();
+    m_size = m_file.Size();
+    return Validate(format, sourceHash, settingsHash, verifyContent);
+}
+
+bool MeshCacheFile::OpenMemory(const void* data, std::size_t size, const MeshCacheVertexFormat* format,
+    std::uint64_t sourceHash, std::uint64_t settingsHash, bool verifyContent)
+{
+    Close();
+    if (!data || (reinterpret_cast<std::uintptr_t>(data) & 15) != 0)
+    {
+        m_error = "cache data is not 16-byte aligned";
+        return false;
+    }
+    m_data = static_cast<const std::uint8_t*>(data);
+    m_size = size;
+    return Validate(format, sourceHash, settingsHash, verifyContent);
+}
+
+bool MeshCacheFile::OpenBytes(std::vector<std::uint8_t>&& bytes, const MeshCacheVertexFormat* format, bool verifyContent)
+{
+    Close();
+    m_bytes = std::move(bytes); // vector の領域は new で取るので 16B 境界
+    m_data = m_bytes.data();
+    m_size = m_bytes.size();
+    return Validate(format, 0, 0, verifyContent);
+}
+
+void MeshCacheFile::Close()
+{
+    m_file.Close();
+    m_bytes.clear();
+    m_bytes.shrink_to_fit();
+    m_data = nullptr;
+    m_size = 0;
+    m_header = MeshCacheHeader();
+}
+
+bool MeshCacheFile::Validate(const MeshCacheVertexFormat* format, std::uint64_t sourceHash, std::uint64_t settingsHash,
+    bool verifyContent)
+{
+    const char* error = nullptr;
+    auto fail = [this, &error]()
+        {
+            const char* e = error;
+            Close();
+            m_error = e;
+            return false;
+        };
+
+    if (!m_data || m_size < sizeof(MeshCacheHeader)) { error = "file is too small"; return fail(); }
+    std::memcpy(&m_header, m_data, sizeof(MeshCacheHeader));
+    const MeshCacheHeader& h = m_header;
+    if (h.magic != MeshCacheHeader::kMagic) { error = "not a mesh cache"; return fail(); }
+    if (h.version != kMeshCacheVersion || h.headerSize != sizeof(MeshCacheHeader)) { error = "cache version mismatch"; return fail(); }
+    if (h.fileSize != m_size || m_size % 16 != 0) { error = "cache size mismatch"; return fail(); }
+    if (sourceHash != 0 && h.sourceHash != sourceHash) { error = "source changed"; return fail(); }
+    if (settingsHash != 0 && h.settingsHash != settingsHash) { error = "settings changed"; return fail(); }
+    if (h.streamCount == 0 || h.streamCount > MeshCacheVertexFormat::kMaxStreams) { error = "bad stream count"; return fail(); }
+    if (format)
+    {
+        if (h.formatKey != format->key || h.streamCount != format->streamCount
+            || !std::equal(h.streamStrides, h.streamStrides + h.streamCount, format->strides))
+        {
+            error = "vertex format changed";
+            return fail();
+        }
+    }
+    if (h.vertexCount == 0 || h.indexCount == 0 || h.indexCount % 3 != 0) { error = "empty mesh"; return fail(); }
+
+    // 区画のサイズは数から決まる。位置は 16B 境界で、ヘッダより後ろ・ファイルの中
+    const std::uint64_t totalIndices = static_cast<std::uint64_t>(h.indexCount) + h.lodIndexCount;
+    std::uint64_t expected[MeshCacheHeader::kSectionCount] = {};
+    expected[MeshCacheHeader::kCpuVertices] = static_cast<std::uint64_t>(h.vertexCount) * sizeof(Vertex);
+    expected[MeshCacheHeader::kCpuIndices] = totalIndices * sizeof(std::uint32_t);
+    for (std::uint32_t s = 0; s < h.streamCount; ++s)
+        expected[MeshCacheHeader::kGpuStream0 + s] = static_cast<std::uint64_t>(h.vertexCount) * h.streamStrides[s];
+    expected[MeshCacheHeader::kGpuIndices] = (h.flags & MeshCacheHeader::kShortIndices) ? totalIndices * sizeof(std::uint16_t) : 0;
+    expected[MeshCacheHeader::kLodLevels] = static_cast<std::uint64_t>(h.lodLevelCount) * sizeof(MeshLodLevel);
+    expected[MeshCacheHeader::kMeshlets] = static_cast<std::uint64_t>(h.meshletCount) * sizeof(Meshlet);
+    expected[MeshCacheHeader::kMeshletBounds] = static_cast<std::uint64_t>(h.meshletCount) * sizeof(MeshletBounds);
+    expected[MeshCacheHeader::kMeshletVertices] = static_cast<std::uint64_t>(h.meshletVertexCount) * sizeof(std::uint32_t);
+    expected[MeshCacheHeader::kMeshletTriangles] = h.meshletTriangleBytes;
+    for (std::uint32_t s = 0; s < MeshCacheHeader::kSectionCount; ++s)
+    {
+        const MeshCacheHeader::Range& r = h.sections[s];
+        if (r.size != expected[s]) { error = "section size mismatch"; return fail(); }
+        if (r.size == 0) continue;
+        if (r.offset % 16 != 0 || r.offset < h.headerSize || r.offset > h.fileSize || r.size > h.fileSize - r.offset)
+        {
+            error = "section out of range";
+            return fail();
+        }
+    }
+    for (std::uint32_t l = 0; l < h.lodLevelCount; ++l)
+    {
+        const MeshLodLevel& level = LodLevels()[l];
+        if (level.indexOffset > h.lodIndexCount || level.indexCount > h.lodIndexCount - level.indexOffset)
+        {
+            error = "LOD range out of bounds";
+            return fail();
+        }
+    }
+
+    if (verifyContent && HashBytes64(m_data + h.headerSize, m_size - h.headerSize) != h.contentHash)
+    {
+        error = "content hash mismatch";
+        return fail();
+    }
+    m_error = nullptr;
+    return true;
+}
+
+void MeshCacheFile::CopyMesh(MeshData& out) const
+{
+    const Vertex* v = Vertices();
+    const std::uint32_t* i = Indices();
+    out.Vertices.assign(v, v + m_header.vertexCount);
+    out.Indices.assign(i, i + m_header.indexCount);
+}
+
+void MeshCacheFile::CopyLods(MeshLods& out) const
+{
+    out.Clear();
+    if (m_header.lodLevelCount == 0) return;
+    const std::uint32_t* i = Indices() + m_header.indexCount;
+    out.Indices.assign(i, i + m_header.lodIndexCount);
+    out.Levels.assign(LodLevels(), LodLevels() + m_header.lodLevelCount);
+}
+
+bool MeshCacheFile::CopyMeshlets(MeshletData& out) const
+{
+    out.Clear();
+    if (m_header.meshletCount == 0) return false;
+    const Meshlet* m = Section<Meshlet>(MeshCacheHeader::kMeshlets);
+    const MeshletBounds* b = Section<MeshletBounds>(MeshCacheHeader::kMeshletBounds);
+    const std::uint32_t* v = Section<std::uint32_t>(MeshCacheHeader::kMeshletVertices);
+    const std::uint8_t* t = Section<std::uint8_t>(MeshCacheHeader::kMeshletTriangles);
+    out.Meshlets.assign(m, m + m_header.meshletCount);
+    out.Bounds.assign(b, b + m_header.meshletCount);
+    out.Vertices.assign(v, v + m_header.meshletVertexCount);
+    out.Triangles.assign(t, t + m_header.meshletTriangleBytes);
+    out.IndexCount = m_header.meshletIndexCount;
+    return true;
+}
+
+MeshOptimizeStats MeshCacheFile::OptimizeStats() const
+{
+    MeshOptimizeStats s;
+    const MeshCacheHeader::OptimizeRecord& r = m_header.optimize;
+    s.optimized = (m_header.flags & MeshCacheHeader::kOptimized) != 0;
+    s.verticesBefore = static_cast<std::size_t>(r.verticesBefore);
+    s.verticesAfter = static_cast<std::size_t>(r.verticesAfter);
+    s.clusters = static_cast<std::size_t>(r.clusters);
+    s.before.misses = static_cast<std::size_t>(r.missesBefore);
+    s.after.misses = static_cast<std::size_t>(r.missesAfter);
+    s.before.triangles = s.after.triangles = static_cast<std::size_t>(r.triangles);
+    s.before.vertices = s.after.vertices = static_cast<std::size_t>(r.verticesReferenced);
+    s.before.acmr = r.acmrBefore;
+    s.after.acmr = r.acmrAfter;
+    s.before.atvr = r.atvrBefore;
+    s.after.atvr = r.atvrAfter;
+    return s;
+}
+
+// ---------------------------------------------------------------------------
+// 書き出し
+// ---------------------------------------------------------------------------
+bool BuildMeshCache(const MeshData& mesh, const MeshCacheVertexFormat& format, const MeshCacheBuildSettings& settings,
+    std::uint64_t sourceHash, std::uint64_t settingsHash, std::vector<std::uint8_t>& out)
+{
+    out.clear();
+    if (format.key == 0 || format.streamCount == 0 || format.streamCount > MeshCacheVertexFormat::kMaxStreams || !format.encode)
+        return false;
+    if (mesh.Vertices.empty() || mesh.Indices.empty() || mesh.Indices.size() % 3 != 0
+        || mesh.Vertices.size() > 0xFFFFFFFFull || mesh.Indices.size() > 0xFFFFFFFFull)
+        return false;
+    const std::size_t vertexCount = mesh.Vertices.size();
+    for (unsigned int i : mesh.Indices)
+        if (i >= vertexCount) return false;
+
+    // 1) SetMesh / BuildMeshLods / BuildMeshlets と同じ手順で焼き込む
+    MeshData m = mesh;
+    const MeshOptimizeStats os = settings.optimize ? OptimizeMesh(m) : MeshOptimizeStats();
+    MeshLods lods;
+    if (settings.buildLods) BuildMeshLods(m, settings.lods, lods);
+    MeshletData meshlets;
+    if (settings.buildMeshlets && m.Indices.size() / 3 > settings.meshlets.maxTriangles)
+    {
+        BuildMeshlets(m, settings.meshlets, meshlets);
+        if (meshlets.Meshlets.size() < 2) meshlets.Clear(); // 1 塊なら持たない（D3D12Renderer::BuildMeshlets と同じ）
+    }
+
+    // 2) ヘッダ
+    MeshCacheHeader h;
+    h.headerSize = sizeof(MeshCacheHeader);
+    h.formatKey = format.key;
+    h.sourceHash = sourceHash;
+    h.settingsHash = settingsHash;
+    h.vertexCount = static_cast<std::uint32_t>(m.Vertices.size());
+    h.indexCount = static_cast<std::uint32_t>(m.Indices.size());
+    h.lodIndexCount = static_cast<std::uint32_t>(lods.Indices.size());
+    h.lodLevelCount = static_cast<std::uint32_t>(lods.Levels.size());
+    h.meshletCount = static_cast<std::uint32_t>(meshlets.Meshlets.size());
+    h.meshletVertexCount = static_cast<std::uint32_t>(meshlets.Vertices.size());
+    h.meshletTriangleBytes = static_cast<std::uint32_t>(meshlets.Triangles.size());
+    h.meshletIndexCount = static_cast<std::uint32_t>(meshlets.IndexCount);
+    h.streamCount = format.streamCount;
+    std::copy(format.strides, format.strides + format.streamCount, h.streamStrides);
+    h.bounds = ComputeMeshBounds(m);
+    if (os.optimized)
+    {
+        h.flags |= MeshCacheHeader::kOptimized;
+        h.optimize.verticesBefore = os.verticesBefore;
+        h.optimize.verticesAfter = os.verticesAfter;
+        h.optimize.clusters = os.clusters;
+        h.optimize.missesBefore = os.before.misses;
+        h.optimize.missesAfter = os.after.misses;
+        h.optimize.triangles = os.after.triangles;
+        h.optimize.verticesReferenced = os.after.vertices;
+        h.optimize.acmrBefore = os.before.acmr;
+        h.optimize.acmrAfter = os.after.acmr;
+        h.optimize.atvrBefore = os.before.atvr;
+        h.optimize.atvrAfter = os.after.atvr;
+    }
+
+    // GPU のインデックス：LOD0 → LOD1 以降を続けた全体が 16bit に収まるか（GeometryPool::Upload と同じ判定）
+    const std::uint64_t totalIndices = static_cast<std::uint64_t>(h.indexCount) + h.lodIndexCount;
+    const bool shortIndices = m.Vertices.size() <= 0x10000; // インデックスは頂点数未満なので頂点数で決まる
+    if (shortIndices) h.flags |= MeshCacheHeader::kShortIndices;
+
+    // 3) 区画の配置（16B 境界に詰める）
+    std::uint64_t sizes[MeshCacheHeader::kSectionCount] = {};
+    sizes[MeshCacheHeader::kCpuVertices] = static_cast<std::uint64_t>(h.vertexCount) * sizeof(Vertex);
+    sizes[MeshCacheHeader::kCpuIndices] = totalIndices * sizeof(std::uint32_t);
+    for (std::uint32_t s = 0; s < format.streamCount; ++s)
+        sizes[MeshCacheHeader::kGpuStream0 + s] = static_cast<std::uint64_t>(h.vertexCount) * format.strides[s];
+    sizes[MeshCacheHeader::kGpuIndices] = shortIndices ? totalIndices * sizeof(std::uint16_t) : 0;
+    sizes[MeshCacheHeader::kLodLevels] = lods.Levels.size() * sizeof(MeshLodLevel);
+    sizes[MeshCacheHeader::kMeshlets] = meshlets.Meshlets.size() * sizeof(Meshlet);
+    sizes[MeshCacheHeader::kMeshletBounds] = meshlets.Bounds.size() * sizeof(MeshletBounds);
+    sizes[MeshCacheHeader::kMeshletVertices] = meshlets.Vertices.size() * sizeof(std::uint32_t);
+    sizes[MeshCacheHeader::kMeshletTriangles] = meshlets.Triangles.size();
+    std::uint64_t cursor = sizeof(MeshCacheHeader);
+    for (std::uint32_t s = 0; s < MeshCacheHeader::kSectionCount; ++s)
+    {
+        if (sizes[s] == 0) continue;
+        h.sections[s] = { cursor, sizes[s] };
+        cursor = Align16(cursor + sizes[s]);
+    }
+    h.fileSize = cursor;
+
+    // 4) 中身（詰め物は 0）
+    out.assign(static_cast<std::size_t>(h.fileSize), 0);
+    std::uint8_t* base = out.data();
+    auto put = [&](std::uint32_t s, const void* data)
+        {
+            if (h.sections[s].size) std::memcpy(base + h.sections[s].offset, data, static_cast<std::size_t>(h.sections[s].size));
+        };
+    put(MeshCacheHeader::kCpuVertices, m.Vertices.data());
+    // CPU のインデックスは LOD0 の後ろに LOD1 以降を続ける（区画は両方の合計）
+    std::uint8_t* cpuIndices = base + h.sections[MeshCacheHeader::kCpuIndices].offset;
+    std::memcpy(cpuIndices, m.Indices.data(), m.Indices.size() * sizeof(std::uint32_t));
+    if (!lods.Indices.empty())
+        std::memcpy(cpuIndices + m.Indices.size() * sizeof(std::uint32_t),
+            lods.Indices.data(), lods.Indices.size() * sizeof(std::uint32_t));
+    put(MeshCacheHeader::kLodLevels, lods.Levels.data());
+    put(MeshCacheHeader::kMeshlets, meshlets.Meshlets.data());
+    put(MeshCacheHeader::kMeshletBounds, meshlets.Bounds.data());
+    put(MeshCacheHeader::kMeshletVertices, meshlets.Vertices.data());
+    put(MeshCacheHeader::kMeshletTriangles, meshlets.Triangles.data());
+
+    void* streams[MeshCacheVertexFormat::kMaxStreams] = {};
+    for (std::uint32_t s = 0; s < format.streamCount; ++s) streams[s] = base + h.sections[MeshCacheHeader::kGpuStream0 + s].offset;
+    format.encode(m.Vertices.data(), m.Vertices.size(), streams);
+
+    if (shortIndices)
+    {
+        const std::uint32_t* src = reinterpret_cast<const std::uint32_t*>(base + h.sections[MeshCacheHeader::kCpuIndices].offset);
+        std::uint16_t* dst = reinterpret_cast<std::uint16_t*>(base + h.sections[MeshCacheHeader::kGpuIndices].offset);
+        for (std::uint64_t i = 0; i < totalIndices; ++i) dst[i] = static_cast<std::uint16_t>(src[i]);
+    }
+
+    h.contentHash = HashBytes64(base + sizeof(MeshCacheHeader), out.size() - sizeof(MeshCacheHeader));
+    std::memcpy(base, &h, sizeof(MeshCacheHeader));
+    return true;
+}
+
+bool WriteMeshCacheFile(const wchar_t* path, const std::vector<std::uint8_t>& bytes)
+{
+    if (!path || bytes.empty()) return false;
+
+    // 一時ファイルに全部書いてから置き換える（途中で落ちても壊れた .mesh が残らない）
+    const std::wstring temp = std::wstring(path) + L".tmp";
+#ifdef _WIN32
+    HANDLE file = CreateFileW(temp.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    bool ok = true;
+    std::size_t written = 0;
+    while (ok && written < bytes.size())
+    {
+        const DWORD chunk = static_cast<DWORD>(std::min<std::size_t>(bytes.size() - written, 64u << 20));
+        DWORD done = 0;
+        ok = WriteFile(file, bytes.data() + written, chunk, &done, nullptr) && done == chunk;
+        written += done;
+    }
+    CloseHandle(file);
+
+    if (ok) ok = MoveFileExW(temp.c_str(), path, MOVEFILE_REPLACE_EXISTING) != 0; // 古い .mesh がマップ中なら失敗する
+    if (!ok) DeleteFileW(temp.c_str());
+    return ok;
+#else
+    // POSIX：rename は置き換えを一度に行う（マップ中の古い .mesh は閉じるまで古い中身のまま読める）
+    const std::filesystem::path tempPath(temp), finalPath(path);
+    const int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+
+    bool ok = true;
+    std::size_t written = 0;
+    while (ok && written < bytes.size())
+    {
+        const ::ssize_t done = ::write(fd, bytes.data() + written, bytes.size() - written);
+        if (done < 0 && errno == EINTR) continue;
+        ok = done > 0;
+        if (ok) written += static_cast<std::size_t>(done);
+    }
+    ok = (::close(fd) == 0) && ok;
+
+    if (ok) ok = std::rename(tempPath.c_str(), finalPath.c_str()) == 0;
+    if (!ok) ::unlink(tempPath.c_str());
+    return ok;
+#endif
+}
+
+bool ImportMeshCached(const wchar_t* sourcePath, const MeshCacheVertexFormat& format,
+    std::shared_ptr<const MeshCacheFile>& out, const MeshImportOptions& importOptions,
+    const MeshCacheBuildSettings& buildSettings, const wchar_t* cachePath, MeshCacheStats* stats)
+{
+    MeshCacheStats local;
+    MeshCacheStats& st = stats ? *stats : local;
+    st = MeshCacheStats();
+    out.reset();
+    if (!sourcePath) { st.error = "no source path"; return false; }
+
+    // 1) 元ファイルの中身でキーを作る（更新日時ではなく中身。コピー/チェックアウトで日時が変わっても使える）
+    auto t0 = Clock::now();
+    std::uint64_t sourceHash = 0;
+    {
+        MappedFile source;
+        if (!source.Open(sourcePath)) { st.error = "cannot open the source file"; return false; }
+        st.sourceBytes = source.Size();
+        sourceHash = HashBytes64(source.Data(), source.Size()) | 1; // 0 は「確かめない」なので避ける
+    }
+    const std::uint64_t settingsHash = HashMeshCacheSettings(importOptions, buildSettings, format) | 1;
+    st.hashMilliseconds = Milliseconds(t0);
+
+    const std::wstring defaultCache = std::wstring(sourcePath) + L".mesh";
+    const wchar_t* cache = cachePath ? cachePath : defaultCache.c_str();
+
+    // 2) ヒット：マップしたまま返す
+    t0 = Clock::now();
+    auto file = std::make_shared<MeshCacheFile>();
+    if (file->Open(cache, &format, sourceHash, settingsHash, true))
+    {
+        st.loadMilliseconds = Milliseconds(t0);
+        st.cacheHit = true;
+        st.cacheBytes = file->SizeBytes();
+        out = std::move(file);
+        return true;
+    }
+
+    // 3) ミス：読み込んで焼き込み、書き出す
+    t0 = Clock::now();
+    MeshData mesh;
+    MeshImportStats importStats;
+    if (!ImportMesh(sourcePath, mesh, importOptions, &importStats))
+    {
+        st.error = importStats.error ? importStats.error : "import failed";
+        return false;
+    }
+    st.importMilliseconds = Milliseconds(t0);
+
+    t0 = Clock::now();
+    std::vector<std::uint8_t> bytes;
+    if (!BuildMeshCache(mesh, format, buildSettings, sourceHash, settingsHash, bytes))
+    {
+        st.error = "cannot build the cache";
+        return false;
+    }
+    st.cacheBytes = bytes.size();
+    st.cacheWritten = WriteMeshCacheFile(cache, bytes);
+    if (!file->OpenBytes(std::move(bytes), &format, false))
+    {
+        st.error = file->Error();
+        return false;
+    }
+    st.buildMilliseconds = Milliseconds(t0);
+    out = std::move(file);
+    return true;
+}
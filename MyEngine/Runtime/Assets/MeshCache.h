@@ -0,0 +1,266 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Assets/Mesh.h"
+#include "Assets/Bounds.h"
+#include "Assets/MeshImporter.h"
+#include "Assets/MeshOptimizer.h"
+#include "Assets/MeshSimplifier.h"
+#include "Assets/Meshlet.h"
+#include "Core/MappedFile.h"
+
+/*
+===============================================================================
+ MeshCache（.mesh：焼き込み済みメッシュのバイナリコンテナ）
+-------------------------------------------------------------------------------
+目的:
+  - 起動のたびに OBJ/glTF を解析し、最適化・LOD・メッシュレット・量子化をやり直さないよう、
+    それらを済ませた結果を 1 ファイルにまとめておく。
+  - 読み込みはメモリマップ（MappedFile）してヘッダを確かめるだけ。頂点/インデックスは
+    GPU の形式（GpuVertexStreams のストリームごとの詰めた配列と、16bit に詰めたインデックス）で
+    入っているので、GeometryPool のステージングへそのままコピーすればよい（頂点ごとの変換をしない）。
+
+ファイルの並び（リトルエンディアン。すべての区画は 16B 境界から始まり、ファイル長も 16 の倍数）:
+  MeshCacheHeader（固定長）
+  [CpuVertices]    Vertex × vertexCount（CPU 側の float 頂点。境界・遮蔽・静的バッチ用）
+  [CpuIndices]     uint32 × (indexCount + lodIndexCount)（LOD0 → LOD1 以降の順）
+  [GpuStream0..3]  stride[s] × vertexCount（ストリーム s の詰めた頂点）
+  [GpuIndices]     uint16 × (indexCount + lodIndexCount)（16bit に収まるときだけ。
+                   収まらなければ空で、GPU も CpuIndices をそのまま使う）
+  [LodLevels]      MeshLodLevel × lodLevelCount
+  [Meshlets] [MeshletBounds] [MeshletVertices] [MeshletTriangles]（メッシュレットが無ければ空）
+  区画の位置とサイズはヘッダの表にある（読む側は数からの期待値と照合する）。
+
+キー:
+  - version      … 形式を変えたら kMeshCacheVersion を上げる（古いファイルは読まない）。
+  - formatKey    … GPU 頂点形式（MeshCacheVertexFormat::key）。量子化の形式を変えたら作り直しになる。
+  - sourceHash   … 元ファイルの中身のハッシュ。元を書き換えたら作り直しになる。
+  - settingsHash … 読み込み/焼き込みの設定のハッシュ。設定を変えたら作り直しになる。
+  - contentHash  … ヘッダより後ろ全部のハッシュ（壊れた/書きかけのファイルを弾く）。
+
+GPU 形式について:
+  - このファイルは Runtime 層にあるので GPU の頂点形式（Pipeline/VertexFormat.h）を直接は知らない。
+    書き出しは MeshCacheVertexFormat（ストリームの stride と詰める関数、形式のキー）を受け取る。
+    D3D12 側は GpuMeshCacheFormat()（Upload/MeshUploader.h）を渡す。
+
+使い方:
+  // 元ファイルの隣（model.obj → model.obj.mesh）を使い、無い/古ければ読み込んで焼き込み、書き出す
+  std::shared_ptr<const MeshCacheFile> cache;
+  if (ImportMeshCached(L"model.obj", GpuMeshCacheFormat(), cache)) mr->SetMeshFromCache(cache);
+  renderer.CreateMeshRendererResources(mr); // GPU 区画をそのまま送る
+
+前提と制限:
+  - 同じ CPU アーキテクチャ（リトルエンディアン、Vertex 等の並びが同じ）で書いたファイルだけを読む。
+  - verifyContent = false で開くと contentHash を確かめない（自分で書いたばかりのファイル向け）。
+    その場合インデックスの範囲も確かめないので、壊れたファイルを渡さないこと。
+===============================================================================
+*/
+
+/// 形式を変えたら上げる（ヘッダ・区画の並び・焼き込みの手順のどれか）
+inline constexpr std::uint32_t kMeshCacheVersion = 1;
+
+// GPU 頂点形式の記述（書き出しで頂点を詰めるのに使う）
+struct MeshCacheVertexFormat
+{
+    static constexpr std::uint32_t kMaxStreams = 4;
+    using EncodeFn = void (*)(const Vertex* src, std::size_t count, void* const* streams);
+
+    std::uint64_t key = 0;                  // 形式の識別子（要素・形式・stride から作る。0 = 無効）
+    std::uint32_t streamCount = 0;
+    std::uint32_t strides[kMaxStreams]{};   // ストリームごとの頂点 1 個のバイト数
+    EncodeFn      encode = nullptr;         // Vertex 配列 → ストリームごとの詰めた配列（streamCount 個）
+};
+
+// 焼き込みの設定（LOD/メッシュレットは D3D12Renderer::BuildMeshLods / BuildMeshlets と同じ既定値）
+struct MeshCacheBuildSettings
+{
+    bool            optimize = true;      // OptimizeMesh をかける（インポートした資産なので既定で有効。SetMesh は既定で無効）
+    bool            buildLods = true;     // BuildMeshLods で LOD1 以降を作る
+    MeshLodSettings lods;
+    bool            buildMeshlets = true; // BuildMeshlets で分ける（1 塊に収まるメッシュは持たない）
+    MeshletLimits   meshlets;
+};
+
+// ImportMeshCached の結果
+struct MeshCacheStats
+{
+    bool        cacheHit = false;      // 既存の .mesh を使った
+    bool        cacheWritten = false;  // 作り直して書き出した（書けなくても結果はメモリ上で返る）
+    std::size_t sourceBytes = 0;
+    std::size_t cacheBytes = 0;
+    double      hashMilliseconds = 0.0;   // 元ファイルのハッシュ
+    double      loadMilliseconds = 0.0;   // .mesh を開いて確かめるまで（ヒット時）
+    double      importMilliseconds = 0.0; // 元ファイルの解析（ミス時）
+    double      buildMilliseconds = 0.0;  // 焼き込み + 書き出し（ミス時）
+    const char* error = nullptr;          // 失敗の理由（静的な文字列）
+};
+
+// ファイルヘッダ（固定長。区画の表を含む）
+struct MeshCacheHeader
+{
+    enum Section : std::uint32_t
+    {
+        kCpuVertices, kCpuIndices,
+        kGpuStream0, kGpuStream1, kGpuStream2, kGpuStream3,
+        kGpuIndices, kLodLevels,
+        kMeshlets, kMeshletBounds, kMeshletVertices, kMeshletTriangles,
+        kSectionCount
+    };
+    enum Flags : std::uint32_t
+    {
+        kShortIndices = 1u << 0, // GpuIndices が 16bit（無ければ GPU も CpuIndices を使う）
+        kOptimized = 1u << 1,    // 焼き込み時に OptimizeMesh が効いた（optimize の値が有効）
+    };
+    struct Range
+    {
+        std::uint64_t offset = 0;
+        std::uint64_t size = 0;
+    };
+    // MeshOptimizeStats の固定長版（size_t/bool の幅に依存しない）
+    struct OptimizeRecord
+    {
+        std::uint64_t verticesBefore = 0, verticesAfter = 0, clusters = 0;
+        std::uint64_t missesBefore = 0, missesAfter = 0, triangles = 0, verticesReferenced = 0;
+        float         acmrBefore = 0.0f, acmrAfter = 0.0f, atvrBefore = 0.0f, atvrAfter = 0.0f;
+    };
+
+    static constexpr std::uint32_t kMagic = 0x4348534D; // "MSHC"
+
+    std::uint32_t  magic = kMagic;
+    std::uint32_t  version = kMeshCacheVersion;
+    std::uint32_t  headerSize = 0;      // sizeof(MeshCacheHeader)
+    std::uint32_t  flags = 0;
+    std::uint64_t  fileSize = 0;
+    std::uint64_t  formatKey = 0;
+    std::uint64_t  sourceHash = 0;
+    std::uint64_t  settingsHash = 0;
+    std::uint64_t  contentHash = 0;     // [headerSize, fileSize) の HashBytes64
+    std::uint32_t  vertexCount = 0;
+    std::uint32_t  indexCount = 0;      // LOD0
+    std::uint32_t  lodIndexCount = 0;   // LOD1 以降の合計
+    std::uint32_t  lodLevelCount = 0;
+    std::uint32_t  meshletCount = 0;
+    std::uint32_t  meshletVertexCount = 0;
+    std::uint32_t  meshletTriangleBytes = 0;
+    std::uint32_t  meshletIndexCount = 0;
+    std::uint32_t  streamCount = 0;
+    std::uint32_t  streamStrides[MeshCacheVertexFormat::kMaxStreams]{};
+    std::uint32_t  reserved = 0;
+    MeshBounds     bounds;
+    OptimizeRecord optimize;
+    Range          sections[kSectionCount];
+};
+
+/**
+ * @brief 読み取り専用の .mesh（マップしたファイル、またはメモリ上のバイト列）
+ * @details Open 系が成功した後は、区画へのポインタを Close まで返せる（中身はコピーしない）。
+ *          Copy* は CPU 側の配列へ区画をまとめてコピーする（MeshRendererComponent::SetMeshFromCache が使う）。
+ */
+class MeshCacheFile
+{
+public:
+    MeshCacheFile() = default;
+    MeshCacheFile(const MeshCacheFile&) = delete;
+    MeshCacheFile& operator=(const MeshCacheFile&) = delete;
+
+    /**
+     * @brief path をマップして開く
+     * @param format       nullptr でなければ formatKey/stride が一致すること
+     * @param sourceHash   0 でなければ一致すること（settingsHash も同様）
+     * @return 形式が合わない/壊れている/キーが違うなら false（理由は Error()）
+     */
+    bool Open(const wchar_t* path, const MeshCacheVertexFormat* format = nullptr,
+        std::uint64_t sourceHash = 0, std::uint64_t settingsHash = 0, bool verifyContent = true);
+
+    /// メモリ上のバイト列を開く（data は 16B 境界で、Close まで生かしておくこと。コピーしない）
+    bool OpenMemory(const void* data, std::size_t size, const MeshCacheVertexFormat* format = nullptr,
+        std::uint64_t sourceHash = 0, std::uint64_t settingsHash = 0, bool verifyContent = true);
+
+    /// バイト列を引き取って開く（焼き込んだ直後の結果をそのまま使うとき）
+    bool OpenBytes(std::vector<std::uint8_t>&& bytes, const MeshCacheVertexFormat* format = nullptr, bool verifyContent = false);
+
+    void Close();
+
+    bool IsOpen() const { return m_data != nullptr; }
+    const char* Error() const { return m_error; }
+    const MeshCacheHeader& Header() const { return m_header; }
+    std::size_t SizeBytes() const { return m_size; }
+
+    std::uint32_t VertexCount() const { return m_header.vertexCount; }
+    std::uint32_t IndexCount() const { return m_header.indexCount; }           // LOD0
+    std::uint32_t TotalIndexCount() const { return m_header.indexCount + m_header.lodIndexCount; }
+    std::uint64_t ContentHash() const { return m_header.contentHash; }
+    std::uint64_t FormatKey() const { return m_header.formatKey; }
+    const MeshBounds& Bounds() const { return m_header.bounds; }
+
+    const Vertex*        Vertices() const { return Section<Vertex>(MeshCacheHeader::kCpuVertices); }
+    const std::uint32_t* Indices() const { return Section<std::uint32_t>(MeshCacheHeader::kCpuIndices); } // TotalIndexCount 個
+    const MeshLodLevel*  LodLevels() const { return Section<MeshLodLevel>(MeshCacheHeader::kLodLevels); }
+
+    /// GPU 用：ストリーム s の詰めた頂点（VertexCount 個）
+    const void* VertexStream(std::uint32_t s) const
+    {
+        return s < m_header.streamCount ? Section<std::uint8_t>(MeshCacheHeader::kGpuStream0 + s) : nullptr;
+    }
+    /// GPU 用：LOD0 → LOD1 以降の順のインデックス（TotalIndexCount 個。ShortIndices なら uint16）
+    const void* GpuIndices() const
+    {
+        return ShortIndices() ? static_cast<const void*>(Section<std::uint16_t>(MeshCacheHeader::kGpuIndices))
+                              : static_cast<const void*>(Indices());
+    }
+    bool ShortIndices() const { return (m_header.flags & MeshCacheHeader::kShortIndices) != 0; }
+
+    void CopyMesh(MeshData& out) const;        // Vertices / LOD0 の Indices
+    void CopyLods(MeshLods& out) const;        // LOD1 以降（無ければ空）
+    bool CopyMeshlets(MeshletData& out) const; // 無ければ false（out は空）
+    MeshOptimizeStats OptimizeStats() const;
+
+private:
+    bool Validate(const MeshCacheVertexFormat* format, std::uint64_t sourceHash, std::uint64_t settingsHash, bool verifyContent);
+
+    template <class T>
+    const T* Section(std::uint32_t s) const
+    {
+        return m_header.sections[s].size ? reinterpret_cast<const T*>(m_data + m_header.sections[s].offset) : nullptr;
+    }
+
+    MappedFile                m_file;
+    std::vector<std::uint8_t> m_bytes;  // OpenBytes で引き取った中身
+    const std::uint8_t*       m_data = nullptr;
+    std::size_t               m_size = 0;
+    MeshCacheHeader           m_header;
+    const char*               m_error = nullptr;
+};
+
+/// 64bit のハッシュ（XXH64 と同じ計算。元ファイル/中身のキー用）
+std::uint64_t HashBytes64(const void* data, std::size_t size, std::uint64_t seed = 0);
+
+/// 読み込み/焼き込みの設定と GPU 形式から settingsHash を作る
+std::uint64_t HashMeshCacheSettings(const MeshImportOptions& import, const MeshCacheBuildSettings& build,
+    const MeshCacheVertexFormat& format);
+
+/**
+ * @brief mesh を焼き込んで .mesh のバイト列にする（out は上書き）
+ * @details 最適化 → LOD → メッシュレット → 境界 → GPU 形式への詰め込み → contentHash の順。
+ *          メッシュ単位の処理は各モジュールのとおり（LOD/メッシュレットは逐次）。
+ * @return mesh が空/不正（インデックスが範囲外・頂点数が 32bit を超える）なら false
+ */
+bool BuildMeshCache(const MeshData& mesh, const MeshCacheVertexFormat& format, const MeshCacheBuildSettings& settings,
+    std::uint64_t sourceHash, std::uint64_t settingsHash, std::vector<std::uint8_t>& out);
+
+/// bytes を path に書く（一時ファイルに書いてから置き換えるので、書きかけのファイルは残らない）
+bool WriteMeshCacheFile(const wchar_t* path, const std::vector<std::uint8_t>& bytes);
+
+/**
+ * @brief キャッシュ付きの読み込み
+ * @details 元ファイルのハッシュと設定のハッシュで cachePath（nullptr なら元のパス + L".mesh"）を確かめ、
+ *          合えばマップして返す。合わなければ ImportMesh → BuildMeshCache → WriteMeshCacheFile で作り直し、
+ *          焼き込んだバイト列から開いたものを返す（書き出しに失敗しても結果は返す）。
+ */
+bool ImportMeshCached(const wchar_t* sourcePath, const MeshCacheVertexFormat& format,
+    std::shared_ptr<const MeshCacheFile>& out,
+    const MeshImportOptions& importOptions = MeshImportOptions(),
+    const MeshCacheBuildSettings& buildSettings = MeshCacheBuildSettings(),
+    const wchar_t* cachePath = nullptr, MeshCacheStats* stats = nullptr);
@@ -0,0 +1,1370 @@
+﻿#include "Assets/MeshImporter.h"
+#include "Core/JobSystem.h"
+#include "Core/MappedFile.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <cwchar>
+#include <cwctype>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace DirectX;
+
+/*
+    MeshImporter.cpp
+    ----------------------------------------------------------------------------
+    - 数値は自前で読む（strtof はロケールを見て遅く、終端の NUL も要る。マップしたファイルには無い）。
+      仮数 19 桁までを 64bit 整数に貯め、10 の冪で 1 回割る/掛ける。メッシュの座標には十分な精度。
+    - 並列化の単位：
+        OBJ  …… ファイルを行の境目で切ったチャンク（2 回なめる：数える → 書く）、
+                 三角形（所有者の決定・面法線）、位置（法線の集計）、頂点（法線の書き込み）
+        glTF …… プリミティブごとに頂点範囲・三角形範囲（アクセサの変換と三角形化）
+    - 並列区間の中では例外を投げない（JobSystem が捕まえない）。失敗は atomic なフラグで返す。
+    - 生成法線の向き：変換後（Z 反転 + 巻き順の入れ替え）の cross(b-a, c-a) は表から見て手前、
+      つまり外向き。変換しない右手系 CCW でも同じく外向きなので、どちらでも符号を直す必要は無い。
+*/
+
+namespace
+{
+    constexpr std::uint32_t kNone = 0xFFFFFFFFu;
+    constexpr std::size_t   kVertexGrain = 16 * 1024;   // 頂点/三角形を並列に回すときの 1 チャンク
+    constexpr std::size_t   kObjChunkBytes = 256 * 1024; // OBJ チャンクの最小サイズ
+
+    double Milliseconds(std::chrono::steady_clock::time_point t0)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+
+    // ========================================================================
+    // 字句解析（ポインタを進めるだけ。文字列は作らない）
+    // ========================================================================
+    inline bool IsBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; } // 改行は含めない
+    inline bool IsDigit(char c) { return static_cast<unsigned>(c - '0') < 10u; }
+
+    const char* SkipBlanks(const char* p, const char* end)
+    {
+        while (p < end && IsBlank(*p)) ++p;
+        return p;
+    }
+
+    const char* LineEnd(const char* p, const char* end)
+    {
+        const void* nl = std::memchr(p, '\n', static_cast<std::size_t>(end - p));
+        return nl ? static_cast<const char*>(nl) : end;
+    }
+
+    // 10 進の実数（[+-]digits[.digits][(e|E)[+-]digits]）。数字が 1 つも無ければ false
+    bool ParseNumber(const char*& p, const char* end, double& out)
+    {
+        static const double kPow10[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+        const char* s = p;
+        bool negative = false;
+        if (s < end && (*s == '-' || *s == '+')) negative = (*s++ == '-');
+
+        std::uint64_t mantissa = 0;
+        int digits = 0;   // mantissa に入れた有効桁数
+        int exponent = 0; // 10 の冪
+        bool any = false;
+        for (; s < end && IsDigit(*s); ++s, any = true)
+        {
+            if (digits < 19) { mantissa = mantissa * 10 + static_cast<unsigned>(*s - '0'); digits += mantissa != 0; }
+            else ++exponent;
+        }
+        if (s < end && *s == '.')
+        {
+            for (++s; s < end && IsDigit(*s); ++s, any = true)
+            {
+                if (digits < 19) { mantissa = mantissa * 10 + static_cast<unsigned>(*s - '0'); digits += mantissa != 0; --exponent; }
+            }
+        }
+        if (!any) return false;
+        if (s < end && (*s == 'e' || *s == 'E'))
+        {
+            const char* e = s + 1;
+            bool negExp = false;
+            if (e < end && (*e == '-' || *e == '+')) negExp = (*e++ == '-');
+            if (e < end && IsDigit(*e))
+            {
+                int value = 0;
+                for (; e < end && IsDigit(*e); ++e)
+                    if (value < 10000) value = value * 10 + (*e - '0');
+                exponent += negExp ? -value : value;
+                s = e;
+            }
+        }
+
+        double v = static_cast<double>(mantissa);
+        if (mantissa != 0 && exponent != 0)
+        {
+            if (exponent < 0) v = exponent >= -22 ? v / kPow10[-exponent] : v * std::pow(10.0, exponent);
+            else              v = exponent <= 22 ? v * kPow10[exponent] : v * std::pow(10.0, exponent);
+        }
+        out = negative ? -v : v;
+        p = s;
+        return true;
+    }
+
+    bool ParseFloat(const char*& p, const char* end, float& out)
+    {
+        double v;
+        if (!ParseNumber(p, end, v)) return false;
+        out = static_cast<float>(v);
+        return true;
+    }
+
+    // 符号付き整数（OBJ のインデックス）
+    bool ParseInt(const char*& p, const char* end, std::int64_t& out)
+    {
+        const char* s = p;
+        bool negative = false;
+        if (s < end && (*s == '-' || *s == '+')) negative = (*s++ == '-');
+        if (s >= end || !IsDigit(*s)) return false;
+        std::int64_t v = 0;
+        for (; s < end && IsDigit(*s); ++s)
+            if (v < (std::int64_t(1) << 40)) v = v * 10 + (*s - '0');
+        out = negative ? -v : v;
+        p = s;
+        return true;
+    }
+
+    void SetError(MeshImportStats& stats, const char* message)
+    {
+        if (!stats.error) stats.error = message;
+    }
+
+    // 並列区間からの失敗報告（最初の 1 つを残す）
+    struct ErrorSlot
+    {
+        std::atomic<const char*> message{ nullptr };
+        void Set(const char* m)
+        {
+            const char* expected = nullptr;
+            message.compare_exchange_strong(expected, m, std::memory_order_relaxed);
+        }
+        const char* Get() const { return message.load(std::memory_order_relaxed); }
+    };
+
+    XMFLOAT3 Normalized(const XMFLOAT3& n)
+    {
+        const float len2 = n.x * n.x + n.y * n.y + n.z * n.z;
+        if (!(len2 > 1e-30f) || !std::isfinite(len2)) return { 0.0f, 1.0f, 0.0f }; // 向きが無い：上向きにしておく
+        const float inv = 1.0f / std::sqrt(len2);
+        return { n.x * inv, n.y * inv, n.z * inv };
+    }
+
+    XMFLOAT3 FaceNormal(const XMFLOAT3& a, const XMFLOAT3& b, const XMFLOAT3& c)
+    {
+        const float ux = b.x - a.x, uy = b.y - a.y, uz = b.z - a.z;
+        const float vx = c.x - a.x, vy = c.y - a.y, vz = c.z - a.z;
+        return { uy * vz - uz * vy, uz * vx - ux * vz, ux * vy - uy * vx }; // 長さ = 面積 × 2（重み付けに使う）
+    }
+
+    // ========================================================================
+    // OBJ
+    // ========================================================================
+    struct ObjChunk
+    {
+        const char* begin = nullptr;
+        const char* end = nullptr;
+        std::size_t positions = 0, normals = 0, triangles = 0;          // 1 回目で数える
+        std::size_t positionBase = 0, normalBase = 0, triangleBase = 0; // 累積和（書き込み先）
+        bool        missingNormals = false; // vn の無い角があった
+        const char* error = nullptr;
+    };
+
+    enum class ObjLine { Other, Position, Normal, Face };
+
+    // 行頭のキーワードを見分ける。body は引数の先頭（空白の後）
+    ObjLine ClassifyObjLine(const char* s, const char* lineEnd, const char*& body)
+    {
+        s = SkipBlanks(s, lineEnd);
+        if (lineEnd - s < 2) return ObjLine::Other;
+        if (s[0] == 'v')
+        {
+            if (IsBlank(s[1])) { body = s + 2; return ObjLine::Position; }
+            if (s[1] == 'n' && lineEnd - s >= 3 && IsBlank(s[2])) { body = s + 3; return ObjLine::Normal; }
+        }
+        else if (s[0] == 'f' && IsBlank(s[1]))
+        {
+            body = s + 2;
+            return ObjLine::Face;
+        }
+        return ObjLine::Other;
+    }
+
+    // 1 回目：数えるだけ
+    void CountObjChunk(ObjChunk& c)
+    {
+        for (const char* p = c.begin; p < c.end;)
+        {
+            const char* lineEnd = LineEnd(p, c.end);
+            const char* body = nullptr;
+            switch (ClassifyObjLine(p, lineEnd, body))
+            {
+            case ObjLine::Position: ++c.positions; break;
+            case ObjLine::Normal:   ++c.normals; break;
+            case ObjLine::Face:
+            {
+                std::size_t corners = 0;
+                for (const char* s = SkipBlanks(body, lineEnd); s < lineEnd && *s != '#'; s = SkipBlanks(s, lineEnd))
+                {
+                    ++corners;
+                    while (s < lineEnd && !IsBlank(*s)) ++s;
+                }
+                if (corners >= 3) c.triangles += corners - 2;
+                break;
+            }
+            default: break;
+            }
+            p = lineEnd + 1;
+        }
+    }
+
+    // OBJ の 1 始まり/負（末尾から）のインデックスを 0 始まりへ。範囲外は kNone
+    std::uint32_t ResolveObjIndex(std::int64_t index, std::size_t seen, std::size_t total)
+    {
+        std::int64_t i = index > 0 ? index - 1 : static_cast<std::int64_t>(seen) + index;
+        if (index == 0 || i < 0 || i >= static_cast<std::int64_t>(total)) return kNone;
+        return static_cast<std::uint32_t>(i);
+    }
+
+    struct ObjTargets
+    {
+        Vertex*        vertices = nullptr;  // 位置 i → 頂点 i（位置と色を書く）
+        XMFLOAT3*      normals = nullptr;   // vn
+        std::uint32_t* cornerPos = nullptr; // 三角形の角ごとの位置番号（= MeshData::Indices。後で頂点番号に置き換える）
+        std::uint32_t* cornerNrm = nullptr; // 三角形の角ごとの vn 番号（無ければ kNone）
+        std::size_t    totalPositions = 0, totalNormals = 0;
+        float          scale = 1.0f;
+        float          zSign = 1.0f;
+        bool           flip = false;
+        XMFLOAT4       defaultColor{};
+    };
+
+    // 2 回目：書き込み先が決まったので、値を読んで直接書く
+    void ParseObjChunk(ObjChunk& c, const ObjTargets& t)
+    {
+        std::size_t pos = 0, nrm = 0, tri = 0;
+        for (const char* p = c.begin; p < c.end && !c.error;)
+        {
+            const char* lineEnd = LineEnd(p, c.end);
+            const char* body = nullptr;
+            switch (ClassifyObjLine(p, lineEnd, body))
+            {
+            case ObjLine::Position:
+            {
+                float v[6];
+                int n = 0;
+                for (const char* s = SkipBlanks(body, lineEnd); n < 6 && ParseFloat(s, lineEnd, v[n]); s = SkipBlanks(s, lineEnd)) ++n;
+                if (n < 3) { c.error = "OBJ: bad vertex position"; break; }
+                Vertex& out = t.vertices[c.positionBase + pos++];
+                out.Position = { v[0] * t.scale, v[1] * t.scale, v[2] * t.scale * t.zSign };
+                out.Normal = { 0.0f, 0.0f, 0.0f };
+                out.Color = n >= 6 ? XMFLOAT4{ v[3], v[4], v[5], 1.0f } : t.defaultColor; // "v x y z r g b"（4 つ目だけの w は無視）
+                break;
+            }
+            case ObjLine::Normal:
+            {
+                float v[3];
+                const char* s = SkipBlanks(body, lineEnd);
+                if (!ParseFloat(s, lineEnd, v[0]) || !ParseFloat(s = SkipBlanks(s, lineEnd), lineEnd, v[1])
+                    || !ParseFloat(s = SkipBlanks(s, lineEnd), lineEnd, v[2]))
+                {
+                    c.error = "OBJ: bad vertex normal";
+                    break;
+                }
+                t.normals[c.normalBase + nrm++] = { v[0], v[1], v[2] * t.zSign };
+                break;
+            }
+            case ObjLine::Face:
+            {
+                // 角を 1 つ読むたびに扇形の三角形 (c0, prev, cur) を 1 つ出す（角の配列を持たない）
+                std::uint32_t firstP = kNone, firstN = kNone, prevP = kNone, prevN = kNone;
+                std::size_t corners = 0;
+                for (const char* s = SkipBlanks(body, lineEnd); s < lineEnd && *s != '#'; s = SkipBlanks(s, lineEnd))
+                {
+                    std::int64_t vi = 0, ni = 0;
+                    bool hasNormal = false;
+                    if (!ParseInt(s, lineEnd, vi)) { c.error = "OBJ: bad face index"; break; }
+                    if (s < lineEnd && *s == '/')
+                    {
+                        ++s;
+                        std::int64_t ti;
+                        if (s < lineEnd && *s != '/') ParseInt(s, lineEnd, ti); // vt は使わない
+                        if (s < lineEnd && *s == '/')
+                        {
+                            ++s;
+                            if (!ParseInt(s, lineEnd, ni)) { c.error = "OBJ: bad face index"; break; }
+                            hasNormal = true;
+                        }
+                    }
+                    if (s < lineEnd && !IsBlank(*s)) { c.error = "OBJ: bad face index"; break; }
+
+                    const std::uint32_t cp = ResolveObjIndex(vi, c.positionBase + pos, t.totalPositions);
+                    const std::uint32_t cn = hasNormal ? ResolveObjIndex(ni, c.normalBase + nrm, t.totalNormals) : kNone;
+                    if (cp == kNone || (hasNormal && cn == kNone)) { c.error = "OBJ: face index out of range"; break; }
+                    if (!hasNormal) c.missingNormals = true;
+
+                    if (corners == 0) { firstP = cp; firstN = cn; }
+                    else if (corners >= 2)
+                    {
+                        const std::size_t k = (c.triangleBase + tri++) * 3;
+                        t.cornerPos[k] = firstP; t.cornerNrm[k] = firstN;
+                        t.cornerPos[k + 1] = t.flip ? cp : prevP; t.cornerNrm[k + 1] = t.flip ? cn : prevN;
+                        t.cornerPos[k + 2] = t.flip ? prevP : cp; t.cornerNrm[k + 2] = t.flip ? prevN : cn;
+                    }
+                    prevP = cp; prevN = cn;
+                    ++corners;
+                }
+                break;
+            }
+            default: break;
+            }
+            p = lineEnd + 1;
+        }
+        if (!c.error && (pos != c.positions || nrm != c.normals || tri != c.triangles))
+            c.error = "OBJ: inconsistent line count"; // 1 回目と 2 回目で数が違う（起きないはず）
+    }
+
+    // (位置, 法線) の組 → 追加した頂点番号（開番地法。組は 64bit にまとめる）
+    class PairTable
+    {
+    public:
+        explicit PairTable(std::size_t expected)
+        {
+            std::size_t cap = 16;
+            while (cap < expected * 2) cap <<= 1;
+            m_keys.assign(cap, ~0ull);
+            m_values.resize(cap);
+        }
+
+        // 見つかればその値、無ければ value を登録して返す
+        std::uint32_t FindOrAdd(std::uint64_t key, std::uint32_t value)
+        {
+            const std::size_t mask = m_keys.size() - 1;
+            std::size_t i = static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+            while (m_keys[i] != ~0ull)
+            {
+                if (m_keys[i] == key) return m_values[i];
+                i = (i + 1) & mask;
+            }
+            m_keys[i] = key;
+            m_values[i] = value;
+            return value;
+        }
+
+    private:
+        std::vector<std::uint64_t> m_keys;
+        std::vector<std::uint32_t> m_values;
+    };
+
+    bool ImportObj(const char* text, std::size_t size, MeshData& out, const MeshImportOptions& options, MeshImportStats& stats)
+    {
+        // ---- チャンクに分ける（境目は次の改行の直後へずらす） ----
+        const std::size_t wanted = std::max<std::size_t>(1, std::min<std::size_t>(size / kObjChunkBytes + 1, JobSystem::WorkerCount() * 4));
+        std::vector<ObjChunk> chunks(wanted);
+        const char* end = text + size;
+        const char* cut = text;
+        for (std::size_t k = 0; k < wanted; ++k)
+        {
+            chunks[k].begin = cut;
+            if (k + 1 == wanted) cut = end;
+            else
+            {
+                const char* target = std::max(cut, text + size * (k + 1) / wanted);
+                cut = target < end ? std::min(end, LineEnd(target, end) + 1) : end;
+            }
+            chunks[k].end = cut;
+        }
+
+        // ---- 1 回目：数える → 累積和 ----
+        JobSystem::ParallelFor(chunks.size(), 1, [&](std::size_t b, std::size_t e)
+            {
+                for (std::size_t k = b; k < e; ++k) CountObjChunk(chunks[k]);
+            });
+        std::size_t positions = 0, normals = 0, triangles = 0;
+        for (ObjChunk& c : chunks)
+        {
+            c.positionBase = positions; c.normalBase = normals; c.triangleBase = triangles;
+            positions += c.positions; normals += c.normals; triangles += c.triangles;
+        }
+        stats.positions = positions;
+        if (triangles == 0) { SetError(stats, "OBJ: no faces"); return false; }
+        if (positions >= kNone || triangles * 3 >= kNone) { SetError(stats, "OBJ: too many vertices"); return false; }
+
+        // ---- 2 回目：位置/色は頂点配列へ、角は Indices へ直接書く ----
+        std::vector<XMFLOAT3> fileNormals(normals);
+        std::vector<std::uint32_t> cornerNrm(triangles * 3);
+        out.Vertices.resize(positions);
+        out.Indices.resize(triangles * 3);
+        ObjTargets t;
+        t.vertices = out.Vertices.data();
+        t.normals = fileNormals.data();
+        t.cornerPos = out.Indices.data();
+        t.cornerNrm = cornerNrm.data();
+        t.totalPositions = positions;
+        t.totalNormals = normals;
+        t.scale = options.scale;
+        t.zSign = options.convertToLeftHanded ? -1.0f : 1.0f;
+        t.flip = options.convertToLeftHanded;
+        t.defaultColor = options.defaultColor;
+        JobSystem::ParallelFor(chunks.size(), 1, [&](std::size_t b, std::size_t e)
+            {
+                for (std::size_t k = b; k < e; ++k) ParseObjChunk(chunks[k], t);
+            });
+        bool missingNormals = normals == 0;
+        for (const ObjChunk& c : chunks)
+        {
+            if (c.error) { SetError(stats, c.error); return false; }
+            missingNormals |= c.missingNormals;
+        }
+
+        const std::size_t cornerCount = out.Indices.size();
+        std::vector<std::uint32_t> owner;        // 位置 → その位置を最初に使った角（法線はその角のもの）
+        std::vector<std::uint32_t> extraSource;  // 追加頂点 → 位置番号
+        std::vector<std::uint32_t> extraNormal;  // 追加頂点 → vn 番号
+        if (normals > 0)
+        {
+            // ---- 位置ごとの所有者 = 最小の角番号（atomic な min。順序によらず同じ結果） ----
+            std::unique_ptr<std::atomic<std::uint32_t>[]> first(new std::atomic<std::uint32_t>[positions]);
+            JobSystem::ParallelFor(positions, kVertexGrain, [&](std::size_t b, std::size_t e)
+                {
+                    for (std::size_t i = b; i < e; ++i) first[i].store(kNone, std::memory_order_relaxed);
+                });
+            JobSystem::ParallelFor(cornerCount, kVertexGrain, [&](std::size_t b, std::size_t e)
+                {
+                    for (std::size_t k = b; k < e; ++k)
+                    {
+                        std::atomic<std::uint32_t>& slot = first[out.Indices[k]];
+                        std::uint32_t cur = slot.load(std::memory_order_relaxed);
+                        while (k < cur && !slot.compare_exchange_weak(cur, static_cast<std::uint32_t>(k), std::memory_order_relaxed)) {}
+                    }
+                });
+            owner.resize(positions);
+            for (std::size_t i = 0; i < positions; ++i) owner[i] = first[i].load(std::memory_order_relaxed);
+
+            // ---- 所有者と法線が違う角を集める（チャンク順に連結するので結果は決定的） ----
+            const std::size_t blocks = (cornerCount + kVertexGrain - 1) / kVertexGrain;
+            std::vector<std::vector<std::uint32_t>> pending(blocks);
+            JobSystem::ParallelFor(blocks, 1, [&](std::size_t b, std::size_t e)
+                {
+                    for (std::size_t blk = b; blk < e; ++blk)
+                    {
+                        const std::size_t last = std::min(cornerCount, (blk + 1) * kVertexGrain);
+                        for (std::size_t k = blk * kVertexGrain; k < last; ++k)
+                            if (cornerNrm[owner[out.Indices[k]]] != cornerNrm[k]) pending[blk].push_back(static_cast<std::uint32_t>(k));
+                    }
+                });
+            std::size_t pendingCount = 0;
+            for (const auto& p : pending) pendingCount += p.size();
+
+            // ---- 違う組だけ頂点を足す（直列。滑らかなメッシュではごく少ない） ----
+            if (pendingCount > 0)
+            {
+                PairTable table(pendingCount);
+                for (const auto& list : pending)
+                {
+                    for (std::uint32_t k : list)
+                    {
+                        const std::uint32_t p = out.Indices[k];
+                        const std::uint64_t key = (static_cast<std::uint64_t>(p) << 32) | cornerNrm[k];
+                        const std::uint32_t next = static_cast<std::uint32_t>(positions + extraSource.size());
+                        const std::uint32_t v = table.FindOrAdd(key, next);
+                        if (v == next)
+                        {
+                            extraSource.push_back(p);
+                            extraNormal.push_back(cornerNrm[k]);
+                        }
+                        out.Indices[k] = v;
+                    }
+                }
+                if (positions + extraSource.size() >= kNone) { SetError(stats, "OBJ: too many vertices"); return false; }
+            }
+        }
+
+        const std::size_t vertexCount = positions + extraSource.size();
+        out.Vertices.resize(vertexCount);
+        for (std::size_t j = 0; j < extraSource.size(); ++j)
+            out.Vertices[positions + j] = out.Vertices[extraSource[j]]; // 位置と色は同じ
+
+        // ---- 法線の無い頂点のために、位置ごとの滑らかな法線を作る ----
+        std::vector<XMFLOAT3> smooth;
+        if (missingNormals)
+        {
+            auto sourceOf = [&](std::uint32_t v) { return v < positions ? v : extraSource[v - positions]; };
+
+            // 面法線（面積の重み付き）
+            std::vector<XMFLOAT3> faceNormals(triangles);
+            JobSystem::ParallelFor(triangles, kVertexGrain, [&](std::size_t b, std::size_t e)
+                {
+                    for (std::size_t f = b; f < e; ++f)
+                    {
+                        const std::uint32_t* tri = &out.Indices[f * 3];
+                        faceNormals[f] = FaceNormal(out.Vertices[tri[0]].Position, out.Vertices[tri[1]].Position, out.Vertices[tri[2]].Position);
+                    }
+                });
+
+            // 位置 → 三角形の表（CSR。数えて並べるだけなので直列）
+            std::vector<std::uint32_t> start(positions + 1, 0), faces(cornerCount);
+            for (std::size_t k = 0; k < cornerCount; ++k) ++start[sourceOf(out.Indices[k]) + 1];
+            for (std::size_t i = 0; i < positions; ++i) start[i + 1] += start[i];
+            {
+                std::vector<std::uint32_t> fill(start.begin(), start.end() - 1);
+                for (std::size_t k = 0; k < cornerCount; ++k) faces[fill[sourceOf(out.Indices[k])]++] = static_cast<std::uint32_t>(k / 3);
+            }
+
+            smooth.resize(positions);
+            JobSystem::ParallelFor(positions, kVertexGrain, [&](std::size_t b, std::size_t e)
+                {
+                    for (std::size_t i = b; i < e; ++i)
+                    {
+                        XMFLOAT3 sum{ 0.0f, 0.0f, 0.0f };
+                        for (std::uint32_t j = start[i]; j < start[i + 1]; ++j)
+                        {
+                            const XMFLOAT3& n = faceNormals[faces[j]];
+                            sum.x += n.x; sum.y += n.y; sum.z += n.z;
+                        }
+                        smooth[i] = Normalized(sum);
+                    }
+                });
+            stats.generatedNormals = true;
+        }
+
+        // ---- 頂点の法線：ファイルの vn があればそれ、無ければ位置ごとの生成法線 ----
+        JobSystem::ParallelFor(vertexCount, kVertexGrain, [&](std::size_t b, std::size_t e)
+            {
+                for (std::size_t v = b; v < e; ++v)
+                {
+                    std::uint32_t n = kNone, source = static_cast<std::uint32_t>(v);
+                    if (v < positions) { if (!owner.empty() && owner[v] != kNone) n = cornerNrm[owner[v]]; }
+                    else { source = extraSource[v - positions]; n = extraNormal[v - positions]; }
+                    if (n != kNone)              out.Vertices[v].Normal = Normalized(fileNormals[n]);
+                    else if (!smooth.empty())    out.Vertices[v].Normal = smooth[source];
+                    else                         out.Vertices[v].Normal = { 0.0f, 1.0f, 0.0f }; // どの面にも使われない位置
+                }
+            });
+        return true;
+    }
+
+    // ========================================================================
+    // JSON（glTF 用の最小のトークナイザ。トークンは元の文字列の位置だけを持つ）
+    // ========================================================================
+    enum class JsonType : std::uint8_t { Object, Array, String, Primitive };
+
+    struct JsonToken
+    {
+        JsonType      type = JsonType::Primitive;
+        std::uint32_t start = 0, end = 0; // 文字列は引用符の内側
+        std::uint32_t size = 0;           // 子の数（オブジェクトはキーの数）
+        std::uint32_t next = 0;           // この部分木の次のトークン
+    };
+
+    class JsonDocument
+    {
+    public:
+        bool Parse(const char* text, std::size_t length)
+        {
+            m_text = text;
+            m_end = text + length;
+            m_tokens.clear();
+            m_tokens.reserve(length / 16 + 16);
+            const char* p = Skip(text);
+            if (!Value(p, 0)) return false;
+            return Skip(p) == m_end || *Skip(p) == '\0';
+        }
+
+        bool Empty() const { return m_tokens.empty(); }
+
+        /// オブジェクト obj のキー key の値（無ければ -1）
+        int Find(int obj, const char* key) const
+        {
+            if (obj < 0 || m_tokens[obj].type != JsonType::Object) return -1;
+            const std::size_t len = std::strlen(key);
+            std::uint32_t t = static_cast<std::uint32_t>(obj) + 1;
+            for (std::uint32_t i = 0; i < m_tokens[obj].size; ++i)
+            {
+                const JsonToken& k = m_tokens[t];
+                const std::uint32_t value = t + 1;
+                if (k.end - k.start == len && std::memcmp(m_text + k.start, key, len) == 0) return static_cast<int>(value);
+                t = m_tokens[value].next;
+            }
+            return -1;
+        }
+
+        /// 配列 arr の i 番目（範囲外は -1）
+        int At(int arr, std::size_t i) const
+        {
+            if (arr < 0 || m_tokens[arr].type != JsonType::Array || i >= m_tokens[arr].size) return -1;
+            std::uint32_t t = static_cast<std::uint32_t>(arr) + 1;
+            while (i--) t = m_tokens[t].next;
+            return static_cast<int>(t);
+        }
+
+        /// 配列の最初の要素と次の要素（At を繰り返すより速い）
+        int First(int arr) const { return Count(arr) > 0 && m_tokens[arr].type == JsonType::Array ? arr + 1 : -1; }
+        int Next(int t) const { return static_cast<int>(m_tokens[t].next); }
+
+        std::size_t Count(int t) const { return t < 0 ? 0 : m_tokens[t].size; }
+        bool IsArray(int t) const { return t >= 0 && m_tokens[t].type == JsonType::Array; }
+        bool IsObject(int t) const { return t >= 0 && m_tokens[t].type == JsonType::Object; }
+
+        bool Number(int t, double& out) const
+        {
+            if (t < 0 || m_tokens[t].type != JsonType::Primitive) return false;
+            const char* p = m_text + m_tokens[t].start;
+            return ParseNumber(p, m_text + m_tokens[t].end, out) && p == m_text + m_tokens[t].end;
+        }
+
+        double NumberOr(int t, double fallback) const
+        {
+            double v;
+            return Number(t, v) ? v : fallback;
+        }
+
+        /// 0 以上の整数（無い/不正なら fallback）
+        std::int64_t IndexOr(int t, std::int64_t fallback) const
+        {
+            double v;
+            if (!Number(t, v) || v < 0 || v != std::floor(v) || v > 4294967295.0) return fallback;
+            return static_cast<std::int64_t>(v);
+        }
+
+        bool BoolOr(int t, bool fallback) const
+        {
+            if (t < 0 || m_tokens[t].type != JsonType::Primitive) return fallback;
+            return m_text[m_tokens[t].start] == 't' ? true : m_text[m_tokens[t].start] == 'f' ? false : fallback;
+        }
+
+        /// 文字列トークンの中身（エスケープはそのまま）
+        bool String(int t, const char*& s, std::size_t& len) const
+        {
+            if (t < 0 || m_tokens[t].type != JsonType::String) return false;
+            s = m_text + m_tokens[t].start;
+            len = m_tokens[t].end - m_tokens[t].start;
+            return true;
+        }
+
+        bool Equals(int t, const char* s) const
+        {
+            const char* v;
+            std::size_t len;
+            return String(t, v, len) && len == std::strlen(s) && std::memcmp(v, s, len) == 0;
+        }
+
+    private:
+        static constexpr int kMaxDepth = 64;
+
+        const char* Skip(const char* p) const
+        {
+            while (p < m_end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) ++p;
+            return p;
+        }
+
+        std::uint32_t Add(JsonType type, const char* start)
+        {
+            JsonToken t;
+            t.type = type;
+            t.start = static_cast<std::uint32_t>(start - m_text);
+            m_tokens.push_back(t);
+            return static_cast<std::uint32_t>(m_tokens.size() - 1);
+        }
+
+        bool StringToken(const char*& p)
+        {
+            const std::uint32_t id = Add(JsonType::String, p + 1);
+            for (++p; p < m_end; ++p)
+            {
+                if (*p == '\\') { if (++p >= m_end) return false; continue; }
+                if (*p == '"')
+                {
+                    m_tokens[id].end = static_cast<std::uint32_t>(p - m_text);
+                    m_tokens[id].next = id + 1;
+                    ++p;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool Value(const char*& p, int depth)
+        {
+            if (p >= m_end || depth > kMaxDepth) return false;
+            if (*p == '"') return StringToken(p);
+            if (*p == '{' || *p == '[')
+            {
+                const bool object = *p == '{';
+                const char close = object ? '}' : ']';
+                const std::uint32_t id = Add(object ? JsonType::Object : JsonType::Array, p);
+                std::uint32_t count = 0;
+                p = Skip(p + 1);
+                if (p < m_end && *p == close) ++p;
+                else
+                {
+                    for (;;)
+                    {
+                        if (object)
+                        {
+                            if (p >= m_end || *p != '"' || !StringToken(p)) return false;
+                            p = Skip(p);
+                            if (p >= m_end || *p != ':') return false;
+                            p = Skip(p + 1);
+                        }
+                        if (!Value(p, depth + 1)) return false;
+                        ++count;
+                        p = Skip(p);
+                        if (p < m_end && *p == ',') { p = Skip(p + 1); continue; }
+                        if (p < m_end && *p == close) { ++p; break; }
+                        return false;
+                    }
+                }
+                m_tokens[id].end = static_cast<std::uint32_t>(p - m_text);
+                m_tokens[id].size = count;
+                m_tokens[id].next = static_cast<std::uint32_t>(m_tokens.size());
+                return true;
+            }
+            // 数値 / true / false / null
+            const std::uint32_t id = Add(JsonType::Primitive, p);
+            while (p < m_end && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') ++p;
+            m_tokens[id].end = static_cast<std::uint32_t>(p - m_text);
+            m_tokens[id].next = id + 1;
+            return m_tokens[id].end > m_tokens[id].start;
+        }
+
+        const char*            m_text = nullptr;
+        const char*            m_end = nullptr;
+        std::vector<JsonToken> m_tokens;
+    };
+
+    // ========================================================================
+    // glTF
+    // ========================================================================
+    constexpr std::uint32_t kGlbMagic = 0x46546C67; // "glTF"
+    constexpr std::uint32_t kGlbJson = 0x4E4F534A;  // "JSON"
+    constexpr std::uint32_t kGlbBin = 0x004E4942;   // "BIN\0"
+
+    std::uint32_t ReadU32(const std::uint8_t* p)
+    {
+        std::uint32_t v;
+        std::memcpy(&v, p, 4);
+        return v; // glTF はリトルエンディアン（このエンジンの対象も同じ）
+    }
+
+    bool DecodeBase64(const char* s, std::size_t len, std::vector<std::uint8_t>& out)
+    {
+        static const auto table = []
+            {
+                std::array<std::int8_t, 256> t{};
+                t.fill(-1);
+                const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+                for (int i = 0; i < 64; ++i) t[static_cast<unsigned char>(alphabet[i])] = static_cast<std::int8_t>(i);
+                return t;
+            }();
+        out.clear();
+        out.reserve(len / 4 * 3);
+        std::uint32_t acc = 0;
+        int bits = 0;
+        for (std::size_t i = 0; i < len; ++i)
+        {
+            const char c = s[i];
+            if (c == '=') break;
+            const std::int8_t v = table[static_cast<unsigned char>(c)];
+            if (v < 0) return false;
+            acc = (acc << 6) | static_cast<std::uint32_t>(v);
+            bits += 6;
+            if (bits >= 8)
+            {
+                bits -= 8;
+                out.push_back(static_cast<std::uint8_t>(acc >> bits));
+            }
+        }
+        return true;
+    }
+
+    // URI（UTF-8、%XX を含みうる）→ ワイド文字のパス
+    bool DecodeUriPath(const char* s, std::size_t len, std::wstring& out)
+    {
+        std::string bytes;
+        bytes.reserve(len);
+        for (std::size_t i = 0; i < len; ++i)
+        {
+            if (s[i] == '%' && i + 2 < len)
+            {
+                auto hex = [](char c) { return c >= '0' && c <= '9' ? c - '0' : (c | 0x20) >= 'a' && (c | 0x20) <= 'f' ? (c | 0x20) - 'a' + 10 : -1; };
+                const int hi = hex(s[i + 1]), lo = hex(s[i + 2]);
+                if (hi < 0 || lo < 0) return false;
+                bytes.push_back(static_cast<char>(hi * 16 + lo));
+                i += 2;
+            }
+            else bytes.push_back(s[i]);
+        }
+        out.clear();
+        for (std::size_t i = 0; i < bytes.size();)
+        {
+            const unsigned char c = static_cast<unsigned char>(bytes[i]);
+            const int n = c < 0x80 ? 1 : (c >> 5) == 0x6 ? 2 : (c >> 4) == 0xE ? 3 : (c >> 3) == 0x1E ? 4 : 0;
+            if (n == 0 || i + n > bytes.size()) return false;
+            std::uint32_t cp = n == 1 ? c : c & (0x7F >> n);
+            for (int k = 1; k < n; ++k) cp = (cp << 6) | (static_cast<unsigned char>(bytes[i + k]) & 0x3F);
+            if (cp >= 0x10000 && sizeof(wchar_t) == 2)
+            {
+                cp -= 0x10000;
+                out.push_back(static_cast<wchar_t>(0xD800 + (cp >> 10)));
+                out.push_back(static_cast<wchar_t>(0xDC00 + (cp & 0x3FF)));
+            }
+            else out.push_back(static_cast<wchar_t>(cp));
+            i += n;
+        }
+        return true;
+    }
+
+    struct GltfBuffer
+    {
+        const std::uint8_t* data = nullptr;
+        std::size_t         size = 0;
+    };
+
+    struct GltfView
+    {
+        std::uint32_t buffer = 0;
+        std::size_t   offset = 0, length = 0, stride = 0;
+    };
+
+    // 読み出し準備の済んだアクセサ（data = nullptr は「全部 0」）
+    struct GltfAccessor
+    {
+        const std::uint8_t* data = nullptr;
+        std::size_t         stride = 0;
+        std::size_t         count = 0;
+        std::uint32_t       componentType = 0;
+        std::uint32_t       components = 0;
+        bool                normalized = false;
+
+        float Read(std::size_t i, std::uint32_t c) const
+        {
+            if (!data || c >= components) return 0.0f;
+            const std::uint8_t* p = data + i * stride;
+            switch (componentType)
+            {
+            case 5126: { float v; std::memcpy(&v, p + c * 4, 4); return v; }
+            case 5121: { const float v = p[c]; return normalized ? v / 255.0f : v; }
+            case 5120: { const float v = static_cast<std::int8_t>(p[c]); return normalized ? std::max(v / 127.0f, -1.0f) : v; }
+            case 5123: { std::uint16_t u; std::memcpy(&u, p + c * 2, 2); const float v = u; return normalized ? v / 65535.0f : v; }
+            case 5122: { std::int16_t s; std::memcpy(&s, p + c * 2, 2); const float v = s; return normalized ? std::max(v / 32767.0f, -1.0f) : v; }
+            case 5125: { return static_cast<float>(ReadU32(p + c * 4)); }
+            default:   return 0.0f;
+            }
+        }
+
+        std::uint32_t Index(std::size_t i) const
+        {
+            if (!data) return 0;
+            const std::uint8_t* p = data + i * stride;
+            switch (componentType)
+            {
+            case 5121: return p[0];
+            case 5123: { std::uint16_t u; std::memcpy(&u, p, 2); return u; }
+            case 5125: return ReadU32(p);
+            default:   return kNone;
+            }
+        }
+    };
+
+    std::uint32_t ComponentSize(std::uint32_t type)
+    {
+        switch (type)
+        {
+        case 5120: case 5121: return 1;
+        case 5122: case 5123: return 2;
+        case 5125: case 5126: return 4;
+        default:              return 0;
+        }
+    }
+
+    std::uint32_t ComponentCount(const JsonDocument& json, int type)
+    {
+        static const struct { const char* name; std::uint32_t n; } kTypes[] = {
+            { "SCALAR", 1 }, { "VEC2", 2 }, { "VEC3", 3 }, { "VEC4", 4 }, { "MAT2", 4 }, { "MAT3", 9 }, { "MAT4", 16 } };
+        for (const auto& t : kTypes)
+            if (json.Equals(type, t.name)) return t.n;
+        return 0;
+    }
+
+    class GltfLoader
+    {
+    public:
+        GltfLoader(const MeshImportOptions& options, MeshImportStats& stats, const std::wstring* baseDir)
+            : m_options(options), m_stats(stats), m_baseDir(baseDir) {}
+
+        bool Load(const std::uint8_t* data, std::size_t size, bool binary, MeshData& out)
+        {
+            const char* jsonText = reinterpret_cast<const char*>(data);
+            std::size_t jsonSize = size;
+            GltfBuffer bin;
+            if (binary)
+            {
+                if (size < 20 || ReadU32(data) != kGlbMagic) return Fail("GLB: bad header");
+                if (ReadU32(data + 4) != 2) return Fail("GLB: unsupported version");
+                const std::size_t total = std::min<std::size_t>(ReadU32(data + 8), size);
+                std::size_t at = 12;
+                jsonText = nullptr;
+                while (at + 8 <= total)
+                {
+                    const std::size_t length = ReadU32(data + at);
+                    const std::uint32_t type = ReadU32(data + at + 4);
+                    if (at + 8 + length > total) return Fail("GLB: truncated chunk");
+                    if (type == kGlbJson && !jsonText) { jsonText = reinterpret_cast<const char*>(data + at + 8); jsonSize = length; }
+                    else if (type == kGlbBin && !bin.data) { bin.data = data + at + 8; bin.size = length; }
+                    at += 8 + ((length + 3) & ~std::size_t(3));
+                }
+                if (!jsonText) return Fail("GLB: missing JSON chunk");
+            }
+            if (!m_json.Parse(jsonText, jsonSize) || !m_json.IsObject(0)) return Fail("glTF: bad JSON");
+
+            if (!LoadBuffers(bin) || !LoadViews()) return false;
+            if (!CollectInstances()) return false;
+
+            out.Vertices.clear();
+            out.Indices.clear();
+            for (const Instance& inst : m_instances)
+            {
+                const int primitives = m_json.Find(m_json.At(m_json.Find(0, "meshes"), inst.mesh), "primitives");
+                int p = m_json.First(primitives);
+                for (std::size_t i = 0; i < m_json.Count(primitives); ++i, p = m_json.Next(p))
+                    if (!AppendPrimitive(p, inst.world, out)) return false;
+            }
+            if (out.Indices.empty()) return Fail("glTF: no triangles");
+            return true;
+        }
+
+    private:
+        struct Instance
+        {
+            std::size_t mesh = 0;
+            XMFLOAT4X4  world{};
+        };
+
+        bool Fail(const char* message)
+        {
+            SetError(m_stats, message);
+            return false;
+        }
+
+        bool LoadBuffers(const GltfBuffer& bin)
+        {
+            const int buffers = m_json.Find(0, "buffers");
+            m_buffers.assign(m_json.Count(buffers), GltfBuffer());
+            std::size_t i = 0;
+            for (int b = m_json.First(buffers); b >= 0 && i < m_buffers.size(); b = m_json.Next(b), ++i)
+            {
+                const std::int64_t length = m_json.IndexOr(m_json.Find(b, "byteLength"), -1);
+                if (length < 0) return Fail("glTF: buffer without byteLength");
+                const char* uri;
+                std::size_t uriLen;
+                if (!m_json.String(m_json.Find(b, "uri"), uri, uriLen))
+                {
+                    // URI の無いバッファ = GLB の BIN チャンク（0 番のみ）
+                    if (i != 0 || !bin.data) return Fail("glTF: buffer has no data");
+                    m_buffers[i] = bin;
+                }
+                else if (uriLen >= 5 && std::memcmp(uri, "data:", 5) == 0)
+                {
+                    const char* comma = static_cast<const char*>(std::memchr(uri, ',', uriLen));
+                    if (!comma || comma - uri < 7 || std::memcmp(comma - 7, ";base64", 7) != 0) return Fail("glTF: unsupported data URI");
+                    m_owned.emplace_back();
+                    if (!DecodeBase64(comma + 1, uriLen - (comma + 1 - uri), m_owned.back())) return Fail("glTF: bad base64");
+                    m_buffers[i] = { m_owned.back().data(), m_owned.back().size() };
+                }
+                else
+                {
+                    std::wstring path;
+                    if (!m_baseDir || !DecodeUriPath(uri, uriLen, path)) return Fail("glTF: external buffer not available");
+                    m_files.emplace_back(std::make_unique<MappedFile>());
+                    if (!m_files.back()->Open((*m_baseDir + path).c_str())) return Fail("glTF: cannot open external buffer");
+                    m_buffers[i] = { m_files.back()->Data(), m_files.back()->Size() };
+                }
+                if (m_buffers[i].size < static_cast<std::size_t>(length)) return Fail("glTF: buffer shorter than byteLength");
+                m_buffers[i].size = static_cast<std::size_t>(length);
+            }
+            return true;
+        }
+
+        bool LoadViews()
+        {
+            const int views = m_json.Find(0, "bufferViews");
+            m_views.reserve(m_json.Count(views));
+            for (int v = m_json.First(views); v >= 0 && m_views.size() < m_json.Count(views); v = m_json.Next(v))
+            {
+                GltfView view;
+                const std::int64_t buffer = m_json.IndexOr(m_json.Find(v, "buffer"), -1);
+                const std::int64_t length = m_json.IndexOr(m_json.Find(v, "byteLength"), -1);
+                if (buffer < 0 || buffer >= static_cast<std::int64_t>(m_buffers.size()) || length < 0) return Fail("glTF: bad bufferView");
+                view.buffer = static_cast<std::uint32_t>(buffer);
+                view.offset = static_cast<std::size_t>(m_json.IndexOr(m_json.Find(v, "byteOffset"), 0));
+                view.length = static_cast<std::size_t>(length);
+                view.stride = static_cast<std::size_t>(m_json.IndexOr(m_json.Find(v, "byteStride"), 0));
+                if (view.offset > m_buffers[view.buffer].size || view.length > m_buffers[view.buffer].size - view.offset)
+                    return Fail("glTF: bufferView out of range");
+                m_views.push_back(view);
+            }
+            return true;
+        }
+
+        // index 番のアクセサを読める形にする（範囲は全部ここで確かめる）
+        bool Accessor(std::int64_t index, GltfAccessor& out)
+        {
+            const int a = m_json.At(m_json.Find(0, "accessors"), static_cast<std::size_t>(index));
+            if (index < 0 || a < 0) return Fail("glTF: bad accessor index");
+            if (m_json.Find(a, "sparse") >= 0) return Fail("glTF: sparse accessors are not supported");
+            out = GltfAccessor();
+            out.componentType = static_cast<std::uint32_t>(m_json.IndexOr(m_json.Find(a, "componentType"), 0));
+            out.components = ComponentCount(m_json, m_json.Find(a, "type"));
+            out.count = static_cast<std::size_t>(m_json.IndexOr(m_json.Find(a, "count"), 0));
+            out.normalized = m_json.BoolOr(m_json.Find(a, "normalized"), false);
+            const std::uint32_t compSize = ComponentSize(out.componentType);
+            if (compSize == 0 || out.components == 0) return Fail("glTF: bad accessor type");
+
+            const std::int64_t viewIndex = m_json.IndexOr(m_json.Find(a, "bufferView"), -1);
+            if (viewIndex < 0) return true; // bufferView 無し = 全部 0
+            if (viewIndex >= static_cast<std::int64_t>(m_views.size())) return Fail("glTF: bad bufferView index");
+            const GltfView& view = m_views[static_cast<std::size_t>(viewIndex)];
+            const std::size_t offset = static_cast<std::size_t>(m_json.IndexOr(m_json.Find(a, "byteOffset"), 0));
+            const std::size_t elementSize = static_cast<std::size_t>(compSize) * out.components;
+            out.stride = view.stride ? view.stride : elementSize;
+            if (out.stride < elementSize) return Fail("glTF: byteStride smaller than element");
+            if (out.count > 0)
+            {
+                // offset + stride × (count - 1) + elementSize <= view.length（桁あふれしない形で）
+                if (offset > view.length || elementSize > view.length - offset
+                    || out.count - 1 > (view.length - offset - elementSize) / out.stride)
+                    return Fail("glTF: accessor out of range");
+            }
+            out.data = m_buffers[view.buffer].data + view.offset + offset;
+            return true;
+        }
+
+        // シーンのノードを辿り、メッシュを持つノードのワールド行列を集める
+        bool CollectInstances()
+        {
+            const int meshes = m_json.Find(0, "meshes");
+            const int nodes = m_json.Find(0, "nodes");
+            const int scenes = m_json.Find(0, "scenes");
+            const std::size_t meshCount = m_json.Count(meshes);
+            m_instances.clear();
+            if (m_json.Count(scenes) == 0)
+            {
+                // シーンが無い：全メッシュを単位行列で
+                for (std::size_t m = 0; m < meshCount; ++m)
+                {
+                    Instance inst;
+                    inst.mesh = m;
+                    XMStoreFloat4x4(&inst.world, XMMatrixIdentity());
+                    m_instances.push_back(inst);
+                }
+                return true;
+            }
+            const std::size_t sceneIndex = static_cast<std::size_t>(m_json.IndexOr(m_json.Find(0, "scene"), 0));
+            const int scene = m_json.At(scenes, sceneIndex);
+            if (scene < 0) return Fail("glTF: bad scene index");
+
+            struct Item { std::int64_t node; XMFLOAT4X4 parent; };
+            std::vector<Item> stack;
+            const int roots = m_json.Find(scene, "nodes");
+            XMFLOAT4X4 identity;
+            XMStoreFloat4x4(&identity, XMMatrixIdentity());
+            for (std::size_t i = m_json.Count(roots); i-- > 0;)
+                stack.push_back({ m_json.IndexOr(m_json.At(roots, i), -1), identity });
+
+            std::size_t visited = 0;
+            const std::size_t nodeCount = m_json.Count(nodes);
+            while (!stack.empty())
+            {
+                const Item item = stack.back();
+                stack.pop_back();
+                const int node = m_json.At(nodes, static_cast<std::size_t>(item.node));
+                if (item.node < 0 || node < 0) return Fail("glTF: bad node index");
+                if (++visited > nodeCount) return Fail("glTF: node hierarchy has a cycle");
+
+                const XMMATRIX world = LocalMatrix(node) * XMLoadFloat4x4(&item.parent);
+                XMFLOAT4X4 w;
+                XMStoreFloat4x4(&w, world);
+                const std::int64_t mesh = m_json.IndexOr(m_json.Find(node, "mesh"), -1);
+                if (mesh >= 0)
+                {
+                    if (static_cast<std::size_t>(mesh) >= meshCount) return Fail("glTF: bad mesh index");
+                    m_instances.push_back({ static_cast<std::size_t>(mesh), w });
+                }
+                const int children = m_json.Find(node, "children");
+                for (std::size_t i = m_json.Count(children); i-- > 0;)
+                    stack.push_back({ m_json.IndexOr(m_json.At(children, i), -1), w });
+            }
+            return true;
+        }
+
+        // ノードのローカル行列（matrix は列優先の 16 要素 = 行ベクトル用の行優先としてそのまま読める）
+        XMMATRIX LocalMatrix(int node) const
+        {
+            const int matrix = m_json.Find(node, "matrix");
+            if (m_json.Count(matrix) == 16)
+            {
+                XMFLOAT4X4 m;
+                float* f = &m._11;
+                int e = m_json.First(matrix);
+                for (int i = 0; i < 16; ++i, e = m_json.Next(e)) f[i] = static_cast<float>(m_json.NumberOr(e, i % 5 == 0 ? 1.0 : 0.0));
+                return XMLoadFloat4x4(&m);
+            }
+            auto vec = [&](const char* key, int n, XMFLOAT4 fallback)
+                {
+                    const int a = m_json.Find(node, key);
+                    float* f = &fallback.x;
+                    if (m_json.Count(a) == static_cast<std::size_t>(n))
+                    {
+                        int e = m_json.First(a);
+                        for (int i = 0; i < n; ++i, e = m_json.Next(e)) f[i] = static_cast<float>(m_json.NumberOr(e, f[i]));
+                    }
+                    return XMLoadFloat4(&fallback);
+                };
+            const XMVECTOR t = vec("translation", 3, { 0.0f, 0.0f, 0.0f, 0.0f });
+            const XMVECTOR r = vec("rotation", 4, { 0.0f, 0.0f, 0.0f, 1.0f });
+            const XMVECTOR s = vec("scale", 3, { 1.0f, 1.0f, 1.0f, 0.0f });
+            return XMMatrixScalingFromVector(s) * XMMatrixRotationQuaternion(XMQuaternionNormalize(r)) * XMMatrixTranslationFromVector(t);
+        }
+
+        bool AppendPrimitive(int primitive, const XMFLOAT4X4& worldF, MeshData& out)
+        {
+            const std::int64_t mode = m_json.IndexOr(m_json.Find(primitive, "mode"), 4);
+            if (mode != 4 && mode != 5 && mode != 6) return true; // 点/線は描かない
+
+            const int attributes = m_json.Find(primitive, "attributes");
+            const std::int64_t posIndex = m_json.IndexOr(m_json.Find(attributes, "POSITION"), -1);
+            if (posIndex < 0) return true; // 位置の無いプリミティブ（拡張専用など）は飛ばす
+            GltfAccessor pos, nrm, col, idx;
+            if (!Accessor(posIndex, pos)) return false;
+            if (pos.components != 3) return Fail("glTF: POSITION must be VEC3");
+            const std::int64_t nrmIndex = m_json.IndexOr(m_json.Find(attributes, "NORMAL"), -1);
+            const std::int64_t colIndex = m_json.IndexOr(m_json.Find(attributes, "COLOR_0"), -1);
+            const std::int64_t idxIndex = m_json.IndexOr(m_json.Find(primitive, "indices"), -1);
+            if (nrmIndex >= 0 && (!Accessor(nrmIndex, nrm) || nrm.components != 3 || nrm.count != pos.count)) return Fail("glTF: bad NORMAL");
+            if (colIndex >= 0 && (!Accessor(colIndex, col) || col.components < 3 || col.components > 4 || col.count != pos.count)) return Fail("glTF: bad COLOR_0");
+            if (idxIndex >= 0 && (!Accessor(idxIndex, idx) || idx.components != 1
+                || (idx.componentType != 5121 && idx.componentType != 5123 && idx.componentType != 5125)))
+                return Fail("glTF: bad indices");
+            m_stats.positions += pos.count;
+
+            const std::size_t cornerCount = idxIndex >= 0 ? idx.count : pos.count;
+            const std::size_t triangles = mode == 4 ? cornerCount / 3 : (cornerCount >= 3 ? cornerCount - 2 : 0);
+            if (triangles == 0) return true;
+
+            // 変換：ワールド行列 → （左手系へ）Z 反転。法線は逆転置。鏡映が 1 回なら巻き順を入れ替える
+            const XMMATRIX world = XMLoadFloat4x4(&worldF) * XMMatrixScaling(m_options.scale, m_options.scale, m_options.scale)
+                * XMMatrixScaling(1.0f, 1.0f, m_options.convertToLeftHanded ? -1.0f : 1.0f);
+            XMVECTOR det;
+            const XMMATRIX normalMatrix = XMMatrixTranspose(XMMatrixInverse(&det, world));
+            const bool flip = XMVectorGetX(det) < 0.0f;
+            const XMFLOAT4 defaultColor = m_options.defaultColor;
+
+            auto position = [&](std::size_t v)
+                {
+                    XMFLOAT3 p{ pos.Read(v, 0), pos.Read(v, 1), pos.Read(v, 2) };
+                    XMStoreFloat3(&p, XMVector3TransformCoord(XMLoadFloat3(&p), world));
+                    return p;
+                };
+            auto color = [&](std::size_t v)
+                {
+                    if (colIndex < 0) return defaultColor;
+                    return XMFLOAT4{ col.Read(v, 0), col.Read(v, 1), col.Read(v, 2), col.components == 4 ? col.Read(v, 3) : 1.0f };
+                };
+            // 三角形 t の 3 つの角（strip/fan は仕様の並び。巻き順の入れ替えもここで）
+            auto corners = [&](std::size_t t, std::uint32_t c[3])
+                {
+                    std::size_t k[3];
+                    if (mode == 4)      { k[0] = t * 3; k[1] = t * 3 + 1; k[2] = t * 3 + 2; }
+                    else if (mode == 5) { k[0] = t; k[1] = t + 1 + (t & 1); k[2] = t + 2 - (t & 1); }
+                    else                { k[0] = t + 1; k[1] = t + 2; k[2] = 0; }
+                    for (int i = 0; i < 3; ++i) c[i] = idxIndex >= 0 ? idx.Index(k[i]) : static_cast<std::uint32_t>(k[i]);
+                    if (flip) std::swap(c[1], c[2]);
+                    return c[0] < pos.count && c[1] < pos.count && c[2] < pos.count;
+                };
+
+            const std::size_t vertexBase = out.Vertices.size();
+            const std::size_t indexBase = out.Indices.size();
+            const std::size_t newVertices = nrmIndex >= 0 ? pos.count : triangles * 3;
+            if (vertexBase + newVertices >= kNone || indexBase + triangles * 3 >= kNone) return Fail("glTF: too many vertices");
+            out.Vertices.resize(vertexBase + newVertices);
+            out.Indices.resize(indexBase + triangles * 3);
+            Vertex* vertices = out.Vertices.data() + vertexBase;
+            std::uint32_t* indices = out.Indices.data() + indexBase;
+            ErrorSlot error;
+
+            if (nrmIndex >= 0)
+            {
+                // 頂点はそのまま変換、インデックスは三角形化して頂点の先頭をずらす
+                JobSystem::ParallelFor(pos.count, kVertexGrain, [&](std::size_t b, std::size_t e)
+                    {
+                        for (std::size_t v = b; v < e; ++v)
+                        {
+                            Vertex& o = vertices[v];
+                            o.Position = position(v);
+                            XMFLOAT3 n{ nrm.Read(v, 0), nrm.Read(v, 1), nrm.Read(v, 2) };
+                            XMStoreFloat3(&n, XMVector3TransformNormal(XMLoadFloat3(&n), normalMatrix));
+                            o.Normal = Normalized(n);
+                            o.Color = color(v);
+                        }
+                    });
+                JobSystem::ParallelFor(triangles, kVertexGrain, [&](std::size_t b, std::size_t e)
+                    {
+                        for (std::size_t t = b; t < e; ++t)
+                        {
+                            std::uint32_t c[3];
+                            if (!corners(t, c)) { error.Set("glTF: index out of range"); return; }
+                            for (int i = 0; i < 3; ++i) indices[t * 3 + i] = static_cast<std::uint32_t>(vertexBase + c[i]);
+                        }
+                    });
+            }
+            else
+            {
+                // 法線が無い：仕様どおりフラット法線（三角形ごとに頂点を分ける）
+                JobSystem::ParallelFor(triangles, kVertexGrain, [&](std::size_t b, std::size_t e)
+                    {
+                        for (std::size_t t = b; t < e; ++t)
+                        {
+                            std::uint32_t c[3];
+                            if (!corners(t, c)) { error.Set("glTF: index out of range"); return; }
+                            Vertex* o = vertices + t * 3;
+                            for (int i = 0; i < 3; ++i)
+                            {
+                                o[i].Position = position(c[i]);
+                                o[i].Color = color(c[i]);
+                                indices[t * 3 + i] = static_cast<std::uint32_t>(vertexBase + t * 3 + i);
+                            }
+                            const XMFLOAT3 n = Normalized(FaceNormal(o[0].Position, o[1].Position, o[2].Position));
+                            o[0].Normal = o[1].Normal = o[2].Normal = n;
+                        }
+                    });
+                m_stats.generatedNormals = true;
+            }
+            if (error.Get()) return Fail(error.Get());
+            return true;
+        }
+
+        const MeshImportOptions&                 m_options;
+        MeshImportStats&                         m_stats;
+        const std::wstring*                      m_baseDir = nullptr; // 外部バッファの基準（末尾に区切り付き。nullptr = 読めない）
+        JsonDocument                             m_json;
+        std::vector<GltfBuffer>                  m_buffers;
+        std::vector<GltfView>                    m_views;
+        std::vector<Instance>                    m_instances;
+        std::vector<std::vector<std::uint8_t>>   m_owned; // data: URI を復号したもの
+        std::vector<std::unique_ptr<MappedFile>> m_files; // 外部バッファ
+    };
+
+    bool Import(const void* data, std::size_t size, MeshFileFormat format, MeshData& out,
+        const MeshImportOptions& options, MeshImportStats* stats, const std::wstring* baseDir)
+    {
+        MeshImportStats local;
+        MeshImportStats& s = stats ? *stats : local;
+        s = MeshImportStats();
+        if (format == MeshFileFormat::Unknown) format = DetectMeshFileFormat(data, size);
+        s.format = format;
+        s.bytes = size;
+        out.Vertices.clear();
+        out.Indices.clear();
+
+        const auto t0 = std::chrono::steady_clock::now();
+        bool ok = false;
+        if (!data || size == 0) SetError(s, "empty file");
+        else if (size >= kNone) SetError(s, "file too large");
+        else
+        {
+            switch (format)
+            {
+            case MeshFileFormat::Obj:
+                ok = ImportObj(static_cast<const char*>(data), size, out, options, s);
+                break;
+            case MeshFileFormat::Gltf:
+            case MeshFileFormat::Glb:
+            {
+                GltfLoader loader(options, s, baseDir);
+                ok = loader.Load(static_cast<const std::uint8_t*>(data), size, format == MeshFileFormat::Glb, out);
+                break;
+            }
+            default:
+                SetError(s, "unknown format");
+                break;
+            }
+        }
+        if (!ok)
+        {
+            out.Vertices.clear();
+            out.Indices.clear();
+        }
+        s.vertices = out.Vertices.size();
+        s.triangles = out.Indices.size() / 3;
+        s.milliseconds = Milliseconds(t0);
+        return ok;
+    }
+}
+
+MeshFileFormat DetectMeshFileFormat(const wchar_t* path)
+{
+    if (!path) return MeshFileFormat::Unknown;
+    const wchar_t* dot = std::wcsrchr(path, L'.');
+    if (!dot) return MeshFileFormat::Unknown;
+    auto is = [dot](const wchar_t* ext)
+        {
+            const wchar_t* a = dot + 1;
+            for (; *a && *ext; ++a, ++ext)
+                if (static_cast<wchar_t>(std::towlower(*a)) != *ext) return false;
+            return *a == 0 && *ext == 0;
+        };
+    if (is(L"obj")) return MeshFileFormat::Obj;
+    if (is(L"gltf")) return MeshFileFormat::Gltf;
+    if (is(L"glb")) return MeshFileFormat::Glb;
+    return MeshFileFormat::Unknown;
+}
+
+MeshFileFormat DetectMeshFileFormat(const void* data, std::size_t size)
+{
+    const std::uint8_t* p = static_cast<const std::uint8_t*>(data);
+    if (!p || size == 0) return MeshFileFormat::Unknown;
+    if (size >= 4 && ReadU32(p) == kGlbMagic) return MeshFileFormat::Glb;
+    std::size_t i = (size >= 3 && p[0] == 0xEF && p[1] == 0xBB && p[2] == 0xBF) ? 3 : 0; // UTF-8 BOM
+    while (i < size && (p[i] == ' ' || p[i] == '\t' || p[i] == '\r' || p[i] == '\n')) ++i;
+    return i < size && p[i] == '{' ? MeshFileFormat::Gltf : MeshFileFormat::Obj;
+}
+
+bool ImportMesh(const wchar_t* path, MeshData& out, const MeshImportOptions& options, MeshImportStats* stats)
+{
+    MappedFile file;
+    if (!file.Open(path))
+    {
+        out.Vertices.clear();
+        out.Indices.clear();
+        if (stats)
+        {
+            *stats = MeshImportStats();
+            stats->error = "cannot open file";
+        }
+        return false;
+    }
+
+    // 外部バッファはファイルと同じフォルダから読む
+    const wchar_t* slash = std::wcsrchr(path, L'\\');
+    const wchar_t* forward = std::wcsrchr(path, L'/');
+    if (!slash || (forward && forward > slash)) slash = forward;
+    const std::wstring baseDir = slash ? std::wstring(path, slash + 1) : std::wstring();
+    return Import(file.Data(), file.Size(), DetectMeshFileFormat(path), out, options, stats, &baseDir);
+}
+
+bool ImportMeshFromMemory(const void* data, std::size_t size, MeshFileFormat format, MeshData& out,
+    const MeshImportOptions& options, MeshImportStats* stats)
+{
+    return Import(data, size, format, out, options, stats, nullptr);
+}
@@ -0,0 +1,93 @@
+﻿#pragma once
+#include <DirectXMath.h>
+#include <cstddef>
+#include <cstdint>
+#include "Assets/Mesh.h"
+
+/*
+===============================================================================
+ MeshImporter（OBJ / glTF 2.0 を MeshData に読み込む）
+-------------------------------------------------------------------------------
+目的:
+  - 手組みの立方体以外のメッシュを、一般的な交換形式から直接 MeshData にする。
+  - 大きなファイルを速く読む：ファイルはメモリマップ（MappedFile）して 1 回なめるだけ、
+    字句解析はバッファ上のポインタを進めるだけで文字列を作らない（トークンは元の位置を指す）。
+    三角形化・法線の生成・頂点の変換はチャンクに分けて JobSystem で並列に行い、
+    MeshData の配列へ直接書く（中間のメッシュ表現を持たない）。
+
+OBJ:
+  - 読むのは v（"v x y z [r g b]" の頂点カラー拡張も）/ vn / f。vt・g・o・usemtl・s などは読み飛ばす
+    （Vertex に UV が無いため。マテリアルは分けず 1 つの MeshData にまとめる）。
+  - ファイルを行の境目でチャンクに分け、1 回目で各チャンクの v/vn/三角形の数を数え、
+    累積和で書き込み先を決めてから 2 回目で並列に書く（負のインデックスもチャンクの先頭数から解決できる）。
+  - 多角形は扇形に三角形化する（凸多角形前提。凹多角形は形が崩れうる）。
+  - 頂点 = (v, vn) の組。位置ごとに最初に使われた法線の組は位置番号のまま使い、
+    別の法線で使われた組だけを後ろに足す（滑らかなメッシュはほぼ全部が前者になる）。
+  - vn の無い角は、同じ位置を使う面の法線（面積で重み付け）を足して滑らかな法線を作る。
+
+glTF 2.0（.gltf / .glb）:
+  - バッファは GLB の BIN チャンク、data: URI（base64）、相対パスの外部ファイル（ImportMesh のみ）。
+  - 既定のシーン（scene。無ければ 0 番。シーンが無ければ全メッシュを単位行列で）のノードを辿り、
+    ノードのワールド行列を焼き込んで、全プリミティブを 1 つの MeshData にまとめる。
+  - 読む属性は POSITION / NORMAL / COLOR_0 とインデックス。mode は TRIANGLES / STRIP / FAN
+    （点・線のプリミティブは飛ばす）。疎（sparse）アクセサは未対応（失敗にする）。
+  - NORMAL が無いプリミティブは仕様どおりフラット法線にする（三角形ごとに頂点を分ける）。
+
+座標系（convertToLeftHanded。既定 true）:
+  - OBJ / glTF は右手系・反時計回り（CCW）が表。このエンジンは左手系・時計回り（CW）が表なので、
+    Z を反転し、三角形の 2 番目と 3 番目を入れ替える（見た目の向きと表裏が元と同じになる）。
+
+前提と制限:
+  - 頂点数・インデックス値は 32bit に収まること。範囲外のインデックスを含むファイルは読まない。
+  - 失敗したら out は空にして false を返す（理由は MeshImportStats::error）。
+===============================================================================
+*/
+
+enum class MeshFileFormat : std::uint8_t
+{
+    Unknown,
+    Obj,
+    Gltf, // JSON（.gltf）
+    Glb,  // バイナリ（.glb）
+};
+
+// 読み込みの設定
+struct MeshImportOptions
+{
+    bool              convertToLeftHanded = true;             // Z 反転 + 巻き順の反転（右手系 CCW → 左手系 CW）
+    float             scale = 1.0f;                           // 位置に掛ける倍率（単位の変換用）
+    DirectX::XMFLOAT4 defaultColor{ 1.0f, 1.0f, 1.0f, 1.0f }; // 頂点カラーが無いときの色
+};
+
+// 読み込みの結果（ベンチマーク/エディタ表示用）
+struct MeshImportStats
+{
+    MeshFileFormat format = MeshFileFormat::Unknown;
+    std::size_t    bytes = 0;        // 読んだファイル（メモリ）のバイト数（glTF の外部バッファは含まない）
+    std::size_t    positions = 0;    // ファイル上の位置の数（OBJ の v / glTF の POSITION の合計）
+    std::size_t    vertices = 0;     // 出力した頂点数
+    std::size_t    triangles = 0;    // 出力した三角形数
+    bool           generatedNormals = false; // 法線の無い頂点があり、面から作った
+    double         milliseconds = 0.0;       // 解析から MeshData 完成まで（ファイルのマップは含まない）
+    const char*    error = nullptr;          // 失敗の理由（成功なら nullptr。静的な文字列）
+};
+
+/// 拡張子（.obj / .gltf / .glb。大文字小文字は区別しない）から形式を決める
+MeshFileFormat DetectMeshFileFormat(const wchar_t* path);
+
+/// 中身から形式を決める（GLB のマジック / '{' で始まる JSON / それ以外は OBJ とみなす）
+MeshFileFormat DetectMeshFileFormat(const void* data, std::size_t size);
+
+/**
+ * @brief ファイルをメモリマップして読み込む（形式は拡張子、分からなければ中身で決める）
+ * @return 成功したら true（out は上書き。失敗したら空）
+ */
+bool ImportMesh(const wchar_t* path, MeshData& out,
+    const MeshImportOptions& options = MeshImportOptions(), MeshImportStats* stats = nullptr);
+
+/**
+ * @brief メモリ上のファイル内容を読み込む（glTF の外部ファイルのバッファは読めない）
+ * @param format Unknown なら中身で決める
+ */
+bool ImportMeshFromMemory(const void* data, std::size_t size, MeshFileFormat format, MeshData& out,
+    const MeshImportOptions& options = MeshImportOptions(), MeshImportStats* stats = nullptr);
@@ -0,0 +1,467 @@
+﻿#include "Assets/MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+using namespace DirectX;
+
+/*
+    MeshOptimizer.cpp
+    ----------------------------------------------------------------------------
+    FIFO の模擬（AnalyzeVertexCache / OptimizeOverdraw）：
+      - 頂点ごとに「キャッシュに入った時刻」を持ち、時刻はミスのたびに 1 進める。
+        FIFO はミスでしか入れ替わらないので、now - stamp[v] < cacheSize なら v はまだ入っている。
+      - リセットは now を cacheSize 進めるだけ（全頂点が追い出されたことになる）。
+    WeldVertices：
+      - 頂点 40B を 32bit ×10 として混ぜたハッシュで開番地法の表（容量は 2 のべき、頂点数の 2 倍以上）を引く。
+        比較は -0.0f を +0.0f に直したバイト列の memcmp（NaN も同じビットなら同じ頂点）。
+    OptimizeVertexCache（Forsyth, "Linear-Speed Vertex Cache Optimisation"）：
+      - 頂点スコア = キャッシュ位置の項（直前の三角形の 3 頂点は 0.75、以降は (1 - 位置/サイズ)^1.5）
+                   + 残り三角形数の項（2 / sqrt(残り)。残りの少ない頂点を早く片付ける）
+      - 三角形スコア = 3 頂点のスコアの和。毎回、キャッシュ内の頂点に接する三角形から最良のものを出す。
+        候補が無ければ未出力の三角形を先頭から探す（カーソルは戻らないので全体で線形）。
+    OptimizeOverdraw（Sander, Nehab, Barczak 2007, "Fast Triangle Reordering for Vertex Locality
+                      and Reduced Overdraw"）：
+      - 硬い区切り：3 頂点ともミスする三角形（キャッシュの連続が切れている位置）。
+      - 柔らかい区切り：硬い区間の中で、先頭からの ACMR が区間全体の ACMR × threshold 以下に
+        なった位置（そこで切ってもキャッシュ効率はほとんど落ちない）。
+      - クラスタのキー = dot(クラスタ重心 - メッシュ重心, クラスタ法線)。大きい（外側を向いて
+        外周にある）クラスタから描く。面法線の向きは頂点法線の和に合わせる（巻き順の規約に依らない）。
+*/
+
+namespace
+{
+    constexpr std::uint32_t kUnused = 0xFFFFFFFFu;
+
+    bool ValidTriangleList(const std::uint32_t* indices, std::size_t indexCount, std::size_t vertexCount)
+    {
+        if (!indices || indexCount == 0 || indexCount % 3 != 0) return false;
+        for (std::size_t i = 0; i < indexCount; ++i)
+            if (indices[i] >= vertexCount) return false;
+        return true;
+    }
+
+    // ---- FIFO キャッシュの模擬 ---------------------------------------------------
+
+    struct FifoCache
+    {
+        std::vector<std::uint32_t> stamp;
+        std::uint32_t size = 16;
+        std::uint32_t now = 0;
+
+        FifoCache(std::size_t vertexCount, std::uint32_t cacheSize)
+            : stamp(vertexCount, 0), size(cacheSize), now(cacheSize + 1) {}
+
+        // ミスなら 1
+        std::uint32_t Touch(std::uint32_t v)
+        {
+            if (now - stamp[v] > size) { stamp[v] = now++; return 1; }
+            return 0;
+        }
+        std::uint32_t Triangle(const std::uint32_t* tri) { return Touch(tri[0]) + Touch(tri[1]) + Touch(tri[2]); }
+        void Reset() { now += size + 1; }
+    };
+
+    // ---- 溶接用のハッシュ ---------------------------------------------------------
+
+    constexpr std::size_t kVertexWords = sizeof(Vertex) / sizeof(std::uint32_t);
+    static_assert(sizeof(Vertex) % sizeof(std::uint32_t) == 0, "Vertex は 4B 単位");
+
+    void CanonicalWords(const Vertex& v, std::uint32_t (&w)[kVertexWords])
+    {
+        std::memcpy(w, &v, sizeof(Vertex));
+        for (std::uint32_t& x : w)
+            if (x == 0x80000000u) x = 0; // -0.0f → +0.0f
+    }
+
+    std::uint32_t HashWords(const std::uint32_t (&w)[kVertexWords])
+    {
+        std::uint32_t h = 2166136261u;
+        for (std::uint32_t x : w)
+        {
+            x *= 0xCC9E2D51u;
+            x = (x << 15) | (x >> 17);
+            h ^= x * 0x1B873593u;
+            h = ((h << 13) | (h >> 19)) * 5u + 0xE6546B64u;
+        }
+        h ^= h >> 16; h *= 0x85EBCA6Bu;
+        h ^= h >> 13; h *= 0xC2B2AE35u;
+        return h ^ (h >> 16);
+    }
+
+    // ---- Forsyth のスコア -----------------------------------------------------------
+
+    constexpr int   kScoreCacheSize = 32;
+    constexpr float kLastTriangleScore = 0.75f;
+    constexpr float kCacheDecayPower = 1.5f;
+    constexpr float kValenceBoostScale = 2.0f;
+    constexpr float kValenceBoostPower = 0.5f;
+    constexpr std::uint32_t kValenceTable = 32;
+
+    struct ForsythTables
+    {
+        float cache[kScoreCacheSize];
+        float valence[kValenceTable];
+
+        ForsythTables()
+        {
+            for (int i = 0; i < kScoreCacheSize; ++i)
+            {
+                if (i < 3) cache[i] = kLastTriangleScore;
+                else
+                {
+                    const float scaler = 1.0f / (kScoreCacheSize - 3);
+                    cache[i] = std::pow(1.0f - (i - 3) * scaler, kCacheDecayPower);
+                }
+            }
+            valence[0] = 0.0f;
+            for (std::uint32_t i = 1; i < kValenceTable; ++i)
+                valence[i] = kValenceBoostScale * std::pow(static_cast<float>(i), -kValenceBoostPower);
+        }
+
+        float Score(int cachePos, std::uint32_t remaining) const
+        {
+            if (remaining == 0) return -1.0f; // もう使われない
+            float s = (cachePos >= 0 && cachePos < kScoreCacheSize) ? cache[cachePos] : 0.0f;
+            s += remaining < kValenceTable ? valence[remaining]
+                : kValenceBoostScale * std::pow(static_cast<float>(remaining), -kValenceBoostPower);
+            return s;
+        }
+    };
+
+    XMFLOAT3 Sub(const XMFLOAT3& a, const XMFLOAT3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+    float    Dot(const XMFLOAT3& a, const XMFLOAT3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    XMFLOAT3 Cross(const XMFLOAT3& a, const XMFLOAT3& b)
+    {
+        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+    }
+}
+
+// ============================================================================
+// 指標
+// ============================================================================
+
+VertexCacheStats AnalyzeVertexCache(const std::uint32_t* indices, std::size_t indexCount,
+    std::size_t vertexCount, std::uint32_t cacheSize)
+{
+    VertexCacheStats s;
+    if (!ValidTriangleList(indices, indexCount, vertexCount)) return s;
+
+    FifoCache cache(vertexCount, cacheSize ? cacheSize : 16);
+    std::vector<bool> used(vertexCount, false);
+    for (std::size_t i = 0; i < indexCount; i += 3)
+    {
+        s.misses += cache.Triangle(indices + i);
+        for (int k = 0; k < 3; ++k)
+        {
+            if (!used[indices[i + k]]) { used[indices[i + k]] = true; ++s.vertices; }
+        }
+    }
+    s.triangles = indexCount / 3;
+    s.acmr = static_cast<float>(s.misses) / static_cast<float>(s.triangles);
+    s.atvr = s.vertices ? static_cast<float>(s.misses) / static_cast<float>(s.vertices) : 0.0f;
+    return s;
+}
+
+// ============================================================================
+// 1) 溶接
+// ============================================================================
+
+std::size_t WeldVertices(MeshData& mesh)
+{
+    const std::size_t n = mesh.Vertices.size();
+    if (n == 0) return 0;
+
+    std::size_t capacity = 16;
+    while (capacity < n * 2) capacity *= 2;
+    std::vector<std::uint32_t> table(capacity, kUnused); // 溶接後の頂点番号
+    std::vector<std::uint32_t> remap(n);
+    std::vector<Vertex> unique;
+    unique.reserve(n);
+
+    std::uint32_t key[kVertexWords], other[kVertexWords];
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        CanonicalWords(mesh.Vertices[i], key);
+        std::size_t slot = HashWords(key) & (capacity - 1);
+        for (;;)
+        {
+            const std::uint32_t u = table[slot];
+            if (u == kUnused)
+            {
+                table[slot] = static_cast<std::uint32_t>(unique.size());
+                remap[i] = table[slot];
+                unique.push_back(mesh.Vertices[i]);
+                break;
+            }
+            CanonicalWords(unique[u], other);
+            if (std::memcmp(key, other, sizeof(key)) == 0) { remap[i] = u; break; }
+            slot = (slot + 1) & (capacity - 1);
+        }
+    }
+
+    const std::size_t removed = n - unique.size();
+    if (removed == 0) return 0;
+    for (unsigned int& idx : mesh.Indices)
+        if (idx < n) idx = remap[idx];
+    mesh.Vertices.swap(unique);
+    return removed;
+}
+
+// ============================================================================
+// 2) 頂点キャッシュ
+// ============================================================================
+
+void OptimizeVertexCache(std::uint32_t* indices, std::size_t indexCount, std::size_t vertexCount)
+{
+    if (!ValidTriangleList(indices, indexCount, vertexCount)) return;
+    static const ForsythTables tables;
+
+    const std::size_t triCount = indexCount / 3;
+
+    // 頂点 → 未出力の三角形（[offset[v], offset[v] + remaining[v]) が生きている）
+    std::vector<std::uint32_t> remaining(vertexCount, 0), offset(vertexCount + 1, 0);
+    for (std::size_t i = 0; i < indexCount; ++i) ++remaining[indices[i]];
+    for (std::size_t v = 0; v < vertexCount; ++v) offset[v + 1] = offset[v] + remaining[v];
+    std::vector<std::uint32_t> adjacency(indexCount), fill(offset.begin(), offset.end() - 1);
+    for (std::size_t i = 0; i < indexCount; ++i) adjacency[fill[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+
+    std::vector<int>   cachePos(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (std::size_t v = 0; v < vertexCount; ++v) vertexScore[v] = tables.Score(-1, remaining[v]);
+
+    std::vector<float> triScore(triCount);
+    std::vector<bool>  emitted(triCount, false);
+    std::uint32_t bestTri = 0;
+    for (std::size_t t = 0; t < triCount; ++t)
+    {
+        const std::uint32_t* tri = indices + t * 3;
+        triScore[t] = vertexScore[tri[0]] + vertexScore[tri[1]] + vertexScore[tri[2]];
+        if (triScore[t] > triScore[bestTri]) bestTri = static_cast<std::uint32_t>(t);
+    }
+
+    std::vector<std::uint32_t> output(indexCount);
+    std::uint32_t cache[kScoreCacheSize + 3], nextCache[kScoreCacheSize + 3];
+    int cacheCount = 0;
+    std::size_t cursor = 0; // 候補が無いときに未出力の三角形を探す位置
+
+    for (std::size_t out = 0; out < triCount; ++out)
+    {
+        if (bestTri == kUnused)
+        {
+            while (emitted[cursor]) ++cursor;
+            bestTri = static_cast<std::uint32_t>(cursor);
+        }
+
+        const std::uint32_t* tri = indices + bestTri * 3;
+        std::memcpy(&output[out * 3], tri, 3 * sizeof(std::uint32_t));
+        emitted[bestTri] = true;
+
+        // 出した三角形を各頂点の生きている表から外す（表の末尾と入れ替える）
+        for (int k = 0; k < 3; ++k)
+        {
+            const std::uint32_t v = tri[k];
+            std::uint32_t* list = adjacency.data() + offset[v];
+            for (std::uint32_t j = 0; j < remaining[v]; ++j)
+            {
+                if (list[j] == bestTri) { list[j] = list[remaining[v] - 1]; break; }
+            }
+            --remaining[v];
+        }
+
+        // LRU：出した 3 頂点を先頭に置き、残りを後ろへ（溢れた分は追い出す）
+        int nextCount = 0;
+        for (int k = 0; k < 3; ++k) nextCache[nextCount++] = tri[k];
+        for (int j = 0; j < cacheCount; ++j)
+        {
+            const std::uint32_t v = cache[j];
+            if (v != tri[0] && v != tri[1] && v != tri[2]) nextCache[nextCount++] = v;
+        }
+
+        // キャッシュ位置とスコアを更新（追い出された頂点は位置 -1）
+        for (int j = 0; j < nextCount; ++j)
+        {
+            const std::uint32_t v = nextCache[j];
+            cachePos[v] = j < kScoreCacheSize ? j : -1;
+            vertexScore[v] = tables.Score(cachePos[v], remaining[v]);
+        }
+
+        // スコアが変わった頂点の三角形を採点し直し、次の最良を決める
+        bestTri = kUnused;
+        float bestScore = -1.0f;
+        for (int j = 0; j < nextCount; ++j)
+        {
+            const std::uint32_t v = nextCache[j];
+            const std::uint32_t* list = adjacency.data() + offset[v];
+            for (std::uint32_t a = 0; a < remaining[v]; ++a)
+            {
+                const std::uint32_t t = list[a];
+                const std::uint32_t* tv = indices + t * 3;
+                triScore[t] = vertexScore[tv[0]] + vertexScore[tv[1]] + vertexScore[tv[2]];
+                if (triScore[t] > bestScore) { bestScore = triScore[t]; bestTri = t; }
+            }
+        }
+
+        cacheCount = std::min(nextCount, kScoreCacheSize);
+        std::memcpy(cache, nextCache, cacheCount * sizeof(std::uint32_t));
+    }
+
+    std::memcpy(indices, output.data(), indexCount * sizeof(std::uint32_t));
+}
+
+// ============================================================================
+// 3) オーバードロー
+// ============================================================================
+
+std::size_t OptimizeOverdraw(std::uint32_t* indices, std::size_t indexCount,
+    const Vertex* vertices, std::size_t vertexCount, float threshold)
+{
+    if (!vertices || !ValidTriangleList(indices, indexCount, vertexCount)) return 0;
+    const std::size_t triCount = indexCount / 3;
+    threshold = std::max(threshold, 1.0f);
+
+    // 硬い区切り：3 頂点ともミスする三角形から新しい区間
+    FifoCache cache(vertexCount, 16);
+    std::vector<std::uint32_t> hard;
+    for (std::size_t t = 0; t < triCount; ++t)
+        if (cache.Triangle(indices + t * 3) == 3 || t == 0) hard.push_back(static_cast<std::uint32_t>(t));
+    hard.push_back(static_cast<std::uint32_t>(triCount));
+
+    // 柔らかい区切り：区間の ACMR × threshold 以下まで下がったら切る
+    std::vector<std::uint32_t> clusters; // 各クラスタの先頭三角形（末尾に triCount）
+    for (std::size_t h = 0; h + 1 < hard.size(); ++h)
+    {
+        const std::uint32_t first = hard[h], last = hard[h + 1];
+        cache.Reset();
+        std::size_t misses = 0;
+        for (std::uint32_t t = first; t < last; ++t) misses += cache.Triangle(indices + t * 3);
+        const float limit = static_cast<float>(misses) / static_cast<float>(last - first) * threshold;
+
+        cache.Reset();
+        clusters.push_back(first);
+        std::uint32_t start = first;
+        std::size_t m = 0;
+        for (std::uint32_t t = first; t < last; ++t)
+        {
+            m += cache.Triangle(indices + t * 3);
+            if (t + 1 < last && static_cast<float>(m) <= limit * static_cast<float>(t - start + 1))
+            {
+                clusters.push_back(t + 1);
+                start = t + 1;
+                m = 0;
+                cache.Reset();
+            }
+        }
+    }
+    const std::size_t clusterCount = clusters.size();
+    clusters.push_back(static_cast<std::uint32_t>(triCount));
+
+    // クラスタごとの重心と法線（面積重み）、メッシュ全体の重心
+    std::vector<XMFLOAT3> centroid(clusterCount), normal(clusterCount);
+    XMFLOAT3 meshCentroid{ 0.0f, 0.0f, 0.0f };
+    float meshArea = 0.0f;
+    for (std::size_t c = 0; c < clusterCount; ++c)
+    {
+        XMFLOAT3 sumC{ 0.0f, 0.0f, 0.0f }, sumN{ 0.0f, 0.0f, 0.0f };
+        float area = 0.0f;
+        for (std::uint32_t t = clusters[c]; t < clusters[c + 1]; ++t)
+        {
+            const Vertex& a = vertices[indices[t * 3 + 0]];
+            const Vertex& b = vertices[indices[t * 3 + 1]];
+            const Vertex& d = vertices[indices[t * 3 + 2]];
+            XMFLOAT3 n = Cross(Sub(b.Position, a.Position), Sub(d.Position, a.Position)); // |n| = 面積 × 2
+            const XMFLOAT3 vn{ a.Normal.x + b.Normal.x + d.Normal.x,
+                               a.Normal.y + b.Normal.y + d.Normal.y,
+                               a.Normal.z + b.Normal.z + d.Normal.z };
+            if (Dot(n, vn) < 0.0f) n = { -n.x, -n.y, -n.z };
+            const float w = std::sqrt(Dot(n, n)) * 0.5f;
+            sumC.x += (a.Position.x + b.Position.x + d.Position.x) * (w / 3.0f);
+            sumC.y += (a.Position.y + b.Position.y + d.Position.y) * (w / 3.0f);
+            sumC.z += (a.Position.z + b.Position.z + d.Position.z) * (w / 3.0f);
+            sumN.x += n.x; sumN.y += n.y; sumN.z += n.z;
+            area += w;
+        }
+        if (area > 0.0f)
+            centroid[c] = { sumC.x / area, sumC.y / area, sumC.z / area };
+        else
+        {
+            const Vertex& a = vertices[indices[clusters[c] * 3]];
+            centroid[c] = a.Position;
+        }
+        normal[c] = sumN;
+        meshCentroid.x += sumC.x; meshCentroid.y += sumC.y; meshCentroid.z += sumC.z;
+        meshArea += area;
+    }
+    if (meshArea > 0.0f)
+        meshCentroid = { meshCentroid.x / meshArea, meshCentroid.y / meshArea, meshCentroid.z / meshArea };
+
+    std::vector<float> key(clusterCount);
+    for (std::size_t c = 0; c < clusterCount; ++c)
+    {
+        const float len = std::sqrt(Dot(normal[c], normal[c]));
+        key[c] = len > 0.0f ? Dot(Sub(centroid[c], meshCentroid), normal[c]) / len : 0.0f;
+    }
+
+    std::vector<std::uint32_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&key](std::uint32_t a, std::uint32_t b) { return key[a] > key[b]; });
+
+    std::vector<std::uint32_t> output;
+    output.reserve(indexCount);
+    for (std::uint32_t c : order)
+        output.insert(output.end(), indices + clusters[c] * 3, indices + clusters[c + 1] * 3);
+    std::memcpy(indices, output.data(), indexCount * sizeof(std::uint32_t));
+    return clusterCount;
+}
+
+// ============================================================================
+// 4) 頂点フェッチ
+// ============================================================================
+
+std::size_t OptimizeVertexFetch(MeshData& mesh)
+{
+    const std::size_t n = mesh.Vertices.size();
+    std::vector<std::uint32_t> remap(n, kUnused);
+    std::vector<Vertex> ordered;
+    ordered.reserve(n);
+    for (unsigned int& idx : mesh.Indices)
+    {
+        if (idx >= n) continue;
+        std::uint32_t& r = remap[idx];
+        if (r == kUnused)
+        {
+            r = static_cast<std::uint32_t>(ordered.size());
+            ordered.push_back(mesh.Vertices[idx]);
+        }
+        idx = r;
+    }
+    mesh.Vertices.swap(ordered);
+    return mesh.Vertices.size();
+}
+
+// ============================================================================
+// まとめ
+// ============================================================================
+
+MeshOptimizeStats OptimizeMesh(MeshData& mesh, const MeshOptimizeSettings& settings)
+{
+    MeshOptimizeStats s;
+    s.verticesBefore = s.verticesAfter = mesh.Vertices.size();
+    if (!ValidTriangleList(mesh.Indices.data(), mesh.Indices.size(), mesh.Vertices.size())) return s;
+
+    s.before = AnalyzeVertexCache(mesh.Indices.data(), mesh.Indices.size(), mesh.Vertices.size(), settings.analyzeCacheSize);
+
+    if (settings.weld) WeldVertices(mesh);
+    if (settings.vertexCache) OptimizeVertexCache(mesh.Indices.data(), mesh.Indices.size(), mesh.Vertices.size());
+    if (settings.overdraw)
+        s.clusters = OptimizeOverdraw(mesh.Indices.data(), mesh.Indices.size(),
+            mesh.Vertices.data(), mesh.Vertices.size(), settings.overdrawThreshold);
+    if (settings.vertexFetch) OptimizeVertexFetch(mesh);
+
+    s.verticesAfter = mesh.Vertices.size();
+    s.after = AnalyzeVertexCache(mesh.Indices.data(), mesh.Indices.size(), mesh.Vertices.size(), settings.analyzeCacheSize);
+    s.optimized = true;
+    return s;
+}
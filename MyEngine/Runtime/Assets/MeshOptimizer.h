@@ -0,0 +1,93 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "Assets/Mesh.h"
+
+/*
+===============================================================================
+ MeshOptimizer（メッシュの並べ替えによる GPU 向け最適化）
+-------------------------------------------------------------------------------
+目的:
+  - コードやインポータから来た MeshData は作られた順のまま。描画結果を変えずに
+    頂点/インデックスを並べ替え、GPU の頂点処理・ピクセル処理・頂点フェッチを減らす。
+  - GPU には依存しない純 CPU コード（MeshRendererComponent::SetMesh やインポート時に呼ぶ）。
+
+段階（OptimizeMesh の順）:
+  1) WeldVertices        …… 全属性がビット単位で同じ頂点を 1 つにまとめる（ハッシュ表。+0/-0 は同一視）
+  2) OptimizeVertexCache …… 頂点キャッシュ（post-transform cache）に当たりやすい三角形順
+                             （Forsyth の線形時間アルゴリズム。LRU 32 を仮定したスコア）
+  3) OptimizeOverdraw    …… 2) の順をキャッシュ効率がほとんど落ちない区切りでクラスタに分け、
+                             メッシュの外側を向いたクラスタから先に描く順へ並べ直す
+                             （Sander et al. 2007。手前の面が先に Z を埋めて Early-Z で捨てられる）
+  4) OptimizeVertexFetch …… 頂点をインデックスで最初に使われる順に並べ直す（VB の読み出しが前へ進む）。
+                             参照されない頂点はここで消える
+
+指標（AnalyzeVertexCache。FIFO キャッシュを模擬）:
+  - ACMR = キャッシュミス数 / 三角形数（0.5 が理想の下限、3.0 が最悪）
+  - ATVR = キャッシュミス数 / 参照される頂点数（1.0 が理想）
+
+前提:
+  - Indices は三角形リスト（3 の倍数）で、どの値も Vertices.size() 未満であること。
+    満たさないメッシュは何もしない（MeshOptimizeStats::optimized = false）。
+  - 三角形の巻き順は変えない（三角形単位で並べ替えるだけ）。
+===============================================================================
+*/
+
+// FIFO キャッシュの模擬結果
+struct VertexCacheStats
+{
+    std::size_t misses = 0;    // 頂点シェーダの実行回数（キャッシュミス）
+    std::size_t triangles = 0;
+    std::size_t vertices = 0;  // 参照される頂点の数
+    float       acmr = 0.0f;   // misses / triangles
+    float       atvr = 0.0f;   // misses / vertices
+};
+
+// OptimizeMesh の段階の有効/無効とパラメータ
+struct MeshOptimizeSettings
+{
+    bool  weld = true;
+    bool  vertexCache = true;
+    bool  overdraw = true;
+    bool  vertexFetch = true;
+    float overdrawThreshold = 1.05f; // クラスタ分割で許す ACMR の悪化（1.05 = 5%）
+    std::uint32_t analyzeCacheSize = 16; // 指標の計算に使う FIFO の大きさ
+};
+
+// OptimizeMesh の結果
+struct MeshOptimizeStats
+{
+    bool             optimized = false;  // 前提を満たして最適化を行ったか
+    std::size_t      verticesBefore = 0;
+    std::size_t      verticesAfter = 0;
+    std::size_t      clusters = 0;       // OptimizeOverdraw で並べ替えたクラスタ数
+    VertexCacheStats before;
+    VertexCacheStats after;
+};
+
+/**
+ * @brief FIFO の頂点キャッシュを模擬して ACMR/ATVR を求める
+ * @param cacheSize キャッシュの頂点数（0 なら 16）
+ */
+VertexCacheStats AnalyzeVertexCache(const std::uint32_t* indices, std::size_t indexCount,
+    std::size_t vertexCount, std::uint32_t cacheSize = 16);
+
+/// 同じ頂点をまとめてインデックスを付け替える。減った頂点数を返す（順序は最初の出現順）
+std::size_t WeldVertices(MeshData& mesh);
+
+/// 三角形の順を頂点キャッシュ向けに並べ替える（indices を上書き）
+void OptimizeVertexCache(std::uint32_t* indices, std::size_t indexCount, std::size_t vertexCount);
+
+/**
+ * @brief キャッシュ最適化済みの三角形順をクラスタ単位で外向きのものから並べ直す
+ * @param threshold クラスタ分割で許す ACMR の悪化率（1.0 以上）
+ * @return クラスタ数
+ */
+std::size_t OptimizeOverdraw(std::uint32_t* indices, std::size_t indexCount,
+    const Vertex* vertices, std::size_t vertexCount, float threshold = 1.05f);
+
+/// 頂点を最初に使われる順へ並べ直し、参照されない頂点を捨てる。残った頂点数を返す
+std::size_t OptimizeVertexFetch(MeshData& mesh);
+
+/// 1)～4) を settings に従って順に行い、前後の指標を返す
+MeshOptimizeStats OptimizeMesh(MeshData& mesh, const MeshOptimizeSettings& settings = MeshOptimizeSettings());
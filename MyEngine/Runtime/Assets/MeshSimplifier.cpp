@@ -0,0 +1,438 @@
+﻿#include "Assets/MeshSimplifier.h"
+#include "Assets/MeshOptimizer.h"
+#include "Core/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <tuple>
+
+using namespace DirectX;
+
+/*
+    MeshSimplifier.cpp
+    ----------------------------------------------------------------------------
+    位置の同一視：
+      - 頂点を位置（-0.0f は +0.0f に直したビット列）で並べ、同じ位置の組の最小番号を root にする。
+        隣接・境界・二次形式はすべて root 単位で扱う（属性の継ぎ目で面が切れて見えないように）。
+      - 参照される頂点が 2 つ以上ある root は「継ぎ目」として固定（kLocked）。
+        それ以外の root は頂点 1 つだけなので、縮退は頂点番号の付け替え（u → v）で済む。
+    パス：
+      - 今の三角形から root → 三角形の隣接（CSR）を作り、全辺の縮退候補（安い向き）を出して誤差順に並べる。
+      - 安い順に、このパスでまだ触っていない 2 頂点の組だけを潰す。潰した u の 1-ring（周りの三角形の頂点）も
+        触ったことにする（隣が同じパスで動くと、動く前の位置で行った裏返り判定が成り立たなくなるため）。
+        誤差が上限を超えたら、または目標の三角形数に届く見込みになったらパスを終える。
+      - インデックスを付け替え、root が重なった三角形（面積 0）を捨てて次のパスへ。
+        1 つも潰せなかったら終わり。
+    二次形式：
+      - 位置は AABB 中心を原点、対角の半分を 1 に正規化してから作る（誤差がそのまま比になる）。
+      - 三角形の平面は面積で重み付けし、評価値を重みの和で割る（= 平面までの距離の 2 乗の重み付き平均）。
+      - 境界の辺には「辺を含み面に垂直な平面」を 辺の長さ^2 × kBorderWeight で足す。
+    裏返り判定：
+      - u の周りの三角形（v を含まないもの）の法線を、u を v に置き換える前後で比べ、
+        なす角が約 75° を超える（cos < 0.25）なら潰さない。
+*/
+
+namespace
+{
+    constexpr std::uint8_t kManifold = 0; // 閉じた面の内側：どの隣へも潰せる
+    constexpr std::uint8_t kBorder = 1;   // 開いた辺に接する：境界に沿ってのみ潰せる
+    constexpr std::uint8_t kLocked = 2;   // 属性の継ぎ目：動かさない
+
+    constexpr double kBorderWeight = 10.0;
+    constexpr std::size_t kMaxPasses = 64;
+
+    struct Quadric
+    {
+        double a00 = 0, a11 = 0, a22 = 0, a01 = 0, a02 = 0, a12 = 0;
+        double b0 = 0, b1 = 0, b2 = 0, c = 0;
+        double w = 0;
+
+        // 平面 n・p + d = 0（n は単位ベクトル）を重み weight で足す
+        void AddPlane(double nx, double ny, double nz, double d, double weight)
+        {
+            a00 += weight * nx * nx; a11 += weight * ny * ny; a22 += weight * nz * nz;
+            a01 += weight * nx * ny; a02 += weight * nx * nz; a12 += weight * ny * nz;
+            b0 += weight * nx * d; b1 += weight * ny * d; b2 += weight * nz * d;
+            c += weight * d * d;
+            w += weight;
+        }
+
+        void Add(const Quadric& q)
+        {
+            a00 += q.a00; a11 += q.a11; a22 += q.a22; a01 += q.a01; a02 += q.a02; a12 += q.a12;
+            b0 += q.b0; b1 += q.b1; b2 += q.b2; c += q.c; w += q.w;
+        }
+
+        // 重み付き平均の距離^2（重みが無ければ 0）
+        double Error(const XMFLOAT3& p) const
+        {
+            if (w <= 0.0) return 0.0;
+            const double x = p.x, y = p.y, z = p.z;
+            const double r = a00 * x * x + a11 * y * y + a22 * z * z
+                + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z)
+                + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+            return std::fabs(r) / w;
+        }
+    };
+
+    struct Collapse
+    {
+        std::uint32_t u = 0; // 動かす頂点
+        std::uint32_t v = 0; // 寄せ先の頂点
+        double        cost = 0.0;
+    };
+
+    inline XMFLOAT3 Sub(const XMFLOAT3& a, const XMFLOAT3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+    inline XMFLOAT3 Cross(const XMFLOAT3& a, const XMFLOAT3& b)
+    {
+        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+    }
+    inline float Dot(const XMFLOAT3& a, const XMFLOAT3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    inline float Length(const XMFLOAT3& a) { return std::sqrt(Dot(a, a)); }
+
+    inline std::uint32_t PositionBits(float f)
+    {
+        if (f == 0.0f) return 0; // -0.0f と +0.0f を同一視
+        std::uint32_t u;
+        std::memcpy(&u, &f, sizeof(u));
+        return u;
+    }
+
+    // root（位置）→ その位置を使う三角形 の CSR
+    struct Adjacency
+    {
+        std::vector<std::uint32_t> offsets;
+        std::vector<std::uint32_t> triangles;
+
+        void Build(const std::vector<std::uint32_t>& tris, const std::vector<std::uint32_t>& root, std::size_t vertexCount)
+        {
+            offsets.assign(vertexCount + 1, 0);
+            for (std::uint32_t idx : tris) ++offsets[root[idx] + 1];
+            for (std::size_t i = 0; i < vertexCount; ++i) offsets[i + 1] += offsets[i];
+            triangles.resize(tris.size());
+            std::vector<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (std::size_t i = 0; i < tris.size(); ++i)
+                triangles[cursor[root[tris[i]]]++] = static_cast<std::uint32_t>(i / 3);
+        }
+    };
+
+    struct Simplifier
+    {
+        const std::size_t          vertexCount;
+        std::vector<XMFLOAT3>      pos;   // 正規化した位置
+        std::vector<std::uint32_t> root;  // 頂点 → 同じ位置の代表
+        std::vector<std::uint8_t>  kind;  // root ごとの種類
+        std::vector<Quadric>       quadric; // root ごと
+        std::vector<std::uint32_t> tris;  // 今の三角形（頂点番号）
+        Adjacency                  adj;
+        bool                       adjFresh = false; // adj が今の tris から作ったものか
+        double                     maxError2 = 0.0;  // これまでに潰した中で最大の誤差^2
+
+        explicit Simplifier(std::size_t n) : vertexCount(n) {}
+
+        // 三角形 t の中の root r の位置（0..2）。無ければ 3
+        int Corner(std::uint32_t t, std::uint32_t r) const
+        {
+            for (int k = 0; k < 3; ++k)
+                if (root[tris[t * 3 + k]] == r) return k;
+            return 3;
+        }
+
+        // 有向辺 a → b（root）を持つ三角形があるか（a の周りを探す）
+        bool EdgeExists(std::uint32_t a, std::uint32_t b) const
+        {
+            for (std::uint32_t i = adj.offsets[a]; i < adj.offsets[a + 1]; ++i)
+            {
+                const std::uint32_t t = adj.triangles[i];
+                const int k = Corner(t, a);
+                if (k < 3 && root[tris[t * 3 + (k + 1) % 3]] == b) return true;
+            }
+            return false;
+        }
+
+        // root が重なった三角形（面積 0）を捨てる
+        void RemoveDegenerate()
+        {
+            std::size_t w = 0;
+            for (std::size_t i = 0; i < tris.size(); i += 3)
+            {
+                const std::uint32_t a = tris[i], b = tris[i + 1], c = tris[i + 2];
+                const std::uint32_t ra = root[a], rb = root[b], rc = root[c];
+                if (ra == rb || rb == rc || ra == rc) continue;
+                tris[w++] = a; tris[w++] = b; tris[w++] = c;
+            }
+            tris.resize(w);
+        }
+
+        void Setup(const unsigned int* indices, std::size_t indexCount, const Vertex* vertices)
+        {
+            // 位置の正規化（AABB 中心を原点、対角の半分を 1）
+            XMFLOAT3 mn{ vertices[0].Position }, mx{ vertices[0].Position };
+            for (std::size_t i = 1; i < vertexCount; ++i)
+            {
+                const XMFLOAT3& p = vertices[i].Position;
+                mn = { std::min(mn.x, p.x), std::min(mn.y, p.y), std::min(mn.z, p.z) };
+                mx = { std::max(mx.x, p.x), std::max(mx.y, p.y), std::max(mx.z, p.z) };
+            }
+            const XMFLOAT3 center{ (mn.x + mx.x) * 0.5f, (mn.y + mx.y) * 0.5f, (mn.z + mx.z) * 0.5f };
+            const float radius = Length(Sub(mx, mn)) * 0.5f;
+            const float scale = radius > 0.0f ? 1.0f / radius : 1.0f;
+            pos.resize(vertexCount);
+            for (std::size_t i = 0; i < vertexCount; ++i)
+            {
+                const XMFLOAT3 d = Sub(vertices[i].Position, center);
+                pos[i] = { d.x * scale, d.y * scale, d.z * scale };
+            }
+
+            // 位置の同一視（並べて同じ位置の組の最小番号を root に）
+            std::vector<std::uint32_t> order(vertexCount);
+            std::iota(order.begin(), order.end(), 0u);
+            auto key = [vertices](std::uint32_t i)
+                {
+                    const XMFLOAT3& p = vertices[i].Position;
+                    return std::make_tuple(PositionBits(p.x), PositionBits(p.y), PositionBits(p.z));
+                };
+            std::sort(order.begin(), order.end(), [&key](std::uint32_t a, std::uint32_t b)
+                {
+                    const auto ka = key(a), kb = key(b);
+                    return ka != kb ? ka < kb : a < b;
+                });
+            root.resize(vertexCount);
+            for (std::size_t i = 0; i < vertexCount; ++i)
+                root[order[i]] = (i > 0 && key(order[i]) == key(order[i - 1])) ? root[order[i - 1]] : order[i];
+
+            tris.assign(indices, indices + indexCount);
+            RemoveDegenerate();
+            adj.Build(tris, root, vertexCount);
+            adjFresh = true;
+
+            // 種類：参照される頂点が 2 つ以上ある位置は継ぎ目、開いた辺に接する位置は境界
+            std::vector<std::uint8_t> referenced(vertexCount, 0);
+            std::vector<std::uint32_t> wedges(vertexCount, 0);
+            for (std::uint32_t idx : tris)
+            {
+                if (!referenced[idx]) { referenced[idx] = 1; ++wedges[root[idx]]; }
+            }
+            kind.assign(vertexCount, kManifold);
+            for (std::uint32_t r = 0; r < vertexCount; ++r)
+            {
+                if (wedges[r] == 0) continue;
+                if (wedges[r] > 1) { kind[r] = kLocked; continue; }
+                for (std::uint32_t i = adj.offsets[r]; i < adj.offsets[r + 1] && kind[r] == kManifold; ++i)
+                {
+                    const std::uint32_t t = adj.triangles[i];
+                    const int k = Corner(t, r);
+                    const std::uint32_t next = root[tris[t * 3 + (k + 1) % 3]];
+                    const std::uint32_t prev = root[tris[t * 3 + (k + 2) % 3]];
+                    if (!EdgeExists(next, r) || !EdgeExists(r, prev)) kind[r] = kBorder;
+                }
+            }
+
+            // 二次形式（root ごと）
+            quadric.assign(vertexCount, Quadric());
+            for (std::size_t i = 0; i < tris.size(); i += 3)
+            {
+                const std::uint32_t v[3] = { tris[i], tris[i + 1], tris[i + 2] };
+                XMFLOAT3 n = Cross(Sub(pos[v[1]], pos[v[0]]), Sub(pos[v[2]], pos[v[0]]));
+                const float len = Length(n);
+                if (len <= 0.0f) continue;
+                n = { n.x / len, n.y / len, n.z / len };
+                const double d = -Dot(n, pos[v[0]]);
+                for (std::uint32_t x : v) quadric[root[x]].AddPlane(n.x, n.y, n.z, d, len * 0.5);
+
+                // 開いた辺：辺を含み面に垂直な平面（境界が内側へ縮むのを防ぐ）
+                for (int k = 0; k < 3; ++k)
+                {
+                    const std::uint32_t a = v[k], b = v[(k + 1) % 3];
+                    if (EdgeExists(root[b], root[a])) continue;
+                    const XMFLOAT3 e = Sub(pos[b], pos[a]);
+                    XMFLOAT3 m = Cross(e, n);
+                    const float ml = Length(m);
+                    if (ml <= 0.0f) continue;
+                    m = { m.x / ml, m.y / ml, m.z / ml };
+                    const double md = -Dot(m, pos[a]);
+                    const double weight = Dot(e, e) * kBorderWeight;
+                    quadric[root[a]].AddPlane(m.x, m.y, m.z, md, weight);
+                    quadric[root[b]].AddPlane(m.x, m.y, m.z, md, weight);
+                }
+            }
+        }
+
+        bool CanCollapse(std::uint32_t u, std::uint32_t v, bool open) const
+        {
+            switch (kind[root[u]])
+            {
+            case kManifold: return true;
+            case kBorder:   return open && kind[root[v]] != kManifold;
+            default:        return false;
+            }
+        }
+
+        double Cost(std::uint32_t u, std::uint32_t v) const
+        {
+            Quadric q = quadric[root[u]];
+            q.Add(quadric[root[v]]);
+            return q.Error(pos[v]);
+        }
+
+        // u を v に置き換えたとき、周りの三角形が裏返る/潰れすぎるなら true
+        bool Flips(std::uint32_t u, std::uint32_t v) const
+        {
+            const std::uint32_t ru = root[u], rv = root[v];
+            for (std::uint32_t i = adj.offsets[ru]; i < adj.offsets[ru + 1]; ++i)
+            {
+                const std::uint32_t t = adj.triangles[i];
+                if (Corner(t, rv) < 3) continue; // 潰れて消える三角形
+                const int k = Corner(t, ru);
+                const XMFLOAT3& b = pos[tris[t * 3 + (k + 1) % 3]];
+                const XMFLOAT3& c = pos[tris[t * 3 + (k + 2) % 3]];
+                const XMFLOAT3 n0 = Cross(Sub(b, pos[u]), Sub(c, pos[u]));
+                const XMFLOAT3 n1 = Cross(Sub(b, pos[v]), Sub(c, pos[v]));
+                if (Dot(n0, n1) <= 0.25f * Length(n0) * Length(n1)) return true; // 面積 0 になるものも潰さない
+            }
+            return false;
+        }
+
+        // 目標の三角形数まで（誤差上限の範囲で）潰す。続けて呼べばさらに減らせる（二次形式は引き継ぐ）
+        void Run(std::size_t targetTriangles, double errorLimit2)
+        {
+            std::vector<Collapse> candidates;
+            std::vector<std::uint32_t> collapseTo(vertexCount);
+            std::vector<std::uint8_t> touched(vertexCount);
+
+            for (std::size_t pass = 0; pass < kMaxPasses && tris.size() / 3 > targetTriangles; ++pass)
+            {
+                if (!adjFresh) adj.Build(tris, root, vertexCount);
+                adjFresh = true;
+
+                // 候補：内側の辺は片側の三角形からだけ（root の小さい方から）、開いた辺はそのまま
+                candidates.clear();
+                for (std::size_t i = 0; i < tris.size(); ++i)
+                {
+                    const std::uint32_t a = tris[i];
+                    const std::uint32_t b = tris[i - i % 3 + (i % 3 + 1) % 3];
+                    const bool open = !EdgeExists(root[b], root[a]);
+                    if (!open && root[a] > root[b]) continue;
+
+                    const bool ab = CanCollapse(a, b, open), ba = CanCollapse(b, a, open);
+                    if (!ab && !ba) continue;
+                    const double cab = ab ? Cost(a, b) : 0.0, cba = ba ? Cost(b, a) : 0.0;
+                    if (ab && (!ba || cab <= cba)) candidates.push_back({ a, b, cab });
+                    else                           candidates.push_back({ b, a, cba });
+                }
+                if (candidates.empty()) break;
+                std::sort(candidates.begin(), candidates.end(),
+                    [](const Collapse& x, const Collapse& y) { return x.cost < y.cost; });
+
+                std::iota(collapseTo.begin(), collapseTo.end(), 0u);
+                std::fill(touched.begin(), touched.end(), std::uint8_t(0));
+                const std::size_t need = tris.size() / 3 - targetTriangles;
+                std::size_t removed = 0, collapses = 0;
+                for (const Collapse& c : candidates)
+                {
+                    if (c.cost > errorLimit2) break;
+                    const std::uint32_t ru = root[c.u], rv = root[c.v];
+                    if (touched[ru] || touched[rv]) continue;
+                    if (Flips(c.u, c.v)) continue;
+
+                    collapseTo[c.u] = c.v; // u は継ぎ目ではないので頂点は 1 つだけ
+                    quadric[rv].Add(quadric[ru]);
+                    // u の周りはこのパスでは動かさない（裏返り判定は動く前の位置で行っているため）
+                    for (std::uint32_t i = adj.offsets[ru]; i < adj.offsets[ru + 1]; ++i)
+                        for (int k = 0; k < 3; ++k) touched[root[tris[adj.triangles[i] * 3 + k]]] = 1;
+                    touched[rv] = 1;
+                    maxError2 = std::max(maxError2, c.cost);
+                    ++collapses;
+                    removed += (kind[ru] == kBorder) ? 1 : 2; // 境界の辺は片側にしか三角形が無い
+                    if (removed >= need) break;
+                }
+                if (collapses == 0) break;
+
+                for (std::uint32_t& idx : tris) idx = collapseTo[idx];
+                RemoveDegenerate();
+                adjFresh = false;
+            }
+        }
+    };
+
+    bool ValidTriangleList(const unsigned int* indices, std::size_t indexCount, std::size_t vertexCount)
+    {
+        if (!indices || indexCount == 0 || indexCount % 3 != 0) return false;
+        for (std::size_t i = 0; i < indexCount; ++i)
+            if (indices[i] >= vertexCount) return false;
+        return true;
+    }
+}
+
+std::size_t SimplifyMesh(unsigned int* destination, const unsigned int* indices, std::size_t indexCount,
+    const Vertex* vertices, std::size_t vertexCount, std::size_t targetIndexCount, float targetError,
+    float* resultError)
+{
+    if (resultError) *resultError = 0.0f;
+    if (!ValidTriangleList(indices, indexCount, vertexCount) || !vertices)
+    {
+        if (destination != indices) std::copy(indices, indices + indexCount, destination);
+        return indexCount;
+    }
+
+    Simplifier s(vertexCount);
+    s.Setup(indices, indexCount, vertices);
+    const double limit = static_cast<double>(targetError);
+    s.Run(targetIndexCount / 3, limit * limit);
+
+    std::copy(s.tris.begin(), s.tris.end(), destination);
+    if (resultError) *resultError = static_cast<float>(std::sqrt(s.maxError2));
+    return s.tris.size();
+}
+
+std::uint32_t BuildMeshLods(const MeshData& mesh, const MeshLodSettings& settings, MeshLods& out)
+{
+    out.Clear();
+    const std::size_t indexCount = mesh.Indices.size();
+    if (!ValidTriangleList(mesh.Indices.data(), indexCount, mesh.Vertices.size())) return 1;
+
+    // 1 つの Simplifier を段ごとに続けて走らせる（二次形式は元メッシュから積み上がるので、
+    // 誤差は常に元の形に対するもの。段ごとに元から作り直すより速い）
+    Simplifier s(mesh.Vertices.size());
+    s.Setup(mesh.Indices.data(), indexCount, mesh.Vertices.data());
+    const double limit2 = static_cast<double>(settings.maxError) * settings.maxError;
+
+    std::size_t prevCount = indexCount;
+    float ratio = 1.0f;
+    for (std::uint32_t lod = 1; lod < settings.maxLods; ++lod)
+    {
+        ratio *= settings.reduction;
+        const std::size_t targetTriangles = std::max(settings.minTriangles,
+            static_cast<std::size_t>(static_cast<float>(indexCount / 3) * ratio));
+        if (targetTriangles * 3 >= prevCount) break;
+
+        s.Run(targetTriangles, limit2);
+        const std::size_t count = s.tris.size();
+        if (count == 0 || static_cast<float>(count) > static_cast<float>(prevCount) * settings.minProgress) break;
+
+        MeshLodLevel level;
+        level.indexOffset = static_cast<std::uint32_t>(out.Indices.size());
+        level.indexCount = static_cast<std::uint32_t>(count);
+        level.error = static_cast<float>(std::sqrt(s.maxError2)); // 続けて潰すので粗い段ほど大きい
+        out.Indices.insert(out.Indices.end(), s.tris.begin(), s.tris.end());
+        OptimizeVertexCache(out.Indices.data() + level.indexOffset, count, mesh.Vertices.size());
+        out.Levels.push_back(level);
+
+        prevCount = count;
+        if (count / 3 <= settings.minTriangles) break;
+    }
+    return static_cast<std::uint32_t>(out.Levels.size() + 1);
+}
+
+void BuildMeshLods(const MeshData* const* meshes, std::size_t count, const MeshLodSettings& settings, MeshLods* out)
+{
+    JobSystem::ParallelFor(count, 1, [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                if (meshes[i]) BuildMeshLods(*meshes[i], settings, out[i]);
+                else           out[i].Clear();
+            }
+        });
+}
@@ -0,0 +1,81 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Assets/Mesh.h"
+
+/*
+===============================================================================
+ MeshSimplifier（二次誤差によるメッシュ簡略化と LOD の生成）
+-------------------------------------------------------------------------------
+目的:
+  - 遠くの小さく映るオブジェクトまで全三角形で描かないよう、MeshData から三角形数を
+    段階的に減らした LOD（Level of Detail）を作る。GPU には依存しない純 CPU コード。
+
+方式（SimplifyMesh。Garland & Heckbert 1997 の二次誤差 = QEM）:
+  - 頂点ごとに「周りの三角形の平面までの距離の 2 乗和」を表す 4×4 の二次形式を持ち、
+    辺 u→v を縮退させたときの誤差 = (Q_u + Q_v)(v の位置) が小さい辺から潰す。
+  - 頂点は動かさず既存の頂点へ寄せる（u を v に置き換えるだけ）。LOD のインデックスは
+    元の頂点配列をそのまま指すので、全 LOD で 1 つの VB（区間）を共有できる。
+  - 開いた辺（境界）の頂点は境界に沿ってのみ動かし、境界には辺に垂直な平面の誤差を足して形を保つ。
+  - 同じ位置に属性違いの頂点がある（法線/色の継ぎ目）頂点は動かさない（縮退先にはなれる）。
+  - 潰した後に周りの三角形の向きが裏返るものは行わない。三角形の巻き順は変えない。
+  - 誤差は頂点 AABB の対角の半分を 1 とした比（= 境界球半径に対する比。スケールに依らない）。
+
+LOD（BuildMeshLods）:
+  - LOD0 は元の Indices。LOD k は三角形数を reduction^k 倍に向けて、前の段の続きから潰す
+    （二次形式は元メッシュの面から積み上げたものを引き継ぐので、誤差は常に元の形に対するもの）。
+  - 三角形が十分減らない / maxError に達した / minTriangles を下回る段で打ち切る（全体で 1～maxLods 段）。
+  - 各段のインデックスは頂点キャッシュ向けに並べ直す（OptimizeVertexCache）。
+  - 複数メッシュは JobSystem で並列に作る（メッシュ単位。各メッシュの中は逐次）。
+
+前提:
+  - Indices は三角形リスト（3 の倍数）で、どの値も Vertices.size() 未満であること。
+    満たさないメッシュは簡略化しない（SimplifyMesh は入力をそのまま返し、LOD は作らない）。
+===============================================================================
+*/
+
+// LOD 1 段（LOD1 以降。LOD0 = 元の Indices 全体）
+struct MeshLodLevel
+{
+    std::uint32_t indexOffset = 0; // MeshLods::Indices 上の先頭
+    std::uint32_t indexCount = 0;
+    float         error = 0.0f;    // 元の形からの誤差（AABB 対角の半分に対する比）
+};
+
+// 1 メッシュ分の LOD（LOD1 以降。頂点は元の MeshData::Vertices を指す）
+struct MeshLods
+{
+    std::vector<unsigned int> Indices; // LOD1 以降のインデックスを連結したもの
+    std::vector<MeshLodLevel> Levels;  // 細かい順（Levels[0] = LOD1）
+
+    void Clear() { Indices.clear(); Levels.clear(); }
+};
+
+// BuildMeshLods の設定
+struct MeshLodSettings
+{
+    std::uint32_t maxLods = 4;         // LOD0 を含めた最大段数
+    float         reduction = 0.5f;    // 段ごとの三角形数の比（LOD k の目標 = LOD0 × reduction^k）
+    float         maxError = 0.05f;    // 許す誤差の上限（これを超える潰し方はしない）
+    float         minProgress = 0.85f; // 前の段の三角形数 × minProgress より減らなければ打ち切る
+    std::size_t   minTriangles = 32;   // これより少ない段は作らない
+};
+
+/**
+ * @brief 二次誤差で三角形を減らす（頂点は元のまま、インデックスだけを作る）
+ * @param destination      出力（indexCount 個ぶんの領域。indices と同じでもよい）
+ * @param targetIndexCount 目標のインデックス数（これ以下になったら止める）
+ * @param targetError      許す誤差の上限（AABB 対角の半分に対する比）
+ * @param resultError      実際に生じた最大の誤差（nullptr 可）
+ * @return 出力したインデックス数
+ */
+std::size_t SimplifyMesh(unsigned int* destination, const unsigned int* indices, std::size_t indexCount,
+    const Vertex* vertices, std::size_t vertexCount, std::size_t targetIndexCount, float targetError,
+    float* resultError = nullptr);
+
+/// mesh の LOD1 以降を作る（out は上書き）。作れた段数（LOD0 を含む）を返す
+std::uint32_t BuildMeshLods(const MeshData& mesh, const MeshLodSettings& settings, MeshLods& out);
+
+/// 複数メッシュの LOD をメッシュ単位で並列に作る（out[i] は meshes[i] の結果。nullptr のメッシュは空）
+void BuildMeshLods(const MeshData* const* meshes, std::size_t count, const MeshLodSettings& settings, MeshLods* out);
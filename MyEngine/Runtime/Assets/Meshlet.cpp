@@ -0,0 +1,505 @@
+﻿#include "Assets/Meshlet.h"
+#include "Core/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace DirectX;
+
+/*
+    Meshlet.cpp
+    ----------------------------------------------------------------------------
+    隣接：
+      - 頂点 → 未使用の三角形 の表（CSR）。三角形を使うたびに 3 頂点の区間から swap-remove で外すので、
+        候補の走査は常に「まだ残っている三角形」だけを見る。
+    候補の評価（Builder::Score）：
+      - 想定半径 R = sqrt(三角形の平均面積 × maxTriangles) / 2（上限まで詰めたメッシュレットの大きさの目安）。
+      - 距離 d = 三角形の重心とメッシュレットの重心の距離、揃い s = 面法線と平均法線の内積として
+          score = (1 + d / R × (1 - coneWeight)) × max(1 - s × coneWeight, 1e-3)
+        を小さい方から選ぶ（新しく増える頂点数が少ないことが常に先）。
+    kd 木：
+      - 三角形の重心を葉 8 個以下まで中央値で割る。使った三角形は葉から親へ alive を減らし、
+        alive = 0 の部分木は探索しない（使い切った側を何度も辿らない）。
+      - 隣接が尽きたとき（連結成分の終わり）と、縁に残った三角形が無いときの次の種にだけ使う。
+*/
+
+namespace
+{
+    constexpr std::uint8_t  kUnused = 0xFF;
+    constexpr std::uint32_t kNone = ~0u;
+    constexpr std::uint32_t kLeafSize = 8;
+
+    XMFLOAT3 Sub(const XMFLOAT3& a, const XMFLOAT3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+    float Dot(const XMFLOAT3& a, const XMFLOAT3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    XMFLOAT3 Cross(const XMFLOAT3& a, const XMFLOAT3& b)
+    {
+        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+    }
+
+    // 三角形の重心の kd 木（使い切った部分木は飛ばす）
+    class CentroidTree
+    {
+    public:
+        void Build(const std::vector<XMFLOAT3>& points)
+        {
+            m_points = &points;
+            const std::uint32_t n = static_cast<std::uint32_t>(points.size());
+            m_items.resize(n);
+            for (std::uint32_t i = 0; i < n; ++i) m_items[i] = i;
+            m_leafOf.assign(n, kNone);
+            m_removed.assign(n, 0);
+            m_nodes.clear();
+            m_nodes.reserve(n / kLeafSize * 2 + 1);
+            if (n > 0) BuildNode(0, n, kNone);
+        }
+
+        // 使った点を外す
+        void Remove(std::uint32_t item)
+        {
+            if (m_removed[item]) return;
+            m_removed[item] = 1;
+            for (std::uint32_t node = m_leafOf[item]; node != kNone; node = m_nodes[node].parent)
+                --m_nodes[node].alive;
+        }
+
+        // p に最も近い残りの点（無ければ kNone）
+        std::uint32_t Nearest(const XMFLOAT3& p) const
+        {
+            std::uint32_t best = kNone;
+            float bestD2 = INFINITY;
+            if (!m_nodes.empty()) NearestNode(0, p, best, bestD2);
+            return best;
+        }
+
+    private:
+        struct Node
+        {
+            float         split = 0.0f;
+            std::uint32_t axis = 3;     // 0..2 = 分割軸、3 = 葉
+            std::uint32_t a = 0;        // 内部：左の子 / 葉：m_items の先頭
+            std::uint32_t b = 0;        // 内部：右の子 / 葉：個数
+            std::uint32_t alive = 0;    // 部分木に残っている点の数
+            std::uint32_t parent = kNone;
+        };
+
+        std::uint32_t BuildNode(std::uint32_t begin, std::uint32_t end, std::uint32_t parent)
+        {
+            const std::uint32_t index = static_cast<std::uint32_t>(m_nodes.size());
+            m_nodes.emplace_back();
+            m_nodes[index].parent = parent;
+            m_nodes[index].alive = end - begin;
+
+            const std::vector<XMFLOAT3>& pts = *m_points;
+            float mn[3] = { INFINITY, INFINITY, INFINITY }, mx[3] = { -INFINITY, -INFINITY, -INFINITY };
+            for (std::uint32_t i = begin; i < end; ++i)
+            {
+                const XMFLOAT3& q = pts[m_items[i]];
+                const float c[3] = { q.x, q.y, q.z };
+                for (int k = 0; k < 3; ++k) { mn[k] = std::min(mn[k], c[k]); mx[k] = std::max(mx[k], c[k]); }
+            }
+            std::uint32_t axis = 0;
+            for (std::uint32_t k = 1; k < 3; ++k) if (mx[k] - mn[k] > mx[axis] - mn[axis]) axis = k;
+
+            if (end - begin <= kLeafSize || !(mx[axis] > mn[axis]))
+            {
+                m_nodes[index].axis = 3;
+                m_nodes[index].a = begin;
+                m_nodes[index].b = end - begin;
+                for (std::uint32_t i = begin; i < end; ++i) m_leafOf[m_items[i]] = index;
+                return index;
+            }
+
+            auto coord = [&](std::uint32_t item) { const XMFLOAT3& q = pts[item]; return axis == 0 ? q.x : axis == 1 ? q.y : q.z; };
+            const std::uint32_t mid = begin + (end - begin) / 2;
+            std::nth_element(m_items.begin() + begin, m_items.begin() + mid, m_items.begin() + end,
+                [&](std::uint32_t l, std::uint32_t r) { return coord(l) < coord(r); });
+            const float split = coord(m_items[mid]);
+
+            const std::uint32_t left = BuildNode(begin, mid, index);
+            const std::uint32_t right = BuildNode(mid, end, index);
+            Node& node = m_nodes[index]; // 子を作ると emplace_back で動くので取り直す
+            node.axis = axis;
+            node.split = split;
+            node.a = left;
+            node.b = right;
+            return index;
+        }
+
+        void NearestNode(std::uint32_t index, const XMFLOAT3& p, std::uint32_t& best, float& bestD2) const
+        {
+            const Node& node = m_nodes[index];
+            if (node.alive == 0) return;
+            if (node.axis == 3)
+            {
+                for (std::uint32_t i = node.a; i < node.a + node.b; ++i)
+                {
+                    const std::uint32_t item = m_items[i];
+                    if (m_removed[item]) continue;
+                    const XMFLOAT3 d = Sub((*m_points)[item], p);
+                    const float d2 = Dot(d, d);
+                    if (d2 < bestD2) { bestD2 = d2; best = item; }
+                }
+                return;
+            }
+            const float c = node.axis == 0 ? p.x : node.axis == 1 ? p.y : p.z;
+            const float d = c - node.split;
+            NearestNode(d <= 0.0f ? node.a : node.b, p, best, bestD2);
+            if (d * d < bestD2) NearestNode(d <= 0.0f ? node.b : node.a, p, best, bestD2);
+        }
+
+        const std::vector<XMFLOAT3>* m_points = nullptr;
+        std::vector<Node>            m_nodes;
+        std::vector<std::uint32_t>   m_items;
+        std::vector<std::uint32_t>   m_leafOf;
+        std::vector<std::uint8_t>    m_removed;
+    };
+
+    struct Builder
+    {
+        std::uint32_t maxVertices = 64;
+        std::uint32_t maxTriangles = 124;
+        float         coneWeight = 0.25f;
+        float         expectedRadius = 1.0f;
+
+        std::vector<std::uint32_t> tris;      // 残した三角形（頂点番号 ×3）
+        std::vector<XMFLOAT3>      centroids; // 三角形の重心
+        std::vector<XMFLOAT3>      normals;   // 三角形の単位法線（面積 0 は 0）
+        std::vector<std::uint32_t> adjOffset; // 頂点 → adjData の先頭
+        std::vector<std::uint32_t> live;      // 頂点ごとの未使用の三角形数（adjData の区間の長さ）
+        std::vector<std::uint32_t> adjData;
+        std::vector<std::uint8_t>  local;     // 頂点 → 今のメッシュレットでのローカル番号（kUnused = 未登録）
+        std::vector<std::uint8_t>  emitted;
+        CentroidTree               tree;
+
+        // 今のメッシュレット
+        Meshlet  current;
+        std::uint32_t last = 0; // 直前に足した三角形
+        XMFLOAT3 centroidSum{ 0, 0, 0 };
+        XMFLOAT3 normalSum{ 0, 0, 0 };
+
+        void Init(const MeshData& mesh)
+        {
+            const std::size_t vertexCount = mesh.Vertices.size();
+            const std::uint32_t* idx = mesh.Indices.data();
+            tris.clear();
+            tris.reserve(mesh.Indices.size());
+            for (std::size_t i = 0; i + 2 < mesh.Indices.size(); i += 3)
+            {
+                const std::uint32_t a = idx[i], b = idx[i + 1], c = idx[i + 2];
+                if (a == b || b == c || a == c) continue; // 面積を持ちえない
+                tris.push_back(a); tris.push_back(b); tris.push_back(c);
+            }
+
+            const std::size_t triCount = tris.size() / 3;
+            centroids.resize(triCount);
+            normals.resize(triCount);
+            double areaSum = 0.0;
+            for (std::size_t t = 0; t < triCount; ++t)
+            {
+                const XMFLOAT3& a = mesh.Vertices[tris[t * 3 + 0]].Position;
+                const XMFLOAT3& b = mesh.Vertices[tris[t * 3 + 1]].Position;
+                const XMFLOAT3& c = mesh.Vertices[tris[t * 3 + 2]].Position;
+                centroids[t] = { (a.x + b.x + c.x) / 3.0f, (a.y + b.y + c.y) / 3.0f, (a.z + b.z + c.z) / 3.0f };
+                const XMFLOAT3 n = Cross(Sub(b, a), Sub(c, a));
+                const float len = std::sqrt(Dot(n, n));
+                normals[t] = len > 0.0f ? XMFLOAT3{ n.x / len, n.y / len, n.z / len } : XMFLOAT3{ 0, 0, 0 };
+                areaSum += 0.5 * len;
+            }
+            const double meanArea = triCount ? areaSum / static_cast<double>(triCount) : 0.0;
+            expectedRadius = static_cast<float>(std::sqrt(meanArea * maxTriangles) * 0.5);
+            if (!(expectedRadius > 0.0f)) expectedRadius = 1.0f;
+
+            // 頂点 → 三角形（CSR）
+            adjOffset.assign(vertexCount + 1, 0);
+            live.assign(vertexCount, 0);
+            for (std::uint32_t v : tris) ++live[v];
+            for (std::size_t v = 0; v < vertexCount; ++v) adjOffset[v + 1] = adjOffset[v] + live[v];
+            adjData.resize(tris.size());
+            std::vector<std::uint32_t> fill(adjOffset.begin(), adjOffset.end() - 1);
+            for (std::size_t t = 0; t < triCount; ++t)
+                for (int k = 0; k < 3; ++k) adjData[fill[tris[t * 3 + k]]++] = static_cast<std::uint32_t>(t);
+
+            local.assign(vertexCount, kUnused);
+            emitted.assign(triCount, 0);
+            tree.Build(centroids);
+        }
+
+        float Score(std::uint32_t t, const XMFLOAT3& center, const XMFLOAT3& axis) const
+        {
+            const XMFLOAT3 d = Sub(centroids[t], center);
+            const float distance = std::sqrt(Dot(d, d));
+            const float spread = Dot(normals[t], axis);
+            const float cone = std::max(1.0f - spread * coneWeight, 1e-3f);
+            return (1.0f + distance / expectedRadius * (1.0f - coneWeight)) * cone;
+        }
+
+        std::uint32_t Extra(std::uint32_t t) const
+        {
+            return (local[tris[t * 3 + 0]] == kUnused) + (local[tris[t * 3 + 1]] == kUnused) + (local[tris[t * 3 + 2]] == kUnused);
+        }
+
+        XMFLOAT3 Center() const
+        {
+            const float inv = current.triangleCount ? 1.0f / static_cast<float>(current.triangleCount) : 0.0f;
+            return { centroidSum.x * inv, centroidSum.y * inv, centroidSum.z * inv };
+        }
+
+        // 今のメッシュレットの頂点に隣接する三角形から次を選ぶ。hadNeighbor = 上限で入らないものも含めて候補があったか
+        std::uint32_t BestNeighbor(const MeshletData& out, bool& hadNeighbor) const
+        {
+            hadNeighbor = false;
+            const XMFLOAT3 center = Center();
+            XMFLOAT3 axis = normalSum;
+            const float len = std::sqrt(Dot(axis, axis));
+            if (len > 0.0f) axis = { axis.x / len, axis.y / len, axis.z / len };
+
+            std::uint32_t best = kNone, bestExtra = 4;
+            float bestScore = INFINITY;
+            auto visit = [&](std::uint32_t v)
+                {
+                    for (std::uint32_t j = adjOffset[v], e = adjOffset[v] + live[v]; j < e; ++j)
+                    {
+                        const std::uint32_t t = adjData[j];
+                        hadNeighbor = true;
+                        const std::uint32_t extra = Extra(t);
+                        if (current.vertexCount + extra > maxVertices || extra > bestExtra) continue;
+                        const float score = Score(t, center, axis);
+                        if (extra < bestExtra || score < bestScore)
+                        {
+                            best = t;
+                            bestExtra = extra;
+                            bestScore = score;
+                        }
+                    }
+                };
+
+            // 直前に足した三角形の周りで頂点を増やさずに閉じられるものがあれば、それで決める（扇を埋める）
+            for (int k = 0; k < 3; ++k) visit(tris[last * 3 + k]);
+            if (bestExtra == 0) return best;
+            for (std::uint32_t i = 0; i < current.vertexCount; ++i) visit(out.Vertices[current.vertexOffset + i]);
+            return best;
+        }
+
+        // 空のメッシュレットの種：直前のメッシュレットの縁に残った三角形のうち、周りの残りが最も少ないもの
+        std::uint32_t Seed(const MeshletData& out, const Meshlet* previous, const XMFLOAT3& previousCenter, std::uint32_t& scan)
+        {
+            if (previous)
+            {
+                std::uint32_t best = kNone, bestLive = ~0u;
+                for (std::uint32_t i = 0; i < previous->vertexCount; ++i)
+                {
+                    const std::uint32_t v = out.Vertices[previous->vertexOffset + i];
+                    for (std::uint32_t j = adjOffset[v], e = adjOffset[v] + live[v]; j < e; ++j)
+                    {
+                        const std::uint32_t t = adjData[j];
+                        const std::uint32_t l = live[tris[t * 3 + 0]] + live[tris[t * 3 + 1]] + live[tris[t * 3 + 2]];
+                        if (l < bestLive) { bestLive = l; best = t; }
+                    }
+                }
+                if (best != kNone) return best;
+                const std::uint32_t nearest = tree.Nearest(previousCenter);
+                if (nearest != kNone) return nearest;
+            }
+            while (scan < emitted.size() && emitted[scan]) ++scan;
+            return scan < emitted.size() ? scan : kNone;
+        }
+
+        void Add(std::uint32_t t, MeshletData& out)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                const std::uint32_t v = tris[t * 3 + k];
+                if (local[v] == kUnused)
+                {
+                    local[v] = static_cast<std::uint8_t>(current.vertexCount++);
+                    out.Vertices.push_back(v);
+                }
+                out.Triangles.push_back(local[v]);
+
+                // 隣接から外す（区間内で末尾と入れ替え）
+                const std::uint32_t begin = adjOffset[v];
+                const std::uint32_t last = begin + live[v] - 1;
+                for (std::uint32_t j = begin; j <= last; ++j)
+                {
+                    if (adjData[j] != t) continue;
+                    std::swap(adjData[j], adjData[last]);
+                    break;
+                }
+                --live[v];
+            }
+            ++current.triangleCount;
+            last = t;
+            emitted[t] = 1;
+            tree.Remove(t);
+            centroidSum = { centroidSum.x + centroids[t].x, centroidSum.y + centroids[t].y, centroidSum.z + centroids[t].z };
+            normalSum = { normalSum.x + normals[t].x, normalSum.y + normals[t].y, normalSum.z + normals[t].z };
+        }
+
+        // 今のメッシュレットを閉じる（空なら何もしない）。閉じたら true
+        bool Flush(MeshletData& out)
+        {
+            if (current.triangleCount == 0) return false;
+            for (std::uint32_t i = 0; i < current.vertexCount; ++i) local[out.Vertices[current.vertexOffset + i]] = kUnused;
+            out.Meshlets.push_back(current);
+            out.IndexCount += current.triangleCount * 3;
+            current = Meshlet();
+            current.vertexOffset = static_cast<std::uint32_t>(out.Vertices.size());
+            current.triangleOffset = static_cast<std::uint32_t>(out.Triangles.size());
+            centroidSum = { 0, 0, 0 };
+            normalSum = { 0, 0, 0 };
+            return true;
+        }
+
+        void Run(MeshletData& out)
+        {
+            const std::size_t triCount = emitted.size();
+            out.Meshlets.reserve(triCount / maxTriangles + 1);
+            out.Vertices.reserve(triCount);
+            out.Triangles.reserve(triCount * 3);
+
+            std::uint32_t scan = 0;
+            XMFLOAT3 previousCenter{ 0, 0, 0 };
+            for (std::size_t done = 0; done < triCount; )
+            {
+                std::uint32_t next = kNone;
+                if (current.triangleCount > 0)
+                {
+                    bool hadNeighbor = false;
+                    next = BestNeighbor(out, hadNeighbor);
+                    if (next == kNone && !hadNeighbor && current.vertexCount + 3 <= maxVertices)
+                        next = tree.Nearest(Center()); // 連結成分を使い切った：近くの別の成分へ
+                    if (next == kNone)
+                    {
+                        previousCenter = Center();
+                        Flush(out);
+                        continue;
+                    }
+                }
+                else
+                {
+                    next = Seed(out, out.Meshlets.empty() ? nullptr : &out.Meshlets.back(), previousCenter, scan);
+                    if (next == kNone) break;
+                }
+
+                Add(next, out);
+                ++done;
+                if (current.triangleCount >= maxTriangles)
+                {
+                    previousCenter = Center();
+                    Flush(out);
+                }
+            }
+            Flush(out);
+        }
+    };
+
+    // Ritter 法の境界球（points は count 個）
+    void BoundingSphere(const XMFLOAT3* points, std::size_t count, XMFLOAT3& center, float& radius)
+    {
+        // 各軸の両端のうち最も離れた組を初期の直径にする
+        std::size_t pmin[3] = { 0, 0, 0 }, pmax[3] = { 0, 0, 0 };
+        auto coord = [](const XMFLOAT3& p, int k) { return k == 0 ? p.x : k == 1 ? p.y : p.z; };
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                if (coord(points[i], k) < coord(points[pmin[k]], k)) pmin[k] = i;
+                if (coord(points[i], k) > coord(points[pmax[k]], k)) pmax[k] = i;
+            }
+        }
+        int axis = 0;
+        float best = -1.0f;
+        for (int k = 0; k < 3; ++k)
+        {
+            const XMFLOAT3 d = Sub(points[pmax[k]], points[pmin[k]]);
+            const float d2 = Dot(d, d);
+            if (d2 > best) { best = d2; axis = k; }
+        }
+        const XMFLOAT3& a = points[pmin[axis]];
+        const XMFLOAT3& b = points[pmax[axis]];
+        center = { (a.x + b.x) * 0.5f, (a.y + b.y) * 0.5f, (a.z + b.z) * 0.5f };
+        radius = std::sqrt(best) * 0.5f;
+
+        // はみ出した点を含むように広げる
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const XMFLOAT3 d = Sub(points[i], center);
+            const float dist = std::sqrt(Dot(d, d));
+            if (dist <= radius) continue;
+            const float grown = (radius + dist) * 0.5f;
+            const float s = (grown - radius) / dist;
+            center = { center.x + d.x * s, center.y + d.y * s, center.z + d.z * s };
+            radius = grown;
+        }
+        radius = radius * (1.0f + 1e-5f) + 1e-7f; // 丸め誤差で端の点が外に出ないように
+    }
+}
+
+MeshletBounds ComputeMeshletBounds(const MeshletData& data, const Meshlet& meshlet, const Vertex* vertices)
+{
+    MeshletBounds bounds;
+    if (meshlet.vertexCount == 0 || meshlet.triangleCount == 0) return bounds;
+
+    XMFLOAT3 points[255];
+    const std::uint32_t vertexCount = std::min<std::uint32_t>(meshlet.vertexCount, 255);
+    for (std::uint32_t i = 0; i < vertexCount; ++i)
+        points[i] = vertices[data.Vertices[meshlet.vertexOffset + i]].Position;
+    BoundingSphere(points, vertexCount, bounds.center, bounds.radius);
+
+    // 法線コーン：面法線の平均を軸に、最も開いた法線との角度 α から sin α
+    XMFLOAT3 normals[255];
+    std::uint32_t normalCount = 0;
+    XMFLOAT3 sum{ 0, 0, 0 };
+    const std::uint8_t* tri = data.Triangles.data() + meshlet.triangleOffset;
+    for (std::uint32_t t = 0; t < meshlet.triangleCount && t < 255; ++t)
+    {
+        const XMFLOAT3& a = points[tri[t * 3 + 0]];
+        const XMFLOAT3& b = points[tri[t * 3 + 1]];
+        const XMFLOAT3& c = points[tri[t * 3 + 2]];
+        const XMFLOAT3 n = Cross(Sub(b, a), Sub(c, a));
+        const float len = std::sqrt(Dot(n, n));
+        if (!(len > 0.0f)) continue; // 面積 0 はラスタライズされないので向きを問わない
+        normals[normalCount++] = { n.x / len, n.y / len, n.z / len };
+        sum = { sum.x + n.x / len, sum.y + n.y / len, sum.z + n.z / len };
+    }
+    const float sumLen = std::sqrt(Dot(sum, sum));
+    if (normalCount == 0 || !(sumLen > 1e-6f)) return bounds; // 向きが打ち消し合う：コーン無し
+
+    bounds.coneAxis = { sum.x / sumLen, sum.y / sumLen, sum.z / sumLen };
+    float minDot = 1.0f;
+    for (std::uint32_t i = 0; i < normalCount; ++i) minDot = std::min(minDot, Dot(normals[i], bounds.coneAxis));
+    minDot -= 1e-3f; // 丸め誤差のぶん開き角を広めに取る（保守側）
+    bounds.coneCutoff = minDot > 0.0f ? std::sqrt(1.0f - minDot * minDot) : 1.0f;
+    return bounds;
+}
+
+std::size_t BuildMeshlets(const MeshData& mesh, const MeshletLimits& limits, MeshletData& out)
+{
+    out.Clear();
+    const std::size_t vertexCount = mesh.Vertices.size();
+    if (mesh.Indices.empty() || mesh.Indices.size() % 3 != 0) return 0;
+    for (std::uint32_t i : mesh.Indices) if (i >= vertexCount) return 0;
+
+    Builder b;
+    b.maxVertices = std::clamp<std::uint32_t>(limits.maxVertices, 3, 255);
+    b.maxTriangles = std::clamp<std::uint32_t>(limits.maxTriangles, 1, 255);
+    b.coneWeight = std::clamp(limits.coneWeight, 0.0f, 1.0f);
+    b.Init(mesh);
+    b.Run(out);
+
+    out.Bounds.resize(out.Meshlets.size());
+    for (std::size_t i = 0; i < out.Meshlets.size(); ++i)
+        out.Bounds[i] = ComputeMeshletBounds(out, out.Meshlets[i], mesh.Vertices.data());
+    return out.Meshlets.size();
+}
+
+void BuildMeshlets(const MeshData* const* meshes, std::size_t count, const MeshletLimits& limits, MeshletData* out)
+{
+    JobSystem::ParallelFor(count, 1, [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                if (meshes[i]) BuildMeshlets(*meshes[i], limits, out[i]);
+                else           out[i].Clear();
+            }
+        });
+}
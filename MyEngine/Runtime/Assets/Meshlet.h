@@ -0,0 +1,97 @@
+﻿#pragma once
+#include <DirectXMath.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Assets/Mesh.h"
+
+/*
+===============================================================================
+ Meshlet（メッシュを小さな三角形の塊に分ける。細かいカリングと GPU 駆動描画の下準備）
+-------------------------------------------------------------------------------
+目的:
+  - オブジェクト単位のカリング（AABB）では、画面に一部しか映らない大きなメッシュや、
+    半分が裏を向いているメッシュも全三角形を描くことになる。MeshData を頂点 64 / 三角形 124 以下の
+    メッシュレットに分け、それぞれに境界球と法線コーンを持たせて塊ごとに捨てられるようにする。
+  - 並び（頂点表 + ローカル 8bit 三角形）はメッシュシェーダがそのまま読める形にしてある。
+    今は CPU 側のカリング（MeshletCuller）がこれを読み、残った塊のインデックスを詰め直して描く。
+  - GPU には依存しない純 CPU コード。
+
+分割（BuildMeshlets。meshoptimizer の buildMeshlets と同じ系統の貪欲法）:
+  - 今のメッシュレットの頂点に隣接する未使用の三角形から、
+      1) 新しく増える頂点が少ないもの
+      2) 同数なら「メッシュレットの重心に近く、法線が平均法線に揃っている」もの（coneWeight で配分）
+    を 1 つずつ足す。頂点か三角形が上限に達して足せるものが無くなったら閉じる。
+  - 隣接が尽きた（連結成分を使い切った）ら、重心に最も近い未使用の三角形へ飛ぶ（三角形の重心の kd 木）。
+  - 次のメッシュレットは、直前のメッシュレットの縁に残った三角形のうち、周りの残りが最も少ない
+    （= 隅に取り残されそうな）ものから始める。穴あきの細切れを作りにくい。
+  - 頂点番号が重なる（面積を持ちえない）三角形は捨てる。三角形の巻き順は変えない。
+
+境界（MeshletBounds）:
+  - 境界球 …… メッシュレットの頂点位置を囲む球（Ritter 法。最小ではないが数 % 以内）。
+  - 法線コーン …… 面法線（cross(b-a, c-a)。この左手系・CW 表では外向き）の平均を軸とし、
+    軸からの最大の開き角 α について coneCutoff = sin α を持つ。全法線が軸の 90° 以内に
+    収まらない塊はコーン無し（coneCutoff = 1。裏向きで捨てることはない）。
+  - 視点 e から見て dot(c - e, axis) >= coneCutoff × |c - e| + radius × (1 + coneCutoff) なら
+    境界球内のどの点へ向かう視線も全三角形の表の向きと 90° 以上離れる = 全部裏向き。
+
+前提:
+  - Indices は三角形リスト（3 の倍数）で、どの値も Vertices.size() 未満であること。
+    満たさないメッシュは分けない（0 を返し、out は空）。
+  - 頂点/三角形の上限は 3～255 / 1～255（ローカル番号を 8bit で持つため）。範囲外は丸める。
+===============================================================================
+*/
+
+// BuildMeshlets の設定
+struct MeshletLimits
+{
+    std::uint32_t maxVertices = 64;   // 1 メッシュレットの頂点数の上限
+    std::uint32_t maxTriangles = 124; // 1 メッシュレットの三角形数の上限（124 = 4 の倍数で 8bit×3 を詰めやすい）
+    float         coneWeight = 0.25f; // 0 = 空間的なまとまりだけ、1 に近いほど法線の揃い（コーンの細さ）を優先
+};
+
+// メッシュレット 1 つ（MeshletData の配列上の区間）
+struct Meshlet
+{
+    std::uint32_t vertexOffset = 0;   // MeshletData::Vertices 上の先頭
+    std::uint32_t triangleOffset = 0; // MeshletData::Triangles 上の先頭（8bit 値の位置。三角形 t は +3t）
+    std::uint32_t vertexCount = 0;
+    std::uint32_t triangleCount = 0;
+};
+
+// メッシュレット 1 つの境界（カリング用。メッシュのローカル空間）
+struct MeshletBounds
+{
+    DirectX::XMFLOAT3 center{};   // 境界球の中心
+    float             radius = 0.0f;
+    DirectX::XMFLOAT3 coneAxis{}; // 面法線の平均方向（正規化済み）
+    float             coneCutoff = 1.0f; // sin(最大の開き角)。1 以上 = コーン無し
+};
+
+// 1 メッシュ分のメッシュレット（頂点は元の MeshData::Vertices を指す）
+struct MeshletData
+{
+    std::vector<Meshlet>       Meshlets;
+    std::vector<MeshletBounds> Bounds;    // Meshlets と同じ添字
+    std::vector<std::uint32_t> Vertices;  // メッシュレットごとの頂点表（元の頂点番号）
+    std::vector<std::uint8_t>  Triangles; // メッシュレットごとのローカル三角形（頂点表の添字 ×3）
+    std::size_t                IndexCount = 0; // 全メッシュレットの三角形数 × 3
+
+    void Clear()
+    {
+        Meshlets.clear(); Bounds.clear(); Vertices.clear(); Triangles.clear();
+        IndexCount = 0;
+    }
+};
+
+/**
+ * @brief mesh をメッシュレットに分け、境界を計算する（out は上書き）
+ * @return メッシュレット数（前提を満たさない/三角形が無いなら 0）
+ */
+std::size_t BuildMeshlets(const MeshData& mesh, const MeshletLimits& limits, MeshletData& out);
+
+/// meshlet の境界球と法線コーンを求める（vertices は元の MeshData::Vertices）
+MeshletBounds ComputeMeshletBounds(const MeshletData& data, const Meshlet& meshlet, const Vertex* vertices);
+
+/// 複数メッシュのメッシュレットをメッシュ単位で並列に作る（out[i] は meshes[i] の結果。nullptr のメッシュは空）
+void BuildMeshlets(const MeshData* const* meshes, std::size_t count, const MeshletLimits& limits, MeshletData* out);
@@ -0,0 +1,183 @@
+﻿#include "Assets/StaticBatch.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using namespace DirectX;
+
+/*
+    StaticBatch.cpp
+    ----------------------------------------------------------------------------
+    流れ：
+      1) 入力ごとにローカル AABB → ワールド AABB（Arvo）→ 中心のセル座標を求める
+      2) (pipeline, セル) で入力番号を安定ソート
+      3) 同じグループを先頭から詰め、頂点上限を超えそうなら次のチャンクへ
+      4) 頂点は行列の成分を直接掛ける（XMVECTOR の出し入れより速い。1 頂点 9+9 積和）
+    注意：
+      - 行列は XMFLOAT4X4 の行優先（v' = v * M）。第 4 列は 0,0,0,1 を仮定する（アフィン）。
+*/
+
+namespace
+{
+    struct SortEntry
+    {
+        std::uint32_t pipeline;
+        std::int32_t  cx, cy, cz;
+        std::uint32_t input;
+    };
+
+    std::int32_t CellOf(float v, float invSize)
+    {
+        const float c = std::floor(v * invSize);
+        // 極端な座標は端のセルに寄せる（int への変換で未定義にならないように）
+        if (!(c > -1.0e9f)) return -1000000000;
+        if (!(c < 1.0e9f)) return 1000000000;
+        return static_cast<std::int32_t>(c);
+    }
+
+    // 1 入力をワールド空間へ焼き込みながら chunk に追記する
+    void AppendBaked(StaticBatchChunk& chunk, const StaticBatchInput& in)
+    {
+        const MeshData& src = *in.mesh;
+        const XMFLOAT4X4& m = in.world;
+
+        // 法線用：3x3 の逆転置（= 余因子行列 / det）。正規化するので 1/det の大きさは不要、符号だけ使う
+        const float a00 = m._22 * m._33 - m._23 * m._32;
+        const float a01 = m._23 * m._31 - m._21 * m._33;
+        const float a02 = m._21 * m._32 - m._22 * m._31;
+        const float a10 = m._13 * m._32 - m._12 * m._33;
+        const float a11 = m._11 * m._33 - m._13 * m._31;
+        const float a12 = m._12 * m._31 - m._11 * m._32;
+        const float a20 = m._12 * m._23 - m._13 * m._22;
+        const float a21 = m._13 * m._21 - m._11 * m._23;
+        const float a22 = m._11 * m._22 - m._12 * m._21;
+        const float det = m._11 * a00 + m._12 * a01 + m._13 * a02;
+        const float s = (det < 0.0f) ? -1.0f : 1.0f;
+
+        const std::size_t base = chunk.mesh.Vertices.size();
+        chunk.mesh.Vertices.resize(base + src.Vertices.size());
+        Vertex* dst = chunk.mesh.Vertices.data() + base;
+        AABB& box = chunk.bounds;
+
+        for (std::size_t i = 0; i < src.Vertices.size(); ++i)
+        {
+            const Vertex& v = src.Vertices[i];
+            Vertex& o = dst[i];
+
+            const float px = v.Position.x, py = v.Position.y, pz = v.Position.z;
+            o.Position.x = px * m._11 + py * m._21 + pz * m._31 + m._41;
+            o.Position.y = px * m._12 + py * m._22 + pz * m._32 + m._42;
+            o.Position.z = px * m._13 + py * m._23 + pz * m._33 + m._43;
+
+            // n' = n * (M^-1)^T … 行ベクトル規約では余因子行列の転置の各列との内積
+            const float nx = v.Normal.x, ny = v.Normal.y, nz = v.Normal.z;
+            float tx = (nx * a00 + ny * a10 + nz * a20) * s;
+            float ty = (nx * a01 + ny * a11 + nz * a21) * s;
+            float tz = (nx * a02 + ny * a12 + nz * a22) * s;
+            const float len2 = tx * tx + ty * ty + tz * tz;
+            if (len2 > 1e-20f)
+            {
+                const float inv = 1.0f / std::sqrt(len2);
+                tx *= inv; ty *= inv; tz *= inv;
+            }
+            o.Normal = { tx, ty, tz };
+            o.Color = v.Color;
+
+            box.Min.x = std::min(box.Min.x, o.Position.x);
+            box.Min.y = std::min(box.Min.y, o.Position.y);
+            box.Min.z = std::min(box.Min.z, o.Position.z);
+            box.Max.x = std::max(box.Max.x, o.Position.x);
+            box.Max.y = std::max(box.Max.y, o.Position.y);
+            box.Max.z = std::max(box.Max.z, o.Position.z);
+        }
+
+        // インデックスは頂点の先頭位置ぶんずらす。鏡映なら巻き順を入れ替える
+        const unsigned int offset = static_cast<unsigned int>(base);
+        const std::size_t ibase = chunk.mesh.Indices.size();
+        const std::size_t icount = src.Indices.size() - src.Indices.size() % 3;
+        chunk.mesh.Indices.resize(ibase + icount);
+        unsigned int* idst = chunk.mesh.Indices.data() + ibase;
+        const bool flip = det < 0.0f;
+        for (std::size_t t = 0; t < icount; t += 3)
+        {
+            idst[t + 0] = src.Indices[t + 0] + offset;
+            idst[t + 1] = src.Indices[t + (flip ? 2 : 1)] + offset;
+            idst[t + 2] = src.Indices[t + (flip ? 1 : 2)] + offset;
+        }
+        ++chunk.sourceCount;
+    }
+}
+
+void BuildStaticBatches(const StaticBatchInput* inputs, std::size_t count,
+    const StaticBatchSettings& settings, std::vector<StaticBatchChunk>& out)
+{
+    out.clear();
+    if (!inputs || count == 0) return;
+
+    const bool grid = settings.chunkSize > 0.0f;
+    const float invSize = grid ? 1.0f / settings.chunkSize : 0.0f;
+    const std::size_t maxVerts = std::max<std::size_t>(settings.maxVerticesPerChunk, 1);
+
+    // 1) セル座標
+    std::vector<SortEntry> order;
+    order.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const StaticBatchInput& in = inputs[i];
+        if (!in.mesh || in.mesh->Vertices.empty() || in.mesh->Indices.size() < 3) continue;
+
+        SortEntry e{ in.pipeline, 0, 0, 0, static_cast<std::uint32_t>(i) };
+        if (grid)
+        {
+            const AABB box = TransformAABB(ComputeAABB(*in.mesh), XMLoadFloat4x4(&in.world));
+            e.cx = CellOf((box.Min.x + box.Max.x) * 0.5f, invSize);
+            e.cy = CellOf((box.Min.y + box.Max.y) * 0.5f, invSize);
+            e.cz = CellOf((box.Min.z + box.Max.z) * 0.5f, invSize);
+        }
+        order.push_back(e);
+    }
+
+    // 2) (pipeline, セル) で安定ソート
+    std::stable_sort(order.begin(), order.end(), [](const SortEntry& a, const SortEntry& b)
+        {
+            if (a.pipeline != b.pipeline) return a.pipeline < b.pipeline;
+            if (a.cx != b.cx) return a.cx < b.cx;
+            if (a.cy != b.cy) return a.cy < b.cy;
+            return a.cz < b.cz;
+        });
+
+    // 3) グループごとに詰める
+    std::size_t g = 0;
+    while (g < order.size())
+    {
+        std::size_t end = g + 1;
+        while (end < order.size() && order[end].pipeline == order[g].pipeline &&
+            order[end].cx == order[g].cx && order[end].cy == order[g].cy && order[end].cz == order[g].cz)
+            ++end;
+
+        // 先に必要な頂点/インデックス数を数えて、チャンクごとに 1 回だけ確保する
+        std::size_t i = g;
+        while (i < end)
+        {
+            std::size_t verts = 0, indices = 0, last = i;
+            do
+            {
+                const MeshData& m = *inputs[order[last].input].mesh;
+                if (verts > 0 && verts + m.Vertices.size() > maxVerts) break;
+                verts += m.Vertices.size();
+                indices += m.Indices.size();
+                ++last;
+            } while (last < end);
+
+            out.emplace_back();
+            StaticBatchChunk& chunk = out.back();
+            chunk.pipeline = order[g].pipeline;
+            chunk.mesh.Vertices.reserve(verts);
+            chunk.mesh.Indices.reserve(indices);
+            chunk.bounds.Min = { FLT_MAX, FLT_MAX, FLT_MAX };
+            chunk.bounds.Max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+            for (; i < last; ++i) AppendBaked(chunk, inputs[order[i].input]);
+        }
+        g = end;
+    }
+}
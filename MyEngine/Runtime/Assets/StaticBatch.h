@@ -0,0 +1,65 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+#include "Assets/Mesh.h"
+#include "Assets/Bounds.h"
+
+/*
+===============================================================================
+ StaticBatch（静的バッチの構築）
+-------------------------------------------------------------------------------
+目的:
+  - 動かないメッシュ（GameObject::IsStatic）をロード時にワールド空間へ焼き込み、
+    PSO ごと・空間チャンクごとに大きな 1 つの MeshData へ結合する。
+  - 数千個の小さな Draw とオブジェクトごとの行列書き込みを、チャンク数ぶんに減らす。
+  - GPU には依存しない純 CPU コード（VB/IB の作成は D3D12Renderer が行う）。
+
+チャンク分け:
+  - 入力のワールド AABB 中心を一辺 chunkSize の格子に落とし、
+    (pipeline, セル x, y, z) が同じものを 1 チャンクにまとめる。
+    チャンクごとにワールド AABB を持つので、結合後も視錐台/オクルージョンカリングが効く。
+  - 1 チャンクの頂点数が maxVerticesPerChunk を超えそうなら新しいチャンクに分ける
+    （既定 65536 = 16bit インデックスに収まる大きさ）。単体で超えるメッシュはそれだけで 1 チャンク。
+
+焼き込み:
+  - 位置は world、法線は world の逆転置（3x3）で変換して正規化する。
+  - 行列式が負（鏡映）の入力は三角形の巻き順を入れ替えて、表裏がそのまま保たれるようにする。
+  - 出力の順序は入力順に依存しない（pipeline → セル → 入力順で安定に並べる）。
+===============================================================================
+*/
+
+// 1 入力（1 MeshRenderer）
+struct StaticBatchInput
+{
+    const MeshData*     mesh = nullptr; // ローカル空間のメッシュ（呼び出し中は生存していること）
+    DirectX::XMFLOAT4X4 world{};        // ワールド行列（アフィン）
+    std::uint32_t       pipeline = 0;   // PSO/マテリアル番号（違うものは結合しない）
+};
+
+// 構築パラメータ
+struct StaticBatchSettings
+{
+    float       chunkSize = 32.0f;            // 空間チャンクの一辺（ワールド単位）。0 以下なら分割しない
+    std::size_t maxVerticesPerChunk = 65536;  // 1 チャンクの頂点数の上限
+};
+
+// 結合結果の 1 チャンク（そのまま 1 Draw になる）
+struct StaticBatchChunk
+{
+    std::uint32_t pipeline = 0;    // 入力の pipeline
+    MeshData      mesh;            // ワールド空間の頂点 + 結合済みインデックス
+    AABB          bounds;          // ワールド AABB（mesh の全頂点）
+    std::uint32_t sourceCount = 0; // 結合した入力の数
+};
+
+/**
+ * @brief 静的メッシュを焼き込み・結合してチャンクを作る
+ * @param inputs   入力配列（mesh が null / 空のものは無視）
+ * @param count    入力数
+ * @param settings チャンク分けのパラメータ
+ * @param out      出力（clear してから追記）
+ */
+void BuildStaticBatches(const StaticBatchInput* inputs, std::size_t count,
+    const StaticBatchSettings& settings, std::vector<StaticBatchChunk>& out);
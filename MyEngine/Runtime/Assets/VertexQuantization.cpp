@@ -0,0 +1,413 @@
+﻿#include "Assets/VertexQuantization.h"
+#include <cmath>
+#include <cstring>
+#include <emmintrin.h>
+
+using namespace DirectX;
+
+/*
+    VertexQuantization.cpp
+    ----------------------------------------------------------------------------
+    half 変換（ビット演算版。F16C 命令に頼らず SSE2 だけで書ける形）：
+      float → half：
+        - |f| >= 65536 → Inf（f が NaN なら qNaN 0x7E00）
+        - |f| <  2^-14 → 非正規化数。magic（0.5f）を足して FPU の最近接偶数丸めで
+                         仮数 10bit を下位に揃え、magic のビットを引く
+        - それ以外     → 指数を付け替え、仮数の下位 13bit を 0xFFF + 奇数ビットで丸める
+                         （最近接偶数。繰り上がりは指数へそのまま伝わり、65504 超は Inf になる）
+      half → float：
+        - 指数/仮数を 13bit 左へずらして指数を付け替える。Inf/NaN はさらに指数を足し、
+          非正規化数は 1 を足してから magic（2^-14）を引いて正規化する
+      SSE2 版は全分岐を計算してマスクで選ぶ（分岐ごとの値は同じ式なのでスカラ版と一致する）。
+    八面体写像：
+      - n / (|x| + |y| + |z|) で八面体へ射影し、下半球（z < 0）は対角線で折り返して上に重ねる。
+      - 復号は z = 1 - |u| - |v|、z < 0 なら t = -z だけ xy を原点側へ戻して正規化する
+        （HLSL 側 OctDecode と同じ式）。
+    丸め：
+      - SNORM16/UNORM8 への丸めは cvtps_epi32（MXCSR 既定 = 最近接偶数）と std::lrint で揃える。
+      - clamp は (x > lo) ? x : lo の形（maxps と同じ。NaN は下限へ落ちる）。
+*/
+
+namespace
+{
+    std::uint32_t AsUint(float f) { std::uint32_t u; std::memcpy(&u, &f, 4); return u; }
+    float AsFloat(std::uint32_t u) { float f; std::memcpy(&f, &u, 4); return f; }
+
+    template <class T> T Load(const void* base, std::size_t stride, std::size_t i, std::size_t k = 0)
+    {
+        T v;
+        std::memcpy(&v, static_cast<const unsigned char*>(base) + stride * i + sizeof(T) * k, sizeof(T));
+        return v;
+    }
+    template <class T> void Store(void* base, std::size_t stride, std::size_t i, std::size_t k, T v)
+    {
+        std::memcpy(static_cast<unsigned char*>(base) + stride * i + sizeof(T) * k, &v, sizeof(T));
+    }
+
+    float ClampF(float x, float lo, float hi)
+    {
+        x = (x > lo) ? x : lo;
+        return (x < hi) ? x : hi;
+    }
+
+    constexpr std::uint32_t kHalfOne = 0x3C00u; // half の 1.0（位置の w）
+
+    // ---- SSE2 カーネル（4 レーン） ----
+
+    __m128i Select(__m128i mask, __m128i a, __m128i b) // mask ? a : b
+    {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+    __m128 Select(__m128 mask, __m128 a, __m128 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    __m128i FloatToHalf4(__m128 f)
+    {
+        __m128i u = _mm_castps_si128(f);
+        const __m128i sign = _mm_and_si128(u, _mm_set1_epi32(static_cast<int>(0x80000000u)));
+        u = _mm_xor_si128(u, sign);
+
+        // Inf / NaN
+        const __m128i isInfNan = _mm_cmpgt_epi32(u, _mm_set1_epi32(0x477FFFFF));
+        const __m128i isNan = _mm_cmpgt_epi32(u, _mm_set1_epi32(0x7F800000));
+        const __m128i infNan = _mm_or_si128(_mm_set1_epi32(0x7C00), _mm_and_si128(isNan, _mm_set1_epi32(0x0200)));
+
+        // 非正規化数 / 0
+        const __m128i isDenorm = _mm_cmpgt_epi32(_mm_set1_epi32(0x38800000), u);
+        const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32(0x3F000000));
+        const __m128i denorm = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(u), magic)),
+            _mm_set1_epi32(0x3F000000));
+
+        // 正規化数
+        const __m128i mantOdd = _mm_and_si128(_mm_srli_epi32(u, 13), _mm_set1_epi32(1));
+        __m128i normal = _mm_add_epi32(_mm_sub_epi32(u, _mm_set1_epi32(112 << 23)), _mm_set1_epi32(0xFFF));
+        normal = _mm_srli_epi32(_mm_add_epi32(normal, mantOdd), 13);
+
+        __m128i h = Select(isDenorm, denorm, normal);
+        h = Select(isInfNan, infNan, h);
+        return _mm_or_si128(h, _mm_srli_epi32(sign, 16));
+    }
+
+    __m128 HalfToFloat4(__m128i h)
+    {
+        __m128i o = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7FFF)), 13);
+        const __m128i exp = _mm_and_si128(o, _mm_set1_epi32(0x0F800000));
+        o = _mm_add_epi32(o, _mm_set1_epi32(0x38000000));
+
+        const __m128i isInfNan = _mm_cmpeq_epi32(exp, _mm_set1_epi32(0x0F800000));
+        o = _mm_add_epi32(o, _mm_and_si128(isInfNan, _mm_set1_epi32(0x38000000)));
+
+        const __m128i isDenorm = _mm_cmpeq_epi32(exp, _mm_setzero_si128());
+        const __m128 denorm = _mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(o, _mm_set1_epi32(1 << 23))),
+            _mm_castsi128_ps(_mm_set1_epi32(113 << 23)));
+        o = Select(isDenorm, _mm_castps_si128(denorm), o);
+
+        return _mm_castsi128_ps(_mm_or_si128(o, _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16)));
+    }
+
+    __m128 Abs4(__m128 v) { return _mm_and_ps(v, _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF))); }
+
+    // x >= 0 なら +1、それ以外 -1（-0 は +1）
+    __m128 SignNotZero4(__m128 v)
+    {
+        return Select(_mm_cmpge_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f), _mm_set1_ps(-1.0f));
+    }
+}
+
+// ============================================================================
+// スカラ版
+// ============================================================================
+
+std::uint16_t FloatToHalf(float f)
+{
+    std::uint32_t u = AsUint(f);
+    const std::uint32_t sign = u & 0x80000000u;
+    u ^= sign;
+
+    std::uint32_t h;
+    if (u >= 0x47800000u)      // |f| >= 65536（丸めても収まらない）/ Inf / NaN
+    {
+        h = (u > 0x7F800000u) ? 0x7E00u : 0x7C00u;
+    }
+    else if (u < 0x38800000u)  // 非正規化数 / 0
+    {
+        h = AsUint(AsFloat(u) + AsFloat(0x3F000000u)) - 0x3F000000u;
+    }
+    else
+    {
+        const std::uint32_t mantOdd = (u >> 13) & 1u;
+        h = (u - (112u << 23) + 0xFFFu + mantOdd) >> 13;
+    }
+    return static_cast<std::uint16_t>(h | (sign >> 16));
+}
+
+float HalfToFloat(std::uint16_t h)
+{
+    std::uint32_t o = (h & 0x7FFFu) << 13;
+    const std::uint32_t exp = o & 0x0F800000u;
+    o += 0x38000000u;
+    if (exp == 0x0F800000u)  o += 0x38000000u;                                     // Inf / NaN
+    else if (exp == 0)       o = AsUint(AsFloat(o + (1u << 23)) - AsFloat(113u << 23)); // 非正規化数 / 0
+    return AsFloat(o | (static_cast<std::uint32_t>(h & 0x8000u) << 16));
+}
+
+void EncodeOctahedral(const XMFLOAT3& n, std::int16_t out[2])
+{
+    const float s = std::fabs(n.x) + std::fabs(n.y) + std::fabs(n.z);
+    const float inv = (s > 0.0f) ? 1.0f / s : 0.0f;
+    float u = n.x * inv;
+    float v = n.y * inv;
+    if (n.z < 0.0f)
+    {
+        const float fu = (1.0f - std::fabs(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+        const float fv = (1.0f - std::fabs(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+        u = fu;
+        v = fv;
+    }
+    out[0] = static_cast<std::int16_t>(std::lrint(ClampF(u, -1.0f, 1.0f) * 32767.0f));
+    out[1] = static_cast<std::int16_t>(std::lrint(ClampF(v, -1.0f, 1.0f) * 32767.0f));
+}
+
+XMFLOAT3 DecodeOctahedral(const std::int16_t in[2])
+{
+    float u = static_cast<float>(in[0]) / 32767.0f;
+    float v = static_cast<float>(in[1]) / 32767.0f;
+    u = (u > -1.0f) ? u : -1.0f; // SNORM の -32768 は -1 扱い
+    v = (v > -1.0f) ? v : -1.0f;
+    const float z = (1.0f - std::fabs(u)) - std::fabs(v);
+    const float t = (-z > 0.0f) ? -z : 0.0f;
+    u += (u >= 0.0f) ? -t : t;
+    v += (v >= 0.0f) ? -t : t;
+    const float len = std::sqrt(u * u + v * v + z * z);
+    return XMFLOAT3(u / len, v / len, z / len);
+}
+
+std::uint32_t PackUnorm8x4(const XMFLOAT4& c)
+{
+    const float ch[4] = { c.x, c.y, c.z, c.w };
+    std::uint32_t out = 0;
+    for (int i = 0; i < 4; ++i)
+        out |= static_cast<std::uint32_t>(std::lrint(ClampF(ch[i], 0.0f, 1.0f) * 255.0f)) << (8 * i);
+    return out;
+}
+
+XMFLOAT4 UnpackUnorm8x4(std::uint32_t packed)
+{
+    return XMFLOAT4(
+        static_cast<float>(packed & 0xFFu) / 255.0f,
+        static_cast<float>((packed >> 8) & 0xFFu) / 255.0f,
+        static_cast<float>((packed >> 16) & 0xFFu) / 255.0f,
+        static_cast<float>(packed >> 24) / 255.0f);
+}
+
+// ============================================================================
+// 一括版（SSE2。4 要素ずつ SoA に並べ替えて計算し、端数はスカラ版）
+// ============================================================================
+
+void EncodeHalf3(const void* src, std::size_t srcStride, void* dst, std::size_t dstStride, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 c[3];
+        for (int k = 0; k < 3; ++k)
+            c[k] = _mm_setr_ps(Load<float>(src, srcStride, i, k), Load<float>(src, srcStride, i + 1, k),
+                Load<float>(src, srcStride, i + 2, k), Load<float>(src, srcStride, i + 3, k));
+        const __m128i xy = _mm_or_si128(FloatToHalf4(c[0]), _mm_slli_epi32(FloatToHalf4(c[1]), 16));
+        const __m128i zw = _mm_or_si128(FloatToHalf4(c[2]), _mm_set1_epi32(static_cast<int>(kHalfOne << 16)));
+        const __m128i lo = _mm_unpacklo_epi32(xy, zw); // 頂点 0, 1 の 8B ずつ
+        const __m128i hi = _mm_unpackhi_epi32(xy, zw); // 頂点 2, 3
+        unsigned char* d = static_cast<unsigned char*>(dst) + dstStride * i;
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(d), lo);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(d + dstStride), _mm_srli_si128(lo, 8));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(d + dstStride * 2), hi);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(d + dstStride * 3), _mm_srli_si128(hi, 8));
+    }
+    for (; i < count; ++i)
+    {
+        for (int k = 0; k < 3; ++k)
+            Store<std::uint16_t>(dst, dstStride, i, k, FloatToHalf(Load<float>(src, srcStride, i, k)));
+        Store<std::uint16_t>(dst, dstStride, i, 3, static_cast<std::uint16_t>(kHalfOne));
+    }
+}
+
+void DecodeHalf3(const void* src, std::size_t srcStride, void* dst, std::size_t dstStride, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        alignas(16) float c[3][4];
+        for (int k = 0; k < 3; ++k)
+        {
+            const __m128i h = _mm_setr_epi32(Load<std::uint16_t>(src, srcStride, i, k), Load<std::uint16_t>(src, srcStride, i + 1, k),
+                Load<std::uint16_t>(src, srcStride, i + 2, k), Load<std::uint16_t>(src, srcStride, i + 3, k));
+            _mm_store_ps(c[k], HalfToFloat4(h));
+        }
+        for (int j = 0; j < 4; ++j)
+            for (int k = 0; k < 3; ++k) Store<float>(dst, dstStride, i + j, k, c[k][j]);
+    }
+    for (; i < count; ++i)
+        for (int k = 0; k < 3; ++k)
+            Store<float>(dst, dstStride, i, k, HalfToFloat(Load<std::uint16_t>(src, srcStride, i, k)));
+}
+
+void EncodeOctahedralSnorm16(const void* src, std::size_t srcStride, void* dst, std::size_t dstStride, std::size_t count)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    const __m128 scale = _mm_set1_ps(32767.0f);
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 c[3];
+        for (int k = 0; k < 3; ++k)
+            c[k] = _mm_setr_ps(Load<float>(src, srcStride, i, k), Load<float>(src, srcStride, i + 1, k),
+                Load<float>(src, srcStride, i + 2, k), Load<float>(src, srcStride, i + 3, k));
+
+        const __m128 s = _mm_add_ps(_mm_add_ps(Abs4(c[0]), Abs4(c[1])), Abs4(c[2]));
+        const __m128 inv = _mm_and_ps(_mm_cmpgt_ps(s, zero), _mm_div_ps(one, s));
+        __m128 u = _mm_mul_ps(c[0], inv);
+        __m128 v = _mm_mul_ps(c[1], inv);
+
+        // 下半球は対角線で折り返す
+        const __m128 fu = _mm_mul_ps(_mm_sub_ps(one, Abs4(v)), SignNotZero4(u));
+        const __m128 fv = _mm_mul_ps(_mm_sub_ps(one, Abs4(u)), SignNotZero4(v));
+        const __m128 lower = _mm_cmplt_ps(c[2], zero);
+        u = Select(lower, fu, u);
+        v = Select(lower, fv, v);
+
+        u = _mm_min_ps(_mm_max_ps(u, minusOne), one);
+        v = _mm_min_ps(_mm_max_ps(v, minusOne), one);
+        const __m128i iu = _mm_cvtps_epi32(_mm_mul_ps(u, scale));
+        const __m128i iv = _mm_cvtps_epi32(_mm_mul_ps(v, scale));
+        const __m128i packed = _mm_or_si128(_mm_and_si128(iu, _mm_set1_epi32(0xFFFF)), _mm_slli_epi32(iv, 16));
+
+        alignas(16) std::uint32_t out[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(out), packed);
+        for (int j = 0; j < 4; ++j) Store<std::uint32_t>(dst, dstStride, i + j, 0, out[j]);
+    }
+    for (; i < count; ++i)
+    {
+        const XMFLOAT3 n(Load<float>(src, srcStride, i, 0), Load<float>(src, srcStride, i, 1), Load<float>(src, srcStride, i, 2));
+        std::int16_t e[2];
+        EncodeOctahedral(n, e);
+        Store<std::int16_t>(dst, dstStride, i, 0, e[0]);
+        Store<std::int16_t>(dst, dstStride, i, 1, e[1]);
+    }
+}
+
+void DecodeOctahedralSnorm16(const void* src, std::size_t srcStride, void* dst, std::size_t dstStride, std::size_t count)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    const __m128 scale = _mm_set1_ps(32767.0f);
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i e = _mm_setr_epi32(
+            static_cast<int>(Load<std::uint32_t>(src, srcStride, i)), static_cast<int>(Load<std::uint32_t>(src, srcStride, i + 1)),
+            static_cast<int>(Load<std::uint32_t>(src, srcStride, i + 2)), static_cast<int>(Load<std::uint32_t>(src, srcStride, i + 3)));
+        // 下位 16bit / 上位 16bit を符号拡張
+        const __m128i eu = _mm_srai_epi32(_mm_slli_epi32(e, 16), 16);
+        const __m128i ev = _mm_srai_epi32(e, 16);
+
+        __m128 u = _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(eu), scale), minusOne);
+        __m128 v = _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(ev), scale), minusOne);
+        const __m128 z = _mm_sub_ps(_mm_sub_ps(one, Abs4(u)), Abs4(v));
+        const __m128 t = _mm_max_ps(_mm_sub_ps(zero, z), zero);
+        u = _mm_add_ps(u, Select(_mm_cmpge_ps(u, zero), _mm_sub_ps(zero, t), t));
+        v = _mm_add_ps(v, Select(_mm_cmpge_ps(v, zero), _mm_sub_ps(zero, t), t));
+        const __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(u, u), _mm_mul_ps(v, v)), _mm_mul_ps(z, z)));
+
+        alignas(16) float c[3][4];
+        _mm_store_ps(c[0], _mm_div_ps(u, len));
+        _mm_store_ps(c[1], _mm_div_ps(v, len));
+        _mm_store_ps(c[2], _mm_div_ps(z, len));
+        for (int j = 0; j < 4; ++j)
+            for (int k = 0; k < 3; ++k) Store<float>(dst, dstStride, i + j, k, c[k][j]);
+    }
+    for (; i < count; ++i)
+    {
+        const std::int16_t e[2] = { Load<std::int16_t>(src, srcStride, i, 0), Load<std::int16_t>(src, srcStride, i, 1) };
+        const XMFLOAT3 n = DecodeOctahedral(e);
+        Store<float>(dst, dstStride, i, 0, n.x);
+        Store<float>(dst, dstStride, i, 1, n.y);
+        Store<float>(dst, dstStride, i, 2, n.z);
+    }
+}
+
+void EncodeUnorm8x4(const void* src, std::size_t srcStride, void* dst, std::size_t dstStride, std::size_t count)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(255.0f);
+    auto quantize = [&](std::size_t j)
+        {
+            const __m128 c = _mm_loadu_ps(reinterpret_cast<const float*>(static_cast<const unsigned char*>(src) + srcStride * j));
+            return _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(c, zero), one), scale));
+        };
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // 4 色 × RGBA の int32 を 16bit → 8bit へ飽和パック（値は 0..255 に収まっている）
+        const __m128i c01 = _mm_packs_epi32(quantize(i), quantize(i + 1));
+        const __m128i c23 = _mm_packs_epi32(quantize(i + 2), quantize(i + 3));
+        alignas(16) std::uint32_t out[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(c01, c23));
+        for (int j = 0; j < 4; ++j) Store<std::uint32_t>(dst, dstStride, i + j, 0, out[j]);
+    }
+    for (; i < count; ++i)
+    {
+        const XMFLOAT4 c(Load<float>(src, srcStride, i, 0), Load<float>(src, srcStride, i, 1),
+            Load<float>(src, srcStride, i, 2), Load<float>(src, srcStride, i, 3));
+        Store<std::uint32_t>(dst, dstStride, i, 0, PackUnorm8x4(c));
+    }
+}
+
+void DecodeUnorm8x4(const void* src, std::size_t srcStride, void* dst, std::size_t dstStride, std::size_t count)
+{
+    const __m128 scale = _mm_set1_ps(255.0f);
+    const __m128i zero = _mm_setzero_si128();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const __m128i b = _mm_cvtsi32_si128(static_cast<int>(Load<std::uint32_t>(src, srcStride, i)));
+        const __m128i w = _mm_unpacklo_epi16(_mm_unpacklo_epi8(b, zero), zero);
+        const __m128 c = _mm_div_ps(_mm_cvtepi32_ps(w), scale);
+        _mm_storeu_ps(reinterpret_cast<float*>(static_cast<unsigned char*>(dst) + dstStride * i), c);
+    }
+}
+
+void CopyFloat3(const void* src, std::size_t srcStride, void* dst, std::size_t dstStride, std::size_t count)
+{
+    const unsigned char* s = static_cast<const unsigned char*>(src);
+    unsigned char* d = static_cast<unsigned char*>(dst);
+    auto load = [&](std::size_t j) { return _mm_loadu_ps(reinterpret_cast<const float*>(s + srcStride * j)); };
+
+    std::size_t i = 0;
+    if (dstStride == 3 * sizeof(float))
+    {
+        // 詰めた float3 ×4 = 48B を 16B ×3 にまとめて書く。16B 読みは要素の後ろ 4B まではみ出すので、
+        // 最後の要素は SIMD で読まない（i + 4 < count）
+        for (; i + 4 < count; i += 4)
+        {
+            const __m128 a = load(i), b = load(i + 1), c = load(i + 2), e = load(i + 3);
+            const __m128 ab = _mm_shuffle_ps(b, a, _MM_SHUFFLE(2, 2, 0, 0));           // b0 b0 a2 a2
+            const __m128 o0 = _mm_shuffle_ps(a, ab, _MM_SHUFFLE(0, 2, 1, 0));          // a0 a1 a2 b0
+            const __m128 o1 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 0, 2, 1));           // b1 b2 c0 c1
+            const __m128 ce = _mm_shuffle_ps(c, e, _MM_SHUFFLE(0, 0, 2, 2));           // c2 c2 e0 e0
+            const __m128 o2 = _mm_shuffle_ps(ce, e, _MM_SHUFFLE(2, 1, 2, 0));          // c2 e0 e1 e2
+            float* out = reinterpret_cast<float*>(d + dstStride * i);
+            _mm_storeu_ps(out, o0);
+            _mm_storeu_ps(out + 4, o1);
+            _mm_storeu_ps(out + 8, o2);
+        }
+    }
+    for (; i < count; ++i) std::memcpy(d + dstStride * i, s + srcStride * i, 3 * sizeof(float));
+}
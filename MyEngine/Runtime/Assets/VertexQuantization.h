@@ -0,0 +1,56 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <DirectXMath.h>
+
+/*
+===============================================================================
+ VertexQuantization（頂点属性の量子化）
+-------------------------------------------------------------------------------
+目的:
+  - CPU 側の Vertex（float）を GPU 用の小さな形式へ詰める／戻すための変換を提供する。
+      位置 : float3 → half4（R16G16B16A16_FLOAT、w = 1）
+      法線 : float3 → 八面体写像 + SNORM16 ×2（R16G16_SNORM）
+      色   : float4 → UNORM8 ×4（R8G8B8A8_UNORM）
+      （位置を float のまま使う形式では CopyFloat3 で AoS の Vertex から詰めた配列へ写すだけ）
+  - VertexFormat.h の要素記述子が、頂点配列の一括変換にここの関数を使う。
+
+スカラ版と一括版:
+  - スカラ版（FloatToHalf など）は基準実装。一括版（Encode* / Decode*）は SSE2 で 4 要素ずつ
+    同じ式を計算し、端数はスカラ版で処理する。丸めまで同じなので結果はビット単位で一致する。
+  - 一括版は「先頭要素へのポインタ + バイトストライド」で受ける（AoS の Vertex から直接詰められる）。
+
+誤差（往復 Decode(Encode(x)) の上限）:
+  - half      : 正規化数の範囲（|x| ∈ [2^-14, 65504]）で相対誤差 2^-11 以下（最近接偶数丸め）。
+                65504 を超える値は Inf、NaN は NaN のまま。
+  - 八面体    : 単位法線の角度誤差はおよそ 0.005° 以下（SNORM16 の刻み 1/32767 に相当）。
+                長さ 0 の法線は (0, 0, 1) になる。
+  - UNORM8    : [0, 1] で絶対誤差 0.5/255 以下。範囲外は 0/1 に飽和、NaN は 0。
+===============================================================================
+*/
+
+// ---- スカラ版（基準実装） ----------------------------------------------------
+
+std::uint16_t FloatToHalf(float f);        // 最近接偶数丸め。範囲外は ±Inf、NaN は qNaN
+float         HalfToFloat(std::uint16_t h);
+
+void              EncodeOctahedral(const DirectX::XMFLOAT3& n, std::int16_t out[2]); // n は正規化済みを想定
+DirectX::XMFLOAT3 DecodeOctahedral(const std::int16_t in[2]);                       // 正規化して返す
+
+std::uint32_t     PackUnorm8x4(const DirectX::XMFLOAT4& c);  // R が最下位バイト（R8G8B8A8 のメモリ順）
+DirectX::XMFLOAT4 UnpackUnorm8x4(std::uint32_t packed);
+
+// ---- 一括版（SSE2） ----------------------------------------------------------
+//  src/dst は先頭要素へのポインタ、stride は要素間のバイト数。src と dst は重ならないこと。
+
+void EncodeHalf3(const void* src, std::size_t srcStride, void* dst, std::size_t dstStride, std::size_t count); // float3 → half4（w = 1）
+void DecodeHalf3(const void* src, std::size_t srcStride, void* dst, std::size_t dstStride, std::size_t count); // half4 → float3（w は捨てる）
+
+void EncodeOctahedralSnorm16(const void* src, std::size_t srcStride, void* dst, std::size_t dstStride, std::size_t count); // float3 → int16 ×2
+void DecodeOctahedralSnorm16(const void* src, std::size_t srcStride, void* dst, std::size_t dstStride, std::size_t count); // int16 ×2 → float3
+
+void EncodeUnorm8x4(const void* src, std::size_t srcStride, void* dst, std::size_t dstStride, std::size_t count); // float4 → uint32
+void DecodeUnorm8x4(const void* src, std::size_t srcStride, void* dst, std::size_t dstStride, std::size_t count); // uint32 → float4
+
+// float3 をそのまま写す（量子化しない位置ストリーム用）。dstStride == 12（詰めた配列）なら 4 要素ずつ SSE で書く
+void CopyFloat3(const void* src, std::size_t srcStride, void* dst, std::size_t dstStride, std::size_t count);
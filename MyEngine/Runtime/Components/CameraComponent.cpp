@@ -6,19 +6,19 @@
 /*
     CameraComponent
     ----------------------------------------------------------------------------
-    F
-      - Q[́u_v\R|[lgB
-      - GameObject  TransformComponentiʒu/]/XP[j
-        t[ View sXVB
-      - p(FOV)/AXyNg/jAEt@[Nbv Projection s𐶐EێB
-    g̓T^F
-      -  FOV/Aspect/Near/Far n  UpdateProjectionMatrix() ŌĂ΂B
-      - Update()  Transform ǂ݁ALookTo  View XViJ̌ Transform ɏ]jB
-      - OCӂ View 𒼐ڐݒ肵ꍇ SetView() gB
+    役割：
+      - ゲーム内の「視点」を表すコンポーネント。
+      - GameObject が持つ TransformComponent（位置/回転/スケール）から
+        毎フレーム View 行列を更新する。
+      - 視野角(FOV)/アスペクト比/ニア・ファークリップから Projection 行列を生成・保持する。
+    使い方の典型：
+      - 初期化時に FOV/Aspect/Near/Far を渡す → UpdateProjectionMatrix() が内部で呼ばれる。
+      - Update() は Transform を読み、LookTo で View を更新する（カメラの向きは Transform に従う）。
+      - もし外部から任意の View を直接設定したい場合は SetView() を使う。
 */
 
 // =============================
-// RXgN^
+// コンストラクタ
 // =============================
 CameraComponent::CameraComponent(GameObject* owner, float fov, float aspect, float nearZ, float farZ)
     : Component(ComponentType::Camera)
@@ -28,31 +28,31 @@ CameraComponent::CameraComponent(GameObject* owner, float fov, float aspect, flo
     , m_NearZ(nearZ)
     , m_FarZ(farZ)
 {
-    //  Projection Ăi`ŒɎQƉ\Ɂj
+    // 生成直後に Projection を作っておく（描画で直ちに参照可能に）
     UpdateProjectionMatrix();
 
-    // View ͈U IdentityiTransform ɂ Update() ōXVj
+    // View は一旦 Identity（Transform により Update() で更新される）
     m_View = DirectX::XMMatrixIdentity();
 }
 
 // =============================
-// CtTCÑtbNifobOÔ݁j
+// ライフサイクルのフック（デバッグログのみ）
 // =============================
 void CameraComponent::OnEnable() { OutputDebugStringA("CameraComponent: OnEnable\n"); }
 void CameraComponent::OnDisable() { OutputDebugStringA("CameraComponent: OnDisable\n"); }
 void CameraComponent::OnDestroy() { OutputDebugStringA("CameraComponent: OnDestroy\n"); }
 
 // =============================
-// Update : Transform  View XV
+// Update : Transform から View を更新
 // =============================
 void CameraComponent::Update(float /*deltaTime*/)
 {
     auto transform = m_Owner->GetComponent<TransformComponent>();
-    if (!transform) return; // Transform ȂJ͍̌XVs\
+    if (!transform) return; // Transform が無いならカメラの向きは更新不能
 
-    // ʒu
+    // 位置
     DirectX::XMVECTOR pos = DirectX::XMLoadFloat3(&transform->Position);
-    // O^iTransform ̉]Zoj
+    // 前方向／上方向（Transform 側の回転から算出）
     DirectX::XMVECTOR forward = transform->GetForwardVector();
     DirectX::XMVECTOR up = transform->GetUpVector();
 
@@ -60,20 +60,20 @@ void CameraComponent::Update(float /*deltaTime*/)
 }
 
 // =============================
-// es̍XViLHj
+// 投影行列の更新（LH）
 // =============================
 void CameraComponent::UpdateProjectionMatrix()
 {
     m_Projection = DirectX::XMMatrixPerspectiveFovLH(
-        DirectX::XMConvertToRadians(m_FOV), // FOV[deg]  [rad]
-        m_Aspect,                           // ʂ̉/c
-        m_NearZ,                            // jANbv
-        m_FarZ                              // t@[Nbv
+        DirectX::XMConvertToRadians(m_FOV), // FOV[deg] → [rad]
+        m_Aspect,                           // 画面の横/縦
+        m_NearZ,                            // ニアクリップ
+        m_FarZ                              // ファークリップ
     );
 }
 
 // =============================
-// View s̍XViLookToLHj
+// View 行列の更新（LookToLH）
 // =============================
 void CameraComponent::UpdateViewMatrix(const DirectX::XMVECTOR& position,
     const DirectX::XMVECTOR& forward,
@@ -83,7 +83,7 @@ void CameraComponent::UpdateViewMatrix(const DirectX::XMVECTOR& position,
 }
 
 // =============================
-// View 𒼐ڎwiLookToLHj
+// View を直接指定（LookToLH）
 // =============================
 void CameraComponent::SetView(const DirectX::XMVECTOR& position,
     const DirectX::XMVECTOR& forward,
@@ -6,153 +6,153 @@
 #include <DirectXMath.h>
 #include "Component.h"
 
-// 
-// Forward Declarationsiheavy include ărhԒZkj
-// 
+// ─────────────────────────────────────────────────────────────────────────────
+// Forward Declarations（heavy include を避けてビルド時間短縮）
+// ─────────────────────────────────────────────────────────────────────────────
 class GameObject;
 class CameraComponent;
 class TransformComponent;
 
 // ============================================================================
 // CameraInputState
-//  - 1t[ɂ͂́ghXibvVbgƂďWB
-//  - Update ̐擪 ReadInput() ɂ\z  enh֒lnB
-//  - u͎擾vƁu샍WbNv𕪗āAfobOeXgeՂɂB
+//  - 1フレームにおける入力の“事実”をスナップショットとして集約。
+//  - Update の先頭で ReadInput() により構築 → 各ハンドラへ値渡し。
+//  - 「入力取得」と「動作ロジック」を分離して、デバッグやテストを容易にする。
 // ============================================================================
 struct CameraInputState
 {
-    //  Buttons / Modifiers 
-    bool  lmb = false;  // Left Mouse Button   c I[rbgiAlt pj
-    bool  mmb = false;  // Middle Mouse Button c p
-    bool  rmb = false;  // Right Mouse Button  c tCi]{ړj
-    bool  alt = false;  // Alt                 c I[rbg/h[̏CL[
-    bool  ctrl = false;  // Ctrl                c tCړ̉CL[
-
-    //  Mouse delta / Wheel 
-    float dx = 0.0f; // }EXړ Xipx / framej  +:E / -:
-    float dy = 0.0f; // }EXړ Yipx / framej  +: / -:iWin j
-    float wheel = 0.0f; // XN[ʁiˑF+O / - zj
+    // ── Buttons / Modifiers ────────────────────────
+    bool  lmb = false;  // Left Mouse Button   … オービット（Alt 併用時）
+    bool  mmb = false;  // Middle Mouse Button … パン
+    bool  rmb = false;  // Right Mouse Button  … フライ（回転＋移動）
+    bool  alt = false;  // Alt                 … オービット/ドリーの修飾キー
+    bool  ctrl = false;  // Ctrl                … フライ移動の加速修飾キー
+
+    // ── Mouse delta / Wheel ────────────────────────
+    float dx = 0.0f; // マウス移動量 X（px / frame）  +:右 / -:左
+    float dy = 0.0f; // マウス移動量 Y（px / frame）  +:下 / -:上（※Win 準拠）
+    float wheel = 0.0f; // スクロール量（実装依存：+前 / -後 を想定）
 };
 
 // ============================================================================
 // CameraTuning
-//  - ׂĂ̊xExӏɏWBOUI̒eՁB
-//  - PʁFlookSpeed  gx/pxhA g[hP/px or bhB
+//  - すべての感度・速度を一箇所に集約。外部UIからの調整も容易。
+//  - 単位：lookSpeed は “度/px”、他は “ワールド単位/px or 秒”。
 // ============================================================================
 struct CameraTuning
 {
-    float lookSpeed = 0.15f; // ]xix/pxj
-    float panSpeed = 0.01f; // pxi[h/pxj
-    float dollySpeed = 0.10f; // Alt+RMB h[xi/pxj
-    float wheelSpeed = 0.50f; // zC[h[i/mb`j
-    float flySpeed = 3.0f;  // tC{xiunits/secj
-    float flyBoost = 3.0f;  // Ctrl ł̉{
+    float lookSpeed = 0.15f; // 視線回転感度（度/px）
+    float panSpeed = 0.01f; // パン速度（ワールド/px）
+    float dollySpeed = 0.10f; // Alt+RMB ドリー感度（距離/px）
+    float wheelSpeed = 0.50f; // ホイールドリー（距離/ノッチ）
+    float flySpeed = 3.0f;  // フライ基本速度（units/sec）
+    float flyBoost = 3.0f;  // Ctrl での加速倍率
 };
 
 // ============================================================================
 // CameraControllerComponent
-//  - Unity CNȃt[J񋟂R|[lgB
-//  - Transform 𒼐ڏiCamera  Transform  View gޑzjB
-//  - nEIC[pidegjFRotation = {Pitch(X), Yaw(Y), Roll(Z)} ̗pB
-//  - ImGui }EXLiio.WantCaptureMouse==truej͈ؑ삵ȂB
+//  - Unity ライクなフリーカメラ操作を提供するコンポーネント。
+//  - Transform を直接書き換え（Camera は Transform から View を組む想定）。
+//  - 左手系・オイラー角（deg）：Rotation = {Pitch(X), Yaw(Y), Roll(Z)} を採用。
+//  - ImGui がマウスを占有中（io.WantCaptureMouse==true）は一切操作しない。
 // ----------------------------------------------------------------------------
-// yꗗiUnitẙojz
-//   }EXF
-//     EMMBi{^j+hbO    c piEE㉺j
-//     ERMBiE{^j+hbO    c _̉]itC[hj
-//     EAlt + LMBi{^j+hbO c I[rbgiʒ_𒆐Sɉ]j
-//     EzC[                     c h[iOړGFOVł͂Ȃʒuړj
-//   L[itC = RMBɗLj:
-//     EW / S  c Oi / ށi[J forwardj
-//     EA / D  c  / Ei[J rightj
-//     EQ / E  c ~ / ㏸i[h upj
-//     ECtrl   c xu[XgiflyBoost {j
+// 【操作一覧（Unity準拠の感覚）】
+//   マウス：
+//     ・MMB（中ボタン）+ドラッグ    … パン（左右・上下）
+//     ・RMB（右ボタン）+ドラッグ    … 視点の回転（フライモード）
+//     ・Alt + LMB（左ボタン）+ドラッグ … オービット（画面中央＝注視点を中心に回転）
+//     ・ホイール                     … ドリー（前後移動；FOVではなく位置移動）
+//   キー（フライ中 = RMB押下中に有効）:
+//     ・W / S  … 前進 / 後退（ローカル forward）
+//     ・A / D  … 左 / 右（ローカル right）
+//     ・Q / E  … 下降 / 上昇（ワールド up）
+//     ・Ctrl   … 速度ブースト（flyBoost 倍）
 // ----------------------------------------------------------------------------
-// yt[ziet[j
-//   1) ͂ ReadInput() ŃXibvVbg
-//   2) [hDxɏip  I[rbg  h[  zC[  tCj
-//       ǂꂩ̃[h炻̃t[ returnih~j
+// 【処理フロー】（各フレーム）
+//   1) 入力を ReadInput() でスナップショット化
+//   2) モード優先度順に処理（パン → オービット → ドリー → ホイール → フライ）
+//      ※ どれかのモードが動いたらそのフレームは return（競合防止）
 // ----------------------------------------------------------------------------
-// y݌vz
-//   Égpԁhۂh߁At[͎pύXȂ
-//     i*JustStarted tOŃXLbv / _ Transform ۑjB
-//   EE/㉺̔] HandleOrbit / HandleFly  yaw/pitch vZ̕Œ\B
+// 【設計メモ】
+//   ・押下直後の“姿勢が跳ぶ”現象を防ぐため、押したフレームは姿勢を変更しない
+//     （*JustStarted フラグでスキップ / 押下時点の Transform を保存＆即時復元）。
+//   ・左右/上下の反転は HandleOrbit / HandleFly の yaw/pitch 計算の符号で調整可能。
 // ============================================================================
 class CameraControllerComponent : public Component
 {
 public:
-    // 
+    // ─────────────────────────────────────────────────────────────────────
     // ctor
-    //   @owner  : {R|[lgڂ GameObjectiTransform LbVj
-    //   @camera : ΏۃJiFOV ̎QƗpBp Transform j
-    // 
+    //   @owner  : 本コンポーネントを載せる GameObject（Transform をキャッシュ）
+    //   @camera : 操作対象カメラ（FOV 等の参照用。姿勢は Transform が主）
+    // ─────────────────────────────────────────────────────────────────────
     CameraControllerComponent(GameObject* owner, CameraComponent* camera);
 
-    // 
-    // Updateit[j
-    //   1) ͎WiReadInputj
-    //   2) D揇[hipI[rbgh[zC[tCj
-    //   3) ǂꂩ瑁 returni[hh~j
-    // 
+    // ─────────────────────────────────────────────────────────────────────
+    // Update（毎フレーム）
+    //   1) 入力収集（ReadInput）
+    //   2) 優先順モード処理（パン→オービット→ドリー→ホイール→フライ）
+    //   3) どれかが処理したら早期 return（モード競合防止）
+    // ─────────────────────────────────────────────────────────────────────
     void Update(float deltaTime) override;
 
-    // fobOOpiCӁj
+    // デバッグログ用（任意）
     void OnEnable() override;
     void OnDisable() override;
 
-    // 
-    // Tuning ANZXiOUI犴xEx𒲐ꍇɁj
-    // 
+    // ─────────────────────────────────────────────────────────────────────
+    // Tuning アクセス（外部UIから感度・速度を調整したい場合に）
+    // ─────────────────────────────────────────────────────────────────────
     CameraTuning& Tuning() { return m_cfg; }
     const CameraTuning& Tuning() const { return m_cfg; }
 
 private:
-    // === ͂̃XibvVbg =================================================
+    // === 入力のスナップショット化 =================================================
     CameraInputState ReadInput() const;
 
-    // === e[hitrue Ԃ獡t[͏j====================
-    bool HandlePan(const CameraInputState& in);           // MMBFʕsړ
-    bool HandleOrbit(const CameraInputState& in);           // Alt+LMBF_S̉]
-    bool HandleDolly(const CameraInputState& in);           // Alt+RMBF_܂ł̋ύX
-    bool HandleWheel(const CameraInputState& in);           // WheelFOh[
-    bool HandleFly(const CameraInputState& in, float dt); // RMB(+WASD/QE)FtC
+    // === 各モード処理（true を返したら今フレームは処理完了）====================
+    bool HandlePan(const CameraInputState& in);           // MMB：画面平行移動
+    bool HandleOrbit(const CameraInputState& in);           // Alt+LMB：注視点中心の回転
+    bool HandleDolly(const CameraInputState& in);           // Alt+RMB：注視点までの距離変更
+    bool HandleWheel(const CameraInputState& in);           // Wheel：前後ドリー
+    bool HandleFly(const CameraInputState& in, float dt); // RMB(+WASD/QE)：フライ
 
 private:
-    //  Orbit pԁiAlt+LMBj
-    bool                  m_prevAltLmb = false;           // Alt+LMB ̑Ot[
-    bool                  m_orbitActive = false;           // I[rbg
-    bool                  m_orbitJustStarted = false;           // 1F͌ڌŒ
-    DirectX::XMFLOAT3     m_orbitPivot = { 0,0,0 };         // ]̒SiŒj
-    float                 m_orbitYaw0 = 0.0f;            // ̊ Yawidegj
-    float                 m_orbitPitch0 = 0.0f;            // ̊ Pitchidegj
-    float                 m_orbitAccX = 0.0f;            // ȍ~̗݌vhbO X
-    float                 m_orbitAccY = 0.0f;            // ȍ~̗݌vhbO Y
-
-    //  Fly pԁiRMBj
-    bool                  m_flyPrevRmb = false;           // RMB ̑Ot[
-    bool                  m_flyJustStarted = false;           // 1F͌ڌŒ
-    float                 m_flyYaw0 = 0.0f;            // ̊ Yawidegj
-    float                 m_flyPitch0 = 0.0f;            // ̊ Pitchidegj
-    float                 m_flyAccX = 0.0f;            // ȍ~̗݌vhbO X
-    float                 m_flyAccY = 0.0f;            // ȍ~̗݌vhbO Y
-
-    //   Transform obNAbviguԂɎpԁh΍j
-    DirectX::XMFLOAT3     m_pressPos{};                         //  Position
-    DirectX::XMFLOAT3     m_pressRot{};                         //  RotationiPitch,Yaw,Rollj
+    // ── Orbit 用内部状態（Alt+LMB）───────────────────────────────────────
+    bool                  m_prevAltLmb = false;           // Alt+LMB の前フレーム状態
+    bool                  m_orbitActive = false;           // オービット中
+    bool                  m_orbitJustStarted = false;           // 押下直後1Fは見た目固定
+    DirectX::XMFLOAT3     m_orbitPivot = { 0,0,0 };         // 回転の中心（固定）
+    float                 m_orbitYaw0 = 0.0f;            // 押下時の基準 Yaw（deg）
+    float                 m_orbitPitch0 = 0.0f;            // 押下時の基準 Pitch（deg）
+    float                 m_orbitAccX = 0.0f;            // 押下以降の累計ドラッグ X
+    float                 m_orbitAccY = 0.0f;            // 押下以降の累計ドラッグ Y
+
+    // ── Fly 用内部状態（RMB）───────────────────────────────────────────
+    bool                  m_flyPrevRmb = false;           // RMB の前フレーム状態
+    bool                  m_flyJustStarted = false;           // 押下直後1Fは見た目固定
+    float                 m_flyYaw0 = 0.0f;            // 押下時の基準 Yaw（deg）
+    float                 m_flyPitch0 = 0.0f;            // 押下時の基準 Pitch（deg）
+    float                 m_flyAccX = 0.0f;            // 押下以降の累計ドラッグ X
+    float                 m_flyAccY = 0.0f;            // 押下以降の累計ドラッグ Y
+
+    // ── 押下時の Transform バックアップ（“押した瞬間に姿勢が飛ぶ”対策）──────────
+    DirectX::XMFLOAT3     m_pressPos{};                         // 押下時の Position
+    DirectX::XMFLOAT3     m_pressRot{};                         // 押下時の Rotation（Pitch,Yaw,Roll）
 
 private:
-    //  OQƐiL͂Ȃj
-    CameraComponent* m_Camera = nullptr; // ΏۃJ
-    TransformComponent* m_Transform = nullptr; // pXV Transform
+    // ── 外部参照先（所有はしない）────────────────────────────────────────
+    CameraComponent* m_Camera = nullptr; // 操作対象カメラ
+    TransformComponent* m_Transform = nullptr; // 姿勢を更新する Transform
 
-    //  pp[^ideg⋗j
-    float                 m_Yaw = 0.0f;    // ]idegj
-    float                 m_Pitch = 0.0f;    // ]idegj }89 ɃNv
-    float                 m_OrbitDist = 5.0f;    // I[rbgipivot ̋j
+    // ── 姿勢パラメータ（degや距離）──────────────────────────────────────
+    float                 m_Yaw = 0.0f;    // 水平回転（deg）
+    float                 m_Pitch = 0.0f;    // 垂直回転（deg）※実装側で ±89° にクランプ
+    float                 m_OrbitDist = 5.0f;    // オービット距離（pivot からの距離）
 
-    // Transform  pxKvȂ痘pigpłj
+    // Transform → 角度同期が必要なら利用（未使用でも可）
     bool                  m_InitSynced = false;
 
-    //  xEx̃`[jOl 
+    // ── 感度・速度のチューニング値 ───────────────────────────────────────
     CameraTuning          m_cfg{};
 };
@@ -1,3 +1,3 @@
 #include "Component.h"
-// cpp ł SetOwner ͕svɂȂ܂
-// inline Ńwb_ɏ̂ cpp ɂ͉ȂOK
+// cpp 内での SetOwner は不要になりました
+// inline でヘッダに書いたので cpp には何も書かなくてOK
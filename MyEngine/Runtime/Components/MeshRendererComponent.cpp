@@ -1,4 +1,5 @@
 ﻿#include "Components/MeshRendererComponent.h"
+#include "Assets/MeshCache.h"
 #include "../D3D12Renderer.h"
 #include "Scene/GameObject.h"
 #include <Windows.h> // OutputDebugStringA
@@ -13,6 +14,8 @@
 
     データの流れ（典型）：
       1) SetMesh() で CPU 側の MeshData を受け取る（頂点/インデックス配列）。
+         optimize = true なら MeshOptimizer で GPU 向けに並べ替えてから保持する。
+         .mesh キャッシュからなら SetMeshFromCache()（焼き込み済みの区画をコピーするだけ）。
       2) D3D12Renderer::CreateMeshRendererResources() などで
          - Upload ヒープへ頂点/インデックスをコピー
          - ID3D12Resource と D3D12_*_BUFFER_VIEW を本コンポーネントへ設定
@@ -22,25 +25,118 @@
     注意：
       - IndexCount は Draw のインデックス数。SetMesh() 時点では CPU メッシュから初期化。
         最終的には GPU リソース生成後も一致している必要がある。
-      - VertexBuffer/IndexBuffer リソース自体の寿命は、外部（レンダラ側の破棄ルーチン）で管理。
+      - VertexBuffers/IndexBuffer リソース自体の寿命は、外部（レンダラ側の破棄ルーチン）で管理。
 */
 
 MeshRendererComponent::MeshRendererComponent()
     : Component(ComponentType::MeshRenderer), IndexCount(0)
 {
     // 安全のためビュー構造体をゼロ初期化（未設定アクセス防止）
-    ZeroMemory(&VertexBufferView, sizeof(VertexBufferView));
+    ZeroMemory(VertexBufferViews, sizeof(VertexBufferViews));
     ZeroMemory(&IndexBufferView, sizeof(IndexBufferView));
 }
 
-void MeshRendererComponent::SetMesh(const MeshData& meshData)
+void MeshRendererComponent::SetMesh(const MeshData& meshData, bool optimize)
 {
     // 1) CPU 側コピー（オリジナルがスコープアウトしても参照を維持）
     //    → この後、レンダラが CreateMeshRendererResources() で GPU 転送する想定。
     m_MeshData = meshData;
+    m_MeshCache.reset();
 
-    // 2) インデックス数を更新（描画時の DrawIndexedInstanced で使用）
-    IndexCount = static_cast<UINT>(meshData.Indices.size());
+    //    GPU 向けの並べ替え（VB/IB を作る前に 1 回だけ。前提を満たさないメッシュはそのまま）
+    m_OptimizeStats = optimize ? OptimizeMesh(m_MeshData) : MeshOptimizeStats();
+
+    // 2) インデックス数を更新（描画時の DrawIndexedInstanced で使用）。LOD とメッシュレットは作り直すまで無し
+    IndexCount = static_cast<UINT>(m_MeshData.Indices.size());
+    m_Lods.Clear();
+    m_Meshlets.reset();
+    LodCount = 1;
+    Lods[0] = { StartIndex, IndexCount, 0.0f };
+
+    // 3) ローカル境界（AABB/境界球）を更新（カリング等で使用。描画時はワールド行列で変換）
+    RecomputeBounds();
+}
+
+void MeshRendererComponent::SetMeshFromCache(std::shared_ptr<const MeshCacheFile> cache)
+{
+    if (!cache || !cache->IsOpen()) return;
+
+    // 区画をまとめてコピーするだけ（頂点ごとの変換・最適化・境界の計算はしない）
+    cache->CopyMesh(m_MeshData);
+    cache->CopyLods(m_Lods);
+    auto meshlets = std::make_shared<MeshletData>();
+    if (cache->CopyMeshlets(*meshlets)) m_Meshlets = std::move(meshlets);
+    else                                m_Meshlets.reset();
+    m_OptimizeStats = cache->OptimizeStats();
+
+    IndexCount = static_cast<UINT>(m_MeshData.Indices.size());
+    LodCount = 1;
+    Lods[0] = { StartIndex, IndexCount, 0.0f };
+
+    m_Bounds = cache->Bounds();
+    m_BoundsDirty = false;
+    m_BoundsConservative = false;
+    ++m_BoundsVersion;
+
+    m_MeshCache = std::move(cache);
+}
+
+void MeshRendererComponent::BuildLods(const MeshLodSettings& settings)
+{
+    m_MeshCache.reset();
+    // GPU 側（Lods[]）は次の CreateMeshRendererResources で反映される
+    ::BuildMeshLods(m_MeshData, settings, m_Lods);
+}
+
+void MeshRendererComponent::BuildMeshlets(const MeshletLimits& limits)
+{
+    auto meshlets = std::make_shared<MeshletData>();
+    if (::BuildMeshlets(m_MeshData, limits, *meshlets) > 0) m_Meshlets = std::move(meshlets);
+    else                                                     m_Meshlets.reset();
+}
+
+MeshData& MeshRendererComponent::EditMeshData()
+{
+    // 何を書き換えられるか分からないので、CPU 側から作った物はすべて作り直しにする
+    m_BoundsDirty = true;
+    m_Lods.Clear();
+    m_Meshlets.reset();
+    m_MeshCache.reset();
+    return m_MeshData;
+}
+
+const MeshBounds& MeshRendererComponent::GetBounds() const
+{
+    // EditMeshData() 経由で編集された → 全頂点から取り直す
+    if (m_BoundsDirty)
+    {
+        m_Bounds = ComputeMeshBounds(m_MeshData);
+        m_BoundsDirty = false;
+        ++m_BoundsVersion;
+    }
+    return m_Bounds;
+}
+
+void MeshRendererComponent::RecomputeBounds()
+{
+    m_Bounds = ComputeMeshBounds(m_MeshData);
+    m_BoundsDirty = false;
+    m_BoundsConservative = false;
+    ++m_BoundsVersion;
+}
+
+void MeshRendererComponent::NotifyVerticesChanged(std::size_t first, std::size_t count)
+{
+    // 範囲を頂点配列内にクランプ
+    const std::size_t n = m_MeshData.Vertices.size();
+    if (first >= n || count == 0) return;
+    if (count > n - first) count = n - first;
+
+    // 変更範囲の頂点だけで境界を広げる（全体の再走査はしない）
+    ExpandBounds(m_Bounds, m_MeshData.Vertices.data() + first, count);
+    m_BoundsDirty = false;
+    m_BoundsConservative = true;
+    ++m_BoundsVersion;
 }
 
 void MeshRendererComponent::Render(D3D12Renderer* renderer)
@@ -1,82 +1,219 @@
 #pragma once
 #include "Components/Component.h"
 #include "Assets/Mesh.h"
+#include "Assets/Bounds.h"
+#include "Assets/MeshOptimizer.h"
+#include "Assets/MeshSimplifier.h"
+#include "Assets/Meshlet.h"
 #include <wrl/client.h>
 #include <d3d12.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 
 /*
 ================================================================================
  MeshRendererComponent
 --------------------------------------------------------------------------------
-ړI
-- L GameObject ̃bV`悷邽߂̍ŏR|[lgB
-- CPU ̃bVf[^iMeshDatajێAD3D12  VB/IB  Renderer ŐB
-- ۂ DrawIndexedInstanced Ăяo D3D12Renderer ɈϏiEӕjB
-
-݌v
-- GPU \[XiVB/IBj͖{NXł͍炸AD3D12Renderer EXV݌vB
-   ̂ D3D12Renderer  friend ɂēobt@֒ڃANZX\ɂB
-- SetMesh()  CPU Rs[̂݁i_ҏWc[XV₷jB
-  GPU ]KvɂȂ Renderer  CreateMeshRendererResources() ĂԁB
-- Render() ́uL GameObject  ActiveInHierarchy ̂Ƃv`˗oB
-  h[ D3D12Renderer::DrawMesh() sB
-
-gp菇ij
+目的
+- 所有 GameObject のメッシュを描画するための最小コンポーネント。
+- CPU 側のメッシュデータ（MeshData）を保持し、D3D12 の VB/IB を Renderer 側で生成。
+- 実際の DrawIndexedInstanced 呼び出しは D3D12Renderer に委譲（職責分離）。
+
+設計メモ
+- GPU リソース（VB/IB）は本クラスでは作らず、D3D12Renderer が生成・更新する設計。
+  → そのため D3D12Renderer を friend にして内部バッファへ直接アクセス可能にする。
+- SetMesh() は CPU 側コピーのみ（頂点編集ツール等から更新しやすくする）。
+  GPU 転送が必要になったら Renderer 側の CreateMeshRendererResources() を呼ぶ。
+- Render() は「所有 GameObject が ActiveInHierarchy のときだけ」描画依頼を出す。
+  実ドローは D3D12Renderer::DrawMesh() が行う。
+
+使用手順（例）
 1) auto mr = go->AddComponent<MeshRendererComponent>();
-2) mr->SetMesh(meshData);                           // CPU ɕێ
-3) renderer->CreateMeshRendererResources(mr);       // VB/IB 쐬iGPU ]j
-4) t[Fmr->Render(renderer);               // Draw ̈Ϗ
-
-ӓ_
-- IndexCount  32bitiDXGI_FORMAT_R32_UINTjOŌvZĂB
-  16bit gꍇ̓r[ Format ƃf[^^킹邱ƁB
-- CPU Mesh  GPU \[X͖̓IiSetMesh ł͕`悳ȂjB
+2) mr->SetMesh(meshData, true);                     // CPU 側に保持（GPU 向けに並べ替える）
+3) renderer->CreateMeshRendererResources(mr);       // VB/IB を作成（GPU 転送）
+4) 毎フレーム：mr->Render(renderer);               // Draw の委譲
+
+注意点
+- CPU 側の Indices は 32bit のまま。GPU 側は最大インデックスが 0xFFFF 以下なら 16bit の共有 IB に置かれ、
+  IndexBufferView.Format が R16_UINT になる（IndexCount/StartIndex は形式によらず要素数）。
+- CPU Mesh と GPU リソースの同期は明示的（SetMesh だけでは描画されない）。
+- ローカル境界（AABB/境界球）は SetMesh で計算してキャッシュする。
+  GetMeshData() は読むだけ（副作用なし）。書き換えは EditMeshData() を通す：
+    * 既定では次の GetBounds() で全頂点から再計算する（遅延・正確）
+    * 頂点だけを動かしたなら NotifyVerticesChanged(first, count) を呼べば、
+      その範囲だけで境界を広げる（増分・保守的。呼ぶかどうかは呼び出し側が選ぶ）
 ================================================================================
 */
 
 class D3D12Renderer;
+class MeshCacheFile;
 
 class MeshRendererComponent : public Component
 {
-    // D3D12Renderer  GPU \[X𒼐ڐݒł悤ɂ
+    // D3D12Renderer が GPU リソースを直接設定できるようにする
     friend class D3D12Renderer;
 
 public:
-    // ^iGfB^\^Ɏgpj
+    // 型情報（エディタ表示や型分岐に使用）
     static ComponentType StaticType() { return ComponentType::MeshRenderer; }
 
     MeshRendererComponent();
     ~MeshRendererComponent() override = default;
 
     //-------------------------------------------------------------------------
-    // CPU bVݒiGPU ]͍sȂj
-    //   - ݒ Renderer  CreateMeshRendererResources() Ă VB/IB XV邱
+    // CPU 側メッシュを設定（GPU 転送は行わない）
+    //   - 設定後は Renderer 側の CreateMeshRendererResources() を呼んで VB/IB を更新すること
+    //   - 既定では渡されたままの頂点/三角形の順で保持する（頂点番号を使った編集ツール向け）
+    //   - optimize = true なら、コピーに OptimizeMesh（溶接・頂点キャッシュ・オーバードロー・
+    //     フェッチ順）をかけてから保持する。形は同じだが頂点/三角形の順と頂点数が変わるので、
+    //     ロード時の資産など、元の頂点番号を使わないメッシュでだけ指定する
+    //     （.mesh キャッシュの焼き込みは MeshCacheBuildSettings::optimize で同じことをする）
+    //   - GetOptimizeStats() で前後の ACMR/ATVR を見られる（false のときは optimized = false）
     //-------------------------------------------------------------------------
-    void SetMesh(const MeshData& meshData);
+    void SetMesh(const MeshData& meshData, bool optimize = false);
+    const MeshOptimizeStats& GetOptimizeStats() const { return m_OptimizeStats; }
 
     //-------------------------------------------------------------------------
-    // `iL GameObject  Active ̂Ƃ̂ Renderer ɈϏj
-    //   - ۂ IA Zbg & DrawIndexedInstanced  D3D12Renderer S
+    // .mesh キャッシュ（Assets/MeshCache.h）から設定する
+    //   - 焼き込み済みなので最適化も境界の計算もしない。CPU 側のメッシュ・LOD・メッシュレット・境界・
+    //     最適化の結果は区画からまとめてコピーする
+    //   - cache は次の CreateMeshRendererResources まで持ち、GPU 形式の区画をそのまま送らせる
+    //     （送ったら手放す。同じ cache を複数の MeshRenderer に渡してよい）
+    //   - SetMesh / EditMeshData / SetLods / BuildLods で手放す（CPU 側と食い違うため）
+    //-------------------------------------------------------------------------
+    void SetMeshFromCache(std::shared_ptr<const MeshCacheFile> cache);
+    const MeshCacheFile* GetMeshCache() const { return m_MeshCache.get(); }
+    void ReleaseMeshCache() { m_MeshCache.reset(); }
+
+    //-------------------------------------------------------------------------
+    // 描画（所有 GameObject が Active のときのみ Renderer に委譲）
+    //   - 実際の IA セット & DrawIndexedInstanced は D3D12Renderer が担当
     //-------------------------------------------------------------------------
     void Render(D3D12Renderer* renderer) override;
 
-    // ǂݎpANZTiGfB^fobKpj
+    // 読み取り用アクセサ（エディタ・デバッガ・Renderer 用。何も捨てない）
     const MeshData& GetMeshData() const { return m_MeshData; }
-    MeshData& GetMeshData() { return m_MeshData; }
+
+    // 編集用アクセサ：書き換えられる前提で、返す前に派生データを捨てる
+    //   - 境界は「要再計算」にする（頂点だけなら編集後の NotifyVerticesChanged() で全再計算を避けられる）
+    //   - インデックスが変わりうるので LOD とメッシュレットも捨てる（必要なら作り直す）
+    //   - GPU へは次の CreateMeshRendererResources で送り直す（.mesh キャッシュも手放す）
+    MeshData& EditMeshData();
+
+    //-------------------------------------------------------------------------
+    // LOD（MeshSimplifier が作る LOD1 以降のインデックス。頂点は m_MeshData のものを共有）
+    //   - BuildLods() はこのメッシュだけを作る（CPU のみ。重いのでロード時に）。
+    //     シーン全体は D3D12Renderer::BuildMeshLods がメッシュ単位で並列に作る
+    //   - SetMesh / EditMeshData で捨てる
+    //   - GPU へは CreateMeshRendererResources で LOD0 と同じ区間（VB 共有、IB は続けて）に置かれ、
+    //     Lods[]/LodCount に各段の StartIndex/IndexCount が入る。描く段は SceneRenderer が選ぶ
+    //-------------------------------------------------------------------------
+    void BuildLods(const MeshLodSettings& settings = MeshLodSettings());
+    void SetLods(MeshLods lods) { m_Lods = std::move(lods); m_MeshCache.reset(); }
+    const MeshLods& GetLods() const { return m_Lods; }
+
+    //-------------------------------------------------------------------------
+    // メッシュレット（Assets/Meshlet.h。LOD0 の三角形を頂点 64 / 三角形 124 以下の塊に分けたもの）
+    //   - BuildMeshlets() はこのメッシュだけを作る（CPU のみ）。シーン全体は
+    //     D3D12Renderer::BuildMeshlets が同じ内容のメッシュをまとめて並列に作り、結果を共有させる
+    //   - SetMesh / EditMeshData で捨てる。GPU へは送らない
+    //   - 持っていれば SceneRenderer が LOD0 を描くときに塊ごとに視錐台/裏向きで判定し、
+    //     残った分のインデックスだけを詰めて描く（MeshletCullSettings）
+    //-------------------------------------------------------------------------
+    void BuildMeshlets(const MeshletLimits& limits = MeshletLimits());
+    void SetMeshlets(std::shared_ptr<const MeshletData> meshlets) { m_Meshlets = std::move(meshlets); }
+    const MeshletData* GetMeshlets() const { return m_Meshlets.get(); }
 
     //-------------------------------------------------------------------------
-    // GPU \[XiRenderer /XVj
-    //   - VertexBuffer / IndexBuffer cc ComPtr ŏL
-    //   - *_VIEW  IA ɃoCh邽߂̃r[f[^
-    //   - IndexCount  DrawIndexedInstanced ̃CfbNX
+    // ローカル境界（AABB + 境界球）
+    //   - GetBounds()/GetLocalBounds() は必要なら遅延で全再計算してから返す
+    //   - NotifyVerticesChanged() は [first, first+count) の頂点だけで境界を広げる。
+    //     縮小はしないので、内側へ動かした場合は RecomputeBounds() で締め直すこと
+    //   - GetBoundsVersion() は境界が変わるたびに増える（上位のキャッシュ無効化用）
     //-------------------------------------------------------------------------
-    Microsoft::WRL::ComPtr<ID3D12Resource> VertexBuffer;     // _obt@iGPUj
-    D3D12_VERTEX_BUFFER_VIEW               VertexBufferView{}; // VBViStride, Size, GPU VAj
-    Microsoft::WRL::ComPtr<ID3D12Resource> IndexBuffer;      // CfbNXobt@iGPUj
-    D3D12_INDEX_BUFFER_VIEW                IndexBufferView{};  // IBViFormat, Size, GPU VAj
-    UINT                                   IndexCount = 0;      // CfbNX
+    const MeshBounds& GetBounds() const;
+    const AABB& GetLocalBounds() const { return GetBounds().Box; }
+    const BoundingSphere& GetLocalSphere() const { return GetBounds().Sphere; }
+    void NotifyVerticesChanged(std::size_t first, std::size_t count);
+    void RecomputeBounds();
+    bool IsBoundsConservative() const { return m_BoundsConservative; }
+    std::uint32_t GetBoundsVersion() const { GetBounds(); return m_BoundsVersion; }
+
+    //-------------------------------------------------------------------------
+    // オクルーダ指定
+    //   - true にすると SceneRenderer がこのメッシュを CPU 側の深度バッファへ塗り、
+    //     後ろに隠れたオブジェクトを描画前に捨てる（OcclusionCuller）。
+    //   - 壁・床・大きな建物など「画面を大きく塞ぐ、三角形の少ない」メッシュにだけ付ける。
+    //-------------------------------------------------------------------------
+    void SetOccluder(bool occluder) { m_Occluder = occluder; }
+    bool IsOccluder() const { return m_Occluder; }
+
+    //-------------------------------------------------------------------------
+    // 静的バッチ済みフラグ（D3D12Renderer::BuildStaticBatches が設定する）
+    //   - true のとき、このメッシュはワールド空間に焼き込まれて結合バッファに含まれているので
+    //     SceneRenderer は個別には描かない（オクルーダとしては引き続き使われる）。
+    //-------------------------------------------------------------------------
+    void SetStaticBatched(bool batched) { m_StaticBatched = batched; }
+    bool IsStaticBatched() const { return m_StaticBatched; }
+
+    //-------------------------------------------------------------------------
+    // GPU リソース（Renderer が生成/更新）
+    //   - VertexBuffer / IndexBuffer …… ComPtr で所有
+    //   - *_VIEW は IA にバインドするためのビューデータ
+    //   - IndexCount は DrawIndexedInstanced のインデックス数
+    //   - VB/IB は全メッシュ共有の GeometryPool（大きな VB/IB 1 組）。このメッシュの区間は
+    //     StartIndex（IB 上の先頭インデックス）と BaseVertex（VB 上の先頭頂点）で表す
+    //   - 頂点はストリームを分けて置く（GpuVertexStreams）。VertexBuffers/VertexBufferViews の
+    //     [kPositionStream] は位置だけ（スロット 0）、[kAttributeStream] は法線 + 色（スロット 1）。
+    //     通常の描画は 2 本ともバインドし、深度/影のように位置しか読まないパスは
+    //     IASetVertexBuffers(0, 1, &VertexBufferViews[kPositionStream]) だけでよい。
+    //     BaseVertex は両ストリーム共通
+    //   - VB/IB は DEFAULT ヒープに置き、COPY キューで転送する（GpuUploadQueue）。
+    //     GpuReady が false の間（転送中）は SceneRenderer が描画候補から外す。
+    //     UploadFence は転送の完了を表すフェンス値（0 = 待つ転送なし）
+    //   - Lods[k] は LOD k の区間（[0] は StartIndex/IndexCount と同じ）。Error は元の形からの誤差
+    //     （ローカル AABB の対角の半分に対する比）。LodCount は有効な段数（LOD が無ければ 1）
+    //   - MeshCacheKey は D3D12Renderer が共有表から外すときに使う（作り直しで古い区間に残らないように）
+    //-------------------------------------------------------------------------
+    static constexpr UINT kPositionStream = 0;    // 位置ストリーム（VB スロット 0）
+    static constexpr UINT kAttributeStream = 1;   // 法線/色ストリーム（VB スロット 1）
+    static constexpr UINT kVertexStreamCount = 2;
+    static constexpr UINT kMaxLods = 4;           // LOD0 を含めた最大段数
+
+    struct LodRange
+    {
+        UINT  StartIndex = 0;
+        UINT  IndexCount = 0;
+        float Error = 0.0f;
+    };
+
+    Microsoft::WRL::ComPtr<ID3D12Resource> VertexBuffers[kVertexStreamCount];     // 頂点バッファ（GPU。ストリームごと）
+    D3D12_VERTEX_BUFFER_VIEW               VertexBufferViews[kVertexStreamCount]{}; // VBV（Stride, Size, GPU VA。添字 = スロット）
+    Microsoft::WRL::ComPtr<ID3D12Resource> IndexBuffer;      // インデックスバッファ（GPU）
+    D3D12_INDEX_BUFFER_VIEW                IndexBufferView{};  // IBV（Format, Size, GPU VA）
+    UINT                                   IndexCount = 0;      // インデックス総数
+    UINT                                   StartIndex = 0;      // DrawIndexedInstanced の StartIndexLocation
+    INT                                    BaseVertex = 0;      // DrawIndexedInstanced の BaseVertexLocation
+    bool                                   GpuReady = true;     // VB/IB の転送が完了して描画に使える
+    std::uint64_t                          UploadFence = 0;     // 転送完了のフェンス値（D3D12Renderer が監視）
+    LodRange                               Lods[kMaxLods]{};    // LOD ごとの区間（共有 IB 上）
+    UINT                                   LodCount = 1;        // 有効な LOD の段数
+    std::uint64_t                          MeshCacheKey = 0;    // D3D12Renderer のメッシュ共有表のキー（0 = 未登録）
 
 private:
-    // CPU bViGfB^ҏWăAbv[ȟf[^j
+    // CPU 側メッシュ（エディタ編集や再アップロードの元データ）
     MeshData m_MeshData;
+    MeshOptimizeStats m_OptimizeStats; // 直近の SetMesh での最適化結果
+    MeshLods m_Lods;                   // LOD1 以降のインデックス（空 = LOD なし）
+    std::shared_ptr<const MeshletData> m_Meshlets; // メッシュレット（nullptr = なし。同じ形のメッシュで共有）
+    std::shared_ptr<const MeshCacheFile> m_MeshCache; // GPU へ送るまでの .mesh（nullptr = 通常の経路）
+
+    // ローカル境界（m_MeshData の頂点位置から算出。GetBounds() で遅延更新するため mutable）
+    mutable MeshBounds    m_Bounds;
+    mutable bool          m_BoundsDirty = false;        // 全再計算が必要
+    mutable std::uint32_t m_BoundsVersion = 0;          // 境界が変わるたびに +1
+    bool                  m_BoundsConservative = false; // 増分更新で緩くなっている可能性あり
+    bool                  m_Occluder = false;           // オクルージョンカリングの遮蔽物として使うか
+    bool                  m_StaticBatched = false;      // 静的バッチに結合済み（個別には描かない）
 };
@@ -79,6 +79,28 @@ XMMATRIX TransformComponent::GetWorldMatrix() const
     return S * R * T;
 }
 
+// ----------------------------------------------------------------------------
+// GetVersion
+// フィールドは外部から直接書き換えられるので、問い合わせ時に前回値と比較する。
+// 9 個の float 比較だけなので毎フレーム全オブジェクトで呼んでも安い。
+// ----------------------------------------------------------------------------
+std::uint32_t TransformComponent::GetVersion() const
+{
+    auto same = [](const XMFLOAT3& a, const XMFLOAT3& b)
+        {
+            return a.x == b.x && a.y == b.y && a.z == b.z;
+        };
+
+    if (!same(Position, m_versionPos) || !same(Rotation, m_versionRot) || !same(Scale, m_versionScale))
+    {
+        m_versionPos = Position;
+        m_versionRot = Rotation;
+        m_versionScale = Scale;
+        ++m_version;
+    }
+    return m_version;
+}
+
 // ----------------------------------------------------------------------------
 // GetForwardVector
 // ローカルの (0,0,1) を回転だけでワールドへ変換し、正規化して返す。
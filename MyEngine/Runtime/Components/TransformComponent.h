@@ -1,28 +1,31 @@
 #pragma once
 #include "Components/Component.h"
 #include <DirectXMath.h>
+#include <cstdint>
 
 /*
 ===============================================================================
  TransformComponent (Header)
 -------------------------------------------------------------------------------
-ړI
-- [hԂɂuʒu(Position)E](Rotation)Egk(Scale)vێA
-  s/xNg/LookAt Ȃǂ̊{ϊ[eBeB񋟂B
+目的
+- ワールド空間における「位置(Position)・回転(Rotation)・拡縮(Scale)」を保持し、
+  行列/方向ベクトル/LookAt などの基本変換ユーティリティを提供する。
 
-WnE\̖
-- n (Left-Handed) OF+Z = O / +X = E / +Y = 
-- Rotation ́ux(degree)vŕێis񉻂钼OɃWA֕ϊjB
-- ] X(Pitch)  Y(Yaw)  Z(Roll) ɓꂷB
-   s񐶐xNg̎Zoł̏ɑ邱ƁB
-    isv 90Ƃ́gсh⎲̌j
+座標系・表現の約束
+- 左手系 (Left-Handed) を前提：+Z = 前 / +X = 右 / +Y = 上
+- Rotation は「度(degree)」で保持する（行列化する直前にラジアンへ変換）。
+- 回転合成順は X(Pitch) → Y(Yaw) → Z(Roll) に統一する。
+  ※ 行列生成や方向ベクトルの算出でもこの順序に揃えること。
+    （順序不一致は 90°ごとの“跳び”や軸ずれの原因）
 
-/^p̃qg
-- xNg TransformNormal(w=0) Łu]̂݁vKpĂ NormalizeB
-  TransformCoord(w=1) ͕sړ܂Ŋ܂ނߕxNgɂ͕sB
-- LookAt ́uʒuƖڕW_v̂Ƃ͉ȂiNaN/Inf h~jB
-- Pitch}90 t߂̓WobNɒӁBKvȂNH[^jIΉʓrB
-- قƂǂ API  const ŕpȂBXbh̊O͌ĂяoŁB
+実装/運用のヒント
+- 方向ベクトルは TransformNormal(w=0) で「回転のみ」を適用してから Normalize。
+  TransformCoord(w=1) は平行移動まで含むため方向ベクトルには不向き。
+- LookAt は「位置と目標が同一点」のときは何もしない（NaN/Inf 防止）。
+- Pitch±90° 付近はジンバルロックに注意。必要ならクォータニオン対応を別途検討。
+- ほとんどの API は const で副作用なし。スレッド化時の外部同期は呼び出し側で。
+  （例外：GetVersion は内部のスナップショットを更新する）
+- フィールドは直接書き換えられるため、変更の検出は GetVersion の“問い合わせ時比較”で行う。
 ===============================================================================
 */
 
@@ -30,72 +33,86 @@ class TransformComponent : public Component
 {
 public:
     //=========================================================================
-    // tB[hi[hԁj
+    // フィールド（ワールド空間）
     //=========================================================================
-    DirectX::XMFLOAT3 Position;  // ʒu (x, y, z)
-    DirectX::XMFLOAT3 Rotation;  // ]pixjPitch=X, Yaw=Y, Roll=Z
-    DirectX::XMFLOAT3 Scale;     // gk (1,1,1)={
+    DirectX::XMFLOAT3 Position;  // 位置 (x, y, z)
+    DirectX::XMFLOAT3 Rotation;  // 回転角（度）Pitch=X, Yaw=Y, Roll=Z
+    DirectX::XMFLOAT3 Scale;     // 拡縮 (1,1,1)=等倍
 
     //-------------------------------------------------------------------------
-    // RXgN^
-    // l: Position=(0,0,0), Rotation=(0,0,0), Scale=(1,1,1)
+    // コンストラクタ
+    // 既定値: Position=(0,0,0), Rotation=(0,0,0), Scale=(1,1,1)
     //-------------------------------------------------------------------------
     TransformComponent();
 
     //=========================================================================
-    // s
+    // 行列
     //=========================================================================
     /**
-     * @brief [hsԂ
-     * @details : Scale  RotX(Pitch)  RotY(Yaw)  RotZ(Roll)  Translate
-     *          in/xWAϊ͎ōsj
+     * @brief ワールド行列を返す
+     * @details 合成順: Scale → RotX(Pitch) → RotY(Yaw) → RotZ(Roll) → Translate
+     *          （左手系/度→ラジアン変換は実装側で行う）
      */
     DirectX::XMMATRIX GetWorldMatrix() const;
 
+    /**
+     * @brief 変換のバージョン番号（カリング結果のキャッシュ判定用）
+     * @details 前回の呼び出しから Position/Rotation/Scale のいずれかが変わっていれば +1 して返す。
+     *          値そのものに意味は無く「前回見た値と違うか」だけを比較に使う。
+     */
+    std::uint32_t GetVersion() const;
+
     //=========================================================================
-    // xNgi[hj
-    //   [J:
+    // 方向ベクトル（ワールド）
+    //   ローカル基準:
     //     Forward = (0,0,1), Right = (1,0,0), Up = (0,1,0)
-    //   :
-    //     TransformNormal(w=0) ŉ]݂̂KpANormalize ĕԂB
+    //   実装注意:
+    //     TransformNormal(w=0) で回転のみを適用し、Normalize して返す。
     //=========================================================================
 
-    /// @brief O(+Z )xNgi[hj擾
+    /// @brief 前方向(+Z 基準)ベクトル（ワールド）を取得
     DirectX::XMVECTOR GetForwardVector() const;
 
-    /// @brief E(+X )xNgi[hj擾
+    /// @brief 右方向(+X 基準)ベクトル（ワールド）を取得
     DirectX::XMVECTOR GetRightVector() const;
 
-    /// @brief (+Y )xNgi[hj擾
+    /// @brief 上方向(+Y 基準)ベクトル（ワールド）を取得
     DirectX::XMVECTOR GetUpVector() const;
 
     //=========================================================================
-    // LookAtiIvVij
-    //   ړI: w肵 target 悤 Rotation ݒ肷B
-    //   O: n(+ZO)BRotation ͓xBRoll ͂ł͕ύXȂB
-    //   dl:
+    // LookAt（オプショナル）
+    //   目的: 指定した target を向くように Rotation を設定する。
+    //   前提: 左手系(+Z前)。Rotation は度。Roll はここでは変更しない。
+    //   仕様:
     //     - dir = normalize(target - position)
     //     - yaw   = atan2(dir.x, dir.z)
     //     - pitch = atan2(dir.y, sqrt(dir.x^2 + dir.z^2))
-    //   [:
-    //     - ʒuƖڕWقړ_̏ꍇ͉ȂiNaNh~jB
+    //   ゼロ距離:
+    //     - 位置と目標がほぼ同一点の場合は何もしない（NaN防止）。
     //=========================================================================
 
     /**
-     * @brief ݂ Position  target 悤 Rotation ݒ
-     * @param target  _i[hj
-     * @param worldUp i {0,1,0}B{ł Roll ͌Œj
+     * @brief 現在の Position から target を向くように Rotation を設定
+     * @param target  注視点（ワールド）
+     * @param worldUp 上方向（既定 {0,1,0}。本実装では Roll は固定）
      */
     void LookAt(const DirectX::XMFLOAT3& target,
         const DirectX::XMFLOAT3& worldUp = { 0.f, 1.f, 0.f });
 
     /**
-     * @brief w Position ֈړ target 
-     * @param position Vʒui[hj
-     * @param target   _i[hj
-     * @param worldUp  i[hj
+     * @brief 指定 Position へ移動した上で target を向く
+     * @param position 新しい位置（ワールド）
+     * @param target   注視点（ワールド）
+     * @param worldUp  上方向（ワールド）
      */
     void LookAt(const DirectX::XMFLOAT3& position,
         const DirectX::XMFLOAT3& target,
         const DirectX::XMFLOAT3& worldUp);
+
+private:
+    // GetVersion 用：最後に問い合わせた時点の値
+    mutable DirectX::XMFLOAT3 m_versionPos{ 0.0f, 0.0f, 0.0f };
+    mutable DirectX::XMFLOAT3 m_versionRot{ 0.0f, 0.0f, 0.0f };
+    mutable DirectX::XMFLOAT3 m_versionScale{ 1.0f, 1.0f, 1.0f };
+    mutable std::uint32_t     m_version = 1;
 };
@@ -1,34 +1,34 @@
 // EditorInterop.cpp
 //------------------------------------------------------------------------------
-// ړIFEditoriImGui jƃQ[WbŃgyԋLhB
-//       ł́uScene EBhEɃJ[\Ă邩vutH[JX邩v
-//       O[oɕێ/擾邾̋ɏ[eBeB񋟂B
-// gpF
-//   - ImGui ̃CAEg/`撆ɁAScene EBhE Hovered/Focused o Set` Ă
-//   - Q[i͏Ȃǁj Is` QƂāAJȂǂ̋/s𔻒f
+// 目的：Editor（ImGui 側）とゲームロジック側の“軽い状態共有”。
+//       ここでは「Scene ウィンドウ上にカーソルが乗っているか」「フォーカスがあるか」を
+//       グローバルに保持/取得するだけの極小ユーティリティを提供する。
+// 使用例：
+//   - ImGui 側のレイアウト/描画中に、Scene ウィンドウの Hovered/Focused を検出して Set～ を呼ぶ
+//   - ゲーム側（入力処理など）で Is～ を参照して、カメラ操作などの許可/不許可を判断
 //
-// ӁF
-//   - ͒Pȃt@CXR[v̐ÓIϐŕێi}`XbhOł͂ȂjB
-//     Xbh瓯ɍXV/QƂ\ꍇ std::atomic<bool> Ȃǂ֍ւ邱ƁB
-//   - l̎FvZXԁBEditorInterop::Set` sxĂōŐVԂɕۂƁB
+// 注意：
+//   - 現状は単純なファイルスコープの静的変数で保持（＝マルチスレッド前提ではない）。
+//     複数スレッドから同時に更新/参照する可能性がある場合は std::atomic<bool> などへ差し替えること。
+//   - 値の寿命：プロセス存続期間。EditorInterop::Set～ を都度呼んで最新状態に保つこと。
 //------------------------------------------------------------------------------
 
 #include "EditorInterop.h"
 
 namespace {
-    // Scene EBhEɃ}EXuĂiHoveredjvǂ
-    // FImGui::IsWindowHovered() ̌ʂt[ɔfB
+    // Scene ウィンドウにマウスが「乗っている（Hovered）」かどうか
+    // 例：ImGui::IsWindowHovered() の結果をフレーム毎に反映する。
     bool g_sceneHovered = false;
 
-    // Scene EBhEɁuL[{[htH[JXiFocusedjvǂ
-    // FImGui::IsWindowFocused() ̌ʂt[ɔfB
+    // Scene ウィンドウに「キーボードフォーカスがある（Focused）」かどうか
+    // 例：ImGui::IsWindowFocused() の結果をフレーム毎に反映する。
     bool g_sceneFocused = false;
 }
 
 //------------------------------------------------------------------------------
 // SetSceneHovered
-//   ImGui  Hovered ̔肪ꂽA̒l֓nB
-//   t[ UI XV^C~OŌĂԂƂzB
+//   ImGui 側で Hovered の判定が取れたら、その値をここへ渡す。
+//   毎フレームの UI 更新タイミングで呼ぶことを想定。
 //------------------------------------------------------------------------------
 void EditorInterop::SetSceneHovered(bool v)
 {
@@ -37,8 +37,8 @@ void EditorInterop::SetSceneHovered(bool v)
 
 //------------------------------------------------------------------------------
 // SetSceneFocused
-//   ImGui  Focused ̔肪ꂽA̒l֓nB
-//   t[ UI XV^C~OŌĂԂƂzB
+//   ImGui 側で Focused の判定が取れたら、その値をここへ渡す。
+//   毎フレームの UI 更新タイミングで呼ぶことを想定。
 //------------------------------------------------------------------------------
 void EditorInterop::SetSceneFocused(bool v)
 {
@@ -47,8 +47,8 @@ void EditorInterop::SetSceneFocused(bool v)
 
 //------------------------------------------------------------------------------
 // IsSceneHovered
-//   ݂ Hovered Ԃ擾iQ[QƁjB
-//   FHovered ̎{^hbOł̃pLɂ铙B
+//   現在の Hovered 状態を取得（ゲーム側から参照）。
+//   例：Hovered の時だけ中ボタンドラッグでのパン操作を有効にする等。
 //------------------------------------------------------------------------------
 bool EditorInterop::IsSceneHovered()
 {
@@ -57,8 +57,8 @@ bool EditorInterop::IsSceneHovered()
 
 //------------------------------------------------------------------------------
 // IsSceneFocused
-//   ݂ Focused Ԃ擾iQ[QƁjB
-//   FFocused ̎L[{[hł̃tCړ󂯕t铙B
+//   現在の Focused 状態を取得（ゲーム側から参照）。
+//   例：Focused の時だけキーボードでのフライ移動を受け付ける等。
 //------------------------------------------------------------------------------
 bool EditorInterop::IsSceneFocused()
 {
@@ -4,47 +4,47 @@
 ===============================================================================
  EditorInterop.h
 -------------------------------------------------------------------------------
-ړI
-- ImGui iGfB^ UIjƃQ[iR|[lg/͏jŋL
-  uScene r[̃zo[/tH[JXԁv󂯓n߂̋ɏubWB
-- ̗F
-  * ImGuiLayer  Scene EBhEzo[ꂽ SetSceneHovered(true)
-  * CameraController Ȃǂ IsSceneHovered()/IsSceneFocused() QƂ
-    ͂󂯕t邩ǂ߂
+目的
+- ImGui 側（エディタ UI）とゲーム側（コンポーネント/入力処理）で共有したい
+  「Scene ビューのホバー/フォーカス状態」を受け渡すための極小ブリッジ。
+- 具体例：
+  * ImGuiLayer で Scene ウィンドウがホバーされたら SetSceneHovered(true)
+  * CameraController などは IsSceneHovered()/IsSceneFocused() を参照して
+    入力を受け付けるかどうかを決める
 
-݌v
-- O[oȃtO getter/setter ŕ񂾂̌y APIB
-- XbhZ[tł͂܂iʏAUI Ɠ͏͓Xbhŉ񂷑zjB
-- u߃t[ł̏ԁvb`IȎgzB
-  t[̓ UI  Set` AQ[QƂ^pɂĂB
+設計メモ
+- グローバルなフラグを getter/setter で包んだだけの軽量 API。
+- スレッドセーフではありません（通常、UI と入力処理は同スレッドで回す想定）。
+- 「直近フレームでの状態」を示すラッチ的な使い方を想定。
+  フレームの頭で UI 側が Set～ し、ゲーム側が参照する運用にしてください。
 ===============================================================================
 */
 struct EditorInterop {
     /**
-     * @brief Scene r[}EXzo[ǂݒ肷
-     * @param v true: zo[ / false: zo[
-     * @note ImGuiLayer::BuildDockAndWindows Ȃ UI \zɍXVz
+     * @brief Scene ビューがマウスホバー中かどうかを設定する
+     * @param v true: ホバー中 / false: 非ホバー
+     * @note ImGuiLayer::BuildDockAndWindows など UI 構築時に更新する想定
      */
     static void SetSceneHovered(bool v);
 
     /**
-     * @brief Scene r[tH[JXiANeBujĂ邩ݒ肷
-     * @param v true: tH[JX / false: tH[JXȂ
-     * @note ImGui::IsWindowFocused() ̌ʂōXVz
+     * @brief Scene ビューがフォーカス（アクティブ）を持っているか設定する
+     * @param v true: フォーカスあり / false: フォーカスなし
+     * @note ImGui::IsWindowFocused() 等の結果で更新する想定
      */
     static void SetSceneFocused(bool v);
 
     /**
-     * @brief ݂̃t[ Scene r[zo[ǂ
-     * @return true: zo[ / false: zo[
-     * @note ̓R|[lgiJȂǁjQ
+     * @brief 現在のフレームで Scene ビューがホバー中かどうか
+     * @return true: ホバー中 / false: 非ホバー
+     * @note 入力コンポーネント側（カメラ操作など）が参照
      */
     static bool IsSceneHovered();
 
     /**
-     * @brief ݂̃t[ Scene r[tH[JXǂ
-     * @return true: tH[JX / false: tH[JXȂ
-     * @note ̗͂DxV[gJbg̉ۂȂǂŎgp
+     * @brief 現在のフレームで Scene ビューがフォーカスを持つかどうか
+     * @return true: フォーカスあり / false: フォーカスなし
+     * @note 入力の優先度決定やショートカットの可否などで使用
      */
     static bool IsSceneFocused();
 };
@@ -1,46 +1,46 @@
 // Input.cpp
 //------------------------------------------------------------------------------
-// FWin32 bZ[W gt[Pʂ̓͏ԁh gݗĂĒ񋟂B
-//       - L[/}EX{^̌/Ot[ԁiEn߁Ej
-//       - }EXWiEBhEWjƈړʁij
-//       - }EXzC[it[̍ʁj
+// 役割：Win32 メッセージから “フレーム単位の入力状態” を組み立てて提供する。
+//       - キー/マウスボタンの現在/前フレーム状態（押下・押し始め・離し）
+//       - マウス座標（ウィンドウ座標）と移動量（Δ）
+//       - マウスホイール（フレーム中の差分量）
 //
-// gi1t̗̖ڈj
-//   1) C[v擪 Input::Update() ĂԁiOt[t[̃XibvVbgj
-//   2) WndProc 痈 Win32 bZ[W Input::ProcessMessage(...) ɑSn
-//   3) Q[XV Input::GetKey / GetMouseButton / GetMouseDelta ȂǂQ
+// 使い方（1フレの流れの目安）
+//   1) メインループ先頭で Input::Update() を呼ぶ（前フレーム→今フレームのスナップショット）
+//   2) WndProc から来る Win32 メッセージを Input::ProcessMessage(...) に全部渡す
+//   3) ゲーム更新時に Input::GetKey / GetMouseButton / GetMouseDelta などを参照
 //
-// ӁF
-//   - {͒PEBhE/PXbhOibZ[W̓BŏԂXVj
-//   - }EX͌ĂяoɁgOۑlݒlh̍Ԃi static ŕێj
-//   - zC[ 1.0f Pʁi1mb`jɐK gt[̍vh Ԃ
-//   - E Ctrl/Alt/Shift ʂ鏈iWM_* ̊gXLR[hQƁj
+// 注意：
+//   - 本実装は単一ウィンドウ/単一スレッド前提（メッセージの到達順で状態が更新される）
+//   - マウスΔは呼び出し時に“前回保存値→現在値”の差分を返す（内部 static で保持）
+//   - ホイールは 1.0f 単位（1ノッチ）に正規化して “フレームの合計” を返す
+//   - 左右 Ctrl/Alt/Shift を区別する処理あり（WM_* の拡張情報やスキャンコードを参照）
 //------------------------------------------------------------------------------
 
 #include <windowsx.h> // GET_X_LPARAM, GET_Y_LPARAM
 #include "Input.h"
 
 // ============================================================================
-// ÓIoig̓foCX̌/Ot[ԁh ێj
+// 静的メンバ（“入力デバイスの現在/前フレーム状態” を保持）
 // ============================================================================
 
-// L[{[hFzL[ 0..255 ̉
-bool Input::m_CurrentKeys[256] = { false };  // t[
-bool Input::m_PreviousKeys[256] = { false };  // Ot[
+// キーボード：仮想キー 0..255 の押下状態
+bool Input::m_CurrentKeys[256] = { false };  // 今フレーム
+bool Input::m_PreviousKeys[256] = { false };  // 前フレーム
 
-// }EXF0/E1/2 3{^z
-bool Input::m_CurrentMouse[3] = { false };  // t[
-bool Input::m_PreviousMouse[3] = { false };  // Ot[
+// マウス：左0/右1/中2 の3ボタンを想定
+bool Input::m_CurrentMouse[3] = { false };  // 今フレーム
+bool Input::m_PreviousMouse[3] = { false };  // 前フレーム
 
-// J[\WiEBhEWnj
+// カーソル座標（ウィンドウ座標系）
 int  Input::m_MouseX = 0;
 int  Input::m_MouseY = 0;
 
-// }EXzC[i1t[̍vF+/-j
+// マウスホイール（1フレームの合計差分：+上/-下）
 float Input::m_MouseWheel = 0.0f;
 
 // ============================================================================
-// InitializeFSԃNAiQ[NɈxĂׂOKj
+// Initialize：全状態クリア（ゲーム起動時に一度呼べばOK）
 // ============================================================================
 void Input::Initialize()
 {
@@ -52,13 +52,13 @@ void Input::Initialize()
 }
 
 // ============================================================================
-// GetMouseDeltaF߂̌Ăяo (dx, dy) Ԃ
-//  -  static  gOQƎ̍Wh oĂAݒlƂ̍Ԃ
-//  - Ăԕpx 1 t[ 1 񂪑ziĂԂƍ݂ɕj
+// GetMouseDelta：直近の呼び出しからの (dx, dy) を返す
+//  - 内部 static に “前回参照時の座標” を覚えておき、現在値との差分を返す
+//  - 呼ぶ頻度は 1 フレーム 1 回が想定（複数回呼ぶと差分が小刻みに分割される）
 // ============================================================================
 MouseDelta Input::GetMouseDelta()
 {
-    static int lastX = m_MouseX; //  0
+    static int lastX = m_MouseX; // 初回は 0
     static int lastY = m_MouseY;
 
     const int dx = m_MouseX - lastX;
@@ -74,8 +74,8 @@ float Input::GetMouseDeltaX() { return static_cast<float>(GetMouseDelta().x); }
 float Input::GetMouseDeltaY() { return static_cast<float>(GetMouseDelta().y); }
 
 // ============================================================================
-// GetMouseScrollDeltaFt[ŗݐςzC[i1.0=1mb`j
-//  - l Update() `ŃZbg邽߁uYt[̑ʁv擾ł
+// GetMouseScrollDelta：フレーム内で累積したホイール差分（1.0=1ノッチ）
+//  - 値は Update() 冒頭でリセットされるため「当該フレームの総量」が取得できる
 // ============================================================================
 float Input::GetMouseScrollDelta()
 {
@@ -83,77 +83,77 @@ float Input::GetMouseScrollDelta()
 }
 
 // ============================================================================
-// UpdateFt[E
-//  - gݏԁh  gOt[ԁh ɑޔ
-//  - zC[ 0 NAit[̐ώẐ߁j
-//  - C[v gt[h ŕKĂԂ
+// Update：フレーム境界処理
+//  - “現在状態” を “前フレーム状態” に退避
+//  - ホイール差分を 0 クリア（次フレームの積算のため）
+//  - ※メインループの “フレーム頭” で必ず呼ぶこと
 // ============================================================================
 void Input::Update()
 {
-    // ̃t[pɐɃzC[NA
+    // 次のフレーム用に先にホイールをクリア
     m_MouseWheel = 0.0f;
 
-    // Ot[փXibvVbg
+    // 前フレームへスナップショット
     memcpy(m_PreviousKeys, m_CurrentKeys, sizeof(m_CurrentKeys));
     memcpy(m_PreviousMouse, m_CurrentMouse, sizeof(m_CurrentMouse));
 }
 
 // ============================================================================
-// L[́ij
-//  - GetKeyFĂ true
-//  - GetKeyDownFt[ŉꂽu true
-//  - GetKeyUpFt[ŗꂽu true
+// キー入力（押下判定）
+//  - GetKey：押されている間 true
+//  - GetKeyDown：今フレームで押された瞬間 true
+//  - GetKeyUp：今フレームで離された瞬間 true
 // ============================================================================
 bool Input::GetKey(KeyCode key) { return m_CurrentKeys[(int)key]; }
 bool Input::GetKeyDown(KeyCode key) { return  m_CurrentKeys[(int)key] && !m_PreviousKeys[(int)key]; }
 bool Input::GetKeyUp(KeyCode key) { return !m_CurrentKeys[(int)key] && m_PreviousKeys[(int)key]; }
 
 // ============================================================================
-// }EX{^i=0, E=1, =2j
+// マウスボタン（※左=0, 右=1, 中=2）
 // ============================================================================
 bool Input::GetMouseButton(MouseButton b) { return m_CurrentMouse[(int)b]; }
 bool Input::GetMouseButtonDown(MouseButton b) { return  m_CurrentMouse[(int)b] && !m_PreviousMouse[(int)b]; }
 bool Input::GetMouseButtonUp(MouseButton b) { return !m_CurrentMouse[(int)b] && m_PreviousMouse[(int)b]; }
 
 // ============================================================================
-// }EXWiEBhEWj
+// マウス座標（ウィンドウ座標）
 // ============================================================================
 int  Input::GetMouseX() { return m_MouseX; }
 int  Input::GetMouseY() { return m_MouseY; }
 
 // ============================================================================
-// ProcessMessageFWin32 WndProc 牡
-//  -  gݏԁh XViUpdate ̓t[ẼXibvVbgj
-//  - E Ctrl/Alt/Shift ̎ʂɒӁF
-//       * Ctrl  c VK_CONTROL ł͍Es  grbg(24bit)ŉE/𔻒
-//       * Alt    c VK_MENU    ligrbgj
-//       * Shift  c VK_SHIFT   ̓XLR[h MapVirtualKey ŎL[ɕϊ
+// ProcessMessage：Win32 WndProc から横流しする
+//  - ここで “現在状態” を更新する（Update はフレーム境界のスナップショット）
+//  - 左右 Ctrl/Alt/Shift の識別に注意：
+//       * Ctrl  … VK_CONTROL では左右不明 → 拡張ビット(24bit)で右/左を判定
+//       * Alt    … VK_MENU    も同様（拡張ビット）
+//       * Shift  … VK_SHIFT   はスキャンコードから MapVirtualKey で実キーに変換
 // ============================================================================
 void Input::ProcessMessage(UINT message, WPARAM wParam, LPARAM lParam)
 {
     switch (message)
     {
         // -----------------------
-        // L[{[h
+        // キーボード押下
         // -----------------------
     case WM_KEYDOWN:
-    case WM_SYSKEYDOWN: // Alt ̃VXeL[܂
+    case WM_SYSKEYDOWN: // Alt 等のシステムキーも含む
     {
         int vk = static_cast<int>(wParam);
 
-        // E Ctrl ʁigL[ȂEj
+        // 左右 Ctrl を識別（拡張キーなら右）
         if (vk == VK_CONTROL)
         {
             const bool ext = (lParam & (1 << 24)) != 0;
             vk = ext ? VK_RCONTROL : VK_LCONTROL;
         }
-        // E AltiVK_MENUj
+        // 左右 Alt（VK_MENU）を識別
         else if (vk == VK_MENU)
         {
             const bool ext = (lParam & (1 << 24)) != 0;
             vk = ext ? VK_RMENU : VK_LMENU;
         }
-        // E Shift ʁiXLR[hzL[gj
+        // 左右 Shift を識別（スキャンコード→仮想キー拡張）
         else if (vk == VK_SHIFT)
         {
             const UINT sc = static_cast<UINT>((lParam >> 16) & 0xFF);
@@ -169,7 +169,7 @@ void Input::ProcessMessage(UINT message, WPARAM wParam, LPARAM lParam)
     }
 
     // -----------------------
-    // L[{[h
+    // キーボード離し
     // -----------------------
     case WM_KEYUP:
     case WM_SYSKEYUP:
@@ -201,7 +201,7 @@ void Input::ProcessMessage(UINT message, WPARAM wParam, LPARAM lParam)
     }
 
     // -----------------------
-    // }EX{^/
+    // マウスボタン押下/離し
     // -----------------------
     case WM_LBUTTONDOWN: m_CurrentMouse[0] = true;  break;
     case WM_LBUTTONUP:   m_CurrentMouse[0] = false; break;
@@ -211,7 +211,7 @@ void Input::ProcessMessage(UINT message, WPARAM wParam, LPARAM lParam)
     case WM_MBUTTONUP:   m_CurrentMouse[2] = false; break;
 
         // -----------------------
-        // }EXړiEBhEWj
+        // マウス移動（ウィンドウ座標）
         // -----------------------
     case WM_MOUSEMOVE:
         m_MouseX = GET_X_LPARAM(lParam);
@@ -219,8 +219,8 @@ void Input::ProcessMessage(UINT message, WPARAM wParam, LPARAM lParam)
         break;
 
         // -----------------------
-        // }EXzC[
-        //  - WHEEL_DELTA(=120)  1.0f ɐKAt[ݐ
+        // マウスホイール
+        //  - WHEEL_DELTA(=120) を 1.0f に正規化し、フレーム累積
         // -----------------------
     case WM_MOUSEWHEEL:
         m_MouseWheel += GET_WHEEL_DELTA_WPARAM(wParam) / float(WHEEL_DELTA);
@@ -0,0 +1,153 @@
+﻿#include "Core/JobSystem.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// JobSystem 実装
+// ----------------------------------------------------------------------------
+// ・1 本の共有キュー + condition_variable の素朴なプール。
+// ・ParallelFor は「バッチ」を 1 つ作り、ワーカー数ぶんの“参加チケット”をキューに積む。
+//   各参加者（ワーカー/呼び出しスレッド）は atomic カウンタからチャンクを奪い合って処理する。
+//   → キュー操作はバッチあたり数回で済み、チャンク数に比例しない。
+// ・呼び出しスレッドも必ずチャンクを処理するので、入れ子や全ワーカー使用中でも進行が止まらない。
+// ============================================================================
+
+namespace
+{
+    struct Batch
+    {
+        const JobSystem::RangeFn* fn = nullptr;
+        std::size_t count = 0;
+        std::size_t grain = 1;
+        std::size_t chunks = 0;
+        std::atomic<std::size_t> next{ 0 };  // 次に取るチャンク番号
+        std::atomic<std::size_t> done{ 0 };  // 完了したチャンク数
+        std::mutex              m;
+        std::condition_variable cv;
+
+        // 取れるだけチャンクを処理する
+        void Drain()
+        {
+            for (;;)
+            {
+                const std::size_t c = next.fetch_add(1, std::memory_order_relaxed);
+                if (c >= chunks) return;
+                const std::size_t begin = c * grain;
+                const std::size_t end = (begin + grain < count) ? begin + grain : count;
+                (*fn)(begin, end);
+                if (done.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks)
+                {
+                    std::lock_guard<std::mutex> lk(m);
+                    cv.notify_all();
+                }
+            }
+        }
+    };
+
+    class Pool
+    {
+    public:
+        Pool()
+        {
+            const unsigned hw = std::thread::hardware_concurrency();
+            const unsigned n = (hw > 1) ? hw - 1 : 0;
+            m_threads.reserve(n);
+            for (unsigned i = 0; i < n; ++i)
+                m_threads.emplace_back([this] { WorkerLoop(); });
+        }
+
+        ~Pool()
+        {
+            {
+                std::lock_guard<std::mutex> lk(m_mutex);
+                m_quit = true;
+            }
+            m_cv.notify_all();
+            for (auto& t : m_threads) t.join();
+        }
+
+        unsigned ThreadCount() const { return static_cast<unsigned>(m_threads.size()); }
+
+        void Submit(const std::shared_ptr<Batch>& b, unsigned tickets)
+        {
+            {
+                std::lock_guard<std::mutex> lk(m_mutex);
+                for (unsigned i = 0; i < tickets; ++i) m_queue.push_back(b);
+            }
+            if (tickets == 1) m_cv.notify_one();
+            else              m_cv.notify_all();
+        }
+
+    private:
+        void WorkerLoop()
+        {
+            for (;;)
+            {
+                std::shared_ptr<Batch> b;
+                {
+                    std::unique_lock<std::mutex> lk(m_mutex);
+                    m_cv.wait(lk, [this] { return m_quit || !m_queue.empty(); });
+                    if (m_quit && m_queue.empty()) return;
+                    b = std::move(m_queue.front());
+                    m_queue.pop_front();
+                }
+                b->Drain();
+            }
+        }
+
+        std::vector<std::thread>           m_threads;
+        std::deque<std::shared_ptr<Batch>> m_queue;
+        std::mutex                         m_mutex;
+        std::condition_variable            m_cv;
+        bool                               m_quit = false;
+    };
+
+    Pool& GetPool()
+    {
+        static Pool s_pool; // 初回使用時に生成、プロセス終了時に join
+        return s_pool;
+    }
+}
+
+void JobSystem::ParallelFor(std::size_t count, std::size_t grain, const RangeFn& fn)
+{
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+
+    const std::size_t chunks = (count + grain - 1) / grain;
+    Pool& pool = GetPool();
+    if (chunks <= 1 || pool.ThreadCount() == 0)
+    {
+        fn(0, count); // 分割の意味がない → その場で実行
+        return;
+    }
+
+    auto b = std::make_shared<Batch>();
+    b->fn = &fn;
+    b->count = count;
+    b->grain = grain;
+    b->chunks = chunks;
+
+    // 参加チケットは「チャンク数 - 1（自分の分）」とワーカー数の小さい方
+    const std::size_t want = chunks - 1;
+    const unsigned tickets = static_cast<unsigned>(
+        (want < pool.ThreadCount()) ? want : pool.ThreadCount());
+    pool.Submit(b, tickets);
+
+    // 呼び出しスレッドも処理に参加
+    b->Drain();
+
+    // 他の参加者が持っているチャンクの完了を待つ
+    std::unique_lock<std::mutex> lk(b->m);
+    b->cv.wait(lk, [&] { return b->done.load(std::memory_order_acquire) == chunks; });
+}
+
+unsigned JobSystem::WorkerCount()
+{
+    return GetPool().ThreadCount() + 1;
+}
@@ -0,0 +1,38 @@
+﻿#pragma once
+#include <cstddef>
+#include <functional>
+
+// ============================================================================
+// JobSystem
+// ----------------------------------------------------------------------------
+// 役割：
+//   - CPU 側の重い処理（BVH 構築、カリング、コマンド記録など）を
+//     ワーカースレッドに分配するための最小のスレッドプール。
+// 使い方：
+//   JobSystem::ParallelFor(count, grain, [&](size_t begin, size_t end) { ... });
+//     - [0, count) を grain 個ずつのチャンクに分け、ワーカーと呼び出しスレッドで処理
+//     - すべてのチャンクが終わるまで戻らない（同期 API）
+// 注意：
+//   - ワーカーは初回使用時に (論理コア数 - 1) 本だけ生成し、プロセス終了時に join する。
+//   - ParallelFor の入れ子呼び出しは可能（内側は呼び出しスレッドでも処理されるので詰まらない）。
+//   - チャンク関数の中で例外を投げないこと（捕捉しない）。
+// ============================================================================
+class JobSystem
+{
+public:
+    using RangeFn = std::function<void(std::size_t begin, std::size_t end)>;
+
+    // ------------------------------------------------------------------------
+    // ParallelFor
+    //  - [0, count) を grain 単位で分割して並列実行（grain=0 は 1 とみなす）
+    //  - チャンク数が 1 以下ならその場で直接実行（スレッド切替コストを払わない）
+    // ------------------------------------------------------------------------
+    static void ParallelFor(std::size_t count, std::size_t grain, const RangeFn& fn);
+
+    // ------------------------------------------------------------------------
+    // WorkerCount
+    //  - 呼び出しスレッドを含めた同時実行数（= ワーカー数 + 1）
+    //  - 分割数の目安に使う
+    // ------------------------------------------------------------------------
+    static unsigned WorkerCount();
+};
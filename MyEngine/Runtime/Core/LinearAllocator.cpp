@@ -0,0 +1,63 @@
+﻿#include "Core/LinearAllocator.h"
+#include <algorithm>
+#include <cstdint>
+
+// ============================================================================
+// LinearAllocator 実装
+// ----------------------------------------------------------------------------
+// ・ブロックは倍々で増やす（足りない分より小さければ必要量ぴったり）。
+// ・Reset 時に複数ブロックあれば合計サイズで 1 ブロックに作り直す
+//   → 次フレームからは同じ使用量なら 1 ブロック内で収まり、追加確保が起きない。
+// ============================================================================
+
+LinearAllocator::LinearAllocator(std::size_t initialBytes)
+{
+    if (initialBytes > 0) AddBlock(initialBytes);
+}
+
+void LinearAllocator::AddBlock(std::size_t minBytes)
+{
+    const std::size_t last = m_blocks.empty() ? 0 : m_blocks.back().size;
+    Block b;
+    b.size = std::max(minBytes, last * 2);
+    b.data.reset(new unsigned char[b.size]);
+    m_capacity += b.size;
+    m_blocks.push_back(std::move(b));
+    m_offset = 0;
+}
+
+void* LinearAllocator::Allocate(std::size_t bytes, std::size_t align)
+{
+    if (bytes == 0) bytes = 1; // 0 バイトでも別アドレスを返す
+
+    for (;;)
+    {
+        if (!m_blocks.empty())
+        {
+            Block& b = m_blocks.back();
+            const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(b.data.get());
+            const std::uintptr_t p = (base + m_offset + (align - 1)) & ~(std::uintptr_t)(align - 1);
+            const std::size_t end = static_cast<std::size_t>(p - base) + bytes;
+            if (end <= b.size)
+            {
+                m_used += end - m_offset;
+                m_offset = end;
+                return reinterpret_cast<void*>(p);
+            }
+        }
+        AddBlock(bytes + align); // アライン分の余裕を足して確保し直す
+    }
+}
+
+void LinearAllocator::Reset()
+{
+    if (m_blocks.size() > 1)
+    {
+        const std::size_t total = m_capacity;
+        m_blocks.clear();
+        m_capacity = 0;
+        AddBlock(total);
+    }
+    m_offset = 0;
+    m_used = 0;
+}
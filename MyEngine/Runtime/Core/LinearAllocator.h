@@ -0,0 +1,64 @@
+﻿#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// ============================================================================
+// LinearAllocator
+// ----------------------------------------------------------------------------
+// 役割：
+//   - 1 フレーム（1 パス）だけ生きる作業データ用のバンプアロケータ。
+//     ポインタを進めるだけで確保し、Reset() でまとめて捨てる（個別解放なし）。
+//   - 描画リストやソート用バッファなど、毎フレーム作り直す配列の new/delete をなくす。
+// 使い方：
+//   arena.Reset();
+//   T* a = arena.Allocate<T>(n);   // 中身は未初期化（POD 前提）
+// 注意：
+//   - デストラクタは呼ばない。トリビアルに破棄できる型だけに使うこと。
+//   - 容量が足りなくなったら新しいブロックを足す（既存ポインタは無効にならない）。
+//     次の Reset() で合計サイズの 1 ブロックにまとめ直すので、定常状態では確保が起きない。
+//   - スレッドセーフではない（スレッドごとに持つ）。
+// ============================================================================
+class LinearAllocator
+{
+public:
+    explicit LinearAllocator(std::size_t initialBytes = 64 * 1024);
+
+    // ------------------------------------------------------------------------
+    // Allocate
+    //  - bytes バイトを align 境界で確保する（align は 2 の冪）
+    // ------------------------------------------------------------------------
+    void* Allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t));
+
+    template <class T>
+    T* Allocate(std::size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "LinearAllocator does not run destructors");
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    // ------------------------------------------------------------------------
+    // Reset
+    //  - すべての確保を破棄する。前回ブロックが複数に分かれていたら 1 つにまとめる。
+    // ------------------------------------------------------------------------
+    void Reset();
+
+    std::size_t Used() const { return m_used; }         ///< 直近 Reset 以降に確保したバイト数（パディング込み）
+    std::size_t Capacity() const { return m_capacity; } ///< 保持しているブロックの合計バイト数
+
+private:
+    struct Block
+    {
+        std::unique_ptr<unsigned char[]> data;
+        std::size_t                      size = 0;
+    };
+
+    void AddBlock(std::size_t minBytes);
+
+    std::vector<Block> m_blocks;     // 末尾が現在のブロック
+    std::size_t        m_offset = 0; // 現在ブロック内の次の位置
+    std::size_t        m_used = 0;
+    std::size_t        m_capacity = 0;
+};
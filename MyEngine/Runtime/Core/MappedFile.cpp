@@ -0,0 +1,149 @@
+﻿#include "MappedFile.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdint>
+#include <filesystem>
+#endif
+#include <utility>
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_file(std::exchange(other.m_file, nullptr))
+    , m_mapping(std::exchange(other.m_mapping, nullptr))
+    , m_data(std::exchange(other.m_data, nullptr))
+    , m_size(std::exchange(other.m_size, 0))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        Close();
+        m_file = std::exchange(other.m_file, nullptr);
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+    }
+    return *this;
+}
+
+bool MappedFile::Open(const wchar_t* path)
+{
+    Close();
+    if (!path) return false;
+
+    // 先読みのヒント（SEQUENTIAL_SCAN）：頭から順になめる用途なのでキャッシュマネージャに伝える
+    HANDLE file = CreateFileW(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < 0
+        || static_cast<unsigned long long>(size.QuadPart) > static_cast<unsigned long long>(SIZE_MAX))
+    {
+        CloseHandle(file);
+        return false;
+    }
+    m_file = file;
+    if (size.QuadPart == 0) return true; // 空ファイルはマップできない（サイズ 0 のまま成功扱い）
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        Close();
+        return false;
+    }
+    m_mapping = mapping;
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        Close();
+        return false;
+    }
+    m_data = static_cast<const std::uint8_t*>(view);
+    m_size = static_cast<std::size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(m_mapping);
+    if (m_file) CloseHandle(m_file);
+    m_data = nullptr;
+    m_mapping = nullptr;
+    m_file = nullptr;
+    m_size = 0;
+}
+
+#else // POSIX
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_fd(std::exchange(other.m_fd, -1))
+    , m_data(std::exchange(other.m_data, nullptr))
+    , m_size(std::exchange(other.m_size, 0))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        Close();
+        m_fd = std::exchange(other.m_fd, -1);
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+    }
+    return *this;
+}
+
+bool MappedFile::Open(const wchar_t* path)
+{
+    Close();
+    if (!path) return false;
+
+    const int fd = ::open(std::filesystem::path(path).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size < 0
+        || static_cast<unsigned long long>(st.st_size) > static_cast<unsigned long long>(SIZE_MAX))
+    {
+        ::close(fd);
+        return false;
+    }
+    m_fd = fd;
+    if (st.st_size == 0) return true; // 空ファイルはマップできない（サイズ 0 のまま成功扱い）
+
+    const std::size_t size = static_cast<std::size_t>(st.st_size);
+    void* view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED)
+    {
+        Close();
+        return false;
+    }
+    // 先読みのヒント（Windows の SEQUENTIAL_SCAN と同じ。効かなくても読むのには困らない）
+    ::posix_madvise(view, size, POSIX_MADV_SEQUENTIAL);
+    m_data = static_cast<const std::uint8_t*>(view);
+    m_size = size;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data) ::munmap(const_cast<std::uint8_t*>(m_data), m_size);
+    if (m_fd >= 0) ::close(m_fd);
+    m_data = nullptr;
+    m_fd = -1;
+    m_size = 0;
+}
+
+#endif
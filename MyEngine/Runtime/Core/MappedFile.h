@@ -0,0 +1,62 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// ============================================================================
+// MappedFile
+// ----------------------------------------------------------------------------
+// 役割：
+//   - ファイルを読み取り専用でメモリにマップし、先頭ポインタとサイズを渡す。
+//     ReadFile で丸ごとコピーする代わりに OS のページキャッシュをそのまま読む
+//     （メッシュの読み込みなど、大きなファイルを 1 回なめるだけの用途向け）。
+//   - Windows は CreateFileMapping/MapViewOfFile、それ以外（テストを回す Linux 等）は
+//     open/mmap。パスは wchar_t のまま受け取り、POSIX では UTF-8 に直して開く。
+// 使い方：
+//   MappedFile file;
+//   if (file.Open(L"model.obj")) Parse(file.Data(), file.Size());
+// 注意：
+//   - 中身は読み取り専用。書き込むとアクセス違反になる。
+//   - 空のファイルは Open に成功し、Data() = nullptr / Size() = 0 になる。
+//   - ポインタは Close（またはデストラクタ）まで有効。コピー不可、ムーブ可。
+// ============================================================================
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // ------------------------------------------------------------------------
+    // Open
+    //  - path を開いてマップする（開いていたものは閉じる）。失敗したら false
+    // ------------------------------------------------------------------------
+    bool Open(const wchar_t* path);
+
+    // ------------------------------------------------------------------------
+    // Close
+    //  - マップを外してハンドルを閉じる（開いていなければ何もしない）
+    // ------------------------------------------------------------------------
+    void Close();
+
+#ifdef _WIN32
+    bool                IsOpen() const { return m_file != nullptr; }
+#else
+    bool                IsOpen() const { return m_fd >= 0; }
+#endif
+    const std::uint8_t* Data() const { return m_data; }
+    std::size_t         Size() const { return m_size; }
+
+private:
+#ifdef _WIN32
+    void*               m_file = nullptr;    // ファイルハンドル（HANDLE）
+    void*               m_mapping = nullptr; // ファイルマッピングオブジェクト（空ファイルでは nullptr）
+#else
+    int                 m_fd = -1;           // ファイル記述子
+#endif
+    const std::uint8_t* m_data = nullptr;
+    std::size_t         m_size = 0;
+};
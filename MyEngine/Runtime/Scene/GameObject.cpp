@@ -1,30 +1,30 @@
 // GameObject.cpp
 //------------------------------------------------------------------------------
-// FV[̃GeBeBim[hj\ GameObject ̎B
-//       - eqic[j\̊ǗiAddChild / RemoveChildj
-//       - Activeiȁj ActiveInHierarchyij̈
-//       - Component Q̃CtTCN (Awake/OnEnable/Start/Update/LateUpdate/OnDisable/OnDestroy)
-//       - jt[iDestroyj
-// ݌vF
-//   * GameObject  shared_ptr Ǘie: weak_ptrjŏzQƂ
-//   * TransformComponent ͕K{BCreate() t@NgňSɕt^ictor ł͕t^Ȃj
-//   * CtTCŃujBvFAddComponent   AwakeAActiveInHierarchy Ȃ瑦 OnEnableB
-//     Start ́uŏ Update Ovɒxs
-//   * ActiveInHierarchyi= ȂL && e ActiveInHierarchyjω̂ OnEnable/OnDisable 𔭉
-//   * RemoveChild q Scene ̃[g֖߂iBs\IuWFNgȂj
+// 役割：シーン内のエンティティ（ノード）を表す GameObject の実装。
+//       - 親子（ツリー）構造の管理（AddChild / RemoveChild）
+//       - Active（自己）と ActiveInHierarchy（実効）の扱い
+//       - Component 群のライフサイクル (Awake/OnEnable/Start/Update/LateUpdate/OnDisable/OnDestroy)
+//       - 破棄フロー（Destroy）
+// 設計メモ：
+//   * GameObject は shared_ptr 管理（親: weak_ptr）で循環参照を回避
+//   * TransformComponent は必須。Create() ファクトリで安全に付与（ctor では付与しない）
+//   * ライフサイクルは「方針B」：AddComponent → 即 Awake、ActiveInHierarchy なら即 OnEnable。
+//     Start は「最初の Update 直前」に遅延実行
+//   * ActiveInHierarchy（= 自己が有効 && 親が ActiveInHierarchy）変化時のみ OnEnable/OnDisable を発火
+//   * RemoveChild した子は Scene のルートへ戻す（到達不能オブジェクトを作らない）
 //------------------------------------------------------------------------------
 
-#include "GameObject.h"              // GameObject NX̒`
-#include "Scene.h"                   // Scene ւ̓o^/Ɖ
-#include "Components/Component.h"    // R|[lg
+#include "GameObject.h"              // GameObject クラスの定義
+#include "Scene.h"                   // Scene への登録/照会
+#include "Components/Component.h"    // 基底コンポーネント
 #include "Components/TransformComponent.h"
 #include <algorithm>                 // std::remove
 
 // ============================================================================
-// wp[iǂ݂₷̂߂̏j
+// 内部ヘルパー（読みやすさのための小道具）
 // ============================================================================
 namespace {
-    // remove-erase CfBIǂ݂₷܂Ƃ߂
+    // remove-erase イディオムを読みやすくまとめる
     template<class T, class U>
     void erase_remove(T& v, const U& value) {
         v.erase(std::remove(v.begin(), v.end(), value), v.end());
@@ -32,74 +32,74 @@ namespace {
 }
 
 // ============================================================================
-// Createit@Ngj
-//  - OSꊇAP[V̂ make_shared gp
-//  - TransformComponent ͕K{Ȃ̂ŁAŊmɕt^
-//  - ctor ł shared_from_this() gȂ߁A AddComponent ݌v
+// Create（ファクトリ）
+//  - 例外安全＆一括アロケーションのため make_shared を使用
+//  - TransformComponent は必須なので、ここで確実に付与する
+//  - ctor では shared_from_this() が使えないため、ここで AddComponent する設計
 // ============================================================================
 std::shared_ptr<GameObject> GameObject::Create(const std::string& name)
 {
-    auto go = std::make_shared<GameObject>(name);           // LLɏ悹
-    go->Transform = go->AddComponent<TransformComponent>(); // K{ Transform 𑦕t^
+    auto go = std::make_shared<GameObject>(name);           // 共有所有に乗せる
+    go->Transform = go->AddComponent<TransformComponent>(); // 必須 Transform を即付与
     return go;
 }
 
 // ============================================================================
 // ctor / dtor
-//  - ctorFTransform ͕t^ȂiCreate() ňSɕt^j
-//  - dtorFq̐eQƁiweakj؂邾BOnDestroy  Destroy() ōs
+//  - ctor：Transform は付与しない（Create() 内で安全に付与）
+//  - dtor：子の親参照（weak）を切るだけ。OnDestroy は Destroy() で行う
 // ============================================================================
 GameObject::GameObject(const std::string& name)
     : Name(name)
 {
-    // ́uԁiActiveInHierarchyjvLbV
-    // ieȂȗLlȂ̂ true j
+    // 生成直後の「実効状態（ActiveInHierarchy）」キャッシュ
+    // （親なし＆自己有効が初期値なので true 相当）
     m_LastActiveInHierarchy = IsActive();
 }
 
 GameObject::~GameObject()
 {
-    // q̐eQƁiweak_ptrjNAiL shared_ptr j
+    // 子の親参照（weak_ptr）をクリア（所有は shared_ptr 側）
     for (const auto& child : m_Children) {
         child->m_Parent.reset();
     }
 }
 
 // ============================================================================
-// Updateit[Ăяoj
-// F
-//   1) jς or ANeBuKwȂ瑁 return
-//   2) q UpdateieqBTransform ˑRj
-//   3) g̃R|[lg UpdateiStart ͏̂ / LȂ̂̂݁j
-//   4) g̃R|[lg LateUpdateiLȂ̂̂݁j
+// Update（毎フレーム呼び出し）
+// 処理順：
+//   1) 破棄済み or 非アクティブ階層なら早期 return
+//   2) 子の Update（親→子。Transform 依存が自然）
+//   3) 自身のコンポーネント Update（Start は初回のみ / 有効なもののみ）
+//   4) 自身のコンポーネント LateUpdate（有効なもののみ）
 // ============================================================================
 void GameObject::Update(float deltaTime)
 {
-    // IɔANeBuȂ牽Ȃ
+    // 実効的に非アクティブなら何もしない
     if (m_Destroyed || !IsActive()) return;
 
-    // --- qIuWFNg̍XVie  qj ---
+    // --- 子オブジェクトの更新（親 → 子） ---
     for (auto& child : m_Children) {
         child->Update(deltaTime);
     }
 
-    // --- R|[lg̍XV ---
+    // --- コンポーネントの更新 ---
     for (auto& comp : m_Components) {
         if (!comp) continue;
 
-        // Start ́uLvu܂ Start ς݂łȂvAŏ Update ̒O 1 񂾂
+        // Start は「有効」かつ「まだ Start 済みでない」時、最初の Update の直前に 1 回だけ
         if (!comp->HasStarted() && comp->IsEnabled() && IsActive()) {
             comp->Start();
             comp->MarkStarted();
         }
 
-        // t[ UpdateiLANeBuj
+        // 毎フレームの Update（有効＆実効アクティブ）
         if (comp->IsEnabled() && IsActive()) {
             comp->Update(deltaTime);
         }
     }
 
-    // --- LateUpdatei Update j ---
+    // --- LateUpdate（順序は Update 後） ---
     for (auto& comp : m_Components) {
         if (comp && comp->IsEnabled()) {
             comp->LateUpdate(deltaTime);
@@ -109,37 +109,37 @@ void GameObject::Update(float deltaTime)
 
 // ============================================================================
 // AddChild
-//  - qɂΏۂɌ̐e΁A܂炩Oiǎh~j
-//  - eq֌W̕ύX ActiveInHierarchy ɉe  Kp OnEnable/OnDisable 𐳂
-//  - Transform ̐eq𓯊ꍇ́AvWFNgjɍ킹Ăōs
+//  - 子にする対象に元の親がいれば、まずそちらから取り外す（孤児化防止）
+//  - 親子関係の変更は ActiveInHierarchy に影響 → 差分適用で OnEnable/OnDisable を正しく発火
+//  - Transform の親子を同期したい場合は、プロジェクト方針に合わせてここで行う
 // ============================================================================
 void GameObject::AddChild(std::shared_ptr<GameObject> child)
 {
-    // ǉÓuq̎ԁvۑiɎgpj
+    // 追加直前の「子の実効状態」を保存（差分判定に使用）
     const bool prevChildHier = child->IsActive();
 
-    // ̐eOiRemoveChild  g[g߂ + Kph s݌vj
+    // 既存の親から取り外す（RemoveChild は “ルート戻し + 差分適用” を行う設計）
     if (auto oldParent = child->m_Parent.lock()) {
         oldParent->RemoveChild(child);
     }
 
-    // ̎qƂēo^AeQƂ𒣂
+    // 自分の子として登録し、親参照を張る
     m_Children.push_back(child);
     child->m_Parent = shared_from_this();
 
-    // Transform ̐eq֌W𓯊ꍇ͂Ŏ{
-    // : child->Transform->SetParent(Transform.get());
+    // Transform の親子関係を同期したい場合はここで実施
+    // 例: child->Transform->SetParent(Transform.get());
 
-    // eςʁAq ActiveInHierarchy ςȂ獷Kp
+    // 親が変わった結果、子の ActiveInHierarchy が変わるなら差分適用
     child->RefreshActiveInHierarchyRecursive(prevChildHier);
 }
 
 // ============================================================================
 // RemoveChild
-//  - ̎qz񂩂珜OAeQƂNA
-//  - ueOꂽ Scene ̃[g֖߂v|V[œB\ێ
-//  - ActiveInHierarchy ω獷KpiOnEnable/OnDisablej
-//  - Reparentitւj AddChild łs߁A2ω_ɒ
+//  - 自分の子配列から除外し、親参照をクリア
+//  - 「親から外れたら Scene のルートへ戻す」ポリシーで到達可能性を維持
+//  - ActiveInHierarchy が変化したら差分適用（OnEnable/OnDisable）
+//  - Reparent（付け替え）時は AddChild 側でも差分を行うため、続けて2回変化しうる点に注意
 // ============================================================================
 void GameObject::RemoveChild(std::shared_ptr<GameObject> child)
 {
@@ -148,49 +148,49 @@ void GameObject::RemoveChild(std::shared_ptr<GameObject> child)
     erase_remove(m_Children, child);
     child->m_Parent.reset();
 
-    // [g֖߂iScene ǗɎcj
+    // ルートへ戻す（Scene 管理下に残す）
     if (auto scene = child->m_Scene.lock()) {
-        scene->AddGameObject(child, nullptr); // e nullptr  [go^
+        scene->AddGameObject(child, nullptr); // 親 nullptr → ルート登録
     }
 
-    // Ԃ̍KpiCxg΁j
+    // 実効状態の差分適用（イベント発火）
     child->RefreshActiveInHierarchyRecursive(prevChildHier);
 }
 
 // ============================================================================
-// SetActiveiȃtO̐ؑցj
-//  |V[F
-//    - q activeSelf ͕ύXȂiUnity ƓljBe̖ŎɂȂ
-//    - OnEnable/OnDisable  ActiveInHierarchy ̕ω̂ݔ
-//    - Scene Ǘi[gzjƂ̐Ƃi{GWjj
-//       Unity ƈႢuANeBu  ΏۂOvjɂĂ
+// SetActive（自己フラグの切替）
+//  ポリシー：
+//    - 子の activeSelf は変更しない（Unity と同様）。親の無効化で実効も無効になる
+//    - OnEnable/OnDisable は ActiveInHierarchy の変化時のみ発火
+//    - Scene 管理（ルート配列）との整合をとる（本エンジン方針）
+//      ※ Unity と違い「非アクティブ → 巡回対象から外す」方針にしている例
 // ============================================================================
 void GameObject::SetActive(bool active)
 {
-    // ύXO̎Ԃ擾ipj
+    // 変更前の実効状態を取得（差分判定用）
     const bool prevHier = IsActive();
 
-    // łɓԂȂ Scene Ƃ̐yďI
+    // すでに同じ状態なら Scene 側との整合を軽く取って終了
     if (m_Active == active) {
         if (auto scene = m_Scene.lock()) {
             if (m_Active) {
-                // [gzɑ݂ȂΒǉ
+                // ルート配列に存在しなければ追加
                 if (!scene->ContainsRootGameObject(shared_from_this())) {
                     scene->AddGameObject(shared_from_this());
                 }
             }
             else {
-                // ANeBuȂ珄ΏۂOijj
+                // 非アクティブなら巡回対象から外す（方針次第）
                 scene->RemoveGameObject(shared_from_this());
             }
         }
         return;
     }
 
-    // ȃtOؑ
+    // 自己フラグを切替
     m_Active = active;
 
-    // Scene Ǘ֔f
+    // Scene 管理へ反映
     if (auto scene = m_Scene.lock()) {
         if (m_Active) {
             if (!scene->ContainsRootGameObject(shared_from_this())) {
@@ -202,15 +202,15 @@ void GameObject::SetActive(bool active)
         }
     }
 
-    // Ԃ̍q֓`diOnEnable/OnDisable 𐳂΁j
+    // 実効状態の差分を自分→子へ伝播（OnEnable/OnDisable を正しく発火）
     RefreshActiveInHierarchyRecursive(prevHier);
 }
 
 // ============================================================================
-// IsActiveiActiveInHierarchy j
-//  - ȂȂ false
-//  - eΐe ActiveInHierarchy ɏ]
-//  - [gȂ玩Ȃ activeSelf ̂܂܎
+// IsActive（ActiveInHierarchy 相当）
+//  - 自己が無効なら false
+//  - 親があれば親の ActiveInHierarchy に従う
+//  - ルートなら自己の activeSelf がそのまま実効
 // ============================================================================
 bool GameObject::IsActive() const
 {
@@ -218,21 +218,21 @@ bool GameObject::IsActive() const
     if (auto parent = m_Parent.lock()) {
         return parent->IsActive();
     }
-    return true; // eȂi[gj
+    return true; // 親なし（ルート）
 }
 
 // ============================================================================
-// Destroyipj
-//  - LȃR|[lg OnDisable ɒʒm  ̌ OnDestroy
-//  - qċAI Destroy
-//  - Scene/Parent ̐؂藣 Scene ̔jt[ōsïꌳǗj
+// Destroy（冪等）
+//  - 有効なコンポーネントに OnDisable を先に通知 → その後 OnDestroy
+//  - 子も再帰的に Destroy
+//  - Scene/Parent からの切り離しは Scene 側の破棄フローで行う（順序の一元管理）
 // ============================================================================
 void GameObject::Destroy()
 {
     if (m_Destroyed) return;
     m_Destroyed = true;
 
-    // LR|[lg͐ OnDisable
+    // 有効だったコンポーネントは先に OnDisable
     if (IsActive()) {
         for (auto& comp : m_Components) {
             if (comp && comp->IsEnabled()) {
@@ -241,13 +241,13 @@ void GameObject::Destroy()
         }
     }
 
-    // ̌ OnDestroy
+    // その後 OnDestroy
     for (auto& comp : m_Components) {
         if (comp) comp->OnDestroy();
     }
     m_Components.clear();
 
-    // qlɔjiċAj
+    // 子も同様に破棄（再帰）
     for (auto& child : m_Children) {
         child->Destroy();
     }
@@ -256,8 +256,8 @@ void GameObject::Destroy()
 
 // ============================================================================
 // Render
-//  - IɔANeBuȂ`悵Ȃ
-//  - e`nR|[lg Renderer ɑ΂ĕ`vsO
+//  - 実効的に非アクティブなら描画しない
+//  - 各描画系コンポーネントが Renderer に対して描画要求を行う前提
 // ============================================================================
 void GameObject::Render(D3D12Renderer* renderer)
 {
@@ -271,48 +271,48 @@ void GameObject::Render(D3D12Renderer* renderer)
     }
 }
 
-// ============================ wp[ ===========================
+// ============================ ここから内部ヘルパー ===========================
 
-// ݂ ActiveInHierarchy ĕ]ĕԂiIsActive Ɠ`Ӑ}mj
+// 現在の ActiveInHierarchy を再評価して返す（IsActive と同義だが意図明確化）
 bool GameObject::ComputeActiveInHierarchy() const
 {
     return IsActive();
 }
 
-// ActiveInHierarchy ̕ωɓKpiOnEnable/OnDisable ΁LbVXVj
+// ActiveInHierarchy の変化を自分に適用（OnEnable/OnDisable 発火＆キャッシュ更新）
 void GameObject::ApplyActiveInHierarchyDelta(bool wasActiveInHierarchy, bool nowActiveInHierarchy)
 {
     if (wasActiveInHierarchy == nowActiveInHierarchy) {
-        return; // ωȂ  Ȃ
+        return; // 変化なし → 何もしない
     }
 
     if (nowActiveInHierarchy) {
-        // IɗLɂȂFLȃR|[lg OnEnable
+        // 実効的に有効になった：有効なコンポーネントへ OnEnable
         for (auto& comp : m_Components) {
             if (comp && comp->IsEnabled()) comp->OnEnable();
         }
     }
     else {
-        // IɖɂȂFLȃR|[lg OnDisable
+        // 実効的に無効になった：有効なコンポーネントへ OnDisable
         for (auto& comp : m_Components) {
             if (comp && comp->IsEnabled()) comp->OnDisable();
         }
     }
 
-    // LbVŐViq̍Kp prev Ƃēnj
+    // キャッシュを最新化（子の差分適用時に prev として渡す）
     m_LastActiveInHierarchy = nowActiveInHierarchy;
 }
 
-// Ɣzic[Śjɂ ActiveInHierarchy ̍Kp
-// @param prevOfThis : ĂяoOɂũm[hgv̎
+// 自分と配下（ツリー全体）について ActiveInHierarchy の差分を適用
+// @param prevOfThis : 呼び出し直前における「このノード自身」の実効状態
 void GameObject::RefreshActiveInHierarchyRecursive(bool prevOfThis)
 {
     const bool now = ComputeActiveInHierarchy();
 
-    // ܂ɓKpi m_LastActiveInHierarchy XVj
+    // まず自分に適用（ここで m_LastActiveInHierarchy が更新される）
     ApplyActiveInHierarchyDelta(prevOfThis, now);
 
-    // qւ́uꂼ̒OԁiLbVjv prev ƂēnAċAKp
+    // 子へは「それぞれの直前状態（キャッシュ）」を prev として渡し、再帰適用
     for (auto& ch : m_Children) {
         if (!ch) continue;
         const bool childPrev = ch->m_LastActiveInHierarchy;
@@ -1,5 +1,5 @@
 #pragma once
-// dCN[hh~BSceneManager ́u Scene ̓o^EؑցEXVvSʃCB
+// 多重インクルード防止。SceneManager は「複数 Scene の登録・切替・更新」を担う上位レイヤ。
 
 #include <memory>
 #include <string>
@@ -10,61 +10,61 @@
 // ============================================================================
 // SceneManager
 // ----------------------------------------------------------------------------
-// E Scene 𖼑OŊǗiǉ/폜jAũ݂ANeBu ScenevێB
-// EQ[[v͊{I SceneManager::Update() Ăׂ΂悢B
-// EzQƂ邽߁AANeBu Scene  weak_ptr ŕێi擾 lockjB
-// ESwitchScene ͎QƂ̍ւ̂݁i/VV[ OnDisable/OnEnable Ȃǂ
-//   vWFNgjɉĊg|CgőΉjB
+// ・複数の Scene を名前で管理（追加/削除）し、「現在のアクティブ Scene」を保持する。
+// ・ゲームループからは基本的に SceneManager::Update() だけ呼べばよい。
+// ・循環参照を避けるため、アクティブ Scene は weak_ptr で保持（取得時に lock）。
+// ・SwitchScene は参照の差し替えのみ（旧/新シーンの OnDisable/OnEnable などは
+//   プロジェクト方針に応じて拡張ポイントで対応）。
 // ============================================================================
 class SceneManager
 {
 public:
     //--------------------------------------------------------------------------
     // AddScene
-    // Scene 𖼑OiL[jœo^B
-    // - L[݂ꍇ͏㏑B
+    // Scene を名前（キー）で登録する。
+    // - 同名キーが存在する場合は上書き。
     //--------------------------------------------------------------------------
     void AddScene(const std::string& name, std::shared_ptr<Scene> scene);
 
     //--------------------------------------------------------------------------
     // RemoveScene
-    // o^ς݂ Scene 폜B
-    // - name Ȃꍇ͉ȂB
-    // - ܂ANeBuƂĎQƂĂꍇAGetActiveScene()  nullptr Ԃ\B
-    //   iKvȂ SwitchScene Őɕ Scene ֐ؑւĂĂԁj
+    // 登録済みの Scene を削除する。
+    // - name が見つからない場合は何もしない。
+    // - まだアクティブとして参照されている場合、GetActiveScene() は nullptr を返す可能性がある。
+    //   （必要なら SwitchScene で先に別 Scene へ切替えてから呼ぶ）
     //--------------------------------------------------------------------------
     void RemoveScene(const std::string& name);
 
     //--------------------------------------------------------------------------
     // SwitchScene
-    // w薼 Scene uANeBuvɂB
-    // - o^ĂȂΉȂB
-    // - ł͋V[̏I/VV[͍̏sȂig|CgjB
-    //   F->V SetActive ̐ؑւsꍇ͖{\bhŎ{B
+    // 指定名の Scene を「アクティブ」にする。
+    // - 登録されていなければ何もしない。
+    // - ここでは旧シーンの終了処理/新シーンの初期化は行わない（拡張ポイント）。
+    //   例：旧->新で SetActive の切替を行いたい場合は本メソッド内で実施する。
     //--------------------------------------------------------------------------
     void SwitchScene(const std::string& name);
 
     //--------------------------------------------------------------------------
     // GetActiveScene
-    // ݃ANeBu Scene 擾B
-    // -  weak_ptrB/폜ς݂Ȃ nullptr ԂB
+    // 現在アクティブな Scene を取得する。
+    // - 内部は weak_ptr。無効化/削除済みなら nullptr を返す。
     //--------------------------------------------------------------------------
     std::shared_ptr<Scene> GetActiveScene() const;
 
     //--------------------------------------------------------------------------
     // Update
-    // ANeBu Scene  Update ϏB
-    // - Q[[v疈t[ĂяozB
-    // @param deltaTime : Ot[̌oߎԁibj
+    // アクティブ Scene があれば Update を委譲する。
+    // - ゲームループから毎フレーム呼び出す想定。
+    // @param deltaTime : 前フレームからの経過時間（秒）
     //--------------------------------------------------------------------------
     void Update(float deltaTime);
 
 private:
-    //======================= Ǘpo =======================
-    // o^ς݂ Scene ꗗiL[FOj
+    //======================= 管理用メンバ =======================
+    // 登録済みの Scene 一覧（キー：名前）
     std::unordered_map<std::string, std::shared_ptr<Scene>> m_Scenes;
 
-    // ݂̃ANeBu SceneizQƉ̂ߎQƁj
-    // - QƐ؂̉\邽߁Agp͕K lock() Ă`FbNB
+    // 現在のアクティブ Scene（循環参照回避のため弱参照）
+    // - 参照切れの可能性があるため、使用時は必ず lock() してからチェック。
     std::weak_ptr<Scene> m_CurrentScene;
 };
@@ -1,28 +1,32 @@
 // ============================================================================
 // main.cpp
-// ړI:
-//   - ŏ D3D12 _OŁAV[/Q[IuWFNg/R|[lg
-//     ǂ̏ŏEXVE`悷邩]ł悤ɂB
-// :
-//   - |V[: AddComponent()  Awake/OnEnable ĂԁiScene ł Awake Ă΂Ȃj
-//   - GameObject  GameObject::Create() t@NgŐishared_from_this Sj
-//   - EBhÉuOgTCYvƁuNCAgTCYv𖾊mɕ
-//   - NCAgTCYXbv`FC/JAXyNg\ziYh~j
-//   - Tv: L[/}EX́A2bƂ Active ؑցAȒPȈړR|[lg
+// 目的:
+//   - 最小限の D3D12 レンダリング環境で、シーン/ゲームオブジェクト/コンポーネントを
+//     どの順で初期化・更新・描画するかを一望できるようにする。
+// 特徴:
+//   - ポリシー: AddComponent() 側で Awake/OnEnable を呼ぶ（Scene 側では Awake を呼ばない）
+//   - GameObject は GameObject::Create() ファクトリで生成（shared_from_this 安全化）
+//   - ウィンドウの「外枠サイズ」と「クライアントサイズ」を明確に分離
+//   - 実クライアントサイズからスワップチェイン/カメラアスペクトを構築（ズレ防止）
+//   - サンプル: キー/マウス入力、2秒ごとの Active 切替、簡単な移動コンポーネント
+//   - コマンドライン引数に .obj / .gltf / .glb を渡すと、MeshImporter で読んで中央に置く
+//     （隣に .mesh キャッシュを書き、次回からはそれをマップして使う）
 //
-// 悭闎Ƃ:
-//   - std::make_shared Ăт GameObject ƁARXgN^ shared_from_this() 
-//     g std::bad_weak_ptr ɂȂ邱Ƃ  t@Ng֐ŉB
-//   - AdjustWindowRect ̖߂́uOg݁ṽTCYBDirectX ̃r[|[gⓊes
-//     AXyNgvZɂ GetClientRect ́uNCAgTCYvgB
-//   - CtTCN𕡐ӏŌĂԂƓdiAwake/Start/OnEnablejBĂю{B
+// よくある落とし穴:
+//   - std::make_shared 直呼びで GameObject を作ると、コンストラクタ内の shared_from_this() が
+//     使えず std::bad_weak_ptr になることがある → ファクトリ関数で回避。
+//   - AdjustWindowRect の戻りは「外枠込み」のサイズ。DirectX のビューポートや投影行列の
+//     アスペクト計算には GetClientRect の「クライアントサイズ」を使う。
+//   - ライフサイクルを複数箇所で呼ぶと二重化する（Awake/Start/OnEnable）。呼び主を一本化する。
 // ============================================================================
 
 #include <windows.h>
+#include <shellapi.h> // CommandLineToArgvW
 #include <string>
+#include <algorithm>
 #include <memory>
 #include <cmath>
-#include <sal.h> // VS ̐ÓI͗pAme[Vi_In_ Ȃǁj
+#include <sal.h> // VS の静的解析用アノテーション（_In_ など）
 
 #include "Graphics/D3D12Renderer.h"
 #include "Scene/GameObject.h"
@@ -39,12 +43,12 @@
 #include "imgui_impl_win32.h"
 #include "imgui_impl_dx12.h"
 
-// ImGui  Win32 nh
+// ImGui の Win32 ハンドラ
 IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(
     HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
 // ----------------------------------------------------------------------------
-// AvŜŋLyʂȏԂEBhEɂԂ牺
+// アプリ全体で共有したい軽量な状態をウィンドウにぶら下げる
 // ----------------------------------------------------------------------------
 struct AppContext {
     D3D12Renderer* renderer = nullptr;
@@ -59,12 +63,12 @@ static AppContext* GetApp(HWND hWnd)
 }
 
 // ============================================================================
-// fobOpR|[lg
-// :
-//   - R|[lg̃CtTCNiOnEnable/OnDisable/OnDestroyj
-//     z^C~OŌĂ΂Ă邩ڎmF邽߂̍ŏB
-// :
-//   - {Ԃł̓bZ[W{bNX͎זɂȂ̂ŃÔ݂ɂȂǒB
+// デバッグ用コンポーネント
+// 役割:
+//   - コンポーネントのライフサイクル（OnEnable/OnDisable/OnDestroy）が
+//     想定タイミングで呼ばれているかを目視確認するための最小実装。
+// 注意:
+//   - 本番ではメッセージボックスは邪魔になるのでログのみにするなど調整。
 // ============================================================================
 class TestComponent : public Component
 {
@@ -77,20 +81,20 @@ public:
 
 // ============================================================================
 // MoveComponent
-// :
-//   - L GameObject  z ʒuTCgŉVvȋB
-// ݌vm[g:
-//   - uR|[lgvčėp₷j̗B
+// 役割:
+//   - 所有 GameObject の z 位置をサイン波で往復させるシンプルな挙動。
+// 設計ノート:
+//   - 「挙動をコンポーネント化」して再利用しやすくする方針の例。
 // ============================================================================
 class MoveComponent : public Component
 {
 public:
     explicit MoveComponent(GameObject* owner) : Component(ComponentType::None), m_Owner(owner) {}
 
-    // Update  Scene  GameObject  Component ̏ɓ`d
+    // Update は Scene → GameObject → Component の順に伝播する
     void Update(float /*dt*/) override {
-        if (!m_Owner || !m_Owner->IsActive()) return; // /jς݂Ȃ牽Ȃ
-        m_Owner->Transform->Position.z = std::sin(m_Frame * 0.05f) * 2.0f; // x0.05, U2.0
+        if (!m_Owner || !m_Owner->IsActive()) return; // 無効化/破棄済みなら何もしない
+        m_Owner->Transform->Position.z = std::sin(m_Frame * 0.05f) * 2.0f; // 速度0.05, 振幅2.0
         ++m_Frame;
     }
 
@@ -98,55 +102,55 @@ public:
     void OnDisable() override { OutputDebugStringA("MoveComponent: OnDisable\n"); }
 
 private:
-    GameObject* m_Owner = nullptr; // Transform փANZX邽߂̏LҎQ
-    int m_Frame = 0;               // o߃t[iԑցj
+    GameObject* m_Owner = nullptr; // Transform へアクセスするための所有者参照
+    int m_Frame = 0;               // 経過フレーム（時間代替）
 };
 
 // ============================================================================
-// WndProc: Win32 EBhEvV[W
-// :
-//   - OS ͂/EBhECxgŏɎ󂯎~߂B
-//   - ͍Œi͓]/WM_DESTROYjB
-// dv:
-//   - Input::ProcessMessage() ŕKĂԁiEEWȂǂɔfjB
+// WndProc: Win32 ウィンドウプロシージャ
+// 役割:
+//   - OS から届く入力/ウィンドウイベントを最初に受け止める。
+//   - 今回は最低限（入力転送/WM_DESTROY）だけ処理。
+// 重要:
+//   - Input::ProcessMessage() をここで必ず呼ぶ（押下・離上・座標などを内部に反映）。
 // ============================================================================
 LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
 {
-    // 1) ŏ ImGui ֓]iImGui ꍇ͂ŏIj
+    // 1) 最初に ImGui へ転送（ImGui が処理した場合はここで終了）
     if (ImGui_ImplWin32_WndProcHandler(hWnd, message, wParam, lParam))
         return 0;
 
-    // 2) ͑w֓]iL[{[h/}EXԂɔfj
+    // 2) 自作入力層へ転送（キーボード/マウス状態を内部に反映）
     Input::ProcessMessage(message, wParam, lParam);
 
-    // 3) AvReLXg擾iWndProc  static Ȃ߁AEBhEɂԂ牺j
+    // 3) アプリコンテキスト取得（WndProc は static なため、ウィンドウにぶら下げる）
     AppContext* app = GetApp(hWnd);
 
     switch (message) {
     case WM_SIZE: {
-        // ŏ 0 TCY̓XLbv
+        // 最小化時の 0 サイズはスキップ
         if (!app || wParam == SIZE_MINIMIZED) return 0;
 
         const UINT newW = LOWORD(lParam);
         const UINT newH = HIWORD(lParam);
         if (newW == 0 || newH == 0) return 0;
 
-        // NCAgTCYXV
+        // クライアントサイズ更新
         app->clientW = newW;
         app->clientH = newH;
 
-        // 1)  GPU \[XiXbv`FCjVTCYŃTCY
+        // 1) 先に GPU リソース（スワップチェイン等）を新サイズでリサイズ
         if (app->renderer)
             app->renderer->Resize(newW, newH);
 
-        // 2) ̌ɃJ̃AXyNgXVi renderer::Resize łXVĂȂd͕svj
+        // 2) その後にカメラのアスペクトを更新（※ renderer::Resize 側でも更新しているなら二重は不要）
         if (app->camera)
             app->camera->SetAspect(static_cast<float>(newW) / static_cast<float>(newH));
 
         return 0;
     }
     case WM_DESTROY:
-        PostQuitMessage(0); // C[vEow
+        PostQuitMessage(0); // メインループ脱出指示
         return 0;
     default:
         return DefWindowProc(hWnd, message, wParam, lParam);
@@ -154,30 +158,30 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
 }
 
 // ============================================================================
-// [eBeB: PȃJt̃bVg݂Ő
-// :
-//   - {iIɂ GLTF/FBX 烍[hă^WFgB
-//   - ̗ł 8_{CfbNXŊȑfiʂƂ̌ŗLFɏoȂʂƒ_dzjB
+// ユーティリティ: 単純なカラフル立方体メッシュを手組みで生成
+// 注意:
+//   - 本格的には GLTF/FBX からロードしてタンジェント等も持たせる。
+//   - この例では 8頂点＋インデックスで簡素化（面ごとの固有色を厳密に出すなら面ごと頂点重複が理想）。
 // ============================================================================
 MeshData CreateCubeMeshData()
 {
     MeshData m;
 
-    // _iʒu/@/Fj
+    // 頂点（位置/法線/色）
     m.Vertices = {
-        // -Z 
+        // -Z 面
         {{-0.5f,  0.5f, -0.5f}, {0,0,-1}, {1,0,0,1}},
         {{ 0.5f,  0.5f, -0.5f}, {0,0,-1}, {0,1,0,1}},
         {{-0.5f, -0.5f, -0.5f}, {0,0,-1}, {0,0,1,1}},
         {{ 0.5f, -0.5f, -0.5f}, {0,0,-1}, {1,1,0,1}},
-        // +Z 
+        // +Z 面
         {{-0.5f,  0.5f,  0.5f}, {0,0, 1}, {0,1,1,1}},
         {{ 0.5f,  0.5f,  0.5f}, {0,0, 1}, {1,0,1,1}},
         {{-0.5f, -0.5f,  0.5f}, {0,0, 1}, {0,0,0,1}},
         {{ 0.5f, -0.5f,  0.5f}, {0,0, 1}, {1,1,1,1}},
     };
 
-    // CfbNXiOp`XgjBWnE\ʂO CW ziPSO ̃JOɍ킹j
+    // インデックス（三角形リスト）。左手座標系・表面が手前で CW 想定（PSO のカリングに合わせる）
     m.Indices = {
         0,1,2, 1,3,2,  // -Z
         4,6,5, 5,6,7,  // +Z
@@ -191,14 +195,49 @@ MeshData CreateCubeMeshData()
 }
 
 // ============================================================================
-// WinMain: AvGg
-// t[:
-//  1) EBhENXo^  2) EBhE  3) ́ENCAg擾
-//  4) D3D   5) V[\z  6) C[viXVE`j  7) I
+// ユーティリティ: コマンドラインの最初の引数のメッシュファイルを読み込む
+// 注意:
+//   - 引数が無ければ nullptr（何も置かない）。読めなかったときは理由をデバッグ出力に出す。
+//   - 元ファイルの隣の .mesh（model.obj.mesh）が元の中身と設定に合えばそれを使い、
+//     合わなければ読み込み直して書き出す（ヒット/ミスと時間をデバッグ出力に出す）。
+//   - 大きさはばらばらなので、呼び出し側でバウンディングボックスから縮尺を決める。
+// ============================================================================
+std::shared_ptr<const MeshCacheFile> ImportMeshFromCommandLine(D3D12Renderer& renderer)
+{
+    int argc = 0;
+    LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+    if (!argv) return nullptr;
+
+    std::shared_ptr<const MeshCacheFile> cache;
+    if (argc >= 2) {
+        MeshCacheStats stats;
+        cache = renderer.ImportMeshCached(argv[1], &stats);
+        char buf[256];
+        if (!cache) {
+            sprintf_s(buf, "MeshImporter: failed (%s)\n", stats.error ? stats.error : "unknown");
+        } else if (stats.cacheHit) {
+            sprintf_s(buf, "MeshCache: hit, %u verts, %u tris, hash %.2f ms + load %.2f ms\n",
+                cache->VertexCount(), cache->IndexCount() / 3, stats.hashMilliseconds, stats.loadMilliseconds);
+        } else {
+            sprintf_s(buf, "MeshCache: miss, %u verts, %u tris, import %.2f ms + build %.2f ms (%s)\n",
+                cache->VertexCount(), cache->IndexCount() / 3, stats.importMilliseconds, stats.buildMilliseconds,
+                stats.cacheWritten ? "written" : "not written");
+        }
+        OutputDebugStringA(buf);
+    }
+    LocalFree(argv);
+    return cache;
+}
+
+// ============================================================================
+// WinMain: アプリエントリ
+// フロー:
+//  1) ウィンドウクラス登録 → 2) ウィンドウ生成 → 3) 入力・実クライアント取得
+//  4) D3D 初期化 → 5) シーン構築 → 6) メインループ（更新・描画） → 7) 終了処理
 // ============================================================================
 int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int nCmdShow)
 {
-    // ---------------- 1) EBhENXo^ ----------------
+    // ---------------- 1) ウィンドウクラス登録 ----------------
     const wchar_t CLASS_NAME[] = L"D3D12WindowClass";
 
     WNDCLASS wc = {};
@@ -207,14 +246,14 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE, _In_ LPSTR, _In
     wc.lpszClassName = CLASS_NAME;
     wc.hCursor = LoadCursor(nullptr, IDC_ARROW);
     wc.hbrBackground = (HBRUSH)(COLOR_WINDOW + 1);
-    RegisterClass(&wc); // s GetLastError()
+    RegisterClass(&wc); // 失敗時は GetLastError()
 
-    // ---------------- 2) EBhE ----------------
-    // \NCAg̈ 800x600BOgԂ AdjustWindowRect ŉZč쐬B
+    // ---------------- 2) ウィンドウ生成 ----------------
+    // 表示したいクライアント領域は 800x600。外枠ぶんは AdjustWindowRect で加算して作成する。
     RECT wr = { 0, 0, 800, 600 };
-    AdjustWindowRect(&wr, WS_OVERLAPPEDWINDOW, FALSE);  // j[
-    const int outerW = wr.right - wr.left; // Ogݕ
-    const int outerH = wr.bottom - wr.top;  // Ogݍ
+    AdjustWindowRect(&wr, WS_OVERLAPPEDWINDOW, FALSE);  // メニュー無し
+    const int outerW = wr.right - wr.left; // 外枠込み幅
+    const int outerH = wr.bottom - wr.top;  // 外枠込み高
 
     HWND hWnd = CreateWindowEx(
         0, CLASS_NAME, L"DirectX12 Engine",
@@ -225,8 +264,8 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE, _In_ LPSTR, _In
     ShowWindow(hWnd, nCmdShow);
     UpdateWindow(hWnd);
 
-    // ---------------- 3) ͏ & NCAg擾 ----------------
-    //  GetClientRect ͕`ΏۃsNZʂ̃TCYBr[|[g/AXyNgɎgB
+    // ---------------- 3) 入力初期化 & 実クライアント取得 ----------------
+    // ※ GetClientRect は描画対象ピクセル面のサイズ。これをビューポート/アスペクトに使う。
     Input::Initialize();
 
     RECT rc{};
@@ -234,108 +273,136 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE, _In_ LPSTR, _In
     const UINT clientW = rc.right - rc.left;
     const UINT clientH = rc.bottom - rc.top;
 
-    // ---------------- 4) D3D12  ----------------
+    // ---------------- 4) D3D12 初期化 ----------------
     D3D12Renderer renderer;
     renderer.Initialize(hWnd, clientW, clientH);
 
-    // EBhEɃAvReLXgԂ牺iWndProc QƂ邽߁j
+    // ウィンドウにアプリコンテキストをぶら下げる（WndProc から参照するため）
     static AppContext ctx;
     SetWindowLongPtr(hWnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(&ctx));
     ctx.renderer = &renderer;
     ctx.clientW = clientW;
     ctx.clientH = clientH;
 
-    // ---------------- 5) V[\z ----------------
+    // ---------------- 5) シーン構築 ----------------
     SceneManager sceneManager;
     auto mainScene = std::make_shared<Scene>("Main Scene");
     sceneManager.AddScene("Main", mainScene);
     sceneManager.SwitchScene("Main");
 
-    // ̃bVig݁j
+    // 立方体メッシュ（手組み）
     MeshData cube = CreateCubeMeshData();
 
-    // --- Cube1ij: CtTCNOt ---
+    // --- Cube1（左）: ライフサイクルログ付き ---
     auto cube1 = GameObject::Create("Cube1");
     cube1->Transform->Position = { -2.0f, 0.0f, 0.0f };
-    cube1->AddComponent<TestComponent>(); // OnEnable/Disable/Destroy ̃O
+    cube1->AddComponent<TestComponent>(); // OnEnable/Disable/Destroy のログ
+    cube1->SetStatic(true);               // 動かない → SceneRenderer の Static BVH に載る
     auto mr1 = cube1->AddComponent<MeshRendererComponent>();
-    mr1->SetMesh(cube);
-    renderer.CreateMeshRendererResources(mr1); // VB/IB  GPU \[X
+    mr1->SetMesh(cube, true);                  // ロード時の資産扱い：GPU 向けに並べ替えてから保持
+    mr1->SetOccluder(true);                    // 後ろに隠れたオブジェクトを CPU 側で間引く遮蔽物にする
+    renderer.CreateMeshRendererResources(mr1); // VB/IB の GPU リソース準備
 
-    // --- Cube2iEj: TCgŉ ---
+    // --- Cube2（右）: サイン波で往復 ---
     auto cube2 = GameObject::Create("Cube2");
     cube2->Transform->Position = { 2.0f, 0.0f, 0.0f };
     auto mr2 = cube2->AddComponent<MeshRendererComponent>();
-    mr2->SetMesh(cube);
+    mr2->SetMesh(cube, true);
     renderer.CreateMeshRendererResources(mr2);
-    cube2->AddComponent<MoveComponent>(cube2.get()); // L҂n
+    cube2->AddComponent<MoveComponent>(cube2.get()); // 所有者を渡す
 
-    // V[ɓo^ieȂ[gj
+    // シーンに登録（親なし＝ルート）
     mainScene->AddGameObject(cube1);
     mainScene->AddGameObject(cube2);
 
-    // --- JiWASD + }EXňړ/]łj ---
+    // --- Imported（中央）: コマンドライン引数のメッシュ。最大辺が 2 になるよう縮尺して原点に置く ---
+    //     （LOD/メッシュレットは .mesh に焼き込み済みなので、下の BuildMeshLods/BuildMeshlets は飛ばされる。
+    //       Static だが、LOD/メッシュレットを持つかチャンクより大きければ BuildStaticBatches は結合しないので、
+    //       .mesh の区画のまま個別に描かれる。小さなメッシュだけが他の Static と一緒にチャンクへ焼き込まれる）
+    if (auto imported = ImportMeshFromCommandLine(renderer)) {
+        const DirectX::XMFLOAT3 mn = imported->Bounds().Box.Min, mx = imported->Bounds().Box.Max;
+        const float extent = (std::max)({ mx.x - mn.x, mx.y - mn.y, mx.z - mn.z, 1e-6f });
+        const float s = 2.0f / extent;
+
+        auto model = GameObject::Create("Imported");
+        model->Transform->Scale = { s, s, s };
+        model->Transform->Position = { -(mn.x + mx.x) * 0.5f * s, -(mn.y + mx.y) * 0.5f * s, -(mn.z + mx.z) * 0.5f * s };
+        model->SetStatic(true);
+        auto mr = model->AddComponent<MeshRendererComponent>();
+        mr->SetMeshFromCache(imported);
+        renderer.CreateMeshRendererResources(mr); // 区画をそのまま送り、cache を手放す
+        mainScene->AddGameObject(model);
+    }
+
+    // LOD とメッシュレットを作る（メッシュ単位で並列。小さすぎる/継ぎ目だらけのメッシュは LOD0 のまま）
+    renderer.BuildMeshLods(mainScene.get());
+    renderer.BuildMeshlets(mainScene.get());
+
+    // Static なメッシュをワールド空間に焼き込んで結合（チャンク単位で描かれる）
+    renderer.BuildStaticBatches(mainScene.get());
+
+    // --- カメラ（WASD + マウスで移動/回転できる） ---
     auto camObj = GameObject::Create("Camera");
-    camObj->Transform->Position = { 0.0f, 2.0f, -5.0f }; // Ղ
+    camObj->Transform->Position = { 0.0f, 2.0f, -5.0f }; // 俯瞰ぎみ
     auto cameraComp = camObj->AddComponent<CameraComponent>(camObj.get());
-    cameraComp->SetAspect(static_cast<float>(clientW) / static_cast<float>(clientH)); // NCAg
+    cameraComp->SetAspect(static_cast<float>(clientW) / static_cast<float>(clientH)); // 実クライアント比
     camObj->AddComponent<CameraControllerComponent>(camObj.get(), cameraComp.get());
     mainScene->AddGameObject(camObj);
 
-    // AppContext ɂێiWndProc ŃAXyNgXVj
+    // AppContext にも保持（WndProc でアスペクト更新したい）
     ctx.camera = cameraComp;
 
-    // ---------------- 6) C[v ----------------
-    // [v\:
-    //  - \Ȃ OS bZ[WiubLOj
-    //  - ȊO̎Ԃ 1t[i߂iԍXV͎QƁV[XV`恨̓XibvVbgj
+    // ---------------- 6) メインループ ----------------
+    // ループ構造:
+    //  - 可能なら OS メッセージを処理（非ブロッキング）
+    //  - それ以外の時間は 1フレーム進める（時間更新→入力参照→シーン更新→描画→入力スナップショット）
     MSG msg = {};
-    float elapsed = 0.0f; // fp: 2bƂ Cube2 gO
+    float elapsed = 0.0f; // デモ用: 2秒ごとに Cube2 をトグルする
 
     while (msg.message != WM_QUIT) {
         if (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
             TranslateMessage(&msg);
             DispatchMessage(&msg);
-            continue; // ̃t[ OS bZ[Ŵ݂ŏI
+            continue; // このフレームは OS メッセージ処理のみで終了
         }
 
-        // ---- 1) ԍXV ----
+        // ---- 1) 時間更新 ----
         Time::Update();
         const float dt = Time::GetDeltaTime();
 
-        // ---- 2) ͗iKvɉĎ̏ɒuj----
+        // ---- 2) 入力例（必要に応じて自分の処理に置換）----
         if (Input::GetMouseButtonDown(MouseButton::Left)) {
             OutputDebugStringA("Left Mouse Clicked!\n");
         }
         if (Input::GetKeyDown(KeyCode::Space)) {
-            mainScene->SetGameObjectActive(cube2, !cube2->IsActive()); // Space ŃgO
+            mainScene->SetGameObjectActive(cube2, !cube2->IsActive()); // Space でトグル
         }
 
-        // f: 2bƂɎŃgOiSpace ƕpƑ؂ւ\j
+        // デモ: 2秒ごとに自動でトグル（Space と併用すると早く切り替わる可能性あり）
         elapsed += dt;
         if (elapsed >= 2.0f) {
             mainScene->SetGameObjectActive(cube2, !cube2->IsActive());
             elapsed = 0.0f;
         }
 
-        // ---- 3) XV` ----
+        // ---- 3) 更新＆描画 ----
         if (auto scene = sceneManager.GetActiveScene()) {
-            scene->Update(dt);                  // Q[WbNieqeR|[lgj
-            renderer.SetScene(scene);           // `悷V[
-            renderer.SetCamera(cameraComp);     // gpJ
-            renderer.Render();                  // D3D12 R}hL^sPresent
+            scene->Update(dt);                  // ゲームロジック（親→子→各コンポーネント）
+            renderer.SetScene(scene);           // 今回描画するシーン
+            renderer.SetCamera(cameraComp);     // 使用カメラ
+            renderer.Render();                  // D3D12 コマンド記録→実行→Present
         }
 
-        // ---- 4) ̓XibvVbgXV ----
-        // t[ GetKeyDown/GetKeyUp ̂߁AŁuOt[ԁvm肳B
+        // ---- 4) 入力スナップショット更新 ----
+        // 次フレームの GetKeyDown/GetKeyUp 判定のため、ここで「前フレーム状態」を確定させる。
         Input::Update();
     }
 
-    // ---------------- 7) I ----------------
-    // ܂ŗƃEBhE͕ĂBGPU cĂ\̂ŁA
-    // renderer.Cleanup()  GPU \[XB
+    // ---------------- 7) 終了処理 ----------------
+    // ここまで来るとウィンドウは閉じている。GPU 処理が残っている可能性があるので、
+    // renderer.Cleanup() 内で GPU 同期→リソース解放をする。
     if (auto scene = sceneManager.GetActiveScene()) {
-        scene->DestroyAllGameObjects(); // OnDestroy 𐳂ĂтȂj
+        scene->DestroyAllGameObjects(); // OnDestroy を正しく呼びながら破棄
     }
     renderer.Cleanup();
 
@@ -0,0 +1,335 @@
+﻿#include "TestFramework.h"
+#include "Assets/MeshCache.h"
+#include "Assets/MeshCorpus.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/*
+    MeshCache のテスト
+    ----------------------------------------------------------------------------
+      - HashBytes64 は XXH64 の参照値と一致する
+      - 焼き込んだ .mesh を開いて CPU 側へコピーすると、SetMesh / BuildMeshLods / BuildMeshlets を
+        その場で行った結果とバイト単位で同じになる（頂点ストリームも形式の encode と同じ）
+      - キー（sourceHash / settingsHash / 形式）が違う・切り詰め・境界ずれ・中身の改変は開かない。
+        ヘッダを壊しても範囲外は読まない（ASan で確かめる）
+      - ImportMeshCached：初回は作って書き出し、2 回目はヒット、元ファイル/設定が変われば作り直す
+    ベンチマークは元ファイルからの読み込み直しとキャッシュの読み込みを比べる。
+    D3D12 に依存しないよう、頂点形式はテスト用のもの（float のまま 2 ストリーム）を使う。
+    描画側の形式（GpuMeshCacheFormat）は Upload/MeshUploaderTests.cpp で確かめる。
+*/
+
+namespace
+{
+    bool SameBytes(const void* a, const void* b, std::size_t n) { return n == 0 || std::memcmp(a, b, n) == 0; }
+
+    // テスト用の頂点形式：位置 | 法線 + 色 の 2 ストリーム（float のまま詰める）
+    void EncodeTestStreams(const Vertex* src, std::size_t count, void* const* streams)
+    {
+        std::uint8_t* position = static_cast<std::uint8_t*>(streams[0]);
+        std::uint8_t* attribute = static_cast<std::uint8_t*>(streams[1]);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::memcpy(position + i * 12, &src[i].Position, 12);
+            std::memcpy(attribute + i * 28, &src[i].Normal, 12);
+            std::memcpy(attribute + i * 28 + 12, &src[i].Color, 16);
+        }
+    }
+
+    const MeshCacheVertexFormat& TestFormat()
+    {
+        static const MeshCacheVertexFormat format = []
+            {
+                MeshCacheVertexFormat f;
+                f.streamCount = 2;
+                f.strides[0] = 12;
+                f.strides[1] = 28;
+                f.encode = EncodeTestStreams;
+                const char desc[] = "test: POSITION R32G32B32 | NORMAL R32G32B32, COLOR R32G32B32A32";
+                f.key = HashBytes64(desc, sizeof(desc)) | 1;
+                return f;
+            }();
+        return format;
+    }
+
+    void WriteFile(const std::wstring& path, const std::string& text)
+    {
+        std::ofstream f(std::filesystem::path(path), std::ios::binary);
+        f.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+}
+
+TEST_CASE(MeshCache_HashMatchesXxh64)
+{
+    CHECK(HashBytes64("", 0) == 0xEF46DB3751D8E999ull);
+    CHECK(HashBytes64("abc", 3) == 0x44BC2CF5AD770999ull);
+    const char* s = "Nobody inspects the spammish repetition";
+    CHECK(HashBytes64(s, std::strlen(s)) == 0xFBCEA83C8A378BF1ull);
+}
+
+TEST_CASE(MeshCache_MatchesInPlaceBuild)
+{
+    const MeshCacheVertexFormat& format = TestFormat();
+
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    const MeshCacheBuildSettings settings;
+    for (const MeshCorpusEntry& e : corpus)
+    {
+        std::vector<std::uint8_t> bytes;
+        REQUIRE(BuildMeshCache(e.mesh, format, settings, 7, 9, bytes));
+        CHECK(bytes.size() % 16 == 0);
+        MeshCacheFile cache;
+        REQUIRE(cache.OpenMemory(bytes.data(), bytes.size(), &format, 7, 9, true));
+
+        // その場で行う場合と同じ手順
+        MeshData ref = e.mesh;
+        const MeshOptimizeStats optimized = OptimizeMesh(ref);
+        MeshLods refLods;
+        BuildMeshLods(ref, settings.lods, refLods);
+        MeshletData refMeshlets;
+        if (ref.Indices.size() / 3 > settings.meshlets.maxTriangles)
+        {
+            BuildMeshlets(ref, settings.meshlets, refMeshlets);
+            if (refMeshlets.Meshlets.size() < 2) refMeshlets.Clear();
+        }
+
+        MeshData mesh;
+        cache.CopyMesh(mesh);
+        REQUIRE(mesh.Vertices.size() == ref.Vertices.size());
+        CHECK(SameBytes(mesh.Vertices.data(), ref.Vertices.data(), mesh.Vertices.size() * sizeof(Vertex)));
+        CHECK(mesh.Indices == ref.Indices);
+
+        MeshLods lods;
+        cache.CopyLods(lods);
+        CHECK(lods.Indices == refLods.Indices);
+        REQUIRE(lods.Levels.size() == refLods.Levels.size());
+        for (std::size_t k = 0; k < lods.Levels.size(); ++k)
+        {
+            CHECK(lods.Levels[k].indexOffset == refLods.Levels[k].indexOffset);
+            CHECK(lods.Levels[k].indexCount == refLods.Levels[k].indexCount);
+            CHECK(lods.Levels[k].error == refLods.Levels[k].error);
+        }
+
+        MeshletData meshlets;
+        CHECK(cache.CopyMeshlets(meshlets) == !refMeshlets.Meshlets.empty());
+        CHECK(meshlets.Meshlets.size() == refMeshlets.Meshlets.size());
+        CHECK(meshlets.Vertices == refMeshlets.Vertices);
+        CHECK(meshlets.Triangles == refMeshlets.Triangles);
+        CHECK(meshlets.IndexCount == refMeshlets.IndexCount);
+        CHECK(SameBytes(meshlets.Bounds.data(), refMeshlets.Bounds.data(), meshlets.Bounds.size() * sizeof(MeshletBounds)));
+
+        const MeshBounds refBounds = ComputeMeshBounds(ref);
+        CHECK(SameBytes(&refBounds, &cache.Bounds(), sizeof(MeshBounds)));
+        const MeshOptimizeStats stats = cache.OptimizeStats();
+        CHECK(stats.optimized == optimized.optimized);
+        CHECK(stats.after.acmr == optimized.after.acmr);
+        CHECK(stats.verticesAfter == optimized.verticesAfter);
+        CHECK(stats.clusters == optimized.clusters);
+
+        // GPU 側：形式の encode で詰めたものと同じ。インデックスは 16bit に収まれば詰める
+        std::vector<std::uint8_t> streams[MeshCacheVertexFormat::kMaxStreams];
+        void* dst[MeshCacheVertexFormat::kMaxStreams] = {};
+        for (std::uint32_t s = 0; s < format.streamCount; ++s)
+        {
+            streams[s].resize(ref.Vertices.size() * format.strides[s]);
+            dst[s] = streams[s].data();
+        }
+        format.encode(ref.Vertices.data(), ref.Vertices.size(), dst);
+        for (std::uint32_t s = 0; s < format.streamCount; ++s)
+        {
+            CHECK(SameBytes(cache.VertexStream(s), streams[s].data(), streams[s].size()));
+            CHECK((reinterpret_cast<std::uintptr_t>(cache.VertexStream(s)) & 15) == 0);
+        }
+        std::vector<std::uint32_t> all = ref.Indices;
+        all.insert(all.end(), refLods.Indices.begin(), refLods.Indices.end());
+        REQUIRE(cache.TotalIndexCount() == all.size());
+        CHECK(cache.ShortIndices() == (ref.Vertices.size() <= 0x10000));
+        if (cache.ShortIndices())
+        {
+            const std::uint16_t* gpu = static_cast<const std::uint16_t*>(cache.GpuIndices());
+            for (std::size_t i = 0; i < all.size(); ++i) CHECK(gpu[i] == all[i]);
+        }
+        else
+        {
+            CHECK(SameBytes(cache.GpuIndices(), all.data(), all.size() * sizeof(std::uint32_t)));
+        }
+
+        std::vector<std::uint8_t> again; // 同じ入力からは同じバイト列
+        BuildMeshCache(e.mesh, format, settings, 7, 9, again);
+        CHECK(again == bytes);
+    }
+}
+
+TEST_CASE(MeshCache_RejectsMismatchAndCorruption)
+{
+    const MeshCacheVertexFormat& format = TestFormat();
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    std::vector<std::uint8_t> bytes;
+    REQUIRE(BuildMeshCache(corpus[1].mesh, format, MeshCacheBuildSettings(), 7, 9, bytes));
+
+    MeshCacheFile x;
+    CHECK(!x.OpenMemory(bytes.data(), bytes.size(), &format, 8, 9, true));
+    CHECK(x.Error() != nullptr);
+    CHECK(!x.OpenMemory(bytes.data(), bytes.size(), &format, 7, 10, true));
+    MeshCacheVertexFormat other = format;
+    other.key ^= 2;
+    CHECK(!x.OpenMemory(bytes.data(), bytes.size(), &other, 0, 0, true));
+    CHECK(!x.OpenMemory(bytes.data(), bytes.size() - 16, &format, 0, 0, true));
+    std::vector<std::uint8_t> shifted(bytes.size() + 16); // 16B 境界にない
+    std::memcpy(shifted.data() + 4, bytes.data(), bytes.size());
+    CHECK(!x.OpenMemory(shifted.data() + 4, bytes.size(), &format));
+
+    // ヘッダより後ろのどの 1 バイトを変えても contentHash で弾く
+    std::mt19937 rng(1);
+    for (int k = 0; k < 64; ++k)
+    {
+        std::vector<std::uint8_t> bad = bytes;
+        const std::size_t at = sizeof(MeshCacheHeader) + rng() % (bad.size() - sizeof(MeshCacheHeader));
+        bad[at] ^= static_cast<std::uint8_t>(1 + rng() % 255);
+        CHECK(!x.OpenMemory(bad.data(), bad.size(), &format, 0, 0, true));
+    }
+    CHECK(x.OpenMemory(bytes.data(), bytes.size(), &format, 0, 0, false));
+
+    // ヘッダを壊して中身の確認なしで開く：弾くか、開けても区画は範囲内（ASan で確かめる）
+    for (int k = 0; k < 2000; ++k)
+    {
+        std::vector<std::uint8_t> bad = bytes;
+        for (int j = 0; j < 1 + k % 4; ++j) bad[rng() % sizeof(MeshCacheHeader)] = static_cast<std::uint8_t>(rng());
+        if (!x.OpenMemory(bad.data(), bad.size(), nullptr, 0, 0, false)) continue;
+        MeshData mesh;
+        MeshLods lods;
+        MeshletData meshlets;
+        x.CopyMesh(mesh);
+        x.CopyLods(lods);
+        x.CopyMeshlets(meshlets);
+        x.OptimizeStats();
+        for (std::uint32_t s = 0; s < x.Header().streamCount; ++s)
+        {
+            volatile std::uint8_t b = static_cast<const std::uint8_t*>(x.VertexStream(s))[0];
+            (void)b;
+        }
+    }
+    x.Close();
+}
+
+TEST_CASE(MeshCache_LargeMeshUses32BitIndices)
+{
+    const MeshCacheVertexFormat& format = TestFormat();
+    MeshData big;
+    for (int i = 0; i < 70000; ++i)
+        big.Vertices.push_back({ { static_cast<float>(i), static_cast<float>(i % 7), 0 }, { 0, 0, -1 }, { 1, 1, 1, 1 } });
+    for (std::uint32_t i = 0; i + 2 < 70000; i += 3) big.Indices.insert(big.Indices.end(), { i, i + 1, i + 2 });
+
+    MeshCacheBuildSettings raw;
+    raw.optimize = false;
+    raw.buildLods = false;
+    raw.buildMeshlets = false;
+    std::vector<std::uint8_t> bytes;
+    REQUIRE(BuildMeshCache(big, format, raw, 1, 1, bytes));
+    MeshCacheFile cache;
+    REQUIRE(cache.OpenMemory(bytes.data(), bytes.size(), &format));
+    CHECK(!cache.ShortIndices());
+    CHECK(cache.GpuIndices() == cache.Indices()); // GPU も CPU 側の区画を使う
+    CHECK(cache.Header().sections[MeshCacheHeader::kGpuIndices].size == 0);
+    CHECK(!cache.OptimizeStats().optimized);
+
+    MeshData bad = big;
+    bad.Indices[5] = 70000;
+    CHECK(!BuildMeshCache(bad, format, raw, 1, 1, bytes));
+    CHECK(bytes.empty());
+    bad = big;
+    bad.Indices.pop_back();
+    CHECK(!BuildMeshCache(bad, format, raw, 1, 1, bytes));
+}
+
+TEST_CASE(MeshCache_ImportCachedHitsAndRebuilds)
+{
+    const MeshCacheVertexFormat& format = TestFormat();
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    const std::wstring source = test::TempPath(L"cached.obj");
+    const std::filesystem::path cachePath = source + L".mesh";
+    std::error_code ec;
+    std::filesystem::remove(cachePath, ec);
+    std::string obj;
+    WriteMeshObj(corpus[1].mesh, obj);
+    WriteFile(source, obj);
+
+    std::shared_ptr<const MeshCacheFile> a, b;
+    MeshCacheStats stats;
+    REQUIRE(ImportMeshCached(source.c_str(), format, a, MeshImportOptions(), MeshCacheBuildSettings(), nullptr, &stats));
+    CHECK(!stats.cacheHit);
+    CHECK(stats.cacheWritten);
+    CHECK(stats.cacheBytes == a->SizeBytes());
+    CHECK(std::filesystem::file_size(cachePath, ec) == a->SizeBytes());
+    CHECK(!std::filesystem::exists(source + L".mesh.tmp", ec)); // 書きかけは残らない
+
+    REQUIRE(ImportMeshCached(source.c_str(), format, b, MeshImportOptions(), MeshCacheBuildSettings(), nullptr, &stats));
+    CHECK(stats.cacheHit);
+    CHECK(!stats.cacheWritten);
+    CHECK(a->ContentHash() == b->ContentHash());
+    CHECK(SameBytes(a->Vertices(), b->Vertices(), a->VertexCount() * sizeof(Vertex)));
+    b.reset(); // マップを閉じてから書き換える
+
+    // 元ファイルが変わった → 作り直し
+    WriteFile(source, obj + "# touched\n");
+    REQUIRE(ImportMeshCached(source.c_str(), format, b, MeshImportOptions(), MeshCacheBuildSettings(), nullptr, &stats));
+    CHECK(!stats.cacheHit);
+    CHECK(stats.cacheWritten);
+    b.reset();
+
+    // 読み込みの設定が変わった → 作り直し、次はヒット
+    MeshImportOptions scaled;
+    scaled.scale = 2.0f;
+    REQUIRE(ImportMeshCached(source.c_str(), format, b, scaled, MeshCacheBuildSettings(), nullptr, &stats));
+    CHECK(!stats.cacheHit);
+    CHECK(std::fabs(b->Bounds().Box.Max.x - 2.0f * a->Bounds().Box.Max.x) < 1e-4f);
+    b.reset();
+    REQUIRE(ImportMeshCached(source.c_str(), format, b, scaled, MeshCacheBuildSettings(), nullptr, &stats));
+    CHECK(stats.cacheHit);
+    b.reset();
+
+    // 壊れたキャッシュファイルは作り直す
+    const std::wstring custom = test::TempPath(L"custom.mesh");
+    std::shared_ptr<const MeshCacheFile> c;
+    REQUIRE(ImportMeshCached(source.c_str(), format, c, MeshImportOptions(), MeshCacheBuildSettings(), custom.c_str(), &stats));
+    CHECK(stats.cacheWritten);
+    c.reset();
+    {
+        std::fstream f(std::filesystem::path(custom), std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(-8, std::ios::end);
+        f.put(0x5A);
+    }
+    REQUIRE(ImportMeshCached(source.c_str(), format, c, MeshImportOptions(), MeshCacheBuildSettings(), custom.c_str(), &stats));
+    CHECK(!stats.cacheHit);
+    CHECK(stats.cacheWritten);
+    c.reset();
+
+    CHECK(!ImportMeshCached(test::TempPath(L"missing.obj").c_str(), format, c, MeshImportOptions(), MeshCacheBuildSettings(), nullptr, &stats));
+    CHECK(stats.error != nullptr);
+    CHECK(!c);
+}
+
+BENCHMARK(MeshCache_LoadVsReimport)
+{
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    std::vector<MeshCacheBenchmarkResult> results;
+    RunMeshCacheBenchmark(corpus, 2, TestFormat(), results); // 結合メッシュの焼き込みが重いので 2 回分
+    for (const MeshCacheBenchmarkResult& r : results)
+    {
+        test::Report(("load " + r.name).c_str(), r.loadMilliseconds);
+        std::printf("  src %9zu B  cache %9zu B  %8zu tris  import %8.2f  build %8.2f  no-verify %7.3f ms  x%.0f\n",
+            r.sourceBytes, r.cacheBytes, r.triangles, r.importMilliseconds, r.buildMilliseconds,
+            r.loadNoVerifyMilliseconds, r.speedup);
+    }
+}
@@ -0,0 +1,461 @@
+﻿#include "Assets/MeshCorpus.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <utility>
+
+using namespace DirectX;
+
+/*
+    MeshCorpus.cpp
+    ----------------------------------------------------------------------------
+    - 形状は格子（u, v）から作り、三角形は (i, j) → (i+1, j) → (i, j+1) の巻き順で揃える。
+    - 乱数は std::mt19937（種が同じなら処理系が違っても同じ並び）。並べ替えは自前の
+      Fisher-Yates（std::shuffle は実装ごとに結果が違う）。
+    - 時間は steady_clock で OptimizeMesh だけを測る（コピーは含めない）。
+*/
+
+namespace
+{
+    constexpr float kPi = 3.14159265358979f;
+
+    template <class T>
+    void Shuffle(std::vector<T>& v, std::mt19937& rng)
+    {
+        for (std::size_t i = v.size(); i > 1; --i)
+        {
+            const std::size_t j = rng() % i;
+            std::swap(v[i - 1], v[j]);
+        }
+    }
+
+    // (cols+1)×(rows+1) の格子頂点を position(u, v) で作り、四角形ごとに 2 三角形を張る
+    template <class PositionFn>
+    MeshData BuildGrid(std::uint32_t cols, std::uint32_t rows, PositionFn&& position)
+    {
+        MeshData m;
+        m.Vertices.reserve((cols + 1) * (rows + 1));
+        for (std::uint32_t j = 0; j <= rows; ++j)
+        {
+            for (std::uint32_t i = 0; i <= cols; ++i)
+            {
+                Vertex v{};
+                position(static_cast<float>(i) / cols, static_cast<float>(j) / rows, v.Position, v.Normal);
+                v.Color = { static_cast<float>(i) / cols, static_cast<float>(j) / rows, 0.5f, 1.0f };
+                m.Vertices.push_back(v);
+            }
+        }
+        m.Indices.reserve(cols * rows * 6);
+        for (std::uint32_t j = 0; j < rows; ++j)
+        {
+            for (std::uint32_t i = 0; i < cols; ++i)
+            {
+                const unsigned int a = j * (cols + 1) + i, b = a + 1, c = a + cols + 1, d = c + 1;
+                m.Indices.insert(m.Indices.end(), { a, b, c, b, d, c });
+            }
+        }
+        return m;
+    }
+
+    MeshData Plane(std::uint32_t n)
+    {
+        return BuildGrid(n, n, [](float u, float v, XMFLOAT3& p, XMFLOAT3& nrm)
+            {
+                p = { u * 2.0f - 1.0f, 0.0f, v * 2.0f - 1.0f };
+                nrm = { 0.0f, 1.0f, 0.0f };
+            });
+    }
+
+    MeshData Sphere(std::uint32_t slices, std::uint32_t stacks)
+    {
+        // 極と継ぎ目は重複頂点のまま（UV 球の普通の作り方）
+        return BuildGrid(slices, stacks, [](float u, float v, XMFLOAT3& p, XMFLOAT3& nrm)
+            {
+                const float phi = u * 2.0f * kPi, theta = v * kPi;
+                nrm = { std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) };
+                p = nrm;
+            });
+    }
+
+    MeshData Torus(std::uint32_t major, std::uint32_t minor)
+    {
+        return BuildGrid(major, minor, [](float u, float v, XMFLOAT3& p, XMFLOAT3& nrm)
+            {
+                const float a = u * 2.0f * kPi, b = v * 2.0f * kPi;
+                const float R = 1.0f, r = 0.35f;
+                nrm = { std::cos(a) * std::cos(b), std::sin(b), std::sin(a) * std::cos(b) };
+                p = { (R + r * std::cos(b)) * std::cos(a), r * std::sin(b), (R + r * std::cos(b)) * std::sin(a) };
+            });
+    }
+
+    // 三角形の順と頂点配列の順をランダムにする（形は変えない）
+    void Scramble(MeshData& m, std::mt19937& rng)
+    {
+        const std::size_t triCount = m.Indices.size() / 3;
+        std::vector<std::uint32_t> tris(triCount);
+        std::iota(tris.begin(), tris.end(), 0u);
+        Shuffle(tris, rng);
+        std::vector<unsigned int> indices;
+        indices.reserve(m.Indices.size());
+        for (std::uint32_t t : tris)
+            indices.insert(indices.end(), m.Indices.begin() + t * 3, m.Indices.begin() + t * 3 + 3);
+
+        std::vector<std::uint32_t> perm(m.Vertices.size()); // 旧番号 → 新番号
+        std::iota(perm.begin(), perm.end(), 0u);
+        Shuffle(perm, rng);
+        std::vector<Vertex> vertices(m.Vertices.size());
+        for (std::size_t i = 0; i < perm.size(); ++i) vertices[perm[i]] = m.Vertices[i];
+        for (unsigned int& idx : indices) idx = perm[idx];
+
+        m.Vertices.swap(vertices);
+        m.Indices.swap(indices);
+    }
+
+    // 三角形の角ごとに頂点を複製する（インデックスは 0, 1, 2, …）
+    MeshData Unweld(const MeshData& src)
+    {
+        MeshData m;
+        m.Vertices.reserve(src.Indices.size());
+        m.Indices.reserve(src.Indices.size());
+        for (unsigned int idx : src.Indices)
+        {
+            m.Indices.push_back(static_cast<unsigned int>(m.Vertices.size()));
+            m.Vertices.push_back(src.Vertices[idx]);
+        }
+        return m;
+    }
+
+    MeshData Cubes(std::uint32_t perAxis, std::mt19937& rng)
+    {
+        static const XMFLOAT3 kNormals[6] = { {1,0,0}, {-1,0,0}, {0,1,0}, {0,-1,0}, {0,0,1}, {0,0,-1} };
+        MeshData m;
+        for (std::uint32_t z = 0; z < perAxis; ++z)
+        for (std::uint32_t y = 0; y < perAxis; ++y)
+        for (std::uint32_t x = 0; x < perAxis; ++x)
+        {
+            const XMFLOAT3 c{ x * 1.5f, y * 1.5f, z * 1.5f };
+            for (const XMFLOAT3& n : kNormals)
+            {
+                // 面の 2 軸（n と直交）
+                const XMFLOAT3 t = (n.x != 0.0f) ? XMFLOAT3{ 0, 1, 0 } : XMFLOAT3{ 1, 0, 0 };
+                const XMFLOAT3 s{ n.y * t.z - n.z * t.y, n.z * t.x - n.x * t.z, n.x * t.y - n.y * t.x };
+                const unsigned int base = static_cast<unsigned int>(m.Vertices.size());
+                for (int k = 0; k < 4; ++k)
+                {
+                    const float a = (k & 1) ? 0.5f : -0.5f, b = (k & 2) ? 0.5f : -0.5f;
+                    Vertex v{};
+                    v.Position = { c.x + n.x * 0.5f + t.x * a + s.x * b,
+                                   c.y + n.y * 0.5f + t.y * a + s.y * b,
+                                   c.z + n.z * 0.5f + t.z * a + s.z * b };
+                    v.Normal = n;
+                    v.Color = { 1.0f, 1.0f, 1.0f, 1.0f };
+                    m.Vertices.push_back(v);
+                }
+                m.Indices.insert(m.Indices.end(), { base, base + 1, base + 2, base + 1, base + 3, base + 2 });
+            }
+        }
+        Scramble(m, rng);
+        return m;
+    }
+}
+
+void BuildMeshCorpus(std::vector<MeshCorpusEntry>& out, std::uint32_t seed)
+{
+    out.clear();
+    std::mt19937 rng(seed);
+
+    out.push_back({ "grid", Plane(256) });
+    out.push_back({ "sphere", Sphere(128, 64) });
+    out.push_back({ "torus", Torus(96, 48) });
+
+    MeshData shuffled = Sphere(128, 64);
+    Scramble(shuffled, rng);
+    out.push_back({ "shuffled", std::move(shuffled) });
+
+    out.push_back({ "soup", Unweld(Torus(96, 48)) });
+    out.push_back({ "cubes", Cubes(16, rng) });
+}
+
+void RunMeshOptimizerBenchmark(const std::vector<MeshCorpusEntry>& corpus,
+    const MeshOptimizeSettings& settings, std::vector<MeshBenchmarkResult>& out)
+{
+    out.clear();
+    out.reserve(corpus.size());
+    for (const MeshCorpusEntry& e : corpus)
+    {
+        MeshData mesh = e.mesh;
+        MeshBenchmarkResult r;
+        r.name = e.name;
+        r.triangles = mesh.Indices.size() / 3;
+
+        const auto t0 = std::chrono::steady_clock::now();
+        r.stats = OptimizeMesh(mesh, settings);
+        const auto t1 = std::chrono::steady_clock::now();
+        r.milliseconds = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        out.push_back(std::move(r));
+    }
+}
+
+void RunMeshletBenchmark(const std::vector<MeshCorpusEntry>& corpus,
+    const MeshletLimits& limits, std::vector<MeshletBenchmarkResult>& out)
+{
+    out.clear();
+    out.reserve(corpus.size());
+    MeshletData meshlets;
+    for (const MeshCorpusEntry& e : corpus)
+    {
+        MeshData mesh = e.mesh;
+        OptimizeMesh(mesh); // SetMesh と同じ並びから分ける
+        MeshletBenchmarkResult r;
+        r.name = e.name;
+        r.triangles = mesh.Indices.size() / 3;
+
+        const auto t0 = std::chrono::steady_clock::now();
+        r.meshlets = BuildMeshlets(mesh, limits, meshlets);
+        const auto t1 = std::chrono::steady_clock::now();
+        r.milliseconds = std::chrono::duration<double, std::milli>(t1 - t0).count();
+
+        std::size_t vertices = 0, triangles = 0, cones = 0;
+        for (std::size_t i = 0; i < meshlets.Meshlets.size(); ++i)
+        {
+            vertices += meshlets.Meshlets[i].vertexCount;
+            triangles += meshlets.Meshlets[i].triangleCount;
+            if (meshlets.Bounds[i].coneCutoff < 1.0f) ++cones;
+        }
+        if (r.meshlets > 0)
+        {
+            const float n = static_cast<float>(r.meshlets);
+            r.avgVertices = static_cast<float>(vertices) / n;
+            r.avgTriangles = static_cast<float>(triangles) / n;
+            r.coneFraction = static_cast<float>(cones) / n;
+        }
+        out.push_back(std::move(r));
+    }
+}
+
+namespace
+{
+    // インポータの逆変換（Z 反転）をかけた位置/法線
+    XMFLOAT3 ToRightHanded(const XMFLOAT3& v) { return { v.x, v.y, -v.z }; }
+
+    void AppendBytes(std::vector<std::uint8_t>& out, const void* data, std::size_t size)
+    {
+        const std::uint8_t* p = static_cast<const std::uint8_t*>(data);
+        out.insert(out.end(), p, p + size);
+    }
+
+    void AppendU32(std::vector<std::uint8_t>& out, std::uint32_t v) { AppendBytes(out, &v, 4); }
+
+    // corpus に、全部を結合して repeat 回ずらして並べた大きなメッシュ（ファイルサイズで数十 MB になる）を足したもの
+    std::vector<MeshCorpusEntry> MakeFileBenchmarkInputs(const std::vector<MeshCorpusEntry>& corpus, std::size_t repeat)
+    {
+        std::vector<MeshCorpusEntry> inputs(corpus.begin(), corpus.end());
+        MeshCorpusEntry all;
+        all.name = "all x" + std::to_string(repeat);
+        for (std::size_t r = 0; r < repeat; ++r)
+        {
+            for (const MeshCorpusEntry& e : corpus)
+            {
+                const unsigned int base = static_cast<unsigned int>(all.mesh.Vertices.size());
+                for (Vertex v : e.mesh.Vertices)
+                {
+                    v.Position.x += 3.0f * static_cast<float>(r);
+                    all.mesh.Vertices.push_back(v);
+                }
+                for (unsigned int i : e.mesh.Indices) all.mesh.Indices.push_back(base + i);
+            }
+        }
+        if (repeat > 0) inputs.push_back(std::move(all));
+        return inputs;
+    }
+}
+
+void WriteMeshObj(const MeshData& mesh, std::string& out)
+{
+    out.clear();
+    out.reserve(mesh.Vertices.size() * 96 + mesh.Indices.size() * 8);
+    out += "# MeshCorpus\n";
+    char line[256];
+    for (const Vertex& v : mesh.Vertices)
+    {
+        const XMFLOAT3 p = ToRightHanded(v.Position);
+        const int n = std::snprintf(line, sizeof(line), "v %.9g %.9g %.9g %.9g %.9g %.9g\n", p.x, p.y, p.z, v.Color.x, v.Color.y, v.Color.z);
+        out.append(line, static_cast<std::size_t>(n));
+    }
+    for (const Vertex& v : mesh.Vertices)
+    {
+        const XMFLOAT3 nrm = ToRightHanded(v.Normal);
+        const int n = std::snprintf(line, sizeof(line), "vn %.9g %.9g %.9g\n", nrm.x, nrm.y, nrm.z);
+        out.append(line, static_cast<std::size_t>(n));
+    }
+    for (std::size_t i = 0; i + 2 < mesh.Indices.size(); i += 3)
+    {
+        // 巻き順を戻す（a, c, b）。OBJ は 1 始まり
+        const unsigned a = mesh.Indices[i] + 1, b = mesh.Indices[i + 2] + 1, c = mesh.Indices[i + 1] + 1;
+        const int n = std::snprintf(line, sizeof(line), "f %u//%u %u//%u %u//%u\n", a, a, b, b, c, c);
+        out.append(line, static_cast<std::size_t>(n));
+    }
+}
+
+void WriteMeshGlb(const MeshData& mesh, std::vector<std::uint8_t>& out)
+{
+    // BIN：位置 | 法線 | 色 | インデックス（すべて 4B 境界）
+    const std::size_t count = mesh.Vertices.size();
+    std::vector<std::uint8_t> bin;
+    bin.reserve(count * 40 + mesh.Indices.size() * 4);
+    XMFLOAT3 mn{ FLT_MAX, FLT_MAX, FLT_MAX }, mx{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (const Vertex& v : mesh.Vertices)
+    {
+        const XMFLOAT3 p = ToRightHanded(v.Position);
+        AppendBytes(bin, &p, sizeof(p));
+        mn = { std::min(mn.x, p.x), std::min(mn.y, p.y), std::min(mn.z, p.z) };
+        mx = { std::max(mx.x, p.x), std::max(mx.y, p.y), std::max(mx.z, p.z) };
+    }
+    for (const Vertex& v : mesh.Vertices)
+    {
+        const XMFLOAT3 n = ToRightHanded(v.Normal);
+        AppendBytes(bin, &n, sizeof(n));
+    }
+    for (const Vertex& v : mesh.Vertices) AppendBytes(bin, &v.Color, sizeof(v.Color));
+    for (std::size_t i = 0; i + 2 < mesh.Indices.size(); i += 3)
+    {
+        AppendU32(bin, mesh.Indices[i]);
+        AppendU32(bin, mesh.Indices[i + 2]);
+        AppendU32(bin, mesh.Indices[i + 1]);
+    }
+    const std::size_t indexCount = mesh.Indices.size() / 3 * 3;
+
+    // JSON（POSITION は min/max が必須）
+    char json[2048];
+    const std::size_t p0 = 0, n0 = count * 12, c0 = count * 24, i0 = count * 40;
+    int len = std::snprintf(json, sizeof(json),
+        "{\"asset\":{\"version\":\"2.0\",\"generator\":\"MeshCorpus\"},\"scene\":0,\"scenes\":[{\"nodes\":[0]}],"
+        "\"nodes\":[{\"mesh\":0}],\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"COLOR_0\":2},\"indices\":3}]}],"
+        "\"accessors\":["
+        "{\"bufferView\":0,\"componentType\":5126,\"count\":%zu,\"type\":\"VEC3\",\"min\":[%.9g,%.9g,%.9g],\"max\":[%.9g,%.9g,%.9g]},"
+        "{\"bufferView\":1,\"componentType\":5126,\"count\":%zu,\"type\":\"VEC3\"},"
+        "{\"bufferView\":2,\"componentType\":5126,\"count\":%zu,\"type\":\"VEC4\"},"
+        "{\"bufferView\":3,\"componentType\":5125,\"count\":%zu,\"type\":\"SCALAR\"}],"
+        "\"bufferViews\":["
+        "{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu},{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu},"
+        "{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu},{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu}],"
+        "\"buffers\":[{\"byteLength\":%zu}]}",
+        count, mn.x, mn.y, mn.z, mx.x, mx.y, mx.z, count, count, indexCount,
+        p0, count * 12, n0, count * 12, c0, count * 16, i0, indexCount * 4, bin.size());
+    std::string text(json, static_cast<std::size_t>(len));
+    while (text.size() % 4) text.push_back(' ');
+    while (bin.size() % 4) bin.push_back(0);
+
+    out.clear();
+    out.reserve(28 + text.size() + bin.size());
+    AppendU32(out, 0x46546C67); // "glTF"
+    AppendU32(out, 2);
+    AppendU32(out, static_cast<std::uint32_t>(12 + 8 + text.size() + 8 + bin.size()));
+    AppendU32(out, static_cast<std::uint32_t>(text.size()));
+    AppendU32(out, 0x4E4F534A); // "JSON"
+    AppendBytes(out, text.data(), text.size());
+    AppendU32(out, static_cast<std::uint32_t>(bin.size()));
+    AppendU32(out, 0x004E4942); // "BIN\0"
+    AppendBytes(out, bin.data(), bin.size());
+}
+
+void RunImportBenchmark(const std::vector<MeshCorpusEntry>& corpus, std::size_t repeat,
+    std::vector<MeshImportBenchmarkResult>& out)
+{
+    out.clear();
+    const std::vector<MeshCorpusEntry> inputs = MakeFileBenchmarkInputs(corpus, repeat);
+
+    std::string obj;
+    std::vector<std::uint8_t> glb;
+    MeshData imported;
+    for (const MeshCorpusEntry& e : inputs)
+    {
+        WriteMeshObj(e.mesh, obj);
+        WriteMeshGlb(e.mesh, glb);
+        const struct { MeshFileFormat format; const void* data; std::size_t size; const char* ext; } files[] = {
+            { MeshFileFormat::Obj, obj.data(), obj.size(), ".obj" },
+            { MeshFileFormat::Glb, glb.data(), glb.size(), ".glb" } };
+        for (const auto& f : files)
+        {
+            MeshImportBenchmarkResult r;
+            r.name = e.name + f.ext;
+            r.format = f.format;
+            r.bytes = f.size;
+            r.milliseconds = DBL_MAX;
+            for (int run = 0; run < 3; ++run)
+            {
+                MeshImportStats stats;
+                ImportMeshFromMemory(f.data, f.size, f.format, imported, MeshImportOptions(), &stats);
+                r.triangles = stats.triangles;
+                r.milliseconds = std::min(r.milliseconds, stats.milliseconds);
+            }
+            const double seconds = std::max(r.milliseconds, 1e-6) * 1e-3;
+            r.megabytesPerSecond = static_cast<double>(r.bytes) * 1e-6 / seconds;
+            r.trianglesPerSecond = static_cast<double>(r.triangles) / seconds;
+            out.push_back(std::move(r));
+        }
+    }
+}
+
+void RunMeshCacheBenchmark(const std::vector<MeshCorpusEntry>& corpus, std::size_t repeat,
+    const MeshCacheVertexFormat& format, std::vector<MeshCacheBenchmarkResult>& out)
+{
+    out.clear();
+    const std::vector<MeshCorpusEntry> inputs = MakeFileBenchmarkInputs(corpus, repeat);
+    const MeshCacheBuildSettings settings;
+
+    std::string obj;
+    std::vector<std::uint8_t> glb, bytes;
+    MeshData imported, loaded;
+    MeshLods lods;
+    MeshletData meshlets;
+    for (const MeshCorpusEntry& e : inputs)
+    {
+        WriteMeshObj(e.mesh, obj);
+        WriteMeshGlb(e.mesh, glb);
+        const struct { MeshFileFormat format; const void* data; std::size_t size; const char* ext; } files[] = {
+            { MeshFileFormat::Obj, obj.data(), obj.size(), ".obj" },
+            { MeshFileFormat::Glb, glb.data(), glb.size(), ".glb" } };
+        for (const auto& f : files)
+        {
+            MeshCacheBenchmarkResult r;
+            r.name = e.name + f.ext;
+            r.format = f.format;
+            r.sourceBytes = f.size;
+            r.importMilliseconds = r.buildMilliseconds = r.loadMilliseconds = r.loadNoVerifyMilliseconds = DBL_MAX;
+            for (int run = 0; run < 3; ++run)
+            {
+                auto t0 = std::chrono::steady_clock::now();
+                ImportMeshFromMemory(f.data, f.size, f.format, imported);
+                auto t1 = std::chrono::steady_clock::now();
+                BuildMeshCache(imported, format, settings, 1, 1, bytes);
+                auto t2 = std::chrono::steady_clock::now();
+                r.importMilliseconds = std::min(r.importMilliseconds, std::chrono::duration<double, std::milli>(t1 - t0).count());
+                r.buildMilliseconds = std::min(r.buildMilliseconds, std::chrono::duration<double, std::milli>(t2 - t1).count());
+            }
+            r.cacheBytes = bytes.size();
+
+            for (int verify = 0; verify < 2; ++verify)
+            {
+                double& best = verify ? r.loadMilliseconds : r.loadNoVerifyMilliseconds;
+                for (int run = 0; run < 3; ++run)
+                {
+                    auto t0 = std::chrono::steady_clock::now();
+                    MeshCacheFile cache;
+                    if (!cache.OpenMemory(bytes.data(), bytes.size(), &format, 1, 1, verify != 0)) break;
+                    cache.CopyMesh(loaded);
+                    cache.CopyLods(lods);
+                    cache.CopyMeshlets(meshlets);
+                    best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count());
+                }
+            }
+            r.triangles = loaded.Indices.size() / 3;
+            r.speedup = (r.importMilliseconds + r.buildMilliseconds) / std::max(r.loadMilliseconds, 1e-6);
+            out.push_back(std::move(r));
+        }
+    }
+}
@@ -0,0 +1,131 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Assets/Mesh.h"
+#include "Assets/MeshOptimizer.h"
+#include "Assets/Meshlet.h"
+#include "Assets/MeshImporter.h"
+#include "Assets/MeshCache.h"
+
+/*
+===============================================================================
+ MeshCorpus（メッシュ処理のベンチマーク用に生成するメッシュ集）
+-------------------------------------------------------------------------------
+目的:
+  - MeshOptimizer / Meshlet などのメッシュ処理を、同じ入力で繰り返し比べられるようにする。
+    ファイルを持たず、決まった乱数の種から毎回同じメッシュを作る（GPU 不要）。
+  - テスト/ベンチマーク（MyEngineTests）専用。エンジン本体には含めない。
+
+中身（BuildMeshCorpus）:
+  - grid      : 256×256 マスの平面。行順に並んだ「素直な」入力
+  - sphere    : UV 球（128×64）。頂点共有あり
+  - torus     : トーラス（96×48）
+  - shuffled  : sphere の三角形と頂点配列をランダムに並べ替えたもの（キャッシュ/フェッチに最悪に近い）
+  - soup      : torus の頂点を三角形ごとに複製したもの（溶接が必要な入力）
+  - cubes     : 面ごとに頂点を持つ小さな立方体 4096 個をランダム順に並べたもの（小さな連結成分が多い）
+
+使い方:
+  std::vector<MeshCorpusEntry> corpus;
+  BuildMeshCorpus(corpus);
+  std::vector<MeshBenchmarkResult> results;
+  RunMeshOptimizerBenchmark(corpus, MeshOptimizeSettings(), results);
+  std::vector<MeshletBenchmarkResult> meshlets;
+  RunMeshletBenchmark(corpus, MeshletLimits(), meshlets);
+  std::vector<MeshImportBenchmarkResult> imports;
+  RunImportBenchmark(corpus, 4, imports);
+  std::vector<MeshCacheBenchmarkResult> caches;
+  RunMeshCacheBenchmark(corpus, 4, GpuMeshCacheFormat(), caches); // 形式は Upload/MeshUploader.h
+
+ファイル形式（インポータの入力を作る）:
+  - WriteMeshObj / WriteMeshGlb は MeshImporter の逆変換（Z 反転 + 巻き順の入れ替え）をかけて書くので、
+    既定の設定で読み戻すと元の MeshData と同じ並び・同じ値（OBJ は 10 進 9 桁の丸め）になる。
+===============================================================================
+*/
+
+struct MeshCorpusEntry
+{
+    std::string name;
+    MeshData    mesh;
+};
+
+struct MeshBenchmarkResult
+{
+    std::string       name;
+    std::size_t       triangles = 0;
+    MeshOptimizeStats stats;             // 前後の ACMR/ATVR と頂点数
+    double            milliseconds = 0.0; // OptimizeMesh 1 回の時間
+};
+
+struct MeshletBenchmarkResult
+{
+    std::string name;
+    std::size_t triangles = 0;
+    std::size_t meshlets = 0;
+    float       avgVertices = 0.0f;  // メッシュレットあたりの頂点数（上限に近いほど詰まっている）
+    float       avgTriangles = 0.0f; // メッシュレットあたりの三角形数
+    float       coneFraction = 0.0f; // 法線コーンを持つ（裏向きで捨てられうる）メッシュレットの割合
+    double      milliseconds = 0.0;  // OptimizeMesh 済みのコピーに BuildMeshlets 1 回の時間
+};
+
+struct MeshImportBenchmarkResult
+{
+    std::string    name;
+    MeshFileFormat format = MeshFileFormat::Unknown;
+    std::size_t    bytes = 0;
+    std::size_t    triangles = 0;
+    double         milliseconds = 0.0;       // ImportMeshFromMemory 1 回の時間（数回の最小）
+    double         megabytesPerSecond = 0.0; // bytes / 時間（1 MB = 10^6 B）
+    double         trianglesPerSecond = 0.0;
+};
+
+struct MeshCacheBenchmarkResult
+{
+    std::string    name;
+    MeshFileFormat format = MeshFileFormat::Unknown; // 読み込み直す側の元ファイルの形式
+    std::size_t    sourceBytes = 0;
+    std::size_t    cacheBytes = 0;
+    std::size_t    triangles = 0;
+    double         importMilliseconds = 0.0;   // ImportMeshFromMemory
+    double         buildMilliseconds = 0.0;    // BuildMeshCache（最適化・LOD・メッシュレット・GPU 形式への詰め込み）
+    double         loadMilliseconds = 0.0;     // OpenMemory（contentHash の確認あり）+ CPU 側へのコピー
+    double         loadNoVerifyMilliseconds = 0.0; // 同上、contentHash の確認なし
+    double         speedup = 0.0;              // (import + build) / load
+};
+
+/// 生成メッシュ集を作る（out は上書き）
+void BuildMeshCorpus(std::vector<MeshCorpusEntry>& out, std::uint32_t seed = 1);
+
+/// corpus の各メッシュのコピーに OptimizeMesh をかけて、指標と時間を集める（out は上書き）
+void RunMeshOptimizerBenchmark(const std::vector<MeshCorpusEntry>& corpus,
+    const MeshOptimizeSettings& settings, std::vector<MeshBenchmarkResult>& out);
+
+/// corpus の各メッシュ（OptimizeMesh 済みのコピー）を BuildMeshlets で分け、詰まり具合と時間を集める（out は上書き）
+void RunMeshletBenchmark(const std::vector<MeshCorpusEntry>& corpus,
+    const MeshletLimits& limits, std::vector<MeshletBenchmarkResult>& out);
+
+/// mesh を OBJ テキストにする（v に頂点カラー、vn、"f a//a b//b c//c"。out は上書き）
+void WriteMeshObj(const MeshData& mesh, std::string& out);
+
+/// mesh を GLB にする（POSITION / NORMAL / COLOR_0 + 32bit インデックス、ノード 1 つ。out は上書き）
+void WriteMeshGlb(const MeshData& mesh, std::vector<std::uint8_t>& out);
+
+/**
+ * @brief インポータの速度を測る（out は上書き）
+ * @details corpus の各メッシュと、全部を 1 つに結合して repeat 回ずらして並べた大きなメッシュを
+ *          OBJ / GLB に書き出し、ImportMeshFromMemory で読み戻す時間を測る（書き出しの時間は含めない）。
+ */
+void RunImportBenchmark(const std::vector<MeshCorpusEntry>& corpus, std::size_t repeat,
+    std::vector<MeshImportBenchmarkResult>& out);
+
+/**
+ * @brief .mesh キャッシュの読み込みと、元ファイルからの読み込み直しを比べる（out は上書き）
+ * @details RunImportBenchmark と同じメッシュを OBJ / GLB に書き出し、
+ *          読み込み直す側 = ImportMeshFromMemory + BuildMeshCache（起動のたびに解析して焼き込む場合）、
+ *          キャッシュ側 = MeshCacheFile::OpenMemory + CopyMesh/CopyLods/CopyMeshlets
+ *          （SetMeshFromCache が行うコピー。GPU へはこの後ステージングへのコピーだけ）で時間を測る。
+ *          ファイルの I/O は含めない（どちらもメモリ上のバイト列から）。
+ */
+void RunMeshCacheBenchmark(const std::vector<MeshCorpusEntry>& corpus, std::size_t repeat,
+    const MeshCacheVertexFormat& format, std::vector<MeshCacheBenchmarkResult>& out);
@@ -0,0 +1,314 @@
+﻿#include "TestFramework.h"
+#include "Assets/MeshImporter.h"
+#include "Assets/MeshCorpus.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/*
+    MeshImporter のテスト
+    ----------------------------------------------------------------------------
+      - コーパスを WriteMeshObj / WriteMeshGlb で書いて読み戻すと、並びも値も元に戻る
+      - OBJ：負のインデックス、法線の生成、法線の違う角の分割、多角形の扇形分割、壊れた入力
+      - glTF：data: URI、STRIP / FAN、ノードの行列、外部 .bin（ファイルからだけ読める）
+      - ファイル（MappedFile 経由）からの読み込みと、切り詰め/壊れた GLB・JSON の拒否
+    ベンチマークは RunImportBenchmark の MB/s と三角形/秒を出す。
+*/
+
+namespace
+{
+    using DirectX::XMFLOAT3;
+
+    XMFLOAT3 Sub(const XMFLOAT3& a, const XMFLOAT3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+    float Dot(const XMFLOAT3& a, const XMFLOAT3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    XMFLOAT3 Cross(const XMFLOAT3& a, const XMFLOAT3& b) { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+    bool Near(const XMFLOAT3& a, const XMFLOAT3& b, float eps)
+    {
+        return std::fabs(a.x - b.x) <= eps && std::fabs(a.y - b.y) <= eps && std::fabs(a.z - b.z) <= eps;
+    }
+
+    bool Import(const std::string& text, MeshData& out, MeshImportStats* stats = nullptr,
+        const MeshImportOptions& options = MeshImportOptions())
+    {
+        return ImportMeshFromMemory(text.data(), text.size(), MeshFileFormat::Unknown, out, options, stats);
+    }
+
+    // 三角形の面法線（左手系 CW = cross(b-a, c-a)）と頂点法線が同じ側を向いているか
+    void CheckFacing(const MeshData& m)
+    {
+        for (std::size_t i = 0; i + 2 < m.Indices.size(); i += 3)
+        {
+            const Vertex& a = m.Vertices[m.Indices[i]];
+            const Vertex& b = m.Vertices[m.Indices[i + 1]];
+            const Vertex& c = m.Vertices[m.Indices[i + 2]];
+            const XMFLOAT3 n = Cross(Sub(b.Position, a.Position), Sub(c.Position, a.Position));
+            if (Dot(n, n) < 1e-12f) continue;
+            CHECK(Dot(n, a.Normal) > 0 && Dot(n, b.Normal) > 0 && Dot(n, c.Normal) > 0);
+        }
+    }
+
+    std::string Base64(const std::vector<std::uint8_t>& d)
+    {
+        static const char* t = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string out;
+        std::size_t i = 0;
+        for (; i + 2 < d.size(); i += 3)
+        {
+            const unsigned v = d[i] << 16 | d[i + 1] << 8 | d[i + 2];
+            out += { t[v >> 18], t[v >> 12 & 63], t[v >> 6 & 63], t[v & 63] };
+        }
+        if (d.size() - i == 1) { const unsigned v = d[i] << 16; out += { t[v >> 18], t[v >> 12 & 63], '=', '=' }; }
+        if (d.size() - i == 2) { const unsigned v = d[i] << 16 | d[i + 1] << 8; out += { t[v >> 18], t[v >> 12 & 63], t[v >> 6 & 63], '=' }; }
+        return out;
+    }
+
+    template <class T>
+    void Put(std::vector<std::uint8_t>& b, T v)
+    {
+        const std::uint8_t* p = reinterpret_cast<const std::uint8_t*>(&v);
+        b.insert(b.end(), p, p + sizeof(T));
+    }
+
+    void WriteFile(const std::wstring& path, const void* data, std::size_t size)
+    {
+        std::ofstream f(std::filesystem::path(path), std::ios::binary);
+        f.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    }
+}
+
+TEST_CASE(MeshImporter_CorpusRoundTrip)
+{
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    for (const MeshCorpusEntry& e : corpus)
+    {
+        std::string obj;
+        WriteMeshObj(e.mesh, obj);
+        MeshData m;
+        MeshImportStats stats;
+        REQUIRE(Import(obj, m, &stats));
+        CHECK(stats.format == MeshFileFormat::Obj);
+        CHECK(!stats.generatedNormals);
+        REQUIRE(m.Vertices.size() == e.mesh.Vertices.size());
+        CHECK(m.Indices == e.mesh.Indices);
+        for (std::size_t i = 0; i < m.Vertices.size(); ++i)
+        {
+            CHECK(Near(m.Vertices[i].Position, e.mesh.Vertices[i].Position, 1e-5f));
+            CHECK(Near(m.Vertices[i].Normal, e.mesh.Vertices[i].Normal, 1e-5f));
+            CHECK(std::fabs(m.Vertices[i].Color.x - e.mesh.Vertices[i].Color.x) < 1e-6f);
+        }
+
+        std::vector<std::uint8_t> glb;
+        WriteMeshGlb(e.mesh, glb);
+        MeshData g;
+        REQUIRE(ImportMeshFromMemory(glb.data(), glb.size(), MeshFileFormat::Unknown, g, MeshImportOptions(), &stats));
+        CHECK(stats.format == MeshFileFormat::Glb);
+        REQUIRE(g.Vertices.size() == e.mesh.Vertices.size());
+        CHECK(g.Indices == e.mesh.Indices);
+        for (std::size_t i = 0; i < g.Vertices.size(); ++i)
+        {
+            CHECK(Near(g.Vertices[i].Position, e.mesh.Vertices[i].Position, 0.0f)); // 32bit float のまま（-0 を除き一致）
+            CHECK(Near(g.Vertices[i].Normal, e.mesh.Vertices[i].Normal, 1e-6f));
+            CHECK(std::memcmp(&g.Vertices[i].Color, &e.mesh.Vertices[i].Color, sizeof(DirectX::XMFLOAT4)) == 0);
+        }
+
+        // 変換なし：Z が反転し、三角形の 2 番目と 3 番目が入れ替わる
+        MeshImportOptions raw;
+        raw.convertToLeftHanded = false;
+        MeshData r;
+        REQUIRE(Import(obj, r, nullptr, raw));
+        CHECK(std::fabs(r.Vertices[0].Position.z + m.Vertices[0].Position.z) < 1e-6f);
+        CHECK(r.Indices[1] == m.Indices[2] && r.Indices[2] == m.Indices[1]);
+    }
+}
+
+TEST_CASE(MeshImporter_ObjFaces)
+{
+    // 負のインデックス、法線なし、コメント/CRLF/vt/g は読み飛ばす
+    {
+        const std::string s = "# quad\r\nv 0 0 0\r\nv 1 0 0\r\nv 1 1 0\r\nv 0 1 0\r\nvt 0 0\r\ng grp\r\nf -4 -3 -2 -1\r\n";
+        MeshData m;
+        MeshImportStats stats;
+        REQUIRE(Import(s, m, &stats));
+        CHECK(stats.generatedNormals);
+        CHECK(stats.triangles == 2);
+        CHECK(stats.positions == 4);
+        CHECK(m.Vertices.size() == 4);
+        for (const Vertex& v : m.Vertices)
+        {
+            CHECK(Near(v.Normal, { 0, 0, -1 }, 1e-6f));
+            CHECK(v.Color.x == 1.0f && v.Color.w == 1.0f);
+        }
+        CheckFacing(m);
+    }
+
+    // 法線の違う角（立方体の辺）は頂点を分ける
+    {
+        const std::string s =
+            "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 0 0 -1\nv 0 1 -1\n"
+            "vt 0 0\nvn 0 0 1\nvn -1 0 0\n"
+            "f 1/1/1 2/1/1 3/1/1 4/1/1\n"
+            "f 1/1/2 4/1/2 6/1/2 5/1/2\n";
+        MeshData m;
+        REQUIRE(Import(s, m));
+        CHECK(m.Indices.size() == 12);
+        CHECK(m.Vertices.size() == 8); // 1 と 4 は 2 つ目の法線の分だけ増える
+        CheckFacing(m);
+    }
+
+    // 五角形は扇形に 3 三角形
+    {
+        MeshData m;
+        REQUIRE(Import("v 0 0 0\nv 2 0 0\nv 3 1 0\nv 1 2 0\nv -1 1 0\nf 1 2 3 4 5\n", m));
+        CHECK(m.Indices.size() == 9);
+        CheckFacing(m);
+    }
+
+    // 辺を共有する 2 面：法線は面積で重み付けして滑らかにする
+    {
+        MeshData m;
+        REQUIRE(Import("v 0 0 0\nv 1 0 0\nv 0 1 0\nv 0 0 1\nf 1 3 2\nf 1 2 4\n", m));
+        CheckFacing(m);
+        const XMFLOAT3 n = m.Vertices[0].Normal;
+        CHECK(std::fabs(Dot(n, n) - 1.0f) < 1e-5f);
+        CHECK(n.y < 0 && n.z > 0);
+    }
+}
+
+TEST_CASE(MeshImporter_ObjErrors)
+{
+    MeshData m;
+    MeshImportStats stats;
+    CHECK(!Import("v 0 0 0\nf 1 2 3\n", m, &stats)); // 範囲外
+    CHECK(m.Vertices.empty());
+    CHECK(stats.error != nullptr);
+    CHECK(!Import("v 0 0 0\nv 1 0 0\nf 1 0 2\n", m)); // 0 は不正
+    CHECK(!Import("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3 \nf 1/1/9 2 3\n", m)); // 法線が範囲外
+}
+
+TEST_CASE(MeshImporter_GltfNodesAndExternalBuffer)
+{
+    // 4 頂点（XY 平面の四角形）+ STRIP のインデックス + FAN のインデックス（16bit）
+    std::vector<std::uint8_t> bin;
+    for (float f : { 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 1.f, 1.f, 0.f }) Put(bin, f);
+    for (std::uint16_t v : { 0, 1, 2, 3 }) Put(bin, v);
+    for (std::uint16_t v : { 0, 1, 3, 2 }) Put(bin, v);
+    const std::string uri = "data:application/octet-stream;base64," + Base64(bin);
+
+    char json[4096];
+    std::snprintf(json, sizeof(json),
+        "{ \"asset\":{\"version\":\"2.0\"}, \"scene\":0, \"scenes\":[{\"nodes\":[0,1,2]}],"
+        " \"nodes\":[ {\"mesh\":0, \"translation\":[5,0,0]},"
+        "  {\"mesh\":1, \"scale\":[-1,1,1]},"
+        "  {\"children\":[3], \"matrix\":[1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,10,1]}, {\"mesh\":0, \"rotation\":[0,0.7071068,0,0.7071068]} ],"
+        " \"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0},\"indices\":1,\"mode\":5}]},"
+        "   {\"primitives\":[{\"attributes\":{\"POSITION\":0},\"indices\":2,\"mode\":6},{\"attributes\":{\"POSITION\":0},\"mode\":1}]}],"
+        " \"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":4,\"type\":\"VEC3\"},"
+        "  {\"bufferView\":1,\"componentType\":5123,\"count\":4,\"type\":\"SCALAR\"},"
+        "  {\"bufferView\":1,\"byteOffset\":8,\"componentType\":5123,\"count\":4,\"type\":\"SCALAR\"}],"
+        " \"bufferViews\":[{\"buffer\":0,\"byteLength\":48},{\"buffer\":0,\"byteOffset\":48,\"byteLength\":16}],"
+        " \"buffers\":[{\"byteLength\":%zu,\"uri\":\"%s\"}] }", bin.size(), uri.c_str());
+    const std::string s = json;
+
+    MeshData m;
+    MeshImportStats stats;
+    REQUIRE(Import(s, m, &stats));
+    CHECK(stats.format == MeshFileFormat::Gltf);
+    CHECK(stats.triangles == 6); // 線のプリミティブは飛ばす
+    CHECK(stats.generatedNormals);
+    REQUIRE(m.Indices.size() == 18);
+    CheckFacing(m);
+
+    bool translated = false, mirrored = false, nested = false;
+    for (const Vertex& v : m.Vertices)
+    {
+        if (v.Position.x >= 5) translated = true;
+        if (v.Position.x < 0) mirrored = true;
+        if (v.Position.z < -9) nested = true; // 親の行列（z+10）が Z 反転で -10 になる
+    }
+    CHECK(translated && mirrored && nested);
+    for (std::size_t i = 0; i < 12; ++i) CHECK(Near(m.Vertices[m.Indices[i]].Normal, { 0, 0, -1 }, 1e-5f));
+    for (std::size_t i = 12; i < 18; ++i) CHECK(Near(m.Vertices[m.Indices[i]].Normal, { 1, 0, 0 }, 1e-4f)); // y 軸 90°
+
+    // 外部 .bin（パスは URI エンコード）はファイルからなら読めるが、メモリからは読めない
+    std::string external = s;
+    external.replace(external.find(uri), uri.size(), "sub%20dir.bin");
+    WriteFile(test::TempPath(L"model.gltf"), external.data(), external.size());
+    WriteFile(test::TempPath(L"sub dir.bin"), bin.data(), bin.size());
+    MeshData f;
+    REQUIRE(ImportMesh(test::TempPath(L"model.gltf").c_str(), f));
+    CHECK(f.Indices == m.Indices);
+    CHECK(f.Vertices.size() == m.Vertices.size());
+    MeshData fromMemory;
+    CHECK(!Import(external, fromMemory, &stats));
+    CHECK(stats.error != nullptr);
+}
+
+TEST_CASE(MeshImporter_FilesAndCorruptInput)
+{
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    const MeshData& mesh = corpus[0].mesh;
+    std::string obj;
+    WriteMeshObj(mesh, obj);
+    std::vector<std::uint8_t> glb;
+    WriteMeshGlb(mesh, glb);
+    const std::wstring objPath = test::TempPath(L"import.OBJ"), glbPath = test::TempPath(L"import.glb");
+    WriteFile(objPath, obj.data(), obj.size());
+    WriteFile(glbPath, glb.data(), glb.size());
+
+    CHECK(DetectMeshFileFormat(objPath.c_str()) == MeshFileFormat::Obj);
+    CHECK(DetectMeshFileFormat(L"a.GlTf") == MeshFileFormat::Gltf);
+    CHECK(DetectMeshFileFormat(L"x.fbx") == MeshFileFormat::Unknown);
+    CHECK(DetectMeshFileFormat(glb.data(), glb.size()) == MeshFileFormat::Glb);
+
+    MeshData a, b, c;
+    REQUIRE(ImportMesh(objPath.c_str(), a));
+    REQUIRE(ImportMesh(glbPath.c_str(), b));
+    CHECK(a.Indices == b.Indices);
+    MeshImportStats stats;
+    CHECK(!ImportMesh(test::TempPath(L"missing.obj").c_str(), c, MeshImportOptions(), &stats));
+    CHECK(stats.error != nullptr);
+    WriteFile(test::TempPath(L"empty.obj"), "", 0);
+    CHECK(!ImportMesh(test::TempPath(L"empty.obj").c_str(), c));
+
+    // GLB をどこで切り詰めても、壊れたまま読まずに失敗する
+    for (std::size_t n = 0; n < glb.size(); n += (n < 200 ? 1 : 997))
+    {
+        MeshData d;
+        CHECK(!ImportMeshFromMemory(glb.data(), n, MeshFileFormat::Glb, d));
+        CHECK(d.Indices.empty());
+    }
+    std::vector<std::uint8_t> bad = glb; // 最後のインデックスを範囲外に
+    bad[glb.size() - 4] = 0xff;
+    bad[glb.size() - 3] = 0xff;
+    bad[glb.size() - 2] = 0xff;
+    bad[glb.size() - 1] = 0x7f;
+    MeshData d;
+    CHECK(!ImportMeshFromMemory(bad.data(), bad.size(), MeshFileFormat::Glb, d));
+
+    for (const char* j : { "{", "{\"asset\":}", "[1,2", "{\"a\":\"\\", "{}",
+        "{\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":9}}]}]}" })
+        CHECK(!ImportMeshFromMemory(j, std::strlen(j), MeshFileFormat::Gltf, d));
+    const std::string deep(200, '['); // 入れ子が深すぎる
+    CHECK(!ImportMeshFromMemory(deep.data(), deep.size(), MeshFileFormat::Gltf, d));
+}
+
+BENCHMARK(MeshImporter_Corpus)
+{
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    std::vector<MeshImportBenchmarkResult> results;
+    RunImportBenchmark(corpus, 8, results);
+    for (const MeshImportBenchmarkResult& r : results)
+    {
+        test::Report(("import " + r.name).c_str(), r.milliseconds);
+        std::printf("  %9zu B %8zu tris %8.1f MB/s %7.2f Mtri/s\n",
+            r.bytes, r.triangles, r.megabytesPerSecond, r.trianglesPerSecond * 1e-6);
+    }
+}
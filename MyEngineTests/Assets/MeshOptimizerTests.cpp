@@ -0,0 +1,150 @@
+﻿#include "TestFramework.h"
+#include "Assets/MeshOptimizer.h"
+#include "Assets/MeshCorpus.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/*
+    MeshOptimizer のテスト
+    ----------------------------------------------------------------------------
+      - WeldVertices は属性がビット単位で等しい頂点をまとめ、-0 と +0 は同じと見なす
+      - 前提を満たさない入力（3 の倍数でない / 範囲外の添字 / 空）は触らない
+      - OptimizeVertexFetch は参照されない頂点を捨て、初出順に並べる
+      - コーパスの全メッシュで、三角形の集合と巻き順は変わらず、ACMR は悪くならない
+    ベンチマークはコーパスごとの ACMR / ATVR と時間を出す。
+*/
+
+namespace
+{
+    using Triangle = std::array<float, 9>;
+
+    // 三角形を位置の並びにし、巻き順を保ったまま最小の頂点が先頭に来るよう回して並べる
+    std::vector<Triangle> Triangles(const MeshData& m)
+    {
+        std::vector<Triangle> out;
+        out.reserve(m.Indices.size() / 3);
+        for (std::size_t i = 0; i + 2 < m.Indices.size(); i += 3)
+        {
+            std::array<std::array<float, 3>, 3> c;
+            for (int k = 0; k < 3; ++k)
+            {
+                const DirectX::XMFLOAT3& p = m.Vertices[m.Indices[i + k]].Position;
+                c[k] = { p.x, p.y, p.z };
+            }
+            int first = 0;
+            for (int k = 1; k < 3; ++k) if (c[k] < c[first]) first = k;
+            Triangle t;
+            for (int k = 0; k < 3; ++k)
+                for (int j = 0; j < 3; ++j) t[k * 3 + j] = c[(first + k) % 3][j];
+            out.push_back(t);
+        }
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+}
+
+TEST_CASE(MeshOptimizer_AnalyzeSingleTriangle)
+{
+    const std::uint32_t idx[] = { 0, 1, 2, 2, 1, 0 };
+    const VertexCacheStats s = AnalyzeVertexCache(idx, 6, 3);
+    CHECK(s.misses == 3);
+    CHECK(s.triangles == 2);
+    CHECK(s.vertices == 3);
+    CHECK(s.acmr == 1.5f);
+    CHECK(s.atvr == 1.0f);
+}
+
+TEST_CASE(MeshOptimizer_WeldMergesEqualVertices)
+{
+    MeshData m;
+    const Vertex a{ { 0, 0, 0 }, { 0, 0, 1 }, { 1, 1, 1, 1 } };
+    Vertex b = a;
+    b.Position.x = -0.0f;
+    const Vertex c{ { 1, 0, 0 }, { 0, 0, 1 }, { 1, 1, 1, 1 } };
+    const Vertex d{ { 0, 1, 0 }, { 0, 0, 1 }, { 1, 1, 1, 1 } };
+    m.Vertices = { a, c, d, b, c, d, c };
+    m.Indices = { 0, 1, 2, 3, 4, 5, 6, 1, 2 };
+
+    CHECK(WeldVertices(m) == 4);
+    CHECK(m.Vertices.size() == 3);
+    CHECK((m.Indices == std::vector<std::uint32_t>{ 0, 1, 2, 0, 1, 2, 1, 1, 2 }));
+}
+
+TEST_CASE(MeshOptimizer_InvalidInputIsUntouched)
+{
+    MeshData m;
+    m.Vertices.resize(3);
+    m.Indices = { 0, 1, 5 };
+    CHECK(!OptimizeMesh(m).optimized);
+    CHECK(m.Indices[2] == 5);
+
+    m.Indices = { 0, 1 };
+    CHECK(!OptimizeMesh(m).optimized);
+    CHECK(m.Indices.size() == 2);
+
+    MeshData empty;
+    CHECK(!OptimizeMesh(empty).optimized);
+}
+
+TEST_CASE(MeshOptimizer_VertexFetchDropsUnused)
+{
+    MeshData m;
+    m.Vertices.resize(5);
+    for (int i = 0; i < 5; ++i) m.Vertices[i].Position = { static_cast<float>(i), 0, 0 };
+    m.Indices = { 4, 2, 3 };
+
+    CHECK(OptimizeVertexFetch(m) == 3);
+    REQUIRE(m.Vertices.size() == 3);
+    CHECK(m.Vertices[0].Position.x == 4);
+    CHECK(m.Vertices[1].Position.x == 2);
+    CHECK(m.Vertices[2].Position.x == 3);
+    CHECK((m.Indices == std::vector<std::uint32_t>{ 0, 1, 2 }));
+}
+
+TEST_CASE(MeshOptimizer_CorpusKeepsTrianglesAndImprovesCache)
+{
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    REQUIRE(!corpus.empty());
+
+    for (const MeshCorpusEntry& e : corpus)
+    {
+        MeshData m = e.mesh;
+        const std::vector<Triangle> before = Triangles(m);
+        const MeshOptimizeStats s = OptimizeMesh(m);
+        REQUIRE(s.optimized);
+        CHECK(Triangles(m) == before);
+        CHECK(s.after.acmr <= s.before.acmr + 1e-6f);
+        CHECK(s.verticesAfter == m.Vertices.size());
+
+        // 頂点は初出順：添字は「これまでの最大 + 1」を超えない
+        std::uint32_t next = 0;
+        for (std::uint32_t i : m.Indices)
+        {
+            REQUIRE(i <= next);
+            if (i == next) ++next;
+        }
+        CHECK(next == m.Vertices.size());
+    }
+}
+
+BENCHMARK(MeshOptimizer_Corpus)
+{
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    std::vector<MeshBenchmarkResult> results;
+    RunMeshOptimizerBenchmark(corpus, MeshOptimizeSettings(), results);
+
+    std::printf("  %-9s %8s %17s %14s %14s %5s\n", "mesh", "tris", "verts", "ACMR", "ATVR", "clus");
+    for (const MeshBenchmarkResult& r : results)
+    {
+        const MeshOptimizeStats& s = r.stats;
+        std::printf("  %-9s %8zu %8zu->%-7zu %6.3f->%-6.3f %6.3f->%-6.3f %5zu\n",
+            r.name.c_str(), r.triangles, s.verticesBefore, s.verticesAfter,
+            s.before.acmr, s.after.acmr, s.before.atvr, s.after.atvr, s.clusters);
+        test::Report(("OptimizeMesh " + r.name).c_str(), r.milliseconds);
+    }
+}
@@ -0,0 +1,258 @@
+﻿#include "TestFramework.h"
+#include "Assets/MeshSimplifier.h"
+#include "Assets/MeshOptimizer.h"
+#include "Assets/MeshCorpus.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/*
+    MeshSimplifier のテスト
+    ----------------------------------------------------------------------------
+      - 前提を満たさない入力はそのまま返し、LOD は作らない
+      - SimplifyMesh は目標の比（1/2・1/4・1/10）のすぐ下まで減らし、誤差の上限を与えるとそこで止まる
+      - コーパスの全メッシュの LOD で、
+          インデックスは頂点数未満、縮退三角形なし、三角形数は LOD0 × reduction^k のすぐ下、
+          誤差は段ごとに減らず maxError 以下、裏返った三角形（頂点法線から 120° 以上ずれる）が元より増えない
+      - 平らな格子は誤差 0 のまま減り、外周は動かない
+      - 複数メッシュ版（並列）は 1 つずつ作ったのと同じ結果になる
+    ベンチマークはコーパスごとの LOD 生成の時間と各段の三角形数/誤差。
+    描画時の段の選び方（ヒステリシス）は Renderer/LodSelectionTests.cpp。
+*/
+
+namespace
+{
+    DirectX::XMFLOAT3 FaceNormal(const MeshData& m, const unsigned int* tri)
+    {
+        const DirectX::XMFLOAT3& a = m.Vertices[tri[0]].Position;
+        const DirectX::XMFLOAT3& b = m.Vertices[tri[1]].Position;
+        const DirectX::XMFLOAT3& c = m.Vertices[tri[2]].Position;
+        const DirectX::XMFLOAT3 e1{ b.x - a.x, b.y - a.y, b.z - a.z }, e2{ c.x - a.x, c.y - a.y, c.z - a.z };
+        return { e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z, e1.x * e2.y - e1.y * e2.x };
+    }
+
+    // 面法線と 3 頂点の法線の和がなす角の cos（面積 0 の三角形は 0）
+    float FacingCos(const MeshData& m, const unsigned int* tri)
+    {
+        const DirectX::XMFLOAT3 f = FaceNormal(m, tri);
+        DirectX::XMFLOAT3 s{};
+        for (int k = 0; k < 3; ++k)
+        {
+            const DirectX::XMFLOAT3& n = m.Vertices[tri[k]].Normal;
+            s.x += n.x; s.y += n.y; s.z += n.z;
+        }
+        const float len = std::sqrt((f.x * f.x + f.y * f.y + f.z * f.z) * (s.x * s.x + s.y * s.y + s.z * s.z));
+        return len > 0.0f ? (f.x * s.x + f.y * s.y + f.z * s.z) / len : 0.0f;
+    }
+
+    // 元のメッシュで多数の三角形が取る向き（巻き順と頂点法線の関係。+1 / -1）
+    float Orientation(const MeshData& m)
+    {
+        std::size_t positive = 0, negative = 0;
+        for (std::size_t i = 0; i + 2 < m.Indices.size(); i += 3)
+        {
+            const float c = FacingCos(m, m.Indices.data() + i);
+            positive += c > 0.0f;
+            negative += c < 0.0f;
+        }
+        return positive >= negative ? 1.0f : -1.0f;
+    }
+
+    // 向きが orientation から 120° 以上ずれた（裏返った）三角形の数。
+    // 粗い段では曲率の大きい所（トーラスの内側など）で 90° を少し超える三角形ができるので、それは数えない
+    std::size_t CountFlipped(const MeshData& m, const unsigned int* indices, std::size_t indexCount, float orientation)
+    {
+        std::size_t flipped = 0;
+        for (std::size_t i = 0; i + 2 < indexCount; i += 3)
+            if (FacingCos(m, indices + i) * orientation < -0.5f) ++flipped;
+        return flipped;
+    }
+
+    // 範囲外の番号と縮退三角形が無いか
+    void CheckTriangles(const MeshData& m, const unsigned int* indices, std::size_t indexCount)
+    {
+        REQUIRE(indexCount % 3 == 0);
+        std::size_t outOfRange = 0, degenerate = 0;
+        for (std::size_t i = 0; i < indexCount; i += 3)
+        {
+            const unsigned int a = indices[i], b = indices[i + 1], c = indices[i + 2];
+            if (a >= m.Vertices.size() || b >= m.Vertices.size() || c >= m.Vertices.size()) ++outOfRange;
+            if (a == b || b == c || a == c) ++degenerate;
+        }
+        CHECK(outOfRange == 0);
+        CHECK(degenerate == 0);
+    }
+
+    const MeshData* Find(const std::vector<MeshCorpusEntry>& corpus, const char* name)
+    {
+        for (const MeshCorpusEntry& e : corpus) if (e.name == name) return &e.mesh;
+        return nullptr;
+    }
+}
+
+TEST_CASE(MeshSimplifier_InvalidInputIsCopied)
+{
+    MeshData m;
+    m.Vertices.resize(3);
+    m.Indices = { 0, 1, 7 };
+    unsigned int dst[3] = {};
+    float error = 1.0f;
+    CHECK(SimplifyMesh(dst, m.Indices.data(), 3, m.Vertices.data(), 3, 0, 1.0f, &error) == 3);
+    CHECK(dst[0] == 0 && dst[1] == 1 && dst[2] == 7);
+    CHECK(error == 0.0f);
+
+    MeshLods lods;
+    lods.Levels.resize(2);
+    CHECK(BuildMeshLods(m, MeshLodSettings(), lods) == 1);
+    CHECK(lods.Levels.empty());
+    CHECK(lods.Indices.empty());
+}
+
+TEST_CASE(MeshSimplifier_ReachesTargetRatios)
+{
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    for (const char* name : { "sphere", "torus" })
+    {
+        const MeshData* found = Find(corpus, name);
+        REQUIRE(found != nullptr);
+        MeshData m = *found;
+        OptimizeMesh(m);
+        std::vector<unsigned int> dst(m.Indices.size());
+        const float orientation = Orientation(m);
+        const std::size_t baseFlipped = CountFlipped(m, m.Indices.data(), m.Indices.size(), orientation);
+
+        float prevError = 0.0f, halfError = 0.0f;
+        for (const float ratio : { 0.5f, 0.25f, 0.1f })
+        {
+            const std::size_t target = static_cast<std::size_t>(m.Indices.size() * ratio) / 3 * 3;
+            float error = -1.0f;
+            const std::size_t n = SimplifyMesh(dst.data(), m.Indices.data(), m.Indices.size(),
+                m.Vertices.data(), m.Vertices.size(), target, 1.0f, &error);
+            CHECK(n <= target);
+            CHECK(n >= target * 95 / 100);
+            CHECK(error >= prevError);
+            CHECK(error <= 0.05f);
+            CheckTriangles(m, dst.data(), n);
+            CHECK(CountFlipped(m, dst.data(), n, orientation) <= baseFlipped);
+            prevError = error;
+            if (ratio == 0.5f) halfError = error;
+        }
+
+        // 誤差の上限を 1/2 の段の誤差の半分にすると、1/10 まで減らないうちに止まる
+        const float limit = halfError * 0.5f;
+        const std::size_t target = m.Indices.size() / 10 / 3 * 3;
+        float error = -1.0f;
+        const std::size_t n = SimplifyMesh(dst.data(), m.Indices.data(), m.Indices.size(),
+            m.Vertices.data(), m.Vertices.size(), target, limit, &error);
+        CHECK(n > target);
+        CHECK(n < m.Indices.size());
+        CHECK(error <= limit);
+    }
+}
+
+TEST_CASE(MeshSimplifier_CorpusLodsAreValid)
+{
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    const MeshLodSettings settings;
+    for (const MeshCorpusEntry& e : corpus)
+    {
+        MeshData m = e.mesh;
+        OptimizeMesh(m);
+        MeshLods lods;
+        const std::uint32_t count = BuildMeshLods(m, settings, lods);
+        REQUIRE(count == lods.Levels.size() + 1);
+        CHECK(count <= settings.maxLods);
+        if (e.name == "sphere" || e.name == "torus" || e.name == "grid") CHECK(count == settings.maxLods);
+
+        const float orientation = Orientation(m);
+        const std::size_t baseFlipped = CountFlipped(m, m.Indices.data(), m.Indices.size(), orientation);
+        double target = static_cast<double>(m.Indices.size() / 3);
+        std::size_t prevTriangles = m.Indices.size() / 3;
+        float prevError = 0.0f;
+        for (const MeshLodLevel& level : lods.Levels)
+        {
+            REQUIRE(level.indexOffset + level.indexCount <= lods.Indices.size());
+            const unsigned int* indices = lods.Indices.data() + level.indexOffset;
+            CheckTriangles(m, indices, level.indexCount);
+
+            const std::size_t triangles = level.indexCount / 3;
+            target *= settings.reduction;
+            CHECK(triangles <= target);
+            CHECK(triangles >= target * 0.95);
+            CHECK(triangles >= settings.minTriangles);
+            CHECK(triangles <= prevTriangles * settings.minProgress);
+
+            CHECK(level.error >= prevError);
+            CHECK(level.error <= settings.maxError);
+            CHECK(CountFlipped(m, indices, level.indexCount, orientation) <= baseFlipped);
+            prevTriangles = triangles;
+            prevError = level.error;
+        }
+    }
+}
+
+TEST_CASE(MeshSimplifier_FlatGridKeepsBorder)
+{
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    const MeshData* grid = Find(corpus, "grid");
+    REQUIRE(grid != nullptr);
+
+    MeshLods lods;
+    BuildMeshLods(*grid, MeshLodSettings(), lods);
+    REQUIRE(!lods.Levels.empty());
+    const MeshLodLevel& last = lods.Levels.back();
+    CHECK(last.error < 1e-4f);
+
+    // 外周（x = ±1, z = ±1）の頂点はすべて残る
+    float minX = 1e9f, maxX = -1e9f, minZ = 1e9f, maxZ = -1e9f;
+    for (std::uint32_t i = 0; i < last.indexCount; ++i)
+    {
+        const DirectX::XMFLOAT3& p = grid->Vertices[lods.Indices[last.indexOffset + i]].Position;
+        minX = std::fmin(minX, p.x); maxX = std::fmax(maxX, p.x);
+        minZ = std::fmin(minZ, p.z); maxZ = std::fmax(maxZ, p.z);
+    }
+    CHECK(minX == -1.0f && maxX == 1.0f);
+    CHECK(minZ == -1.0f && maxZ == 1.0f);
+}
+
+TEST_CASE(MeshSimplifier_BatchMatchesSingle)
+{
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    std::vector<const MeshData*> meshes;
+    for (const MeshCorpusEntry& e : corpus) meshes.push_back(&e.mesh);
+    meshes.push_back(nullptr);
+
+    std::vector<MeshLods> batch(meshes.size());
+    BuildMeshLods(meshes.data(), meshes.size(), MeshLodSettings(), batch.data());
+    for (std::size_t i = 0; i < corpus.size(); ++i)
+    {
+        MeshLods single;
+        BuildMeshLods(corpus[i].mesh, MeshLodSettings(), single);
+        CHECK(batch[i].Indices == single.Indices);
+        CHECK(batch[i].Levels.size() == single.Levels.size());
+    }
+    CHECK(batch.back().Levels.empty());
+}
+
+BENCHMARK(MeshSimplifier_Corpus)
+{
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    for (const MeshCorpusEntry& e : corpus)
+    {
+        MeshData m = e.mesh;
+        OptimizeMesh(m);
+        MeshLods lods;
+        const double ms = test::BestMilliseconds(3, [&] { BuildMeshLods(m, MeshLodSettings(), lods); });
+
+        std::printf("  %-9s LOD0 %6zu", e.name.c_str(), m.Indices.size() / 3);
+        for (const MeshLodLevel& level : lods.Levels) std::printf(" | %6u (err %.4f)", level.indexCount / 3, level.error);
+        std::printf("\n");
+        test::Report(("BuildMeshLods " + e.name).c_str(), ms);
+    }
+}
@@ -0,0 +1,194 @@
+﻿#include "TestFramework.h"
+#include "Assets/Meshlet.h"
+#include "Assets/MeshOptimizer.h"
+#include "Assets/MeshCorpus.h"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <vector>
+
+/*
+    Meshlet のテスト
+    ----------------------------------------------------------------------------
+      - 前提を満たさない入力は分けず、縮退三角形は捨てる
+      - コーパスの全メッシュで、
+          頂点数/三角形数は上限以内、ローカル番号は頂点表の中、
+          面積を持つ三角形はちょうど 1 回ずつ現れて巻き順も変わらない、
+          境界球は全頂点を含み、法線コーンは全面法線を含む
+      - 上限は 3～255 / 1～255 に丸める
+      - 複数メッシュ版（並列）は 1 つずつ作ったのと同じ結果になる
+    ベンチマークはコーパスごとの詰まり具合と時間を出す。
+*/
+
+namespace
+{
+    using Tri = std::array<std::uint32_t, 3>;
+
+    // 巻き順を保ったまま最小の番号が先頭に来るよう回す
+    Tri Canonical(std::uint32_t a, std::uint32_t b, std::uint32_t c)
+    {
+        if (a <= b && a <= c) return { a, b, c };
+        if (b <= a && b <= c) return { b, c, a };
+        return { c, a, b };
+    }
+
+    DirectX::XMFLOAT3 Sub(const DirectX::XMFLOAT3& a, const DirectX::XMFLOAT3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+    float Dot(const DirectX::XMFLOAT3& a, const DirectX::XMFLOAT3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    DirectX::XMFLOAT3 Cross(const DirectX::XMFLOAT3& a, const DirectX::XMFLOAT3& b)
+    {
+        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+    }
+
+    // d が mesh を正しく覆っているかを調べる（失敗は CHECK で報告）
+    void CheckMeshlets(const MeshData& mesh, const MeshletData& d, const MeshletLimits& limits)
+    {
+        REQUIRE(d.Bounds.size() == d.Meshlets.size());
+
+        std::map<Tri, int> want, got;
+        for (std::size_t i = 0; i + 2 < mesh.Indices.size(); i += 3)
+        {
+            const std::uint32_t a = mesh.Indices[i], b = mesh.Indices[i + 1], c = mesh.Indices[i + 2];
+            if (a != b && b != c && a != c) ++want[Canonical(a, b, c)];
+        }
+
+        std::size_t triangles = 0;
+        for (std::size_t i = 0; i < d.Meshlets.size(); ++i)
+        {
+            const Meshlet& m = d.Meshlets[i];
+            const MeshletBounds& b = d.Bounds[i];
+            CHECK(m.vertexCount >= 1 && m.vertexCount <= limits.maxVertices);
+            CHECK(m.triangleCount >= 1 && m.triangleCount <= limits.maxTriangles);
+            REQUIRE(m.vertexOffset + m.vertexCount <= d.Vertices.size());
+            REQUIRE(m.triangleOffset + m.triangleCount * 3 <= d.Triangles.size());
+            triangles += m.triangleCount;
+
+            for (std::uint32_t v = 0; v < m.vertexCount; ++v)
+            {
+                const DirectX::XMFLOAT3 q = Sub(mesh.Vertices[d.Vertices[m.vertexOffset + v]].Position, b.center);
+                CHECK(std::sqrt(Dot(q, q)) <= b.radius * 1.0001f + 1e-6f);
+            }
+
+            const float cosAngle = b.coneCutoff < 1.0f ? std::sqrt(1.0f - b.coneCutoff * b.coneCutoff) : -1.0f;
+            for (std::uint32_t t = 0; t < m.triangleCount; ++t)
+            {
+                std::uint32_t idx[3];
+                for (int k = 0; k < 3; ++k)
+                {
+                    const std::uint32_t local = d.Triangles[m.triangleOffset + t * 3 + k];
+                    REQUIRE(local < m.vertexCount);
+                    idx[k] = d.Vertices[m.vertexOffset + local];
+                }
+                ++got[Canonical(idx[0], idx[1], idx[2])];
+
+                const DirectX::XMFLOAT3& p0 = mesh.Vertices[idx[0]].Position;
+                const DirectX::XMFLOAT3 n = Cross(Sub(mesh.Vertices[idx[1]].Position, p0), Sub(mesh.Vertices[idx[2]].Position, p0));
+                const float len = std::sqrt(Dot(n, n));
+                if (b.coneCutoff < 1.0f && len > 0.0f) CHECK(Dot(n, b.coneAxis) / len >= cosAngle - 1e-4f);
+            }
+        }
+        CHECK(got == want);
+        CHECK(triangles * 3 == d.IndexCount);
+    }
+}
+
+TEST_CASE(Meshlet_InvalidAndDegenerateInput)
+{
+    MeshData m;
+    m.Vertices.resize(3);
+    m.Indices = { 0, 1, 7 };
+    MeshletData d;
+    CHECK(BuildMeshlets(m, MeshletLimits(), d) == 0);
+    CHECK(d.Meshlets.empty());
+
+    m.Indices = { 0, 1 };
+    CHECK(BuildMeshlets(m, MeshletLimits(), d) == 0);
+
+    m.Indices = { 0, 0, 1 }; // 面積を持たない三角形だけ
+    CHECK(BuildMeshlets(m, MeshletLimits(), d) == 0);
+    CHECK(d.IndexCount == 0);
+}
+
+TEST_CASE(Meshlet_CorpusCoversEveryTriangleOnce)
+{
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    for (const MeshCorpusEntry& e : corpus)
+    {
+        MeshData m = e.mesh;
+        OptimizeMesh(m);
+        MeshletData d;
+        const std::size_t n = BuildMeshlets(m, MeshletLimits(), d);
+        CHECK(n == d.Meshlets.size());
+        CHECK(n > 0);
+        CheckMeshlets(m, d, MeshletLimits());
+    }
+}
+
+TEST_CASE(Meshlet_LimitsAreClamped)
+{
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    const MeshData* found = nullptr;
+    for (const MeshCorpusEntry& e : corpus) if (e.name == "sphere") found = &e.mesh;
+    REQUIRE(found != nullptr);
+    const MeshData& sphere = *found;
+
+    // 上限 3 / 1：1 メッシュレット = 1 三角形
+    MeshletLimits tiny;
+    tiny.maxVertices = 1;
+    tiny.maxTriangles = 0;
+    MeshletData d;
+    CHECK(BuildMeshlets(sphere, tiny, d) == sphere.Indices.size() / 3);
+    MeshletLimits clamped;
+    clamped.maxVertices = 3;
+    clamped.maxTriangles = 1;
+    CheckMeshlets(sphere, d, clamped);
+
+    // 上限 255 / 255（8bit の範囲まで）
+    MeshletLimits huge;
+    huge.maxVertices = 1000;
+    huge.maxTriangles = 1000;
+    BuildMeshlets(sphere, huge, d);
+    clamped.maxVertices = 255;
+    clamped.maxTriangles = 255;
+    CheckMeshlets(sphere, d, clamped);
+}
+
+TEST_CASE(Meshlet_BatchMatchesSingle)
+{
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    std::vector<const MeshData*> meshes;
+    for (const MeshCorpusEntry& e : corpus) meshes.push_back(&e.mesh);
+    meshes.push_back(nullptr);
+
+    std::vector<MeshletData> batch(meshes.size());
+    BuildMeshlets(meshes.data(), meshes.size(), MeshletLimits(), batch.data());
+    for (std::size_t i = 0; i < corpus.size(); ++i)
+    {
+        MeshletData single;
+        BuildMeshlets(corpus[i].mesh, MeshletLimits(), single);
+        CHECK(batch[i].Vertices == single.Vertices);
+        CHECK(batch[i].Triangles == single.Triangles);
+        CHECK(batch[i].Meshlets.size() == single.Meshlets.size());
+    }
+    CHECK(batch.back().Meshlets.empty());
+}
+
+BENCHMARK(Meshlet_Corpus)
+{
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    std::vector<MeshletBenchmarkResult> results;
+    RunMeshletBenchmark(corpus, MeshletLimits(), results);
+
+    std::printf("  %-9s %8s %8s %7s %7s %6s\n", "mesh", "tris", "meshlets", "verts", "tris", "cone");
+    for (const MeshletBenchmarkResult& r : results)
+    {
+        std::printf("  %-9s %8zu %8zu %7.1f %7.1f %5.0f%%\n",
+            r.name.c_str(), r.triangles, r.meshlets, r.avgVertices, r.avgTriangles, r.coneFraction * 100.0f);
+        test::Report(("BuildMeshlets " + r.name).c_str(), r.milliseconds);
+    }
+}
@@ -0,0 +1,244 @@
+﻿#include "TestFramework.h"
+#include "Assets/StaticBatch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace DirectX;
+
+/*
+    StaticBatch のテスト/ベンチマーク
+    ----------------------------------------------------------------------------
+      - 焼き込み：位置は world、法線は逆転置で変換され、鏡映では巻き順が入れ替わる
+      - チャンク分け：pipeline とセルが違えば分かれ、頂点数の上限を守る
+      - 出力は入力順に依存しない
+      - 同じ出力へ作り直すと前回の結果は残らず、新しく作ったのと同じになる
+    ベンチマークは 100x100 個の立方体（2 pipeline）の結合。
+*/
+
+namespace
+{
+    /// 一辺 1 の立方体（角の頂点 8 個、法線は角方向）
+    MeshData MakeCube()
+    {
+        MeshData m;
+        const float p[8][3] = { {-1,-1,-1}, {1,-1,-1}, {1,1,-1}, {-1,1,-1}, {-1,-1,1}, {1,-1,1}, {1,1,1}, {-1,1,1} };
+        const float inv = 1.0f / std::sqrt(3.0f);
+        for (const auto& c : p)
+        {
+            Vertex v{};
+            v.Position = { c[0] * 0.5f, c[1] * 0.5f, c[2] * 0.5f };
+            v.Normal = { c[0] * inv, c[1] * inv, c[2] * inv };
+            v.Color = { 1, 1, 1, 1 };
+            m.Vertices.push_back(v);
+        }
+        const unsigned int ids[] = { 0,1,2, 0,2,3, 4,6,5, 4,7,6, 0,4,5, 0,5,1, 3,2,6, 3,6,7, 0,3,7, 0,7,4, 1,5,6, 1,6,2 };
+        m.Indices.assign(std::begin(ids), std::end(ids));
+        return m;
+    }
+
+    StaticBatchInput MakeInput(const MeshData& mesh, FXMMATRIX world, std::uint32_t pipeline = 0)
+    {
+        StaticBatchInput in;
+        in.mesh = &mesh;
+        XMStoreFloat4x4(&in.world, world);
+        in.pipeline = pipeline;
+        return in;
+    }
+
+    /// n x n の格子に並べた立方体（市松模様で pipeline 0/1）
+    std::vector<StaticBatchInput> MakeGrid(const MeshData& cube, int n)
+    {
+        std::vector<StaticBatchInput> inputs;
+        for (int z = 0; z < n; ++z)
+            for (int x = 0; x < n; ++x)
+                inputs.push_back(MakeInput(cube, XMMatrixRotationY(x * 0.1f) * XMMatrixTranslation(x * 2.0f, 0, z * 2.0f),
+                    static_cast<std::uint32_t>((x + z) & 1)));
+        return inputs;
+    }
+}
+
+TEST_CASE(StaticBatch_BakesMirroredTransform)
+{
+    const MeshData cube = MakeCube();
+    const StaticBatchInput in = MakeInput(cube, XMMatrixScaling(-2, 1, 3) * XMMatrixTranslation(10, 0, 0));
+    std::vector<StaticBatchChunk> out;
+    BuildStaticBatches(&in, 1, {}, out);
+    REQUIRE(out.size() == 1);
+    const StaticBatchChunk& chunk = out[0];
+    CHECK(chunk.sourceCount == 1);
+    REQUIRE(chunk.mesh.Vertices.size() == 8);
+    REQUIRE(chunk.mesh.Indices.size() == 36);
+
+    CHECK(chunk.mesh.Vertices[0].Position.x == 11.0f);
+    CHECK(chunk.mesh.Vertices[0].Position.z == -1.5f);
+
+    // 鏡映なので各三角形の 2 番目と 3 番目が入れ替わる
+    for (std::size_t t = 0; t < 36; t += 3)
+    {
+        CHECK(chunk.mesh.Indices[t] == cube.Indices[t]);
+        CHECK(chunk.mesh.Indices[t + 1] == cube.Indices[t + 2]);
+        CHECK(chunk.mesh.Indices[t + 2] == cube.Indices[t + 1]);
+    }
+
+    // 法線：逆転置 diag(-1/2, 1, 1/3) を (-1,-1,-1)/√3 に掛けて正規化
+    const XMFLOAT3 n = chunk.mesh.Vertices[0].Normal;
+    const float len = std::sqrt(0.25f + 1.0f + 1.0f / 9.0f);
+    CHECK(std::fabs(n.x - 0.5f / len) < 1e-5f);
+    CHECK(std::fabs(n.y + 1.0f / len) < 1e-5f);
+    CHECK(std::fabs(n.z + (1.0f / 3.0f) / len) < 1e-5f);
+
+    CHECK(chunk.bounds.Min.x == 9.0f);
+    CHECK(chunk.bounds.Max.x == 11.0f);
+    CHECK(chunk.bounds.Max.z == 1.5f);
+}
+
+TEST_CASE(StaticBatch_SplitsByPipelineAndCell)
+{
+    const MeshData cube = MakeCube();
+    const MeshData empty;
+    std::vector<StaticBatchInput> inputs;
+    inputs.push_back(MakeInput(cube, XMMatrixTranslation(1, 0, 1), 0));
+    inputs.push_back(MakeInput(cube, XMMatrixTranslation(3, 0, 1), 0));  // 同じセル・同じ pipeline → 結合
+    inputs.push_back(MakeInput(cube, XMMatrixTranslation(5, 0, 1), 1));  // pipeline 違い
+    inputs.push_back(MakeInput(cube, XMMatrixTranslation(40, 0, 1), 0)); // 隣のセル
+    inputs.push_back(MakeInput(empty, XMMatrixIdentity(), 0));           // 空は無視
+    StaticBatchInput none;
+    inputs.push_back(none);                                              // null も無視
+
+    StaticBatchSettings settings;
+    settings.chunkSize = 32.0f;
+    std::vector<StaticBatchChunk> out;
+    BuildStaticBatches(inputs.data(), inputs.size(), settings, out);
+    REQUIRE(out.size() == 3);
+
+    std::size_t sources = 0;
+    for (const StaticBatchChunk& c : out)
+    {
+        sources += c.sourceCount;
+        CHECK(c.mesh.Vertices.size() == 8 * c.sourceCount);
+        CHECK(c.mesh.Indices.size() == 36 * c.sourceCount);
+        for (const unsigned int i : c.mesh.Indices) CHECK(i < c.mesh.Vertices.size());
+        for (const Vertex& v : c.mesh.Vertices)
+        {
+            CHECK(v.Position.x >= c.bounds.Min.x && v.Position.x <= c.bounds.Max.x);
+            CHECK(v.Position.z >= c.bounds.Min.z && v.Position.z <= c.bounds.Max.z);
+        }
+    }
+    CHECK(sources == 4);
+
+    // chunkSize <= 0 なら空間では分けない（pipeline だけで分かれる）
+    settings.chunkSize = 0.0f;
+    BuildStaticBatches(inputs.data(), inputs.size(), settings, out);
+    CHECK(out.size() == 2);
+}
+
+TEST_CASE(StaticBatch_RespectsVertexLimit)
+{
+    const MeshData cube = MakeCube();
+    const std::vector<StaticBatchInput> inputs = MakeGrid(cube, 20);
+    StaticBatchSettings settings;
+    settings.chunkSize = 32.0f;
+    settings.maxVerticesPerChunk = 100; // 立方体 12 個まで
+    std::vector<StaticBatchChunk> out;
+    BuildStaticBatches(inputs.data(), inputs.size(), settings, out);
+
+    std::size_t sources = 0;
+    for (const StaticBatchChunk& c : out)
+    {
+        CHECK(c.mesh.Vertices.size() <= 100);
+        sources += c.sourceCount;
+    }
+    CHECK(sources == inputs.size());
+
+    // 単体で上限を超えるメッシュはそれだけで 1 チャンク
+    settings.maxVerticesPerChunk = 4;
+    BuildStaticBatches(inputs.data(), 3, settings, out);
+    CHECK(out.size() == 3);
+}
+
+TEST_CASE(StaticBatch_OutputIsIndependentOfInputOrder)
+{
+    const MeshData cube = MakeCube();
+    std::vector<StaticBatchInput> inputs = MakeGrid(cube, 10);
+    StaticBatchSettings settings;
+    settings.chunkSize = 8.0f;
+    std::vector<StaticBatchChunk> a, b;
+    BuildStaticBatches(inputs.data(), inputs.size(), settings, a);
+
+    // 逆順に入れてもチャンクの並びと中身の範囲は変わらない（チャンク内の頂点順だけが変わる）
+    std::reverse(inputs.begin(), inputs.end());
+    BuildStaticBatches(inputs.data(), inputs.size(), settings, b);
+
+    REQUIRE(a.size() == b.size());
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        CHECK(a[i].pipeline == b[i].pipeline);
+        CHECK(a[i].sourceCount == b[i].sourceCount);
+        CHECK(a[i].mesh.Vertices.size() == b[i].mesh.Vertices.size());
+        CHECK(a[i].bounds.Min.x == b[i].bounds.Min.x && a[i].bounds.Max.z == b[i].bounds.Max.z);
+    }
+}
+
+TEST_CASE(StaticBatch_RebuildReplacesPreviousOutput)
+{
+    const MeshData cube = MakeCube();
+    std::vector<StaticBatchInput> inputs = MakeGrid(cube, 10);
+    StaticBatchSettings settings;
+    settings.chunkSize = 8.0f;
+    std::vector<StaticBatchChunk> out;
+    BuildStaticBatches(inputs.data(), inputs.size(), settings, out);
+    const std::size_t first = out.size();
+    REQUIRE(first > 1);
+
+    // 同じ入力でもう一度：結合は 1 重のまま
+    BuildStaticBatches(inputs.data(), inputs.size(), settings, out);
+    CHECK(out.size() == first);
+
+    // 半分を動かし、残りを減らしてから作り直す → 新しく作ったものと一致する
+    for (std::size_t i = 0; i < inputs.size(); i += 2) inputs[i].world._41 += 100.0f;
+    inputs.resize(inputs.size() - 7);
+    BuildStaticBatches(inputs.data(), inputs.size(), settings, out);
+    std::vector<StaticBatchChunk> fresh;
+    BuildStaticBatches(inputs.data(), inputs.size(), settings, fresh);
+
+    REQUIRE(out.size() == fresh.size());
+    std::size_t sources = 0;
+    for (std::size_t i = 0; i < out.size(); ++i)
+    {
+        CHECK(out[i].pipeline == fresh[i].pipeline);
+        CHECK(out[i].sourceCount == fresh[i].sourceCount);
+        CHECK(out[i].mesh.Indices == fresh[i].mesh.Indices);
+        REQUIRE(out[i].mesh.Vertices.size() == fresh[i].mesh.Vertices.size());
+        for (std::size_t v = 0; v < out[i].mesh.Vertices.size(); ++v)
+            CHECK(out[i].mesh.Vertices[v].Position.x == fresh[i].mesh.Vertices[v].Position.x);
+        CHECK(out[i].bounds.Min.x == fresh[i].bounds.Min.x && out[i].bounds.Max.x == fresh[i].bounds.Max.x);
+        sources += out[i].sourceCount;
+    }
+    CHECK(sources == inputs.size());
+
+    // 入力なしで作り直すと空になる
+    BuildStaticBatches(inputs.data(), 0, settings, out);
+    CHECK(out.empty());
+}
+
+BENCHMARK(StaticBatch_Build10k)
+{
+    const MeshData cube = MakeCube();
+    const std::vector<StaticBatchInput> inputs = MakeGrid(cube, 100);
+    StaticBatchSettings settings;
+    settings.chunkSize = 32.0f;
+    settings.maxVerticesPerChunk = 1024;
+    std::vector<StaticBatchChunk> out;
+    test::Report("build (10k cubes)", test::BestMilliseconds(5, [&] { BuildStaticBatches(inputs.data(), inputs.size(), settings, out); }));
+
+    std::size_t vertices = 0, triangles = 0;
+    for (const StaticBatchChunk& c : out)
+    {
+        vertices += c.mesh.Vertices.size();
+        triangles += c.mesh.Indices.size() / 3;
+    }
+    std::printf("  draws %zu -> %zu chunks, vertices=%zu triangles=%zu\n", inputs.size(), out.size(), vertices, triangles);
+    CHECK(vertices == 8 * inputs.size());
+}
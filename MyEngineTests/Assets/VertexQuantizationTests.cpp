@@ -0,0 +1,256 @@
+﻿#include "TestFramework.h"
+#include "Assets/VertexQuantization.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+/*
+    VertexQuantization のテスト
+    ----------------------------------------------------------------------------
+    ヘッダに書いた誤差の上限を確かめる。
+      - half    : 全 65536 値が往復で変わらない。正規化数の範囲は最近接偶数丸めで相対誤差 2^-11 以下
+      - 八面体  : 単位法線の角度誤差 0.005° 以下、長さ 0 は (0, 0, 1)
+      - UNORM8  : 絶対誤差 0.5/255 以下、範囲外は飽和、NaN は 0
+    一括版（SSE2）は端数を含む件数・詰めていないストライドで、スカラ版とビット単位で一致すること。
+*/
+
+namespace
+{
+    std::uint32_t Bits(float f)
+    {
+        std::uint32_t u;
+        std::memcpy(&u, &f, sizeof(u));
+        return u;
+    }
+
+    bool SameFloat(float a, float b) { return Bits(a) == Bits(b) || (std::isnan(a) && std::isnan(b)); }
+
+    /// c の前後の half から f に最も近いもの（同点なら偶数）を総当たりで選ぶ
+    std::uint16_t NearestHalf(float f, std::uint16_t c)
+    {
+        double best = 1e300;
+        std::uint16_t bestHalf = 0;
+        for (int d = -2; d <= 2; ++d)
+        {
+            const int mag = static_cast<int>(c & 0x7FFF) + d;
+            if (mag < 0 || mag > 0x7C00) continue;
+            const std::uint16_t cand = static_cast<std::uint16_t>(mag | (c & 0x8000));
+            const double e = std::fabs(static_cast<double>(HalfToFloat(cand)) - f);
+            if (e < best || (e == best && !(cand & 1))) { best = e; bestHalf = cand; }
+        }
+        return bestHalf;
+    }
+
+    std::vector<XMFLOAT3> RandomUnitNormals(std::size_t n, std::mt19937& rng)
+    {
+        std::normal_distribution<float> nd;
+        std::vector<XMFLOAT3> ns;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const float x = nd(rng), y = nd(rng), z = nd(rng);
+            const float len = std::sqrt(x * x + y * y + z * z);
+            ns.push_back({ x / len, y / len, z / len });
+        }
+        // 八面体の折り返しの境目（軸方向と z の符号 0）
+        for (const XMFLOAT3& n : { XMFLOAT3{ 0, 0, 1 }, XMFLOAT3{ 0, 0, -1 }, XMFLOAT3{ 1, 0, 0 }, XMFLOAT3{ -1, 0, 0 },
+                 XMFLOAT3{ 0, -1, 0 }, XMFLOAT3{ -0.0f, 0, -1 } })
+            ns.push_back(n);
+        return ns;
+    }
+}
+
+TEST_CASE(VertexQuantization_HalfRoundTripsEveryHalf)
+{
+    for (std::uint32_t h = 0; h < 65536; ++h)
+    {
+        const float f = HalfToFloat(static_cast<std::uint16_t>(h));
+        const std::uint16_t r = FloatToHalf(f);
+        const bool nan = (h & 0x7C00) == 0x7C00 && (h & 0x3FF);
+        if (nan) CHECK(std::isnan(f) && (r & 0x7C00) == 0x7C00 && (r & 0x3FF));
+        else     CHECK(r == h);
+    }
+}
+
+TEST_CASE(VertexQuantization_HalfErrorBound)
+{
+    std::mt19937 rng(7);
+    std::vector<float> values;
+    for (int i = 0; i < 50000; ++i)
+    {
+        const std::uint32_t u = rng();
+        float f;
+        std::memcpy(&f, &u, sizeof(f));
+        if (!std::isnan(f)) values.push_back(f);
+    }
+    std::uniform_real_distribution<float> wide(-70000.0f, 70000.0f), tiny(-1e-4f, 1e-4f);
+    for (int i = 0; i < 50000; ++i) values.push_back(wide(rng));
+    for (int i = 0; i < 50000; ++i) values.push_back(tiny(rng));
+
+    int relChecked = 0;
+    for (const float f : values)
+    {
+        const std::uint16_t h = FloatToHalf(f);
+        const float a = std::fabs(f);
+        if (a >= 65520.0f)
+        {
+            CHECK((h & 0x7FFF) == 0x7C00); // Inf
+            continue;
+        }
+        CHECK(h == NearestHalf(f, h));
+        if (a >= 6.103515625e-05f) // 2^-14 以上（正規化数）
+        {
+            CHECK(std::fabs(static_cast<double>(HalfToFloat(h)) - f) <= a * std::ldexp(1.0, -11));
+            ++relChecked;
+        }
+    }
+    CHECK(relChecked > 50000);
+
+    CHECK(FloatToHalf(65504.0f) == 0x7BFF);
+    CHECK(FloatToHalf(65520.0f) == 0x7C00);
+    CHECK(FloatToHalf(-0.0f) == 0x8000);
+    CHECK(FloatToHalf(std::numeric_limits<float>::infinity()) == 0x7C00);
+    CHECK((FloatToHalf(std::numeric_limits<float>::quiet_NaN()) & 0x7FFF) == 0x7E00);
+}
+
+TEST_CASE(VertexQuantization_HalfBatchMatchesScalar)
+{
+    struct Padded { float x, y, z, pad; };
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> u(-2000.0f, 2000.0f);
+    const std::size_t n = 1003; // 4 の倍数でない端数も通す
+    std::vector<Padded> src(n);
+    for (Padded& p : src) p = { u(rng), u(rng) * 1e-3f, u(rng) * 1e-6f, 0.0f };
+    src[0] = { std::numeric_limits<float>::infinity(), -0.0f, 1e9f, 0.0f };
+
+    std::vector<std::uint16_t> half(n * 4);
+    EncodeHalf3(src.data(), sizeof(Padded), half.data(), 8, n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        CHECK(half[i * 4 + 0] == FloatToHalf(src[i].x));
+        CHECK(half[i * 4 + 1] == FloatToHalf(src[i].y));
+        CHECK(half[i * 4 + 2] == FloatToHalf(src[i].z));
+        CHECK(half[i * 4 + 3] == 0x3C00); // w = 1
+    }
+
+    std::vector<Padded> back(n);
+    DecodeHalf3(half.data(), 8, back.data(), sizeof(Padded), n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        CHECK(SameFloat(back[i].x, HalfToFloat(half[i * 4 + 0])));
+        CHECK(SameFloat(back[i].y, HalfToFloat(half[i * 4 + 1])));
+        CHECK(SameFloat(back[i].z, HalfToFloat(half[i * 4 + 2])));
+    }
+}
+
+TEST_CASE(VertexQuantization_OctahedralAngleErrorBound)
+{
+    std::mt19937 rng(7);
+    const std::vector<XMFLOAT3> normals = RandomUnitNormals(50000, rng);
+    double maxDegrees = 0.0;
+    for (const XMFLOAT3& n : normals)
+    {
+        std::int16_t e[2];
+        EncodeOctahedral(n, e);
+        const XMFLOAT3 d = DecodeOctahedral(e);
+        const double len = std::sqrt(static_cast<double>(d.x) * d.x + static_cast<double>(d.y) * d.y + static_cast<double>(d.z) * d.z);
+        CHECK(std::fabs(len - 1.0) < 1e-6);
+
+        const double dot = static_cast<double>(n.x) * d.x + static_cast<double>(n.y) * d.y + static_cast<double>(n.z) * d.z;
+        const double cx = static_cast<double>(n.y) * d.z - static_cast<double>(n.z) * d.y;
+        const double cy = static_cast<double>(n.z) * d.x - static_cast<double>(n.x) * d.z;
+        const double cz = static_cast<double>(n.x) * d.y - static_cast<double>(n.y) * d.x;
+        const double degrees = std::atan2(std::sqrt(cx * cx + cy * cy + cz * cz), dot) * 180.0 / 3.14159265358979323846;
+        maxDegrees = (std::max)(maxDegrees, degrees);
+    }
+    std::printf("  max angle error %.6f deg\n", maxDegrees);
+    CHECK(maxDegrees < 0.005);
+
+    std::int16_t e[2];
+    EncodeOctahedral(XMFLOAT3{ 0, 0, 0 }, e); // 長さ 0 は (0, 0, 1)
+    const XMFLOAT3 z = DecodeOctahedral(e);
+    CHECK(z.x == 0.0f && z.y == 0.0f && z.z == 1.0f);
+}
+
+TEST_CASE(VertexQuantization_OctahedralBatchMatchesScalar)
+{
+    std::mt19937 rng(11);
+    const std::vector<XMFLOAT3> normals = RandomUnitNormals(10001, rng);
+    std::vector<std::uint32_t> packed(normals.size());
+    EncodeOctahedralSnorm16(normals.data(), sizeof(XMFLOAT3), packed.data(), 4, normals.size());
+    for (std::size_t i = 0; i < normals.size(); ++i)
+    {
+        std::int16_t e[2];
+        EncodeOctahedral(normals[i], e);
+        CHECK(packed[i] == (static_cast<std::uint16_t>(e[0]) | static_cast<std::uint32_t>(static_cast<std::uint16_t>(e[1])) << 16));
+    }
+
+    // 任意の SNORM16 の組（-32768 を含む）を戻しても一致する
+    std::vector<std::uint32_t> raw(10003);
+    for (std::uint32_t& w : raw) w = rng();
+    raw[0] = 0x80008000u;
+    raw[1] = 0x7FFF7FFFu;
+    std::vector<XMFLOAT3> decoded(raw.size());
+    DecodeOctahedralSnorm16(raw.data(), 4, decoded.data(), sizeof(XMFLOAT3), raw.size());
+    for (std::size_t i = 0; i < raw.size(); ++i)
+    {
+        const std::int16_t e[2] = { static_cast<std::int16_t>(raw[i] & 0xFFFF), static_cast<std::int16_t>(raw[i] >> 16) };
+        const XMFLOAT3 r = DecodeOctahedral(e);
+        CHECK(Bits(r.x) == Bits(decoded[i].x) && Bits(r.y) == Bits(decoded[i].y) && Bits(r.z) == Bits(decoded[i].z));
+    }
+}
+
+TEST_CASE(VertexQuantization_Unorm8ErrorBound)
+{
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> u(-0.2f, 1.2f);
+    std::vector<XMFLOAT4> colors(10001);
+    for (XMFLOAT4& c : colors) c = { u(rng), u(rng), u(rng), u(rng) };
+    colors[0] = { std::numeric_limits<float>::quiet_NaN(), -std::numeric_limits<float>::infinity(),
+                  std::numeric_limits<float>::infinity(), 0.5f };
+
+    std::vector<std::uint32_t> packed(colors.size());
+    EncodeUnorm8x4(colors.data(), sizeof(XMFLOAT4), packed.data(), 4, colors.size());
+    CHECK(packed[0] == (0u | 0u << 8 | 255u << 16 | 128u << 24)); // NaN → 0、±Inf は飽和、R が最下位
+
+    std::vector<XMFLOAT4> decoded(colors.size());
+    DecodeUnorm8x4(packed.data(), 4, decoded.data(), sizeof(XMFLOAT4), colors.size());
+    for (std::size_t i = 0; i < colors.size(); ++i)
+    {
+        CHECK(packed[i] == PackUnorm8x4(colors[i]));
+        const XMFLOAT4 r = UnpackUnorm8x4(packed[i]);
+        CHECK(Bits(r.x) == Bits(decoded[i].x) && Bits(r.y) == Bits(decoded[i].y) &&
+              Bits(r.z) == Bits(decoded[i].z) && Bits(r.w) == Bits(decoded[i].w));
+
+        const float in[4] = { colors[i].x, colors[i].y, colors[i].z, colors[i].w };
+        const float out[4] = { r.x, r.y, r.z, r.w };
+        for (int k = 0; k < 4; ++k)
+        {
+            const float clamped = std::isnan(in[k]) ? 0.0f : (std::min)((std::max)(in[k], 0.0f), 1.0f);
+            CHECK(std::fabs(clamped - out[k]) <= 0.5f / 255.0f + 1e-6f);
+        }
+    }
+}
+
+TEST_CASE(VertexQuantization_CopyFloat3)
+{
+    struct Padded { float x, y, z, pad; };
+    std::vector<Padded> src(1003);
+    for (std::size_t i = 0; i < src.size(); ++i)
+        src[i] = { static_cast<float>(i), -static_cast<float>(i) * 0.5f, 1.0f / (1.0f + i), 99.0f };
+
+    std::vector<XMFLOAT3> packed(src.size()); // dstStride == 12（SSE で詰める経路）
+    CopyFloat3(src.data(), sizeof(Padded), packed.data(), sizeof(XMFLOAT3), src.size());
+    std::vector<Padded> strided(src.size());  // 詰めていない経路
+    CopyFloat3(src.data(), sizeof(Padded), strided.data(), sizeof(Padded), src.size());
+    for (std::size_t i = 0; i < src.size(); ++i)
+    {
+        CHECK(packed[i].x == src[i].x && packed[i].y == src[i].y && packed[i].z == src[i].z);
+        CHECK(strided[i].x == src[i].x && strided[i].y == src[i].y && strided[i].z == src[i].z);
+    }
+}
@@ -0,0 +1,149 @@
+﻿#include "TestFramework.h"
+#include "Fakes/FakeD3D12.h"
+#include "Core/CommandListPool.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+/*
+    CommandListPool のテスト
+    ----------------------------------------------------------------------------
+    記録だけするモックの Backend（fake::CommandLists）で、
+      - 組のアロケータは退役時の Signal 値に GPU が届いてから Reset され、再利用される
+      - Close は Acquire した順に並べる
+      - 作成/Open/Reset の失敗で組を数え直し、壊れた組は再利用しない
+    を確かめる。
+*/
+
+TEST_CASE(CommandListPool_ResetsOnlyAfterFence)
+{
+    fake::CommandLists lists;
+    CommandListPool pool;
+    pool.Initialize(lists.Backend());
+    std::vector<ID3D12CommandList*> out;
+
+    // フレーム 1：3 本
+    pool.BeginFrame(0);
+    for (int i = 0; i < 3; ++i) pool.Acquire();
+    CHECK(lists.created == 3);
+    CHECK(pool.Stats().listsThisFrame == 3);
+    pool.Close(out);
+    CHECK(out.size() == 3);
+    CHECK((lists.closed == std::vector<std::uint32_t>{ 0, 1, 2 }));
+    pool.EndFrame(1);
+    CHECK(pool.Stats().listsLastFrame == 3);
+    CHECK(pool.Stats().listsThisFrame == 0);
+
+    // フレーム 2：GPU はまだ 1 に届いていない → Reset せずに新しく作る
+    pool.BeginFrame(0);
+    CHECK(lists.reset.empty());
+    pool.Acquire();
+    CHECK(lists.created == 4);
+    pool.Close(out);
+    pool.EndFrame(2);
+
+    // フレーム 3：1 に到達 → フレーム 1 の 3 組だけ Reset されて空きに戻る
+    pool.BeginFrame(1);
+    CHECK((lists.reset == std::vector<std::uint32_t>{ 0, 1, 2 }));
+    CHECK(pool.Stats().freeEntries == 3);
+    for (int i = 0; i < 4; ++i) pool.Acquire();
+    CHECK(lists.created == 5);
+    CHECK(pool.Stats().entries == 5);
+    pool.Close(out);
+    pool.EndFrame(3);
+
+    pool.BeginFrame(3);
+    CHECK(lists.reset.size() == 3 + 1 + 4);
+    CHECK(pool.Stats().freeEntries == 5);
+
+    pool.Destroy();
+    CHECK(pool.Stats().entries == 0);
+}
+
+TEST_CASE(CommandListPool_CloseKeepsAcquireOrder)
+{
+    fake::CommandLists lists;
+    CommandListPool pool;
+    pool.Initialize(lists.Backend());
+    std::vector<ID3D12CommandList*> out;
+
+    pool.BeginFrame(0);
+    for (int i = 0; i < 4; ++i) pool.Acquire();
+    pool.Close(out);
+    pool.EndFrame(1);
+
+    // 空きから取り出す順は問わないが、Close は取り出した順（= open の順）に並ぶ
+    pool.BeginFrame(1);
+    lists.opened.clear();
+    lists.closed.clear();
+    for (int i = 0; i < 4; ++i) pool.Acquire();
+    pool.Close(out);
+    CHECK(lists.closed == lists.opened);
+    std::vector<std::uint32_t> ids = lists.closed;
+    std::sort(ids.begin(), ids.end());
+    CHECK((ids == std::vector<std::uint32_t>{ 0, 1, 2, 3 }));
+    pool.EndFrame(2);
+}
+
+TEST_CASE(CommandListPool_FailuresDropEntries)
+{
+    fake::CommandLists lists;
+    CommandListPool pool;
+    pool.Initialize(lists.Backend());
+    std::vector<ID3D12CommandList*> out;
+
+    pool.BeginFrame(0);
+    lists.failCreate = true;
+    CHECK(pool.Acquire() == nullptr);
+    CHECK(pool.Stats().entries == 0);
+    CHECK(pool.Stats().listsThisFrame == 0);
+    CHECK(pool.Current() == nullptr);
+
+    lists.failCreate = false;
+    lists.failOpen = true; // 作れても開けない組は捨てる
+    CHECK(pool.Acquire() == nullptr);
+    CHECK(pool.Stats().entries == 0);
+    CHECK(pool.Stats().listsThisFrame == 0);
+
+    lists.failOpen = false;
+    pool.Acquire();
+    pool.Acquire();
+    CHECK(pool.Stats().entries == 2);
+    pool.Close(out);
+    pool.EndFrame(1);
+
+    // Reset に失敗した組は空きに戻さない
+    lists.failReset = true;
+    pool.BeginFrame(1);
+    CHECK(pool.Stats().entries == 0);
+    CHECK(pool.Stats().freeEntries == 0);
+    lists.failReset = false;
+
+    pool.Acquire();
+    CHECK(lists.created == 4); // 開けなかった 1 組 + 2 組 + 作り直した 1 組
+    CHECK(pool.Stats().entries == 1);
+}
+
+TEST_CASE(CommandListPool_ConcurrentAcquire)
+{
+    fake::CommandLists lists;
+    CommandListPool pool;
+    pool.Initialize(lists.Backend());
+    std::vector<ID3D12CommandList*> out;
+
+    // ビューごとのスレッドがチャンク用のリストを同時に取る
+    pool.BeginFrame(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&] { for (int i = 0; i < 50; ++i) pool.Acquire(); });
+    for (std::thread& t : threads) t.join();
+
+    CHECK(pool.Stats().listsThisFrame == 200);
+    CHECK(pool.Stats().entries == 200);
+    pool.Close(out);
+    CHECK(out.size() == 200);
+    std::vector<std::uint32_t> ids = lists.closed;
+    std::sort(ids.begin(), ids.end());
+    CHECK(std::adjacent_find(ids.begin(), ids.end()) == ids.end()); // 同じ組を 2 度払い出していない
+    pool.EndFrame(1);
+}
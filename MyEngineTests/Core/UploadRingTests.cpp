@@ -0,0 +1,183 @@
+﻿#include "TestFramework.h"
+#include "Fakes/FakeD3D12.h"
+#include "Core/UploadRing.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+    UploadRing のテスト
+    ----------------------------------------------------------------------------
+    フェイクのページ（CPU メモリ）とフェイクのフェンスで、
+      - ページは退役時の Signal 値に GPU が届くまで再利用されない
+      - 使用量に合わせて伸び、届いたら作り直さずに使い回す
+      - ページより大きい要求は専用ページになり、退役後に解放される
+    を確かめる。
+*/
+
+TEST_CASE(UploadRing_ReusesPagesOnlyAfterFence)
+{
+    fake::UploadPages pages;
+    fake::Fence fence;
+    UploadRing ring;
+    ring.Initialize(pages.Factory(), 4096);
+
+    // フレーム 1：256B 境界の CB × 40 = 10240B → 4KB ページ 3 枚
+    ring.BeginFrame(fence.completed);
+    for (int i = 0; i < 40; ++i)
+    {
+        const UploadAllocation a = ring.Allocate(80, 256);
+        REQUIRE(a.cpu);
+        CHECK(a.gpu % 256 == 0);
+        CHECK(a.size == 80);
+    }
+    CHECK(ring.Stats().pages == 3);
+    CHECK(ring.Stats().pagesCreated == 3);
+    const std::uint64_t frame1 = fence.Signal();
+    ring.EndFrame(frame1);
+    CHECK(ring.Stats().bytesLastFrame > 0);
+
+    // フレーム 2：GPU はまだフレーム 1 を終えていない → 新しいページを作る
+    ring.BeginFrame(fence.completed);
+    CHECK(ring.Stats().freePages == 0);
+    for (int i = 0; i < 16; ++i) ring.Allocate(256, 256);
+    CHECK(ring.Stats().pagesCreated == 4);
+    const std::uint64_t frame2 = fence.Signal();
+    ring.EndFrame(frame2);
+
+    // GPU がフレーム 1 に到達 → 3 枚が空きに戻り、同じ量なら作らずに済む
+    fence.Complete(frame1);
+    ring.BeginFrame(fence.completed);
+    CHECK(ring.Stats().freePages == 3);
+    for (int i = 0; i < 40; ++i) ring.Allocate(80, 256);
+    CHECK(ring.Stats().pagesCreated == 4);
+    CHECK(pages.created == 4);
+    ring.EndFrame(fence.Signal());
+
+    // 古い値で BeginFrame しても何も戻らない
+    const std::uint32_t freeBefore = ring.Stats().freePages;
+    ring.BeginFrame(0);
+    CHECK(ring.Stats().freePages == freeBefore);
+}
+
+TEST_CASE(UploadRing_DedicatedPageForOversizedRequest)
+{
+    fake::UploadPages pages;
+    fake::Fence fence;
+    UploadRing ring;
+    ring.Initialize(pages.Factory(), 4096);
+
+    ring.BeginFrame(fence.completed);
+    ring.Allocate(64, 256);
+    const UploadAllocation big = ring.Allocate(10000, 256);
+    REQUIRE(big.cpu);
+    CHECK(big.size == 10000);
+    CHECK(big.offset == 0); // 専用ページの先頭
+    CHECK(ring.Stats().pages == 2);
+    std::memset(big.cpu, 0xAB, 10000); // 全域が書ける
+
+    const std::uint64_t f = fence.Signal();
+    ring.EndFrame(f);
+    fence.Complete(f);
+    ring.BeginFrame(fence.completed);
+    CHECK(ring.Stats().pages == 1);     // 専用ページは解放
+    CHECK(ring.Stats().freePages == 1); // 通常ページだけが空きに戻る
+}
+
+TEST_CASE(UploadRing_AllocationsAreAlignedAndDisjoint)
+{
+    fake::UploadPages pages;
+    UploadRing ring;
+    ring.Initialize(pages.Factory(), 4096);
+    ring.BeginFrame(0);
+
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> ranges;
+    const std::uint64_t aligns[] = { 1, 4, 16, 256 };
+    for (int i = 0; i < 500; ++i)
+    {
+        const std::uint64_t bytes = 1 + (i * 37) % 700;
+        const std::uint64_t align = aligns[i % 4];
+        const UploadAllocation a = ring.Allocate(bytes, align);
+        REQUIRE(a.cpu);
+        CHECK(a.gpu % align == 0);
+        CHECK(a.offset + bytes <= ring.PageSize());
+        ranges.push_back({ a.gpu, bytes });
+    }
+    std::sort(ranges.begin(), ranges.end());
+    for (std::size_t i = 1; i < ranges.size(); ++i)
+        CHECK(ranges[i - 1].first + ranges[i - 1].second <= ranges[i].first);
+}
+
+TEST_CASE(UploadRing_FailedFactoryReturnsEmptyAllocation)
+{
+    fake::UploadPages pages;
+    pages.fail = true;
+    UploadRing ring;
+    ring.Initialize(pages.Factory(), 4096);
+    ring.BeginFrame(0);
+    CHECK(ring.Allocate(16, 16).cpu == nullptr);
+    CHECK(ring.Stats().pages == 0);
+
+    pages.fail = false; // 次の要求では作り直せる
+    CHECK(ring.Allocate(16, 16).cpu != nullptr);
+}
+
+TEST_CASE(UploadRing_DeferReleaseWaitsForFence)
+{
+    fake::UploadPages pages;
+    fake::Fence fence;
+    UploadRing ring;
+    ring.Initialize(pages.Factory(), 4096);
+
+    fake::Resource old(1024);
+    ring.BeginFrame(fence.completed);
+    ring.Allocate(64, 256);
+    ring.DeferRelease(Microsoft::WRL::ComPtr<ID3D12Resource>(&old));
+    CHECK(old.RefCount() == 2);
+    const std::uint64_t f = fence.Signal();
+    ring.EndFrame(f);
+
+    ring.BeginFrame(fence.completed);
+    CHECK(old.RefCount() == 2); // GPU が届くまでは持っている
+    ring.EndFrame(fence.Signal());
+
+    fence.Complete(f);
+    ring.BeginFrame(fence.completed);
+    CHECK(old.RefCount() == 1);
+}
+
+TEST_CASE(UploadRing_ConcurrentAllocate)
+{
+    fake::UploadPages pages;
+    UploadRing ring;
+    ring.Initialize(pages.Factory(), 4096);
+    ring.BeginFrame(0);
+
+    // 2 スレッドから同時に切り出しても範囲が重ならない（Scene/Game の並列記録）
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> got[2];
+    auto worker = [&](int t)
+        {
+            for (int i = 0; i < 2000; ++i)
+            {
+                const bool cb = i % 3 == 0;
+                const std::uint64_t bytes = cb ? 240 : 16 + (i % 7) * 8;
+                const UploadAllocation a = ring.Allocate(bytes, cb ? 256 : 16);
+                if (!a.cpu) continue;
+                std::memset(a.cpu, t + 1, static_cast<std::size_t>(bytes));
+                got[t].push_back({ a.gpu, bytes });
+            }
+        };
+    std::thread a(worker, 0), b(worker, 1);
+    a.join();
+    b.join();
+
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> all(got[0]);
+    all.insert(all.end(), got[1].begin(), got[1].end());
+    CHECK(all.size() == 4000);
+    std::sort(all.begin(), all.end());
+    for (std::size_t i = 1; i < all.size(); ++i)
+        CHECK(all[i - 1].first + all[i - 1].second <= all[i].first);
+    ring.EndFrame(1);
+}
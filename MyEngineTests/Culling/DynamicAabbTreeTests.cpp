@@ -0,0 +1,253 @@
+﻿#include "TestFramework.h"
+#include "Culling/DynamicAabbTree.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+/*
+    DynamicAabbTree のテスト/ベンチマーク
+    ----------------------------------------------------------------------------
+      - 作成/移動/削除を乱数で混ぜても、視錐台/重なりクエリが線形走査（生きているプロキシの
+        ファット AABB を 1 つずつ判定）と同じ答えを返し、元の AABB と重なるものは必ず含む
+      - ファット AABB は常に元の AABB を含み、余白の中の小さな移動では組み替えない
+      - 削除した ID は再利用され、userData の読み書き・Clear・高さ（平衡）が期待どおり
+    ベンチマークは 2 万プロキシを毎フレーム少しずつ動かす更新と視錐台クエリの速さ。
+*/
+
+namespace
+{
+    AABB Box(const XMFLOAT3& c, float s)
+    {
+        AABB b;
+        b.Min = { c.x - s, c.y - s, c.z - s };
+        b.Max = { c.x + s, c.y + s, c.z + s };
+        return b;
+    }
+
+    bool Overlaps(const AABB& a, const AABB& b)
+    {
+        return a.Min.x <= b.Max.x && b.Min.x <= a.Max.x && a.Min.y <= b.Max.y && b.Min.y <= a.Max.y &&
+               a.Min.z <= b.Max.z && b.Min.z <= a.Max.z;
+    }
+
+    bool Contains(const AABB& outer, const AABB& inner)
+    {
+        return outer.Min.x <= inner.Min.x && outer.Min.y <= inner.Min.y && outer.Min.z <= inner.Min.z &&
+               outer.Max.x >= inner.Max.x && outer.Max.y >= inner.Max.y && outer.Max.z >= inner.Max.z;
+    }
+
+    Frustum MakeFrustum(const XMFLOAT3& eye, const XMFLOAT3& dir, float farZ)
+    {
+        const XMMATRIX view = XMMatrixLookToLH(XMLoadFloat3(&eye), XMLoadFloat3(&dir), XMVectorSet(0, 1, 0, 0));
+        return Frustum::FromViewProj(view * XMMatrixPerspectiveFovLH(0.8f, 1.5f, 0.1f, farZ));
+    }
+
+    /// 線形走査の相手（userData = 添字）
+    struct Model
+    {
+        std::vector<AABB>         boxes;
+        std::vector<std::int32_t> proxies; // 削除済みは kNull
+    };
+
+    std::vector<std::uint32_t> Sorted(std::vector<std::uint32_t> v)
+    {
+        std::sort(v.begin(), v.end());
+        return v;
+    }
+}
+
+TEST_CASE(DynamicAabbTree_RandomOperationsMatchLinearScan)
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> pos(-100.0f, 100.0f), size(0.1f, 2.0f), speed(-0.1f, 0.1f);
+    DynamicAabbTree tree;
+    Model model;
+    const std::uint32_t n = 3000;
+    std::vector<XMFLOAT3> velocity(n);
+    for (std::uint32_t i = 0; i < n; ++i)
+    {
+        model.boxes.push_back(Box({ pos(rng), pos(rng), pos(rng) }, size(rng)));
+        model.proxies.push_back(tree.CreateProxy(model.boxes[i], i));
+        velocity[i] = { speed(rng), speed(rng), speed(rng) };
+    }
+
+    std::size_t moved = 0, reinserted = 0;
+    bool fatContains = true, overlapExact = true, overlapCovers = true, frustumExact = true, frustumCovers = true;
+    for (int frame = 0; frame < 60; ++frame)
+    {
+        // 一定の速度で動かす（たまに向きを変える / 大きく飛ばす）
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            if (model.proxies[i] == DynamicAabbTree::kNull) continue;
+            if (rng() % 20 == 0) velocity[i] = { speed(rng), speed(rng), speed(rng) };
+            const XMFLOAT3 d = rng() % 200 == 0 ? XMFLOAT3{ pos(rng), pos(rng), pos(rng) } : velocity[i];
+            AABB& b = model.boxes[i];
+            b.Min = { b.Min.x + d.x, b.Min.y + d.y, b.Min.z + d.z };
+            b.Max = { b.Max.x + d.x, b.Max.y + d.y, b.Max.z + d.z };
+            reinserted += tree.MoveProxy(model.proxies[i], b, d);
+            ++moved;
+        }
+        // 作る/消す
+        for (int k = 0; k < 20; ++k)
+        {
+            const std::uint32_t i = rng() % n;
+            if (model.proxies[i] == DynamicAabbTree::kNull)
+                model.proxies[i] = tree.CreateProxy(model.boxes[i], i);
+            else
+            {
+                tree.DestroyProxy(model.proxies[i]);
+                model.proxies[i] = DynamicAabbTree::kNull;
+            }
+        }
+
+        std::uint32_t alive = 0;
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            if (model.proxies[i] == DynamicAabbTree::kNull) continue;
+            ++alive;
+            fatContains &= Contains(tree.GetFatAABB(model.proxies[i]), model.boxes[i]);
+            fatContains &= tree.GetUserData(model.proxies[i]) == i;
+        }
+        CHECK(tree.ProxyCount() == alive);
+
+        // 重なり：ファット AABB での線形走査と一致し、元の AABB で重なるものは全部入る
+        const AABB q = Box({ pos(rng), pos(rng), pos(rng) }, 20.0f);
+        std::vector<std::uint32_t> got, fat, tight;
+        tree.QueryOverlap(q, got);
+        got = Sorted(got);
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            if (model.proxies[i] == DynamicAabbTree::kNull) continue;
+            if (Overlaps(tree.GetFatAABB(model.proxies[i]), q)) fat.push_back(i);
+            if (Overlaps(model.boxes[i], q)) tight.push_back(i);
+        }
+        overlapExact &= got == fat;
+        overlapCovers &= std::includes(got.begin(), got.end(), tight.begin(), tight.end());
+
+        // 視錐台：同様
+        const Frustum f = MakeFrustum({ pos(rng), pos(rng), pos(rng) }, { pos(rng), pos(rng) * 0.2f, pos(rng) }, 80.0f);
+        got.clear(); fat.clear(); tight.clear();
+        tree.QueryFrustum(f, got);
+        got = Sorted(got);
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            if (model.proxies[i] == DynamicAabbTree::kNull) continue;
+            if (f.Intersects(tree.GetFatAABB(model.proxies[i]))) fat.push_back(i);
+            if (f.Intersects(model.boxes[i])) tight.push_back(i);
+        }
+        frustumExact &= got == fat;
+        frustumCovers &= std::includes(got.begin(), got.end(), tight.begin(), tight.end());
+    }
+    CHECK(fatContains);
+    CHECK(overlapExact);
+    CHECK(overlapCovers);
+    CHECK(frustumExact);
+    CHECK(frustumCovers);
+    CHECK(reinserted > 0);
+    CHECK(reinserted < moved / 4); // 移動の大半は見越したファット AABB に収まる
+
+    // 平衡：葉 3000 前後なら高さは log2 の 2 倍程度に収まる
+    CHECK(tree.Height() <= 2 * static_cast<std::int32_t>(std::ceil(std::log2(static_cast<double>(tree.ProxyCount())))));
+}
+
+TEST_CASE(DynamicAabbTree_FatMarginAndMoves)
+{
+    DynamicAabbTree tree(0.5f, 2.0f);
+    const AABB b = Box({ 0, 0, 0 }, 1.0f);
+    const std::int32_t id = tree.CreateProxy(b, 7);
+    const AABB& fat = tree.GetFatAABB(id);
+    CHECK(fat.Min.x == -1.5f && fat.Max.x == 1.5f);
+    CHECK(fat.Min.y == -1.5f && fat.Max.z == 1.5f);
+
+    // 余白の中なら組み替えない
+    CHECK(!tree.MoveProxy(id, Box({ 0.3f, 0, 0 }, 1.0f), { 0.3f, 0, 0 }));
+    CHECK(tree.GetFatAABB(id).Max.x == 1.5f);
+
+    // 外へ出たら組み替え、移動方向へ displacement × 2 だけ伸ばす
+    CHECK(tree.MoveProxy(id, Box({ 2.0f, 0, 0 }, 1.0f), { 1.0f, 0, 0 }));
+    const AABB& moved = tree.GetFatAABB(id);
+    CHECK(moved.Min.x == 0.5f);
+    CHECK(moved.Max.x == 5.5f);
+    CHECK(moved.Min.y == -1.5f && moved.Max.y == 1.5f);
+    CHECK(tree.GetUserData(id) == 7);
+
+    std::vector<std::uint32_t> out;
+    tree.QueryOverlap(Box({ 5.0f, 0, 0 }, 0.1f), out); // 見越した側は当たる
+    CHECK(out.size() == 1);
+    out.clear();
+    tree.QueryOverlap(Box({ 0, 0, 0 }, 0.1f), out);    // 元の位置はもう当たらない
+    CHECK(out.empty());
+}
+
+TEST_CASE(DynamicAabbTree_DestroyReusesIdsAndClear)
+{
+    DynamicAabbTree tree;
+    std::vector<std::int32_t> ids;
+    for (std::uint32_t i = 0; i < 16; ++i) ids.push_back(tree.CreateProxy(Box({ static_cast<float>(i) * 10.0f, 0, 0 }, 1.0f), i));
+    CHECK(tree.ProxyCount() == 16);
+
+    tree.DestroyProxy(ids[3]);
+    CHECK(tree.ProxyCount() == 15);
+    std::vector<std::uint32_t> out;
+    tree.QueryOverlap(Box({ 30.0f, 0, 0 }, 0.5f), out);
+    CHECK(out.empty());
+
+    // 空いたノードを使い回す（ノード配列は伸びない = 同じ ID か既存の範囲内）
+    const std::int32_t again = tree.CreateProxy(Box({ 30.0f, 0, 0 }, 1.0f), 99);
+    CHECK(again >= 0 && again < 2 * 16);
+    tree.SetUserData(again, 100);
+    tree.QueryOverlap(Box({ 30.0f, 0, 0 }, 0.5f), out);
+    CHECK(out == std::vector<std::uint32_t>({ 100 }));
+
+    tree.Clear();
+    CHECK(tree.ProxyCount() == 0);
+    CHECK(tree.Height() == 0);
+    out.clear();
+    tree.QueryOverlap(Box({ 0, 0, 0 }, 1000.0f), out);
+    CHECK(out.empty());
+    CHECK(tree.CreateProxy(Box({ 0, 0, 0 }, 1.0f), 1) >= 0);
+    CHECK(tree.ProxyCount() == 1);
+}
+
+BENCHMARK(DynamicAabbTree_20k)
+{
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> pos(-500.0f, 500.0f), size(0.5f, 3.0f), step(-0.2f, 0.2f);
+    const std::uint32_t n = 20000;
+    std::vector<AABB> boxes(n);
+    DynamicAabbTree tree;
+    std::vector<std::int32_t> ids(n);
+    const double buildMs = test::BestMilliseconds(1, [&]
+    {
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            boxes[i] = Box({ pos(rng), pos(rng) * 0.1f, pos(rng) }, size(rng));
+            ids[i] = tree.CreateProxy(boxes[i], i);
+        }
+    });
+
+    std::vector<XMFLOAT3> steps(n);
+    for (XMFLOAT3& d : steps) d = { step(rng), 0.0f, step(rng) };
+    std::size_t reinserted = 0;
+    const double moveMs = test::BestMilliseconds(10, [&]
+    {
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            AABB& b = boxes[i];
+            const XMFLOAT3& d = steps[i];
+            b.Min.x += d.x; b.Max.x += d.x; b.Min.z += d.z; b.Max.z += d.z;
+            reinserted += tree.MoveProxy(ids[i], b, d);
+        }
+    });
+
+    const Frustum f = MakeFrustum({ 0, 20, -600 }, { 0, 0, 1 }, 400.0f);
+    std::vector<std::uint32_t> out;
+    const double queryMs = test::BestMilliseconds(20, [&] { out.clear(); tree.QueryFrustum(f, out); });
+
+    test::Report("CreateProxy 20k", buildMs);
+    test::Report("MoveProxy 20k (1 frame)", moveMs);
+    test::Report("QueryFrustum 20k", queryMs);
+}
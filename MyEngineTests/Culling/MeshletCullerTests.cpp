@@ -0,0 +1,331 @@
+﻿#include "TestFramework.h"
+#include "Culling/MeshletCuller.h"
+#include "Assets/Meshlet.h"
+#include "Assets/MeshOptimizer.h"
+#include "Assets/MeshCorpus.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+/*
+    MeshletCuller のテスト/ベンチマーク
+    ----------------------------------------------------------------------------
+    z=-10 から +Z を見るカメラで、
+      - 視錐台：外の球は捨て、内側/平面をまたぐ球は残す。ワールド行列を掛けてもローカル空間で同じ答え
+      - 法線コーン：カメラと反対を向くコーンは捨て、正面/横向き/開きの大きいコーン/カメラに近い球は残す。
+        鏡映では表裏が入れ替わり、コーン無し（cutoff 1）は捨てない。正射影は視線方向だけで決まる
+      - CullMeshlets は手で組んだメッシュレットで残す番号・統計（加算）・インデックス数が既知の値になり、
+        WriteMeshletIndices は元の頂点番号を順に書く
+      - コーパスの全メッシュ × ランダムなワールド/カメラ（鏡映・正射影を含む）で、
+        見える三角形（表向きで視錐台の外に出ていない）を持つメッシュレットを捨てない。16bit と 32bit の出力は一致
+    ベンチマークはコーパス全体の判定（Mmeshlet/s）と詰め直し（Mtri/s）の速さ。
+*/
+
+namespace
+{
+    /// z=-10 から +Z を見るカメラ（縦横比 1、near 0.1 / far 100）
+    XMMATRIX MakeView() { return XMMatrixLookToLH(XMVectorSet(0, 0, -10, 1), XMVectorSet(0, 0, 1, 0), XMVectorSet(0, 1, 0, 0)); }
+    XMMATRIX MakeProj() { return XMMatrixPerspectiveFovLH(1.0f, 1.0f, 0.1f, 100.0f); }
+
+    MeshletBounds Sphere(float x, float y, float z, float r)
+    {
+        MeshletBounds b;
+        b.center = { x, y, z };
+        b.radius = r;
+        return b;
+    }
+
+    MeshletBounds Cone(float x, float y, float z, float r, float ax, float ay, float az, float cutoff)
+    {
+        MeshletBounds b = Sphere(x, y, z, r);
+        b.coneAxis = { ax, ay, az };
+        b.coneCutoff = cutoff;
+        return b;
+    }
+
+    XMFLOAT3 Sub(const XMFLOAT3& a, const XMFLOAT3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+    float Dot(const XMFLOAT3& a, const XMFLOAT3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    XMFLOAT3 Cross(const XMFLOAT3& a, const XMFLOAT3& b) { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+    float PlaneDistance(const XMFLOAT4& p, const XMFLOAT3& q) { return p.x * q.x + p.y * q.y + p.z * q.z + p.w; }
+
+    /// ランダムなワールド/カメラ（trial % 4 == 3 は鏡映、trial % 5 == 4 は正射影）
+    struct RandomView
+    {
+        XMMATRIX world, view, proj;
+        XMFLOAT3 eye;
+        bool     mirrored, ortho;
+    };
+
+    RandomView MakeRandomView(int trial, std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+        RandomView r;
+        r.mirrored = trial % 4 == 3;
+        r.ortho = trial % 5 == 4;
+        const float sx = 1.0f + 0.5f * u(rng), sy = 1.0f + 0.5f * u(rng), sz = (r.mirrored ? -1.0f : 1.0f) * (1.0f + 0.5f * u(rng));
+        r.world = XMMatrixScaling(sx, sy, sz) * XMMatrixRotationY(u(rng) * 3.0f) * XMMatrixRotationX(u(rng)) * XMMatrixTranslation(u(rng), u(rng), u(rng));
+
+        r.eye = { u(rng) * 4.0f, u(rng) * 4.0f, u(rng) * 4.0f };
+        const float len = std::sqrt(Dot(r.eye, r.eye));
+        if (len < 2.5f) r.eye = { r.eye.x * 2.5f / len, r.eye.y * 2.5f / len, r.eye.z * 2.5f / len };
+        const XMFLOAT3 dir{ -r.eye.x + u(rng) * 0.5f, -r.eye.y + u(rng) * 0.5f, -r.eye.z + u(rng) * 0.5f };
+        r.view = XMMatrixLookToLH(XMLoadFloat3(&r.eye), XMLoadFloat3(&dir), XMVectorSet(0, 1, 0, 0));
+        r.proj = r.ortho ? XMMatrixOrthographicOffCenterLH(-1.5f, 1.5f, -1.0f, 1.0f, 0.1f, 50.0f)
+                         : XMMatrixPerspectiveFovLH(0.6f + 0.4f * u(rng), 1.5f, 0.1f, 50.0f);
+        return r;
+    }
+}
+
+TEST_CASE(MeshletCuller_FrustumRejectKnownAnswer)
+{
+    const MeshletCullView v = MakeMeshletCullView(XMMatrixIdentity(), MakeView(), MakeProj());
+
+    // z=0（カメラから 10）での半幅は 10 × tan 0.5 ≒ 5.46
+    CHECK(!IsMeshletOutside(Sphere(0, 0, 0, 1), v));
+    CHECK(IsMeshletOutside(Sphere(20, 0, 0, 1), v));    // 右の外
+    CHECK(IsMeshletOutside(Sphere(0, -20, 0, 1), v));   // 下の外
+    CHECK(!IsMeshletOutside(Sphere(6, 0, 0, 1), v));    // 右の平面をまたぐ
+    CHECK(IsMeshletOutside(Sphere(0, 0, -20, 1), v));   // カメラの後ろ
+    CHECK(IsMeshletOutside(Sphere(0, 0, -10.05f, 0.1f), v)); // near（z=-9.9）の手前
+    CHECK(!IsMeshletOutside(Sphere(0, 0, -9.95f, 0.1f), v)); // near をまたぐ
+    CHECK(IsMeshletOutside(Sphere(0, 0, 95, 1), v));    // far（z=90）の奥
+    CHECK(!IsMeshletOutside(Sphere(0, 0, 89.5f, 1), v)); // far をまたぐ
+
+    // ワールドで右へ 20 動かすと、ローカルの原点は外になる（平面はローカル空間）
+    const MeshletCullView moved = MakeMeshletCullView(XMMatrixTranslation(20, 0, 0), MakeView(), MakeProj());
+    CHECK(IsMeshletOutside(Sphere(0, 0, 0, 1), moved));
+    CHECK(!IsMeshletOutside(Sphere(-20, 0, 0, 1), moved));
+}
+
+TEST_CASE(MeshletCuller_ConeRejectKnownAnswer)
+{
+    const MeshletCullView v = MakeMeshletCullView(XMMatrixIdentity(), MakeView(), MakeProj());
+    REQUIRE(v.perspective);
+    REQUIRE(!v.mirrored);
+    REQUIRE(v.testCone);
+    CHECK(std::fabs(v.eye.z + 10.0f) < 1e-4f);
+
+    // 透視投影：dot(c - e, a) >= cutoff × |c - e| + r × (1 + cutoff) なら裏向き
+    CHECK(IsMeshletBackfacing(Cone(0, 0, 0, 1, 0, 0, 1, 0.0f), v));     // 10 >= 1
+    CHECK(!IsMeshletBackfacing(Cone(0, 0, 0, 1, 0, 0, -1, 0.0f), v));   // カメラを向く
+    CHECK(!IsMeshletBackfacing(Cone(0, 0, 0, 1, 1, 0, 0, 0.0f), v));    // 横向き（シルエット）
+    CHECK(IsMeshletBackfacing(Cone(0, 0, 0, 1, 0, 0, 1, 0.5f), v));     // 10 >= 5 + 1.5
+    CHECK(!IsMeshletBackfacing(Cone(0, 0, 0, 1, 0, 0, 1, 0.95f), v));   // 10 < 9.5 + 1.95
+    CHECK(!IsMeshletBackfacing(Cone(0, 0, 0, 1, 0, 0, 1, 1.0f), v));    // コーン無し
+    CHECK(!IsMeshletBackfacing(Cone(0, 0, -9.5f, 1, 0, 0, 1, 0.0f), v)); // 球がカメラに近い：0.5 < 1
+
+    // 鏡映：表裏が入れ替わる（z 反転ではカメラがローカルの +Z 側に来て、巻き順の法線も反転する）
+    const MeshletCullView mirror = MakeMeshletCullView(XMMatrixScaling(1, 1, -1), MakeView(), MakeProj());
+    REQUIRE(mirror.mirrored);
+    CHECK(std::fabs(mirror.eye.z - 10.0f) < 1e-4f);
+    CHECK(IsMeshletBackfacing(Cone(0, 0, 0, 1, 0, 0, 1, 0.0f), mirror));
+    CHECK(!IsMeshletBackfacing(Cone(0, 0, 0, 1, 0, 0, -1, 0.0f), mirror));
+    MeshletCullView flipped = v;
+    flipped.mirrored = true;
+    CHECK(!IsMeshletBackfacing(Cone(0, 0, 0, 1, 0, 0, 1, 0.0f), flipped));
+    CHECK(IsMeshletBackfacing(Cone(0, 0, 0, 1, 0, 0, -1, 0.0f), flipped));
+
+    // 正射影：dot(direction, a) >= cutoff × |direction|（位置と半径は関係しない）
+    const MeshletCullView ortho = MakeMeshletCullView(XMMatrixScaling(0.5f, 0.5f, 0.5f), MakeView(),
+        XMMatrixOrthographicOffCenterLH(-5.0f, 5.0f, -5.0f, 5.0f, 0.1f, 100.0f));
+    REQUIRE(!ortho.perspective);
+    CHECK(std::fabs(ortho.direction.z - 2.0f) < 1e-4f); // ローカルでは長さ 2
+    CHECK(IsMeshletBackfacing(Cone(0, 0, -19, 100, 0, 0, 1, 0.5f), ortho));
+    CHECK(!IsMeshletBackfacing(Cone(0, 0, 0, 1, 0.8f, 0, -0.6f, 0.0f), ortho)); // 斜めにカメラを向く
+    CHECK(IsMeshletBackfacing(Cone(0, 0, 0, 1, 0.6f, 0, 0.8f, 0.5f), ortho));   // 1.6 >= 1.0
+    CHECK(!IsMeshletBackfacing(Cone(0, 0, 0, 1, 0.6f, 0, 0.8f, 0.85f), ortho)); // 1.6 < 1.7
+
+    // 潰れたワールド行列では向きを判定しない
+    const MeshletCullView flat = MakeMeshletCullView(XMMatrixScaling(1, 0, 1), MakeView(), MakeProj());
+    CHECK(!flat.testCone);
+}
+
+TEST_CASE(MeshletCuller_CullAndWriteKnownAnswer)
+{
+    // 1 三角形のメッシュレット 4 つ：見える / 視錐台の外 / 裏向き / コーン無し
+    MeshletData d;
+    const MeshletBounds bounds[] = {
+        Cone(0, 0, 0, 1, 0, 0, -1, 0.0f),
+        Sphere(20, 0, 0, 1),
+        Cone(0, 0, 0, 1, 0, 0, 1, 0.0f),
+        Sphere(0, 1, 0, 1),
+    };
+    for (std::uint32_t i = 0; i < 4; ++i)
+    {
+        Meshlet m;
+        m.vertexOffset = i * 3;
+        m.triangleOffset = i * 3;
+        m.vertexCount = 3;
+        m.triangleCount = 1;
+        d.Meshlets.push_back(m);
+        d.Bounds.push_back(bounds[i]);
+        for (std::uint32_t k = 0; k < 3; ++k) d.Vertices.push_back(100 + i * 10 + k);
+        d.Triangles.insert(d.Triangles.end(), { 0, 2, 1 });
+    }
+    d.IndexCount = 12;
+
+    MeshletCullView v = MakeMeshletCullView(XMMatrixIdentity(), MakeView(), MakeProj());
+    std::vector<std::uint32_t> visible{ 7, 7, 7 };
+    MeshletCullStats stats;
+    CHECK(CullMeshlets(d, v, visible, &stats) == 6);
+    CHECK(visible == std::vector<std::uint32_t>({ 0, 3 }));
+    CHECK(stats.tested == 4);
+    CHECK(stats.frustumCulled == 1);
+    CHECK(stats.coneCulled == 1);
+
+    std::uint32_t ib32[12] = {};
+    std::uint16_t ib16[12] = {};
+    CHECK(WriteMeshletIndices(d, visible.data(), visible.size(), ib32, false) == 6);
+    CHECK(WriteMeshletIndices(d, visible.data(), visible.size(), ib16, true) == 6);
+    const std::uint32_t want[] = { 100, 102, 101, 130, 132, 131 };
+    for (int k = 0; k < 6; ++k)
+    {
+        CHECK(ib32[k] == want[k]);
+        CHECK(ib16[k] == want[k]);
+    }
+
+    // 判定を切ると残る。統計は加算
+    v.testFrustum = false;
+    CHECK(CullMeshlets(d, v, visible, &stats) == 9);
+    CHECK(visible == std::vector<std::uint32_t>({ 0, 1, 3 }));
+    v.testFrustum = true;
+    v.testCone = false;
+    CHECK(CullMeshlets(d, v, visible, &stats) == 9);
+    CHECK(visible == std::vector<std::uint32_t>({ 0, 2, 3 }));
+    CHECK(stats.tested == 12);
+    CHECK(stats.frustumCulled == 2);
+    CHECK(stats.coneCulled == 2);
+}
+
+TEST_CASE(MeshletCuller_CorpusKeepsVisibleTriangles)
+{
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    std::mt19937 rng(7);
+    for (const MeshCorpusEntry& e : corpus)
+    {
+        MeshData m = e.mesh;
+        OptimizeMesh(m);
+        MeshletData d;
+        const std::size_t n = BuildMeshlets(m, MeshletLimits(), d);
+        REQUIRE(n > 0);
+
+        std::size_t culled = 0;
+        std::vector<std::uint32_t> visible;
+        std::vector<std::uint32_t> ib32(d.IndexCount);
+        std::vector<std::uint16_t> ib16(d.IndexCount);
+        for (int trial = 0; trial < 10; ++trial)
+        {
+            const RandomView r = MakeRandomView(trial, rng);
+            const MeshletCullView v = MakeMeshletCullView(r.world, r.view, r.proj);
+            CHECK(v.mirrored == r.mirrored);
+            CHECK(v.perspective == !r.ortho);
+
+            MeshletCullStats stats;
+            const std::size_t indexCount = CullMeshlets(d, v, visible, &stats);
+            CHECK(stats.tested == n);
+            CHECK(stats.tested == visible.size() + stats.frustumCulled + stats.coneCulled);
+            culled += stats.frustumCulled + stats.coneCulled;
+            CHECK(WriteMeshletIndices(d, visible.data(), visible.size(), ib32.data(), false) == indexCount);
+            if (m.Vertices.size() <= 0x10000)
+            {
+                WriteMeshletIndices(d, visible.data(), visible.size(), ib16.data(), true);
+                bool same = true;
+                for (std::size_t k = 0; k < indexCount; ++k) same &= ib16[k] == ib32[k];
+                CHECK(same);
+            }
+
+            // ワールド空間の総当たり：表向きで視錐台の外に出ていない三角形があるメッシュレットは残る
+            const Frustum wf = Frustum::FromViewProj(r.view * r.proj);
+            XMVECTOR det;
+            XMFLOAT3 forward;
+            XMStoreFloat3(&forward, XMMatrixInverse(&det, r.view).r[2]);
+            std::vector<char> kept(n, 0);
+            for (std::uint32_t i : visible) kept[i] = 1;
+            std::size_t wronglyCulled = 0;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                if (kept[i]) continue;
+                const Meshlet& ml = d.Meshlets[i];
+                std::vector<XMFLOAT3> wp(ml.vertexCount);
+                for (std::uint32_t k = 0; k < ml.vertexCount; ++k)
+                    XMStoreFloat3(&wp[k], XMVector3TransformCoord(XMLoadFloat3(&m.Vertices[d.Vertices[ml.vertexOffset + k]].Position), r.world));
+                for (std::uint32_t t = 0; t < ml.triangleCount; ++t)
+                {
+                    const std::uint8_t* tri = &d.Triangles[ml.triangleOffset + t * 3];
+                    const XMFLOAT3 &a = wp[tri[0]], &b = wp[tri[1]], &c = wp[tri[2]];
+                    const XMFLOAT3 nrm = Cross(Sub(b, a), Sub(c, a));
+                    const float area = std::sqrt(Dot(nrm, nrm));
+                    if (area < 1e-10f) continue;
+                    const XMFLOAT3 toTri = Sub(a, r.eye);
+                    const float facing = r.ortho ? Dot(nrm, forward) : Dot(nrm, toTri) / std::sqrt(Dot(toTri, toTri));
+                    if (facing >= -1e-6f * area) continue; // 裏向き（または真横）
+                    bool outside = false;
+                    for (const XMFLOAT4& p : wf.Planes)
+                        outside |= PlaneDistance(p, a) < -1e-4f && PlaneDistance(p, b) < -1e-4f && PlaneDistance(p, c) < -1e-4f;
+                    if (!outside) { ++wronglyCulled; break; }
+                }
+            }
+            if (wronglyCulled) std::printf("  %s trial %d: %zu meshlets wrongly culled\n", e.name.c_str(), trial, wronglyCulled);
+            CHECK(wronglyCulled == 0);
+        }
+        CHECK(culled > 0); // 何かは捨てている
+    }
+}
+
+BENCHMARK(MeshletCuller_Corpus)
+{
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    std::vector<MeshletData> meshlets(corpus.size());
+    std::size_t totalMeshlets = 0, maxIndices = 0;
+    for (std::size_t i = 0; i < corpus.size(); ++i)
+    {
+        MeshData m = corpus[i].mesh;
+        OptimizeMesh(m);
+        BuildMeshlets(m, MeshletLimits(), meshlets[i]);
+        totalMeshlets += meshlets[i].Meshlets.size();
+        if (meshlets[i].IndexCount > maxIndices) maxIndices = meshlets[i].IndexCount;
+    }
+
+    constexpr int kViews = 64;
+    std::mt19937 rng(11);
+    std::vector<MeshletCullView> views;
+    for (int i = 0; i < kViews; ++i)
+    {
+        const RandomView r = MakeRandomView(i, rng);
+        views.push_back(MakeMeshletCullView(r.world, r.view, r.proj));
+    }
+
+    std::vector<std::vector<std::uint32_t>> visible(corpus.size() * kViews);
+    MeshletCullStats stats;
+    const double cullMs = test::BestMilliseconds(5, [&]
+    {
+        stats = MeshletCullStats();
+        for (std::size_t i = 0; i < corpus.size(); ++i)
+            for (int k = 0; k < kViews; ++k) CullMeshlets(meshlets[i], views[k], visible[i * kViews + k], &stats);
+    });
+
+    std::vector<std::uint32_t> ib(maxIndices);
+    std::size_t written = 0;
+    const double writeMs = test::BestMilliseconds(5, [&]
+    {
+        written = 0;
+        for (std::size_t i = 0; i < corpus.size(); ++i)
+            for (int k = 0; k < kViews; ++k)
+            {
+                const std::vector<std::uint32_t>& vis = visible[i * kViews + k];
+                written += WriteMeshletIndices(meshlets[i], vis.data(), vis.size(), ib.data(), false);
+            }
+    });
+
+    std::printf("  %zu meshlets x %d views: frustum %.1f%%, cone %.1f%% culled | cull %.1f Mmeshlet/s, write %.0f Mtri/s\n",
+        totalMeshlets, kViews, 100.0 * stats.frustumCulled / stats.tested, 100.0 * stats.coneCulled / stats.tested,
+        stats.tested / (cullMs * 1e3), written / 3 / (writeMs * 1e3));
+    test::Report("CullMeshlets corpus", cullMs);
+    test::Report("WriteMeshletIndices corpus", writeMs);
+}
@@ -0,0 +1,203 @@
+﻿#include "TestFramework.h"
+#include "Culling/OcclusionCuller.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+/*
+    OcclusionCuller のテスト/ベンチマーク
+    ----------------------------------------------------------------------------
+    カメラ正面に大きな壁を置き、
+      - 壁の裏の箱は隠れ、手前の箱・壁の端から覗く箱・近平面をまたぐ箱は見える
+      - AVX2 版とスカラー版で深度バッファと判定がビット単位で一致する
+    を確かめる。ベンチマークはオクルーダ 201 個（約 2400 三角形）の塗りと AABB 判定の速さ。
+*/
+
+namespace
+{
+    /// 一辺 1 の立方体（原点中心）
+    MeshData MakeUnitBox()
+    {
+        MeshData m;
+        for (int i = 0; i < 8; ++i)
+        {
+            Vertex v{};
+            v.Position = { (i & 1) ? 0.5f : -0.5f, (i & 2) ? 0.5f : -0.5f, (i & 4) ? 0.5f : -0.5f };
+            m.Vertices.push_back(v);
+        }
+        const unsigned int faces[] = { 0,1,3, 0,3,2, 4,6,7, 4,7,5, 0,4,5, 0,5,1, 2,3,7, 2,7,6, 0,2,6, 0,6,4, 1,5,7, 1,7,3 };
+        m.Indices.assign(std::begin(faces), std::end(faces));
+        return m;
+    }
+
+    /// z=-10 から +Z を見るカメラ
+    XMMATRIX MakeViewProj()
+    {
+        const XMMATRIX view = XMMatrixLookToLH(XMVectorSet(0, 0, -10, 1), XMVectorSet(0, 0, 1, 0), XMVectorSet(0, 1, 0, 0));
+        const XMMATRIX proj = XMMatrixPerspectiveFovLH(1.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
+        return view * proj;
+    }
+
+    AABB Box(float x0, float y0, float z0, float x1, float y1, float z1)
+    {
+        AABB b;
+        b.Min = { x0, y0, z0 };
+        b.Max = { x1, y1, z1 };
+        return b;
+    }
+
+    /// z=0 に 20x20 の壁 + その奥に散らした小さな箱 200 個
+    std::vector<XMMATRIX> MakeOccluders()
+    {
+        std::vector<XMMATRIX> worlds;
+        worlds.push_back(XMMatrixScaling(20, 20, 0.2f));
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<float> u(-15.0f, 15.0f);
+        for (int i = 0; i < 200; ++i)
+        {
+            const float sx = 1 + u(rng) * 0.1f, sy = 1 + std::fabs(u(rng)) * 0.2f, ry = u(rng);
+            const float x = u(rng), y = u(rng), z = u(rng) + 15;
+            worlds.push_back(XMMatrixScaling(sx, sy, 1) * XMMatrixRotationY(ry) * XMMatrixTranslation(x, y, z));
+        }
+        return worlds;
+    }
+
+    void RasterizeScene(OcclusionCuller& culler, const MeshData& box, const std::vector<XMMATRIX>& worlds)
+    {
+        culler.BeginFrame(MakeViewProj());
+        for (const XMMATRIX& w : worlds) culler.AddOccluder(box, w);
+        culler.Rasterize();
+    }
+}
+
+TEST_CASE(OcclusionCuller_WallHidesBoxesBehindIt)
+{
+    const MeshData box = MakeUnitBox();
+    OcclusionCuller culler;
+    culler.BeginFrame(MakeViewProj());
+    culler.AddOccluder(box, XMMatrixScaling(20, 20, 0.2f));
+    culler.Rasterize();
+    CHECK(culler.Stats().occluderTriangles == 12);
+    CHECK(culler.Stats().rasterizedTriangles > 0);
+
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> u(-7.0f, 7.0f);
+    for (int i = 0; i < 500; ++i)
+    {
+        const float x = u(rng), y = u(rng);
+        CHECK(!culler.IsVisible(Box(x, y, 5, x + 1, y + 1, 6)));  // 壁の裏
+        CHECK(culler.IsVisible(Box(x, y, -3, x + 1, y + 1, -2))); // 壁の手前
+    }
+    CHECK(culler.IsVisible(Box(-1, -1, -11, 1, 1, -9))); // 近平面をまたぐ → 常に可視
+    CHECK(culler.IsVisible(AABB{}));                     // 無効な AABB は常に可視
+}
+
+TEST_CASE(OcclusionCuller_BoxPeekingPastEdgeIsVisible)
+{
+    // 幅 4 の壁（x=-2..2）。カメラから見た壁の端は x/距離 = 0.2
+    const MeshData box = MakeUnitBox();
+    OcclusionCuller culler;
+    culler.BeginFrame(MakeViewProj());
+    culler.AddOccluder(box, XMMatrixScaling(4, 4, 0.2f));
+    culler.Rasterize();
+
+    CHECK(!culler.IsVisible(Box(-1, -0.5f, 5, 1, 0.5f, 6)));    // 真後ろ
+    CHECK(!culler.IsVisible(Box(1.5f, -0.5f, 5, 2.5f, 0.5f, 6))); // 2.5/15 < 0.2 なのでまだ隠れる
+    CHECK(culler.IsVisible(Box(2.5f, -0.5f, 5, 4, 0.5f, 6)));     // 4/15 > 0.2 → 端からはみ出す
+    CHECK(culler.IsVisible(Box(-4, -0.5f, 5, -2.5f, 0.5f, 6)));   // 反対側も
+}
+
+TEST_CASE(OcclusionCuller_EmptyFrameHidesNothing)
+{
+    OcclusionCuller culler;
+    culler.BeginFrame(MakeViewProj());
+    culler.Rasterize();
+    CHECK(culler.Stats().occluderTriangles == 0);
+    CHECK(culler.IsVisible(Box(0, 0, 100, 1, 1, 101)));
+
+    // 前のフレームのオクルーダは BeginFrame で消える
+    const MeshData box = MakeUnitBox();
+    culler.BeginFrame(MakeViewProj());
+    culler.AddOccluder(box, XMMatrixScaling(20, 20, 0.2f));
+    culler.Rasterize();
+    CHECK(!culler.IsVisible(Box(0, 0, 5, 1, 1, 6)));
+    culler.BeginFrame(MakeViewProj());
+    culler.Rasterize();
+    CHECK(culler.IsVisible(Box(0, 0, 5, 1, 1, 6)));
+}
+
+TEST_CASE(OcclusionCuller_ResizeRoundsUpToTiles)
+{
+    OcclusionCuller culler(100, 50);
+    CHECK(culler.Width() == 104);
+    CHECK(culler.Height() == 56);
+    culler.Resize(64, 64);
+    CHECK(culler.Width() == 64);
+    CHECK(culler.Height() == 64);
+    CHECK(reinterpret_cast<std::uintptr_t>(culler.Depth()) % 32 == 0);
+}
+
+TEST_CASE(OcclusionCuller_SimdMatchesScalar)
+{
+    if (!OcclusionCuller::IsAvx2Supported())
+    {
+        std::printf("  AVX2 unsupported: skipped\n");
+        return;
+    }
+    const MeshData box = MakeUnitBox();
+    const std::vector<XMMATRIX> occluders = MakeOccluders();
+    OcclusionCuller simd, scalar;
+    scalar.SetSimdEnabled(false);
+    REQUIRE(simd.IsSimdEnabled());
+    RasterizeScene(simd, box, occluders);
+    RasterizeScene(scalar, box, occluders);
+
+    const std::size_t pixels = static_cast<std::size_t>(simd.Width()) * simd.Height();
+    CHECK(std::memcmp(simd.Depth(), scalar.Depth(), pixels * sizeof(float)) == 0);
+
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<float> u(-15.0f, 15.0f);
+    for (int i = 0; i < 2000; ++i)
+    {
+        const float x = u(rng), y = u(rng), z = u(rng) + 15;
+        const AABB b = Box(x, y, z, x + 0.5f, y + 0.5f, z + 0.5f);
+        CHECK(simd.IsVisible(b) == scalar.IsVisible(b));
+    }
+}
+
+BENCHMARK(OcclusionCuller_RasterizeAndTest)
+{
+    const MeshData box = MakeUnitBox();
+    const std::vector<XMMATRIX> occluders = MakeOccluders();
+
+    std::vector<AABB> queries;
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> u(-15.0f, 15.0f);
+    for (int i = 0; i < 100000; ++i)
+    {
+        const float x = u(rng), y = u(rng), z = u(rng) + 15;
+        queries.push_back(Box(x, y, z, x + 0.5f, y + 0.5f, z + 0.5f));
+    }
+
+    for (const bool simd : { true, false })
+    {
+        if (simd && !OcclusionCuller::IsAvx2Supported()) continue;
+        OcclusionCuller culler;
+        culler.SetSimdEnabled(simd);
+        const double raster = test::BestMilliseconds(50, [&] { RasterizeScene(culler, box, occluders); });
+        int visible = 0;
+        const double query = test::BestMilliseconds(5, [&]
+            {
+                visible = 0;
+                for (const AABB& b : queries) visible += culler.IsVisible(b) ? 1 : 0;
+            });
+        test::Report(simd ? "rasterize (avx2)" : "rasterize (scalar)", raster);
+        test::Report(simd ? "100k IsVisible (avx2)" : "100k IsVisible (scalar)", query);
+        std::printf("  triangles=%u rasterized=%u visible=%d/%zu\n",
+            culler.Stats().occluderTriangles, culler.Stats().rasterizedTriangles, visible, queries.size());
+    }
+}
@@ -0,0 +1,194 @@
+﻿#include "TestFramework.h"
+#include "Culling/StaticBvh.h"
+#include "Core/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace DirectX;
+
+/*
+    StaticBvh のテスト/ベンチマーク
+    ----------------------------------------------------------------------------
+    乱数で散らした AABB 群に対して、視錐台/重なり/レイの各クエリが
+    線形走査（全 AABB を 1 つずつ判定）と同じ答えを返すことを確かめる。
+    ベンチマークは 10 万オブジェクトでの構築時間と、視錐台クエリの線形走査との比較。
+*/
+
+namespace
+{
+    /// XZ 平面に広く、Y 方向は薄く散らした AABB 群（屋外シーン相当）
+    std::vector<AABB> MakeScatteredBoxes(int count, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> pos(-1000.0f, 1000.0f), size(0.5f, 4.0f);
+        std::vector<AABB> boxes(static_cast<std::size_t>(count));
+        for (AABB& b : boxes)
+        {
+            const float x = pos(rng), y = pos(rng) * 0.1f, z = pos(rng), s = size(rng);
+            b.Min = { x - s, y - s, z - s };
+            b.Max = { x + s, y + s, z + s };
+        }
+        return boxes;
+    }
+
+    Frustum MakeFrustum(float farZ)
+    {
+        const XMMATRIX view = XMMatrixLookToLH(XMVectorSet(0, 10, -50, 1), XMVectorSet(0.3f, 0, 1, 0), XMVectorSet(0, 1, 0, 0));
+        const XMMATRIX proj = XMMatrixPerspectiveFovLH(1.0f, 16.0f / 9.0f, 0.1f, farZ);
+        return Frustum::FromViewProj(view * proj);
+    }
+
+    std::vector<std::uint32_t> LinearFrustum(const std::vector<AABB>& boxes, const Frustum& f)
+    {
+        std::vector<std::uint32_t> ids;
+        for (std::uint32_t i = 0; i < boxes.size(); ++i)
+            if (boxes[i].IsValid() && f.Intersects(boxes[i])) ids.push_back(i);
+        return ids;
+    }
+
+    /// スラブ法で [0, maxT] の進入距離を求める（見つからなければ false）
+    bool RayBox(const XMFLOAT3& o, const XMFLOAT3& d, float maxT, const AABB& b, float& outT)
+    {
+        const float org[3] = { o.x, o.y, o.z }, dir[3] = { d.x, d.y, d.z };
+        const float mn[3] = { b.Min.x, b.Min.y, b.Min.z }, mx[3] = { b.Max.x, b.Max.y, b.Max.z };
+        float t0 = 0.0f, t1 = maxT;
+        for (int a = 0; a < 3; ++a)
+        {
+            const float inv = 1.0f / dir[a];
+            float tn = (mn[a] - org[a]) * inv, tf = (mx[a] - org[a]) * inv;
+            if (tn > tf) std::swap(tn, tf);
+            t0 = (std::max)(t0, tn);
+            t1 = (std::min)(t1, tf);
+            if (t0 > t1) return false;
+        }
+        outT = t0;
+        return true;
+    }
+}
+
+TEST_CASE(StaticBvh_FrustumMatchesLinearScan)
+{
+    std::vector<AABB> boxes = MakeScatteredBoxes(20000, 7);
+    boxes[5] = AABB{}; // 無効な AABB は構築時に除外される
+    StaticBvh bvh;
+    bvh.Build(boxes);
+    CHECK(bvh.PrimitiveCount() == boxes.size() - 1);
+
+    for (const float farZ : { 50.0f, 400.0f, 5000.0f })
+    {
+        const Frustum f = MakeFrustum(farZ);
+        std::vector<std::uint32_t> got;
+        BvhQueryStats stats;
+        bvh.QueryFrustum(f, got, &stats);
+        std::sort(got.begin(), got.end());
+        CHECK(got == LinearFrustum(boxes, f));
+        if (farZ < 100.0f) CHECK(stats.nodesVisited < bvh.NodeCount() / 4); // 近い視錐台は木のごく一部しか辿らない
+    }
+}
+
+TEST_CASE(StaticBvh_OverlapMatchesLinearScan)
+{
+    const std::vector<AABB> boxes = MakeScatteredBoxes(5000, 11);
+    StaticBvh bvh;
+    bvh.Build(boxes);
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> pos(-1000.0f, 1000.0f), size(1.0f, 80.0f);
+    for (int k = 0; k < 50; ++k)
+    {
+        const float x = pos(rng), z = pos(rng), s = size(rng);
+        AABB q;
+        q.Min = { x - s, -s, z - s };
+        q.Max = { x + s, s, z + s };
+
+        std::vector<std::uint32_t> got, want;
+        bvh.QueryOverlap(q, got);
+        for (std::uint32_t i = 0; i < boxes.size(); ++i)
+        {
+            const AABB& b = boxes[i];
+            if (b.Min.x <= q.Max.x && q.Min.x <= b.Max.x && b.Min.y <= q.Max.y && q.Min.y <= b.Max.y &&
+                b.Min.z <= q.Max.z && q.Min.z <= b.Max.z)
+                want.push_back(i);
+        }
+        std::sort(got.begin(), got.end());
+        CHECK(got == want);
+    }
+}
+
+TEST_CASE(StaticBvh_RaycastReturnsNearestHit)
+{
+    const std::vector<AABB> boxes = MakeScatteredBoxes(5000, 13);
+    StaticBvh bvh;
+    bvh.Build(boxes);
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> pos(-1000.0f, 1000.0f);
+    int hits = 0;
+    for (int k = 0; k < 200; ++k)
+    {
+        const XMFLOAT3 o{ pos(rng), pos(rng) * 0.1f, pos(rng) };
+        const XMFLOAT3 d{ pos(rng), pos(rng) * 0.01f, pos(rng) };
+        std::uint32_t id = 0;
+        float t = 0.0f;
+        const bool hit = bvh.Raycast(o, d, 1.0f, id, t);
+
+        float bestT = 1e30f;
+        bool want = false;
+        for (const AABB& b : boxes)
+        {
+            float bt;
+            if (RayBox(o, d, 1.0f, b, bt) && bt < bestT) { bestT = bt; want = true; }
+        }
+        CHECK(hit == want);
+        if (hit && want)
+        {
+            CHECK(std::fabs(t - bestT) <= 1e-5f);
+            float own;
+            CHECK(RayBox(o, d, 1.0f, boxes[id], own)); // 返した ID 自身にも当たっている
+            ++hits;
+        }
+    }
+    CHECK(hits > 0);
+}
+
+TEST_CASE(StaticBvh_ClearAndRebuild)
+{
+    StaticBvh bvh;
+    CHECK(bvh.Empty());
+    std::vector<std::uint32_t> out;
+    bvh.QueryFrustum(MakeFrustum(400.0f), out); // 空でも落ちない
+    CHECK(out.empty());
+
+    bvh.Build(MakeScatteredBoxes(100, 1));
+    CHECK(!bvh.Empty());
+    CHECK(bvh.PrimitiveCount() == 100);
+
+    bvh.Build(MakeScatteredBoxes(10, 2)); // 以前の内容は破棄される
+    CHECK(bvh.PrimitiveCount() == 10);
+
+    bvh.Clear();
+    CHECK(bvh.Empty());
+    CHECK(bvh.PrimitiveCount() == 0);
+}
+
+BENCHMARK(StaticBvh_Build100k)
+{
+    const std::vector<AABB> boxes = MakeScatteredBoxes(100000, 7);
+    StaticBvh bvh;
+    test::Report("build (100k)", test::BestMilliseconds(5, [&] { bvh.Build(boxes); }));
+    std::printf("  nodes=%zu workers=%u\n", bvh.NodeCount(), JobSystem::WorkerCount());
+
+    const Frustum f = MakeFrustum(400.0f);
+    std::vector<std::uint32_t> out, linear;
+    BvhQueryStats stats;
+    test::Report("frustum query (bvh)", test::BestMilliseconds(50, [&] { out.clear(); stats = {}; bvh.QueryFrustum(f, out, &stats); }));
+    test::Report("frustum query (linear)", test::BestMilliseconds(50, [&] { linear = LinearFrustum(boxes, f); }));
+    std::printf("  visible=%zu nodes=%u accepted=%u tested=%u\n",
+        out.size(), stats.nodesVisited, stats.subtreesAccepted, stats.primitivesTested);
+    std::sort(out.begin(), out.end());
+    CHECK(out == linear);
+}
@@ -0,0 +1,225 @@
+﻿#pragma once
+#include <wrl/client.h>
+#include <d3d12.h>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "Core/CommandListPool.h"
+#include "Core/UploadRing.h"
+#include "Upload/GpuUploadQueue.h"
+
+/*
+===============================================================================
+ FakeD3D12（テスト用の GPU の代役）
+-------------------------------------------------------------------------------
+目的:
+  - フェンスを使って寿命を管理するクラス（UploadRing / CommandListPool / GpuUploadQueue …）を、
+    デバイス無しで確かめるための最小の代役。
+  - 「GPU がどこまで進んだか」はテストが Fence::Complete で明示的に決める。
+    各クラスの差し替え口（PageFactory / Backend）にはここの部品を渡す。
+
+部品:
+  - Fence       …… Signal で値を払い出し、Complete で到達値を進める（単調増加）
+  - UploadPages …… CPU メモリのページを作る PageFactory（GPU アドレスは 64KB 境界の架空の値）
+  - CommandLists …… CommandListPool::Backend。実物は作らず、呼ばれた組の id を記録する
+                    （list は null のままなので、Acquire の戻り値ではなく記録と Stats で確かめる）
+  - CopyQueue   …… GpuUploadQueue::Backend。積まれたコピーは Advance でフェンスに届いたときに実行する
+                   （その時点のステージングを読むので、完了前に上書きされれば中身が壊れて分かる）
+  - Resource    …… CPU メモリを中身に持つ ID3D12Resource。参照カウントと中身だけが本物で、
+                   他のメソッドは E_NOTIMPL を返す。寿命はテストが持つ（Release で delete しない）ので、
+                   RefCount() で「クラスが参照を手放したか」を確かめられる。
+===============================================================================
+*/
+
+namespace fake
+{
+    /// 手で進めるフェンス
+    struct Fence
+    {
+        std::uint64_t completed = 0; ///< GPU が到達した値
+        std::uint64_t next = 1;      ///< 次に Signal する値
+
+        std::uint64_t Signal() { return next++; }
+        void Complete(std::uint64_t value) { if (value > completed) completed = value; }
+        void CompleteAll() { completed = next - 1; }
+    };
+
+    /// CPU メモリのアップロードページ（UploadRing::PageFactory として渡す）
+    class UploadPages
+    {
+    public:
+        int  created = 0;  ///< 作ったページ数
+        bool fail = false; ///< true の間は作成に失敗する
+
+        UploadRing::PageFactory Factory()
+        {
+            return [this](std::uint64_t bytes, UploadPage& out) -> bool
+                {
+                    if (fail) return false;
+                    m_memory.emplace_back(new std::uint8_t[static_cast<std::size_t>(bytes)]);
+                    out.cpu = m_memory.back().get();
+                    out.gpu = m_nextGpu;
+                    out.size = bytes;
+                    m_nextGpu += (bytes + 0xFFFF) & ~0xFFFFull; // コミット済みリソースと同じく 64KB 境界
+                    ++created;
+                    return true;
+                };
+        }
+
+    private:
+        std::vector<std::unique_ptr<std::uint8_t[]>> m_memory;
+        std::uint64_t                                m_nextGpu = 0x10000;
+    };
+
+    /// 記録だけするコマンドリストの Backend
+    struct CommandLists
+    {
+        bool failCreate = false;
+        bool failOpen = false;
+        bool failReset = false;
+
+        int                        created = 0;
+        std::vector<std::uint32_t> opened; ///< open された組の id（呼ばれた順）
+        std::vector<std::uint32_t> closed; ///< close された組の id（呼ばれた順）
+        std::vector<std::uint32_t> reset;  ///< resetAllocator された組の id（呼ばれた順）
+
+        CommandListPool::Backend Backend()
+        {
+            CommandListPool::Backend b;
+            b.create = [this](CommandListEntry&) { if (failCreate) return false; ++created; return true; };
+            b.resetAllocator = [this](CommandListEntry& e) { if (failReset) return false; reset.push_back(e.id); return true; };
+            b.open = [this](CommandListEntry& e) { if (failOpen) return false; opened.push_back(e.id); return true; };
+            b.close = [this](CommandListEntry& e) { closed.push_back(e.id); };
+            return b;
+        }
+    };
+
+    class Resource;
+
+    /// COPY キューの代役（コピーは GPU がフェンスに届いた時点で実行する）
+    class CopyQueue
+    {
+    public:
+        std::uint64_t completed = 0;     ///< キューが到達したフェンス値
+        int           waits = 0;         ///< wait が呼ばれた回数
+        bool          failStaging = false;
+
+        GpuUploadQueue::Backend Backend();
+
+        /// fence 以下で提出されたコピーを実行して到達値を進める
+        void Advance(std::uint64_t fence);
+
+    private:
+        struct Copy
+        {
+            Resource*     dst;
+            std::uint64_t dstOffset;
+            Resource*     src; ///< nullptr ならステージング
+            std::uint64_t srcOffset;
+            std::uint64_t bytes;
+        };
+
+        std::vector<std::uint8_t>                              m_staging;
+        std::vector<Copy>                                      m_open;
+        std::deque<std::pair<std::uint64_t, std::vector<Copy>>> m_submitted;
+    };
+
+    /// CPU メモリを中身に持つバッファ
+    class Resource final : public ID3D12Resource
+    {
+    public:
+        std::vector<std::uint8_t> bytes; ///< バッファの中身（コピーの転送先/転送元として読み書きする）
+
+        explicit Resource(std::size_t size, D3D12_GPU_VIRTUAL_ADDRESS gpu = 0) : bytes(size, 0), m_gpu(gpu) {}
+        Resource(const Resource&) = delete;
+        Resource& operator=(const Resource&) = delete;
+
+        /// テストが持つ 1 を含む参照数（クラスが参照を手放していれば 1）
+        ULONG RefCount() const { return m_refs; }
+
+        // IUnknown
+        HRESULT STDMETHODCALLTYPE QueryInterface(REFIID, void** out) override { if (out) *out = nullptr; return E_NOINTERFACE; }
+        ULONG STDMETHODCALLTYPE AddRef() override { return ++m_refs; }
+        ULONG STDMETHODCALLTYPE Release() override { return --m_refs; }
+
+        // ID3D12Object / ID3D12DeviceChild
+        HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID, UINT*, void*) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID, UINT, const void*) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID, const IUnknown*) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE SetName(LPCWSTR) override { return S_OK; }
+        HRESULT STDMETHODCALLTYPE GetDevice(REFIID, void** out) override { if (out) *out = nullptr; return E_NOTIMPL; }
+
+        // ID3D12Resource
+        HRESULT STDMETHODCALLTYPE Map(UINT, const D3D12_RANGE*, void** out) override
+        {
+            if (out) *out = bytes.data();
+            return S_OK;
+        }
+        void STDMETHODCALLTYPE Unmap(UINT, const D3D12_RANGE*) override {}
+        D3D12_RESOURCE_DESC STDMETHODCALLTYPE GetDesc() override
+        {
+            D3D12_RESOURCE_DESC d{};
+            d.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+            d.Width = bytes.size();
+            d.Height = 1;
+            d.DepthOrArraySize = 1;
+            d.MipLevels = 1;
+            d.SampleDesc.Count = 1;
+            d.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+            return d;
+        }
+        D3D12_GPU_VIRTUAL_ADDRESS STDMETHODCALLTYPE GetGPUVirtualAddress() override { return m_gpu; }
+        HRESULT STDMETHODCALLTYPE WriteToSubresource(UINT, const D3D12_BOX*, const void*, UINT, UINT) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE ReadFromSubresource(void*, UINT, UINT, UINT, const D3D12_BOX*) override { return E_NOTIMPL; }
+        HRESULT STDMETHODCALLTYPE GetHeapProperties(D3D12_HEAP_PROPERTIES*, D3D12_HEAP_FLAGS*) override { return E_NOTIMPL; }
+
+    private:
+        ULONG                     m_refs = 1;
+        D3D12_GPU_VIRTUAL_ADDRESS m_gpu = 0;
+    };
+
+    inline GpuUploadQueue::Backend CopyQueue::Backend()
+    {
+        GpuUploadQueue::Backend b;
+        b.createStaging = [this](std::uint64_t bytes, UploadPage& out)
+            {
+                if (failStaging) return false;
+                m_staging.assign(static_cast<std::size_t>(bytes), 0);
+                out.cpu = m_staging.data();
+                out.gpu = 0x10000;
+                out.size = bytes;
+                return true;
+            };
+        b.copy = [this](ID3D12Resource* dst, std::uint64_t dstOffset, ID3D12Resource* src, std::uint64_t srcOffset, std::uint64_t bytes)
+            {
+                m_open.push_back({ static_cast<Resource*>(dst), dstOffset, static_cast<Resource*>(src), srcOffset, bytes });
+                return true;
+            };
+        b.submit = [this](std::uint64_t fence)
+            {
+                m_submitted.emplace_back(fence, std::move(m_open));
+                m_open.clear();
+                return true;
+            };
+        b.completed = [this] { return completed; };
+        b.wait = [this](std::uint64_t fence) { ++waits; Advance(fence); };
+        return b;
+    }
+
+    inline void CopyQueue::Advance(std::uint64_t fence)
+    {
+        while (!m_submitted.empty() && m_submitted.front().first <= fence)
+        {
+            for (const Copy& c : m_submitted.front().second)
+            {
+                const std::uint8_t* from = c.src ? c.src->bytes.data() : m_staging.data();
+                std::memcpy(c.dst->bytes.data() + c.dstOffset, from + c.srcOffset, static_cast<std::size_t>(c.bytes));
+            }
+            m_submitted.pop_front();
+        }
+        if (fence > completed) completed = fence;
+    }
+}
@@ -0,0 +1,197 @@
+﻿#include "TestFramework.h"
+#include "Renderer/DrawList.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+/*
+    DrawList のテスト/ベンチマーク
+    ----------------------------------------------------------------------------
+      - MakeKey：pipeline > mesh > depth の順に効き、depth は手前ほど小さい。負の depth / NaN は 0 と同じ
+      - RadixSortDrawPackets は std::stable_sort（key 昇順）と同じ並びになる（同じキーは入力順のまま）。
+        件数 0 / 1 / 全部同じキー / 1 桁だけ違うキー / 負の depth 混じりの乱数でも同じ
+      - DrawList は Begin → Push → Sort を何フレーム繰り返しても正しく並び、capacity を超えた分は捨てる。
+        作業領域（LinearAllocator）は伸びたあとの Reset で 1 ブロックにまとまり、同じ件数なら以後増えない
+    ベンチマークは 1 万件の基数ソートと std::sort / std::stable_sort の比較。
+*/
+
+namespace
+{
+    /// 中身を持たない描画候補（アドレス = 入力順の番号）
+    unsigned char g_items[1 << 16];
+
+    const RenderItem* Item(std::size_t i) { return reinterpret_cast<const RenderItem*>(g_items + i); }
+
+    std::vector<DrawPacket> StableSorted(std::vector<DrawPacket> v)
+    {
+        std::stable_sort(v.begin(), v.end(), [](const DrawPacket& a, const DrawPacket& b) { return a.key < b.key; });
+        return v;
+    }
+
+    bool Same(const std::vector<DrawPacket>& a, const DrawPacket* b, std::size_t n)
+    {
+        if (a.size() != n) return false;
+        for (std::size_t i = 0; i < n; ++i)
+            if (a[i].key != b[i].key || a[i].item != b[i].item || a[i].lod != b[i].lod) return false;
+        return true;
+    }
+
+    bool RadixMatchesStableSort(const std::vector<DrawPacket>& input)
+    {
+        std::vector<DrawPacket> data = input, scratch(input.size());
+        RadixSortDrawPackets(data.data(), scratch.data(), data.size());
+        return Same(StableSorted(input), data.data(), data.size());
+    }
+}
+
+TEST_CASE(DrawList_MakeKeyOrder)
+{
+    // 同じ PSO・メッシュの中では手前から奥へ
+    CHECK(DrawList::MakeKey(0, 0, 0.5f) < DrawList::MakeKey(0, 0, 1.0f));
+    CHECK(DrawList::MakeKey(0, 0, 1.0f) < DrawList::MakeKey(0, 0, 1000.0f));
+    CHECK(DrawList::MakeKey(0, 0, -5.0f) == DrawList::MakeKey(0, 0, 0.0f));
+    CHECK(DrawList::MakeKey(0, 0, std::numeric_limits<float>::quiet_NaN()) == DrawList::MakeKey(0, 0, 0.0f));
+
+    // mesh は depth より、pipeline は mesh より効く
+    CHECK(DrawList::MakeKey(0, 1, 0.0f) > DrawList::MakeKey(0, 0, 1e30f));
+    CHECK(DrawList::MakeKey(1, 0, 0.0f) > DrawList::MakeKey(0, 0xFFFFFF, 1e30f));
+
+    // 範囲外のビットは隣の欄へはみ出さない
+    CHECK(DrawList::MakeKey(0x1FF, 0, 0.0f) == DrawList::MakeKey(0xFF, 0, 0.0f));
+    CHECK(DrawList::MakeKey(0, 0x1000001, 0.0f) == DrawList::MakeKey(0, 1, 0.0f));
+}
+
+TEST_CASE(DrawList_RadixSortMatchesStableSort)
+{
+    // 0 件 / 1 件は何もしない
+    DrawPacket one = { 42, Item(0), 3 };
+    RadixSortDrawPackets(nullptr, nullptr, 0);
+    RadixSortDrawPackets(&one, nullptr, 1);
+    CHECK(one.key == 42 && one.item == Item(0) && one.lod == 3);
+
+    // 全部同じキー（全パスを飛ばす）/ 1 桁だけ違うキー（1 パスだけ回る = 結果は scratch 側）
+    std::vector<DrawPacket> same, oneDigit;
+    for (std::size_t i = 0; i < 300; ++i)
+    {
+        same.push_back({ DrawList::MakeKey(2, 7, 1.0f), Item(i), 0 });
+        oneDigit.push_back({ 0x0102030400000000ull | (static_cast<std::uint64_t>(i * 37 % 5) << 40), Item(i), static_cast<std::uint32_t>(i % 4) });
+    }
+    CHECK(RadixMatchesStableSort(same));
+    CHECK(RadixMatchesStableSort(oneDigit));
+
+    // 乱数：件数・キーの散らばり・負の depth を変えて
+    std::mt19937_64 rng(3);
+    bool allMatch = true;
+    for (int trial = 0; trial < 50; ++trial)
+    {
+        const std::size_t n = rng() % 5000 + 2;
+        const std::uint32_t pipelines = 1 + static_cast<std::uint32_t>(trial % 4), meshes = 1 + static_cast<std::uint32_t>(rng() % 60);
+        std::vector<DrawPacket> v(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const float depth = static_cast<float>(rng() % 100000) / 7.0f - ((trial & 1) ? 100.0f : 0.0f);
+            v[i] = { DrawList::MakeKey(static_cast<std::uint32_t>(rng() % pipelines), static_cast<std::uint32_t>(rng() % meshes),
+                         (trial % 5 == 0) ? static_cast<float>(rng() % 4) : depth),
+                     Item(i), static_cast<std::uint32_t>(rng() % 4) };
+        }
+        allMatch &= RadixMatchesStableSort(v);
+    }
+    CHECK(allMatch);
+}
+
+TEST_CASE(DrawList_BeginPushSortAcrossFrames)
+{
+    std::mt19937 rng(5);
+    DrawList list;
+
+    // capacity を超えた分は捨てる
+    list.Begin(3);
+    for (std::size_t i = 0; i < 5; ++i) list.Push(DrawList::MakeKey(0, 0, static_cast<float>(5 - i)), Item(i));
+    CHECK(list.Size() == 3);
+    list.Sort();
+    CHECK(list.begin()[0].item == Item(2) && list.begin()[1].item == Item(1) && list.begin()[2].item == Item(0));
+
+    // 毎フレーム件数を変えて積み直す：どのフレームも stable_sort と同じ並び
+    bool allMatch = true;
+    for (const std::size_t count : { 100u, 20000u, 60000u, 60000u, 1000u, 60000u })
+    {
+        list.Begin(count);
+        std::vector<DrawPacket> pushed;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const DrawPacket p = { DrawList::MakeKey(rng() % 3, rng() % 37, static_cast<float>(rng() % 1000) * 0.25f), Item(i),
+                                   static_cast<std::uint32_t>(rng() % 4) };
+            list.Push(p.key, p.item, p.lod);
+            pushed.push_back(p);
+        }
+        CHECK(list.Size() == count);
+        list.Sort();
+        allMatch &= Same(StableSorted(pushed), list.begin(), list.Size());
+    }
+    CHECK(allMatch);
+}
+
+TEST_CASE(DrawList_ArenaMergesAndStopsGrowing)
+{
+    // DrawList と同じ使い方（Reset → パケット n 件 → 作業領域 n 件）を LinearAllocator で直接確かめる
+    LinearAllocator arena(1024);
+    std::mt19937_64 rng(7);
+    const std::size_t n = 10000;
+    std::size_t steadyCapacity = 0;
+    bool allMatch = true;
+    for (int frame = 0; frame < 4; ++frame)
+    {
+        arena.Reset();
+        DrawPacket* packets = arena.Allocate<DrawPacket>(n);
+        DrawPacket* scratch = arena.Allocate<DrawPacket>(n);
+        CHECK(reinterpret_cast<std::uintptr_t>(packets) % alignof(DrawPacket) == 0);
+        CHECK(reinterpret_cast<std::uintptr_t>(scratch) % alignof(DrawPacket) == 0);
+        CHECK(arena.Used() >= 2 * n * sizeof(DrawPacket));
+        CHECK(arena.Used() <= arena.Capacity());
+
+        std::vector<DrawPacket> pushed(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            pushed[i] = { DrawList::MakeKey(0, static_cast<std::uint32_t>(rng() % 16), static_cast<float>(rng() % 500)), Item(i), 0 };
+            packets[i] = pushed[i];
+        }
+        RadixSortDrawPackets(packets, scratch, n);
+        allMatch &= Same(StableSorted(pushed), packets, n);
+
+        // 1 フレーム目で伸びたブロックは 2 フレーム目の Reset でまとまり、以後は増えない
+        if (frame == 1) steadyCapacity = arena.Capacity();
+        if (frame > 1) CHECK(arena.Capacity() == steadyCapacity);
+    }
+    CHECK(allMatch);
+    CHECK(steadyCapacity >= 2 * n * sizeof(DrawPacket));
+}
+
+BENCHMARK(DrawList_Sort10k)
+{
+    std::mt19937_64 rng(3);
+    const std::size_t n = 10000;
+    std::vector<DrawPacket> input(n), work(n), scratch(n);
+    for (std::size_t i = 0; i < n; ++i)
+        input[i] = { DrawList::MakeKey(static_cast<std::uint32_t>(rng() % 4), static_cast<std::uint32_t>(rng() % 64),
+                         static_cast<float>(rng() % 100000) * 0.01f), Item(i), 0 };
+    const auto less = [](const DrawPacket& a, const DrawPacket& b) { return a.key < b.key; };
+
+    const double radixMs = test::BestMilliseconds(50, [&] { work = input; RadixSortDrawPackets(work.data(), scratch.data(), n); });
+    const double sortMs = test::BestMilliseconds(50, [&] { work = input; std::sort(work.begin(), work.end(), less); });
+    const double stableMs = test::BestMilliseconds(50, [&] { work = input; std::stable_sort(work.begin(), work.end(), less); });
+
+    DrawList list;
+    const double listMs = test::BestMilliseconds(50, [&]
+    {
+        list.Begin(n);
+        for (const DrawPacket& p : input) list.Push(p.key, p.item, p.lod);
+        list.Sort();
+    });
+
+    test::Report("RadixSortDrawPackets 10k", radixMs);
+    test::Report("std::sort 10k", sortMs);
+    test::Report("std::stable_sort 10k", stableMs);
+    test::Report("DrawList Begin/Push/Sort 10k", listMs);
+}
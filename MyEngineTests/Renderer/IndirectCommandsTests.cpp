@@ -0,0 +1,114 @@
+﻿#include "TestFramework.h"
+#include "Renderer/IndirectCommands.h"
+#include <cstddef>
+#include <vector>
+
+/*
+    IndirectCommands のテスト
+    ----------------------------------------------------------------------------
+    BuildInstanceBatches → WriteIndirectCommands の流れで、
+      - レコードのレイアウトがコマンドシグネチャの引数順（VBV x2 / IBV / drawBase / Draw）と一致する
+      - 区間ごとに drawBase・インスタンス数・メッシュ区間・LOD が正しく入る
+      - pipeline が変わるところで IndirectRun が切れる
+    を確かめる。RenderItem の中身は使わないので、アドレスだけをメッシュの識別に使う。
+*/
+
+static_assert(offsetof(IndirectDrawCommand, vbv) == 0, "vbv[0] must be the first argument");
+static_assert(offsetof(IndirectDrawCommand, ibv) == 32, "ibv follows the vertex streams");
+static_assert(offsetof(IndirectDrawCommand, drawBase) == 48, "drawBase is the root constant");
+static_assert(offsetof(IndirectDrawCommand, draw) == 52, "draw arguments must come last");
+
+namespace
+{
+    /// 中身を持たない描画候補（アドレス = メッシュの識別子）
+    alignas(8) unsigned char g_items[3][8];
+
+    const RenderItem* Item(int mesh) { return reinterpret_cast<const RenderItem*>(g_items[mesh]); }
+    int MeshOf(const RenderItem& item)
+    {
+        return static_cast<int>((reinterpret_cast<const unsigned char*>(&item) - g_items[0]) / sizeof(g_items[0]));
+    }
+
+    IndirectMesh GetMesh(const RenderItem& item, std::uint32_t lod)
+    {
+        const int mesh = MeshOf(item);
+        IndirectMesh m;
+        m.vbv[0].BufferLocation = 0x10000;
+        m.vbv[0].StrideInBytes = 12;
+        m.vbv[1].BufferLocation = 0x20000;
+        m.vbv[1].StrideInBytes = 8;
+        m.ibv.BufferLocation = 0x30000;
+        m.ibv.Format = DXGI_FORMAT_R32_UINT;
+        m.indexCount = 36u * (mesh + 1) >> lod;
+        m.startIndex = 1000u * mesh + 100u * lod;
+        m.baseVertex = 500 * mesh;
+        return m;
+    }
+}
+
+TEST_CASE(IndirectCommands_OneRecordPerBatchSplitByPipeline)
+{
+    // pipeline 0：メッシュ 0 x2、メッシュ 1 x2（LOD 0 と 1）、pipeline 3：メッシュ 2 x2
+    const DrawPacket packets[] = {
+        { DrawList::MakeKey(0, 0, 1.0f), Item(0), 0 },
+        { DrawList::MakeKey(0, 0, 2.0f), Item(0), 0 },
+        { DrawList::MakeKey(0, 1, 1.0f), Item(1), 0 },
+        { DrawList::MakeKey(0, 2, 3.0f), Item(1), 1 }, // 同じメッシュでも LOD が違えば別区間
+        { DrawList::MakeKey(3, 3, 1.0f), Item(2), 0 },
+        { DrawList::MakeKey(3, 3, 2.0f), Item(2), 0 },
+    };
+    std::vector<InstanceBatch> batches;
+    const std::size_t instances = BuildInstanceBatches(packets, 6, 6,
+        [](const RenderItem& a, const RenderItem& b) { return &a == &b; }, batches);
+    CHECK(instances == 6);
+    REQUIRE(batches.size() == 4);
+
+    IndirectDrawCommand out[4]{};
+    std::vector<IndirectRun> runs;
+    CHECK(WriteIndirectCommands(packets, batches.data(), batches.size(), GetMesh, out, runs) == 4);
+
+    REQUIRE(runs.size() == 2);
+    CHECK(runs[0].pipeline == 0 && runs[0].first == 0 && runs[0].count == 3);
+    CHECK(runs[1].pipeline == 3 && runs[1].first == 3 && runs[1].count == 1);
+
+    const std::uint32_t wantBase[] = { 0, 2, 3, 4 };
+    const std::uint32_t wantCount[] = { 2, 1, 1, 2 };
+    const std::uint32_t wantIndices[] = { 36, 72, 36, 108 };
+    const std::uint32_t wantStart[] = { 0, 1000, 1100, 2000 };
+    for (int i = 0; i < 4; ++i)
+    {
+        const IndirectDrawCommand& c = out[i];
+        CHECK(c.drawBase == wantBase[i]);
+        CHECK(c.draw.InstanceCount == wantCount[i]);
+        CHECK(c.draw.IndexCountPerInstance == wantIndices[i]);
+        CHECK(c.draw.StartIndexLocation == wantStart[i]);
+        CHECK(c.draw.StartInstanceLocation == 0);
+        CHECK(c.vbv[0].BufferLocation == 0x10000 && c.vbv[0].StrideInBytes == 12);
+        CHECK(c.vbv[1].BufferLocation == 0x20000 && c.vbv[1].StrideInBytes == 8);
+        CHECK(c.ibv.BufferLocation == 0x30000);
+    }
+    CHECK(out[3].draw.BaseVertexLocation == 1000);
+}
+
+TEST_CASE(IndirectCommands_MaxInstancesTruncatesBatches)
+{
+    const DrawPacket packets[] = {
+        { DrawList::MakeKey(1, 0, 1.0f), Item(0), 0 },
+        { DrawList::MakeKey(1, 0, 2.0f), Item(0), 0 },
+        { DrawList::MakeKey(1, 0, 3.0f), Item(0), 0 },
+        { DrawList::MakeKey(2, 1, 1.0f), Item(1), 0 },
+    };
+    std::vector<InstanceBatch> batches;
+    CHECK(BuildInstanceBatches(packets, 4, 2, [](const RenderItem& a, const RenderItem& b) { return &a == &b; }, batches) == 2);
+    REQUIRE(batches.size() == 1);
+
+    IndirectDrawCommand out[1]{};
+    std::vector<IndirectRun> runs{ { 9, 9, 9 } }; // 前の内容は上書きされる
+    WriteIndirectCommands(packets, batches.data(), batches.size(), GetMesh, out, runs);
+    REQUIRE(runs.size() == 1);
+    CHECK(runs[0].pipeline == 1 && runs[0].first == 0 && runs[0].count == 1);
+    CHECK(out[0].draw.InstanceCount == 2);
+
+    WriteIndirectCommands(packets, batches.data(), 0, GetMesh, out, runs);
+    CHECK(runs.empty());
+}
@@ -0,0 +1,253 @@
+﻿#include "TestFramework.h"
+#include "Renderer/InstanceBatcher.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+/*
+    InstanceBatcher のテスト/ベンチマーク
+    ----------------------------------------------------------------------------
+      - ソート済みの描画リストを、PSO・メッシュ・LOD がすべて同じ連続区間に切る
+        （区間は隙間なく並び、隣の区間とはどれかが違う。同じキーの別メッシュが挟まれば切る）
+      - 区間内のインスタンスは描画リストの順（std::stable_sort と同じ、手前から奥）のまま
+      - maxInstances を超えた分は捨てる
+      - PackInstance の world は元の行列と同じ点を返し、normal は接線と直交したままの法線を返す。
+        潰れた行列では normal は単位行列
+    RenderItem の中身は使わないので、アドレスを添字として描画候補ごとの情報を別表に持つ。
+    ベンチマークは 10 万件の区間切りと PackInstance の速さ。
+*/
+
+namespace
+{
+    /// 描画候補ごとの情報（RenderItem のアドレス = Scene::items 上の添字）
+    struct Object
+    {
+        std::uint32_t pipeline = 0;
+        std::uint32_t mesh = 0;
+        std::uint32_t lod = 0;
+        float         depth = 0.0f;
+    };
+
+    struct Scene
+    {
+        std::vector<std::uint64_t> items; // 中身を持たない描画候補
+        std::vector<Object>        objects;
+
+        const RenderItem* Item(std::size_t i) const { return reinterpret_cast<const RenderItem*>(&items[i]); }
+        const Object& Of(const RenderItem& item) const
+        {
+            return objects[reinterpret_cast<const std::uint64_t*>(&item) - items.data()];
+        }
+    };
+
+    /// PSO 3 種 × メッシュ 8 種 × LOD 2 段を散らした描画リスト（奥行きは 0.5 刻みで重複あり）
+    void MakeScene(std::size_t n, std::uint32_t seed, Scene& scene, std::vector<DrawPacket>& packets)
+    {
+        std::mt19937 rng(seed);
+        scene.items.assign(n, 0);
+        scene.objects.resize(n);
+        packets.resize(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            Object& o = scene.objects[i];
+            o.pipeline = rng() % 3;
+            o.mesh = rng() % 8;
+            o.lod = rng() % 2;
+            o.depth = static_cast<float>(rng() % 64) * 0.5f;
+            packets[i] = { DrawList::MakeKey(o.pipeline, o.mesh * 4 + o.lod, o.depth), scene.Item(i), o.lod };
+        }
+    }
+
+    void Sort(std::vector<DrawPacket>& packets)
+    {
+        std::vector<DrawPacket> scratch(packets.size());
+        RadixSortDrawPackets(packets.data(), scratch.data(), packets.size());
+    }
+
+    XMFLOAT3 Transform(const XMFLOAT3X4& m, const XMFLOAT3& p)
+    {
+        return { m._11 * p.x + m._12 * p.y + m._13 * p.z + m._14,
+                 m._21 * p.x + m._22 * p.y + m._23 * p.z + m._24,
+                 m._31 * p.x + m._32 * p.y + m._33 * p.z + m._34 };
+    }
+
+    /// 行ベクトル規約：n' = n * normal
+    XMFLOAT3 TransformNormal(const XMFLOAT3X3& m, const XMFLOAT3& n)
+    {
+        return { n.x * m._11 + n.y * m._21 + n.z * m._31,
+                 n.x * m._12 + n.y * m._22 + n.z * m._32,
+                 n.x * m._13 + n.y * m._23 + n.z * m._33 };
+    }
+
+    float Dot(const XMFLOAT3& a, const XMFLOAT3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    float Length(const XMFLOAT3& a) { return std::sqrt(Dot(a, a)); }
+}
+
+TEST_CASE(InstanceBatcher_GroupsByPipelineMeshAndLod)
+{
+    Scene scene;
+    std::vector<DrawPacket> packets;
+    MakeScene(5000, 1, scene, packets);
+    Sort(packets);
+
+    auto sameMesh = [&](const RenderItem& a, const RenderItem& b) { return scene.Of(a).mesh == scene.Of(b).mesh; };
+    std::vector<InstanceBatch> batches;
+    REQUIRE(BuildInstanceBatches(packets.data(), packets.size(), packets.size(), sameMesh, batches) == packets.size());
+
+    std::uint32_t next = 0;
+    for (std::size_t b = 0; b < batches.size(); ++b)
+    {
+        const InstanceBatch& batch = batches[b];
+        CHECK(batch.first == next);
+        CHECK(batch.count > 0);
+        CHECK(batch.item == packets[batch.first].item);
+        const Object& head = scene.Of(*batch.item);
+        CHECK(batch.lod == head.lod);
+        bool same = true;
+        for (std::uint32_t i = batch.first; i < batch.first + batch.count; ++i)
+        {
+            const Object& o = scene.Of(*packets[i].item);
+            same &= o.pipeline == head.pipeline && o.mesh == head.mesh && o.lod == head.lod && packets[i].lod == head.lod;
+        }
+        CHECK(same);
+        if (b > 0)
+        {
+            const Object& prev = scene.Of(*batches[b - 1].item);
+            CHECK(prev.pipeline != head.pipeline || prev.mesh != head.mesh || prev.lod != head.lod);
+        }
+        next = batch.first + batch.count;
+    }
+    CHECK(next == packets.size());
+    CHECK(batches.size() == 3 * 8 * 2); // 衝突が無ければ組み合わせごとに 1 区間
+}
+
+TEST_CASE(InstanceBatcher_KeepsDrawListOrder)
+{
+    Scene scene;
+    std::vector<DrawPacket> packets;
+    MakeScene(5000, 2, scene, packets);
+    std::vector<DrawPacket> expected = packets;
+    std::stable_sort(expected.begin(), expected.end(), [](const DrawPacket& a, const DrawPacket& b) { return a.key < b.key; });
+    Sort(packets);
+
+    auto sameMesh = [&](const RenderItem& a, const RenderItem& b) { return scene.Of(a).mesh == scene.Of(b).mesh; };
+    std::vector<InstanceBatch> batches;
+    BuildInstanceBatches(packets.data(), packets.size(), packets.size(), sameMesh, batches);
+
+    // インスタンス i = 描画リストの i 番目 = stable_sort の i 番目（同じ奥行きは入力順のまま）
+    bool sameOrder = true, nearToFar = true;
+    for (const InstanceBatch& batch : batches)
+        for (std::uint32_t i = batch.first; i < batch.first + batch.count; ++i)
+        {
+            sameOrder &= packets[i].item == expected[i].item;
+            if (i > batch.first) nearToFar &= scene.Of(*packets[i - 1].item).depth <= scene.Of(*packets[i].item).depth;
+        }
+    CHECK(sameOrder);
+    CHECK(nearToFar);
+}
+
+TEST_CASE(InstanceBatcher_SplitsCollisionsAndLimits)
+{
+    // 同じキーの別メッシュが交互に来たら毎回切る
+    Scene scene;
+    scene.items.assign(3, 0);
+    scene.objects.resize(3);
+    scene.objects[0].mesh = 1;
+    scene.objects[1].mesh = 2;
+    scene.objects[2].mesh = 1;
+    const std::uint64_t key = DrawList::MakeKey(0, 5, 1.0f);
+    const DrawPacket packets[] = { { key, scene.Item(0), 0 }, { key, scene.Item(1), 0 }, { key, scene.Item(2), 0 } };
+    auto sameMesh = [&](const RenderItem& a, const RenderItem& b) { return scene.Of(a).mesh == scene.Of(b).mesh; };
+    std::vector<InstanceBatch> batches;
+    CHECK(BuildInstanceBatches(packets, 3, 10, sameMesh, batches) == 3);
+    CHECK(batches.size() == 3);
+
+    // 同じメッシュでも LOD が違えば切る
+    const DrawPacket lods[] = { { key, scene.Item(0), 0 }, { key, scene.Item(2), 1 } };
+    BuildInstanceBatches(lods, 2, 10, sameMesh, batches);
+    CHECK(batches.size() == 2);
+
+    // 上限を超えた分は捨てる（0 なら区間なし）
+    const DrawPacket same[] = { { key, scene.Item(0), 0 }, { key, scene.Item(2), 0 }, { key, scene.Item(0), 0 } };
+    CHECK(BuildInstanceBatches(same, 3, 2, sameMesh, batches) == 2);
+    REQUIRE(batches.size() == 1);
+    CHECK(batches[0].count == 2);
+    CHECK(BuildInstanceBatches(same, 3, 0, sameMesh, batches) == 0);
+    CHECK(batches.empty());
+}
+
+TEST_CASE(InstanceBatcher_PackInstanceMatchesTransform)
+{
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> scale(0.2f, 3.0f);
+    float pointError = 0.0f, normalError = 0.0f;
+    for (int trial = 0; trial < 200; ++trial)
+    {
+        const float sz = (trial % 4 == 3 ? -1.0f : 1.0f) * scale(rng); // 鏡映も混ぜる
+        const XMMATRIX world = XMMatrixScaling(scale(rng), scale(rng), sz)
+            * XMMatrixRotationY(u(rng) * 3.0f) * XMMatrixRotationX(u(rng) * 3.0f)
+            * XMMatrixTranslation(u(rng) * 100.0f, u(rng) * 100.0f, u(rng) * 100.0f);
+        XMFLOAT4X4 m;
+        XMStoreFloat4x4(&m, world);
+        InstanceData inst;
+        PackInstance(m, inst);
+
+        for (int k = 0; k < 4; ++k)
+        {
+            // 点：XMVector3TransformCoord と同じ
+            const XMFLOAT3 p{ u(rng) * 5.0f, u(rng) * 5.0f, u(rng) * 5.0f };
+            XMFLOAT3 want;
+            XMStoreFloat3(&want, XMVector3TransformCoord(XMLoadFloat3(&p), world));
+            const XMFLOAT3 got = Transform(inst.world, p);
+            pointError = std::fmax(pointError, Length({ got.x - want.x, got.y - want.y, got.z - want.z }) / (1.0f + Length(want)));
+
+            // 法線：面上の接線 t と直交する n は、変換後も変換後の接線と直交する
+            const XMFLOAT3 n{ u(rng), u(rng), u(rng) };
+            XMFLOAT3 t{ u(rng), u(rng), u(rng) };
+            const float proj = Dot(n, t) / Dot(n, n);
+            t = { t.x - n.x * proj, t.y - n.y * proj, t.z - n.z * proj };
+            XMFLOAT3 tw;
+            XMStoreFloat3(&tw, XMVector3TransformNormal(XMLoadFloat3(&t), world));
+            const XMFLOAT3 nw = TransformNormal(inst.normal, n);
+            normalError = std::fmax(normalError, std::fabs(Dot(nw, tw)) / (Length(nw) * Length(tw)));
+        }
+    }
+    CHECK(pointError < 1e-5f);
+    CHECK(normalError < 1e-4f);
+
+    // 潰れた行列では法線行列は単位行列（位置はそのまま詰める）
+    XMFLOAT4X4 flat;
+    XMStoreFloat4x4(&flat, XMMatrixScaling(1.0f, 0.0f, 1.0f) * XMMatrixTranslation(1.0f, 2.0f, 3.0f));
+    InstanceData inst;
+    PackInstance(flat, inst);
+    CHECK(inst.normal._11 == 1.0f && inst.normal._22 == 1.0f && inst.normal._33 == 1.0f);
+    CHECK(inst.normal._12 == 0.0f && inst.normal._23 == 0.0f && inst.normal._31 == 0.0f);
+    CHECK(inst.world._14 == 1.0f && inst.world._24 == 2.0f && inst.world._34 == 3.0f);
+}
+
+BENCHMARK(InstanceBatcher_100k)
+{
+    Scene scene;
+    std::vector<DrawPacket> packets;
+    MakeScene(100000, 4, scene, packets);
+    Sort(packets);
+    auto sameMesh = [&](const RenderItem& a, const RenderItem& b) { return scene.Of(a).mesh == scene.Of(b).mesh; };
+
+    std::vector<InstanceBatch> batches;
+    batches.reserve(64);
+    const double batchMs = test::BestMilliseconds(10, [&] { BuildInstanceBatches(packets.data(), packets.size(), packets.size(), sameMesh, batches); });
+
+    std::vector<XMFLOAT4X4> worlds(packets.size());
+    for (std::size_t i = 0; i < worlds.size(); ++i)
+        XMStoreFloat4x4(&worlds[i], XMMatrixRotationY(static_cast<float>(i)) * XMMatrixTranslation(static_cast<float>(i), 0.0f, 1.0f));
+    std::vector<InstanceData> instances(packets.size());
+    const double packMs = test::BestMilliseconds(10, [&] { for (std::size_t i = 0; i < worlds.size(); ++i) PackInstance(worlds[i], instances[i]); });
+
+    test::Report("BuildInstanceBatches 100k", batchMs);
+    test::Report("PackInstance 100k", packMs);
+}
@@ -0,0 +1,107 @@
+﻿#include "TestFramework.h"
+#include "Renderer/LodSelection.h"
+#include <cfloat>
+#include <cstdint>
+
+/*
+    LodSelection のテスト（描画時の LOD の選び方）
+    ----------------------------------------------------------------------------
+    誤差 0 / 0.01 / 0.02 / 0.04、pixelError 1、hysteresis 0.25 の 4 段で、
+      - 既知の半径で選ぶ段（LOD0 から粗くするのは誤差 × 1.25 が 1 以下のとき）
+      - 同じ半径でも前回の段で答えが変わり（遊びの幅の中では前回の段に留まる）、hysteresis 0 なら変わらない
+      - 境目の前後で半径が揺れても段が行き来しない。半径を増減させると段は単調に動く
+      - 前回の段が範囲外 / 段が 1 つ / カメラが球の中（FLT_MAX）は LOD0
+*/
+
+namespace
+{
+    const float kErrors[] = { 0.0f, 0.01f, 0.02f, 0.04f };
+
+    LodSelectSettings Settings(float hysteresis)
+    {
+        LodSelectSettings s;
+        s.pixelError = 1.0f;
+        s.hysteresis = hysteresis;
+        return s;
+    }
+}
+
+TEST_CASE(LodSelection_KnownAnswers)
+{
+    const LodSelectSettings s = Settings(0.25f);
+    CHECK(SelectLod(kErrors, 4, 20.0f, 0, s) == 3);  // 0.04 × 20 × 1.25 = 1.0
+    CHECK(SelectLod(kErrors, 4, 21.0f, 0, s) == 2);
+    CHECK(SelectLod(kErrors, 4, 40.0f, 0, s) == 2);  // 0.02 × 40 × 1.25 = 1.0
+    CHECK(SelectLod(kErrors, 4, 41.0f, 0, s) == 1);
+    CHECK(SelectLod(kErrors, 4, 81.0f, 0, s) == 0);
+    CHECK(SelectLod(kErrors, 2, 20.0f, 0, s) == 1); // 段数で打ち切る
+    CHECK(SelectLod(kErrors, 1, 1.0f, 0, s) == 0);
+
+    // 範囲外の前回の段 / カメラが球の中
+    CHECK(SelectLod(kErrors, 4, 81.0f, 9, s) == 0);
+    CHECK(SelectLod(kErrors, 4, FLT_MAX, 3, s) == 0);
+}
+
+TEST_CASE(LodSelection_HysteresisHoldsPreviousLod)
+{
+    const LodSelectSettings s = Settings(0.25f);
+
+    // 半径 25：LOD0 からなら 2（0.04 × 25 × 1.25 > 1）、LOD3 からなら 3 のまま（0.04 × 25 ÷ 1.25 <= 1）
+    CHECK(SelectLod(kErrors, 4, 25.0f, 0, s) == 2);
+    CHECK(SelectLod(kErrors, 4, 25.0f, 2, s) == 2);
+    CHECK(SelectLod(kErrors, 4, 25.0f, 3, s) == 3);
+    CHECK(SelectLod(kErrors, 4, 31.0f, 3, s) == 3);  // 0.04 × 31 ÷ 1.25 = 0.992
+    CHECK(SelectLod(kErrors, 4, 32.0f, 3, s) == 2);  // 1.024：細かく戻す
+    CHECK(SelectLod(kErrors, 4, 200.0f, 3, s) == 0); // 一度に何段でも戻る
+
+    // 遊びなしなら前回の段に依らない
+    const LodSelectSettings none = Settings(0.0f);
+    for (std::uint32_t prev = 0; prev < 4; ++prev)
+    {
+        CHECK(SelectLod(kErrors, 4, 25.0f, prev, none) == 3);
+        CHECK(SelectLod(kErrors, 4, 26.0f, prev, none) == 2);
+    }
+}
+
+TEST_CASE(LodSelection_NoFlickerAroundThresholds)
+{
+    const LodSelectSettings s = Settings(0.25f);
+
+    // 半径を 1 → 200 → 1 と動かす：段は単調に動き、切り替えは片道 3 回ずつ
+    std::uint32_t lod = SelectLod(kErrors, 4, 1.0f, 0, s), switches = 0;
+    CHECK(lod == 3);
+    for (int r = 1; r <= 200; ++r)
+    {
+        const std::uint32_t next = SelectLod(kErrors, 4, static_cast<float>(r), lod, s);
+        CHECK(next <= lod);
+        switches += next != lod;
+        lod = next;
+    }
+    CHECK(lod == 0);
+    for (int r = 200; r >= 1; --r)
+    {
+        const std::uint32_t next = SelectLod(kErrors, 4, static_cast<float>(r), lod, s);
+        CHECK(next >= lod);
+        switches += next != lod;
+        lod = next;
+    }
+    CHECK(lod == 3);
+    CHECK(switches == 6);
+
+    // 各境目（遊びなしでの境目 25 / 50 / 100）の ±5% で揺らしても最初の答えのまま
+    for (const float edge : { 25.0f, 50.0f, 100.0f })
+    {
+        for (std::uint32_t start = 0; start < 4; ++start)
+        {
+            const std::uint32_t first = SelectLod(kErrors, 4, edge * 1.05f, start, s);
+            lod = first;
+            bool stable = true;
+            for (int i = 0; i < 20; ++i)
+            {
+                lod = SelectLod(kErrors, 4, edge * ((i & 1) ? 1.05f : 0.95f), lod, s);
+                stable &= lod == first;
+            }
+            CHECK(stable);
+        }
+    }
+}
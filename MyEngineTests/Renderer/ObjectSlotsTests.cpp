@@ -0,0 +1,111 @@
+﻿#include "TestFramework.h"
+#include "Renderer/ObjectSlots.h"
+#include <random>
+#include <set>
+#include <vector>
+
+/*
+    ObjectSlots のテスト
+    ----------------------------------------------------------------------------
+      - ObjectSlotAllocator：解放したスロットを小さい番号から再利用し、二重解放は無視する
+      - DirtySlotRanges：区間は昇順で重ならず、積んだスロットをすべて覆い、
+        隙間が maxGap 以下ならつながる
+*/
+
+TEST_CASE(ObjectSlots_ReusesLowestFreedSlot)
+{
+    ObjectSlotAllocator slots;
+    for (std::uint32_t i = 0; i < 10; ++i) CHECK(slots.Allocate() == i);
+    slots.Free(7);
+    slots.Free(2);
+    slots.Free(5);
+    slots.Free(2);  // 二重解放は無視
+    slots.Free(99); // 範囲外も無視
+    slots.Free(ObjectSlotAllocator::kInvalid);
+    CHECK(slots.LiveCount() == 7);
+    CHECK(!slots.IsLive(2));
+    CHECK(slots.IsLive(3));
+
+    CHECK(slots.Allocate() == 2);
+    CHECK(slots.Allocate() == 5);
+    CHECK(slots.Allocate() == 7);
+    CHECK(slots.Allocate() == 10);
+    CHECK(slots.HighWater() == 11);
+    CHECK(slots.LiveCount() == 11);
+
+    slots.Clear();
+    CHECK(slots.HighWater() == 0);
+    CHECK(slots.LiveCount() == 0);
+    CHECK(slots.Allocate() == 0);
+}
+
+TEST_CASE(ObjectSlots_DirtyRangesMergeSmallGaps)
+{
+    DirtySlotRanges dirty;
+    std::vector<SlotRange> ranges;
+    CHECK(dirty.Empty());
+    CHECK(dirty.Build(0, ranges) == 0);
+    CHECK(ranges.empty());
+
+    for (const std::uint32_t s : { 5u, 1u, 2u, 3u, 3u, 20u, 12u, 10u }) dirty.Mark(s);
+
+    // 隣接だけつなぐ：1-3, 5, 10, 12, 20
+    CHECK(dirty.Build(0, ranges) == 7);
+    REQUIRE(ranges.size() == 5);
+    CHECK(ranges[0].first == 1 && ranges[0].count == 3);
+    CHECK(ranges[1].first == 5 && ranges[1].count == 1);
+    CHECK(ranges[2].first == 10 && ranges[2].count == 1);
+    CHECK(ranges[3].first == 12 && ranges[3].count == 1);
+    CHECK(ranges[4].first == 20 && ranges[4].count == 1);
+
+    // 隙間 2 以下をつなぐ：1-5, 10-12, 20（積んだ内容は Build で消えない）
+    CHECK(dirty.Build(2, ranges) == 9);
+    REQUIRE(ranges.size() == 3);
+    CHECK(ranges[0].first == 1 && ranges[0].count == 5);
+    CHECK(ranges[1].first == 10 && ranges[1].count == 3);
+    CHECK(ranges[2].first == 20 && ranges[2].count == 1);
+
+    dirty.Clear();
+    dirty.MarkRange(4, 3);
+    dirty.Mark(7);
+    CHECK(dirty.Build(0, ranges) == 4);
+    REQUIRE(ranges.size() == 1);
+    CHECK(ranges[0].first == 4 && ranges[0].count == 4);
+}
+
+TEST_CASE(ObjectSlots_DirtyRangesCoverRandomMarks)
+{
+    std::mt19937 rng(1);
+    std::vector<SlotRange> ranges;
+    for (int t = 0; t < 200; ++t)
+    {
+        DirtySlotRanges dirty;
+        std::set<std::uint32_t> marked;
+        const int count = static_cast<int>(rng() % 50);
+        for (int i = 0; i < count; ++i)
+        {
+            const std::uint32_t s = rng() % 200;
+            marked.insert(s);
+            dirty.Mark(s);
+        }
+        const std::uint32_t gap = rng() % 6;
+        const std::size_t total = dirty.Build(gap, ranges);
+
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < ranges.size(); ++i)
+        {
+            sum += ranges[i].count;
+            if (i > 0) CHECK(ranges[i].first - (ranges[i - 1].first + ranges[i - 1].count) > gap);
+            // 区間の両端は実際に書き換えたスロット（余分に広げない）
+            CHECK(marked.count(ranges[i].first) == 1);
+            CHECK(marked.count(ranges[i].first + ranges[i].count - 1) == 1);
+        }
+        CHECK(sum == total);
+        for (const std::uint32_t s : marked)
+        {
+            bool covered = false;
+            for (const SlotRange& r : ranges) covered |= s >= r.first && s < r.first + r.count;
+            CHECK(covered);
+        }
+    }
+}
@@ -0,0 +1,87 @@
+﻿#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+/*
+===============================================================================
+ TestFramework（ヘッドレスのテスト/ベンチマーク）
+-------------------------------------------------------------------------------
+目的:
+  - GPU もウィンドウも使わない CPU 側のモジュール（アロケータ・カリング・メッシュ処理など）を、
+    エンジン本体とは別の実行ファイル（MyEngineTests）で確かめる。外部のライブラリには依存しない。
+  - D3D12 に触るモジュールは、各クラスの差し替え口（PageFactory / Backend）にフェイクを渡し、
+    フェンスの進み方をテストから手で決める（Fakes/FakeD3D12.h）。
+
+書き方:
+  TEST_CASE(UploadRing_ReusesPagesAfterFence) { ... CHECK(式); REQUIRE(式); }
+  BENCHMARK(StaticBvh_Build100k) { ... test::Report("build", ms); }
+  - CHECK は失敗を記録して続ける。REQUIRE は失敗したらそのケースを打ち切る
+    （以降の確認が前提を失う場合に使う）。
+  - ケースは登録順に実行する（ファイル内は上から順。ファイル間の順序は決めない）。
+
+実行:
+  MyEngineTests.exe            …… テストだけを全部
+  MyEngineTests.exe --bench    …… ベンチマークだけ（Release で実行すること）
+  MyEngineTests.exe --all      …… 両方
+  後ろに文字列を並べると、名前にどれかを含むケースだけを実行する。
+  失敗が 1 つでもあれば終了コード 1。
+  D3D12 / Win32 に依存しないテストは CMakeLists.txt でも（Linux などで）ビルドして ctest で回せる。
+===============================================================================
+*/
+
+namespace test
+{
+    using CaseFn = void (*)();
+
+    /// ケースを登録する（TEST_CASE / BENCHMARK が静的初期化で呼ぶ）
+    struct Registrar
+    {
+        Registrar(const char* name, CaseFn fn, bool benchmark);
+    };
+
+    /// REQUIRE の失敗でケースを打ち切るための例外（ランナーだけが捕まえる）
+    struct AbortCase {};
+
+    /// 失敗を記録する（CHECK/REQUIRE から呼ばれる）
+    void Fail(const char* file, int line, const char* expr);
+
+    /// ベンチマークの結果を 1 行出す（"  label  12.345 ms"。詳細は printf で自由に足してよい）
+    void Report(const char* label, double milliseconds);
+
+    /**
+     * @brief テスト用の一時ファイルのパス（実行ごとに作る一時ディレクトリの下）
+     * @details ディレクトリはランナーが作って終了時に消す。name はファイル名だけ渡す
+     */
+    std::wstring TempPath(const wchar_t* name);
+
+    /// fn を repeat 回実行し、最も速かった 1 回のミリ秒を返す（外乱を除くため最小値を使う）
+    template <class Fn>
+    double BestMilliseconds(int repeat, Fn&& fn)
+    {
+        double best = 1e300;
+        for (int i = 0; i < (std::max)(repeat, 1); ++i)
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            fn();
+            const std::chrono::duration<double, std::milli> dt = std::chrono::steady_clock::now() - t0;
+            best = (std::min)(best, dt.count());
+        }
+        return best;
+    }
+}
+
+#define TEST_DETAIL_CASE(name, benchmark) \
+    static void name(); \
+    static const test::Registrar name##_registrar(#name, &name, benchmark); \
+    static void name()
+
+#define TEST_CASE(name) TEST_DETAIL_CASE(name, false)
+#define BENCHMARK(name) TEST_DETAIL_CASE(name, true)
+
+#define CHECK(expr) \
+    do { if (!(expr)) test::Fail(__FILE__, __LINE__, #expr); } while (0)
+
+#define REQUIRE(expr) \
+    do { if (!(expr)) { test::Fail(__FILE__, __LINE__, #expr); throw test::AbortCase(); } } while (0)
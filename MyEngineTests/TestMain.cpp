@@ -0,0 +1,122 @@
+﻿#include "TestFramework.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+/*
+    TestMain
+    ----------------------------------------------------------------------------
+    登録されたケースを順に実行し、失敗の数を数える。
+      - 失敗は「ファイル(行): 式」で標準エラーへ出す（VS の出力ウィンドウからジャンプできる形）。
+      - 例外はケース単位で捕まえて失敗として数え、次のケースへ進む。
+      - 一時ディレクトリ（%TEMP%/MyEngineTests）は最初に作り直し、最後に消す。
+*/
+
+namespace
+{
+    struct Case
+    {
+        const char*  name;
+        test::CaseFn fn;
+        bool         benchmark;
+    };
+
+    // 静的初期化の順序に依存しないよう、関数内 static で持つ
+    std::vector<Case>& Registry()
+    {
+        static std::vector<Case> cases;
+        return cases;
+    }
+
+    int                   g_failures = 0;
+    std::filesystem::path g_tempDir;
+
+    bool Matches(const char* name, const std::vector<const char*>& filters)
+    {
+        if (filters.empty()) return true;
+        for (const char* f : filters)
+            if (std::strstr(name, f)) return true;
+        return false;
+    }
+}
+
+namespace test
+{
+    Registrar::Registrar(const char* name, CaseFn fn, bool benchmark)
+    {
+        Registry().push_back({ name, fn, benchmark });
+    }
+
+    void Fail(const char* file, int line, const char* expr)
+    {
+        ++g_failures;
+        std::fprintf(stderr, "%s(%d): CHECK failed: %s\n", file, line, expr);
+    }
+
+    void Report(const char* label, double milliseconds)
+    {
+        std::printf("  %-40s %10.3f ms\n", label, milliseconds);
+    }
+
+    std::wstring TempPath(const wchar_t* name)
+    {
+        return (g_tempDir / name).wstring();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool runTests = true, runBenchmarks = false;
+    std::vector<const char*> filters;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--bench") == 0)    { runTests = false; runBenchmarks = true; }
+        else if (std::strcmp(argv[i], "--all") == 0) { runTests = true;  runBenchmarks = true; }
+        else filters.push_back(argv[i]);
+    }
+
+    std::error_code ec;
+    g_tempDir = std::filesystem::temp_directory_path(ec) / "MyEngineTests";
+    std::filesystem::remove_all(g_tempDir, ec);
+    std::filesystem::create_directories(g_tempDir, ec);
+
+    int ran = 0, failedCases = 0;
+    for (const Case& c : Registry())
+    {
+        if ((c.benchmark ? !runBenchmarks : !runTests) || !Matches(c.name, filters)) continue;
+
+        std::printf("[ RUN  ] %s\n", c.name);
+        std::fflush(stdout);
+        const int before = g_failures;
+        const auto t0 = std::chrono::steady_clock::now();
+        try
+        {
+            c.fn();
+        }
+        catch (const test::AbortCase&)
+        {
+        }
+        catch (const std::exception& e)
+        {
+            test::Fail(c.name, 0, e.what());
+        }
+        catch (...)
+        {
+            test::Fail(c.name, 0, "unknown exception");
+        }
+        const std::chrono::duration<double, std::milli> dt = std::chrono::steady_clock::now() - t0;
+        const bool ok = g_failures == before;
+        std::printf("[ %s ] %s (%.1f ms)\n", ok ? " OK " : "FAIL", c.name, dt.count());
+        ++ran;
+        if (!ok) ++failedCases;
+    }
+
+    std::filesystem::remove_all(g_tempDir, ec);
+    std::printf("%d case(s), %d failed\n", ran, failedCases);
+    return failedCases == 0 ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+﻿#include "TestFramework.h"
+#include "Fakes/FakeD3D12.h"
+#include "Upload/GpuUploadQueue.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+/*
+    GpuUploadQueue のテスト
+    ----------------------------------------------------------------------------
+    フェイクの COPY キュー（fake::CopyQueue）で、
+      - ステージングが満杯なら提出して最も古い転送を待ち、中身は壊れない
+      - ステージングより大きいデータは分割して送られる
+      - 同じ提出に入った転送は同じフェンス値を返し、転送先の参照は完了まで持つ
+      - EnqueueCopy はステージングを使わずに GPU 上でコピーする
+    を確かめる。
+*/
+
+namespace
+{
+    std::vector<std::uint8_t> RandomBytes(std::size_t n, std::mt19937& rng)
+    {
+        std::vector<std::uint8_t> v(n);
+        for (std::uint8_t& b : v) b = static_cast<std::uint8_t>(rng());
+        return v;
+    }
+}
+
+TEST_CASE(GpuUploadQueue_StallsWhenStagingIsFull)
+{
+    fake::CopyQueue gpu;
+    GpuUploadQueue queue;
+    REQUIRE(queue.Initialize(gpu.Backend(), 64 * 1024));
+    CHECK(queue.Staging().Capacity() == 64 * 1024);
+
+    // 40KB x 3：2 つ目と 3 つ目はステージングが空くまで待つ
+    std::mt19937 rng(1);
+    std::vector<std::unique_ptr<fake::Resource>> res;
+    std::vector<std::vector<std::uint8_t>> data;
+    std::vector<std::uint64_t> fences;
+    for (int i = 0; i < 3; ++i)
+    {
+        res.emplace_back(new fake::Resource(40000));
+        data.push_back(RandomBytes(40000, rng));
+        fences.push_back(queue.Enqueue(res[i].get(), 0, data[i].data(), 40000));
+    }
+    CHECK((fences == std::vector<std::uint64_t>{ 1, 2, 3 }));
+    CHECK(queue.GetStats().stalls == 2);
+    CHECK(gpu.waits == 2);
+
+    CHECK(queue.IsComplete(0));
+    CHECK(queue.IsComplete(2));
+    CHECK(!queue.IsComplete(3));
+    queue.Submit();
+    CHECK(!queue.IsComplete(3));
+    gpu.Advance(3);
+    queue.Update();
+    CHECK(queue.IsComplete(3));
+    CHECK(queue.GetStats().inFlight == 0);
+    for (int i = 0; i < 3; ++i) CHECK(res[i]->bytes == data[i]);
+    for (int i = 0; i < 3; ++i) CHECK(res[i]->RefCount() == 1); // 完了後は参照を手放す
+}
+
+TEST_CASE(GpuUploadQueue_SplitsLargeUploads)
+{
+    fake::CopyQueue gpu;
+    GpuUploadQueue queue;
+    REQUIRE(queue.Initialize(gpu.Backend(), 64 * 1024));
+
+    std::mt19937 rng(2);
+    fake::Resource big(200000);
+    const std::vector<std::uint8_t> data = RandomBytes(200000, rng);
+    const std::uint64_t fence = queue.Enqueue(&big, 0, data.data(), data.size());
+    CHECK(fence != 0);
+    CHECK(queue.GetStats().copies == 4); // 64KB ごとに 4 回
+    CHECK(queue.GetStats().bytesQueued == 200000);
+
+    queue.WaitIdle();
+    CHECK(queue.IsComplete(fence));
+    CHECK(big.bytes == data);
+    CHECK(queue.Staging().Used() == 0);
+
+    // オフセット付きでバッファの途中へ書く
+    const std::vector<std::uint8_t> patch(1000, 0x5A);
+    queue.Enqueue(&big, 5000, patch.data(), patch.size());
+    queue.WaitIdle();
+    CHECK(big.bytes[4999] == data[4999]);
+    CHECK(big.bytes[5000] == 0x5A && big.bytes[5999] == 0x5A);
+    CHECK(big.bytes[6000] == data[6000]);
+}
+
+TEST_CASE(GpuUploadQueue_SmallUploadsShareOneSubmit)
+{
+    fake::CopyQueue gpu;
+    GpuUploadQueue queue;
+    REQUIRE(queue.Initialize(gpu.Backend(), 64 * 1024));
+
+    fake::Resource a(100), b(100);
+    const std::vector<std::uint8_t> x(100, 7), y(100, 9);
+    const std::uint64_t fa = queue.Enqueue(&a, 0, x.data(), 100);
+    const std::uint64_t fb = queue.Enqueue(&b, 0, y.data(), 100);
+    CHECK(fa == fb);
+    CHECK(a.RefCount() == 2); // 完了まで転送先を持つ
+
+    const std::uint32_t submits = queue.GetStats().submits;
+    CHECK(queue.Submit() == fa);
+    CHECK(queue.GetStats().submits == submits + 1);
+    CHECK(queue.GetStats().inFlight == 1);
+    CHECK(queue.Submit() == fa); // 何も溜まっていなければ提出しない
+    CHECK(queue.GetStats().submits == submits + 1);
+
+    queue.Update(); // まだ届いていない
+    CHECK(a.RefCount() == 2);
+    gpu.Advance(fa);
+    queue.Update();
+    CHECK(a.bytes == x);
+    CHECK(b.bytes == y);
+    CHECK(a.RefCount() == 1);
+    CHECK(b.RefCount() == 1);
+    CHECK(queue.GetStats().inFlight == 0);
+}
+
+TEST_CASE(GpuUploadQueue_EnqueueCopyBypassesStaging)
+{
+    fake::CopyQueue gpu;
+    GpuUploadQueue queue;
+    REQUIRE(queue.Initialize(gpu.Backend(), 64 * 1024));
+
+    std::mt19937 rng(3);
+    fake::Resource src(300000), dst(300000);
+    src.bytes = RandomBytes(300000, rng);
+    const std::uint64_t fence = queue.EnqueueCopy(&dst, 100, &src, 0, 200000);
+    CHECK(fence != 0);
+    CHECK(queue.Staging().Used() == 0);
+    CHECK(src.RefCount() == 2);
+    CHECK(dst.RefCount() == 2);
+
+    queue.WaitIdle();
+    CHECK(std::equal(src.bytes.begin(), src.bytes.begin() + 200000, dst.bytes.begin() + 100));
+    CHECK(dst.bytes[0] == 0);
+    CHECK(src.RefCount() == 1);
+    CHECK(dst.RefCount() == 1);
+}
+
+TEST_CASE(GpuUploadQueue_FailsWithoutStaging)
+{
+    fake::CopyQueue gpu;
+    gpu.failStaging = true;
+    GpuUploadQueue queue;
+    CHECK(!queue.Initialize(gpu.Backend(), 64 * 1024));
+
+    fake::Resource dst(16);
+    const std::uint8_t data[16] = {};
+    CHECK(queue.Enqueue(&dst, 0, data, sizeof(data)) == 0);
+    CHECK(dst.RefCount() == 1);
+}
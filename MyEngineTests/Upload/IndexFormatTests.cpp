@@ -0,0 +1,90 @@
+﻿#include "TestFramework.h"
+#include "Upload/IndexFormat.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/*
+    IndexFormat のテスト
+    ----------------------------------------------------------------------------
+      - 境目：頂点 65536 個（最大インデックス 0xFFFF）までは R16_UINT、65537 個（0x10000）からは R32_UINT。
+        0xFFFF は strip-cut 値ではなく普通のインデックスとして 16bit に入る
+      - 大きいインデックスが列のどこにあっても（先頭/末尾/1 個だけ）R32 になる。空は R32
+      - PackShortIndices は値をそのまま詰め、out の前の中身は残さない
+*/
+
+namespace
+{
+    /// 頂点 vertexCount 個の格子状メッシュ相当のインデックス（最後の三角形が最大の頂点を指す）
+    std::vector<std::uint32_t> IndicesFor(std::uint32_t vertexCount)
+    {
+        std::vector<std::uint32_t> indices;
+        for (std::uint32_t i = 0; i + 2 < vertexCount; i += 1021) indices.insert(indices.end(), { i, i + 1, i + 2 });
+        indices.insert(indices.end(), { 0, vertexCount - 2, vertexCount - 1 });
+        return indices;
+    }
+}
+
+TEST_CASE(IndexFormat_CutoffAt65536Vertices)
+{
+    const std::vector<std::uint32_t> fits = IndicesFor(65536);
+    CHECK(FitsShortIndices(fits.data(), fits.size()));
+    CHECK(ChooseIndexFormat(fits.data(), fits.size()) == DXGI_FORMAT_R16_UINT);
+
+    const std::vector<std::uint32_t> over = IndicesFor(65537);
+    CHECK(!FitsShortIndices(over.data(), over.size()));
+    CHECK(ChooseIndexFormat(over.data(), over.size()) == DXGI_FORMAT_R32_UINT);
+
+    // 65535 個（最大 0xFFFE）も当然 16bit
+    const std::vector<std::uint32_t> below = IndicesFor(65535);
+    CHECK(ChooseIndexFormat(below.data(), below.size()) == DXGI_FORMAT_R16_UINT);
+
+    // 0xFFFF そのものは 16bit に収まり、詰めても値が変わらない
+    const std::uint32_t cut[] = { 0xFFFFu, 0, 1 };
+    CHECK(FitsShortIndices(cut, 3));
+    std::vector<std::uint16_t> packed;
+    PackShortIndices(cut, 3, packed);
+    CHECK(packed.size() == 3 && packed[0] == 0xFFFF);
+
+    CHECK(IndexFormatSize(DXGI_FORMAT_R16_UINT) == 2);
+    CHECK(IndexFormatSize(DXGI_FORMAT_R32_UINT) == 4);
+}
+
+TEST_CASE(IndexFormat_AnyLargeIndexForces32Bit)
+{
+    std::vector<std::uint32_t> indices(3000);
+    for (std::size_t i = 0; i < indices.size(); ++i) indices[i] = static_cast<std::uint32_t>(i % 600);
+    CHECK(ChooseIndexFormat(indices.data(), indices.size()) == DXGI_FORMAT_R16_UINT);
+
+    for (const std::size_t at : { std::size_t(0), indices.size() / 2, indices.size() - 1 })
+    {
+        std::vector<std::uint32_t> one = indices;
+        one[at] = 0x10000u;
+        CHECK(ChooseIndexFormat(one.data(), one.size()) == DXGI_FORMAT_R32_UINT);
+        one[at] = 0xFFFFFFFFu;
+        CHECK(ChooseIndexFormat(one.data(), one.size()) == DXGI_FORMAT_R32_UINT);
+    }
+
+    // 空 / null は 16bit にしない
+    CHECK(!FitsShortIndices(nullptr, 0));
+    CHECK(!FitsShortIndices(indices.data(), 0));
+    CHECK(ChooseIndexFormat(nullptr, 0) == DXGI_FORMAT_R32_UINT);
+}
+
+TEST_CASE(IndexFormat_PackRoundTrips)
+{
+    std::mt19937 rng(1);
+    std::vector<std::uint32_t> indices(100000);
+    for (std::uint32_t& v : indices) v = rng() % 65536;
+    REQUIRE(FitsShortIndices(indices.data(), indices.size()));
+
+    std::vector<std::uint16_t> packed(250000, 0xABCD); // 前の中身は残らない
+    PackShortIndices(indices.data(), indices.size(), packed);
+    REQUIRE(packed.size() == indices.size());
+    bool same = true;
+    for (std::size_t i = 0; i < indices.size(); ++i) same &= packed[i] == indices[i];
+    CHECK(same);
+
+    PackShortIndices(indices.data(), 0, packed);
+    CHECK(packed.empty());
+}
@@ -0,0 +1,48 @@
+﻿#include "TestFramework.h"
+#include "Upload/MeshUploader.h"
+#include "Pipeline/VertexFormat.h"
+#include "Assets/MeshCache.h"
+#include "Assets/MeshCorpus.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/*
+    MeshUploader のテスト（.mesh に書く GPU 頂点形式）
+    ----------------------------------------------------------------------------
+      - GpuMeshCacheFormat はストリーム数/stride が GpuVertexStreams と同じで、キーは 0 でない
+      - 焼き込んだ頂点ストリームは描画側の GpuVertexStreams::Encode とバイト単位で同じで、16B 境界に載る
+    形式によらない .mesh の読み書きは Assets/MeshCacheTests.cpp（D3D12 なしで回る）。
+*/
+
+TEST_CASE(MeshUploader_CacheFormatMatchesEncode)
+{
+    const MeshCacheVertexFormat& format = GpuMeshCacheFormat();
+    REQUIRE(format.key != 0);
+    REQUIRE(format.streamCount == GpuVertexStreams::kStreamCount);
+    for (std::uint32_t s = 0; s < format.streamCount; ++s) CHECK(format.strides[s] == GpuVertexStreams::kStrides[s]);
+
+    std::vector<MeshCorpusEntry> corpus;
+    BuildMeshCorpus(corpus);
+    MeshCacheBuildSettings raw;
+    raw.optimize = false;
+    raw.buildLods = false;
+    raw.buildMeshlets = false;
+    for (const MeshCorpusEntry& e : corpus)
+    {
+        std::vector<std::uint8_t> bytes;
+        REQUIRE(BuildMeshCache(e.mesh, format, raw, 1, 1, bytes));
+        MeshCacheFile cache;
+        REQUIRE(cache.OpenMemory(bytes.data(), bytes.size(), &format, 1, 1, true));
+        REQUIRE(cache.VertexCount() == e.mesh.Vertices.size());
+
+        GpuVertexStreams::Arrays arrays;
+        GpuVertexStreams::Encode(e.mesh.Vertices, arrays);
+        const auto streams = GpuVertexStreams::Data(arrays);
+        for (std::uint32_t s = 0; s < format.streamCount; ++s)
+        {
+            CHECK(std::memcmp(cache.VertexStream(s), streams[s], e.mesh.Vertices.size() * format.strides[s]) == 0);
+            CHECK((reinterpret_cast<std::uintptr_t>(cache.VertexStream(s)) & 15) == 0);
+        }
+    }
+}
@@ -0,0 +1,164 @@
+﻿#include "TestFramework.h"
+#include "Upload/RangeAllocator.h"
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+/*
+    RangeAllocator のテスト
+    ----------------------------------------------------------------------------
+      - best-fit で切り出し、解放した区間は前後の空きと結合する
+      - Compact は生きている区間を先頭へ詰め、アラインを守り、動かした区間を位置順に返す
+      - 乱数で確保/解放/Compact/Grow を繰り返しても、モデル（ハンドル → 区間）と一致し続ける
+*/
+
+TEST_CASE(RangeAllocator_BestFitAndCoalesce)
+{
+    RangeAllocator r;
+    r.Reset(100);
+    const std::uint32_t a = r.Allocate(30), b = r.Allocate(30), c = r.Allocate(30);
+    CHECK(r.Offset(a) == 0);
+    CHECK(r.Offset(b) == 30);
+    CHECK(r.Offset(c) == 60);
+    CHECK(r.FreeTotal() == 10);
+
+    r.Free(b);
+    CHECK(r.FreeBlocks() == 2);
+    CHECK(r.LargestFree() == 30);
+    CHECK(r.Allocate(35) == RangeAllocator::kInvalid); // 空きは 40 あるが 1 区間に収まらない
+    CHECK(r.Fragmentation() > 0.2f);
+
+    const std::uint32_t d = r.Allocate(10); // 30 の穴ではなく末尾の 10 にぴったり入る
+    CHECK(r.Offset(d) == 90);
+
+    r.Free(a); // a と b の穴が 1 つにまとまる
+    CHECK(r.FreeBlocks() == 1);
+    CHECK(r.LargestFree() == 60);
+    r.Free(a); // 二重解放は無視
+    r.Free(RangeAllocator::kInvalid);
+    CHECK(r.Used() == 40);
+    CHECK(r.LiveCount() == 2);
+    CHECK(!r.IsLive(a));
+    CHECK(r.IsLive(c));
+}
+
+TEST_CASE(RangeAllocator_CompactKeepsAlignment)
+{
+    RangeAllocator r;
+    r.Reset(100);
+    const std::uint32_t a = r.Allocate(30), b = r.Allocate(30), c = r.Allocate(30);
+    r.Free(b);
+    const std::uint32_t d = r.Allocate(10);
+    r.Free(a);
+
+    std::vector<RangeMove> moves;
+    r.Compact(moves);
+    REQUIRE(moves.size() == 2);
+    CHECK(moves[0].handle == c && moves[0].from == 60 && moves[0].to == 0 && moves[0].size == 30);
+    CHECK(moves[1].handle == d && moves[1].from == 90 && moves[1].to == 30 && moves[1].size == 10);
+    CHECK(r.Offset(c) == 0);
+    CHECK(r.Offset(d) == 30);
+    CHECK(r.FreeBlocks() == 1);
+    CHECK(r.LargestFree() == 60);
+    CHECK(r.Fragmentation() == 0.0f);
+
+    // 16 境界：前余り（40..48）は空きに戻る
+    const std::uint32_t e = r.Allocate(5, 16);
+    CHECK(r.Offset(e) == 48);
+    CHECK(r.FreeTotal() == 55);
+    CHECK(r.FreeBlocks() == 2);
+
+    r.Grow(200);
+    CHECK(r.Capacity() == 200);
+    CHECK(r.LargestFree() == 200 - 53);
+    r.Grow(50); // 小さくはしない
+    CHECK(r.Capacity() == 200);
+
+    r.Compact(moves);
+    CHECK(r.Offset(e) == 48); // Compact でもアラインは守る
+    CHECK(moves.empty());
+}
+
+TEST_CASE(RangeAllocator_CompactMergesAllFreeSpace)
+{
+    RangeAllocator r;
+    r.Reset(1000);
+    std::vector<std::uint32_t> handles;
+    for (int i = 0; i < 50; ++i) handles.push_back(r.Allocate(1 + i % 17));
+    for (std::size_t i = 0; i < handles.size(); i += 2) r.Free(handles[i]);
+    CHECK(r.FreeBlocks() > 1);
+
+    std::vector<RangeMove> moves;
+    r.Compact(moves);
+    CHECK(r.FreeBlocks() == 1);
+    CHECK(r.Used() + r.FreeTotal() == 1000);
+    CHECK(r.Fragmentation() == 0.0f);
+    for (std::size_t i = 1; i < moves.size(); ++i) CHECK(moves[i - 1].to < moves[i].to);
+}
+
+TEST_CASE(RangeAllocator_RandomOperationsMatchModel)
+{
+    std::mt19937 rng(3);
+    RangeAllocator r;
+    r.Reset(1 << 16);
+    std::map<std::uint32_t, std::pair<std::uint64_t, std::uint64_t>> live; // handle → (offset, size)
+    std::vector<std::uint32_t> handles;
+    std::vector<RangeMove> moves;
+
+    for (int it = 0; it < 20000; ++it)
+    {
+        const int op = static_cast<int>(rng() % 100);
+        if (op < 55)
+        {
+            const std::uint64_t size = 1 + rng() % (rng() % 8 == 0 ? 4000 : 200);
+            const std::uint64_t align = 1ull << (rng() % 4);
+            const std::uint32_t h = r.Allocate(size, align);
+            if (h == RangeAllocator::kInvalid)
+            {
+                CHECK(r.LargestFree() < size + align - 1); // 失敗するのは本当に入らないときだけ
+                continue;
+            }
+            const std::uint64_t off = r.Offset(h);
+            REQUIRE(off % align == 0 && off + size <= r.Capacity());
+            if (it % 64 == 0)
+                for (const auto& kv : live) REQUIRE(off + size <= kv.second.first || kv.second.first + kv.second.second <= off);
+            live[h] = { off, size };
+            handles.push_back(h);
+        }
+        else if (op < 95)
+        {
+            if (handles.empty()) continue;
+            const std::size_t i = rng() % handles.size();
+            const std::uint32_t h = handles[i];
+            handles[i] = handles.back();
+            handles.pop_back();
+            r.Free(h);
+            live.erase(h);
+        }
+        else if (op < 99)
+        {
+            r.Compact(moves);
+            for (const RangeMove& m : moves)
+            {
+                CHECK(m.to < m.from);
+                live[m.handle].first = m.to;
+            }
+            for (const auto& kv : live) REQUIRE(r.Offset(kv.first) == kv.second.first);
+        }
+        else
+        {
+            r.Grow(r.Capacity() + 1000);
+        }
+
+        REQUIRE(r.LiveCount() == live.size());
+        REQUIRE(r.Used() + r.FreeTotal() <= r.Capacity());
+        if (it % 64 == 0)
+        {
+            std::uint64_t used = 0;
+            for (const auto& kv : live) used += kv.second.second;
+            REQUIRE(r.Used() == used);
+        }
+    }
+}
@@ -0,0 +1,113 @@
+﻿#include "TestFramework.h"
+#include "Upload/StagingRing.h"
+#include <random>
+#include <utility>
+#include <vector>
+
+/*
+    StagingRing のテスト
+    ----------------------------------------------------------------------------
+      - 末尾で足りない分は詰め物にして先頭へ折り返し、退役分はフェンス順に解放される
+      - ちょうど Capacity の要求は通り、超える要求は常に失敗する
+      - 乱数で切り出し/退役/解放を繰り返しても、使用中の領域は決して重ならない
+*/
+
+TEST_CASE(StagingRing_WrapsAndReclaimsInFenceOrder)
+{
+    StagingRing ring;
+    ring.Reset(100);
+    CHECK(ring.Allocate(40, 1) == 0);
+    CHECK(ring.Allocate(40, 1) == 40);
+    CHECK(ring.Allocate(30, 1) == StagingRing::kInvalid); // 末尾に 20 しか無く、先頭はまだ使用中
+    CHECK(ring.PendingBytes() == 80);
+    ring.Retire(1);
+    CHECK(ring.PendingBytes() == 0);
+
+    CHECK(ring.Allocate(10, 16) == 80); // 16 境界
+    CHECK(ring.Used() == 90);
+    ring.Retire(2);
+    ring.Reclaim(1);
+    CHECK(ring.Used() == 10);
+
+    // 末尾の 10（90..100）は詰め物になって先頭から取る
+    CHECK(ring.Allocate(30, 1) == 0);
+    CHECK(ring.Used() == 10 + 10 + 30);
+    CHECK(ring.Allocate(51, 1) == StagingRing::kInvalid); // tail=80, head=30 → 空きは 50
+    CHECK(ring.Allocate(50, 1) == 30);
+    CHECK(ring.Used() == 100);
+    CHECK(ring.Allocate(1, 1) == StagingRing::kInvalid);
+
+    ring.Retire(3);
+    CHECK(ring.OldestFence() == 2);
+    ring.Reclaim(2);
+    CHECK(ring.Used() == 90);
+    CHECK(ring.OldestFence() == 3);
+    ring.Reclaim(3);
+    CHECK(ring.Used() == 0);
+    CHECK(!ring.HasRetired());
+}
+
+TEST_CASE(StagingRing_CapacityLimits)
+{
+    StagingRing ring;
+    ring.Reset(100);
+    CHECK(ring.Allocate(100, 1) == 0);
+    CHECK(ring.Allocate(1, 1) == StagingRing::kInvalid);
+    ring.Retire(1);
+    ring.Reclaim(1);
+    CHECK(ring.Allocate(101, 1) == StagingRing::kInvalid);
+    CHECK(ring.Used() == 0);
+
+    ring.Retire(2); // 何も切り出していなければ何もしない
+    CHECK(!ring.HasRetired());
+
+    ring.Allocate(10, 1);
+    ring.Retire(3);
+    ring.Reset(200); // 退役待ちも捨てる
+    CHECK(!ring.HasRetired());
+    CHECK(ring.Capacity() == 200);
+    CHECK(ring.Used() == 0);
+}
+
+TEST_CASE(StagingRing_LiveRangesNeverOverlap)
+{
+    using Range = std::pair<std::uint64_t, std::uint64_t>; // (offset, bytes)
+    std::mt19937 rng(7);
+    StagingRing ring;
+    ring.Reset(1000);
+    std::vector<std::pair<std::uint64_t, Range>> retired; // (fence, range)
+    std::vector<Range> open;
+    std::uint64_t fence = 0, done = 0;
+
+    auto disjoint = [](const Range& a, const Range& b) { return a.first + a.second <= b.first || b.first + b.second <= a.first; };
+    for (int it = 0; it < 100000; ++it)
+    {
+        const int op = static_cast<int>(rng() % 10);
+        if (op < 6)
+        {
+            const std::uint64_t bytes = 1 + rng() % 300, align = 1ull << (rng() % 5);
+            const std::uint64_t off = ring.Allocate(bytes, align);
+            if (off == StagingRing::kInvalid) continue;
+            const Range r{ off, bytes };
+            REQUIRE(off % align == 0 && off + bytes <= 1000);
+            for (const auto& l : retired) REQUIRE(disjoint(r, l.second));
+            for (const Range& l : open) REQUIRE(disjoint(r, l));
+            open.push_back(r);
+        }
+        else if (op < 8)
+        {
+            if (open.empty()) continue;
+            ring.Retire(++fence);
+            for (const Range& r : open) retired.push_back({ fence, r });
+            open.clear();
+        }
+        else if (done < fence)
+        {
+            done += 1 + rng() % (fence - done);
+            ring.Reclaim(done);
+            std::vector<std::pair<std::uint64_t, Range>> keep;
+            for (const auto& l : retired) if (l.first > done) keep.push_back(l);
+            retired.swap(keep);
+        }
+    }
+}